@@ -515,7 +515,10 @@ Ax88179Reset (
 
   if (EFI_ERROR(Status)) goto err;
 
-  Val = 12; //AX88179_BULKIN_SIZE_INK - 1;
+  //
+  //  Bulk in transfers are limited to (RXBINQSIZE + 2) KiB
+  //
+  Val = AX88179_BULKIN_SIZE_INK - 2;
   Status =  Ax88179MacWrite (RXBINQSIZE,
                               0x01,
                               NicDevice,
@@ -1040,3 +1043,93 @@ done:
 no_pkt:
    return Status;
 }
+
+/**
+  Move the frames of the current bulk in transfer into the receive ring.
+
+  Bad frames are skipped, rather than throwing away the rest of the
+  transfer. Frames which don't fit in the ring are left in the bulk in
+  buffer, until the next call.
+
+  @param [in] NicDevice       Pointer to the NIC_DEVICE structure
+
+**/
+STATIC
+VOID
+Ax88179RxUnpack (
+  IN NIC_DEVICE *NicDevice
+  )
+{
+  RX_RING_ENTRY *Entry;
+  UINT16        CurrentPktLen;
+  BOOLEAN       Valid;
+
+  while ((NicDevice->PktCnt != 0) &&
+         (NicDevice->RxCount < AX88179_RX_RING_SIZE)) {
+    Valid = TRUE;
+    CurrentPktLen = *((UINT16*) (NicDevice->CurPktHdrOff + 2));
+    if (CurrentPktLen & (RXHDR_DROP | RXHDR_CRCERR))
+      Valid = FALSE;
+    CurrentPktLen &=  0x1fff;
+    CurrentPktLen -= 2; /*EEEE*/
+
+    if ((*((UINT16*)NicDevice->CurPktOff)) != 0xEEEE) {
+      //
+      //  Lost track of the frames in the transfer
+      //
+      NicDevice->PktCnt = 0;
+      break;
+    }
+
+    if (Valid && (60 <= CurrentPktLen) &&
+        ((CurrentPktLen - 14) <= MAX_ETHERNET_PKT_SIZE)) {
+      Entry = &NicDevice->RxRing[NicDevice->RxHead];
+      Entry->Length = CurrentPktLen;
+      CopyMem (Entry->Data, NicDevice->CurPktOff + 2, CurrentPktLen);
+      NicDevice->RxHead = (NicDevice->RxHead + 1) % AX88179_RX_RING_SIZE;
+      NicDevice->RxCount++;
+    } else {
+      SnpStatsRecordDrop (NicDevice->SnpStats, SnpStatsReceive);
+    }
+
+    NicDevice->PktCnt--;
+    NicDevice->CurPktHdrOff += 4;
+    NicDevice->CurPktOff += (CurrentPktLen + 2 + 7) & 0xfff8;
+  }
+}
+
+/**
+  Fill the receive ring from the bulk in endpoint.
+
+  This routine runs periodically at TPL_CALLBACK, so SN_Receive only
+  has to dequeue frames and never waits for a bulk in transfer to time
+  out. Bulk in transfers are issued until one returns no frames, or
+  the ring is full.
+
+  @param [in] Event           Timer event
+  @param [in] Context         Pointer to the NIC_DEVICE structure
+
+**/
+VOID
+EFIAPI
+Ax88179RxTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  NIC_DEVICE *NicDevice;
+
+  NicDevice = (NIC_DEVICE *) Context;
+
+  if ((NicDevice->SimpleNetworkData.State != EfiSimpleNetworkInitialized) ||
+      !NicDevice->LinkUp || !NicDevice->Complete) {
+    return;
+  }
+
+  while (NicDevice->RxCount < AX88179_RX_RING_SIZE) {
+    if ((NicDevice->PktCnt == 0) && EFI_ERROR (Ax88179BulkIn (NicDevice))) {
+      break;
+    }
+    Ax88179RxUnpack (NicDevice);
+  }
+}
@@ -21,6 +21,7 @@
 #include <Library/DebugLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/NetLib.h>
+#include <Library/SnpStatsLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/UefiLib.h>
@@ -69,10 +70,23 @@
 #define USB_NETWORK_CLASS   0x09    ///<  USB Network class code
 #define USB_BUS_TIMEOUT     1000    ///<  USB timeout in milliseconds
 
-#define AX88179_BULKIN_SIZE_INK     2
+//
+//  Bulk in buffer size, in KiB. The device aggregates received frames into
+//  bulk in transfers of up to this size (see RXBINQSIZE), so a single
+//  transfer can carry a dozen full size frames.
+//
+#define AX88179_BULKIN_SIZE_INK     24
 #define AX88179_MAX_BULKIN_SIZE    (1024 * AX88179_BULKIN_SIZE_INK)
 #define AX88179_MAX_PKT_SIZE  2048
 
+//
+//  Received frames are moved from the bulk in buffer into the receive ring
+//  by Ax88179RxTimer, in the background, and returned from there by
+//  SN_Receive without waiting on the bulk in endpoint.
+//
+#define AX88179_RX_RING_SIZE  64    ///<  Number of frames in the receive ring
+#define TIMER_MSEC            10    ///<  Polling interval for the NIC
+
 #define HC_DEBUG        0
 #define ADD_MACPATHNOD  1
 #define BULKIN_TIMEOUT  3 //5000
@@ -234,6 +248,11 @@ typedef struct _RX_PACKET {
 } RX_PACKET;
 #pragma pack()
 
+typedef struct _RX_RING_ENTRY {
+  UINT16  Length;                     ///<  Frame length in bytes
+  UINT8   Data[AX88179_MAX_PKT_SIZE]; ///<  Received frame
+} RX_RING_ENTRY;
+
 /**
   AX88179 control structure
 
@@ -279,6 +298,13 @@ typedef struct {
   UINT8                     *CurPktHdrOff;
   UINT8                     *CurPktOff;
 
+  RX_RING_ENTRY             *RxRing;            ///<  Frames received by Ax88179RxTimer
+  UINTN                     RxHead;             ///<  Next ring entry to fill
+  UINTN                     RxTail;             ///<  Next ring entry to return
+  UINTN                     RxCount;            ///<  Number of frames in the ring
+
+  SNP_STATS_CONTEXT         *SnpStats;          ///<  Call counters and latencies
+
   TX_PACKET                 *TxTest;
 
   INT8                      MulticastHash[8];
@@ -1049,5 +1075,12 @@ Ax88179BulkIn(
   IN NIC_DEVICE *NicDevice
 );
 
+VOID
+EFIAPI
+Ax88179RxTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
 
 #endif  //  AX88179_H_
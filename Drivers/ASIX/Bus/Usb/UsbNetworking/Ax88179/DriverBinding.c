@@ -268,15 +268,31 @@ DriverStart (
     goto ERR;
   }
 
-  return Status;
+  //
+  //  Statistics are optional, the interface works without them
+  //
+  Status = SnpStatsInstall (NicDevice->Controller, &NicDevice->SnpStats);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "Ax88179: No statistics: %r\n", Status));
+  }
+
+  return EFI_SUCCESS;
 
 
 ERR:
 
+  if (NicDevice->Timer != NULL) {
+    gBS->CloseEvent (NicDevice->Timer);
+  }
+
   if (NicDevice->BulkInbuf != NULL) {
     gBS->FreePool (NicDevice->BulkInbuf);
   }
 
+  if (NicDevice->RxRing != NULL) {
+    gBS->FreePool (NicDevice->RxRing);
+  }
+
   if (NicDevice->TxTest != NULL) {
     gBS->FreePool (NicDevice->TxTest);
   }
@@ -437,10 +453,20 @@ DriverStop (
                         EFI_OPEN_PROTOCOL_BY_CHILD_CONTROLLER
                         );
     } else {
+      SnpStatsUninstall (ChildHandleBuffer[Index], NicDevice->SnpStats);
+
+      if (NicDevice->Timer != NULL) {
+        gBS->CloseEvent (NicDevice->Timer);
+      }
+
       if (NicDevice->BulkInbuf != NULL) {
         gBS->FreePool (NicDevice->BulkInbuf);
       }
 
+      if (NicDevice->RxRing != NULL) {
+        gBS->FreePool (NicDevice->RxRing);
+      }
+
       if (NicDevice->TxTest != NULL) {
         gBS->FreePool (NicDevice->TxTest);
       }
@@ -109,10 +109,9 @@ ReceiveFilterUpdate (
   @retval EFI_DEVICE_ERROR      The command could not be sent to the network interface.
 
 **/
-
+STATIC
 EFI_STATUS
-EFIAPI
-SN_GetStatus (
+Ax88179GetStatus (
   IN  EFI_SIMPLE_NETWORK_PROTOCOL *SimpleNetwork,
   OUT UINT32                      *InterruptStatus,
   OUT VOID                        **TxBuf
@@ -195,6 +194,34 @@ EXIT:
   return Status;
 }
 
+/**
+  This function returns the current status of the network interface, and
+  records the call in the SNP statistics.  See Ax88179GetStatus.
+
+**/
+EFI_STATUS
+EFIAPI
+SN_GetStatus (
+  IN  EFI_SIMPLE_NETWORK_PROTOCOL *SimpleNetwork,
+  OUT UINT32                      *InterruptStatus,
+  OUT VOID                        **TxBuf
+  )
+{
+  EFI_STATUS              Status;
+  UINT64                  StartTicks;
+
+  if (SimpleNetwork == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = Ax88179GetStatus (SimpleNetwork, InterruptStatus, TxBuf);
+  SnpStatsRecord (DEV_FROM_SIMPLE_NETWORK (SimpleNetwork)->SnpStats,
+                  SnpStatsGetStatus, StartTicks, Status, 0);
+
+  return Status;
+}
+
 /**
   This function performs read and write operations on the NVRAM device
   attached to a network interface.
@@ -510,9 +537,9 @@ EXIT:
   @retval EFI_DEVICE_ERROR      The command could not be sent to the network interface.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-SN_Receive (
+Ax88179Receive (
   IN  EFI_SIMPLE_NETWORK_PROTOCOL *SimpleNetwork,
   OUT UINTN                       *HeaderSize,
   OUT UINTN                       *BufferSize,
@@ -525,10 +552,9 @@ SN_Receive (
   ETHERNET_HEADER         *Header;
   EFI_SIMPLE_NETWORK_MODE *Mode;
   NIC_DEVICE              *NicDevice;
+  RX_RING_ENTRY           *Entry;
   EFI_STATUS              Status;
   UINT16                  Type = 0;
-  UINT16                  CurrentPktLen;
-  BOOLEAN                 Valid = TRUE;
   EFI_TPL                 TplPrevious;
 
   TplPrevious = gBS->RaiseTPL (TPL_CALLBACK);
@@ -563,30 +589,20 @@ SN_Receive (
         }
 
         //
-        //  Attempt to do bulk in
+        //  Return the oldest frame of the receive ring, which is
+        //  filled in the background by Ax88179RxTimer
         //
-        if (NicDevice->PktCnt == 0) {
-          Status = Ax88179BulkIn(NicDevice);
-          if (EFI_ERROR(Status))
-            goto  no_pkt;
-        }
-        CurrentPktLen = *((UINT16*) (NicDevice->CurPktHdrOff + 2));
-        if (CurrentPktLen & (RXHDR_DROP | RXHDR_CRCERR))
-          Valid = FALSE;
-        CurrentPktLen &=  0x1fff;
-        CurrentPktLen -= 2; /*EEEE*/
-
-        if (Valid && (60 <= CurrentPktLen) &&
-        ((CurrentPktLen - 14) <= MAX_ETHERNET_PKT_SIZE) &&
-            (*((UINT16*)NicDevice->CurPktOff)) == 0xEEEE) {
-          if (*BufferSize < (UINTN)CurrentPktLen) {
+        if (NicDevice->RxCount != 0) {
+          Entry = &NicDevice->RxRing[NicDevice->RxTail];
+          if (*BufferSize < (UINTN)Entry->Length) {
+            *BufferSize = Entry->Length;
             gBS->RestoreTPL (TplPrevious);
             return EFI_BUFFER_TOO_SMALL;
           }
-          *BufferSize = CurrentPktLen;
-          CopyMem (Buffer, NicDevice->CurPktOff + 2, CurrentPktLen);
+          *BufferSize = Entry->Length;
+          CopyMem (Buffer, Entry->Data, Entry->Length);
 
-          Header = (ETHERNET_HEADER *) NicDevice->CurPktOff + 2;
+          Header = (ETHERNET_HEADER *) Entry->Data;
 
           if ((HeaderSize != NULL)  && ((*HeaderSize != 7720))) {
             *HeaderSize = sizeof (*Header);
@@ -603,12 +619,10 @@ SN_Receive (
             Type = (UINT16)((Type >> 8) | (Type << 8));
             *Protocol = Type;
           }
-          NicDevice->PktCnt--;
-          NicDevice->CurPktHdrOff += 4;
-          NicDevice->CurPktOff += (CurrentPktLen + 2 + 7) & 0xfff8;
+          NicDevice->RxTail = (NicDevice->RxTail + 1) % AX88179_RX_RING_SIZE;
+          NicDevice->RxCount--;
           Status = EFI_SUCCESS;
         } else {
-          NicDevice->PktCnt = 0;
           Status = EFI_NOT_READY;
         }
       } else {
@@ -628,11 +642,44 @@ SN_Receive (
   //
   // Return the operation status
   //
-no_pkt:
   gBS->RestoreTPL (TplPrevious);
   return Status;
 }
 
+/**
+  This function receives a packet from the network interface, and records
+  the call in the SNP statistics.  See Ax88179Receive.
+
+**/
+EFI_STATUS
+EFIAPI
+SN_Receive (
+  IN  EFI_SIMPLE_NETWORK_PROTOCOL *SimpleNetwork,
+  OUT UINTN                       *HeaderSize,
+  OUT UINTN                       *BufferSize,
+  OUT VOID                        *Buffer,
+  OUT EFI_MAC_ADDRESS             *SrcAddr,
+  OUT EFI_MAC_ADDRESS             *DestAddr,
+  OUT UINT16                      *Protocol
+  )
+{
+  EFI_STATUS              Status;
+  UINT64                  StartTicks;
+
+  if (SimpleNetwork == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = Ax88179Receive (SimpleNetwork, HeaderSize, BufferSize, Buffer,
+                           SrcAddr, DestAddr, Protocol);
+  SnpStatsRecord (DEV_FROM_SIMPLE_NETWORK (SimpleNetwork)->SnpStats,
+                  SnpStatsReceive, StartTicks, Status,
+                  EFI_ERROR (Status) ? 0 : *BufferSize);
+
+  return Status;
+}
+
 /**
   This function is used to enable and disable the hardware and software receive
   filters for the underlying network device.
@@ -864,6 +911,14 @@ SN_Reset (
       //
       NicDevice = DEV_FROM_SIMPLE_NETWORK (SimpleNetwork);
 
+      //
+      //  Discard the received frames
+      //
+      NicDevice->PktCnt = 0;
+      NicDevice->RxHead = 0;
+      NicDevice->RxTail = 0;
+      NicDevice->RxCount = 0;
+
       //
       //  Reset the device
       //
@@ -1001,9 +1056,33 @@ SN_Setup (
                                sizeof (TX_PACKET),
                                (VOID **) &NicDevice->TxTest);
   if (EFI_ERROR (Status)) {
-    gBS->FreePool (NicDevice->BulkInbuf);
+    return Status;
+  }
+
+  Status = gBS->AllocatePool (EfiBootServicesData,
+                               AX88179_RX_RING_SIZE * sizeof (RX_RING_ENTRY),
+                               (VOID **) &NicDevice->RxRing);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
+  //
+  //  Receive in the background, so that SN_Receive doesn't wait on
+  //  the bulk in endpoint
+  //
+  Status = gBS->CreateEvent (EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                              TPL_CALLBACK,
+                              Ax88179RxTimer,
+                              NicDevice,
+                              &NicDevice->Timer);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->SetTimer (NicDevice->Timer,
+                           TimerPeriodic,
+                           EFI_TIMER_PERIOD_MILLISECONDS (TIMER_MSEC));
+
   //
   //  Return the setup status
   //
@@ -1222,16 +1301,12 @@ SN_Statistics (
   Mode = SimpleNetwork->Mode;
 
   if (EfiSimpleNetworkInitialized == Mode->State) {
-    if ((StatisticsSize != NULL) && (*StatisticsSize == 0)) {
-      Status = EFI_BUFFER_TOO_SMALL;
-      goto EXIT;
-    }
-
-    if(Reset) {
-      Status = EFI_SUCCESS;
-    } else {
-      Status = EFI_SUCCESS;
-    }
+    Status = SnpStatsGetNetworkStatistics (
+               DEV_FROM_SIMPLE_NETWORK (SimpleNetwork)->SnpStats,
+               Reset,
+               StatisticsSize,
+               StatisticsTable
+               );
   } else {
     if (EfiSimpleNetworkStarted == Mode->State) {
       Status = EFI_DEVICE_ERROR; ;
@@ -1240,8 +1315,6 @@ SN_Statistics (
     }
   }
 
-  Status = EFI_UNSUPPORTED;
-EXIT:
   gBS->RestoreTPL(TplPrevious);
   return Status;
 }
@@ -1408,9 +1481,9 @@ SN_Shutdown (
   @retval EFI_DEVICE_ERROR      The command could not be sent to the network interface.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-SN_Transmit (
+Ax88179Transmit (
   IN EFI_SIMPLE_NETWORK_PROTOCOL *SimpleNetwork,
   IN UINTN                       HeaderSize,
   IN UINTN                       BufferSize,
@@ -1546,3 +1619,36 @@ EXIT:
   gBS->RestoreTPL (TplPrevious);
   return Status;
 }
+
+/**
+  This function queues a packet for transmission, and records the call in
+  the SNP statistics.  See Ax88179Transmit.
+
+**/
+EFI_STATUS
+EFIAPI
+SN_Transmit (
+  IN EFI_SIMPLE_NETWORK_PROTOCOL *SimpleNetwork,
+  IN UINTN                       HeaderSize,
+  IN UINTN                       BufferSize,
+  IN VOID                        *Buffer,
+  IN EFI_MAC_ADDRESS             *SrcAddr,
+  IN EFI_MAC_ADDRESS             *DestAddr,
+  IN UINT16                      *Protocol
+  )
+{
+  EFI_STATUS              Status;
+  UINT64                  StartTicks;
+
+  if (SimpleNetwork == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = Ax88179Transmit (SimpleNetwork, HeaderSize, BufferSize, Buffer,
+                            SrcAddr, DestAddr, Protocol);
+  SnpStatsRecord (DEV_FROM_SIMPLE_NETWORK (SimpleNetwork)->SnpStats,
+                  SnpStatsTransmit, StartTicks, Status, BufferSize);
+
+  return Status;
+}
@@ -1298,3 +1298,81 @@ no_pkt:
   return Status;
 }
 #endif
+
+/**
+  Move the frames of the current bulk in transfer into the receive ring.
+
+  Frames which don't fit in the ring are left in the bulk in buffer,
+  until the next call. A bad frame length means the frame headers can no
+  longer be followed, so the rest of the transfer is dropped.
+
+  @param [in] NicDevice       Pointer to the NIC_DEVICE structure
+
+**/
+STATIC
+VOID
+Ax88772RxUnpack (
+  IN NIC_DEVICE *NicDevice
+  )
+{
+  RX_RING_ENTRY *Entry;
+  UINT16        CurrentPktLen;
+
+  while ((NicDevice->PktCnt != 0) &&
+         (NicDevice->RxCount < AX88772_RX_RING_SIZE)) {
+    CurrentPktLen = *((UINT16*) (NicDevice->CurPktHdrOff));
+    CurrentPktLen &=  0x7ff;
+
+    if ((CurrentPktLen < 60) ||
+        (CurrentPktLen - 14 > MAX_ETHERNET_PKT_SIZE)) {
+      NicDevice->PktCnt = 0;
+      break;
+    }
+
+    Entry = &NicDevice->RxRing[NicDevice->RxHead];
+    Entry->Length = CurrentPktLen;
+    CopyMem (Entry->Data, NicDevice->CurPktOff, CurrentPktLen);
+    NicDevice->RxHead = (NicDevice->RxHead + 1) % AX88772_RX_RING_SIZE;
+    NicDevice->RxCount++;
+
+    NicDevice->PktCnt--;
+    NicDevice->CurPktHdrOff += (CurrentPktLen + 4 + 1) & 0xfffe;
+    NicDevice->CurPktOff = NicDevice->CurPktHdrOff + 4;
+  }
+}
+
+/**
+  Fill the receive ring from the bulk in endpoint.
+
+  This routine runs periodically at TPL_CALLBACK, so SN_Receive only
+  has to dequeue frames and never waits for a bulk in transfer to time
+  out. Bulk in transfers are issued until one returns no frames, or
+  the ring is full.
+
+  @param [in] Event           Timer event
+  @param [in] Context         Pointer to the NIC_DEVICE structure
+
+**/
+VOID
+EFIAPI
+Ax88772RxTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  NIC_DEVICE *NicDevice;
+
+  NicDevice = (NIC_DEVICE *) Context;
+
+  if ((NicDevice->SimpleNetworkData.State != EfiSimpleNetworkInitialized) ||
+      !NicDevice->LinkUp || !NicDevice->Complete) {
+    return;
+  }
+
+  while (NicDevice->RxCount < AX88772_RX_RING_SIZE) {
+    if ((NicDevice->PktCnt == 0) && EFI_ERROR (Ax88772BulkIn (NicDevice))) {
+      break;
+    }
+    Ax88772RxUnpack (NicDevice);
+  }
+}
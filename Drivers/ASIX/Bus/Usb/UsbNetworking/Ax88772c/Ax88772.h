@@ -77,7 +77,14 @@
 #define USB_NETWORK_CLASS   0x09    ///<  USB Network class code
 #define USB_BUS_TIMEOUT     1000    ///<  USB timeout in milliseconds
 
-#define TIMER_MSEC          20              ///<  Polling interval for the NIC
+#define TIMER_MSEC          10              ///<  Polling interval for the NIC
+
+//
+//  Received frames are moved from the bulk in buffer into the receive ring
+//  by Ax88772RxTimer, in the background, and returned from there by
+//  SN_Receive without waiting on the bulk in endpoint.
+//
+#define AX88772_RX_RING_SIZE  64            ///<  Number of frames in the receive ring
 
 #define HC_DEBUG  0
 
@@ -319,6 +326,14 @@ typedef struct _RX_TX_PACKET {
 } RX_TX_PACKET;
 #pragma pack()
 
+/**
+  Receive ring entry
+**/
+typedef struct _RX_RING_ENTRY {
+  UINT16 Length;                      ///<  Frame length in bytes
+  UINT8  Data[AX88772_MAX_PKT_SIZE];  ///<  Received frame
+} RX_RING_ENTRY;
+
 /**
   AX88772 control structure
 
@@ -364,6 +379,12 @@ typedef struct {
   UINT8                     *CurPktOff;
   UINT16                    PktCnt;
 
+  RX_RING_ENTRY             *RxRing;            ///<  Frames received by Ax88772RxTimer
+  UINTN                     RxHead;             ///<  Next ring entry to fill
+  UINTN                     RxTail;             ///<  Next ring entry to return
+  UINTN                     RxCount;            ///<  Number of frames in the ring
+  EFI_EVENT                 Timer;              ///<  Timer to receive packets
+
   RX_TX_PACKET              *TxTest;
 
   UINT8                     MulticastHash[8];
@@ -1036,6 +1057,13 @@ Ax88772BulkIn(
   IN NIC_DEVICE *NicDevice
 );
 
+VOID
+EFIAPI
+Ax88772RxTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
 //------------------------------------------------------------------------------
 
 #endif  //  AX88772_H_
@@ -524,10 +524,10 @@ SN_Receive (
   ETHERNET_HEADER         *Header;
   EFI_SIMPLE_NETWORK_MODE *Mode;
   NIC_DEVICE              *NicDevice = NULL;
+  RX_RING_ENTRY           *Entry;
   EFI_STATUS              Status;
   EFI_TPL                 TplPrevious;
   UINT16                  Type;
-  UINT16                  CurrentPktLen;
 
 
   TplPrevious = gBS->RaiseTPL (TPL_CALLBACK);
@@ -562,28 +562,20 @@ SN_Receive (
         }
 
         //
-        //  Attempt to receive a packet
+        //  Return the oldest frame of the receive ring, which is
+        //  filled in the background by Ax88772RxTimer
         //
-        if (0 == NicDevice->PktCnt) {
-          Status = Ax88772BulkIn(NicDevice);
-          if (EFI_ERROR(Status)) {
-            goto  no_pkt;
-          }
-        }
-
-        CurrentPktLen = *((UINT16*) (NicDevice->CurPktHdrOff));
-        CurrentPktLen &=  0x7ff;
-
-        if ((60 <= CurrentPktLen) &&
-            (CurrentPktLen - 14 <= MAX_ETHERNET_PKT_SIZE)) {
-            if (*BufferSize < (UINTN)CurrentPktLen) {
+        if (NicDevice->RxCount != 0) {
+            Entry = &NicDevice->RxRing[NicDevice->RxTail];
+            if (*BufferSize < (UINTN)Entry->Length) {
+              *BufferSize = Entry->Length;
               gBS->RestoreTPL (TplPrevious);
               return EFI_BUFFER_TOO_SMALL;
             }
 
-            *BufferSize = CurrentPktLen;
-            CopyMem (Buffer, NicDevice->CurPktOff, CurrentPktLen);
-            Header = (ETHERNET_HEADER *) NicDevice->CurPktOff;
+            *BufferSize = Entry->Length;
+            CopyMem (Buffer, Entry->Data, Entry->Length);
+            Header = (ETHERNET_HEADER *) Entry->Data;
 
             if ((HeaderSize != NULL)  && (*HeaderSize != 7720)) {
               *HeaderSize = sizeof (*Header);
@@ -599,13 +591,11 @@ SN_Receive (
               Type = (UINT16)((Type >> 8) | (Type << 8));
               *Protocol = Type;
             }
-            NicDevice->PktCnt--;
-            NicDevice->CurPktHdrOff += (CurrentPktLen + 4 + 1) & 0xfffe;
-            NicDevice->CurPktOff = NicDevice->CurPktHdrOff + 4;
+            NicDevice->RxTail = (NicDevice->RxTail + 1) % AX88772_RX_RING_SIZE;
+            NicDevice->RxCount--;
             Status = EFI_SUCCESS;
         } else {
-          NicDevice->PktCnt = 0;
-          Status = EFI_DEVICE_ERROR;
+          Status = EFI_NOT_READY;
         }
       } else {
         //
@@ -627,7 +617,6 @@ SN_Receive (
   //
   // Return the operation status
   //
-no_pkt:
   gBS->RestoreTPL (TplPrevious);
   return Status;
 }
@@ -868,6 +857,14 @@ SN_Reset (
       //
       NicDevice = DEV_FROM_SIMPLE_NETWORK (SimpleNetwork);
 
+      //
+      //  Discard the received frames
+      //
+      NicDevice->PktCnt = 0;
+      NicDevice->RxHead = 0;
+      NicDevice->RxTail = 0;
+      NicDevice->RxCount = 0;
+
       //
       //  Reset the device
       //
@@ -1010,10 +1007,35 @@ SN_Setup (
                                    (VOID **) &NicDevice->TxTest);
 
   if (EFI_ERROR (Status)) {
-    gBS->FreePool (NicDevice->BulkInbuf);
     return Status;
   }
 
+  Status = gBS->AllocatePool (EfiBootServicesData,
+                                   AX88772_RX_RING_SIZE * sizeof (RX_RING_ENTRY),
+                                   (VOID **) &NicDevice->RxRing);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  //  Receive in the background, so that SN_Receive doesn't wait on
+  //  the bulk in endpoint
+  //
+  Status = gBS->CreateEvent (EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                              TPL_CALLBACK,
+                              Ax88772RxTimer,
+                              NicDevice,
+                              &NicDevice->Timer);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->SetTimer (NicDevice->Timer,
+                           TimerPeriodic,
+                           EFI_TIMER_PERIOD_MILLISECONDS (TIMER_MSEC));
+
   //
   //  Return the setup status
   //
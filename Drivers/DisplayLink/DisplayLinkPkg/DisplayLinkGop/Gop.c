@@ -69,6 +69,28 @@ CheckBounds (
   return EFI_SUCCESS;
 }
 
+/**
+ * Update the store of the area of the screen that is "dirty" - the lines that need to be converted before the
+ * next screen update.
+ * @param UsbDisplayLinkDev
+ * @param Y                 First line that was BLTted to
+ * @param Height            Number of lines that were BLTted to
+ */
+STATIC VOID
+MarkDirtyLines (
+  IN  USB_DISPLAYLINK_DEV  *UsbDisplayLinkDev,
+  IN  UINTN                Y,
+  IN  UINTN                Height
+)
+{
+  if (Y < UsbDisplayLinkDev->LastY1) {
+    UsbDisplayLinkDev->LastY1 = Y;
+  }
+  if ((Y + Height) > UsbDisplayLinkDev->LastY2) {
+    UsbDisplayLinkDev->LastY2 = Y + Height;
+  }
+}
+
 /**
  * Update the local copy of the Frame Buffer. This local copy is periodically transmitted to the
  * DisplayLink device (via DlGopSendScreenUpdate)
@@ -121,13 +143,7 @@ BuildBackBuffer (
 
   case EfiBltBufferToVideo:
   {
-    // Update the store of the area of the screen that is "dirty" - that we need to send in the next screen update.
-    if (DestinationY < UsbDisplayLinkDev->LastY1) {
-      UsbDisplayLinkDev->LastY1 = DestinationY;
-    }
-    if ((DestinationY + Height) > UsbDisplayLinkDev->LastY2) {
-      UsbDisplayLinkDev->LastY2 = DestinationY + Height;
-    }
+    MarkDirtyLines (UsbDisplayLinkDev, DestinationY, Height);
 
     EFI_GRAPHICS_OUTPUT_BLT_PIXEL* Blt;
     EFI_GRAPHICS_OUTPUT_BLT_PIXEL* DstB;
@@ -146,6 +162,8 @@ BuildBackBuffer (
 
   case EfiBltVideoToVideo:
   {
+    MarkDirtyLines (UsbDisplayLinkDev, DestinationY, Height);
+
     EFI_GRAPHICS_OUTPUT_BLT_PIXEL* SrcB;
     EFI_GRAPHICS_OUTPUT_BLT_PIXEL* DstB;
     SrcB = UsbDisplayLinkDev->Screen + SourceY * PixelsPerScanLine + SourceX;
@@ -163,6 +181,8 @@ BuildBackBuffer (
 
   case EfiBltVideoFill:
   {
+    MarkDirtyLines (UsbDisplayLinkDev, DestinationY, Height);
+
     EFI_GRAPHICS_OUTPUT_BLT_PIXEL* DstB;
     DstB = UsbDisplayLinkDev->Screen + DestinationY * PixelsPerScanLine + DestinationX;
     for (H = 0; H < Height; H++) {
@@ -251,8 +271,99 @@ DlGopSendTestPattern (
 }
 
 
+/**
+ * Swap a BLT pixel read as a little-endian word (Blue, Green, Red, Reserved) round to the byte order sent to the
+ * DisplayLink device (Red, Green, Blue) in the low 24 bits of the word.
+ */
+#define DL_PIXEL_TO_RGB(Pixel) \
+  ((((Pixel) >> 16) & 0xFF) | ((Pixel) & 0xFF00) | (((Pixel) & 0xFF) << 16))
+
+/**
+ * Convert the lines of the back buffer that have been BLTted to since the last screen update into the format sent
+ * to the DisplayLink device.
+ *
+ * Pixels are converted four at a time: four 32-bit BLT pixels are packed into three 32-bit words of 24-bit pixels,
+ * rather than copying each byte on its own.
+ * @param UsbDisplayLinkDev
+ */
+STATIC VOID
+ConvertDirtyLines (
+    IN USB_DISPLAYLINK_DEV* UsbDisplayLinkDev
+    )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL* SrcPtr;
+  UINT8* DstPtr;
+  CONST UINT32* SrcWords;
+  UINT32* DstWords;
+  UINT32 Rgb0;
+  UINT32 Rgb1;
+  UINT32 Rgb2;
+  UINT32 Rgb3;
+  UINTN Width;
+  UINTN LastLine;
+  UINTN Count;
+
+  Width = UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info->HorizontalResolution;
+  LastLine = MIN (UsbDisplayLinkDev->LastY2, UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info->VerticalResolution);
+
+  if (UsbDisplayLinkDev->LastY1 >= LastLine) {
+    return;
+  }
+
+  SrcPtr = UsbDisplayLinkDev->Screen + UsbDisplayLinkDev->LastY1 * Width;
+  DstPtr = UsbDisplayLinkDev->WireScreen + UsbDisplayLinkDev->LastY1 * Width * 3;
+
+  Count = (LastLine - UsbDisplayLinkDev->LastY1) * Width;
+
+  // Convert pixel by pixel up to a pixel whose converted copy starts on a 32-bit boundary
+  while ((Count > 0) && (((UINTN)DstPtr & 3) != 0)) {
+    // Need to swap round the RGB values
+    DstPtr[0] = SrcPtr->Red;
+    DstPtr[1] = SrcPtr->Green;
+    DstPtr[2] = SrcPtr->Blue;
+    SrcPtr++;
+    DstPtr += 3;
+    Count--;
+  }
+
+  SrcWords = (CONST UINT32*)SrcPtr;
+  DstWords = (UINT32*)DstPtr;
+
+  for (; Count >= 4; Count -= 4) {
+    Rgb0 = DL_PIXEL_TO_RGB (SrcWords[0]);
+    Rgb1 = DL_PIXEL_TO_RGB (SrcWords[1]);
+    Rgb2 = DL_PIXEL_TO_RGB (SrcWords[2]);
+    Rgb3 = DL_PIXEL_TO_RGB (SrcWords[3]);
+    DstWords[0] = Rgb0 | (Rgb1 << 24);
+    DstWords[1] = (Rgb1 >> 8) | (Rgb2 << 16);
+    DstWords[2] = (Rgb2 >> 16) | (Rgb3 << 8);
+    SrcWords += 4;
+    DstWords += 3;
+  }
+
+  SrcPtr = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)SrcWords;
+  DstPtr = (UINT8*)DstWords;
+
+  for (; Count > 0; Count--) {
+    DstPtr[0] = SrcPtr->Red;
+    DstPtr[1] = SrcPtr->Green;
+    DstPtr[2] = SrcPtr->Blue;
+    SrcPtr++;
+    DstPtr += 3;
+  }
+}
+
 /**
  * Transfer the latest copy of the Blt buffer over USB to the DisplayLink device
+ *
+ * The device takes the whole frame, one line per bulk transfer, so a frame is sent whenever anything was BLTted
+ * to. Only the lines that were BLTted to are converted to the 24bpp format beforehand, the others are sent
+ * straight from the copy made for the previous frames.
+ *
+ * The converted copy acts as the front buffer: the TPL is only raised while the BLTted lines are converted into
+ * it, so that a BLT can't come in half way. The frame is then streamed from it at the TPL of the caller, which
+ * lets other events run between the bulk transfers. Only this function writes to the converted copy, and it is
+ * called from the periodic timer at TPL_CALLBACK, which the BLTs into the back buffer don't change.
  * @param UsbDisplayLinkDev
  * @return
  */
@@ -267,50 +378,41 @@ DlGopSendScreenUpdate (
 
   // If it has been a while since we sent an update, send a full screen.
   // This allows us to update a hot-plugged monitor quickly.
-  if (UsbDisplayLinkDev->TimeSinceLastScreenUpdate > DISPLAYLINK_FULL_SCREEN_UPDATE_PERIOD) {
-    UsbDisplayLinkDev->LastY1 = 0;
-    UsbDisplayLinkDev->LastY2 = UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info->HorizontalResolution - 1;
-  }
+  BOOLEAN FullScreenUpdate = (UsbDisplayLinkDev->TimeSinceLastScreenUpdate > DISPLAYLINK_FULL_SCREEN_UPDATE_PERIOD);
 
   // If there has been no BLT since the last update/poll, drop out quietly.
-  if (UsbDisplayLinkDev->LastY2 < UsbDisplayLinkDev->LastY1) {
+  if ((UsbDisplayLinkDev->LastY2 < UsbDisplayLinkDev->LastY1) && !FullScreenUpdate) {
     UsbDisplayLinkDev->TimeSinceLastScreenUpdate += (DISPLAYLINK_SCREEN_UPDATE_TIMER_PERIOD / 1000);  // Convert us to ms
     return EFI_SUCCESS;
   }
 
+  if (UsbDisplayLinkDev->WireScreen == NULL) {
+    return EFI_NOT_READY;
+  }
+
   UsbDisplayLinkDev->TimeSinceLastScreenUpdate = 0;
 
   EFI_TPL OriginalTPL = gBS->RaiseTPL (TPL_NOTIFY);
 
+  ConvertDirtyLines (UsbDisplayLinkDev);
+
+  // Reset the values that store which area of the screen has been BLTted to: the converted copy is now up to date.
+  UsbDisplayLinkDev->LastY2 = 0;
+  UsbDisplayLinkDev->LastY1 = (UINTN)-1;
+
+  gBS->RestoreTPL (OriginalTPL);
+
   UINTN DataLen;
-  UINTN Width;
   UINTN Height;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL* SrcPtr;
-  UINT8* DstPtr;
-  UINT8 DstBuffer[1920 * 3]; // Get rid of the magic numbers at some point
-                             // Could also use a buffer allocated at runtime to store the line, stored in the USB_DISPLAYLINK_DEV structure.
+  UINT8* LinePtr;
   UINTN H;
 
   DataLen = UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info->HorizontalResolution * 3; // Send 1 line @ 24 bits per pixel
-  Width = UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info->HorizontalResolution;
   Height = UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info->VerticalResolution;
-  SrcPtr = UsbDisplayLinkDev->Screen;
-  DstPtr = DstBuffer;
+  LinePtr = UsbDisplayLinkDev->WireScreen;
 
   for (H = 0; H < Height; H++) {
-    DstPtr = DstBuffer;
-
-    UINTN W;
-    for (W = 0; W < Width; W++) {
-      // Need to swap round the RGB values
-      DstPtr[0] = ((UINT8 *)SrcPtr)[2];
-      DstPtr[1] = ((UINT8 *)SrcPtr)[1];
-      DstPtr[2] = ((UINT8 *)SrcPtr)[0];
-      SrcPtr++;
-      DstPtr += 3;
-    }
-
-    Status = DlUsbBulkWrite (UsbDisplayLinkDev, DstBuffer, DataLen, &USBStatus);
+    Status = DlUsbBulkWrite (UsbDisplayLinkDev, LinePtr, DataLen, &USBStatus);
 
     // USBStatus values defined in usbio.h, e.g. EFI_USB_ERR_TIMEOUT 0x40
     if (EFI_ERROR (Status)) {
@@ -320,26 +422,23 @@ DlGopSendScreenUpdate (
     // Need an extra DlUsbBulkWrite if the data length is divisible by USB MaxPacketSize. This spare data will just get written into the (invisible) stride area.
     // Note that the API doesn't let us do a bulk write of 0.
     if ((DataLen & (UsbDisplayLinkDev->BulkOutEndpointDescriptor.MaxPacketSize - 1)) == 0) {
-      Status = DlUsbBulkWrite (UsbDisplayLinkDev, DstBuffer, 2, &USBStatus);
+      Status = DlUsbBulkWrite (UsbDisplayLinkDev, LinePtr, 2, &USBStatus);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "Screen update - USB bulk transfer of pixel data failed. Line %d len %d, failure code %r USB status x%x\n", H, DataLen, Status, USBStatus));
         break;
       }
     }
+    LinePtr += DataLen;
   }
 
-  if (!EFI_ERROR (Status)) {
-    // If we've successfully transmitted the frame, reset the values that store which area of the screen has been BLTted to.
-    // If we haven't succeeded, this will mean we'll try to resend it after the next poll period.
-    UsbDisplayLinkDev->LastY2 = 0;
-    UsbDisplayLinkDev->LastY1 = (UINTN)-1;
+  if (EFI_ERROR (Status)) {
+    // If we haven't succeeded, force a full screen update after the next poll period.
+    UsbDisplayLinkDev->TimeSinceLastScreenUpdate = DISPLAYLINK_FULL_SCREEN_UPDATE_PERIOD + 1;
   }
 
   // Payload with length of 1 to terminate the frame
   // We need to do this even if we had an error, to indicate to the DL device that it should now expect a new frame.
-  DlUsbBulkWrite (UsbDisplayLinkDev, DstBuffer, 1, &USBStatus);
-
-  gBS->RestoreTPL (OriginalTPL);
+  DlUsbBulkWrite (UsbDisplayLinkDev, UsbDisplayLinkDev->WireScreen, 1, &USBStatus);
 
   return Status;
 }
@@ -482,7 +581,23 @@ DisplayLinkSetMode (
     Gop->Mode->Info->VerticalResolution *
     sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
 
-  if (UsbDisplayLinkDev->Screen == NULL) {
+  if (UsbDisplayLinkDev->WireScreen != NULL) {
+    FreePool (UsbDisplayLinkDev->WireScreen);
+  }
+
+  UsbDisplayLinkDev->WireScreen = (UINT8*)AllocateZeroPool (
+    Gop->Mode->Info->HorizontalResolution *
+    Gop->Mode->Info->VerticalResolution * 3);
+
+  if ((UsbDisplayLinkDev->Screen == NULL) || (UsbDisplayLinkDev->WireScreen == NULL)) {
+    if (UsbDisplayLinkDev->Screen != NULL) {
+      FreePool (UsbDisplayLinkDev->Screen);
+      UsbDisplayLinkDev->Screen = NULL;
+    }
+    if (UsbDisplayLinkDev->WireScreen != NULL) {
+      FreePool (UsbDisplayLinkDev->WireScreen);
+      UsbDisplayLinkDev->WireScreen = NULL;
+    }
     return EFI_OUT_OF_RESOURCES;
   }
 
@@ -496,6 +611,8 @@ DisplayLinkSetMode (
     Gop->Mode->Mode = GRAPHICS_OUTPUT_INVALID_MODE_NUMBER;
     FreePool (UsbDisplayLinkDev->Screen);
     UsbDisplayLinkDev->Screen = NULL;
+    FreePool (UsbDisplayLinkDev->WireScreen);
+    UsbDisplayLinkDev->WireScreen = NULL;
   } else {
     BuildBackBuffer (
       UsbDisplayLinkDev,
@@ -515,7 +632,7 @@ DisplayLinkSetMode (
 }
 
 /**
- * Implementation of the GOP protocol Blt API function
+ * Copies or fills a rectangle of the back buffer; see DisplayLinkBlt
  * @param This            Pointer to the instance of the GOP protocol
  * @param BltBuffer
  * @param BltOperation
@@ -528,9 +645,8 @@ DisplayLinkSetMode (
  * @param Delta
  * @return
  */
-EFI_STATUS
-EFIAPI
-DisplayLinkBlt (
+STATIC EFI_STATUS
+DlGopBlt (
   IN  EFI_GRAPHICS_OUTPUT_PROTOCOL            *This,
   IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL           *BltBuffer, OPTIONAL
   IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION       BltOperation,
@@ -576,3 +692,46 @@ DisplayLinkBlt (
   return EFI_SUCCESS;
 }
 
+
+/**
+ * Implementation of the GOP protocol Blt API function, which also records
+ * the call in the GOP statistics. The USB transfer of the updated back
+ * buffer happens later, in DisplayLinkPeriodicTimer, and isn't included.
+ * @param This            Pointer to the instance of the GOP protocol
+ * @param BltBuffer
+ * @param BltOperation
+ * @param SourceX
+ * @param SourceY
+ * @param DestinationX
+ * @param DestinationY
+ * @param Width
+ * @param Height
+ * @param Delta
+ * @return
+ */
+EFI_STATUS
+EFIAPI
+DisplayLinkBlt (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL            *This,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL           *BltBuffer, OPTIONAL
+  IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION       BltOperation,
+  IN  UINTN                                   SourceX,
+  IN  UINTN                                   SourceY,
+  IN  UINTN                                   DestinationX,
+  IN  UINTN                                   DestinationY,
+  IN  UINTN                                   Width,
+  IN  UINTN                                   Height,
+  IN  UINTN                                   Delta         OPTIONAL
+)
+{
+  EFI_STATUS Status;
+  UINT64 StartTicks;
+
+  StartTicks = GopStatsStart ();
+  Status = DlGopBlt (This, BltBuffer, BltOperation, SourceX, SourceY, DestinationX, DestinationY, Width, Height, Delta);
+  GopStatsRecord (USB_DISPLAYLINK_DEV_FROM_GRAPHICS_OUTPUT_PROTOCOL(This)->GopStats,
+                  BltOperation, StartTicks, Status, Width, Height);
+
+  return Status;
+}
+
@@ -761,6 +761,12 @@ UsbDisplayLinkDriverBindingStart (
     goto ErrorExit8;
   }
 
+  // Statistics are optional, the display works without them
+  Status = GopStatsInstall (Controller, &UsbDisplayLinkDev->GopStats);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "No Blt statistics: %r\n", Status));
+  }
+
   UsbDisplayLinkDev->ControllerNameTable = (EFI_UNICODE_STRING_TABLE*)NULL;
 
   AddUnicodeString2 (
@@ -1030,6 +1036,9 @@ UsbDisplayLinkDriverBindingStop (
     DEBUG ((DEBUG_WARN, "Error resetting USB interface alternate setting - %r.\n", Status));
   }
 
+  GopStatsUninstall (Controller, UsbDisplayLinkDev->GopStats);
+  UsbDisplayLinkDev->GopStats = (GOP_STATS_CONTEXT*)NULL;
+
   Status = gBS->UninstallMultipleProtocolInterfaces (
                   Controller,
                   &gEfiGraphicsOutputProtocolGuid,
@@ -1065,6 +1074,11 @@ UsbDisplayLinkDriverBindingStop (
     UsbDisplayLinkDev->Screen = NULL;
   }
 
+  if (UsbDisplayLinkDev->WireScreen != NULL) {
+    FreePool (UsbDisplayLinkDev->WireScreen);
+    UsbDisplayLinkDev->WireScreen = NULL;
+  }
+
   if (UsbDisplayLinkDev->GraphicsOutputProtocol.Mode) {
     if (UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info) {
       FreePool (UsbDisplayLinkDev->GraphicsOutputProtocol.Mode->Info);
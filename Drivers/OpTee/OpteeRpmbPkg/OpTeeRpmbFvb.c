@@ -390,6 +390,13 @@ OpTeeRpmbFvbWrite (
   }
   Base = (VOID *)(UINTN)Instance->MemBaseAddress + (Lba * Instance->BlockSize) +
          Offset;
+
+  // The memory copy mirrors the RPMB contents, so there is no need for an
+  // SVC round trip if the data is already there
+  if (CompareMem (Base, Buffer, *NumBytes) == 0) {
+    return EFI_SUCCESS;
+  }
+
   Status = ReadWriteRpmb (
              SP_SVC_RPMB_WRITE,
              (UINTN)Buffer,
@@ -406,6 +413,32 @@ OpTeeRpmbFvbWrite (
   return Status;
 }
 
+/**
+  Check whether a range of the memory copy is in the erased state.
+
+  @param[in] Base      Start of the range
+  @param[in] NumBytes  Length of the range in bytes, a multiple of 8
+
+  @retval    TRUE      All bits of the range are set
+  @retval    FALSE     Some bits of the range are clear
+**/
+STATIC
+BOOLEAN
+IsErased (
+  IN CONST UINT64 *Base,
+  IN UINTN        NumBytes
+  )
+{
+  UINTN Index;
+
+  for (Index = 0; Index < NumBytes / sizeof (UINT64); Index++) {
+    if (Base[Index] != MAX_UINT64) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
 /**
   Erases and initializes a firmware volume block.
 
@@ -464,7 +497,6 @@ OpTeeRpmbFvbErase (
   UINTN   NumLba;
   EFI_LBA Start;
   VOID    *Base;
-  VOID    *Buf;
   VA_LIST Args;
   EFI_STATUS Status;
 
@@ -481,25 +513,28 @@ OpTeeRpmbFvbErase (
     NumBytes = NumLba * Instance->BlockSize;
     Base = (VOID *)(UINTN)Instance->MemBaseAddress +
            (Start * Instance->BlockSize);
-    Buf = AllocatePool (NumLba * Instance->BlockSize);
-    if (Buf == NULL) {
-      return EFI_DEVICE_ERROR;
+    // Blocks that are already erased don't need an SVC round trip
+    if (IsErased (Base, NumBytes)) {
+      continue;
     }
-    SetMem64 (Buf, NumLba * Instance->BlockSize, ~0UL);
-    // Write the device
+    // Update the in memory copy and write the device from it
+    SetMem64 (Base, NumBytes, ~0UL);
     Status = ReadWriteRpmb (
                SP_SVC_RPMB_WRITE,
-               (UINTN)Buf,
+               (UINTN)Base,
                NumBytes,
                Start * Instance->BlockSize
                );
     if (EFI_ERROR (Status)) {
-      FreePool (Buf);
+      // Bring the memory copy back in line with the device
+      ReadWriteRpmb (
+        SP_SVC_RPMB_READ,
+        (UINTN)Base,
+        NumBytes,
+        Start * Instance->BlockSize
+        );
       return Status;
     }
-    // Update the in memory copy
-    SetMem64 (Base, NumLba * Instance->BlockSize, ~0UL);
-    FreePool (Buf);
   }
 
   VA_END (Args);
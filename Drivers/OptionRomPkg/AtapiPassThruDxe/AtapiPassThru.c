@@ -239,6 +239,7 @@ Returns:
                     );
   if (!EFI_ERROR (Status)) {
     Supports &= (EFI_PCI_DEVICE_ENABLE               |
+                 EFI_PCI_IO_ATTRIBUTE_BUS_MASTER     |
                  EFI_PCI_IO_ATTRIBUTE_IDE_PRIMARY_IO |
                  EFI_PCI_IO_ATTRIBUTE_IDE_SECONDARY_IO);
     Status = PciIo->Attributes (
@@ -386,6 +387,8 @@ Returns:
          Controller
          );
 
+  FreeAtapiBusMaster (AtapiScsiPrivate);
+
   gBS->FreePool (AtapiScsiPrivate);
 
   return EFI_SUCCESS;
@@ -442,6 +445,8 @@ Returns:
 
   InitAtapiIoPortRegisters(AtapiScsiPrivate, IdeRegsBaseAddr);
 
+  InitAtapiBusMaster (AtapiScsiPrivate);
+
   //
   // Initialize the LatestTargetId to MAX_TARGET_ID.
   //
@@ -449,6 +454,9 @@ Returns:
   AtapiScsiPrivate->LatestLun       = 0;
 
   Status = InstallScsiPassThruProtocols (&Controller, AtapiScsiPrivate);
+  if (EFI_ERROR (Status)) {
+    FreeAtapiBusMaster (AtapiScsiPrivate);
+  }
 
   return Status;
 }
@@ -1675,6 +1683,137 @@ Returns:
 
 }
 
+VOID
+InitAtapiBusMaster (
+  IN  ATAPI_SCSI_PASS_THRU_DEV     *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Detect the Bus Master IDE function and allocate a PRD table for each
+  channel. Channels without a PRD table fall back to PIO.
+
+Arguments:
+
+  AtapiScsiPrivate            - The pointer of ATAPI_SCSI_PASS_THRU_DEV
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_STATUS          Status;
+  EFI_PCI_IO_PROTOCOL *PciIo;
+  PCI_TYPE00          PciData;
+  ATAPI_BUS_MASTER    *BusMaster;
+  UINT8               IdeChannel;
+  UINTN               Bytes;
+  VOID                *Buffer;
+
+  PciIo = AtapiScsiPrivate->PciIo;
+
+  Status = PciIo->Pci.Read (
+                        PciIo,
+                        EfiPciIoWidthUint8,
+                        0,
+                        sizeof (PciData),
+                        &PciData
+                        );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  //
+  // The Bus Master IDE registers live in an IO BAR
+  //
+  if ((PciData.Hdr.ClassCode[0] & IDE_BUS_MASTER_CAPABLE) == 0 ||
+      (PciData.Device.Bar[BUS_MASTER_BAR_INDEX] & BIT0) == 0) {
+    return;
+  }
+
+  for (IdeChannel = 0; IdeChannel < ATAPI_MAX_CHANNEL; IdeChannel++) {
+
+    BusMaster         = &AtapiScsiPrivate->BusMaster[IdeChannel];
+    BusMaster->Offset = (UINT8) (IdeChannel * BUS_MASTER_CHANNEL_SIZE);
+
+    Status = PciIo->AllocateBuffer (
+                      PciIo,
+                      AllocateAnyPages,
+                      EfiBootServicesData,
+                      ATAPI_PRD_TABLE_PAGES,
+                      &Buffer,
+                      0
+                      );
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    //
+    // Without the dual address cycle attribute the table is mapped below 4GB
+    //
+    Bytes  = EFI_PAGES_TO_SIZE (ATAPI_PRD_TABLE_PAGES);
+    Status = PciIo->Map (
+                      PciIo,
+                      EfiPciIoOperationBusMasterCommonBuffer,
+                      Buffer,
+                      &Bytes,
+                      &BusMaster->PrdTableDeviceAddress,
+                      &BusMaster->PrdTableMap
+                      );
+    if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (ATAPI_PRD_TABLE_PAGES))) {
+      if (!EFI_ERROR (Status)) {
+        PciIo->Unmap (PciIo, BusMaster->PrdTableMap);
+      }
+      PciIo->FreeBuffer (PciIo, ATAPI_PRD_TABLE_PAGES, Buffer);
+      continue;
+    }
+
+    ZeroMem (Buffer, EFI_PAGES_TO_SIZE (ATAPI_PRD_TABLE_PAGES));
+    BusMaster->PrdTable = Buffer;
+    BusMaster->Present  = TRUE;
+  }
+}
+
+VOID
+FreeAtapiBusMaster (
+  IN  ATAPI_SCSI_PASS_THRU_DEV     *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Free the PRD tables allocated by InitAtapiBusMaster().
+
+Arguments:
+
+  AtapiScsiPrivate            - The pointer of ATAPI_SCSI_PASS_THRU_DEV
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_PCI_IO_PROTOCOL *PciIo;
+  ATAPI_BUS_MASTER    *BusMaster;
+  UINT8               IdeChannel;
+
+  PciIo = AtapiScsiPrivate->PciIo;
+
+  for (IdeChannel = 0; IdeChannel < ATAPI_MAX_CHANNEL; IdeChannel++) {
+    BusMaster = &AtapiScsiPrivate->BusMaster[IdeChannel];
+    if (!BusMaster->Present) {
+      continue;
+    }
+
+    PciIo->Unmap (PciIo, BusMaster->PrdTableMap);
+    PciIo->FreeBuffer (PciIo, ATAPI_PRD_TABLE_PAGES, BusMaster->PrdTable);
+    BusMaster->Present = FALSE;
+  }
+}
+
 
 EFI_STATUS
 CheckSCSIRequestPacket (
@@ -2174,6 +2313,8 @@ Returns:
   UINT16      *CommandIndex;
   UINT8       Count;
   EFI_STATUS  Status;
+  VOID        *DataMap;
+  BOOLEAN     UseDma;
 
   //
   // Set all the command parameters by fill related registers.
@@ -2210,12 +2351,27 @@ Returns:
   }
 
   //
-  // No OVL; No DMA (by setting feature register)
+  // Block data commands go through the bus master when the channel and
+  // device support it, anything else is transferred by PIO.
+  //
+  DataMap = NULL;
+  UseDma  = (BOOLEAN) !EFI_ERROR (AtapiPassThruDmaPrepare (
+                                    AtapiScsiPrivate,
+                                    Target,
+                                    PacketCommand,
+                                    Buffer,
+                                    *ByteCount,
+                                    Direction,
+                                    &DataMap
+                                    ));
+
+  //
+  // No OVL; DMA only for the bus master data phase (by setting feature register)
   //
   WritePortB (
     AtapiScsiPrivate->PciIo,
     AtapiScsiPrivate->IoPort->Reg1.Feature,
-    0x00
+    (UINT8) (UseDma ? DMA : 0x00)
     );
 
   //
@@ -2235,12 +2391,13 @@ Returns:
 
   //
   //  DEFAULT_CTL:0x0a (0000,1010)
-  //  Disable interrupt
+  //  Disable interrupt. The bus master only latches completion in BMIS
+  //  while the device drives INTRQ, so leave it enabled for DMA.
   //
   WritePortB (
     AtapiScsiPrivate->PciIo,
     AtapiScsiPrivate->IoPort->Alt.DeviceControl,
-    DEFAULT_CTL
+    (UINT8) (UseDma ? (DEFAULT_CTL & ~IEN_L) : DEFAULT_CTL)
     );
 
   //
@@ -2264,6 +2421,9 @@ Returns:
       Status = EFI_DEVICE_ERROR;
     }
 
+    if (UseDma) {
+      AtapiPassThruDmaStop (AtapiScsiPrivate, DataMap);
+    }
     *ByteCount = 0;
     return Status;
   }
@@ -2276,6 +2436,15 @@ Returns:
     WritePortW (AtapiScsiPrivate->PciIo, AtapiScsiPrivate->IoPort->Data, *CommandIndex);
   }
 
+  if (UseDma) {
+    return AtapiPassThruDmaReadWriteData (
+            AtapiScsiPrivate,
+            DataMap,
+            ByteCount,
+            TimeoutInMicroSeconds
+            );
+  }
+
   //
   // call AtapiPassThruPioReadWriteData() function to get
   // requested transfer data form device.
@@ -2416,6 +2585,394 @@ Arguments:
 }
 
 
+EFI_STATUS
+AtapiPassThruDmaPrepare (
+  ATAPI_SCSI_PASS_THRU_DEV  *AtapiScsiPrivate,
+  UINT32                    Target,
+  UINT8                     *PacketCommand,
+  VOID                      *Buffer,
+  UINT32                    ByteCount,
+  DATA_DIRECTION            Direction,
+  VOID                      **DataMap
+  )
+/*++
+
+Routine Description:
+
+  Maps the data buffer and programs the Bus Master IDE registers of the
+  current channel for a DMA data phase. Only block data commands are
+  transferred by DMA, everything else keeps using PIO.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Target:             The Target ID of the ATAPI device.
+  PacketCommand:      Points to the ATAPI command packet.
+  Buffer:             Points to the transferred data.
+  ByteCount:          The buffer size.
+  Direction:          Indicates the data transfer direction.
+  DataMap:            Returns the mapping of the data buffer.
+
+Returns:
+
+  EFI_SUCCESS         The channel is ready for the DMA data phase.
+  EFI_UNSUPPORTED     The command must be transferred by PIO.
+
+--*/
+{
+  EFI_STATUS                      Status;
+  EFI_PCI_IO_PROTOCOL             *PciIo;
+  ATAPI_BUS_MASTER                *BusMaster;
+  EFI_PCI_IO_PROTOCOL_OPERATION   Operation;
+  EFI_PHYSICAL_ADDRESS            DeviceAddress;
+  UINTN                           MappedLength;
+  UINT32                          Remaining;
+  UINT32                          Length;
+  UINT32                          PrdTableAddr;
+  UINTN                           Index;
+  UINT8                           BmCommand;
+  UINT8                           BmStatus;
+
+  *DataMap  = NULL;
+  PciIo     = AtapiScsiPrivate->PciIo;
+  BusMaster = ATAPI_CURRENT_BUS_MASTER (AtapiScsiPrivate);
+
+  if (!BusMaster->Present || (Buffer == NULL) || (ByteCount == 0) || ((ByteCount & 1) != 0)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  switch (PacketCommand[0]) {
+  case OP_READ_10:
+  case OP_READ_12:
+  case OP_WRITE_10:
+  case OP_WRITE_12:
+    break;
+
+  default:
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Whoever configured the transfer mode of the device reports in BMIS
+  // whether it may be driven by DMA.
+  //
+  PciIo->Io.Read (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIS_OFFSET,
+              1,
+              &BmStatus
+              );
+  if ((BmStatus & ((Target == 0) ? BMIS_DRV0_DMA_CAPABLE : BMIS_DRV1_DMA_CAPABLE)) == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (Direction == DataIn) {
+    Operation = EfiPciIoOperationBusMasterWrite;
+    BmCommand = (UINT8) BMIC_NREAD;
+  } else {
+    Operation = EfiPciIoOperationBusMasterRead;
+    BmCommand = 0;
+  }
+
+  MappedLength = ByteCount;
+  Status = PciIo->Map (
+                    PciIo,
+                    Operation,
+                    Buffer,
+                    &MappedLength,
+                    &DeviceAddress,
+                    DataMap
+                    );
+  if (EFI_ERROR (Status)) {
+    *DataMap = NULL;
+    return EFI_UNSUPPORTED;
+  }
+
+  if ((MappedLength != ByteCount) ||
+      ((DeviceAddress & 1) != 0) ||
+      ((DeviceAddress + ByteCount) > SIZE_4GB)) {
+    goto Unsupported;
+  }
+
+  //
+  // Build the PRD table, splitting the buffer at every 64KB boundary.
+  //
+  Remaining = ByteCount;
+  Index     = 0;
+  while (Remaining > 0) {
+    if (Index == ATAPI_PRD_MAX_ENTRIES) {
+      goto Unsupported;
+    }
+
+    Length = ATAPI_PRD_MAX_LENGTH - (UINT32) (DeviceAddress & (ATAPI_PRD_MAX_LENGTH - 1));
+    if (Length > Remaining) {
+      Length = Remaining;
+    }
+
+    //
+    // A 64KB region is encoded as a byte count of 0.
+    //
+    BusMaster->PrdTable[Index].RegionBaseAddr = (UINT32) DeviceAddress;
+    BusMaster->PrdTable[Index].ByteCount      = (UINT16) Length;
+    BusMaster->PrdTable[Index].EndOfTable     = 0;
+
+    DeviceAddress += Length;
+    Remaining     -= Length;
+    Index++;
+  }
+  BusMaster->PrdTable[Index - 1].EndOfTable = ATAPI_PRD_EOT;
+
+  //
+  // Program direction and descriptor table with the bus master stopped,
+  // then clear the latched interrupt and error bits.
+  //
+  PciIo->Io.Write (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIC_OFFSET,
+              1,
+              &BmCommand
+              );
+
+  PrdTableAddr = (UINT32) BusMaster->PrdTableDeviceAddress;
+  PciIo->Io.Write (
+              PciIo,
+              EfiPciIoWidthUint32,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMID_OFFSET,
+              1,
+              &PrdTableAddr
+              );
+
+  BmStatus |= BMIS_INTERRUPT | BMIS_ERROR;
+  PciIo->Io.Write (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIS_OFFSET,
+              1,
+              &BmStatus
+              );
+
+  return EFI_SUCCESS;
+
+Unsupported:
+  PciIo->Unmap (PciIo, *DataMap);
+  *DataMap = NULL;
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+AtapiPassThruDmaReadWriteData (
+  ATAPI_SCSI_PASS_THRU_DEV  *AtapiScsiPrivate,
+  VOID                      *DataMap,
+  UINT32                    *ByteCount,
+  UINT64                    TimeoutInMicroSeconds
+  )
+/*++
+
+Routine Description:
+
+  Starts the bus master after the ATAPI command packet is sent, waits for
+  the data phase to finish and releases the data buffer mapping.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  DataMap:            The mapping returned by AtapiPassThruDmaPrepare().
+  ByteCount:          Set to 0 if the transfer failed.
+  TimeoutInMicroSeconds:
+                      The timeout, in micro second units, to use for the
+                      execution of this ATAPI command.
+                      A TimeoutInMicroSeconds value of 0 means that
+                      this function will wait indefinitely for the ATAPI
+                      command to execute.
+
+Returns:
+
+  EFI_STATUS
+
+--*/
+{
+  EFI_STATUS            Status;
+  EFI_PCI_IO_PROTOCOL   *PciIo;
+  ATAPI_BUS_MASTER      *BusMaster;
+  UINT64                Delay;
+  UINT8                 BmCommand;
+  UINT8                 BmStatus;
+
+  PciIo     = AtapiScsiPrivate->PciIo;
+  BusMaster = ATAPI_CURRENT_BUS_MASTER (AtapiScsiPrivate);
+
+  PciIo->Io.Read (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIC_OFFSET,
+              1,
+              &BmCommand
+              );
+  BmCommand |= (UINT8) BMIC_START;
+  PciIo->Io.Write (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIC_OFFSET,
+              1,
+              &BmCommand
+              );
+
+  if (TimeoutInMicroSeconds == 0) {
+    Delay = 2;
+  } else {
+    Delay = DivU64x32 (TimeoutInMicroSeconds, (UINT32) 30) + 1;
+  }
+
+  //
+  // The device raises INTRQ once the data phase and status are complete,
+  // which the bus master latches in BMIS.
+  //
+  do {
+
+    PciIo->Io.Read (
+                PciIo,
+                EfiPciIoWidthUint8,
+                BUS_MASTER_BAR_INDEX,
+                BusMaster->Offset + BMIS_OFFSET,
+                1,
+                &BmStatus
+                );
+    if ((BmStatus & (BMIS_INTERRUPT | BMIS_ERROR)) != 0) {
+      break;
+    }
+
+    //
+    // Stall for 30 us
+    //
+    gBS->Stall (30);
+
+    //
+    // Loop infinitely if not meeting expected condition
+    //
+    if (TimeoutInMicroSeconds == 0) {
+      Delay = 2;
+    }
+
+    Delay--;
+  } while (Delay);
+
+  AtapiPassThruDmaStop (AtapiScsiPrivate, DataMap);
+
+  if (Delay == 0) {
+    *ByteCount = 0;
+    return EFI_TIMEOUT;
+  }
+
+  if ((BmStatus & BMIS_ERROR) != 0) {
+    *ByteCount = 0;
+    return EFI_DEVICE_ERROR;
+  }
+
+  //
+  // Reading the status register also acknowledges INTRQ.
+  //
+  Status = StatusWaitForBSYClear (AtapiScsiPrivate, TimeoutInMicroSeconds);
+  if (EFI_ERROR (Status)) {
+    *ByteCount = 0;
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = AtapiPassThruCheckErrorStatus (AtapiScsiPrivate);
+  if (EFI_ERROR (Status)) {
+    *ByteCount = 0;
+  }
+
+  return Status;
+}
+
+VOID
+AtapiPassThruDmaStop (
+  ATAPI_SCSI_PASS_THRU_DEV  *AtapiScsiPrivate,
+  VOID                      *DataMap
+  )
+/*++
+
+Routine Description:
+
+  Stops the bus master of the current channel and releases the data
+  buffer mapping.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  DataMap:            The mapping returned by AtapiPassThruDmaPrepare().
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_PCI_IO_PROTOCOL   *PciIo;
+  ATAPI_BUS_MASTER      *BusMaster;
+  UINT8                 BmCommand;
+  UINT8                 BmStatus;
+
+  PciIo     = AtapiScsiPrivate->PciIo;
+  BusMaster = ATAPI_CURRENT_BUS_MASTER (AtapiScsiPrivate);
+
+  PciIo->Io.Read (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIC_OFFSET,
+              1,
+              &BmCommand
+              );
+  BmCommand &= (UINT8) ~BMIC_START;
+  PciIo->Io.Write (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIC_OFFSET,
+              1,
+              &BmCommand
+              );
+
+  PciIo->Io.Read (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIS_OFFSET,
+              1,
+              &BmStatus
+              );
+  BmStatus |= BMIS_INTERRUPT | BMIS_ERROR;
+  PciIo->Io.Write (
+              PciIo,
+              EfiPciIoWidthUint8,
+              BUS_MASTER_BAR_INDEX,
+              BusMaster->Offset + BMIS_OFFSET,
+              1,
+              &BmStatus
+              );
+
+  PciIo->Unmap (PciIo, DataMap);
+
+  //
+  // Disable interrupt again
+  //
+  WritePortB (
+    PciIo,
+    AtapiScsiPrivate->IoPort->Alt.DeviceControl,
+    DEFAULT_CTL
+    );
+}
+
+
 UINT8
 ReadPortB (
   IN  EFI_PCI_IO_PROTOCOL   *PciIo,
@@ -68,10 +68,58 @@ typedef enum {
 #define IDE_PRIMARY_PROGRAMMABLE_INDICATOR    BIT1
 #define IDE_SECONDARY_OPERATING_MODE          BIT2
 #define IDE_SECONDARY_PROGRAMMABLE_INDICATOR  BIT3
+#define IDE_BUS_MASTER_CAPABLE                BIT7
 
 
 #define ATAPI_MAX_CHANNEL 2
 
+//
+// Bus Master IDE registers, BAR4 holds the primary channel at offset 0
+// and the secondary channel at offset 8
+//
+#define BUS_MASTER_BAR_INDEX      4
+#define BUS_MASTER_CHANNEL_SIZE   8
+
+#define BMIC_OFFSET               0x00  ///< Bus Master IDE Command
+#define BMIS_OFFSET               0x02  ///< Bus Master IDE Status
+#define BMID_OFFSET               0x04  ///< Bus Master IDE Descriptor Table Pointer
+
+#define BMIC_START                BIT0
+#define BMIC_NREAD                BIT3  ///< Bus master writes to memory
+
+#define BMIS_ACTIVE               BIT0
+#define BMIS_ERROR                BIT1
+#define BMIS_INTERRUPT            BIT2
+#define BMIS_DRV0_DMA_CAPABLE     BIT5
+#define BMIS_DRV1_DMA_CAPABLE     BIT6
+
+///
+/// Physical Region Descriptor, a region must not cross a 64KB boundary
+///
+#pragma pack(1)
+typedef struct {
+  UINT32  RegionBaseAddr;
+  UINT16  ByteCount;                    ///< 0 means 64KB
+  UINT16  EndOfTable;
+} ATAPI_PRD_ENTRY;
+#pragma pack()
+
+#define ATAPI_PRD_EOT             BIT15
+#define ATAPI_PRD_MAX_LENGTH      SIZE_64KB
+#define ATAPI_PRD_TABLE_PAGES     1
+#define ATAPI_PRD_MAX_ENTRIES     (EFI_PAGES_TO_SIZE (ATAPI_PRD_TABLE_PAGES) / sizeof (ATAPI_PRD_ENTRY))
+
+///
+/// Per channel Bus Master IDE state
+///
+typedef struct {
+  BOOLEAN                 Present;
+  UINT8                   Offset;       ///< Offset of the channel's registers in BAR4
+  ATAPI_PRD_ENTRY         *PrdTable;
+  EFI_PHYSICAL_ADDRESS    PrdTableDeviceAddress;
+  VOID                    *PrdTableMap;
+} ATAPI_BUS_MASTER;
+
 ///
 /// IDE registers set
 ///
@@ -102,6 +150,7 @@ typedef struct {
   //
   IDE_BASE_REGISTERS               *IoPort;
   IDE_BASE_REGISTERS               AtapiIoPortRegisters[2];
+  ATAPI_BUS_MASTER                 BusMaster[ATAPI_MAX_CHANNEL];
   UINT32                           LatestTargetId;
   UINT64                           LatestLun;
 } ATAPI_SCSI_PASS_THRU_DEV;
@@ -128,6 +177,12 @@ typedef struct {
       ATAPI_SCSI_PASS_THRU_DEV_SIGNATURE \
       )
 
+//
+// Bus Master IDE state of the channel selected by IoPort
+//
+#define ATAPI_CURRENT_BUS_MASTER(a) \
+  (&(a)->BusMaster[(a)->IoPort - (a)->AtapiIoPortRegisters])
+
 //
 // Global Variables
 //
@@ -1176,6 +1231,99 @@ Returns:
 --*/
 ;
 
+EFI_STATUS
+AtapiPassThruDmaPrepare (
+  ATAPI_SCSI_PASS_THRU_DEV  *AtapiScsiPrivate,
+  UINT32                    Target,
+  UINT8                     *PacketCommand,
+  VOID                      *Buffer,
+  UINT32                    ByteCount,
+  DATA_DIRECTION            Direction,
+  VOID                      **DataMap
+  )
+/*++
+
+Routine Description:
+
+  Maps the data buffer and programs the Bus Master IDE registers of the
+  current channel for a DMA data phase. Only block data commands are
+  transferred by DMA, everything else keeps using PIO.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  Target:             The Target ID of the ATAPI device.
+  PacketCommand:      Points to the ATAPI command packet.
+  Buffer:             Points to the transferred data.
+  ByteCount:          The buffer size.
+  Direction:          Indicates the data transfer direction.
+  DataMap:            Returns the mapping of the data buffer.
+
+Returns:
+
+  EFI_SUCCESS         The channel is ready for the DMA data phase.
+  EFI_UNSUPPORTED     The command must be transferred by PIO.
+
+--*/
+;
+
+EFI_STATUS
+AtapiPassThruDmaReadWriteData (
+  ATAPI_SCSI_PASS_THRU_DEV  *AtapiScsiPrivate,
+  VOID                      *DataMap,
+  UINT32                    *ByteCount,
+  UINT64                    TimeOutInMicroSeconds
+  )
+/*++
+
+Routine Description:
+
+  Starts the bus master after the ATAPI command packet is sent, waits for
+  the data phase to finish and releases the data buffer mapping.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  DataMap:            The mapping returned by AtapiPassThruDmaPrepare().
+  ByteCount:          Set to 0 if the transfer failed.
+  TimeoutInMicroSeconds:
+                      The timeout, in micro second units, to use for the
+                      execution of this ATAPI command.
+                      A TimeoutInMicroSeconds value of 0 means that
+                      this function will wait indefinitely for the ATAPI
+                      command to execute.
+
+Returns:
+
+  EFI_STATUS
+
+--*/
+;
+
+VOID
+AtapiPassThruDmaStop (
+  ATAPI_SCSI_PASS_THRU_DEV  *AtapiScsiPrivate,
+  VOID                      *DataMap
+  )
+/*++
+
+Routine Description:
+
+  Stops the bus master of the current channel and releases the data
+  buffer mapping.
+
+Arguments:
+
+  AtapiScsiPrivate:   Private data structure for the specified channel.
+  DataMap:            The mapping returned by AtapiPassThruDmaPrepare().
+
+Returns:
+
+  None
+
+--*/
+;
+
 
 UINT8
 ReadPortB (
@@ -1596,6 +1744,49 @@ Returns:
 --*/  
 ;
 
+VOID
+InitAtapiBusMaster (
+  IN  ATAPI_SCSI_PASS_THRU_DEV     *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Detect the Bus Master IDE function and allocate a PRD table for each
+  channel. Channels without a PRD table fall back to PIO.
+
+Arguments:
+
+  AtapiScsiPrivate            - The pointer of ATAPI_SCSI_PASS_THRU_DEV
+
+Returns:
+
+  None
+
+--*/
+;
+
+VOID
+FreeAtapiBusMaster (
+  IN  ATAPI_SCSI_PASS_THRU_DEV     *AtapiScsiPrivate
+  )
+/*++
+
+Routine Description:
+
+  Free the PRD tables allocated by InitAtapiBusMaster().
+
+Arguments:
+
+  AtapiScsiPrivate            - The pointer of ATAPI_SCSI_PASS_THRU_DEV
+
+Returns:
+
+  None
+
+--*/
+;
+
 /**
   Installs Scsi Pass Thru and/or Ext Scsi Pass Thru 
   protocols based on feature flags. 
@@ -408,6 +408,77 @@ UsbSerialDriverCheckInput (
   }
 }
 
+/**
+  Sends the data coalesced by WriteSerialIo to the device in a single bulk
+  transfer.
+
+  @param  UsbSerialDevice[in]        Handle to the USB device to write to
+
+  @retval EFI_SUCCESS                The buffered data was written, or there was
+                                     none.
+  @retval EFI_DEVICE_ERROR           The device reported an error.
+  @retval EFI_TIMEOUT                The data write was stopped due to a timeout.
+
+**/
+EFI_STATUS
+EFIAPI
+FlushWriteBuffer (
+  IN USB_SER_DEV  *UsbSerialDevice
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       BufferSize;
+  EFI_TPL     Tpl;
+
+  Tpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  BufferSize = UsbSerialDevice->WriteBufferCount;
+  UsbSerialDevice->WriteBufferCount = 0;
+
+  if (UsbSerialDevice->Shutdown) {
+    gBS->RestoreTPL (Tpl);
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = UsbSerialDataTransfer (
+             UsbSerialDevice,
+             EfiUsbDataOut,
+             UsbSerialDevice->WriteBuffer,
+             &BufferSize,
+             FTDI_TIMEOUT
+             );
+
+  gBS->RestoreTPL (Tpl);
+  if (EFI_ERROR (Status)) {
+    if (Status == EFI_TIMEOUT){
+      return Status;
+    } else {
+      return EFI_DEVICE_ERROR;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  UsbSerialDriverFlushOutput.
+  sends any output that WriteSerialIo has buffered once no more data has been
+  written for WRITE_FLUSH_DELAY.
+
+  @param  Event[in]
+  @param  Context[in]....The current instance of the USB serial device
+
+**/
+VOID
+EFIAPI
+UsbSerialDriverFlushOutput (
+  IN  EFI_EVENT  Event,
+  IN  VOID       *Context
+  )
+{
+  FlushWriteBuffer ((USB_SER_DEV*)Context);
+}
+
 /**
   Encodes the baud rate into the format expected by the Ftdi device.
 
@@ -2015,6 +2086,18 @@ UsbSerialDriverBindingStart (
          EFI_TIMER_PERIOD_MILLISECONDS (500)
          );
 
+  //
+  // Create the timer that sends coalesced output
+  //
+  UsbSerialDevice->WriteBufferCount = 0;
+  gBS->CreateEvent (
+         EVT_TIMER | EVT_NOTIFY_SIGNAL,
+         TPL_CALLBACK,
+         UsbSerialDriverFlushOutput,
+         UsbSerialDevice,
+         &(UsbSerialDevice->FlushTimer)
+         );
+
   //
   // Check if the remaining device path is null. If it is not null change the settings
   // of the device to match those on the device path
@@ -2218,6 +2301,8 @@ UsbSerialDriverBindingStop (
                0
                );
         gBS->CloseEvent (UsbSerialDevice->PollingLoop);
+        gBS->CloseEvent (UsbSerialDevice->FlushTimer);
+        FlushWriteBuffer (UsbSerialDevice);
         UsbSerialDevice->Shutdown = TRUE;
         FreeUnicodeStringTable (UsbSerialDevice->ControllerNameTable);
         FreePool (UsbSerialDevice->DataBuffer);
@@ -2258,6 +2343,13 @@ SerialReset (
   USB_SER_DEV  *UsbSerialDevice;
 
   UsbSerialDevice = USB_SER_DEV_FROM_THIS (This);
+
+  //
+  // The reset purges the device's transmit FIFO, drop buffered output with it
+  //
+  gBS->SetTimer (UsbSerialDevice->FlushTimer, TimerCancel, 0);
+  UsbSerialDevice->WriteBufferCount = 0;
+
   Status          = ResetInternal (UsbSerialDevice);
   if (EFI_ERROR (Status)){
     return EFI_DEVICE_ERROR;
@@ -2389,6 +2481,12 @@ SetAttributes (
 
   UsbSerialDevice = USB_SER_DEV_FROM_THIS (This);
 
+  //
+  // Send the output written with the previous attributes first
+  //
+  gBS->SetTimer (UsbSerialDevice->FlushTimer, TimerCancel, 0);
+  FlushWriteBuffer (UsbSerialDevice);
+
   Status = SetAttributesInternal (
              UsbSerialDevice,
              BaudRate,
@@ -2550,6 +2648,8 @@ WriteSerialIo (
   EFI_STATUS   Status;
   USB_SER_DEV  *UsbSerialDevice;
   EFI_TPL      Tpl;
+  UINTN        Written;
+  UINTN        Length;
 
   UsbSerialDevice = USB_SER_DEV_FROM_THIS (This);
 
@@ -2557,24 +2657,48 @@ WriteSerialIo (
     return EFI_DEVICE_ERROR;
   }
 
+  Status  = EFI_SUCCESS;
+  Written = 0;
+
   Tpl = gBS->RaiseTPL (TPL_NOTIFY);
 
-  Status = UsbSerialDataTransfer (
-             UsbSerialDevice,
-             EfiUsbDataOut,
-             Buffer,
-             BufferSize,
-             FTDI_TIMEOUT
-             );
+  //
+  // Consoles tend to write a few bytes at a time, each of which would cost a
+  // USB transfer of its own: coalesce them, and send the buffer when it is
+  // full, at the end of a line, or when nothing more has been written for
+  // WRITE_FLUSH_DELAY
+  //
+  while (Written < *BufferSize) {
+    Length = MIN (
+               *BufferSize - Written,
+               SW_WRITE_BUFFER_SIZE - UsbSerialDevice->WriteBufferCount
+               );
+    CopyMem (
+      &UsbSerialDevice->WriteBuffer[UsbSerialDevice->WriteBufferCount],
+      (UINT8 *)Buffer + Written,
+      Length
+      );
+    UsbSerialDevice->WriteBufferCount += Length;
+    Written                           += Length;
 
-  gBS->RestoreTPL (Tpl);
-  if (EFI_ERROR (Status)) {
-    if (Status == EFI_TIMEOUT){
-      return Status;
-    } else {
-      return EFI_DEVICE_ERROR;
+    if (UsbSerialDevice->WriteBufferCount == SW_WRITE_BUFFER_SIZE) {
+      Status = FlushWriteBuffer (UsbSerialDevice);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
     }
   }
 
-  return EFI_SUCCESS;
+  if (!EFI_ERROR (Status) && (Written != 0) &&
+      (((UINT8 *)Buffer)[Written - 1] == '\n')) {
+    gBS->SetTimer (UsbSerialDevice->FlushTimer, TimerCancel, 0);
+    Status = FlushWriteBuffer (UsbSerialDevice);
+  } else if (UsbSerialDevice->WriteBufferCount != 0) {
+    gBS->SetTimer (UsbSerialDevice->FlushTimer, TimerRelative, WRITE_FLUSH_DELAY);
+  }
+
+  gBS->RestoreTPL (Tpl);
+
+  *BufferSize = Written;
+  return Status;
 }
@@ -172,6 +172,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 #define SW_FIFO_DEPTH 1024
 
+//
+// Size of the buffer used to coalesce writes into a single USB transfer, and
+// how long buffered output may wait for more data before it is sent
+//
+#define SW_WRITE_BUFFER_SIZE  512
+#define WRITE_FLUSH_DELAY     EFI_TIMER_PERIOD_MILLISECONDS (10)
+
 //
 // struct to define a usb device as a vendor and product id pair
 //
@@ -245,6 +252,9 @@ typedef struct {
   CONTROL_BITS                  ControlValues;
   STATUS_BITS                   StatusValues;
   UINT8                         ReadBuffer[512];
+  EFI_EVENT                     FlushTimer;
+  UINTN                         WriteBufferCount;
+  UINT8                         WriteBuffer[SW_WRITE_BUFFER_SIZE];
 } USB_SER_DEV;
 
 #define USB_SER_DEV_FROM_THIS(a) \
@@ -409,6 +409,13 @@ CirrusLogic5430ControllerDriverStart (
                       &Private->EdidActive,
                       NULL
                       );
+
+      //
+      // Statistics are optional, the display works without them
+      //
+      if (!EFI_ERROR (Status)) {
+        GopStatsInstall (Private->Handle, &Private->GopStats);
+      }
     }
   } else {
     //
@@ -496,6 +503,8 @@ CirrusLogic5430ControllerDriverStop (
 
     if (FeaturePcdGet (PcdSupportGop)) {
       CirrusLogic5430GraphicsOutputDestructor (Private);
+      GopStatsUninstall (Private->Handle, Private->GopStats);
+      Private->GopStats = NULL;
       //
       // Remove the UGA and GOP protocol interface from the system
       //
@@ -537,6 +546,8 @@ CirrusLogic5430ControllerDriverStop (
     Private = CIRRUS_LOGIC_5430_PRIVATE_DATA_FROM_GRAPHICS_OUTPUT_THIS (GraphicsOutput);
 
     CirrusLogic5430GraphicsOutputDestructor (Private);
+    GopStatsUninstall (Private->Handle, Private->GopStats);
+    Private->GopStats = NULL;
     //
     // Remove the GOP protocol interface from the system
     //
@@ -706,6 +717,191 @@ inw (
   return Data;
 }
 
+/**
+  Program the BitBLT engine with a rectangle operation, start it and wait for
+  it to complete. All offsets and sizes are in bytes, which are pixels in the
+  256 color modes this driver uses.
+
+  @param  Private            Driver private data.
+  @param  DestinationOffset  Frame buffer offset of the first destination byte.
+  @param  SourceOffset       Frame buffer offset of the first source byte.
+  @param  Width              Width of the rectangle, must not be zero.
+  @param  Height             Height of the rectangle, must not be zero.
+  @param  DestinationPitch   Bytes between two destination lines.
+  @param  SourcePitch        Bytes between two source lines.
+  @param  Mode               Value of the BLT mode register.
+  @param  ModeExtension      Value of the BLT mode extension register.
+
+**/
+STATIC
+VOID
+CirrusLogic5430BitBlt (
+  CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private,
+  UINTN                           DestinationOffset,
+  UINTN                           SourceOffset,
+  UINTN                           Width,
+  UINTN                           Height,
+  UINTN                           DestinationPitch,
+  UINTN                           SourcePitch,
+  UINT8                           Mode,
+  UINT8                           ModeExtension
+  )
+{
+  //
+  // The engine takes the width and the height minus one
+  //
+  Width--;
+  Height--;
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Width << 8) & 0xff00) | BLT_WIDTH_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Width & 0xff00) | (BLT_WIDTH_REGISTER + 1)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Height << 8) & 0xff00) | BLT_HEIGHT_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Height & 0xff00) | (BLT_HEIGHT_REGISTER + 1)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((DestinationPitch << 8) & 0xff00) | BLT_DEST_PITCH_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((DestinationPitch & 0xff00) | (BLT_DEST_PITCH_REGISTER + 1)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((SourcePitch << 8) & 0xff00) | BLT_SOURCE_PITCH_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((SourcePitch & 0xff00) | (BLT_SOURCE_PITCH_REGISTER + 1)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((DestinationOffset << 8) & 0xff00) | BLT_DEST_ADDRESS_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((DestinationOffset & 0xff00) | (BLT_DEST_ADDRESS_REGISTER + 1)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((DestinationOffset >> 8) & 0x3f00) | (BLT_DEST_ADDRESS_REGISTER + 2)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((SourceOffset << 8) & 0xff00) | BLT_SOURCE_ADDRESS_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((SourceOffset & 0xff00) | (BLT_SOURCE_ADDRESS_REGISTER + 1)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((SourceOffset >> 8) & 0x3f00) | (BLT_SOURCE_ADDRESS_REGISTER + 2)));
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x002f);
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Mode << 8) | BLT_MODE_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, (BLT_ROP_SOURCE_COPY << 8) | BLT_ROP_REGISTER);
+  outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((ModeExtension << 8) | BLT_MODE_EXTENSION_REGISTER));
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0034);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0035);
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, (BLT_STATUS_START << 8) | BLT_STATUS_REGISTER);
+
+  outb (Private, GRAPH_ADDRESS_REGISTER, BLT_STATUS_REGISTER);
+  while ((inb (Private, GRAPH_DATA_REGISTER) & BLT_STATUS_BUSY) == BLT_STATUS_BUSY)
+    ;
+}
+
+/**
+  Copy a rectangle of the frame buffer to another place of the frame buffer
+  with the BitBLT engine. Overlapping rectangles are copied correctly.
+
+  @param  Private            Driver private data.
+  @param  DestinationOffset  Frame buffer offset of the destination rectangle.
+  @param  SourceOffset       Frame buffer offset of the source rectangle.
+  @param  Width              Width of the rectangle, must not be zero.
+  @param  Height             Height of the rectangle, must not be zero.
+  @param  Pitch              Bytes per scan line.
+
+**/
+VOID
+CirrusLogic5430BitBltCopy (
+  CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private,
+  UINTN                           DestinationOffset,
+  UINTN                           SourceOffset,
+  UINTN                           Width,
+  UINTN                           Height,
+  UINTN                           Pitch
+  )
+{
+  UINTN Last;
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0000);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0010);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0012);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0014);
+
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0001);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0011);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0013);
+  outw (Private, GRAPH_ADDRESS_REGISTER, 0x0015);
+
+  if (DestinationOffset <= SourceOffset) {
+    CirrusLogic5430BitBlt (Private, DestinationOffset, SourceOffset, Width, Height, Pitch, Pitch, 0, 0);
+  } else {
+    //
+    // The destination may overlap the end of the source, for example when
+    // scrolling down, so walk both rectangles from their last byte.
+    //
+    Last = (Height - 1) * Pitch + Width - 1;
+    CirrusLogic5430BitBlt (
+      Private,
+      DestinationOffset + Last,
+      SourceOffset + Last,
+      Width,
+      Height,
+      Pitch,
+      Pitch,
+      BLT_MODE_BACKWARDS,
+      0
+      );
+  }
+}
+
+/**
+  Fill a rectangle of the frame buffer with a single pixel value.
+
+  The GD5446 fills the rectangle with its BitBLT engine on its own. Older
+  chips do not have the solid fill mode, so the first line is written by the
+  CPU and the BitBLT engine replicates it, reading it again for every line
+  through a source pitch of zero.
+
+  @param  Private            Driver private data.
+  @param  DestinationOffset  Frame buffer offset of the rectangle.
+  @param  Width              Width of the rectangle, must not be zero.
+  @param  Height             Height of the rectangle, must not be zero.
+  @param  Pitch              Bytes per scan line.
+  @param  Pixel              The pixel value to fill the rectangle with.
+
+**/
+VOID
+CirrusLogic5430BitBltFill (
+  CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private,
+  UINTN                           DestinationOffset,
+  UINTN                           Width,
+  UINTN                           Height,
+  UINTN                           Pitch,
+  UINT8                           Pixel
+  )
+{
+  if (Private->BitBltSolidFill) {
+    //
+    // The foreground color is the fill color
+    //
+    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Pixel << 8) | 0x01));
+    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0011);
+    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0013);
+    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0015);
+
+    CirrusLogic5430BitBlt (
+      Private,
+      DestinationOffset,
+      0,
+      Width,
+      Height,
+      Pitch,
+      0,
+      BLT_MODE_COLOR_EXPAND | BLT_MODE_PATTERN_COPY,
+      BLT_MODE_EXTENSION_SOLID_FILL
+      );
+
+    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0001);
+    return;
+  }
+
+  Private->PciIo->Mem.Write (
+                        Private->PciIo,
+                        EfiPciIoWidthFillUint8,
+                        0,
+                        DestinationOffset,
+                        Width,
+                        &Pixel
+                        );
+
+  if (Height > 1) {
+    CirrusLogic5430BitBlt (Private, DestinationOffset + Pitch, DestinationOffset, Width, Height - 1, Pitch, 0, 0, 0);
+  }
+}
+
 /**
   TODO: Add function description
 
@@ -837,6 +1033,11 @@ InitializeGraphicsMode (
   //
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Only the GD5446 BitBLT engine can fill a rectangle with a solid color
+  //
+  Private->BitBltSolidFill = (BOOLEAN) (DeviceId == CIRRUS_LOGIC_5446_DEVICE_ID);
+
   outw (Private, SEQ_ADDRESS_REGISTER, 0x1206);
   outw (Private, SEQ_ADDRESS_REGISTER, 0x0012);
 
@@ -33,6 +33,7 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/TimerLib.h>
+#include <Library/GopStatsLib.h>
 
 #include <IndustryStandard/Pci.h>
 //
@@ -97,6 +98,8 @@ typedef struct {
   CIRRUS_LOGIC_5430_MODE_DATA           ModeData[CIRRUS_LOGIC_5430_MODE_COUNT];
   UINT8                                 *LineBuffer;
   BOOLEAN                               HardwareNeedsStarting;
+  BOOLEAN                               BitBltSolidFill;
+  GOP_STATS_CONTEXT                     *GopStats;
 } CIRRUS_LOGIC_5430_PRIVATE_DATA;
 
 ///
@@ -152,6 +155,28 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gCirrusLogic5430DriverSupporte
 #define PALETTE_INDEX_REGISTER  0x3c8
 #define PALETTE_DATA_REGISTER   0x3c9
 
+//
+// BitBLT engine registers, indexed through GRAPH_ADDRESS_REGISTER
+//
+#define BLT_WIDTH_REGISTER              0x20
+#define BLT_HEIGHT_REGISTER             0x22
+#define BLT_DEST_PITCH_REGISTER         0x24
+#define BLT_SOURCE_PITCH_REGISTER       0x26
+#define BLT_DEST_ADDRESS_REGISTER       0x28
+#define BLT_SOURCE_ADDRESS_REGISTER     0x2c
+#define BLT_MODE_REGISTER               0x30
+#define BLT_STATUS_REGISTER             0x31
+#define BLT_ROP_REGISTER                0x32
+#define BLT_MODE_EXTENSION_REGISTER     0x33
+
+#define BLT_MODE_BACKWARDS              0x01
+#define BLT_MODE_PATTERN_COPY           0x40
+#define BLT_MODE_COLOR_EXPAND           0x80
+#define BLT_MODE_EXTENSION_SOLID_FILL   0x04
+#define BLT_STATUS_BUSY                 0x01
+#define BLT_STATUS_START                0x02
+#define BLT_ROP_SOURCE_COPY             0x0d
+
 //
 // UGA Draw Hardware abstraction internal worker functions
 //
@@ -424,6 +449,26 @@ inw (
   UINTN                           Address
   );
 
+VOID
+CirrusLogic5430BitBltCopy (
+  CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private,
+  UINTN                           DestinationOffset,
+  UINTN                           SourceOffset,
+  UINTN                           Width,
+  UINTN                           Height,
+  UINTN                           Pitch
+  );
+
+VOID
+CirrusLogic5430BitBltFill (
+  CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private,
+  UINTN                           DestinationOffset,
+  UINTN                           Width,
+  UINTN                           Height,
+  UINTN                           Pitch,
+  UINT8                           Pixel
+  );
+
 EFI_STATUS
 CirrusLogic5430VideoModeSetup (
   CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private
@@ -176,9 +176,9 @@ Routine Description:
   return EFI_SUCCESS;
 }
 
+STATIC
 EFI_STATUS
-EFIAPI
-CirrusLogic5430GraphicsOutputBlt (
+CirrusLogic5430GraphicsOutputBltWorker (
   IN  EFI_GRAPHICS_OUTPUT_PROTOCOL          *This,
   IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL         *BltBuffer, OPTIONAL
   IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION     BltOperation,
@@ -226,7 +226,6 @@ Returns:
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL   *Blt;
   UINTN                           X;
   UINT8                           Pixel;
-  UINT32                          WidePixel;
   UINTN                           ScreenWidth;
   UINTN                           Offset;
   UINTN                           SourceOffset;
@@ -338,95 +337,15 @@ Returns:
     SourceOffset  = (SourceY * Private->ModeData[CurrentMode].HorizontalResolution) + (SourceX);
     Offset        = (DestinationY * Private->ModeData[CurrentMode].HorizontalResolution) + (DestinationX);
 
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0000);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0010);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0012);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0014);
-
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0001);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0011);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0013);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0015);
-
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Width << 8) & 0xff00) | 0x20));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Width & 0xff00) | 0x21));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((Height << 8) & 0xff00) | 0x22));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((Height & 0xff00) | 0x23));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((ScreenWidth << 8) & 0xff00) | 0x24));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((ScreenWidth & 0xff00) | 0x25));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) (((ScreenWidth << 8) & 0xff00) | 0x26));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((ScreenWidth & 0xff00) | 0x27));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) << 8) & 0xff00) | 0x28));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) >> 0) & 0xff00) | 0x29));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((Offset) >> 8) & 0xff00) | 0x2a));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) << 8) & 0xff00) | 0x2c));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) >> 0) & 0xff00) | 0x2d));
-    outw (Private, GRAPH_ADDRESS_REGISTER, (UINT16) ((((SourceOffset) >> 8) & 0xff00) | 0x2e));
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x002f);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0030);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0d32);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0033);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0034);
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0035);
-
-    outw (Private, GRAPH_ADDRESS_REGISTER, 0x0231);
-
-    outb (Private, GRAPH_ADDRESS_REGISTER, 0x31);
-    while ((inb (Private, GRAPH_DATA_REGISTER) & 0x01) == 0x01)
-      ;
+    CirrusLogic5430BitBltCopy (Private, Offset, SourceOffset, Width, Height, ScreenWidth);
     break;
 
   case EfiBltVideoFill:
     Blt       = BltBuffer;
     Pixel     = RGB_BYTES_TO_PIXEL (Blt->Red, Blt->Green, Blt->Blue);
-    WidePixel = (Pixel << 8) | Pixel;
-    WidePixel = (WidePixel << 16) | WidePixel;
+    Offset    = (DestinationY * Private->ModeData[CurrentMode].HorizontalResolution) + DestinationX;
 
-    if (DestinationX == 0 && Width == Private->ModeData[CurrentMode].HorizontalResolution) {
-      Offset = DestinationY * Private->ModeData[CurrentMode].HorizontalResolution;
-      if (((Offset & 0x03) == 0) && (((Width * Height) & 0x03) == 0)) {
-        Private->PciIo->Mem.Write (
-                              Private->PciIo,
-                              EfiPciIoWidthFillUint32,
-                              0,
-                              Offset,
-                              (Width * Height) >> 2,
-                              &WidePixel
-                              );
-      } else {
-        Private->PciIo->Mem.Write (
-                              Private->PciIo,
-                              EfiPciIoWidthFillUint8,
-                              0,
-                              Offset,
-                              Width * Height,
-                              &Pixel
-                              );
-      }
-    } else {
-      for (SrcY = SourceY, DstY = DestinationY; SrcY < (Height + SourceY); SrcY++, DstY++) {
-        Offset = (DstY * Private->ModeData[CurrentMode].HorizontalResolution) + DestinationX;
-        if (((Offset & 0x03) == 0) && ((Width & 0x03) == 0)) {
-          Private->PciIo->Mem.Write (
-                                Private->PciIo,
-                                EfiPciIoWidthFillUint32,
-                                0,
-                                Offset,
-                                Width >> 2,
-                                &WidePixel
-                                );
-        } else {
-          Private->PciIo->Mem.Write (
-                                Private->PciIo,
-                                EfiPciIoWidthFillUint8,
-                                0,
-                                Offset,
-                                Width,
-                                &Pixel
-                                );
-        }
-      }
-    }
+    CirrusLogic5430BitBltFill (Private, Offset, Width, Height, Private->ModeData[CurrentMode].HorizontalResolution, Pixel);
     break;
 
   case EfiBltBufferToVideo:
@@ -475,6 +394,66 @@ Returns:
   return EFI_SUCCESS;
 }
 
+EFI_STATUS
+EFIAPI
+CirrusLogic5430GraphicsOutputBlt (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL          *This,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL         *BltBuffer, OPTIONAL
+  IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION     BltOperation,
+  IN  UINTN                                 SourceX,
+  IN  UINTN                                 SourceY,
+  IN  UINTN                                 DestinationX,
+  IN  UINTN                                 DestinationY,
+  IN  UINTN                                 Width,
+  IN  UINTN                                 Height,
+  IN  UINTN                                 Delta
+  )
+/*++
+
+Routine Description:
+
+  Graphics Output protocol instance to block transfer for CirrusLogic device.
+  Records the call in the GOP statistics; see
+  CirrusLogic5430GraphicsOutputBltWorker for the transfer itself.
+
+Arguments:
+
+  Same as CirrusLogic5430GraphicsOutputBltWorker
+
+Returns:
+
+  Same as CirrusLogic5430GraphicsOutputBltWorker
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT64      StartTicks;
+
+  StartTicks = GopStatsStart ();
+  Status = CirrusLogic5430GraphicsOutputBltWorker (
+             This,
+             BltBuffer,
+             BltOperation,
+             SourceX,
+             SourceY,
+             DestinationX,
+             DestinationY,
+             Width,
+             Height,
+             Delta
+             );
+  GopStatsRecord (
+    CIRRUS_LOGIC_5430_PRIVATE_DATA_FROM_GRAPHICS_OUTPUT_THIS (This)->GopStats,
+    BltOperation,
+    StartTicks,
+    Status,
+    Width,
+    Height
+    );
+
+  return Status;
+}
+
 EFI_STATUS
 CirrusLogic5430GraphicsOutputConstructor (
   CIRRUS_LOGIC_5430_PRIVATE_DATA  *Private
@@ -68,6 +68,40 @@ ConfigurePixelBitMaskFormat (
 }
 
 
+/**
+  Convert a row of pixels between the EFI_GRAPHICS_OUTPUT_BLT_PIXEL layout and
+  the PixelRedGreenBlueReserved8BitPerColor layout.
+
+  Both layouts only differ in the position of the red and blue bytes, so the
+  same conversion works in either direction, without going through the
+  generic mask and shift logic.
+
+  @param[out] Destination  Pointer to the converted pixels
+  @param[in]  Source       Pointer to the pixels to convert
+  @param[in]  Count        Number of pixels to convert
+
+**/
+STATIC
+VOID
+SwapRedBlue (
+  OUT UINT32                            *Destination,
+  IN  UINT32                            *Source,
+  IN  UINTN                             Count
+  )
+{
+  UINTN   Index;
+  UINT32  Uint32;
+
+  for (Index = 0; Index < Count; Index++) {
+    Uint32 = Source[Index];
+    Destination[Index] =
+      (Uint32 & 0x0000ff00) |
+      ((Uint32 & 0x000000ff) << 16) |
+      ((Uint32 >> 16) & 0x000000ff);
+  }
+}
+
+
 /**
   Configure the FrameBufferLib instance
 
@@ -477,7 +511,17 @@ BltLibVideoToBltBufferEx (
 
     CopyMem (BltMemDst, BltMemSrc, WidthInBytes);
 
-    if (mPixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
+    if (mPixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+      SwapRedBlue (
+        (UINT32 *) (
+            (UINT8 *) BltBuffer +
+            (DstY * Delta) +
+            (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))
+          ),
+        (UINT32 *) mBltLibLineBuffer,
+        Width
+        );
+    } else if (mPixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
       for (X = 0; X < Width; X++) {
         Blt         = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) ((UINT8 *) BltBuffer + (DstY * Delta) + (DestinationX + X) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
         Uint32 = *(UINT32*) (mBltLibLineBuffer + (X * mBltLibBytesPerPixel));
@@ -606,7 +650,23 @@ BltLibBufferToVideoEx (
     BltMemDst = (VOID*) (mBltLibFrameBuffer + Offset);
 
     if (mPixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
-      BltMemSrc = (VOID *) ((UINT8 *) BltBuffer + (SrcY * Delta));
+      BltMemSrc =
+        (VOID *) (
+            (UINT8 *) BltBuffer +
+            (SrcY * Delta) +
+            (SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))
+          );
+    } else if (mPixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+      SwapRedBlue (
+        (UINT32 *) mBltLibLineBuffer,
+        (UINT32 *) (
+            (UINT8 *) BltBuffer +
+            (SrcY * Delta) +
+            (SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))
+          ),
+        Width
+        );
+      BltMemSrc = (VOID *) mBltLibLineBuffer;
     } else {
       for (X = 0; X < Width; X++) {
         Blt =
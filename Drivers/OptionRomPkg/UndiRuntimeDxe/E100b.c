@@ -1594,31 +1594,35 @@ CheckCBList (
   UINT16  cnt;
 
   cnt = 0;
-  while (1) {
+  while (AdapterInfo->FreeCBCount < AdapterInfo->TxBufCnt) {
     Tmp_ptr = AdapterInfo->FreeTxTailPtr->NextTCBVirtualLinkPtr;
-    if ((Tmp_ptr->cb_header.status & CMD_STATUS_MASK) != 0) {
-      //
-      // check if Q is full
-      //
-      if (next (AdapterInfo->xmit_done_tail) != AdapterInfo->xmit_done_head) {
-        ASSERT (AdapterInfo->xmit_done_tail < TX_BUFFER_COUNT << 1);
-        AdapterInfo->xmit_done[AdapterInfo->xmit_done_tail] = Tmp_ptr->free_data_ptr;
-
-        UnMapIt (
-          AdapterInfo,
-          Tmp_ptr->free_data_ptr,
-          Tmp_ptr->TBDArray[0].buf_len,
-          TO_DEVICE,
-          (UINT64) Tmp_ptr->TBDArray[0].phys_buf_addr
-          );
-
-        AdapterInfo->xmit_done_tail = next (AdapterInfo->xmit_done_tail);
-      }
+    if ((Tmp_ptr->cb_header.status & CMD_STATUS_MASK) == 0) {
+      break;
+    }
 
-      SetFreeCB (AdapterInfo, Tmp_ptr);
-    } else {
+    //
+    // if the Q of completed buffers is full, leave the CB in use until
+    // get_status makes room, rather than losing track of its buffer
+    //
+    if (next (AdapterInfo->xmit_done_tail) == AdapterInfo->xmit_done_head) {
       break;
     }
+
+    ASSERT (AdapterInfo->xmit_done_tail < TX_BUFFER_COUNT << 1);
+    AdapterInfo->xmit_done[AdapterInfo->xmit_done_tail] = Tmp_ptr->free_data_ptr;
+
+    UnMapIt (
+      AdapterInfo,
+      Tmp_ptr->free_data_ptr,
+      Tmp_ptr->TBDArray[0].buf_len,
+      TO_DEVICE,
+      (UINT64) Tmp_ptr->TBDArray[0].phys_buf_addr
+      );
+
+    AdapterInfo->xmit_done_tail = next (AdapterInfo->xmit_done_tail);
+
+    SetFreeCB (AdapterInfo, Tmp_ptr);
+    cnt++;
   }
 
   return cnt;
@@ -12,7 +12,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 // pci config offsets:
 
 #define RX_BUFFER_COUNT 32
-#define TX_BUFFER_COUNT 32
+#define TX_BUFFER_COUNT 64
 
 #define PCI_VENDOR_ID_INTEL 0x8086
 #define PCI_DEVICE_ID_INTEL_82557 0x1229
@@ -0,0 +1,719 @@
+/** @file
+  BlkBench - benchmarks block devices through BLOCK_IO and BLOCK_IO2
+
+  Lists the handles with the Block I/O protocol, or runs a sweep of workloads
+  on one of them and reports, for each, its throughput, its IOPS and the
+  average, median, 90th and 99th percentile and maximum latency of its
+  requests. The sweep covers:
+   - sequential and random reads, and with -w sequential and random writes,
+   - transfers of 512B, 4KiB, 64KiB and 1MiB (those that aren't a multiple of
+     the block size are skipped),
+   - queue depths of 1, 2, 4... up to the maximum. Queue depth 1 goes through
+     BLOCK_IO; deeper queues need BLOCK_IO2, and keep that many requests in
+     flight at all times.
+
+  Usage: BlkBench [-d Device [-w] [-n Operations] [-q QueueDepth] [-s StartLba] [-r RangeMiB]]
+    Without -d, lists the block devices.
+    -d sets the index of the device to benchmark, as listed.
+    -w adds write workloads. THIS DESTROYS THE DATA in the tested range.
+    -n sets the number of requests of each workload (default: 256).
+    -q sets the maximum queue depth (default: 8, at most 32).
+    -s sets the first LBA of the tested range (default: 0).
+    -r sets the size of the tested range, in MiB (default: 1024, or up to the
+       end of the device).
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Protocol/BlockIo.h>
+#include <Protocol/BlockIo2.h>
+#include <Protocol/DevicePath.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/ShellCEntryLib.h>
+#include <Library/SortLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+#define BENCH_DEFAULT_OPERATIONS   256
+#define BENCH_DEFAULT_QUEUE_DEPTH  8
+#define BENCH_MAX_QUEUE_DEPTH      32
+#define BENCH_DEFAULT_RANGE_MB     1024
+
+typedef enum {
+  BenchSequentialRead,
+  BenchRandomRead,
+  BenchSequentialWrite,
+  BenchRandomWrite,
+  BenchPatternMax
+} BENCH_PATTERN;
+
+STATIC CONST CHAR16  *mPatternNames[BenchPatternMax] = {
+  L"seq-read",
+  L"rand-read",
+  L"seq-write",
+  L"rand-write"
+};
+
+STATIC CONST UINTN  mTransferSizes[] = {
+  512,
+  SIZE_4KB,
+  SIZE_64KB,
+  SIZE_1MB
+};
+
+typedef struct {
+  EFI_BLOCK_IO_PROTOCOL     *BlockIo;
+  // NULL if the device doesn't have BLOCK_IO2
+  EFI_BLOCK_IO2_PROTOCOL    *BlockIo2;
+  UINT32                    MediaId;
+  UINT32                    BlockSize;
+  UINTN                     Alignment;
+  EFI_LBA                   FirstLba;
+  UINT64                    NumberBlocks;
+  UINTN                     Operations;
+  // Latency of each request of a workload, in nanoseconds
+  UINT64                    *Latencies;
+} BENCH_DEVICE;
+
+typedef struct {
+  EFI_BLOCK_IO2_TOKEN    Token;
+  VOID                   *Buffer;
+  UINTN                  Operation;
+  UINT64                 StartTicks;
+  BOOLEAN                Busy;
+} BENCH_SLOT;
+
+STATIC BOOLEAN  mCounterCountsDown;
+
+/**
+   Returns the time elapsed between two readings of the performance counter.
+
+   @param[in]      StartTicks    First reading.
+   @param[in]      EndTicks      Second reading.
+
+   @return Nanoseconds.
+**/
+STATIC
+UINT64
+ElapsedNs (
+  IN UINT64  StartTicks,
+  IN UINT64  EndTicks
+  )
+{
+  return GetTimeInNanoSecond (mCounterCountsDown ? StartTicks - EndTicks : EndTicks - StartTicks);
+}
+
+/**
+   Compares two latencies, for sorting.
+
+   @param[in]      Buffer1       Pointer to the first latency.
+   @param[in]      Buffer2       Pointer to the second latency.
+
+   @return <0, 0 or >0 if the first latency is smaller, equal or larger.
+**/
+STATIC
+INTN
+EFIAPI
+CompareLatency (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  UINT64  Latency1;
+  UINT64  Latency2;
+
+  Latency1 = *(CONST UINT64 *)Buffer1;
+  Latency2 = *(CONST UINT64 *)Buffer2;
+
+  return Latency1 < Latency2 ? -1 : (Latency1 > Latency2 ? 1 : 0);
+}
+
+/**
+   Returns a percentile of the sorted latencies of a workload.
+
+   @param[in]      Latencies     Sorted latencies.
+   @param[in]      Count         Number of latencies, not 0.
+   @param[in]      Percentile    Percentile, from 1 to 100.
+
+   @return Latency, in nanoseconds.
+**/
+STATIC
+UINT64
+LatencyPercentile (
+  IN CONST UINT64  *Latencies,
+  IN UINTN         Count,
+  IN UINTN         Percentile
+  )
+{
+  UINTN  Index;
+
+  Index = (Count * Percentile + 99) / 100;
+  return Latencies[Index == 0 ? 0 : Index - 1];
+}
+
+/**
+   Returns the first LBA of a request of a workload.
+
+   @param[in]      Device        Pointer to the device being benchmarked.
+   @param[in]      Pattern       Pattern of the workload.
+   @param[in]      Chunks        Number of transfers that fit in the tested range.
+   @param[in]      BlocksPerIo   Number of blocks of each transfer.
+   @param[in]      Operation     Index of the request.
+   @param[in, out] Seed          Seed of the random patterns.
+
+   @return LBA.
+**/
+STATIC
+EFI_LBA
+NextLba (
+  IN     BENCH_DEVICE   *Device,
+  IN     BENCH_PATTERN  Pattern,
+  IN     UINT64         Chunks,
+  IN     UINTN          BlocksPerIo,
+  IN     UINTN          Operation,
+  IN OUT UINT32         *Seed
+  )
+{
+  UINT64  Chunk;
+
+  if ((Pattern == BenchRandomRead) || (Pattern == BenchRandomWrite)) {
+    // Numerical Recipes' LCG; good enough to scatter requests around
+    *Seed = *Seed * 1664525 + 1013904223;
+    DivU64x64Remainder (*Seed, Chunks, &Chunk);
+  } else {
+    DivU64x64Remainder (Operation, Chunks, &Chunk);
+  }
+
+  return Device->FirstLba + MultU64x32 (Chunk, (UINT32)BlocksPerIo);
+}
+
+/**
+   Runs a workload with one request at a time, through BLOCK_IO.
+
+   @param[in]      Device        Pointer to the device being benchmarked.
+   @param[in]      Pattern       Pattern of the workload.
+   @param[in]      TransferSize  Size of each request, in bytes.
+   @param[in]      Chunks        Number of transfers that fit in the tested range.
+   @param[in]      Buffer        Buffer of TransferSize bytes.
+
+   @return Status of the first request that failed, or EFI_SUCCESS.
+**/
+STATIC
+EFI_STATUS
+RunSynchronous (
+  IN BENCH_DEVICE   *Device,
+  IN BENCH_PATTERN  Pattern,
+  IN UINTN          TransferSize,
+  IN UINT64         Chunks,
+  IN VOID           *Buffer
+  )
+{
+  EFI_BLOCK_IO_PROTOCOL  *BlockIo;
+  EFI_LBA                Lba;
+  UINT64                 StartTicks;
+  UINT32                 Seed;
+  UINTN                  Operation;
+  EFI_STATUS             Status;
+
+  BlockIo = Device->BlockIo;
+  Seed    = 0x12345678;
+  Status  = EFI_SUCCESS;
+
+  for (Operation = 0; Operation < Device->Operations; Operation++) {
+    Lba        = NextLba (Device, Pattern, Chunks, TransferSize / Device->BlockSize, Operation, &Seed);
+    StartTicks = GetPerformanceCounter ();
+
+    if ((Pattern == BenchSequentialRead) || (Pattern == BenchRandomRead)) {
+      Status = BlockIo->ReadBlocks (BlockIo, Device->MediaId, Lba, TransferSize, Buffer);
+    } else {
+      Status = BlockIo->WriteBlocks (BlockIo, Device->MediaId, Lba, TransferSize, Buffer);
+    }
+
+    Device->Latencies[Operation] = ElapsedNs (StartTicks, GetPerformanceCounter ());
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (!EFI_ERROR (Status) && (Pattern != BenchSequentialRead) && (Pattern != BenchRandomRead)) {
+    Status = BlockIo->FlushBlocks (BlockIo);
+  }
+
+  return Status;
+}
+
+/**
+   Runs a workload keeping QueueDepth requests in flight, through BLOCK_IO2.
+
+   A new request is submitted as soon as one completes. If a request fails,
+   no new request is submitted, but the ones in flight are still waited for.
+
+   @param[in]      Device        Pointer to the device being benchmarked.
+   @param[in]      Pattern       Pattern of the workload.
+   @param[in]      TransferSize  Size of each request, in bytes.
+   @param[in]      Chunks        Number of transfers that fit in the tested range.
+   @param[in]      Slots         Slots of the requests in flight, with their
+                                 buffer and event.
+   @param[in]      QueueDepth    Number of slots.
+
+   @return Status of the first request that failed, or EFI_SUCCESS.
+**/
+STATIC
+EFI_STATUS
+RunAsynchronous (
+  IN BENCH_DEVICE   *Device,
+  IN BENCH_PATTERN  Pattern,
+  IN UINTN          TransferSize,
+  IN UINT64         Chunks,
+  IN BENCH_SLOT     *Slots,
+  IN UINTN          QueueDepth
+  )
+{
+  EFI_BLOCK_IO2_PROTOCOL  *BlockIo2;
+  BENCH_SLOT              *Slot;
+  EFI_LBA                 Lba;
+  UINT32                  Seed;
+  UINTN                   Submitted;
+  UINTN                   InFlight;
+  UINTN                   Index;
+  EFI_STATUS              Status;
+  EFI_STATUS              FirstError;
+
+  BlockIo2   = Device->BlockIo2;
+  Seed       = 0x12345678;
+  Submitted  = 0;
+  InFlight   = 0;
+  FirstError = EFI_SUCCESS;
+
+  do {
+    for (Index = 0; Index < QueueDepth; Index++) {
+      Slot = &Slots[Index];
+
+      if (Slot->Busy) {
+        if (gBS->CheckEvent (Slot->Token.Event) != EFI_SUCCESS) {
+          continue;
+        }
+
+        Device->Latencies[Slot->Operation] = ElapsedNs (Slot->StartTicks, GetPerformanceCounter ());
+        Slot->Busy                         = FALSE;
+        InFlight--;
+
+        if (EFI_ERROR (Slot->Token.TransactionStatus) && !EFI_ERROR (FirstError)) {
+          FirstError = Slot->Token.TransactionStatus;
+        }
+      }
+
+      if (EFI_ERROR (FirstError) || (Submitted == Device->Operations)) {
+        continue;
+      }
+
+      Lba                           = NextLba (Device, Pattern, Chunks, TransferSize / Device->BlockSize, Submitted, &Seed);
+      Slot->Operation               = Submitted;
+      Slot->Token.TransactionStatus = EFI_SUCCESS;
+      Slot->StartTicks              = GetPerformanceCounter ();
+
+      if ((Pattern == BenchSequentialRead) || (Pattern == BenchRandomRead)) {
+        Status = BlockIo2->ReadBlocksEx (BlockIo2, Device->MediaId, Lba, &Slot->Token, TransferSize, Slot->Buffer);
+      } else {
+        Status = BlockIo2->WriteBlocksEx (BlockIo2, Device->MediaId, Lba, &Slot->Token, TransferSize, Slot->Buffer);
+      }
+
+      if (EFI_ERROR (Status)) {
+        FirstError = Status;
+        continue;
+      }
+
+      Slot->Busy = TRUE;
+      InFlight++;
+      Submitted++;
+    }
+  } while ((InFlight != 0) || (!EFI_ERROR (FirstError) && (Submitted < Device->Operations)));
+
+  if (!EFI_ERROR (FirstError) && (Pattern != BenchSequentialRead) && (Pattern != BenchRandomRead)) {
+    FirstError = BlockIo2->FlushBlocksEx (BlockIo2, NULL);
+  }
+
+  return FirstError;
+}
+
+/**
+   Runs a workload and prints its results.
+
+   @param[in]      Device        Pointer to the device being benchmarked.
+   @param[in]      Pattern       Pattern of the workload.
+   @param[in]      TransferSize  Size of each request, in bytes.
+   @param[in]      QueueDepth    Number of requests kept in flight.
+
+   @return Status of the workload.
+**/
+STATIC
+EFI_STATUS
+RunWorkload (
+  IN BENCH_DEVICE   *Device,
+  IN BENCH_PATTERN  Pattern,
+  IN UINTN          TransferSize,
+  IN UINTN          QueueDepth
+  )
+{
+  BENCH_SLOT  Slots[BENCH_MAX_QUEUE_DEPTH];
+  UINT8       *Buffers;
+  UINTN       Stride;
+  UINTN       Pages;
+  UINT64      Chunks;
+  UINT64      StartTicks;
+  UINT64      ElapsedTime;
+  UINT64      TotalLatency;
+  UINTN       Index;
+  EFI_STATUS  Status;
+
+  Chunks = DivU64x32 (Device->NumberBlocks, (UINT32)(TransferSize / Device->BlockSize));
+
+  if (Chunks == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Stride  = ALIGN_VALUE (TransferSize, Device->Alignment);
+  Pages   = EFI_SIZE_TO_PAGES (Stride * QueueDepth);
+  Buffers = AllocateAlignedPages (Pages, Device->Alignment);
+
+  if (Buffers == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  // Don't write the same page over and over, in case the device skips it
+  for (Index = 0; Index < Stride * QueueDepth; Index++) {
+    Buffers[Index] = (UINT8)(Index * 7 + (Index >> 12));
+  }
+
+  ZeroMem (Slots, sizeof (Slots));
+  ElapsedTime = 0;
+  Status      = EFI_SUCCESS;
+
+  for (Index = 0; Index < QueueDepth && QueueDepth > 1; Index++) {
+    Slots[Index].Buffer = Buffers + Index * Stride;
+    Status              = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Slots[Index].Token.Event);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    ZeroMem (Device->Latencies, Device->Operations * sizeof (UINT64));
+
+    StartTicks = GetPerformanceCounter ();
+
+    if (QueueDepth == 1) {
+      Status = RunSynchronous (Device, Pattern, TransferSize, Chunks, Buffers);
+    } else {
+      Status = RunAsynchronous (Device, Pattern, TransferSize, Chunks, Slots, QueueDepth);
+    }
+
+    ElapsedTime = ElapsedNs (StartTicks, GetPerformanceCounter ());
+  }
+
+  for (Index = 0; Index < QueueDepth; Index++) {
+    if (Slots[Index].Token.Event != NULL) {
+      gBS->CloseEvent (Slots[Index].Token.Event);
+    }
+  }
+
+  FreeAlignedPages (Buffers, Pages);
+
+  if (EFI_ERROR (Status)) {
+    Print (L"%-10s %7u qd%-2u failed: %r\n", mPatternNames[Pattern], TransferSize, QueueDepth, Status);
+    return Status;
+  }
+
+  TotalLatency = 0;
+  for (Index = 0; Index < Device->Operations; Index++) {
+    TotalLatency += Device->Latencies[Index];
+  }
+
+  PerformQuickSort (Device->Latencies, Device->Operations, sizeof (UINT64), CompareLatency);
+
+  Print (L"%-10s %7u qd%-2u", mPatternNames[Pattern], TransferSize, QueueDepth);
+
+  if (ElapsedTime != 0) {
+    Print (
+      L" %6lu MB/s %8lu IOPS",
+      DivU64x64Remainder (MultU64x32 (MultU64x32 (Device->Operations, (UINT32)TransferSize), 1000), ElapsedTime, NULL),
+      DivU64x64Remainder (MultU64x32 (Device->Operations, 1000000000), ElapsedTime, NULL)
+      );
+  }
+
+  Print (
+    L" | us: %7lu avg %7lu p50 %7lu p90 %7lu p99 %7lu max\n",
+    DivU64x32 (DivU64x64Remainder (TotalLatency, Device->Operations, NULL), 1000),
+    DivU64x32 (LatencyPercentile (Device->Latencies, Device->Operations, 50), 1000),
+    DivU64x32 (LatencyPercentile (Device->Latencies, Device->Operations, 90), 1000),
+    DivU64x32 (LatencyPercentile (Device->Latencies, Device->Operations, 99), 1000),
+    DivU64x32 (Device->Latencies[Device->Operations - 1], 1000)
+    );
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Lists the handles with the Block I/O protocol.
+
+   @param[in]      Handles       Handles with the Block I/O protocol.
+   @param[in]      NumberHandles Number of handles.
+**/
+STATIC
+VOID
+ListDevices (
+  IN EFI_HANDLE  *Handles,
+  IN UINTN       NumberHandles
+  )
+{
+  EFI_BLOCK_IO_PROTOCOL     *BlockIo;
+  EFI_BLOCK_IO2_PROTOCOL    *BlockIo2;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  CHAR16                    *DevicePathText;
+  UINTN                     Index;
+  EFI_STATUS                Status;
+
+  for (Index = 0; Index < NumberHandles; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiBlockIoProtocolGuid, (VOID **)&BlockIo);
+
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiDevicePathProtocolGuid, (VOID **)&DevicePath);
+
+    DevicePathText = EFI_ERROR (Status) ? NULL : ConvertDevicePathToText (DevicePath, TRUE, TRUE);
+    Print (L"%u: %s\n", Index, DevicePathText != NULL ? DevicePathText : L"(no device path)");
+
+    if (DevicePathText != NULL) {
+      FreePool (DevicePathText);
+    }
+
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiBlockIo2ProtocolGuid, (VOID **)&BlockIo2);
+
+    Print (
+      L"   %u bytes/block, %lu blocks%s%s%s%s\n",
+      BlockIo->Media->BlockSize,
+      BlockIo->Media->LastBlock + 1,
+      BlockIo->Media->MediaPresent ? L"" : L", no media",
+      BlockIo->Media->ReadOnly ? L", read-only" : L"",
+      BlockIo->Media->LogicalPartition ? L", partition" : L"",
+      EFI_ERROR (Status) ? L"" : L", BLOCK_IO2"
+      );
+  }
+}
+
+/**
+   Reads the numeric value of an option.
+
+   @param[in]      Argc          The number of items in Argv.
+   @param[in]      Argv          Array of pointers to the arguments.
+   @param[in, out] Index         On input, index of the option. On output, index of its value.
+   @param[out]     Value         Pointer to where the value will be stored.
+
+   @retval TRUE                  The value was read.
+   @retval FALSE                 The value is missing.
+**/
+STATIC
+BOOLEAN
+GetOptionValue (
+  IN     UINTN   Argc,
+  IN     CHAR16  **Argv,
+  IN OUT UINTN   *Index,
+  OUT    UINT64  *Value
+  )
+{
+  if (*Index + 1 >= Argc) {
+    return FALSE;
+  }
+
+  (*Index)++;
+  return !EFI_ERROR (StrDecimalToUint64S (Argv[*Index], NULL, Value));
+}
+
+/**
+   The main entry point of the application.
+
+   @param[in] Argc             The number of items in Argv.
+   @param[in] Argv             Array of pointers to the arguments.
+
+   @retval 0                   The devices were listed or benchmarked.
+   @retval Other               An error occurred.
+**/
+INTN
+EFIAPI
+ShellAppMain (
+  IN UINTN   Argc,
+  IN CHAR16  **Argv
+  )
+{
+  EFI_STATUS          Status;
+  EFI_HANDLE          *Handles;
+  EFI_BLOCK_IO_MEDIA  *Media;
+  BENCH_DEVICE        Device;
+  UINTN               NumberHandles;
+  UINTN               Index;
+  UINTN               Size;
+  UINTN               QueueDepth;
+  UINT64              DeviceIndex;
+  UINT64              Operations;
+  UINT64              MaxQueueDepth;
+  UINT64              StartLba;
+  UINT64              RangeMb;
+  UINT64              CounterStart;
+  UINT64              CounterEnd;
+  UINTN               Pattern;
+  UINTN               LastPattern;
+  BOOLEAN             Valid;
+
+  DeviceIndex   = MAX_UINT64;
+  Operations    = BENCH_DEFAULT_OPERATIONS;
+  MaxQueueDepth = BENCH_DEFAULT_QUEUE_DEPTH;
+  StartLba      = 0;
+  RangeMb       = BENCH_DEFAULT_RANGE_MB;
+  LastPattern   = BenchRandomRead;
+  Valid         = TRUE;
+
+  for (Index = 1; Index < Argc && Valid; Index++) {
+    if (StrCmp (Argv[Index], L"-w") == 0) {
+      LastPattern = BenchRandomWrite;
+    } else if (StrCmp (Argv[Index], L"-d") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &DeviceIndex);
+    } else if (StrCmp (Argv[Index], L"-n") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &Operations) && (Operations != 0) && (Operations <= SIZE_1MB);
+    } else if (StrCmp (Argv[Index], L"-q") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &MaxQueueDepth) &&
+              (MaxQueueDepth != 0) && (MaxQueueDepth <= BENCH_MAX_QUEUE_DEPTH);
+    } else if (StrCmp (Argv[Index], L"-s") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &StartLba);
+    } else if (StrCmp (Argv[Index], L"-r") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &RangeMb) && (RangeMb != 0);
+    } else {
+      Valid = FALSE;
+    }
+  }
+
+  if (!Valid) {
+    Print (L"Usage: %s [-d Device [-w] [-n Operations] [-q QueueDepth] [-s StartLba] [-r RangeMiB]]\n", Argv[0]);
+    return 1;
+  }
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiBlockIoProtocolGuid,
+                  NULL,
+                  &NumberHandles,
+                  &Handles
+                  );
+
+  if (EFI_ERROR (Status)) {
+    Print (L"No block devices found: %r\n", Status);
+    return 1;
+  }
+
+  if (DeviceIndex == MAX_UINT64) {
+    ListDevices (Handles, NumberHandles);
+    FreePool (Handles);
+    return 0;
+  }
+
+  if (DeviceIndex >= NumberHandles) {
+    Print (L"Device %lu doesn't exist (%u block devices found)\n", DeviceIndex, NumberHandles);
+    FreePool (Handles);
+    return 1;
+  }
+
+  ZeroMem (&Device, sizeof (Device));
+
+  Status = gBS->HandleProtocol (Handles[DeviceIndex], &gEfiBlockIoProtocolGuid, (VOID **)&Device.BlockIo);
+
+  if (!EFI_ERROR (Status) &&
+      EFI_ERROR (gBS->HandleProtocol (Handles[DeviceIndex], &gEfiBlockIo2ProtocolGuid, (VOID **)&Device.BlockIo2)))
+  {
+    Device.BlockIo2 = NULL;
+  }
+
+  FreePool (Handles);
+
+  if (EFI_ERROR (Status)) {
+    Print (L"Failed to open device %lu: %r\n", DeviceIndex, Status);
+    return 1;
+  }
+
+  Media = Device.BlockIo->Media;
+
+  if (!Media->MediaPresent || (StartLba > Media->LastBlock)) {
+    Print (L"Device %lu has no media, or is smaller than the start LBA\n", DeviceIndex);
+    return 1;
+  }
+
+  if ((LastPattern == BenchRandomWrite) && Media->ReadOnly) {
+    Print (L"Device %lu is read-only\n", DeviceIndex);
+    return 1;
+  }
+
+  Device.MediaId      = Media->MediaId;
+  Device.BlockSize    = Media->BlockSize;
+  Device.Alignment    = MAX (Media->IoAlign, EFI_PAGE_SIZE);
+  Device.FirstLba     = StartLba;
+  Device.NumberBlocks = MIN (
+                          Media->LastBlock - StartLba + 1,
+                          DivU64x32 (MultU64x32 (RangeMb, SIZE_1MB), Media->BlockSize)
+                          );
+  Device.Operations = (UINTN)Operations;
+  Device.Latencies  = AllocatePool (Device.Operations * sizeof (UINT64));
+
+  if (Device.Latencies == NULL) {
+    return 1;
+  }
+
+  if (Device.BlockIo2 == NULL) {
+    MaxQueueDepth = 1;
+  }
+
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  mCounterCountsDown = CounterStart > CounterEnd;
+
+  Print (
+    L"Device %lu: LBA %lu to %lu, %u bytes/block, %u requests per workload%s\n",
+    DeviceIndex,
+    Device.FirstLba,
+    Device.FirstLba + Device.NumberBlocks - 1,
+    Device.BlockSize,
+    Device.Operations,
+    Device.BlockIo2 == NULL ? L", queue depth 1 only (no BLOCK_IO2)" : L""
+    );
+
+  Status = EFI_SUCCESS;
+
+  for (Pattern = BenchSequentialRead; Pattern <= LastPattern; Pattern++) {
+    for (Index = 0; Index < ARRAY_SIZE (mTransferSizes); Index++) {
+      Size = mTransferSizes[Index];
+
+      if ((Size < Device.BlockSize) || ((Size % Device.BlockSize) != 0)) {
+        continue;
+      }
+
+      for (QueueDepth = 1; QueueDepth <= MaxQueueDepth; QueueDepth *= 2) {
+        Status = RunWorkload (&Device, (BENCH_PATTERN)Pattern, Size, QueueDepth);
+
+        if (EFI_ERROR (Status)) {
+          goto Exit;
+        }
+      }
+    }
+  }
+
+Exit:
+  FreePool (Device.Latencies);
+  return EFI_ERROR (Status) ? 1 : 0;
+}
@@ -0,0 +1,490 @@
+/** @file
+  Ext4Bench - Ext4Dxe benchmark application
+
+  Runs a fixed set of workloads on an ext4 volume and reports their speed,
+  along with how much disk I/O Ext4Dxe had to do for them:
+   - sequential read of a large file, in 1MiB chunks,
+   - random 4KiB reads of the same file,
+   - repeated opens of a (preferably deep) path,
+   - repeated listings of a directory.
+
+  Usage: Ext4Bench <Volume> <LargeFile> <Directory> <DeepPath>
+    Volume is the index of the ext4 volume, in the order handles with the
+    Ext4 statistics protocol are returned; paths are relative to its root.
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Guid/FileInfo.h>
+#include <Protocol/Ext4Statistics.h>
+#include <Protocol/SimpleFileSystem.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/ShellCEntryLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+#define BENCH_SEQUENTIAL_CHUNK_SIZE  SIZE_1MB
+#define BENCH_RANDOM_READ_SIZE       SIZE_4KB
+#define BENCH_RANDOM_READS           1024
+#define BENCH_OPENS                  256
+#define BENCH_LISTINGS               16
+#define BENCH_FILE_INFO_SIZE         (SIZE_OF_EFI_FILE_INFO + 256 * sizeof (CHAR16))
+
+typedef struct {
+  CONST CHAR16       *Name;
+  UINT64             Operations;
+  // Bytes returned to the caller; 0 for workloads that don't read data
+  UINT64             Bytes;
+  UINT64             StartTicks;
+  UINT64             ElapsedNs;
+  EXT4_STATISTICS    Statistics;
+} BENCH_RESULT;
+
+/**
+   Starts measuring a workload.
+
+   @param[in]      Stats         Pointer to the volume's statistics protocol.
+   @param[out]     Result        Pointer to the workload's result.
+   @param[in]      Name          Name of the workload.
+**/
+STATIC
+VOID
+BenchStart (
+  IN  EXT4_STATISTICS_PROTOCOL  *Stats,
+  OUT BENCH_RESULT              *Result,
+  IN  CONST CHAR16              *Name
+  )
+{
+  ZeroMem (Result, sizeof (*Result));
+  Result->Name = Name;
+
+  Stats->ResetStatistics (Stats);
+  Result->StartTicks = GetPerformanceCounter ();
+}
+
+/**
+   Stops measuring a workload and prints its results.
+
+   @param[in]      Stats         Pointer to the volume's statistics protocol.
+   @param[in out]  Result        Pointer to the workload's result.
+**/
+STATIC
+VOID
+BenchStop (
+  IN     EXT4_STATISTICS_PROTOCOL  *Stats,
+  IN OUT BENCH_RESULT              *Result
+  )
+{
+  UINT64  EndTicks;
+  UINT64  CounterStart;
+  UINT64  CounterEnd;
+  UINT64  Ticks;
+
+  EndTicks = GetPerformanceCounter ();
+  Stats->GetStatistics (Stats, &Result->Statistics);
+
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+
+  // Some performance counters count down
+  Ticks             = CounterStart > CounterEnd ? Result->StartTicks - EndTicks : EndTicks - Result->StartTicks;
+  Result->ElapsedNs = GetTimeInNanoSecond (Ticks);
+
+  Print (
+    L"%-14s %8lu ops %10lu us",
+    Result->Name,
+    Result->Operations,
+    DivU64x32 (Result->ElapsedNs, 1000)
+    );
+
+  if (Result->ElapsedNs != 0) {
+    Print (L" %10lu ops/s", DivU64x64Remainder (MultU64x32 (Result->Operations, 1000000000), Result->ElapsedNs, NULL));
+
+    if (Result->Bytes != 0) {
+      Print (L" %6lu MB/s", DivU64x64Remainder (MultU64x32 (Result->Bytes, 1000), Result->ElapsedNs, NULL));
+    }
+  }
+
+  Print (
+    L" | %8lu disk reads %12lu bytes",
+    Result->Statistics.DiskReads,
+    Result->Statistics.DiskBytesRead
+    );
+
+  if (Result->Operations != 0) {
+    Print (
+      L" (%lu reads, %lu bytes per op)",
+      DivU64x64Remainder (Result->Statistics.DiskReads, Result->Operations, NULL),
+      DivU64x64Remainder (Result->Statistics.DiskBytesRead, Result->Operations, NULL)
+      );
+  }
+
+  Print (L"\n");
+}
+
+/**
+   Retrieves the size of a file.
+
+   @param[in]      File          Pointer to the open file.
+   @param[out]     Size          Pointer to where the size will be stored.
+
+   @return Status of the operation.
+**/
+STATIC
+EFI_STATUS
+BenchGetFileSize (
+  IN  EFI_FILE_PROTOCOL  *File,
+  OUT UINT64             *Size
+  )
+{
+  EFI_FILE_INFO  *Info;
+  UINTN          InfoSize;
+  EFI_STATUS     Status;
+
+  InfoSize = BENCH_FILE_INFO_SIZE;
+  Info     = AllocatePool (InfoSize);
+
+  if (Info == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = File->GetInfo (File, &gEfiFileInfoGuid, &InfoSize, Info);
+
+  if (!EFI_ERROR (Status)) {
+    *Size = Info->FileSize;
+  }
+
+  FreePool (Info);
+  return Status;
+}
+
+/**
+   Reads a whole file sequentially.
+
+   @param[in]      Stats         Pointer to the volume's statistics protocol.
+   @param[in]      Root          Pointer to the volume's root directory.
+   @param[in]      Path          Path of the file.
+
+   @return Status of the workload.
+**/
+STATIC
+EFI_STATUS
+BenchSequentialRead (
+  IN EXT4_STATISTICS_PROTOCOL  *Stats,
+  IN EFI_FILE_PROTOCOL         *Root,
+  IN CHAR16                    *Path
+  )
+{
+  EFI_FILE_PROTOCOL  *File;
+  VOID               *Buffer;
+  UINTN              Length;
+  BENCH_RESULT       Result;
+  EFI_STATUS         Status;
+
+  Buffer = AllocatePool (BENCH_SEQUENTIAL_CHUNK_SIZE);
+
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = Root->Open (Root, &File, Path, EFI_FILE_MODE_READ, 0);
+
+  if (EFI_ERROR (Status)) {
+    FreePool (Buffer);
+    return Status;
+  }
+
+  BenchStart (Stats, &Result, L"seq-read");
+
+  do {
+    Length = BENCH_SEQUENTIAL_CHUNK_SIZE;
+    Status = File->Read (File, &Length, Buffer);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Result.Operations++;
+    Result.Bytes += Length;
+  } while (Length != 0);
+
+  BenchStop (Stats, &Result);
+
+  File->Close (File);
+  FreePool (Buffer);
+  return Status;
+}
+
+/**
+   Reads 4KiB blocks at random (but reproducible) offsets of a file.
+
+   @param[in]      Stats         Pointer to the volume's statistics protocol.
+   @param[in]      Root          Pointer to the volume's root directory.
+   @param[in]      Path          Path of the file.
+
+   @return Status of the workload.
+**/
+STATIC
+EFI_STATUS
+BenchRandomRead (
+  IN EXT4_STATISTICS_PROTOCOL  *Stats,
+  IN EFI_FILE_PROTOCOL         *Root,
+  IN CHAR16                    *Path
+  )
+{
+  EFI_FILE_PROTOCOL  *File;
+  UINT8              Buffer[BENCH_RANDOM_READ_SIZE];
+  UINTN              Length;
+  UINT64             FileSize;
+  UINT64             NumberChunks;
+  UINT64             Chunk;
+  UINT32             Seed;
+  UINTN              Index;
+  BENCH_RESULT       Result;
+  EFI_STATUS         Status;
+
+  Status = Root->Open (Root, &File, Path, EFI_FILE_MODE_READ, 0);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = BenchGetFileSize (File, &FileSize);
+
+  if (EFI_ERROR (Status) || (FileSize < BENCH_RANDOM_READ_SIZE)) {
+    File->Close (File);
+    return EFI_ERROR (Status) ? Status : EFI_BAD_BUFFER_SIZE;
+  }
+
+  NumberChunks = DivU64x32 (FileSize, BENCH_RANDOM_READ_SIZE);
+  Seed         = 0x12345678;
+
+  BenchStart (Stats, &Result, L"rand-read-4k");
+
+  for (Index = 0; Index < BENCH_RANDOM_READS; Index++) {
+    // Numerical Recipes' LCG; good enough to scatter reads around
+    Seed = Seed * 1664525 + 1013904223;
+    DivU64x64Remainder (Seed, NumberChunks, &Chunk);
+
+    Status = File->SetPosition (File, MultU64x32 (Chunk, BENCH_RANDOM_READ_SIZE));
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Length = BENCH_RANDOM_READ_SIZE;
+    Status = File->Read (File, &Length, Buffer);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Result.Operations++;
+    Result.Bytes += Length;
+  }
+
+  BenchStop (Stats, &Result);
+
+  File->Close (File);
+  return Status;
+}
+
+/**
+   Opens and closes a path repeatedly.
+
+   @param[in]      Stats         Pointer to the volume's statistics protocol.
+   @param[in]      Root          Pointer to the volume's root directory.
+   @param[in]      Path          Path to open.
+
+   @return Status of the workload.
+**/
+STATIC
+EFI_STATUS
+BenchOpen (
+  IN EXT4_STATISTICS_PROTOCOL  *Stats,
+  IN EFI_FILE_PROTOCOL         *Root,
+  IN CHAR16                    *Path
+  )
+{
+  EFI_FILE_PROTOCOL  *File;
+  UINTN              Index;
+  BENCH_RESULT       Result;
+  EFI_STATUS         Status;
+
+  Status = EFI_SUCCESS;
+
+  BenchStart (Stats, &Result, L"open");
+
+  for (Index = 0; Index < BENCH_OPENS; Index++) {
+    Status = Root->Open (Root, &File, Path, EFI_FILE_MODE_READ, 0);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    File->Close (File);
+    Result.Operations++;
+  }
+
+  BenchStop (Stats, &Result);
+
+  return Status;
+}
+
+/**
+   Lists a directory repeatedly. Each directory entry counts as an operation.
+
+   @param[in]      Stats         Pointer to the volume's statistics protocol.
+   @param[in]      Root          Pointer to the volume's root directory.
+   @param[in]      Path          Path of the directory.
+
+   @return Status of the workload.
+**/
+STATIC
+EFI_STATUS
+BenchListDirectory (
+  IN EXT4_STATISTICS_PROTOCOL  *Stats,
+  IN EFI_FILE_PROTOCOL         *Root,
+  IN CHAR16                    *Path
+  )
+{
+  EFI_FILE_PROTOCOL  *Dir;
+  EFI_FILE_INFO      *Info;
+  UINTN              Length;
+  UINTN              Index;
+  BENCH_RESULT       Result;
+  EFI_STATUS         Status;
+
+  Info = AllocatePool (BENCH_FILE_INFO_SIZE);
+
+  if (Info == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = Root->Open (Root, &Dir, Path, EFI_FILE_MODE_READ, 0);
+
+  if (EFI_ERROR (Status)) {
+    FreePool (Info);
+    return Status;
+  }
+
+  BenchStart (Stats, &Result, L"readdir");
+
+  for (Index = 0; Index < BENCH_LISTINGS && !EFI_ERROR (Status); Index++) {
+    Status = Dir->SetPosition (Dir, 0);
+
+    while (!EFI_ERROR (Status)) {
+      Length = BENCH_FILE_INFO_SIZE;
+      Status = Dir->Read (Dir, &Length, Info);
+
+      if (EFI_ERROR (Status) || (Length == 0)) {
+        break;
+      }
+
+      Result.Operations++;
+    }
+  }
+
+  BenchStop (Stats, &Result);
+
+  Dir->Close (Dir);
+  FreePool (Info);
+  return Status;
+}
+
+/**
+   UEFI application entry point.
+
+   @param[in] Argc             The number of items in Argv.
+   @param[in] Argv             Array of pointers to the arguments.
+
+   @retval 0                   The benchmark ran successfully.
+   @retval other               An error occurred.
+**/
+INTN
+EFIAPI
+ShellAppMain (
+  IN UINTN   Argc,
+  IN CHAR16  **Argv
+  )
+{
+  EFI_HANDLE                       *Handles;
+  UINTN                            NumberHandles;
+  UINTN                            Volume;
+  EXT4_STATISTICS_PROTOCOL         *Stats;
+  EFI_SIMPLE_FILE_SYSTEM_PROTOCOL  *Sfs;
+  EFI_FILE_PROTOCOL                *Root;
+  EFI_STATUS                       Status;
+
+  if (Argc != 5) {
+    Print (L"Usage: %s <Volume> <LargeFile> <Directory> <DeepPath>\n", Argv[0]);
+    return 1;
+  }
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gExt4StatisticsProtocolGuid,
+                  NULL,
+                  &NumberHandles,
+                  &Handles
+                  );
+
+  if (EFI_ERROR (Status)) {
+    Print (L"No ext4 volumes found: %r\n", Status);
+    return 1;
+  }
+
+  Volume = StrDecimalToUintn (Argv[1]);
+
+  if (Volume >= NumberHandles) {
+    Print (L"Volume %u doesn't exist (%u ext4 volumes found)\n", Volume, NumberHandles);
+    FreePool (Handles);
+    return 1;
+  }
+
+  Status = gBS->HandleProtocol (Handles[Volume], &gExt4StatisticsProtocolGuid, (VOID **)&Stats);
+
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->HandleProtocol (Handles[Volume], &gEfiSimpleFileSystemProtocolGuid, (VOID **)&Sfs);
+  }
+
+  FreePool (Handles);
+
+  if (!EFI_ERROR (Status)) {
+    Status = Sfs->OpenVolume (Sfs, &Root);
+  }
+
+  if (EFI_ERROR (Status)) {
+    Print (L"Failed to open volume %u: %r\n", Volume, Status);
+    return 1;
+  }
+
+  Status = BenchSequentialRead (Stats, Root, Argv[2]);
+
+  if (!EFI_ERROR (Status)) {
+    Status = BenchRandomRead (Stats, Root, Argv[2]);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = BenchListDirectory (Stats, Root, Argv[3]);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = BenchOpen (Stats, Root, Argv[4]);
+  }
+
+  Root->Close (Root);
+
+  if (EFI_ERROR (Status)) {
+    Print (L"Benchmark failed: %r\n", Status);
+    return 1;
+  }
+
+  return 0;
+}
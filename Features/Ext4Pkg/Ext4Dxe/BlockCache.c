@@ -0,0 +1,397 @@
+/** @file
+  Metadata block cache
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "Ext4Dxe.h"
+
+/**
+   Initialises the partition's block cache.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+
+   @retval EFI_SUCCESS            The cache was initialised (or is disabled).
+   @retval EFI_OUT_OF_RESOURCES   Failed to allocate the hash table.
+**/
+EFI_STATUS
+Ext4InitBlockCache (
+  IN OUT EXT4_PARTITION  *Partition
+  )
+{
+  EXT4_BLOCK_CACHE  *Cache;
+  UINT32            Index;
+
+  Cache = &Partition->BlockCache;
+
+  InitializeListHead (&Cache->Lru);
+  Cache->NumberEntries = 0;
+  Cache->MaxEntries    = PcdGet32 (PcdExt4BlockCacheSize);
+  Cache->Buckets       = NULL;
+  Cache->NumberBuckets = 0;
+
+  if (Cache->MaxEntries == 0) {
+    return EFI_SUCCESS;
+  }
+
+  // Keep the number of buckets a power of two so the hash is a simple mask,
+  // and at most MaxEntries so chains stay (on average) under two entries long.
+  Cache->NumberBuckets = GetPowerOfTwo32 (Cache->MaxEntries);
+  Cache->Buckets       = AllocatePool (Cache->NumberBuckets * sizeof (LIST_ENTRY));
+
+  if (Cache->Buckets == NULL) {
+    Cache->MaxEntries    = 0;
+    Cache->NumberBuckets = 0;
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < Cache->NumberBuckets; Index++) {
+    InitializeListHead (&Cache->Buckets[Index]);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Frees the partition's block cache, along with every cached block.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+**/
+VOID
+Ext4FreeBlockCache (
+  IN OUT EXT4_PARTITION  *Partition
+  )
+{
+  EXT4_BLOCK_CACHE        *Cache;
+  LIST_ENTRY              *Node;
+  LIST_ENTRY              *NextNode;
+  EXT4_BLOCK_CACHE_ENTRY  *Entry;
+
+  Cache = &Partition->BlockCache;
+
+  BASE_LIST_FOR_EACH_SAFE (Node, NextNode, &Cache->Lru) {
+    Entry = EXT4_BLOCK_CACHE_ENTRY_FROM_LRU_NODE (Node);
+    RemoveEntryList (&Entry->LruNode);
+    FreePool (Entry);
+  }
+
+  if (Cache->Buckets != NULL) {
+    FreePool (Cache->Buckets);
+    Cache->Buckets = NULL;
+  }
+
+  Cache->NumberEntries = 0;
+  Cache->NumberBuckets = 0;
+  Cache->MaxEntries    = 0;
+}
+
+/**
+   Looks up a block in the block cache, marking it as the most recently used.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[in]  BlockNr        Block number.
+
+   @return Pointer to the cache entry, or NULL if the block isn't cached.
+**/
+STATIC
+EXT4_BLOCK_CACHE_ENTRY *
+Ext4BlockCacheLookup (
+  IN EXT4_PARTITION  *Partition,
+  IN EXT4_BLOCK_NR   BlockNr
+  )
+{
+  EXT4_BLOCK_CACHE        *Cache;
+  LIST_ENTRY              *Bucket;
+  LIST_ENTRY              *Node;
+  EXT4_BLOCK_CACHE_ENTRY  *Entry;
+
+  Cache  = &Partition->BlockCache;
+  Bucket = &Cache->Buckets[(UINTN)(BlockNr & (Cache->NumberBuckets - 1))];
+
+  BASE_LIST_FOR_EACH (Node, Bucket) {
+    Entry = EXT4_BLOCK_CACHE_ENTRY_FROM_HASH_NODE (Node);
+
+    if (Entry->BlockNr == BlockNr) {
+      // Move it to the front of the LRU list
+      RemoveEntryList (&Entry->LruNode);
+      InsertHeadList (&Cache->Lru, &Entry->LruNode);
+      return Entry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+   Gets a free cache entry, allocating a new one or evicting the least recently
+   used block if the cache is full.
+   The entry must be either inserted with Ext4BlockCacheInsert or released with
+   Ext4BlockCacheRelease.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+
+   @return Pointer to the cache entry, or NULL if we're out of memory.
+**/
+STATIC
+EXT4_BLOCK_CACHE_ENTRY *
+Ext4BlockCacheGetFreeEntry (
+  IN EXT4_PARTITION  *Partition
+  )
+{
+  EXT4_BLOCK_CACHE        *Cache;
+  EXT4_BLOCK_CACHE_ENTRY  *Entry;
+
+  Cache = &Partition->BlockCache;
+  Entry = NULL;
+
+  if (Cache->NumberEntries < Cache->MaxEntries) {
+    Entry = AllocatePool (sizeof (EXT4_BLOCK_CACHE_ENTRY) + Partition->BlockSize);
+
+    if (Entry != NULL) {
+      Cache->NumberEntries++;
+    }
+  }
+
+  if (Entry == NULL) {
+    // Either the cache is full or we're out of memory; recycle the least recently used block.
+    if (IsListEmpty (&Cache->Lru)) {
+      return NULL;
+    }
+
+    Entry = EXT4_BLOCK_CACHE_ENTRY_FROM_LRU_NODE (GetPreviousNode (&Cache->Lru, &Cache->Lru));
+    RemoveEntryList (&Entry->HashNode);
+    RemoveEntryList (&Entry->LruNode);
+  }
+
+  return Entry;
+}
+
+/**
+   Inserts a filled cache entry into the block cache.
+
+   @param[in]      Partition      Pointer to the opened ext4 partition.
+   @param[in out]  Entry          Pointer to the cache entry.
+   @param[in]      BlockNr        Block number the entry holds.
+**/
+STATIC
+VOID
+Ext4BlockCacheInsert (
+  IN     EXT4_PARTITION          *Partition,
+  IN OUT EXT4_BLOCK_CACHE_ENTRY  *Entry,
+  IN     EXT4_BLOCK_NR           BlockNr
+  )
+{
+  EXT4_BLOCK_CACHE  *Cache;
+
+  Cache          = &Partition->BlockCache;
+  Entry->BlockNr = BlockNr;
+  InsertHeadList (&Cache->Buckets[(UINTN)(BlockNr & (Cache->NumberBuckets - 1))], &Entry->HashNode);
+  InsertHeadList (&Cache->Lru, &Entry->LruNode);
+}
+
+/**
+   Releases a cache entry obtained with Ext4BlockCacheGetFreeEntry that
+   couldn't be filled.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[in]  Entry          Pointer to the cache entry.
+**/
+STATIC
+VOID
+Ext4BlockCacheRelease (
+  IN EXT4_PARTITION          *Partition,
+  IN EXT4_BLOCK_CACHE_ENTRY  *Entry
+  )
+{
+  FreePool (Entry);
+  Partition->BlockCache.NumberEntries--;
+}
+
+/**
+   Retrieves a block from the block cache, reading it from the disk (and
+   evicting the least recently used block, if the cache is full) on a miss.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[in]  BlockNr        Block number.
+   @param[out] OutEntry       Pointer to where the cache entry will be stored.
+
+   @return Success status of the lookup.
+**/
+STATIC
+EFI_STATUS
+Ext4BlockCacheGet (
+  IN  EXT4_PARTITION          *Partition,
+  IN  EXT4_BLOCK_NR           BlockNr,
+  OUT EXT4_BLOCK_CACHE_ENTRY  **OutEntry
+  )
+{
+  EXT4_BLOCK_CACHE_ENTRY  *Entry;
+  EFI_STATUS              Status;
+
+  Entry = Ext4BlockCacheLookup (Partition, BlockNr);
+
+  if (Entry != NULL) {
+    *OutEntry = Entry;
+    return EFI_SUCCESS;
+  }
+
+  Entry = Ext4BlockCacheGetFreeEntry (Partition);
+
+  if (Entry == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = Ext4ReadDiskIo (
+             Partition,
+             EXT4_BLOCK_CACHE_ENTRY_DATA (Entry),
+             Partition->BlockSize,
+             EXT4_BLOCK_TO_BYTES (Partition, BlockNr)
+             );
+
+  if (EFI_ERROR (Status)) {
+    Ext4BlockCacheRelease (Partition, Entry);
+    return Status;
+  }
+
+  Ext4BlockCacheInsert (Partition, Entry, BlockNr);
+
+  *OutEntry = Entry;
+  return EFI_SUCCESS;
+}
+
+/**
+   Reads from the partition's disk through the block cache.
+   Blocks that are not cached are read from the disk and cached.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[out] Buffer         Pointer to a destination buffer.
+   @param[in]  Length         Length of the destination buffer.
+   @param[in]  Offset         Offset, in bytes, of the location to read.
+
+   @return Success status of the read.
+**/
+EFI_STATUS
+Ext4ReadCached (
+  IN EXT4_PARTITION  *Partition,
+  OUT VOID           *Buffer,
+  IN UINTN           Length,
+  IN UINT64          Offset
+  )
+{
+  EXT4_BLOCK_CACHE        *Cache;
+  EXT4_BLOCK_CACHE_ENTRY  *Entry;
+  EXT4_BLOCK_NR           BlockNr;
+  UINT32                  BlockOffset;
+  UINTN                   ToCopy;
+  EFI_STATUS              Status;
+
+  Cache = &Partition->BlockCache;
+
+  // Reads that are larger than the whole cache would only serve to thrash it.
+  if ((Cache->MaxEntries == 0) || (Length > MultU64x32 (Cache->MaxEntries, Partition->BlockSize))) {
+    return Ext4ReadDiskIo (Partition, Buffer, Length, Offset);
+  }
+
+  while (Length != 0) {
+    BlockNr = DivU64x32Remainder (Offset, Partition->BlockSize, &BlockOffset);
+    ToCopy  = MIN (Length, Partition->BlockSize - BlockOffset);
+
+    Status = Ext4BlockCacheGet (Partition, BlockNr, &Entry);
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    CopyMem (Buffer, EXT4_BLOCK_CACHE_ENTRY_DATA (Entry) + BlockOffset, ToCopy);
+
+    Buffer  = (CHAR8 *)Buffer + ToCopy;
+    Length -= ToCopy;
+    Offset += ToCopy;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Reads a run of physically contiguous blocks into the block cache with a
+   single disk read. Blocks that are already cached are left untouched.
+   Failures are not fatal, as the blocks will simply be read on demand.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[in]  BlockNr        First block of the run.
+   @param[in]  NumberBlocks   Number of blocks in the run.
+**/
+VOID
+Ext4PrefetchBlocks (
+  IN EXT4_PARTITION  *Partition,
+  IN EXT4_BLOCK_NR   BlockNr,
+  IN UINT32          NumberBlocks
+  )
+{
+  EXT4_BLOCK_CACHE        *Cache;
+  EXT4_BLOCK_CACHE_ENTRY  *Entry;
+  UINT8                   *Buffer;
+  UINT32                  Index;
+  EFI_STATUS              Status;
+
+  Cache = &Partition->BlockCache;
+
+  // Never prefetch more than half the cache, so a prefetch doesn't evict
+  // its own blocks nor everything else that's hot.
+  NumberBlocks = MIN (NumberBlocks, Cache->MaxEntries / 2);
+
+  // Trim the run down to the blocks that aren't cached yet
+  while (NumberBlocks != 0 && Ext4BlockCacheLookup (Partition, BlockNr) != NULL) {
+    BlockNr++;
+    NumberBlocks--;
+  }
+
+  while (NumberBlocks != 0 && Ext4BlockCacheLookup (Partition, BlockNr + NumberBlocks - 1) != NULL) {
+    NumberBlocks--;
+  }
+
+  if (NumberBlocks <= 1) {
+    // A single block is read on demand just as fast.
+    return;
+  }
+
+  Buffer = AllocatePool (NumberBlocks * Partition->BlockSize);
+
+  if (Buffer == NULL) {
+    return;
+  }
+
+  Status = Ext4ReadDiskIo (
+             Partition,
+             Buffer,
+             NumberBlocks * Partition->BlockSize,
+             EXT4_BLOCK_TO_BYTES (Partition, BlockNr)
+             );
+
+  if (EFI_ERROR (Status)) {
+    FreePool (Buffer);
+    return;
+  }
+
+  for (Index = 0; Index < NumberBlocks; Index++) {
+    if (Ext4BlockCacheLookup (Partition, BlockNr + Index) != NULL) {
+      continue;
+    }
+
+    Entry = Ext4BlockCacheGetFreeEntry (Partition);
+
+    if (Entry == NULL) {
+      break;
+    }
+
+    CopyMem (
+      EXT4_BLOCK_CACHE_ENTRY_DATA (Entry),
+      Buffer + Index * Partition->BlockSize,
+      Partition->BlockSize
+      );
+    Ext4BlockCacheInsert (Partition, Entry, BlockNr + Index);
+  }
+
+  FreePool (Buffer);
+}
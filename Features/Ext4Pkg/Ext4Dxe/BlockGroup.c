@@ -77,7 +77,7 @@ Ext4ReadInode (
                       BlockGroup->bg_inode_table_hi
                       );
 
-  Status = Ext4ReadDiskIo (
+  Status = Ext4ReadCached (
              Partition,
              Inode,
              Partition->InodeSize,
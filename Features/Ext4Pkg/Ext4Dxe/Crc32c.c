@@ -0,0 +1,138 @@
+/** @file
+  CRC32C (Castagnoli) routines used to verify metadata_csum checksums
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+  Ext4 checksums every inode, block group descriptor, extent block and
+  directory block with CRC32C, so the CRC ends up being computed for most
+  metadata we read. Where the CPU has CRC32C instructions (SSE4.2 on x86,
+  the CRC32 extension on ARMv8), those are used; otherwise, we use a
+  slicing-by-8 table implementation, which processes 8 bytes per iteration
+  instead of the single byte BaseLib's CalculateCrc32c does.
+**/
+
+#include "Ext4Dxe.h"
+
+// Reflected CRC32C polynomial
+#define EXT4_CRC32C_POLYNOMIAL  0x82F63B78
+
+STATIC UINT32   mCrc32cTable[8][256];
+STATIC BOOLEAN  mCrc32cUseHw;
+
+/**
+   Initialises the CRC32C tables and selects the best CRC32C implementation
+   for the current CPU.
+**/
+VOID
+Ext4InitCrc32c (
+  VOID
+  )
+{
+  UINT32  Index;
+  UINT32  Slice;
+  UINT32  Crc;
+  UINT32  Bit;
+
+  for (Index = 0; Index < 256; Index++) {
+    Crc = Index;
+
+    for (Bit = 0; Bit < 8; Bit++) {
+      Crc = (Crc >> 1) ^ ((Crc & 1) != 0 ? EXT4_CRC32C_POLYNOMIAL : 0);
+    }
+
+    mCrc32cTable[0][Index] = Crc;
+  }
+
+  // Table N holds the CRC of a byte followed by N zero bytes
+  for (Slice = 1; Slice < 8; Slice++) {
+    for (Index = 0; Index < 256; Index++) {
+      Crc                        = mCrc32cTable[Slice - 1][Index];
+      mCrc32cTable[Slice][Index] = (Crc >> 8) ^ mCrc32cTable[0][Crc & 0xFF];
+    }
+  }
+
+  mCrc32cUseHw = Ext4Crc32cHwSupported ();
+
+  DEBUG ((DEBUG_INFO, "[ext4] Using %a CRC32C\n", mCrc32cUseHw ? "hardware" : "slicing-by-8"));
+}
+
+/**
+   Updates a CRC32C using slicing-by-8 tables.
+
+   @param[in]      Crc           Current CRC (not inverted).
+   @param[in]      Buffer        Pointer to the buffer.
+   @param[in]      Length        Length of the buffer, in bytes.
+
+   @return The updated CRC.
+**/
+STATIC
+UINT32
+Ext4Crc32cSlicing (
+  IN UINT32      Crc,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  )
+{
+  CONST UINT8  *Data;
+  UINT32       Low;
+  UINT32       High;
+
+  Data = Buffer;
+
+  // Byte at a time until the data is aligned, so the 64-bit loads are too
+  while (Length != 0 && ((UINTN)Data & 7) != 0) {
+    Crc = (Crc >> 8) ^ mCrc32cTable[0][(Crc ^ *Data++) & 0xFF];
+    Length--;
+  }
+
+  // Note: This assumes we're running on a little-endian CPU, as every UEFI
+  // architecture is.
+  while (Length >= 8) {
+    Low  = *(CONST UINT32 *)Data ^ Crc;
+    High = *(CONST UINT32 *)(Data + 4);
+    Crc  = mCrc32cTable[7][Low & 0xFF] ^
+           mCrc32cTable[6][(Low >> 8) & 0xFF] ^
+           mCrc32cTable[5][(Low >> 16) & 0xFF] ^
+           mCrc32cTable[4][Low >> 24] ^
+           mCrc32cTable[3][High & 0xFF] ^
+           mCrc32cTable[2][(High >> 8) & 0xFF] ^
+           mCrc32cTable[1][(High >> 16) & 0xFF] ^
+           mCrc32cTable[0][High >> 24];
+
+    Data   += 8;
+    Length -= 8;
+  }
+
+  while (Length != 0) {
+    Crc = (Crc >> 8) ^ mCrc32cTable[0][(Crc ^ *Data++) & 0xFF];
+    Length--;
+  }
+
+  return Crc;
+}
+
+/**
+   Updates a CRC32C with the contents of a buffer.
+   Like ext4 (and unlike CalculateCrc32c), the CRC is neither inverted on the
+   way in nor on the way out.
+
+   @param[in]      Crc           Current CRC.
+   @param[in]      Buffer        Pointer to the buffer.
+   @param[in]      Length        Length of the buffer, in bytes.
+
+   @return The updated CRC.
+**/
+UINT32
+Ext4Crc32c (
+  IN UINT32      Crc,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  )
+{
+  if (mCrc32cUseHw) {
+    return Ext4Crc32cHw (Crc, Buffer, Length);
+  }
+
+  return Ext4Crc32cSlicing (Crc, Buffer, Length);
+}
@@ -0,0 +1,45 @@
+/** @file
+  CRC32C instruction support for architectures that don't have (or where we
+  don't use) CRC32C instructions
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "Ext4Dxe.h"
+
+/**
+   Checks if the CPU supports the CRC32C instructions used by Ext4Crc32cHw.
+
+   @retval TRUE   Ext4Crc32cHw can be used.
+   @retval FALSE  Ext4Crc32cHw can't be used.
+**/
+BOOLEAN
+EFIAPI
+Ext4Crc32cHwSupported (
+  VOID
+  )
+{
+  return FALSE;
+}
+
+/**
+   Updates a CRC32C with the contents of a buffer, using CRC32C instructions.
+
+   @param[in]      Crc           Current CRC (not inverted).
+   @param[in]      Buffer        Pointer to the buffer.
+   @param[in]      Length        Length of the buffer, in bytes.
+
+   @return The updated CRC.
+**/
+UINT32
+EFIAPI
+Ext4Crc32cHw (
+  IN UINT32      Crc,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  )
+{
+  ASSERT (FALSE);
+  return Crc;
+}
@@ -0,0 +1,188 @@
+/** @file
+  Dentry cache
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+  Keeps the dentries (and inodes) of recently opened files alive, so that
+  opening the same path again doesn't need to look up every path component in
+  its directory, nor read the inode table. The cache holds a reference to each
+  dentry it contains, which in turn keeps every parent dentry alive.
+**/
+
+#include "Ext4Dxe.h"
+
+/**
+   Removes a dentry from the dentry cache, dropping the cache's reference.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+   @param[in out]  Dentry         Pointer to the cached dentry.
+**/
+STATIC
+VOID
+Ext4UncacheDentry (
+  IN OUT EXT4_PARTITION  *Partition,
+  IN OUT EXT4_DENTRY     *Dentry
+  )
+{
+  RemoveEntryList (&Dentry->CacheNode);
+  Partition->NumberCachedDentries--;
+
+  FreePool (Dentry->CachedInode);
+  Dentry->CachedInode = NULL;
+
+  Ext4UnrefDentry (Dentry);
+}
+
+/**
+   Adds a dentry, along with its inode, to the dentry cache.
+   If the cache is full, the least recently used dentry is evicted.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+   @param[in out]  Dentry         Pointer to the dentry.
+   @param[in]      Inode          Pointer to the dentry's inode.
+   @param[in]      InodeNum       Inode number.
+**/
+VOID
+Ext4CacheDentry (
+  IN OUT EXT4_PARTITION  *Partition,
+  IN OUT EXT4_DENTRY     *Dentry,
+  IN CONST EXT4_INODE    *Inode,
+  IN EXT4_INO_NR         InodeNum
+  )
+{
+  UINT32  MaxEntries;
+
+  MaxEntries = PcdGet32 (PcdExt4DentryCacheSize);
+
+  if ((MaxEntries == 0) || (Dentry->CachedInode != NULL)) {
+    return;
+  }
+
+  Dentry->CachedInode = AllocateCopyPool (Partition->InodeSize, Inode);
+
+  if (Dentry->CachedInode == NULL) {
+    return;
+  }
+
+  if (Partition->NumberCachedDentries == MaxEntries) {
+    Ext4UncacheDentry (
+      Partition,
+      EXT4_DENTRY_FROM_CACHE_NODE (GetPreviousNode (&Partition->DentryCache, &Partition->DentryCache))
+      );
+  }
+
+  Dentry->Inode = InodeNum;
+  Ext4RefDentry (Dentry);
+  InsertHeadList (&Partition->DentryCache, &Dentry->CacheNode);
+  Partition->NumberCachedDentries++;
+}
+
+/**
+   Looks up a cached child dentry by name.
+   Names are compared exactly, as they're stored on disk.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+   @param[in]      Parent         Pointer to the parent dentry.
+   @param[in]      Name           Pointer to the UCS-2 formatted filename.
+
+   @return Pointer to the cached dentry, or NULL if it's not cached.
+**/
+EXT4_DENTRY *
+Ext4LookupCachedDentry (
+  IN OUT EXT4_PARTITION  *Partition,
+  IN EXT4_DENTRY         *Parent,
+  IN CONST CHAR16        *Name
+  )
+{
+  LIST_ENTRY   *Node;
+  EXT4_DENTRY  *Dentry;
+
+  BASE_LIST_FOR_EACH (Node, &Parent->Children) {
+    Dentry = EXT4_DENTRY_FROM_DENTRY_LIST (Node);
+
+    if ((Dentry->CachedInode != NULL) && (StrCmp (Dentry->Name, Name) == 0)) {
+      // Move it to the front of the LRU list
+      RemoveEntryList (&Dentry->CacheNode);
+      InsertHeadList (&Partition->DentryCache, &Dentry->CacheNode);
+      return Dentry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+   Opens a file using a cached dentry, without reading anything from the disk.
+
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[in]      OpenMode    Mode in which the file is supposed to be open.
+   @param[out]     OutFile     Pointer to the newly opened file.
+   @param[in]      Dentry      Pointer to the cached dentry.
+
+   @retval EFI_STATUS          Result of the operation
+**/
+EFI_STATUS
+Ext4OpenCachedDentry (
+  IN  EXT4_PARTITION  *Partition,
+  IN  UINT64          OpenMode,
+  OUT EXT4_FILE       **OutFile,
+  IN  EXT4_DENTRY     *Dentry
+  )
+{
+  EFI_STATUS  Status;
+  EXT4_FILE   *File;
+
+  ASSERT (Dentry->CachedInode != NULL);
+
+  File = AllocateZeroPool (sizeof (EXT4_FILE));
+
+  if (File == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  File->Inode = AllocateCopyPool (Partition->InodeSize, Dentry->CachedInode);
+
+  if (File->Inode == NULL) {
+    FreePool (File);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = Ext4InitExtentsMap (File);
+
+  if (EFI_ERROR (Status)) {
+    FreePool (File->Inode);
+    FreePool (File);
+    return Status;
+  }
+
+  File->InodeNum = Dentry->Inode;
+  File->Dentry   = Dentry;
+  Ext4RefDentry (Dentry);
+
+  Ext4SetupFile (File, Partition);
+
+  *OutFile = File;
+
+  InsertTailList (&Partition->OpenFiles, &File->OpenFilesListNode);
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Empties the dentry cache.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+**/
+VOID
+Ext4FlushDentryCache (
+  IN OUT EXT4_PARTITION  *Partition
+  )
+{
+  LIST_ENTRY  *Node;
+  LIST_ENTRY  *NextNode;
+
+  BASE_LIST_FOR_EACH_SAFE (Node, NextNode, &Partition->DentryCache) {
+    Ext4UncacheDentry (Partition, EXT4_DENTRY_FROM_CACHE_NODE (Node));
+  }
+}
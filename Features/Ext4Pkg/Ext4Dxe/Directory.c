@@ -10,6 +10,16 @@
 
 #include <Library/BaseUcs2Utf8Lib.h>
 
+// A level of a hash tree lookup
+typedef struct {
+  // Node's block
+  CHAR8            *Block;
+  EXT4_DX_ENTRY    *Entries;
+  UINTN            Count;
+  // Index of the entry the lookup went through
+  UINTN            At;
+} EXT4_DX_FRAME;
+
 /**
    Retrieves the filename of the directory entry and converts it to UTF-16/UCS-2
 
@@ -81,6 +91,454 @@ Ext4ValidDirent (
   return TRUE;
 }
 
+/**
+   Folds a UCS-2 filename to lower case ASCII, so it can be compared against
+   on-disk names without converting them.
+
+   @param[in]      Name        Pointer to the UCS-2 formatted filename.
+   @param[in]      NameLength  Length of Name, in characters.
+   @param[out]     AsciiName   Pointer to an array of CHAR8's, of size EXT4_NAME_MAX.
+
+   @retval TRUE          Name is pure ASCII and was folded.
+           FALSE         Name isn't pure ASCII, or is too long to be a dirent name.
+**/
+STATIC
+BOOLEAN
+Ext4FoldAsciiName (
+  IN CONST CHAR16  *Name,
+  IN UINTN         NameLength,
+  OUT CHAR8        AsciiName[EXT4_NAME_MAX]
+  )
+{
+  UINTN  Index;
+
+  if (NameLength > EXT4_NAME_MAX) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < NameLength; Index++) {
+    if (Name[Index] >= 0x80) {
+      return FALSE;
+    }
+
+    AsciiName[Index] = (CHAR8)Name[Index];
+    if ((AsciiName[Index] >= 'A') && (AsciiName[Index] <= 'Z')) {
+      AsciiName[Index] += 'a' - 'A';
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+   Compares a directory entry's name against a name folded by Ext4FoldAsciiName,
+   ignoring ASCII case.
+
+   A dirent name with non-ASCII bytes never matches: its UTF-8 sequences decode to
+   fewer characters than the ASCII name has bytes.
+
+   @param[in]      Entry       Pointer to a EXT4_DIR_ENTRY, of the same name length.
+   @param[in]      AsciiName   Pointer to the folded name.
+
+   @retval TRUE          The names match.
+           FALSE         The names don't match.
+**/
+STATIC
+BOOLEAN
+Ext4AsciiDirentNameMatches (
+  IN CONST EXT4_DIR_ENTRY  *Entry,
+  IN CONST CHAR8           *AsciiName
+  )
+{
+  UINTN  Index;
+  CHAR8  Char;
+
+  for (Index = 0; Index < Entry->name_len; Index++) {
+    Char = Entry->name[Index];
+
+    if ((Char >= 'A') && (Char <= 'Z')) {
+      Char += 'a' - 'A';
+    }
+
+    // Non-ASCII bytes can't be equal to the folded name's
+    if (Char != AsciiName[Index]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+   Checks if a directory is indexed by a hash tree.
+
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[in]      Directory   Pointer to the opened directory.
+
+   @retval TRUE          The directory has a hash tree.
+           FALSE         The directory must be scanned linearly.
+**/
+STATIC
+BOOLEAN
+Ext4DirIsIndexed (
+  IN CONST EXT4_PARTITION  *Partition,
+  IN CONST EXT4_FILE       *Directory
+  )
+{
+  // Single block directories can't have a hash tree, even if they're flagged
+  return EXT4_HAS_COMPAT (Partition, EXT4_FEATURE_COMPAT_DIR_INDEX) &&
+         ((Directory->Inode->i_flags & EXT4_INDEX_FL) != 0) &&
+         (EXT4_INODE_SIZE (Directory->Inode) > Partition->BlockSize);
+}
+
+/**
+   Reads a logical block of a directory.
+
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[in]      Directory   Pointer to the opened directory.
+   @param[in]      Block       Logical block number.
+   @param[out]     Buffer      Pointer to a buffer of BlockSize bytes.
+
+   @return The result of the operation.
+**/
+STATIC
+EFI_STATUS
+Ext4DxReadBlock (
+  IN  EXT4_PARTITION  *Partition,
+  IN  EXT4_FILE       *Directory,
+  IN  UINT32          Block,
+  OUT CHAR8           *Buffer
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Length;
+
+  Block &= EXT4_DX_BLOCK_MASK;
+
+  if (Block >= DivU64x32 (EXT4_INODE_SIZE (Directory->Inode), Partition->BlockSize)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Length = Partition->BlockSize;
+
+  Status = Ext4Read (Partition, Directory, Buffer, MultU64x32 (Block, Partition->BlockSize), &Length);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return Length == Partition->BlockSize ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+}
+
+/**
+   Parses a hash tree node's entries and finds the entry that covers a hash.
+
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[in]      Block       Pointer to the node's block.
+   @param[in]      Offset      Offset of the entries (and their count/limit) in the block.
+   @param[in]      Hash        Hash to look up.
+   @param[out]     Frame       Pointer to the frame to fill.
+
+   @retval EFI_SUCCESS           The node was parsed.
+   @retval EFI_VOLUME_CORRUPTED  The node is corrupted.
+**/
+STATIC
+EFI_STATUS
+Ext4DxParseNode (
+  IN  CONST EXT4_PARTITION  *Partition,
+  IN  CHAR8                 *Block,
+  IN  UINTN                 Offset,
+  IN  UINT32                Hash,
+  OUT EXT4_DX_FRAME         *Frame
+  )
+{
+  EXT4_DX_COUNTLIMIT  *CountLimit;
+  UINTN               Low;
+  UINTN               High;
+  UINTN               Middle;
+
+  CountLimit = (EXT4_DX_COUNTLIMIT *)(Block + Offset);
+
+  if (  (CountLimit->count == 0) || (CountLimit->count > CountLimit->limit)
+     || (Offset + CountLimit->limit * sizeof (EXT4_DX_ENTRY) > Partition->BlockSize))
+  {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Frame->Entries = (EXT4_DX_ENTRY *)(Block + Offset);
+  Frame->Count   = CountLimit->count;
+
+  // Entries are sorted by hash, and the first one (the count/limit) covers
+  // everything below the second one's hash.
+  Low  = 1;
+  High = Frame->Count - 1;
+
+  while (Low <= High) {
+    Middle = (Low + High) / 2;
+
+    if (Frame->Entries[Middle].hash > Hash) {
+      High = Middle - 1;
+    } else {
+      Low = Middle + 1;
+    }
+  }
+
+  Frame->At = Low - 1;
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Retrieves a directory entry from a hash tree leaf block.
+   Names are compared byte by byte, exactly as they're stored on disk.
+
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[in]      Block       Pointer to the leaf block.
+   @param[in]      Name        Pointer to the UTF-8 filename.
+   @param[in]      NameLength  Length of the filename, in bytes.
+   @param[out]     Result      Pointer to the destination directory entry.
+
+   @retval EFI_SUCCESS           The entry was found.
+   @retval EFI_NOT_FOUND         The entry is not in this block.
+   @retval EFI_VOLUME_CORRUPTED  The block is corrupted.
+**/
+STATIC
+EFI_STATUS
+Ext4DxSearchLeaf (
+  IN  CONST EXT4_PARTITION  *Partition,
+  IN  CHAR8                 *Block,
+  IN  CONST CHAR8           *Name,
+  IN  UINTN                 NameLength,
+  OUT EXT4_DIR_ENTRY        *Result
+  )
+{
+  EXT4_DIR_ENTRY  *Entry;
+  UINTN           BlockOffset;
+  UINTN           RemainingBlock;
+
+  for (BlockOffset = 0; BlockOffset < Partition->BlockSize; BlockOffset += Entry->rec_len) {
+    Entry          = (EXT4_DIR_ENTRY *)(Block + BlockOffset);
+    RemainingBlock = Partition->BlockSize - BlockOffset;
+
+    if (  (RemainingBlock < EXT4_MIN_DIR_ENTRY_LEN) || !Ext4ValidDirent (Entry)
+       || (Entry->name_len > RemainingBlock) || (Entry->rec_len > RemainingBlock))
+    {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (  (Entry->inode != 0) && (Entry->name_len == NameLength)
+       && (CompareMem (Entry->name, Name, NameLength) == 0))
+    {
+      CopyMem (Result, Entry, MIN (Entry->rec_len, sizeof (EXT4_DIR_ENTRY)));
+      return EFI_SUCCESS;
+    }
+  }
+
+  return EFI_NOT_FOUND;
+}
+
+/**
+   Advances to the next leaf of the hash tree, if it may hold entries with the
+   same hash (on hash collisions, entries can spill over to the next leaf).
+
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[in]      Directory   Pointer to the opened directory.
+   @param[in out]  Frames      Path from the root to the current leaf.
+   @param[in]      Depth       Index of the deepest frame.
+   @param[in]      Hash        Hash being looked up.
+
+   @retval EFI_SUCCESS     The deepest frame now points to the next leaf.
+   @retval EFI_NOT_FOUND   No other leaf can hold the hash.
+   @retval !EFI_SUCCESS    Failed to read an interior node.
+**/
+STATIC
+EFI_STATUS
+Ext4DxNextLeaf (
+  IN     EXT4_PARTITION  *Partition,
+  IN     EXT4_FILE       *Directory,
+  IN OUT EXT4_DX_FRAME   *Frames,
+  IN     UINTN           Depth,
+  IN     UINT32          Hash
+  )
+{
+  EFI_STATUS          Status;
+  UINTN               Level;
+  EXT4_DX_COUNTLIMIT  *CountLimit;
+
+  Level = Depth;
+
+  while (++Frames[Level].At >= Frames[Level].Count) {
+    if (Level == 0) {
+      return EFI_NOT_FOUND;
+    }
+
+    Level--;
+  }
+
+  // A continuation block is marked by setting the lowest bit of its hash
+  if ((Frames[Level].Entries[Frames[Level].At].hash & ~1U) != Hash) {
+    return EFI_NOT_FOUND;
+  }
+
+  // Walk back down the left side of the subtree
+  for ( ; Level < Depth; Level++) {
+    Status = Ext4DxReadBlock (
+               Partition,
+               Directory,
+               Frames[Level].Entries[Frames[Level].At].block,
+               Frames[Level + 1].Block
+               );
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    CountLimit = (EXT4_DX_COUNTLIMIT *)(Frames[Level + 1].Block + EXT4_DX_NODE_ENTRIES_OFFSET);
+
+    if (  (CountLimit->count == 0) || (CountLimit->count > CountLimit->limit)
+       || (EXT4_DX_NODE_ENTRIES_OFFSET + CountLimit->limit * sizeof (EXT4_DX_ENTRY) > Partition->BlockSize))
+    {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    Frames[Level + 1].Entries = (EXT4_DX_ENTRY *)CountLimit;
+    Frames[Level + 1].Count   = CountLimit->count;
+    Frames[Level + 1].At      = 0;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Retrieves a directory entry using the directory's hash tree.
+
+   @param[in]      Directory   Pointer to the opened directory.
+   @param[in]      Name        Pointer to the UCS-2 formatted filename.
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[out]     Result      Pointer to the destination directory entry.
+
+   @retval EFI_SUCCESS           The entry was found.
+   @retval EFI_NOT_FOUND         No entry has this exact name.
+   @retval EFI_UNSUPPORTED       The hash tree can't be used.
+   @retval EFI_VOLUME_CORRUPTED  The hash tree is corrupted.
+   @retval !EFI_SUCCESS          Failed to read the directory.
+**/
+STATIC
+EFI_STATUS
+Ext4DxRetrieveDirent (
+  IN EXT4_FILE        *Directory,
+  IN CONST CHAR16     *Name,
+  IN EXT4_PARTITION   *Partition,
+  OUT EXT4_DIR_ENTRY  *Result
+  )
+{
+  EFI_STATUS         Status;
+  CHAR8              *Utf8Name;
+  UINTN              NameLength;
+  CHAR8              *Buf;
+  CHAR8              *Leaf;
+  EXT4_DX_ROOT_INFO  *RootInfo;
+  EXT4_DX_FRAME      Frames[EXT4_DX_MAX_INDIRECT_LEVELS_LARGEDIR + 1];
+  UINTN              Depth;
+  UINTN              Level;
+  UINTN              Offset;
+  UINT32             Hash;
+
+  Status = UCS2StrToUTF8 ((CHAR16 *)Name, &Utf8Name);
+
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  NameLength = AsciiStrLen (Utf8Name);
+
+  if (NameLength > EXT4_NAME_MAX) {
+    FreePool (Utf8Name);
+    return EFI_NOT_FOUND;
+  }
+
+  // One block for each level of the tree, plus one for the leaf
+  Buf = AllocatePool (Partition->BlockSize * (ARRAY_SIZE (Frames) + 1));
+
+  if (Buf == NULL) {
+    FreePool (Utf8Name);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Level = 0; Level < ARRAY_SIZE (Frames); Level++) {
+    Frames[Level].Block = Buf + Level * Partition->BlockSize;
+  }
+
+  Leaf = Buf + ARRAY_SIZE (Frames) * Partition->BlockSize;
+
+  Status = Ext4DxReadBlock (Partition, Directory, 0, Frames[0].Block);
+
+  if (EFI_ERROR (Status)) {
+    goto Out;
+  }
+
+  RootInfo = (EXT4_DX_ROOT_INFO *)(Frames[0].Block + EXT4_DX_ROOT_INFO_OFFSET);
+  Depth    = RootInfo->indirect_levels;
+
+  if (  (RootInfo->reserved_zero != 0) || (RootInfo->info_length < sizeof (EXT4_DX_ROOT_INFO))
+     || (Depth > (EXT4_HAS_INCOMPAT (Partition, EXT4_FEATURE_INCOMPAT_LARGEDIR) ?
+                  EXT4_DX_MAX_INDIRECT_LEVELS_LARGEDIR : EXT4_DX_MAX_INDIRECT_LEVELS)))
+  {
+    Status = EFI_VOLUME_CORRUPTED;
+    goto Out;
+  }
+
+  Status = Ext4DirHash (Partition, RootInfo->hash_version, Utf8Name, NameLength, &Hash);
+
+  if (EFI_ERROR (Status)) {
+    goto Out;
+  }
+
+  Offset = EXT4_DX_ROOT_INFO_OFFSET + RootInfo->info_length;
+
+  for (Level = 0; ; Level++) {
+    Status = Ext4DxParseNode (Partition, Frames[Level].Block, Offset, Hash, &Frames[Level]);
+
+    if (EFI_ERROR (Status) || (Level == Depth)) {
+      break;
+    }
+
+    Status = Ext4DxReadBlock (
+               Partition,
+               Directory,
+               Frames[Level].Entries[Frames[Level].At].block,
+               Frames[Level + 1].Block
+               );
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Offset = EXT4_DX_NODE_ENTRIES_OFFSET;
+  }
+
+  while (!EFI_ERROR (Status)) {
+    Status = Ext4DxReadBlock (Partition, Directory, Frames[Depth].Entries[Frames[Depth].At].block, Leaf);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Status = Ext4DxSearchLeaf (Partition, Leaf, Utf8Name, NameLength, Result);
+
+    if (Status != EFI_NOT_FOUND) {
+      break;
+    }
+
+    Status = Ext4DxNextLeaf (Partition, Directory, Frames, Depth, Hash);
+  }
+
+Out:
+  FreePool (Buf);
+  FreePool (Utf8Name);
+  return Status;
+}
+
 /**
    Retrieves a directory entry.
 
@@ -111,15 +569,9 @@ Ext4RetrieveDirent (
   CHAR16          DirentUcs2Name[EXT4_NAME_MAX + 1];
   UINTN           ToCopy;
   UINTN           BlockOffset;
-
-  Status = EFI_NOT_FOUND;
-  Buf    = AllocatePool (Partition->BlockSize);
-
-  if (Buf == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  Off = 0;
+  UINTN           NameLength;
+  CHAR8           AsciiName[EXT4_NAME_MAX];
+  BOOLEAN         NameIsAscii;
 
   Inode      = Directory->Inode;
   DirInoSize = EXT4_INODE_SIZE (Inode);
@@ -130,13 +582,50 @@ Ext4RetrieveDirent (
     return EFI_VOLUME_CORRUPTED;
   }
 
+  // "." and ".." are always at the start of the first block, so don't bother hashing them
+  if (  Ext4DirIsIndexed (Partition, Directory)
+     && (StrCmp (Name, L".") != 0) && (StrCmp (Name, L"..") != 0))
+  {
+    Status = Ext4DxRetrieveDirent (Directory, Name, Partition, Result);
+
+    // The hash tree only finds exact matches, but UEFI file names are
+    // case-insensitive, so we still fall back to a linear scan on a miss.
+    // A corrupted or unsupported hash tree must not make files unreachable
+    // either, since the leaves are still valid linear directory blocks.
+    if ((Status != EFI_NOT_FOUND) && (Status != EFI_UNSUPPORTED) && (Status != EFI_VOLUME_CORRUPTED)) {
+      return Status;
+    }
+
+    if (Status != EFI_NOT_FOUND) {
+      DEBUG ((DEBUG_WARN, "[ext4] Can't use the directory's hash tree (%r), falling back to a linear scan\n", Status));
+    }
+  }
+
+  // Lookups are frequent, so they all scan through the same buffer
+  if (Partition->DirentScratch == NULL) {
+    Partition->DirentScratch = AllocatePool (Partition->BlockSize);
+
+    if (Partition->DirentScratch == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+
+  Status = EFI_NOT_FOUND;
+  Buf    = Partition->DirentScratch;
+
+  Off        = 0;
+  NameLength = StrLen (Name);
+
+  // Most names are pure ASCII, and can be compared without going through
+  // UTF-8 conversion and the Unicode collation protocol.
+  NameIsAscii = Ext4FoldAsciiName (Name, NameLength, AsciiName);
+
   while (Off < DirInoSize) {
     Length = Partition->BlockSize;
 
     Status = Ext4Read (Partition, Directory, Buf, Off, &Length);
 
     if (Status != EFI_SUCCESS) {
-      FreePool (Buf);
       return Status;
     }
 
@@ -145,18 +634,15 @@ Ext4RetrieveDirent (
       RemainingBlock = Partition->BlockSize - BlockOffset;
       // Check if the minimum directory entry fits inside [BlockOffset, EndOfBlock]
       if (RemainingBlock < EXT4_MIN_DIR_ENTRY_LEN) {
-        FreePool (Buf);
         return EFI_VOLUME_CORRUPTED;
       }
 
       if (!Ext4ValidDirent (Entry)) {
-        FreePool (Buf);
         return EFI_VOLUME_CORRUPTED;
       }
 
       if ((Entry->name_len > RemainingBlock) || (Entry->rec_len > RemainingBlock)) {
         // Corrupted filesystem
-        FreePool (Buf);
         return EFI_VOLUME_CORRUPTED;
       }
 
@@ -166,6 +652,28 @@ Ext4RetrieveDirent (
         continue;
       }
 
+      // Check the length first to avoid converting names that can't match.
+      // Each UCS-2 character takes 1 to 3 bytes in UTF-8.
+      if (  (Entry->name_len < NameLength)
+         || (Entry->name_len > NameLength * 3)
+         || (NameIsAscii && (Entry->name_len != NameLength)))
+      {
+        BlockOffset += Entry->rec_len;
+        continue;
+      }
+
+      if (NameIsAscii) {
+        if (Ext4AsciiDirentNameMatches (Entry, AsciiName)) {
+          ToCopy = MIN (Entry->rec_len, sizeof (EXT4_DIR_ENTRY));
+
+          CopyMem (Result, Entry, ToCopy);
+          return EFI_SUCCESS;
+        }
+
+        BlockOffset += Entry->rec_len;
+        continue;
+      }
+
       Status = Ext4GetUcs2DirentName (Entry, DirentUcs2Name);
 
       /* In theory, this should never fail.
@@ -180,13 +688,10 @@ Ext4RetrieveDirent (
         continue;
       }
 
-      if ((Entry->name_len == StrLen (Name)) &&
-          !Ext4StrCmpInsensitive (DirentUcs2Name, (CHAR16 *)Name))
-      {
+      if (!Ext4StrCmpInsensitive (DirentUcs2Name, (CHAR16 *)Name)) {
         ToCopy = MIN (Entry->rec_len, sizeof (EXT4_DIR_ENTRY));
 
         CopyMem (Result, Entry, ToCopy);
-        FreePool (Buf);
         return EFI_SUCCESS;
       }
 
@@ -196,7 +701,6 @@ Ext4RetrieveDirent (
     Off += Partition->BlockSize;
   }
 
-  FreePool (Buf);
   return EFI_NOT_FOUND;
 }
 
@@ -319,6 +823,21 @@ Ext4OpenFile (
 {
   EXT4_DIR_ENTRY  Entry;
   EFI_STATUS      Status;
+  EXT4_DENTRY     *Dentry;
+
+  // Repeated opens of the same path skip both the directory lookup and the inode read
+  Dentry = Ext4LookupCachedDentry (Partition, Directory->Dentry, Name);
+
+  if (Dentry != NULL) {
+    Status = Ext4OpenCachedDentry (Partition, OpenMode, OutFile, Dentry);
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Ext4PrefetchExtents (Partition, *OutFile);
+    return EFI_SUCCESS;
+  }
 
   Status = Ext4RetrieveDirent (Directory, Name, Partition, &Entry);
 
@@ -331,7 +850,21 @@ Ext4OpenFile (
     return EFI_NOT_FOUND;
   }
 
-  return Ext4OpenDirent (Partition, OpenMode, OutFile, &Entry, Directory);
+  Status = Ext4OpenDirent (Partition, OpenMode, OutFile, &Entry, Directory);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  // "." and ".." reuse existing dentries, which are either already cached or
+  // don't belong to this directory.
+  if ((*OutFile)->Dentry->Parent == Directory->Dentry) {
+    Ext4CacheDentry (Partition, (*OutFile)->Dentry, (*OutFile)->Inode, (*OutFile)->InodeNum);
+  }
+
+  Ext4PrefetchExtents (Partition, *OutFile);
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -406,6 +939,151 @@ Ext4OpenVolume (
   return EFI_SUCCESS;
 }
 
+/**
+   Inserts a block number into a sorted array of unique block numbers.
+
+   @param[in out]  Blocks         Pointer to the sorted array.
+   @param[in out]  NumberBlocks   Number of blocks in the array.
+   @param[in]      BlockNr        Block number to insert.
+**/
+STATIC
+VOID
+Ext4InsertSortedBlock (
+  IN OUT EXT4_BLOCK_NR  *Blocks,
+  IN OUT UINTN          *NumberBlocks,
+  IN     EXT4_BLOCK_NR  BlockNr
+  )
+{
+  UINTN  Index;
+
+  Index = *NumberBlocks;
+
+  while (Index != 0 && Blocks[Index - 1] > BlockNr) {
+    Index--;
+  }
+
+  if ((Index != 0) && (Blocks[Index - 1] == BlockNr)) {
+    return;
+  }
+
+  CopyMem (&Blocks[Index + 1], &Blocks[Index], (*NumberBlocks - Index) * sizeof (EXT4_BLOCK_NR));
+  Blocks[Index] = BlockNr;
+  (*NumberBlocks)++;
+}
+
+/**
+   Prefetches the inode table blocks of the remaining entries in the directory
+   block that contains Offset, so ReadDir() doesn't need to read the inode
+   table one inode at a time.
+   The blocks are sorted and physically contiguous blocks are read together;
+   with flex_bg, the inode tables of a flex group are laid out back to back,
+   so this usually ends up being a handful of (large) reads.
+
+   @param[in]      Partition      Pointer to the ext4 partition.
+   @param[in out]  File           Pointer to the open directory.
+   @param[in]      Offset         Offset of the next directory entry.
+**/
+STATIC
+VOID
+Ext4PrefetchDirInodes (
+  IN     EXT4_PARTITION  *Partition,
+  IN OUT EXT4_FILE       *File,
+  IN     UINT64          Offset
+  )
+{
+  UINT32                 BlockOffset;
+  UINTN                  Length;
+  UINTN                  Pos;
+  UINT8                  *DirBlock;
+  EXT4_DIR_ENTRY         *Entry;
+  EXT4_BLOCK_NR          *Blocks;
+  UINTN                  NumberBlocks;
+  UINTN                  Index;
+  UINTN                  RunStart;
+  UINT64                 InodeIndex;
+  UINT32                 BlockGroupNumber;
+  EXT4_BLOCK_GROUP_DESC  *BlockGroup;
+  EXT4_BLOCK_NR          InodeTableStart;
+  EFI_STATUS             Status;
+
+  DivU64x32Remainder (Offset, Partition->BlockSize, &BlockOffset);
+  Length = Partition->BlockSize - BlockOffset;
+
+  // Whatever happens, don't try again until the next directory block.
+  File->InodesPrefetchedUpTo = Offset + Length;
+
+  if (Partition->BlockCache.MaxEntries == 0) {
+    return;
+  }
+
+  DirBlock = AllocatePool (Length);
+  Blocks   = AllocatePool ((Length / EXT4_MIN_DIR_ENTRY_LEN) * sizeof (EXT4_BLOCK_NR));
+
+  if ((DirBlock == NULL) || (Blocks == NULL)) {
+    goto Out;
+  }
+
+  Status = Ext4Read (Partition, File, DirBlock, Offset, &Length);
+
+  if (EFI_ERROR (Status)) {
+    goto Out;
+  }
+
+  NumberBlocks = 0;
+
+  for (Pos = 0; Pos + EXT4_MIN_DIR_ENTRY_LEN <= Length; Pos += Entry->rec_len) {
+    Entry = (EXT4_DIR_ENTRY *)(DirBlock + Pos);
+
+    if (!Ext4ValidDirent (Entry) || (Entry->rec_len > Length - Pos)) {
+      // ReadDir() will find (and report) the corruption by itself.
+      break;
+    }
+
+    if (Entry->inode == 0) {
+      continue;
+    }
+
+    BlockGroupNumber = (UINT32)DivU64x64Remainder (
+                                 Entry->inode - 1,
+                                 Partition->SuperBlock.s_inodes_per_group,
+                                 &InodeIndex
+                                 );
+
+    if (BlockGroupNumber >= Partition->NumberBlockGroups) {
+      continue;
+    }
+
+    BlockGroup      = Ext4GetBlockGroupDesc (Partition, BlockGroupNumber);
+    InodeTableStart = EXT4_BLOCK_NR_FROM_HALFS (
+                        Partition,
+                        BlockGroup->bg_inode_table_lo,
+                        BlockGroup->bg_inode_table_hi
+                        );
+
+    Ext4InsertSortedBlock (
+      Blocks,
+      &NumberBlocks,
+      InodeTableStart + DivU64x32 (MultU64x32 (InodeIndex, Partition->InodeSize), Partition->BlockSize)
+      );
+  }
+
+  for (RunStart = 0, Index = 1; Index <= NumberBlocks; Index++) {
+    if ((Index == NumberBlocks) || (Blocks[Index] != Blocks[Index - 1] + 1)) {
+      Ext4PrefetchBlocks (Partition, Blocks[RunStart], (UINT32)(Index - RunStart));
+      RunStart = Index;
+    }
+  }
+
+Out:
+  if (DirBlock != NULL) {
+    FreePool (DirBlock);
+  }
+
+  if (Blocks != NULL) {
+    FreePool (Blocks);
+  }
+}
+
 /**
    Reads a directory entry.
 
@@ -503,6 +1181,10 @@ Ext4ReadDir (
       continue;
     }
 
+    if (Offset >= File->InodesPrefetchedUpTo) {
+      Ext4PrefetchDirInodes (Partition, File, Offset);
+    }
+
     Status = Ext4OpenDirent (Partition, EFI_FILE_MODE_READ, &TempFile, &Entry, File);
 
     if (EFI_ERROR (Status)) {
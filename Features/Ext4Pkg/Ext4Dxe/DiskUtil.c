@@ -24,6 +24,9 @@ Ext4ReadDiskIo (
   IN UINT64          Offset
   )
 {
+  Partition->Statistics.DiskReads++;
+  Partition->Statistics.DiskBytesRead += Length;
+
   return EXT4_DISK_IO (Partition)->ReadDisk (
                                      EXT4_DISK_IO (Partition),
                                      EXT4_MEDIA_ID (Partition),
@@ -34,7 +37,182 @@ Ext4ReadDiskIo (
 }
 
 /**
-   Reads blocks from the partition's disk using the DISK_IO protocol.
+   Retrieves the partition's statistics.
+
+   @param[in]      This          Pointer to the EXT4_STATISTICS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+EFI_STATUS
+EFIAPI
+Ext4GetStatistics (
+  IN  EXT4_STATISTICS_PROTOCOL  *This,
+  OUT EXT4_STATISTICS           *Statistics
+  )
+{
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  CopyMem (Statistics, &EXT4_PARTITION_FROM_STATISTICS (This)->Statistics, sizeof (EXT4_STATISTICS));
+  return EFI_SUCCESS;
+}
+
+/**
+   Resets the partition's statistics to zero.
+
+   @param[in]      This          Pointer to the EXT4_STATISTICS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+EFI_STATUS
+EFIAPI
+Ext4ResetStatistics (
+  IN EXT4_STATISTICS_PROTOCOL  *This
+  )
+{
+  ZeroMem (&EXT4_PARTITION_FROM_STATISTICS (This)->Statistics, sizeof (EXT4_STATISTICS));
+  return EFI_SUCCESS;
+}
+
+/**
+   Initialises a batch of reads.
+   Reads are only issued asynchronously if the partition's disk supports
+   DISK_IO2 and we're running at TPL_APPLICATION, where we can wait for them.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[out] Batch          Pointer to the batch.
+**/
+VOID
+Ext4InitIoBatch (
+  IN  EXT4_PARTITION  *Partition,
+  OUT EXT4_IO_BATCH   *Batch
+  )
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  gBS->RestoreTPL (OldTpl);
+
+  Batch->NumberTokens = 0;
+  Batch->Status       = EFI_SUCCESS;
+  Batch->Async        = (EXT4_DISK_IO2 (Partition) != NULL) && (OldTpl == TPL_APPLICATION);
+}
+
+/**
+   Waits for every read of the batch to complete.
+   The batch can be reused afterwards.
+
+   @param[in out] Batch       Pointer to the batch.
+
+   @return The status of the first read that failed, or EFI_SUCCESS.
+**/
+EFI_STATUS
+Ext4WaitIoBatch (
+  IN OUT EXT4_IO_BATCH  *Batch
+  )
+{
+  EFI_DISK_IO2_TOKEN  *Token;
+  EFI_STATUS          Status;
+  UINTN               Index;
+  UINTN               EventIndex;
+
+  for (Index = 0; Index < Batch->NumberTokens; Index++) {
+    Token = &Batch->Tokens[Index];
+
+    Status = gBS->WaitForEvent (1, &Token->Event, &EventIndex);
+
+    if (EFI_ERROR (Status)) {
+      // This can't happen at TPL_APPLICATION, but don't ever let the read
+      // complete into a buffer we've already given back.
+      while (gBS->CheckEvent (Token->Event) == EFI_NOT_READY) {
+      }
+    }
+
+    if (EFI_ERROR (Token->TransactionStatus) && !EFI_ERROR (Batch->Status)) {
+      Batch->Status = Token->TransactionStatus;
+    }
+
+    gBS->CloseEvent (Token->Event);
+  }
+
+  Batch->NumberTokens = 0;
+  return Batch->Status;
+}
+
+/**
+   Reads from the partition's disk as part of a batch of reads.
+   If the disk supports DISK_IO2, the read is only started, and the buffer
+   must not be touched until Ext4WaitIoBatch() is called. Otherwise, this
+   is just a synchronous Ext4ReadDiskIo().
+
+   @param[in]     Partition   Pointer to the opened ext4 partition.
+   @param[in out] Batch       Pointer to the batch.
+   @param[out]    Buffer      Pointer to a destination buffer.
+   @param[in]     Length      Length of the destination buffer.
+   @param[in]     Offset      Offset, in bytes, of the location to read.
+
+   @return Success status of the disk read (or of its submission).
+**/
+EFI_STATUS
+Ext4ReadDiskIoAsync (
+  IN     EXT4_PARTITION  *Partition,
+  IN OUT EXT4_IO_BATCH   *Batch,
+  OUT    VOID            *Buffer,
+  IN     UINTN           Length,
+  IN     UINT64          Offset
+  )
+{
+  EFI_DISK_IO2_TOKEN  *Token;
+  EFI_STATUS          Status;
+
+  if (!Batch->Async) {
+    return Ext4ReadDiskIo (Partition, Buffer, Length, Offset);
+  }
+
+  if (Batch->NumberTokens == EXT4_MAX_INFLIGHT_READS) {
+    Status = Ext4WaitIoBatch (Batch);
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  Token = &Batch->Tokens[Batch->NumberTokens];
+
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Token->Event);
+
+  if (EFI_ERROR (Status)) {
+    return Ext4ReadDiskIo (Partition, Buffer, Length, Offset);
+  }
+
+  Token->TransactionStatus = EFI_SUCCESS;
+
+  Partition->Statistics.DiskReads++;
+  Partition->Statistics.DiskBytesRead += Length;
+
+  Status = EXT4_DISK_IO2 (Partition)->ReadDiskEx (
+                                        EXT4_DISK_IO2 (Partition),
+                                        EXT4_MEDIA_ID (Partition),
+                                        Offset,
+                                        Token,
+                                        Length,
+                                        Buffer
+                                        );
+
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (Token->Event);
+    return Status;
+  }
+
+  Batch->NumberTokens++;
+  return EFI_SUCCESS;
+}
+
+/**
+   Reads blocks from the partition's disk, through the partition's block cache.
 
    @param[in]  Partition      Pointer to the opened ext4 partition.
    @param[out] Buffer         Pointer to a destination buffer.
@@ -68,7 +246,7 @@ Ext4ReadBlocks (
     return EFI_INVALID_PARAMETER;
   }
 
-  return Ext4ReadDiskIo (Partition, Buffer, Length, Offset);
+  return Ext4ReadCached (Partition, Buffer, Length, Offset);
 }
 
 /**
@@ -68,7 +68,8 @@
           mostly-list of EXT4_DIR_ENTRY.
        2) Hash tree directories: These are used for larger directories, with
           hundreds of entries, and are designed in a backwards compatible way.
-          These are not yet implemented in the Ext4Dxe driver.
+          Ext4Dxe uses them to speed up lookups, and falls back to a linear
+          scan if the tree looks corrupted.
 
   7) Journal
      Ext3/4 filesystems have a journal to help protect the filesystem against
@@ -406,6 +407,60 @@ typedef struct {
 
 #define EXT4_MIN_DIR_ENTRY_LEN  8
 
+// Hash versions used by hash tree (dir_index) directories
+#define EXT4_DX_HASH_LEGACY             0
+#define EXT4_DX_HASH_HALF_MD4           1
+#define EXT4_DX_HASH_TEA                2
+#define EXT4_DX_HASH_LEGACY_UNSIGNED    3
+#define EXT4_DX_HASH_HALF_MD4_UNSIGNED  4
+#define EXT4_DX_HASH_TEA_UNSIGNED       5
+
+// s_flags values
+#define EXT4_FLAGS_SIGNED_HASH    0x1
+#define EXT4_FLAGS_UNSIGNED_HASH  0x2
+
+// This on-disk structure follows the "." and ".." entries in the first
+// block of a hash tree directory.
+typedef struct {
+  UINT32    reserved_zero;
+  UINT8     hash_version;
+  // Length of this structure, should be 8
+  UINT8     info_length;
+  // Depth of the tree, not counting the root and the leaves
+  UINT8     indirect_levels;
+  UINT8     unused_flags;
+} EXT4_DX_ROOT_INFO;
+
+// Offset of EXT4_DX_ROOT_INFO in the root block, past the "." and ".." entries
+#define EXT4_DX_ROOT_INFO_OFFSET  24
+
+// Interior nodes start with a fake, empty directory entry that covers the whole block
+#define EXT4_DX_NODE_ENTRIES_OFFSET  8
+
+// The first entry of every node is replaced by this count/limit structure;
+// its block covers every hash below the second entry's.
+typedef struct {
+  // Maximum number of entries that could fit in this node
+  UINT16    limit;
+  // Number of entries, including this one
+  UINT16    count;
+  UINT32    block;
+} EXT4_DX_COUNTLIMIT;
+
+typedef struct {
+  // Lowest hash covered by 'block'
+  UINT32    hash;
+  // Logical block of the directory
+  UINT32    block;
+} EXT4_DX_ENTRY;
+
+// The top 4 bits of dx block numbers are reserved.
+#define EXT4_DX_BLOCK_MASK  0x0FFFFFFF
+
+// Maximum indirect_levels, with and without the largedir feature
+#define EXT4_DX_MAX_INDIRECT_LEVELS           1
+#define EXT4_DX_MAX_INDIRECT_LEVELS_LARGEDIR  2
+
 // This on-disk structure is present at the bottom of the extent tree
 typedef struct {
   // First logical block
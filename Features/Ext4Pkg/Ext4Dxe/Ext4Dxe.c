@@ -450,6 +450,8 @@ Ext4Stop (
                   ControllerHandle,
                   &gEfiSimpleFileSystemProtocolGuid,
                   &Partition->Interface,
+                  &gExt4StatisticsProtocolGuid,
+                  &Partition->StatisticsInterface,
                   NULL
                   );
 
@@ -515,6 +517,8 @@ Ext4EntryPoint (
 {
   EFI_STATUS  Status;
 
+  Ext4InitCrc32c ();
+
   Status = EfiLibInstallAllDriverProtocols2 (
              ImageHandle,
              SystemTable,
@@ -680,7 +684,7 @@ Ext4IsBindingSupported (
                   );
 
   if (!EFI_ERROR (Status)) {
-    if (!Ext4SuperblockCheckMagic (DiskIo, BlockIo)) {
+    if (!Ext4SuperblockCheckMagic (ControllerHandle, DiskIo, BlockIo)) {
       Status = EFI_UNSUPPORTED;
     }
   }
@@ -16,7 +16,9 @@
 #include <Protocol/BlockIo.h>
 #include <Protocol/DiskIo.h>
 #include <Protocol/DiskIo2.h>
+#include <Protocol/PartitionInfo.h>
 #include <Protocol/SimpleFileSystem.h>
+#include <Protocol/Ext4Statistics.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -58,6 +60,43 @@ Ext4OpenPartition (
 typedef struct _Ext4File     EXT4_FILE;
 typedef struct _Ext4_Dentry  EXT4_DENTRY;
 
+/**
+   A single filesystem block held in the partition's block cache.
+   The block's data immediately follows the structure.
+ */
+typedef struct _Ext4_BLOCK_CACHE_ENTRY {
+  EXT4_BLOCK_NR    BlockNr;
+  LIST_ENTRY       HashNode;
+  LIST_ENTRY       LruNode;
+} EXT4_BLOCK_CACHE_ENTRY;
+
+#define EXT4_BLOCK_CACHE_ENTRY_FROM_HASH_NODE(Node)                            \
+  BASE_CR(Node, EXT4_BLOCK_CACHE_ENTRY, HashNode)
+
+#define EXT4_BLOCK_CACHE_ENTRY_FROM_LRU_NODE(Node)                             \
+  BASE_CR(Node, EXT4_BLOCK_CACHE_ENTRY, LruNode)
+
+#define EXT4_BLOCK_CACHE_ENTRY_DATA(Entry)  ((UINT8 *)((Entry) + 1))
+
+/**
+   Bounded, per-partition cache of filesystem blocks used for metadata reads.
+   Blocks are looked up through a hash table and evicted in LRU order; the head
+   of Lru is the most recently used block.
+ */
+typedef struct _Ext4_BLOCK_CACHE {
+  LIST_ENTRY    *Buckets;
+  UINT32        NumberBuckets;
+  LIST_ENTRY    Lru;
+  UINT32        NumberEntries;
+  UINT32        MaxEntries;
+} EXT4_BLOCK_CACHE;
+
+// A cached extent, or a link in the partition's list of free ones
+typedef union _Ext4_EXTENT_SLOT {
+  EXT4_EXTENT                    Extent;
+  union _Ext4_EXTENT_SLOT        *Next;
+} EXT4_EXTENT_SLOT;
+
 typedef struct _Ext4_PARTITION {
   EFI_SIMPLE_FILE_SYSTEM_PROTOCOL    Interface;
   EFI_DISK_IO_PROTOCOL               *DiskIo;
@@ -85,8 +124,26 @@ typedef struct _Ext4_PARTITION {
   LIST_ENTRY                         OpenFiles;
 
   EXT4_DENTRY                        *RootDentry;
+
+  EXT4_BLOCK_CACHE                   BlockCache;
+
+  // Recently opened dentries, most recently used first
+  LIST_ENTRY                         DentryCache;
+  UINT32                             NumberCachedDentries;
+
+  // Block-sized buffer reused by every linear directory lookup
+  CHAR8                              *DirentScratch;
+
+  // Extents freed by closed files, kept around for the next file to cache
+  EXT4_EXTENT_SLOT                   *FreeExtents;
+
+  EXT4_STATISTICS_PROTOCOL           StatisticsInterface;
+  EXT4_STATISTICS                    Statistics;
 } EXT4_PARTITION;
 
+#define EXT4_PARTITION_FROM_STATISTICS(This)                                   \
+  BASE_CR(This, EXT4_PARTITION, StatisticsInterface)
+
 /**
    This structure represents a directory entry inside our directory entry tree.
    For now, it will be used as a way to track file names inside our opening
@@ -103,9 +160,15 @@ struct _Ext4_Dentry {
   struct _Ext4_Dentry    *Parent;
   LIST_ENTRY             Children;
   LIST_ENTRY             ListNode;
+
+  // Copy of the inode, if the dentry is in the partition's dentry cache.
+  // The cache then also holds a reference to the dentry.
+  EXT4_INODE             *CachedInode;
+  LIST_ENTRY             CacheNode;
 };
 
 #define EXT4_DENTRY_FROM_DENTRY_LIST(Node)  BASE_CR(Node, EXT4_DENTRY, ListNode)
+#define EXT4_DENTRY_FROM_CACHE_NODE(Node)   BASE_CR(Node, EXT4_DENTRY, CacheNode)
 
 /**
    Creates a new dentry object.
@@ -145,6 +208,68 @@ Ext4UnrefDentry (
   IN OUT EXT4_DENTRY  *Dentry
   );
 
+/**
+   Adds a dentry, along with its inode, to the dentry cache.
+   If the cache is full, the least recently used dentry is evicted.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+   @param[in out]  Dentry         Pointer to the dentry.
+   @param[in]      Inode          Pointer to the dentry's inode.
+   @param[in]      InodeNum       Inode number.
+**/
+VOID
+Ext4CacheDentry (
+  IN OUT EXT4_PARTITION  *Partition,
+  IN OUT EXT4_DENTRY     *Dentry,
+  IN CONST EXT4_INODE    *Inode,
+  IN EXT4_INO_NR         InodeNum
+  );
+
+/**
+   Looks up a cached child dentry by name.
+   Names are compared exactly, as they're stored on disk.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+   @param[in]      Parent         Pointer to the parent dentry.
+   @param[in]      Name           Pointer to the UCS-2 formatted filename.
+
+   @return Pointer to the cached dentry, or NULL if it's not cached.
+**/
+EXT4_DENTRY *
+Ext4LookupCachedDentry (
+  IN OUT EXT4_PARTITION  *Partition,
+  IN EXT4_DENTRY         *Parent,
+  IN CONST CHAR16        *Name
+  );
+
+/**
+   Opens a file using a cached dentry, without reading anything from the disk.
+
+   @param[in]      Partition   Pointer to the ext4 partition.
+   @param[in]      OpenMode    Mode in which the file is supposed to be open.
+   @param[out]     OutFile     Pointer to the newly opened file.
+   @param[in]      Dentry      Pointer to the cached dentry.
+
+   @retval EFI_STATUS          Result of the operation
+**/
+EFI_STATUS
+Ext4OpenCachedDentry (
+  IN  EXT4_PARTITION  *Partition,
+  IN  UINT64          OpenMode,
+  OUT EXT4_FILE       **OutFile,
+  IN  EXT4_DENTRY     *Dentry
+  );
+
+/**
+   Empties the dentry cache.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+**/
+VOID
+Ext4FlushDentryCache (
+  IN OUT EXT4_PARTITION  *Partition
+  );
+
 /**
    Opens and parses the superblock.
 
@@ -191,6 +316,71 @@ Ext4OpenSuperblock (
 **/
 #define EXT4_MEDIA_ID(Partition)  Partition->BlockIo->Media->MediaId
 
+// Maximum number of reads an EXT4_IO_BATCH keeps in flight
+#define EXT4_MAX_INFLIGHT_READS  8
+
+/**
+   A batch of disk reads that are kept in flight at the same time, if the
+   partition's disk supports DISK_IO2.
+**/
+typedef struct {
+  EFI_DISK_IO2_TOKEN    Tokens[EXT4_MAX_INFLIGHT_READS];
+  UINTN                 NumberTokens;
+  BOOLEAN               Async;
+  // Status of the first read that failed
+  EFI_STATUS            Status;
+} EXT4_IO_BATCH;
+
+/**
+   Initialises a batch of reads.
+   Reads are only issued asynchronously if the partition's disk supports
+   DISK_IO2 and we're running at TPL_APPLICATION, where we can wait for them.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[out] Batch          Pointer to the batch.
+**/
+VOID
+Ext4InitIoBatch (
+  IN  EXT4_PARTITION  *Partition,
+  OUT EXT4_IO_BATCH   *Batch
+  );
+
+/**
+   Waits for every read of the batch to complete.
+   The batch can be reused afterwards.
+
+   @param[in out] Batch       Pointer to the batch.
+
+   @return The status of the first read that failed, or EFI_SUCCESS.
+**/
+EFI_STATUS
+Ext4WaitIoBatch (
+  IN OUT EXT4_IO_BATCH  *Batch
+  );
+
+/**
+   Reads from the partition's disk as part of a batch of reads.
+   If the disk supports DISK_IO2, the read is only started, and the buffer
+   must not be touched until Ext4WaitIoBatch() is called. Otherwise, this
+   is just a synchronous Ext4ReadDiskIo().
+
+   @param[in]     Partition   Pointer to the opened ext4 partition.
+   @param[in out] Batch       Pointer to the batch.
+   @param[out]    Buffer      Pointer to a destination buffer.
+   @param[in]     Length      Length of the destination buffer.
+   @param[in]     Offset      Offset, in bytes, of the location to read.
+
+   @return Success status of the disk read (or of its submission).
+**/
+EFI_STATUS
+Ext4ReadDiskIoAsync (
+  IN     EXT4_PARTITION  *Partition,
+  IN OUT EXT4_IO_BATCH   *Batch,
+  OUT    VOID            *Buffer,
+  IN     UINTN           Length,
+  IN     UINT64          Offset
+  );
+
 /**
    Reads from the partition's disk using the DISK_IO protocol.
 
@@ -210,7 +400,36 @@ Ext4ReadDiskIo (
   );
 
 /**
-   Reads blocks from the partition's disk using the DISK_IO protocol.
+   Retrieves the partition's statistics.
+
+   @param[in]      This          Pointer to the EXT4_STATISTICS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+EFI_STATUS
+EFIAPI
+Ext4GetStatistics (
+  IN  EXT4_STATISTICS_PROTOCOL  *This,
+  OUT EXT4_STATISTICS           *Statistics
+  );
+
+/**
+   Resets the partition's statistics to zero.
+
+   @param[in]      This          Pointer to the EXT4_STATISTICS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+EFI_STATUS
+EFIAPI
+Ext4ResetStatistics (
+  IN EXT4_STATISTICS_PROTOCOL  *This
+  );
+
+/**
+   Reads blocks from the partition's disk, through the partition's block cache.
 
    @param[in]  Partition      Pointer to the opened ext4 partition.
    @param[out] Buffer         Pointer to a destination buffer.
@@ -245,6 +464,64 @@ Ext4AllocAndReadBlocks (
   IN EXT4_BLOCK_NR   BlockNumber
   );
 
+/**
+   Initialises the partition's block cache.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+
+   @retval EFI_SUCCESS            The cache was initialised (or is disabled).
+   @retval EFI_OUT_OF_RESOURCES   Failed to allocate the hash table.
+**/
+EFI_STATUS
+Ext4InitBlockCache (
+  IN OUT EXT4_PARTITION  *Partition
+  );
+
+/**
+   Frees the partition's block cache, along with every cached block.
+
+   @param[in out]  Partition      Pointer to the ext4 partition.
+**/
+VOID
+Ext4FreeBlockCache (
+  IN OUT EXT4_PARTITION  *Partition
+  );
+
+/**
+   Reads from the partition's disk through the block cache.
+   Blocks that are not cached are read from the disk and cached.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[out] Buffer         Pointer to a destination buffer.
+   @param[in]  Length         Length of the destination buffer.
+   @param[in]  Offset         Offset, in bytes, of the location to read.
+
+   @return Success status of the read.
+**/
+EFI_STATUS
+Ext4ReadCached (
+  IN EXT4_PARTITION  *Partition,
+  OUT VOID           *Buffer,
+  IN UINTN           Length,
+  IN UINT64          Offset
+  );
+
+/**
+   Reads a run of physically contiguous blocks into the block cache with a
+   single disk read. Blocks that are already cached are left untouched.
+   Failures are not fatal, as the blocks will simply be read on demand.
+
+   @param[in]  Partition      Pointer to the opened ext4 partition.
+   @param[in]  BlockNr        First block of the run.
+   @param[in]  NumberBlocks   Number of blocks in the run.
+**/
+VOID
+Ext4PrefetchBlocks (
+  IN EXT4_PARTITION  *Partition,
+  IN EXT4_BLOCK_NR   BlockNr,
+  IN UINT32          NumberBlocks
+  );
+
 /**
    Checks if the opened partition has the 64-bit feature (see
 EXT4_FEATURE_INCOMPAT_64BIT).
@@ -361,6 +638,24 @@ Ext4GetExtent (
   OUT EXT4_EXTENT    *Extent
   );
 
+/**
+   Finds the length of the file hole that starts at a logical block, i.e. the
+   number of blocks until the next extent.
+   @param[in]      Partition     Pointer to the opened EXT4 partition.
+   @param[in]      File          Pointer to the opened file.
+   @param[in]      LogicalBlock  Unmapped block at which the hole starts.
+   @param[out]     HoleLength    Pointer to the length of the hole, in blocks.
+
+   @return Status of the lookup.
+**/
+EFI_STATUS
+Ext4GetHoleLength (
+  IN  EXT4_PARTITION  *Partition,
+  IN  EXT4_FILE       *File,
+  IN  EXT4_BLOCK_NR   LogicalBlock,
+  OUT UINT64          *HoleLength
+  );
+
 struct _Ext4File {
   EFI_FILE_PROTOCOL     Protocol;
   EXT4_INODE            *Inode;
@@ -373,10 +668,27 @@ struct _Ext4File {
 
   ORDERED_COLLECTION    *ExtentsMap;
 
+  // Every extent of the file, sorted, if the whole extent tree was prefetched
+  // at open time. Takes precedence over ExtentsMap.
+  EXT4_EXTENT           *ExtentArray;
+  UINTN                 NumberExtents;
+
   LIST_ENTRY            OpenFilesListNode;
 
   // Owning reference to this file's directory entry.
   EXT4_DENTRY           *Dentry;
+
+  // Read-ahead buffer, holding ReadAheadLength bytes of the disk starting at
+  // ReadAheadStart. Allocated on the first sequential read.
+  UINT8                 *ReadAheadBuffer;
+  UINT64                ReadAheadStart;
+  UINTN                 ReadAheadLength;
+
+  // File offset at which a sequential read would continue.
+  UINT64                NextReadOffset;
+
+  // Directory offset up to which ReadDir() prefetched the entries' inodes.
+  UINT64                InodesPrefetchedUpTo;
 };
 
 #define EXT4_FILE_FROM_OPEN_FILES_NODE(Node)                                   \
@@ -644,6 +956,95 @@ Ext4WriteFile (
   IN VOID               *Buffer
   );
 
+/**
+  Opens a new file relative to the source directory's location, in an
+  asynchronous fashion.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to the source location.
+  @param[out]     NewHandle   A pointer to the location to return the opened handle for the new
+                              file.
+  @param[in]      FileName    The Null-terminated string of the name of the file to be opened.
+  @param[in]      OpenMode    The mode to open the file.
+  @param[in]      Attributes  Only valid for EFI_FILE_MODE_CREATE, in which case these are the
+                              attribute bits for the newly created file.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval Others               See Ext4Open(), for blocking requests.
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4OpenEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  OUT EFI_FILE_PROTOCOL     **NewHandle,
+  IN CHAR16                 *FileName,
+  IN UINT64                 OpenMode,
+  IN UINT64                 Attributes,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  );
+
+/**
+  Reads data from a file, in an asynchronous fashion.
+
+  The disk reads that make up the request are kept in flight at the same time
+  when the disk supports DISK_IO2, but the request itself completes before
+  this function returns.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to read data from.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval Others               See Ext4ReadFile(), for blocking requests.
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4ReadFileEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  );
+
+/**
+  Writes data to a file, in an asynchronous fashion.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to write data to.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval Others               See Ext4WriteFile(), for blocking requests.
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4WriteFileEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  );
+
+/**
+  Flushes all modified data associated with a file to a device, in an
+  asynchronous fashion.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to flush.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval EFI_ACCESS_DENIED    The file was opened read-only (blocking requests).
+  @retval EFI_WRITE_PROTECTED  The file or medium is write-protected (blocking requests).
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4FlushFileEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  );
+
 /**
   Returns a file's current position.
 
@@ -881,6 +1282,27 @@ Ext4StrCmpInsensitive (
   IN CHAR16  *Str2
   );
 
+/**
+   Hashes a filename for a lookup in a hash tree directory.
+
+   @param[in]      Partition     Pointer to the opened ext4 partition.
+   @param[in]      HashVersion   Hash algorithm, one of EXT4_DX_HASH_*.
+   @param[in]      Name          Pointer to the UTF-8 filename.
+   @param[in]      Length        Length of the filename, in bytes.
+   @param[out]     Hash          Pointer to where the hash will be stored.
+
+   @retval EFI_SUCCESS        The name was hashed.
+   @retval EFI_UNSUPPORTED    Unknown hash version.
+**/
+EFI_STATUS
+Ext4DirHash (
+  IN  CONST EXT4_PARTITION  *Partition,
+  IN  UINT8                 HashVersion,
+  IN  CONST CHAR8           *Name,
+  IN  UINTN                 Length,
+  OUT UINT32                *Hash
+  );
+
 /**
    Retrieves the filename of the directory entry and converts it to UTF-16/UCS-2
 
@@ -947,6 +1369,22 @@ Ext4InitExtentsMap (
   IN EXT4_FILE  *File
   );
 
+/**
+   Reads the whole extent tree of a large file into a sorted, flat array of
+   extents, which then serves every extent lookup of the file.
+   Files smaller than PcdExt4ExtentPrefetchMinSize keep filling the extents map lazily.
+
+   Failures are not fatal: the file just falls back to the extents map.
+
+   @param[in]      Partition     Pointer to the opened EXT4 partition.
+   @param[in]      File          Pointer to the open file.
+**/
+VOID
+Ext4PrefetchExtents (
+  IN EXT4_PARTITION  *Partition,
+  IN EXT4_FILE       *File
+  );
+
 /**
    Frees the extents map, deleting every extent stored.
 
@@ -957,6 +1395,72 @@ Ext4FreeExtentsMap (
   IN EXT4_FILE  *File
   );
 
+/**
+   Releases the extents kept in the partition's free list.
+
+   @param[in out]  Partition   Pointer to the ext4 partition.
+**/
+VOID
+Ext4FreeExtentSlots (
+  IN OUT EXT4_PARTITION  *Partition
+  );
+
+/**
+   Initialises the CRC32C tables and selects the best CRC32C implementation
+   for the current CPU.
+**/
+VOID
+Ext4InitCrc32c (
+  VOID
+  );
+
+/**
+   Updates a CRC32C with the contents of a buffer.
+   Like ext4 (and unlike CalculateCrc32c), the CRC is neither inverted on the
+   way in nor on the way out.
+
+   @param[in]      Crc           Current CRC.
+   @param[in]      Buffer        Pointer to the buffer.
+   @param[in]      Length        Length of the buffer, in bytes.
+
+   @return The updated CRC.
+**/
+UINT32
+Ext4Crc32c (
+  IN UINT32      Crc,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  );
+
+/**
+   Checks if the CPU supports the CRC32C instructions used by Ext4Crc32cHw.
+
+   @retval TRUE   Ext4Crc32cHw can be used.
+   @retval FALSE  Ext4Crc32cHw can't be used.
+**/
+BOOLEAN
+EFIAPI
+Ext4Crc32cHwSupported (
+  VOID
+  );
+
+/**
+   Updates a CRC32C with the contents of a buffer, using CRC32C instructions.
+
+   @param[in]      Crc           Current CRC (not inverted).
+   @param[in]      Buffer        Pointer to the buffer.
+   @param[in]      Length        Length of the buffer, in bytes.
+
+   @return The updated CRC.
+**/
+UINT32
+EFIAPI
+Ext4Crc32cHw (
+  IN UINT32      Crc,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  );
+
 /**
    Calculates the checksum of the given buffer.
    @param[in]      Partition     Pointer to the opened EXT4 partition.
@@ -1116,14 +1620,18 @@ Ext4GetVolumeName (
 
 /**
    Checks the superblock's magic value.
+   The whole superblock is read, so that mounting the partition afterwards
+   doesn't need to read it again.
 
-   @param[in] DiskIo      Pointer to the DiskIo.
-   @param[in] BlockIo     Pointer to the BlockIo.
+   @param[in] ControllerHandle  Handle of the device being probed.
+   @param[in] DiskIo            Pointer to the DiskIo.
+   @param[in] BlockIo           Pointer to the BlockIo.
 
    @returns Whether the partition has a valid EXT4 superblock magic value.
 **/
 BOOLEAN
 Ext4SuperblockCheckMagic (
+  IN EFI_HANDLE             ControllerHandle,
   IN EFI_DISK_IO_PROTOCOL   *DiskIo,
   IN EFI_BLOCK_IO_PROTOCOL  *BlockIo
   );
@@ -1138,6 +1646,16 @@ Ext4SuperblockCheckMagic (
 #define EXT4_EXTENT_IS_UNINITIALIZED(Extent)                                   \
   ((Extent)->ee_len > EXT4_EXTENT_MAX_INITIALIZED)
 
+/**
+   Retrieves the first physical block of the extent.
+
+   @param[in] Extent    Pointer to the EXT4_EXTENT
+
+   @returns The extent's first physical block.
+**/
+#define EXT4_EXTENT_PHYSICAL(Extent)                                           \
+  (LShiftU64 ((Extent)->ee_start_hi, 32) | (Extent)->ee_start_lo)
+
 /**
    Retrieves the extent's length, dealing with uninitialized extents in the
 process.
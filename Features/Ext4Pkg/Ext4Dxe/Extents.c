@@ -212,6 +212,223 @@ Ext4ExtentIdxLeafBlock (
   return LShiftU64 (Index->ei_leaf_hi, 32) | Index->ei_leaf_lo;
 }
 
+/**
+   Appends the extents of a leaf to the file's flat extent array.
+
+   @param[in]      File          Pointer to the open file.
+   @param[in]      Header        Pointer to the leaf's EXT4_EXTENT_HEADER.
+   @param[in out]  Capacity      Pointer to the capacity of the array, in extents.
+
+   @retval EFI_SUCCESS            The extents were appended.
+   @retval EFI_OUT_OF_RESOURCES   Failed to grow the array.
+   @retval EFI_VOLUME_CORRUPTED   The extents are not sorted or overlap.
+**/
+STATIC
+EFI_STATUS
+Ext4AppendExtents (
+  IN     EXT4_FILE                 *File,
+  IN     CONST EXT4_EXTENT_HEADER  *Header,
+  IN OUT UINTN                     *Capacity
+  )
+{
+  CONST EXT4_EXTENT  *Ext;
+  EXT4_EXTENT        *Last;
+  EXT4_EXTENT        *NewArray;
+  UINTN              NewCapacity;
+  UINT16             Idx;
+
+  Ext = (CONST EXT4_EXTENT *)(Header + 1);
+
+  for (Idx = 0; Idx < Header->eh_entries; Idx++, Ext++) {
+    if (File->NumberExtents != 0) {
+      Last = &File->ExtentArray[File->NumberExtents - 1];
+
+      // Lookups binary search the array, so it needs to be sorted and free of overlaps
+      if (Ext->ee_block < Last->ee_block + Ext4GetExtentLength (Last)) {
+        return EFI_VOLUME_CORRUPTED;
+      }
+    }
+
+    if (File->NumberExtents == *Capacity) {
+      NewCapacity = MAX (*Capacity * 2, 16);
+      NewArray    = ReallocatePool (
+                      *Capacity * sizeof (EXT4_EXTENT),
+                      NewCapacity * sizeof (EXT4_EXTENT),
+                      File->ExtentArray
+                      );
+
+      if (NewArray == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      File->ExtentArray = NewArray;
+      *Capacity         = NewCapacity;
+    }
+
+    File->ExtentArray[File->NumberExtents++] = *Ext;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Walks an extent tree node, appending every extent under it to the file's
+   flat extent array.
+
+   @param[in]      Partition     Pointer to the opened EXT4 partition.
+   @param[in]      File          Pointer to the open file.
+   @param[in]      Header        Pointer to the node's (validated) EXT4_EXTENT_HEADER.
+   @param[in out]  Capacity      Pointer to the capacity of the array, in extents.
+
+   @return Result of the operation.
+**/
+STATIC
+EFI_STATUS
+Ext4PrefetchExtentNode (
+  IN     EXT4_PARTITION      *Partition,
+  IN     EXT4_FILE           *File,
+  IN     EXT4_EXTENT_HEADER  *Header,
+  IN OUT UINTN               *Capacity
+  )
+{
+  EXT4_EXTENT_INDEX   *Index;
+  EXT4_EXTENT_HEADER  *Child;
+  EFI_STATUS          Status;
+  UINT16              Idx;
+
+  if (Header->eh_depth == 0) {
+    return Ext4AppendExtents (File, Header, Capacity);
+  }
+
+  Child = AllocatePool (Partition->BlockSize);
+
+  if (Child == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Index  = (EXT4_EXTENT_INDEX *)(Header + 1);
+  Status = EFI_SUCCESS;
+
+  for (Idx = 0; Idx < Header->eh_entries; Idx++, Index++) {
+    Status = Ext4ReadBlocks (Partition, Child, 1, Ext4ExtentIdxLeafBlock (Index));
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    if (  !Ext4ExtentHeaderValid (Child) || !Ext4CheckExtentChecksum (Child, File)
+       || (Child->eh_depth != Header->eh_depth - 1))
+    {
+      Status = EFI_VOLUME_CORRUPTED;
+      break;
+    }
+
+    Status = Ext4PrefetchExtentNode (Partition, File, Child, Capacity);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  FreePool (Child);
+  return Status;
+}
+
+/**
+   Reads the whole extent tree of a large file into a sorted, flat array of
+   extents, which then serves every extent lookup of the file.
+   Files smaller than PcdExt4ExtentPrefetchMinSize keep filling the extents map lazily.
+
+   Failures are not fatal: the file just falls back to the extents map.
+
+   @param[in]      Partition     Pointer to the opened EXT4 partition.
+   @param[in]      File          Pointer to the open file.
+**/
+VOID
+Ext4PrefetchExtents (
+  IN EXT4_PARTITION  *Partition,
+  IN EXT4_FILE       *File
+  )
+{
+  EXT4_EXTENT_HEADER  *Header;
+  EFI_STATUS          Status;
+  UINTN               Capacity;
+  UINT32              MinSize;
+
+  MinSize = PcdGet32 (PcdExt4ExtentPrefetchMinSize);
+
+  if (  (MinSize == 0) || (File->ExtentArray != NULL)
+     || ((File->Inode->i_flags & EXT4_EXTENTS_FL) == 0)
+     || (EXT4_INODE_SIZE (File->Inode) < MinSize))
+  {
+    return;
+  }
+
+  Header = Ext4GetInoExtentHeader (File->Inode);
+
+  if (!Ext4ExtentHeaderValid (Header)) {
+    return;
+  }
+
+  Capacity            = 0;
+  File->NumberExtents = 0;
+
+  Status = Ext4PrefetchExtentNode (Partition, File, Header, &Capacity);
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "[ext4] Failed to prefetch the extents of inode %lu - %r\n", File->InodeNum, Status));
+
+    if (File->ExtentArray != NULL) {
+      FreePool (File->ExtentArray);
+    }
+
+    File->ExtentArray   = NULL;
+    File->NumberExtents = 0;
+    return;
+  }
+
+  // An empty file still needs a (non-NULL) array, so that lookups know the tree was read
+  if (File->ExtentArray == NULL) {
+    File->ExtentArray = AllocatePool (sizeof (EXT4_EXTENT));
+  }
+}
+
+/**
+   Finds the position of a logical block in the file's flat extent array.
+
+   @param[in]      File          Pointer to the open file, with a flat extent array.
+   @param[in]      Block         Logical block.
+
+   @return The number of extents that start at or before Block; the extent
+           that may cover Block (if any) is the one before that.
+**/
+STATIC
+UINTN
+Ext4BinsearchExtentArray (
+  IN CONST EXT4_FILE  *File,
+  IN EXT4_BLOCK_NR    Block
+  )
+{
+  UINTN  Low;
+  UINTN  High;
+  UINTN  Middle;
+
+  Low  = 0;
+  High = File->NumberExtents;
+
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+
+    if (File->ExtentArray[Middle].ee_block <= Block) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  return Low;
+}
+
 /**
    Retrieves an extent from an EXT4 inode.
    @param[in]      Partition     Pointer to the opened EXT4 partition.
@@ -237,6 +454,7 @@ Ext4GetExtent (
   EXT4_EXTENT_HEADER  *ExtHeader;
   EXT4_EXTENT_INDEX   *Index;
   EFI_STATUS          Status;
+  UINTN               Position;
 
   Inode  = File->Inode;
   Ext    = NULL;
@@ -249,6 +467,22 @@ Ext4GetExtent (
     return EFI_NO_MAPPING;
   }
 
+  // If the whole tree was prefetched, the array is authoritative
+  if (File->ExtentArray != NULL) {
+    Position = Ext4BinsearchExtentArray (File, LogicalBlock);
+
+    if (Position != 0) {
+      Ext = &File->ExtentArray[Position - 1];
+
+      if (LogicalBlock - Ext->ee_block < Ext4GetExtentLength (Ext)) {
+        *Extent = *Ext;
+        return EFI_SUCCESS;
+      }
+    }
+
+    return EFI_NO_MAPPING;
+  }
+
   // Note: Right now, holes are the single biggest reason for cache misses
   // We should find a way to get (or cache) holes
   if ((Ext = Ext4GetExtentFromMap (File, (UINT32)LogicalBlock)) != NULL) {
@@ -359,6 +593,126 @@ Ext4GetExtent (
   return EFI_SUCCESS;
 }
 
+/**
+   Finds the length of the file hole that starts at a logical block, i.e. the
+   number of blocks until the next extent.
+   @param[in]      Partition     Pointer to the opened EXT4 partition.
+   @param[in]      File          Pointer to the opened file.
+   @param[in]      LogicalBlock  Unmapped block at which the hole starts.
+   @param[out]     HoleLength    Pointer to the length of the hole, in blocks.
+
+   @return Status of the lookup.
+**/
+EFI_STATUS
+Ext4GetHoleLength (
+  IN  EXT4_PARTITION  *Partition,
+  IN  EXT4_FILE       *File,
+  IN  EXT4_BLOCK_NR   LogicalBlock,
+  OUT UINT64          *HoleLength
+  )
+{
+  VOID                *Buffer;
+  EXT4_EXTENT         *Ext;
+  UINT32              CurrentDepth;
+  EXT4_EXTENT_HEADER  *ExtHeader;
+  EXT4_EXTENT_INDEX   *Index;
+  EFI_STATUS          Status;
+  UINT64              NextBlock;
+  UINTN               Position;
+
+  *HoleLength = 1;
+
+  // Block maps describe their holes as uninitialized extents (see Ext4GetExtentInBlockMap),
+  // and blocks past UINT32_MAX can't ever be mapped.
+  if (((File->Inode->i_flags & EXT4_EXTENTS_FL) == 0) || (LogicalBlock > MAX_UINT32)) {
+    return EFI_SUCCESS;
+  }
+
+  Buffer    = NULL;
+  NextBlock = (UINT64)MAX_UINT32 + 1;
+
+  if (File->ExtentArray != NULL) {
+    Position = Ext4BinsearchExtentArray (File, LogicalBlock);
+
+    if (Position < File->NumberExtents) {
+      NextBlock = File->ExtentArray[Position].ee_block;
+    }
+
+    *HoleLength = NextBlock - LogicalBlock;
+    return EFI_SUCCESS;
+  }
+  ExtHeader = Ext4GetInoExtentHeader (File->Inode);
+
+  if (!Ext4ExtentHeaderValid (ExtHeader)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  CurrentDepth = ExtHeader->eh_depth;
+
+  // Walk down the tree just like Ext4GetExtent does, but keep track of the first
+  // block covered by the subtrees to the right of our path. The hole ends there,
+  // or at the next extent in the leaf, whichever comes first.
+  while (ExtHeader->eh_depth != 0) {
+    CurrentDepth--;
+
+    if (ExtHeader->eh_entries == 0) {
+      Status = EFI_VOLUME_CORRUPTED;
+      goto Out;
+    }
+
+    Index = Ext4BinsearchExtentIndex (ExtHeader, LogicalBlock);
+
+    if (Index + 1 < (EXT4_EXTENT_INDEX *)(ExtHeader + 1) + ExtHeader->eh_entries) {
+      NextBlock = MIN (NextBlock, Index[1].ei_block);
+    }
+
+    if (Buffer == NULL) {
+      Buffer = AllocatePool (Partition->BlockSize);
+      if (Buffer == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+    }
+
+    Status = Ext4ReadBlocks (Partition, Buffer, 1, Ext4ExtentIdxLeafBlock (Index));
+    if (EFI_ERROR (Status)) {
+      goto Out;
+    }
+
+    ExtHeader = Buffer;
+
+    if (  !Ext4ExtentHeaderValid (ExtHeader) || !Ext4CheckExtentChecksum (ExtHeader, File)
+       || (ExtHeader->eh_depth != CurrentDepth))
+    {
+      Status = EFI_VOLUME_CORRUPTED;
+      goto Out;
+    }
+  }
+
+  Ext = Ext4BinsearchExtentExt (ExtHeader, LogicalBlock);
+
+  if (Ext != NULL) {
+    if (LogicalBlock < Ext->ee_block) {
+      NextBlock = MIN (NextBlock, Ext->ee_block);
+    } else if (Ext + 1 < (EXT4_EXTENT *)(ExtHeader + 1) + ExtHeader->eh_entries) {
+      NextBlock = MIN (NextBlock, Ext[1].ee_block);
+    }
+  }
+
+  // A corrupted tree might make the "hole" end before it starts; play it safe.
+  if (NextBlock > LogicalBlock) {
+    *HoleLength = NextBlock - LogicalBlock;
+  }
+
+  Status = EFI_SUCCESS;
+
+Out:
+  if (Buffer != NULL) {
+    FreePool (Buffer);
+  }
+
+  return Status;
+}
+
 /**
   Compare two EXT4_EXTENT structs.
   Used in the extent map's ORDERED_COLLECTION.
@@ -450,6 +804,69 @@ Ext4InitExtentsMap (
   return EFI_SUCCESS;
 }
 
+/**
+   Gets memory for a cached extent, preferably from the partition's free list.
+
+   @param[in out]  Partition   Pointer to the ext4 partition.
+
+   @return Pointer to the extent, or NULL if we ran out of memory.
+**/
+STATIC
+EXT4_EXTENT *
+Ext4AllocateExtentSlot (
+  IN OUT EXT4_PARTITION  *Partition
+  )
+{
+  EXT4_EXTENT_SLOT  *Slot;
+
+  Slot = Partition->FreeExtents;
+
+  if (Slot == NULL) {
+    return AllocatePool (sizeof (EXT4_EXTENT_SLOT));
+  }
+
+  Partition->FreeExtents = Slot->Next;
+  return &Slot->Extent;
+}
+
+/**
+   Puts a cached extent back on the partition's free list.
+
+   @param[in out]  Partition   Pointer to the ext4 partition.
+   @param[in]      Extent      Pointer to the extent.
+**/
+STATIC
+VOID
+Ext4FreeExtentSlot (
+  IN OUT EXT4_PARTITION  *Partition,
+  IN EXT4_EXTENT         *Extent
+  )
+{
+  EXT4_EXTENT_SLOT  *Slot;
+
+  Slot                   = (EXT4_EXTENT_SLOT *)Extent;
+  Slot->Next             = Partition->FreeExtents;
+  Partition->FreeExtents = Slot;
+}
+
+/**
+   Releases the extents kept in the partition's free list.
+
+   @param[in out]  Partition   Pointer to the ext4 partition.
+**/
+VOID
+Ext4FreeExtentSlots (
+  IN OUT EXT4_PARTITION  *Partition
+  )
+{
+  EXT4_EXTENT_SLOT  *Slot;
+
+  while ((Slot = Partition->FreeExtents) != NULL) {
+    Partition->FreeExtents = Slot->Next;
+    FreePool (Slot);
+  }
+}
+
 /**
    Frees the extents map, deleting every extent stored.
 
@@ -470,13 +887,19 @@ Ext4FreeExtentsMap (
 
   while ((MinEntry = OrderedCollectionMin (File->ExtentsMap)) != NULL) {
     OrderedCollectionDelete (File->ExtentsMap, MinEntry, (VOID **)&Ext);
-    FreePool (Ext);
+    Ext4FreeExtentSlot (File->Partition, Ext);
   }
 
   ASSERT (OrderedCollectionIsEmpty (File->ExtentsMap));
 
   OrderedCollectionUninit (File->ExtentsMap);
   File->ExtentsMap = NULL;
+
+  if (File->ExtentArray != NULL) {
+    FreePool (File->ExtentArray);
+    File->ExtentArray   = NULL;
+    File->NumberExtents = 0;
+  }
 }
 
 /**
@@ -502,7 +925,7 @@ Ext4CacheExtents (
    */
 
   for (Idx = 0; Idx < NumberExtents; Idx++, Extents++) {
-    Extent = AllocatePool (sizeof (EXT4_EXTENT));
+    Extent = Ext4AllocateExtentSlot (File->Partition);
 
     if (Extent == NULL) {
       return;
@@ -513,7 +936,7 @@ Ext4CacheExtents (
 
     // EFI_ALREADY_STARTED = already exists in the tree.
     if (EFI_ERROR (Status)) {
-      FreePool (Extent);
+      Ext4FreeExtentSlot (File->Partition, Extent);
 
       if (Status == EFI_ALREADY_STARTED) {
         continue;
@@ -318,6 +318,11 @@ Ext4CloseInternal (
   FreePool (File->Inode);
   Ext4FreeExtentsMap (File);
   Ext4UnrefDentry (File->Dentry);
+
+  if (File->ReadAheadBuffer != NULL) {
+    FreePool (File->ReadAheadBuffer);
+  }
+
   FreePool (File);
   return EFI_SUCCESS;
 }
@@ -435,6 +440,149 @@ Ext4WriteFile (
   return EFI_WRITE_PROTECTED;
 }
 
+/**
+  Completes an asynchronous file request.
+  Ext4Dxe always completes requests before returning, so this only reports
+  the status through the token and signals its event.
+
+  @param[in out]  Token       A pointer to the token associated with the request.
+  @param[in]      Status      The status of the request.
+
+  @return The value the *Ex() function should return.
+**/
+STATIC
+EFI_STATUS
+Ext4CompleteIoToken (
+  IN OUT EFI_FILE_IO_TOKEN  *Token,
+  IN     EFI_STATUS         Status
+  )
+{
+  // A NULL event means the caller asked for a blocking request
+  if (Token->Event == NULL) {
+    return Status;
+  }
+
+  Token->Status = Status;
+  gBS->SignalEvent (Token->Event);
+  return EFI_SUCCESS;
+}
+
+/**
+  Opens a new file relative to the source directory's location, in an
+  asynchronous fashion.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to the source location.
+  @param[out]     NewHandle   A pointer to the location to return the opened handle for the new
+                              file.
+  @param[in]      FileName    The Null-terminated string of the name of the file to be opened.
+  @param[in]      OpenMode    The mode to open the file.
+  @param[in]      Attributes  Only valid for EFI_FILE_MODE_CREATE, in which case these are the
+                              attribute bits for the newly created file.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval Others               See Ext4Open(), for blocking requests.
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4OpenEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  OUT EFI_FILE_PROTOCOL     **NewHandle,
+  IN CHAR16                 *FileName,
+  IN UINT64                 OpenMode,
+  IN UINT64                 Attributes,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = Ext4Open (This, NewHandle, FileName, OpenMode, Attributes);
+
+  if (Token == NULL) {
+    return Status;
+  }
+
+  return Ext4CompleteIoToken (Token, Status);
+}
+
+/**
+  Reads data from a file, in an asynchronous fashion.
+
+  The disk reads that make up the request are kept in flight at the same time
+  when the disk supports DISK_IO2, but the request itself completes before
+  this function returns.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to read data from.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval Others               See Ext4ReadFile(), for blocking requests.
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4ReadFileEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  )
+{
+  return Ext4CompleteIoToken (Token, Ext4ReadFile (This, &Token->BufferSize, Token->Buffer));
+}
+
+/**
+  Writes data to a file, in an asynchronous fashion.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to write data to.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval Others               See Ext4WriteFile(), for blocking requests.
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4WriteFileEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  )
+{
+  return Ext4CompleteIoToken (Token, Ext4WriteFile (This, &Token->BufferSize, Token->Buffer));
+}
+
+/**
+  Flushes all modified data associated with a file to a device, in an
+  asynchronous fashion.
+
+  @param[in]      This        A pointer to the EFI_FILE_PROTOCOL instance that is the file
+                              handle to flush.
+  @param[in out]  Token       A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS          The request was completed; its status is in Token->Status.
+  @retval EFI_ACCESS_DENIED    The file was opened read-only (blocking requests).
+  @retval EFI_WRITE_PROTECTED  The file or medium is write-protected (blocking requests).
+
+**/
+EFI_STATUS
+EFIAPI
+Ext4FlushFileEx (
+  IN EFI_FILE_PROTOCOL      *This,
+  IN OUT EFI_FILE_IO_TOKEN  *Token
+  )
+{
+  EXT4_FILE  *File;
+
+  File = (EXT4_FILE *)This;
+
+  return Ext4CompleteIoToken (
+           Token,
+           (File->OpenMode & EFI_FILE_MODE_WRITE) ? EFI_WRITE_PROTECTED : EFI_ACCESS_DENIED
+           );
+}
+
 /**
   Returns a file's current position.
 
@@ -503,6 +651,10 @@ Ext4SetPosition (
 
   File->Position = Position;
 
+  if (Ext4FileIsDir (File)) {
+    File->InodesPrefetchedUpTo = 0;
+  }
+
   return EFI_SUCCESS;
 }
 
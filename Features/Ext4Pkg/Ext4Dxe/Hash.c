@@ -0,0 +1,314 @@
+/** @file
+  Directory hash functions, used by hash tree (dir_index) directories
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+  The algorithms here need to match the ones in Linux's fs/ext4/hash.c exactly,
+  since the hashes are stored on disk.
+**/
+
+#include "Ext4Dxe.h"
+
+// Default seed, used if the superblock's s_hash_seed is all zeroes
+STATIC CONST UINT32  gExt4DefaultHashSeed[4] = {
+  0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476
+};
+
+#define EXT4_HASH_HALF_MD4_F(x, y, z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define EXT4_HASH_HALF_MD4_G(x, y, z)  (((x) & (y)) + (((x) ^ (y)) & (z)))
+#define EXT4_HASH_HALF_MD4_H(x, y, z)  ((x) ^ (y) ^ (z))
+
+#define EXT4_HASH_HALF_MD4_K2  013240474631UL
+#define EXT4_HASH_HALF_MD4_K3  015666365641UL
+
+#define EXT4_HASH_ROUND(f, a, b, c, d, x, s)                                   \
+  (a = LRotU32 ((a) + f ((b), (c), (d)) + (x), (s)))
+
+#define EXT4_HASH_TEA_DELTA  0x9E3779B9
+
+/**
+   Fetches a character of a filename, as a signed or unsigned char.
+
+   @param[in]      Name          Pointer to the character.
+   @param[in]      Unsigned      TRUE if chars are treated as unsigned.
+
+   @return The character, sign-extended if !Unsigned.
+**/
+STATIC
+INT32
+Ext4HashChar (
+  IN CONST CHAR8  *Name,
+  IN BOOLEAN      Unsigned
+  )
+{
+  return Unsigned ? (INT32)(UINT8)*Name : (INT32)(INT8)*Name;
+}
+
+/**
+   The legacy ext3 directory hash.
+
+   @param[in]      Name          Pointer to the filename.
+   @param[in]      Length        Length of the filename, in bytes.
+   @param[in]      Unsigned      TRUE if chars are treated as unsigned.
+
+   @return The hash of the filename.
+**/
+STATIC
+UINT32
+Ext4DxHackHash (
+  IN CONST CHAR8  *Name,
+  IN UINTN        Length,
+  IN BOOLEAN      Unsigned
+  )
+{
+  UINT32  Hash;
+  UINT32  Hash0;
+  UINT32  Hash1;
+
+  Hash0 = 0x12a3fe2d;
+  Hash1 = 0x37abe8f9;
+
+  while (Length-- != 0) {
+    Hash = Hash1 + (Hash0 ^ (UINT32)(Ext4HashChar (Name++, Unsigned) * 7152373));
+
+    if ((Hash & BIT31) != 0) {
+      Hash -= 0x7fffffff;
+    }
+
+    Hash1 = Hash0;
+    Hash0 = Hash;
+  }
+
+  return Hash0 << 1;
+}
+
+/**
+   Packs a filename into an array of UINT32s, padding it with its length.
+
+   @param[in]      Name          Pointer to the filename.
+   @param[in]      Length        Remaining length of the filename, in bytes.
+   @param[out]     Buf           Pointer to the destination array.
+   @param[in]      Num           Number of UINT32s in Buf.
+   @param[in]      Unsigned      TRUE if chars are treated as unsigned.
+**/
+STATIC
+VOID
+Ext4Str2HashBuf (
+  IN CONST CHAR8  *Name,
+  IN INTN         Length,
+  OUT UINT32      *Buf,
+  IN INTN         Num,
+  IN BOOLEAN      Unsigned
+  )
+{
+  UINT32  Pad;
+  UINT32  Val;
+  INTN    Index;
+
+  Pad  = (UINT32)Length | ((UINT32)Length << 8);
+  Pad |= Pad << 16;
+
+  Val = Pad;
+
+  if (Length > Num * 4) {
+    Length = Num * 4;
+  }
+
+  for (Index = 0; Index < Length; Index++) {
+    Val = (UINT32)Ext4HashChar (Name++, Unsigned) + (Val << 8);
+
+    if ((Index % 4) == 3) {
+      *Buf++ = Val;
+      Val    = Pad;
+      Num--;
+    }
+  }
+
+  if (--Num >= 0) {
+    *Buf++ = Val;
+  }
+
+  while (--Num >= 0) {
+    *Buf++ = Pad;
+  }
+}
+
+/**
+   The MD4 transform, reduced to 3 rounds of 8 steps each.
+
+   @param[in out]  Buf           Hash state, 4 UINT32s.
+   @param[in]      In            Input data, 8 UINT32s.
+**/
+STATIC
+VOID
+Ext4HalfMd4Transform (
+  IN OUT UINT32    Buf[4],
+  IN CONST UINT32  In[8]
+  )
+{
+  UINT32  a;
+  UINT32  b;
+  UINT32  c;
+  UINT32  d;
+
+  a = Buf[0];
+  b = Buf[1];
+  c = Buf[2];
+  d = Buf[3];
+
+  // Round 1
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, a, b, c, d, In[0], 3);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, d, a, b, c, In[1], 7);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, c, d, a, b, In[2], 11);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, b, c, d, a, In[3], 19);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, a, b, c, d, In[4], 3);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, d, a, b, c, In[5], 7);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, c, d, a, b, In[6], 11);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_F, b, c, d, a, In[7], 19);
+
+  // Round 2
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, a, b, c, d, In[1] + EXT4_HASH_HALF_MD4_K2, 3);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, d, a, b, c, In[3] + EXT4_HASH_HALF_MD4_K2, 5);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, c, d, a, b, In[5] + EXT4_HASH_HALF_MD4_K2, 9);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, b, c, d, a, In[7] + EXT4_HASH_HALF_MD4_K2, 13);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, a, b, c, d, In[0] + EXT4_HASH_HALF_MD4_K2, 3);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, d, a, b, c, In[2] + EXT4_HASH_HALF_MD4_K2, 5);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, c, d, a, b, In[4] + EXT4_HASH_HALF_MD4_K2, 9);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_G, b, c, d, a, In[6] + EXT4_HASH_HALF_MD4_K2, 13);
+
+  // Round 3
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, a, b, c, d, In[3] + EXT4_HASH_HALF_MD4_K3, 3);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, d, a, b, c, In[7] + EXT4_HASH_HALF_MD4_K3, 9);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, c, d, a, b, In[2] + EXT4_HASH_HALF_MD4_K3, 11);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, b, c, d, a, In[6] + EXT4_HASH_HALF_MD4_K3, 15);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, a, b, c, d, In[1] + EXT4_HASH_HALF_MD4_K3, 3);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, d, a, b, c, In[5] + EXT4_HASH_HALF_MD4_K3, 9);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, c, d, a, b, In[0] + EXT4_HASH_HALF_MD4_K3, 11);
+  EXT4_HASH_ROUND (EXT4_HASH_HALF_MD4_H, b, c, d, a, In[4] + EXT4_HASH_HALF_MD4_K3, 15);
+
+  Buf[0] += a;
+  Buf[1] += b;
+  Buf[2] += c;
+  Buf[3] += d;
+}
+
+/**
+   The TEA block cipher's transform, used as a hash.
+
+   @param[in out]  Buf           Hash state, 4 UINT32s (only the first 2 are updated).
+   @param[in]      In            Input data, 4 UINT32s.
+**/
+STATIC
+VOID
+Ext4TeaTransform (
+  IN OUT UINT32    Buf[4],
+  IN CONST UINT32  In[4]
+  )
+{
+  UINT32  Sum;
+  UINT32  b0;
+  UINT32  b1;
+  UINTN   Round;
+
+  Sum = 0;
+  b0  = Buf[0];
+  b1  = Buf[1];
+
+  for (Round = 0; Round < 16; Round++) {
+    Sum += EXT4_HASH_TEA_DELTA;
+    b0  += ((b1 << 4) + In[0]) ^ (b1 + Sum) ^ ((b1 >> 5) + In[1]);
+    b1  += ((b0 << 4) + In[2]) ^ (b0 + Sum) ^ ((b0 >> 5) + In[3]);
+  }
+
+  Buf[0] += b0;
+  Buf[1] += b1;
+}
+
+/**
+   Hashes a filename for a lookup in a hash tree directory.
+
+   @param[in]      Partition     Pointer to the opened ext4 partition.
+   @param[in]      HashVersion   Hash algorithm, one of EXT4_DX_HASH_*.
+   @param[in]      Name          Pointer to the UTF-8 filename.
+   @param[in]      Length        Length of the filename, in bytes.
+   @param[out]     Hash          Pointer to where the hash will be stored.
+
+   @retval EFI_SUCCESS        The name was hashed.
+   @retval EFI_UNSUPPORTED    Unknown hash version.
+**/
+EFI_STATUS
+Ext4DirHash (
+  IN  CONST EXT4_PARTITION  *Partition,
+  IN  UINT8                 HashVersion,
+  IN  CONST CHAR8           *Name,
+  IN  UINTN                 Length,
+  OUT UINT32                *Hash
+  )
+{
+  UINT32       Buf[4];
+  UINT32       In[8];
+  CONST CHAR8  *Ptr;
+  INTN         Remaining;
+  BOOLEAN      Unsigned;
+  UINTN        Index;
+
+  if (  (HashVersion <= EXT4_DX_HASH_TEA)
+     && ((Partition->SuperBlock.s_flags & EXT4_FLAGS_UNSIGNED_HASH) != 0))
+  {
+    HashVersion += EXT4_DX_HASH_LEGACY_UNSIGNED;
+  }
+
+  CopyMem (Buf, gExt4DefaultHashSeed, sizeof (Buf));
+
+  for (Index = 0; Index < ARRAY_SIZE (Buf); Index++) {
+    if (Partition->SuperBlock.s_hash_seed[Index] != 0) {
+      CopyMem (Buf, Partition->SuperBlock.s_hash_seed, sizeof (Buf));
+      break;
+    }
+  }
+
+  Unsigned  = HashVersion >= EXT4_DX_HASH_LEGACY_UNSIGNED;
+  Ptr       = Name;
+  Remaining = (INTN)Length;
+
+  switch (HashVersion) {
+    case EXT4_DX_HASH_LEGACY:
+    case EXT4_DX_HASH_LEGACY_UNSIGNED:
+      *Hash = Ext4DxHackHash (Name, Length, Unsigned);
+      break;
+    case EXT4_DX_HASH_HALF_MD4:
+    case EXT4_DX_HASH_HALF_MD4_UNSIGNED:
+      while (Remaining > 0) {
+        Ext4Str2HashBuf (Ptr, Remaining, In, 8, Unsigned);
+        Ext4HalfMd4Transform (Buf, In);
+        Remaining -= 32;
+        Ptr       += 32;
+      }
+
+      *Hash = Buf[1];
+      break;
+    case EXT4_DX_HASH_TEA:
+    case EXT4_DX_HASH_TEA_UNSIGNED:
+      while (Remaining > 0) {
+        Ext4Str2HashBuf (Ptr, Remaining, In, 4, Unsigned);
+        Ext4TeaTransform (Buf, In);
+        Remaining -= 16;
+        Ptr       += 16;
+      }
+
+      *Hash = Buf[0];
+      break;
+    default:
+      return EFI_UNSUPPORTED;
+  }
+
+  // The lowest bit is reserved, and the largest hash means end-of-directory
+  *Hash &= ~1U;
+
+  if (*Hash == (0x7fffffffU << 1)) {
+    *Hash = (0x7fffffffU - 1) << 1;
+  }
+
+  return EFI_SUCCESS;
+}
@@ -69,6 +69,136 @@ Ext4CalculateInodeChecksum (
   return Crc;
 }
 
+/**
+   Finds how many bytes of a file are stored contiguously on disk, starting
+   at an offset inside an extent. Extents that directly follow each other,
+   both logically and physically, are merged.
+
+   @param[in]      Partition     Pointer to the opened EXT4 partition.
+   @param[in]      File          Pointer to the opened file.
+   @param[in]      Extent        Pointer to the (initialized) extent.
+   @param[in]      ExtentOffset  Offset inside the extent, in bytes.
+   @param[in]      Wanted        Number of bytes after which to stop looking.
+   @param[out]     RunLength     Pointer to the number of contiguous bytes.
+
+   @return Status of the extent lookups.
+**/
+STATIC
+EFI_STATUS
+Ext4GetContiguousRun (
+  IN  EXT4_PARTITION     *Partition,
+  IN  EXT4_FILE          *File,
+  IN  CONST EXT4_EXTENT  *Extent,
+  IN  UINT64             ExtentOffset,
+  IN  UINT64             Wanted,
+  OUT UINT64             *RunLength
+  )
+{
+  EFI_STATUS   Status;
+  EXT4_EXTENT  Current;
+  EXT4_EXTENT  Next;
+
+  Current    = *Extent;
+  *RunLength = MultU64x32 (Current.ee_len, Partition->BlockSize) - ExtentOffset;
+
+  while (*RunLength < Wanted) {
+    Status = Ext4GetExtent (Partition, File, Current.ee_block + Current.ee_len, &Next);
+
+    if (Status == EFI_NO_MAPPING) {
+      break;
+    }
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (  EXT4_EXTENT_IS_UNINITIALIZED (&Next)
+       || (Next.ee_block != Current.ee_block + Current.ee_len)
+       || (EXT4_EXTENT_PHYSICAL (&Next) != EXT4_EXTENT_PHYSICAL (&Current) + Current.ee_len))
+    {
+      break;
+    }
+
+    *RunLength += MultU64x32 (Next.ee_len, Partition->BlockSize);
+    Current     = Next;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Reads file data from the disk, through the file's read-ahead buffer.
+
+   On sequential access, small reads fill the read-ahead buffer with the
+   following, physically contiguous data of the file, so that the reads that
+   follow are served from memory.
+
+   @param[in]      Partition     Pointer to the opened EXT4 partition.
+   @param[in]      File          Pointer to the opened file.
+   @param[out]     Buffer        Pointer to the buffer.
+   @param[in]      Length        Number of bytes to read.
+   @param[in]      DiskOffset    Offset on the disk, in bytes.
+   @param[in]      RunLength     Number of bytes stored contiguously from
+                                 DiskOffset onwards, at least Length.
+   @param[in]      Sequential    TRUE if the read continues the previous one.
+   @param[in out]  Batch         Batch that reads straight into Buffer may be queued on.
+
+   @return Status of the read operation.
+**/
+STATIC
+EFI_STATUS
+Ext4ReadFileData (
+  IN     EXT4_PARTITION  *Partition,
+  IN     EXT4_FILE       *File,
+  OUT    VOID            *Buffer,
+  IN     UINTN           Length,
+  IN     UINT64          DiskOffset,
+  IN     UINT64          RunLength,
+  IN     BOOLEAN         Sequential,
+  IN OUT EXT4_IO_BATCH   *Batch
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      Window;
+  UINTN       ToRead;
+
+  if (  (File->ReadAheadBuffer != NULL) && (DiskOffset >= File->ReadAheadStart)
+     && (DiskOffset + Length <= File->ReadAheadStart + File->ReadAheadLength))
+  {
+    CopyMem (Buffer, File->ReadAheadBuffer + (DiskOffset - File->ReadAheadStart), Length);
+    return EFI_SUCCESS;
+  }
+
+  Window = PcdGet32 (PcdExt4ReadAheadSize);
+
+  if (!Sequential || (Length >= Window)) {
+    return Ext4ReadDiskIoAsync (Partition, Batch, Buffer, Length, DiskOffset);
+  }
+
+  if (File->ReadAheadBuffer == NULL) {
+    File->ReadAheadBuffer = AllocatePool (Window);
+
+    if (File->ReadAheadBuffer == NULL) {
+      return Ext4ReadDiskIo (Partition, Buffer, Length, DiskOffset);
+    }
+  }
+
+  ToRead = (UINTN)MIN (RunLength, Window);
+
+  Status = Ext4ReadDiskIo (Partition, File->ReadAheadBuffer, ToRead, DiskOffset);
+
+  if (EFI_ERROR (Status)) {
+    File->ReadAheadLength = 0;
+    return Status;
+  }
+
+  File->ReadAheadStart  = DiskOffset;
+  File->ReadAheadLength = ToRead;
+
+  CopyMem (Buffer, File->ReadAheadBuffer, Length);
+  return EFI_SUCCESS;
+}
+
 /**
    Reads from an EXT4 inode.
    @param[in]      Partition     Pointer to the opened EXT4 partition.
@@ -89,25 +219,28 @@ Ext4Read (
   IN OUT UINTN           *Length
   )
 {
-  EXT4_INODE   *Inode;
-  UINT64       InodeSize;
-  UINT64       CurrentSeek;
-  UINTN        RemainingRead;
-  UINTN        BeenRead;
-  UINTN        WasRead;
-  EXT4_EXTENT  Extent;
-  UINT32       BlockOff;
-  EFI_STATUS   Status;
-  BOOLEAN      HasBackingExtent;
-  UINT32       HoleOff;
-  UINT64       HoleLen;
-  UINT64       ExtentStartBytes;
-  UINT64       ExtentLengthBytes;
-  UINT64       ExtentLogicalBytes;
+  EXT4_INODE     *Inode;
+  UINT64         InodeSize;
+  UINT64         CurrentSeek;
+  UINTN          RemainingRead;
+  UINTN          BeenRead;
+  UINTN          WasRead;
+  EXT4_EXTENT    Extent;
+  UINT32         BlockOff;
+  EFI_STATUS     Status;
+  BOOLEAN        HasBackingExtent;
+  UINT64         HoleLen;
+  UINT64         ExtentStartBytes;
+  UINT64         ExtentLogicalBytes;
+  UINT64         RunLength;
+  BOOLEAN        Sequential;
+  EXT4_BLOCK_NR  CurrentBlock;
+  UINT64         HoleBlocks;
+  EXT4_IO_BATCH  Batch;
+  EFI_STATUS     BatchStatus;
 
   // Our extent offset is the difference between CurrentSeek and ExtentLogicalBytes
   UINT64  ExtentOffset;
-  UINTN   ExtentMayRead;
 
   Inode         = File->Inode;
   InodeSize     = EXT4_INODE_SIZE (Inode);
@@ -125,54 +258,82 @@ Ext4Read (
     RemainingRead = (UINTN)(InodeSize - Offset);
   }
 
+  // Reading from the start of the file doesn't tell us anything about the
+  // access pattern, so only read ahead once the file is read in order.
+  Sequential = (Offset != 0) && (Offset == File->NextReadOffset);
+
+  // Reads of separate runs of the file are kept in flight together, if the disk supports it
+  Ext4InitIoBatch (Partition, &Batch);
+  Status = EFI_SUCCESS;
+
   while (RemainingRead != 0) {
     WasRead = 0;
 
     // The algorithm here is to get the extent corresponding to the current block
     // and then read as much as we can from the current extent.
 
-    Status = Ext4GetExtent (
-               Partition,
-               File,
-               DivU64x32Remainder (CurrentSeek, Partition->BlockSize, &BlockOff),
-               &Extent
-               );
+    CurrentBlock = DivU64x32Remainder (CurrentSeek, Partition->BlockSize, &BlockOff);
+
+    Status = Ext4GetExtent (Partition, File, CurrentBlock, &Extent);
 
     if ((Status != EFI_SUCCESS) && (Status != EFI_NO_MAPPING)) {
-      return Status;
+      break;
     }
 
     HasBackingExtent = Status != EFI_NO_MAPPING;
 
     if (!HasBackingExtent || EXT4_EXTENT_IS_UNINITIALIZED (&Extent)) {
-      HoleOff = BlockOff;
-
       if (!HasBackingExtent) {
-        HoleLen = Partition->BlockSize - HoleOff;
+        // Zero the whole hole at once, instead of looking it up again for every block
+        Status = Ext4GetHoleLength (Partition, File, CurrentBlock, &HoleBlocks);
+
+        if (EFI_ERROR (Status)) {
+          break;
+        }
+
+        HoleLen = EXT4_BLOCK_TO_BYTES (Partition, HoleBlocks) - BlockOff;
       } else {
         // Uninitialized extents behave exactly the same as file holes, except they have
         // blocks already allocated to them.
-        HoleLen = (Ext4GetExtentLength (&Extent) * Partition->BlockSize) - HoleOff;
+        HoleLen = EXT4_BLOCK_TO_BYTES (Partition, Extent.ee_block + Ext4GetExtentLength (&Extent)) - CurrentSeek;
       }
 
       WasRead = HoleLen > RemainingRead ? RemainingRead : (UINTN)HoleLen;
-      // Potential improvement: In the future, we could get the file hole's total
-      // size and memset all that
       ZeroMem (Buffer, WasRead);
     } else {
-      ExtentStartBytes = MultU64x32 (
-                           LShiftU64 (Extent.ee_start_hi, 32) |
-                           Extent.ee_start_lo,
-                           Partition->BlockSize
-                           );
-      ExtentLengthBytes  = Extent.ee_len * Partition->BlockSize;
+      ExtentStartBytes   = EXT4_BLOCK_TO_BYTES (Partition, EXT4_EXTENT_PHYSICAL (&Extent));
       ExtentLogicalBytes = (UINT64)Extent.ee_block * Partition->BlockSize;
       ExtentOffset       = CurrentSeek - ExtentLogicalBytes;
-      ExtentMayRead      = (UINTN)(ExtentLengthBytes - ExtentOffset);
 
-      WasRead = ExtentMayRead > RemainingRead ? RemainingRead : ExtentMayRead;
+      // Issue a single transfer for as much of the file as is contiguous on disk.
+      // When reading ahead, look far enough to fill the read-ahead buffer, but
+      // never past the end of the file.
+      Status = Ext4GetContiguousRun (
+                 Partition,
+                 File,
+                 &Extent,
+                 ExtentOffset,
+                 MIN (InodeSize - CurrentSeek, MAX (RemainingRead, Sequential ? PcdGet32 (PcdExt4ReadAheadSize) : 0)),
+                 &RunLength
+                 );
 
-      Status = Ext4ReadDiskIo (Partition, Buffer, WasRead, ExtentStartBytes + ExtentOffset);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      RunLength = MIN (RunLength, InodeSize - CurrentSeek);
+      WasRead   = RunLength > RemainingRead ? RemainingRead : (UINTN)RunLength;
+
+      Status = Ext4ReadFileData (
+                 Partition,
+                 File,
+                 Buffer,
+                 WasRead,
+                 ExtentStartBytes + ExtentOffset,
+                 RunLength,
+                 Sequential,
+                 &Batch
+                 );
 
       if (EFI_ERROR (Status)) {
         DEBUG ((
@@ -182,7 +343,7 @@ Ext4Read (
           ExtentStartBytes + ExtentOffset,
           ExtentStartBytes + ExtentOffset + WasRead - 1
           ));
-        return Status;
+        break;
       }
     }
 
@@ -192,7 +353,20 @@ Ext4Read (
     CurrentSeek   += WasRead;
   }
 
-  *Length = BeenRead;
+  // Always wait for the reads in flight, since they write to the caller's buffer
+  BatchStatus = Ext4WaitIoBatch (&Batch);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (EFI_ERROR (BatchStatus)) {
+    DEBUG ((DEBUG_ERROR, "[ext4] Error %r reading from inode %lu\n", BatchStatus, File->InodeNum));
+    return BatchStatus;
+  }
+
+  *Length              = BeenRead;
+  File->NextReadOffset = CurrentSeek;
 
   return EFI_SUCCESS;
 }
@@ -36,28 +36,42 @@ Ext4OpenPartition (
   }
 
   InitializeListHead (&Part->OpenFiles);
+  InitializeListHead (&Part->DentryCache);
 
   Part->BlockIo = BlockIo;
   Part->DiskIo  = DiskIo;
   Part->DiskIo2 = DiskIo2;
 
+  Status = Ext4InitBlockCache (Part);
+
+  if (EFI_ERROR (Status)) {
+    FreePool (Part);
+    return Status;
+  }
+
   Status = Ext4OpenSuperblock (Part);
 
   if (EFI_ERROR (Status)) {
+    Ext4FreeBlockCache (Part);
     FreePool (Part);
     return Status;
   }
 
-  Part->Interface.Revision   = EFI_SIMPLE_FILE_SYSTEM_PROTOCOL_REVISION;
-  Part->Interface.OpenVolume = Ext4OpenVolume;
-  Status                     = gBS->InstallMultipleProtocolInterfaces (
-                                      &DeviceHandle,
-                                      &gEfiSimpleFileSystemProtocolGuid,
-                                      &Part->Interface,
-                                      NULL
-                                      );
+  Part->Interface.Revision                  = EFI_SIMPLE_FILE_SYSTEM_PROTOCOL_REVISION;
+  Part->Interface.OpenVolume                = Ext4OpenVolume;
+  Part->StatisticsInterface.GetStatistics   = Ext4GetStatistics;
+  Part->StatisticsInterface.ResetStatistics = Ext4ResetStatistics;
+  Status                                    = gBS->InstallMultipleProtocolInterfaces (
+                                                     &DeviceHandle,
+                                                     &gEfiSimpleFileSystemProtocolGuid,
+                                                     &Part->Interface,
+                                                     &gExt4StatisticsProtocolGuid,
+                                                     &Part->StatisticsInterface,
+                                                     NULL
+                                                     );
 
   if (EFI_ERROR (Status)) {
+    Ext4FreeBlockCache (Part);
     FreePool (Part);
     return Status;
   }
@@ -77,9 +91,7 @@ Ext4SetupFile (
   IN EXT4_PARTITION  *Partition
   )
 {
-  // Note: We don't yet support revision 2 of the file protocol
-  // (needs DISK_IO2 + asynchronous IO)
-  File->Protocol.Revision    = EFI_FILE_PROTOCOL_REVISION;
+  File->Protocol.Revision    = EFI_FILE_PROTOCOL_REVISION2;
   File->Protocol.Open        = Ext4Open;
   File->Protocol.Close       = Ext4Close;
   File->Protocol.Delete      = Ext4Delete;
@@ -89,6 +101,10 @@ Ext4SetupFile (
   File->Protocol.GetPosition = Ext4GetPosition;
   File->Protocol.GetInfo     = Ext4GetInfo;
   File->Protocol.SetInfo     = Ext4SetInfo;
+  File->Protocol.OpenEx      = Ext4OpenEx;
+  File->Protocol.ReadEx      = Ext4ReadFileEx;
+  File->Protocol.WriteEx     = Ext4WriteFileEx;
+  File->Protocol.FlushEx     = Ext4FlushFileEx;
 
   File->Partition = Partition;
 }
@@ -119,12 +135,22 @@ Ext4UnmountAndFreePartition (
     Ext4CloseInternal (File);
   }
 
+  // The cache holds references to dentries (and through them, to the root dentry)
+  Ext4FlushDentryCache (Partition);
+
   DeletedRootDentry = Ext4UnrefDentry (Partition->RootDentry);
 
   if (!DeletedRootDentry) {
     DEBUG ((DEBUG_ERROR, "[ext4] Failed to delete root dentry - resource leak present.\n"));
   }
 
+  Ext4FreeExtentSlots (Partition);
+
+  if (Partition->DirentScratch != NULL) {
+    FreePool (Partition->DirentScratch);
+  }
+
+  Ext4FreeBlockCache (Partition);
   FreePool (Partition->BlockGroups);
   FreePool (Partition);
 
@@ -7,7 +7,7 @@
 
 #include "Ext4Dxe.h"
 
-STATIC CONST UINT32  gSupportedCompatFeat = EXT4_FEATURE_COMPAT_EXT_ATTR;
+STATIC CONST UINT32  gSupportedCompatFeat = EXT4_FEATURE_COMPAT_EXT_ATTR | EXT4_FEATURE_COMPAT_DIR_INDEX;
 
 STATIC CONST UINT32  gSupportedRoCompatFeat =
   EXT4_FEATURE_RO_COMPAT_DIR_NLINK | EXT4_FEATURE_RO_COMPAT_EXTRA_ISIZE |
@@ -21,7 +21,7 @@ STATIC CONST UINT32  gSupportedIncompatFeat =
   EXT4_FEATURE_INCOMPAT_MMP | EXT4_FEATURE_INCOMPAT_RECOVER;
 
 // Future features that may be nice additions in the future:
-// 1) Btree support: Required for write support and would speed up lookups in large directories.
+// 1) Btree support: Required for write support (lookups already use the hash tree, see Directory.c).
 // 2) meta_bg: Required to mount meta_bg-enabled partitions.
 
 // Note: We ignore MMP because it's impossible that it's mapped elsewhere,
@@ -34,41 +34,138 @@ STATIC CONST UINT32  gSupportedIncompatFeat =
 // this is desired, it's fairly trivial to look for EFI_VOLUME_CORRUPTED
 // references and add some Ext4SignalCorruption function + function call.
 
+#define EXT4_PROBE_MISS_CACHE_SIZE  32
+
+// A medium that was probed and doesn't hold an ext4 filesystem
+typedef struct {
+  EFI_BLOCK_IO_PROTOCOL    *BlockIo;
+  UINT32                   MediaId;
+} EXT4_PROBE_MISS;
+
+// Every handle gets probed by every ConnectController(), so remember which ones
+// aren't ext4. A media change gets a new MediaId, which will be probed again.
+STATIC EXT4_PROBE_MISS  mProbeMisses[EXT4_PROBE_MISS_CACHE_SIZE];
+STATIC UINTN            mNextProbeMiss;
+
+// The superblock read by the last successful probe. Start() usually follows,
+// and can take it instead of reading it from the disk again.
+STATIC EFI_BLOCK_IO_PROTOCOL  *mProbedBlockIo;
+STATIC UINT32                 mProbedMediaId;
+STATIC EXT4_SUPERBLOCK        mProbedSuperblock;
+
 /**
-   Checks the superblock's magic value.
+   Checks whether a medium was already probed and found not to be ext4.
 
-   @param[in] DiskIo      Pointer to the DiskIo.
    @param[in] BlockIo     Pointer to the BlockIo.
 
+   @returns Whether the probe can be skipped.
+**/
+STATIC
+BOOLEAN
+Ext4IsKnownProbeMiss (
+  IN EFI_BLOCK_IO_PROTOCOL  *BlockIo
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < EXT4_PROBE_MISS_CACHE_SIZE; Index++) {
+    if (  (mProbeMisses[Index].BlockIo == BlockIo)
+       && (mProbeMisses[Index].MediaId == BlockIo->Media->MediaId))
+    {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+   Checks the superblock's magic value.
+   The whole superblock is read, so that mounting the partition afterwards
+   doesn't need to read it again.
+
+   @param[in] ControllerHandle  Handle of the device being probed.
+   @param[in] DiskIo            Pointer to the DiskIo.
+   @param[in] BlockIo           Pointer to the BlockIo.
+
    @returns Whether the partition has a valid EXT4 superblock magic value.
 **/
 BOOLEAN
 Ext4SuperblockCheckMagic (
+  IN EFI_HANDLE             ControllerHandle,
   IN EFI_DISK_IO_PROTOCOL   *DiskIo,
   IN EFI_BLOCK_IO_PROTOCOL  *BlockIo
   )
 {
-  UINT16      Magic;
-  EFI_STATUS  Status;
+  EFI_STATUS                   Status;
+  EFI_PARTITION_INFO_PROTOCOL  *PartitionInfo;
+
+  if (Ext4IsKnownProbeMiss (BlockIo)) {
+    return FALSE;
+  }
+
+  // EFI system partitions are FAT by definition, no need to look at them
+  Status = gBS->HandleProtocol (ControllerHandle, &gEfiPartitionInfoProtocolGuid, (VOID **)&PartitionInfo);
+
+  if (!EFI_ERROR (Status) && (PartitionInfo->System == 1)) {
+    return FALSE;
+  }
+
+  mProbedBlockIo = NULL;
 
   Status = DiskIo->ReadDisk (
                      DiskIo,
                      BlockIo->Media->MediaId,
-                     EXT4_SUPERBLOCK_OFFSET + OFFSET_OF (EXT4_SUPERBLOCK, s_magic),
-                     sizeof (Magic),
-                     &Magic
+                     EXT4_SUPERBLOCK_OFFSET,
+                     sizeof (EXT4_SUPERBLOCK),
+                     &mProbedSuperblock
                      );
   if (EFI_ERROR (Status)) {
     return FALSE;
   }
 
-  if (Magic != EXT4_SIGNATURE) {
+  if (mProbedSuperblock.s_magic != EXT4_SIGNATURE) {
+    mProbeMisses[mNextProbeMiss].BlockIo = BlockIo;
+    mProbeMisses[mNextProbeMiss].MediaId = BlockIo->Media->MediaId;
+    mNextProbeMiss                       = (mNextProbeMiss + 1) % EXT4_PROBE_MISS_CACHE_SIZE;
     return FALSE;
   }
 
+  mProbedBlockIo = BlockIo;
+  mProbedMediaId = BlockIo->Media->MediaId;
   return TRUE;
 }
 
+/**
+   Reads the partition's superblock, taking the one read by the last probe if
+   it came from the same medium.
+
+   @param[in out] Partition  Pointer to the opened ext4 partition.
+
+   @return The status of the read.
+**/
+STATIC
+EFI_STATUS
+Ext4ReadSuperblock (
+  IN OUT EXT4_PARTITION  *Partition
+  )
+{
+  if (  (mProbedBlockIo == Partition->BlockIo)
+     && (mProbedMediaId == Partition->BlockIo->Media->MediaId))
+  {
+    mProbedBlockIo = NULL;
+    CopyMem (&Partition->SuperBlock, &mProbedSuperblock, sizeof (EXT4_SUPERBLOCK));
+    return EFI_SUCCESS;
+  }
+
+  return Ext4ReadDiskIo (
+           Partition,
+           &Partition->SuperBlock,
+           sizeof (EXT4_SUPERBLOCK),
+           EXT4_SUPERBLOCK_OFFSET
+           );
+}
+
 /**
    Does brief validation of the ext4 superblock.
 
@@ -167,12 +264,7 @@ Ext4OpenSuperblock (
   UINT32                 UnsupportedRoCompat;
   EXT4_BLOCK_GROUP_DESC  *Desc;
 
-  Status = Ext4ReadDiskIo (
-             Partition,
-             &Partition->SuperBlock,
-             sizeof (EXT4_SUPERBLOCK),
-             EXT4_SUPERBLOCK_OFFSET
-             );
+  Status = Ext4ReadSuperblock (Partition);
 
   if (EFI_ERROR (Status)) {
     return Status;
@@ -347,7 +439,7 @@ Ext4CalculateChecksum (
   switch (Partition->SuperBlock.s_checksum_type) {
     case EXT4_CHECKSUM_CRC32C:
       // For some reason, EXT4 really likes non-inverted CRC32C checksums, so we stick to that here.
-      return ~CalculateCrc32c(Buffer, Length, ~InitialValue);
+      return Ext4Crc32c (InitialValue, Buffer, Length);
     default:
       ASSERT (FALSE);
       return 0;
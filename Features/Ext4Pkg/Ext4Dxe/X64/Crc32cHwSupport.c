@@ -0,0 +1,30 @@
+/** @file
+  SSE4.2 CRC32 instruction detection
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "../Ext4Dxe.h"
+
+#define CPUID_VERSION_INFO             0x01
+#define CPUID_VERSION_INFO_ECX_SSE4_2  BIT20
+
+/**
+   Checks if the CPU supports the CRC32C instructions used by Ext4Crc32cHw.
+
+   @retval TRUE   Ext4Crc32cHw can be used.
+   @retval FALSE  Ext4Crc32cHw can't be used.
+**/
+BOOLEAN
+EFIAPI
+Ext4Crc32cHwSupported (
+  VOID
+  )
+{
+  UINT32  Ecx;
+
+  AsmCpuid (CPUID_VERSION_INFO, NULL, NULL, &Ecx, NULL);
+
+  return (Ecx & CPUID_VERSION_INFO_ECX_SSE4_2) != 0;
+}
@@ -0,0 +1,63 @@
+/** @file
+  Ext4 statistics protocol
+
+  Installed by Ext4Dxe on every mounted partition, next to the Simple File
+  System protocol. Lets tools (like Ext4Bench) see how much disk I/O the
+  driver does on behalf of its callers.
+
+  Copyright (c) 2022 Pedro Falcato All rights reserved.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef EXT4_STATISTICS_PROTOCOL_H_
+#define EXT4_STATISTICS_PROTOCOL_H_
+
+#define EXT4_STATISTICS_PROTOCOL_GUID \
+  { 0x9fe3945e, 0x6948, 0x46b5, { 0xb7, 0xbf, 0xc6, 0x4e, 0x1a, 0x3b, 0xf7, 0xb1 } }
+
+typedef struct _EXT4_STATISTICS_PROTOCOL EXT4_STATISTICS_PROTOCOL;
+
+typedef struct {
+  // Number of DISK_IO(2) reads issued
+  UINT64    DiskReads;
+  // Number of bytes read through DISK_IO(2)
+  UINT64    DiskBytesRead;
+} EXT4_STATISTICS;
+
+/**
+   Retrieves the partition's statistics.
+
+   @param[in]      This          Pointer to the EXT4_STATISTICS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EXT4_STATISTICS_GET)(
+  IN  EXT4_STATISTICS_PROTOCOL  *This,
+  OUT EXT4_STATISTICS           *Statistics
+  );
+
+/**
+   Resets the partition's statistics to zero.
+
+   @param[in]      This          Pointer to the EXT4_STATISTICS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EXT4_STATISTICS_RESET)(
+  IN EXT4_STATISTICS_PROTOCOL  *This
+  );
+
+struct _EXT4_STATISTICS_PROTOCOL {
+  EXT4_STATISTICS_GET      GetStatistics;
+  EXT4_STATISTICS_RESET    ResetStatistics;
+};
+
+extern EFI_GUID  gExt4StatisticsProtocolGuid;
+
+#endif
@@ -0,0 +1,463 @@
+/** @file
+  FvbStats - benchmarks the Firmware Volume Block drivers behind the variable
+  store
+
+  Wraps every Firmware Volume Block instance with FvbStatsLib, writes
+  non-volatile variables until the variable store has been filled about twice
+  over, so that the variable driver has to reclaim it, and prints, for each
+  instance, how many Read(), Write() and EraseBlocks() calls the workload made,
+  the bytes they moved, and their average, median, 90th and 99th percentile
+  and maximum durations, along with those of the SetVariable() calls.
+
+  Without -w, only prints the statistics of the instances that were wrapped
+  by their driver at boot.
+
+  Usage: FvbStats [-w [-n Writes] [-s Size] [-c Variables]] [-r]
+    -w runs the workload.
+    -n sets the number of variable writes (default: enough to fill the
+       variable store twice).
+    -s sets the size of each variable, in bytes (default: 1024).
+    -c sets the number of distinct variables written in turn (default: 16).
+    -r resets the statistics after printing them.
+
+  FVB instances that are only reachable from SMM or another secure
+  environment aren't visible; only the SetVariable() durations cover them.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Protocol/DevicePath.h>
+#include <Protocol/FirmwareVolumeBlock.h>
+#include <Protocol/FvbStats.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/FvbStatsLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PrintLib.h>
+#include <Library/ShellCEntryLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+
+#define DEFAULT_VARIABLE_SIZE   1024
+#define DEFAULT_VARIABLE_COUNT  16
+
+#define VARIABLE_ATTRIBUTES  (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS)
+
+//
+// Vendor GUID of the variables written by the workload
+//
+STATIC EFI_GUID  mFvbStatsVariableGuid = {
+  0xf9f80644, 0x142b, 0x4d28, { 0xa6, 0x82, 0x4d, 0xa4, 0x98, 0x0e, 0xf6, 0x72 }
+};
+
+STATIC CONST CHAR16  *mCallNames[FvbStatsCallMax] = {
+  L"Read",
+  L"Write",
+  L"Erase"
+};
+
+/**
+   Converts performance counter ticks to nanoseconds.
+
+   @param[in]      Ticks         Number of ticks.
+   @param[in]      Frequency     Frequency of the performance counter, in Hz.
+
+   @return Nanoseconds.
+**/
+STATIC
+UINT64
+TicksToNs (
+  IN UINT64  Ticks,
+  IN UINT64  Frequency
+  )
+{
+  UINT64  Seconds;
+  UINT64  Remainder;
+
+  if (Frequency == 0) {
+    return 0;
+  }
+
+  // Split the conversion so that it doesn't overflow for large tick counts
+  Seconds = DivU64x64Remainder (Ticks, Frequency, &Remainder);
+  return MultU64x32 (Seconds, 1000000000) +
+         DivU64x64Remainder (MultU64x32 (Remainder, 1000000000), Frequency, NULL);
+}
+
+/**
+   Prints the statistics of one kind of call.
+
+   @param[in]      Name          Name of the call.
+   @param[in]      Data          Pointer to the call's statistics.
+   @param[in]      Frequency     Frequency of the performance counter, in Hz.
+**/
+STATIC
+VOID
+PrintCall (
+  IN CONST CHAR16               *Name,
+  IN CONST FVB_STATS_CALL_DATA  *Data,
+  IN UINT64                     Frequency
+  )
+{
+  Print (
+    L"  %-11s %10lu calls %6lu errors %12lu bytes\n",
+    Name,
+    Data->Calls,
+    Data->Errors,
+    Data->Bytes
+    );
+
+  if (Data->Calls == 0) {
+    return;
+  }
+
+  Print (
+    L"              %10lu ns avg %10lu ns p50 %10lu ns p90 %10lu ns p99 %10lu ns max\n",
+    TicksToNs (DivU64x64Remainder (Data->TotalTicks, Data->Calls, NULL), Frequency),
+    TicksToNs (FvbStatsPercentile (Data, 50), Frequency),
+    TicksToNs (FvbStatsPercentile (Data, 90), Frequency),
+    TicksToNs (FvbStatsPercentile (Data, 99), Frequency),
+    TicksToNs (Data->MaxTicks, Frequency)
+    );
+}
+
+/**
+   Prints the statistics of every FVB instance that has them.
+
+   @param[in]      Reset         TRUE to reset the statistics after printing them.
+
+   @retval EFI_SUCCESS           The statistics were printed.
+   @return Status of locating the instances.
+**/
+STATIC
+EFI_STATUS
+PrintAllStatistics (
+  IN BOOLEAN  Reset
+  )
+{
+  EFI_STATUS                Status;
+  EFI_HANDLE                *Handles;
+  UINTN                     NumberHandles;
+  UINTN                     Index;
+  UINTN                     Call;
+  FVB_STATS_PROTOCOL        *Protocol;
+  FVB_STATS                 *Stats;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  CHAR16                    *DevicePathText;
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gFvbStatsProtocolGuid,
+                  NULL,
+                  &NumberHandles,
+                  &Handles
+                  );
+
+  if (EFI_ERROR (Status)) {
+    Print (L"No FVB instances with statistics found: %r\n", Status);
+    return Status;
+  }
+
+  // FVB_STATS is too large to comfortably live on the stack
+  Stats = AllocatePool (sizeof (*Stats));
+
+  if (Stats == NULL) {
+    FreePool (Handles);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < NumberHandles; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gFvbStatsProtocolGuid, (VOID **)&Protocol);
+
+    if (!EFI_ERROR (Status)) {
+      Status = Protocol->GetStatistics (Protocol, Stats);
+    }
+
+    if (EFI_ERROR (Status)) {
+      Print (L"%u: failed to get statistics: %r\n", Index, Status);
+      continue;
+    }
+
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiDevicePathProtocolGuid, (VOID **)&DevicePath);
+
+    DevicePathText = EFI_ERROR (Status) ? NULL : ConvertDevicePathToText (DevicePath, TRUE, TRUE);
+    Print (L"%u: %s\n", Index, DevicePathText != NULL ? DevicePathText : L"(no device path)");
+
+    if (DevicePathText != NULL) {
+      FreePool (DevicePathText);
+    }
+
+    for (Call = 0; Call < FvbStatsCallMax; Call++) {
+      PrintCall (mCallNames[Call], &Stats->Call[Call], Stats->CounterFrequency);
+    }
+
+    if (Reset) {
+      Protocol->ResetStatistics (Protocol);
+    }
+  }
+
+  FreePool (Stats);
+  FreePool (Handles);
+  return EFI_SUCCESS;
+}
+
+/**
+   Writes variables until the requested number of writes is done, timing each
+   SetVariable() call, then deletes them.
+
+   @param[in]      Writes        Number of writes, 0 to fill the variable store twice.
+   @param[in]      Size          Size of each variable, in bytes.
+   @param[in]      Count         Number of distinct variables written in turn.
+   @param[out]     Data          Pointer to the SetVariable() statistics.
+
+   @retval EFI_SUCCESS           All writes succeeded.
+   @return Status of the first write that failed.
+**/
+STATIC
+EFI_STATUS
+RunWorkload (
+  IN  UINTN                Writes,
+  IN  UINTN                Size,
+  IN  UINTN                Count,
+  OUT FVB_STATS_CALL_DATA  *Data
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      MaximumStorageSize;
+  UINT64      RemainingStorageSize;
+  UINT64      MaximumVariableSize;
+  UINT64      StartTicks;
+  UINT8       *Buffer;
+  UINTN       Index;
+  CHAR16      Name[16];
+
+  Status = gRT->QueryVariableInfo (
+                  VARIABLE_ATTRIBUTES,
+                  &MaximumStorageSize,
+                  &RemainingStorageSize,
+                  &MaximumVariableSize
+                  );
+
+  if (EFI_ERROR (Status)) {
+    Print (L"Failed to query the variable store: %r\n", Status);
+    return Status;
+  }
+
+  Print (
+    L"Variable store: %lu bytes, %lu bytes free, %lu bytes per variable at most\n",
+    MaximumStorageSize,
+    RemainingStorageSize,
+    MaximumVariableSize
+    );
+
+  if (Size > MaximumVariableSize) {
+    Print (L"Variables of %u bytes don't fit in the variable store\n", Size);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  // Every write appends a new copy of the variable, so writing twice the
+  // size of the store forces at least one reclaim
+  if (Writes == 0) {
+    Writes = (UINTN)DivU64x64Remainder (MultU64x32 (MaximumStorageSize, 2) + Size - 1, Size, NULL);
+  }
+
+  Buffer = AllocatePool (Size);
+
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Print (L"Writing %u variables of %u bytes, %u times...\n", Count, Size, Writes);
+
+  for (Index = 0; Index < Writes; Index++) {
+    UnicodeSPrint (Name, sizeof (Name), L"FvbStats%04u", Index % Count);
+
+    // Change the data on every write, so the variable driver can't skip it
+    SetMem (Buffer, Size, (UINT8)(Index / Count));
+
+    StartTicks = FvbStatsStart ();
+    Status     = gRT->SetVariable (Name, &mFvbStatsVariableGuid, VARIABLE_ATTRIBUTES, Size, Buffer);
+    FvbStatsRecord (Data, StartTicks, Status, Size);
+
+    if (EFI_ERROR (Status)) {
+      Print (L"Write %u of %s failed: %r\n", Index, Name, Status);
+      break;
+    }
+  }
+
+  for (Index = 0; Index < Count; Index++) {
+    UnicodeSPrint (Name, sizeof (Name), L"FvbStats%04u", Index);
+    gRT->SetVariable (Name, &mFvbStatsVariableGuid, 0, 0, NULL);
+  }
+
+  FreePool (Buffer);
+  return Status;
+}
+
+/**
+   Reads the numeric value of an option.
+
+   @param[in]      Argc          The number of items in Argv.
+   @param[in]      Argv          Array of pointers to the arguments.
+   @param[in, out] Index         On input, index of the option. On output, index of its value.
+   @param[out]     Value         Pointer to where the value will be stored.
+
+   @retval TRUE                  The value was read.
+   @retval FALSE                 The value is missing or zero.
+**/
+STATIC
+BOOLEAN
+GetOptionValue (
+  IN     UINTN   Argc,
+  IN     CHAR16  **Argv,
+  IN OUT UINTN   *Index,
+  OUT    UINTN   *Value
+  )
+{
+  if (*Index + 1 >= Argc) {
+    return FALSE;
+  }
+
+  (*Index)++;
+  *Value = StrDecimalToUintn (Argv[*Index]);
+  return *Value != 0;
+}
+
+/**
+   The main entry point of the application.
+
+   @param[in] Argc             The number of items in Argv.
+   @param[in] Argv             Array of pointers to the arguments.
+
+   @retval 0                   The statistics were printed.
+   @retval Other               An error occurred.
+**/
+INTN
+EFIAPI
+ShellAppMain (
+  IN UINTN   Argc,
+  IN CHAR16  **Argv
+  )
+{
+  EFI_STATUS           Status;
+  EFI_HANDLE           *Handles;
+  FVB_STATS_CONTEXT    **Contexts;
+  FVB_STATS_CALL_DATA  *SetVariableData;
+  FVB_STATS_PROTOCOL   *Protocol;
+  UINTN                NumberHandles;
+  UINTN                Index;
+  UINTN                Writes;
+  UINTN                Size;
+  UINTN                Count;
+  BOOLEAN              Workload;
+  BOOLEAN              Reset;
+  BOOLEAN              Valid;
+
+  Workload = FALSE;
+  Reset    = FALSE;
+  Valid    = TRUE;
+  Writes   = 0;
+  Size     = DEFAULT_VARIABLE_SIZE;
+  Count    = DEFAULT_VARIABLE_COUNT;
+
+  for (Index = 1; Index < Argc && Valid; Index++) {
+    if (StrCmp (Argv[Index], L"-w") == 0) {
+      Workload = TRUE;
+    } else if (StrCmp (Argv[Index], L"-r") == 0) {
+      Reset = TRUE;
+    } else if (StrCmp (Argv[Index], L"-n") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &Writes);
+    } else if (StrCmp (Argv[Index], L"-s") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &Size);
+    } else if (StrCmp (Argv[Index], L"-c") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &Count) && (Count <= 10000);
+    } else {
+      Valid = FALSE;
+    }
+  }
+
+  if (!Valid) {
+    Print (L"Usage: %s [-w [-n Writes] [-s Size] [-c Variables]] [-r]\n", Argv[0]);
+    return 1;
+  }
+
+  if (!Workload) {
+    return EFI_ERROR (PrintAllStatistics (Reset)) ? 1 : 0;
+  }
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiFirmwareVolumeBlock2ProtocolGuid,
+                  NULL,
+                  &NumberHandles,
+                  &Handles
+                  );
+
+  if (EFI_ERROR (Status)) {
+    Print (L"No FVB instances found: %r\n", Status);
+    NumberHandles = 0;
+    Handles       = NULL;
+  }
+
+  Contexts        = AllocateZeroPool (MAX (NumberHandles, 1) * sizeof (*Contexts));
+  SetVariableData = AllocateZeroPool (sizeof (*SetVariableData));
+
+  if ((Contexts == NULL) || (SetVariableData == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  //
+  // Wrap the instances that their driver didn't wrap already, and start the
+  // others from zero too
+  //
+  for (Index = 0; Index < NumberHandles; Index++) {
+    Status = FvbStatsInstall (Handles[Index], &Contexts[Index]);
+
+    if (Status == EFI_ALREADY_STARTED) {
+      Status = gBS->HandleProtocol (Handles[Index], &gFvbStatsProtocolGuid, (VOID **)&Protocol);
+      if (!EFI_ERROR (Status)) {
+        Protocol->ResetStatistics (Protocol);
+      }
+    }
+
+    if (EFI_ERROR (Status)) {
+      Print (L"Failed to wrap FVB instance %u: %r\n", Index, Status);
+    }
+  }
+
+  Status = RunWorkload (Writes, Size, Count, SetVariableData);
+
+  PrintCall (L"SetVariable", SetVariableData, FvbStatsCounterFrequency ());
+  PrintAllStatistics (Reset);
+
+  //
+  // The wrappers are part of this image; an instance that can't be restored
+  // would call into freed memory, so at least say which one it is
+  //
+  for (Index = 0; Index < NumberHandles; Index++) {
+    if (EFI_ERROR (FvbStatsUninstall (Handles[Index], Contexts[Index]))) {
+      Print (L"Failed to restore FVB instance %u, reset the system\n", Index);
+    }
+  }
+
+Exit:
+  if (SetVariableData != NULL) {
+    FreePool (SetVariableData);
+  }
+
+  if (Contexts != NULL) {
+    FreePool (Contexts);
+  }
+
+  if (Handles != NULL) {
+    FreePool (Handles);
+  }
+
+  return EFI_ERROR (Status) ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+/** @file
+  FVB statistics library
+
+  Wraps the Read(), Write() and EraseBlocks() functions of a Firmware Volume
+  Block protocol instance, to count their calls, the bytes they moved, and
+  how long each call took. Recording a call costs two reads of the
+  performance counter and a few additions, so the wrappers barely change the
+  timing they measure.
+
+  The instance is wrapped in place, so its users, like the variable driver
+  and the fault tolerant write driver, are measured without being changed.
+  The counters are published through the FVB statistics protocol.
+
+  The wrappers live in the module that links the library, and in boot
+  services memory: they must be removed before that module is unloaded, and
+  can't measure calls made at runtime.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef FVB_STATS_LIB_H_
+#define FVB_STATS_LIB_H_
+
+#include <Protocol/FirmwareVolumeBlock.h>
+#include <Protocol/FvbStats.h>
+
+typedef struct _FVB_STATS_CONTEXT FVB_STATS_CONTEXT;
+
+/**
+   Wraps the Firmware Volume Block protocol instance of a handle, and
+   installs the FVB statistics protocol on the handle.
+
+   @param[in]      Handle        Handle the Firmware Volume Block protocol is installed on.
+   @param[out]     Context       Pointer to where the statistics context will be stored.
+
+   @retval EFI_SUCCESS           The instance was wrapped.
+   @retval EFI_ALREADY_STARTED   The handle already has the FVB statistics protocol.
+   @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+   @return Status of locating or installing the protocols.
+**/
+EFI_STATUS
+EFIAPI
+FvbStatsInstall (
+  IN  EFI_HANDLE         Handle,
+  OUT FVB_STATS_CONTEXT  **Context
+  );
+
+/**
+   Restores the wrapped Firmware Volume Block protocol instance, uninstalls
+   the FVB statistics protocol, and frees the statistics.
+
+   @param[in]      Handle        Handle passed to FvbStatsInstall().
+   @param[in]      Context       Statistics context, may be NULL.
+
+   @retval EFI_SUCCESS           The instance was restored.
+   @retval EFI_ACCESS_DENIED     The instance was wrapped again by someone else,
+                                 and can't be restored.
+   @return Status of uninstalling the protocol.
+**/
+EFI_STATUS
+EFIAPI
+FvbStatsUninstall (
+  IN EFI_HANDLE         Handle,
+  IN FVB_STATS_CONTEXT  *Context OPTIONAL
+  );
+
+/**
+   Returns the smallest duration counted by a latency histogram bucket.
+
+   @param[in]      Bucket        Index of the bucket, up to FVB_STATS_HISTOGRAM_BUCKETS.
+
+   @return Duration in performance counter ticks. MAX_UINT64 for
+           FVB_STATS_HISTOGRAM_BUCKETS, the end of the last bucket.
+**/
+UINT64
+EFIAPI
+FvbStatsBucketStart (
+  IN UINTN  Bucket
+  );
+
+/**
+   Estimates a percentile of the durations counted by a latency histogram.
+
+   @param[in]      Data          Pointer to the call's statistics.
+   @param[in]      Percentile    Percentile to estimate, from 0 to 100.
+
+   @return Duration in performance counter ticks, interpolated within the
+           bucket that holds the percentile. 0 if there were no calls.
+**/
+UINT64
+EFIAPI
+FvbStatsPercentile (
+  IN CONST FVB_STATS_CALL_DATA  *Data,
+  IN UINTN                      Percentile
+  );
+
+/**
+   Starts timing a call.
+
+   @return Performance counter value, to pass to FvbStatsRecord().
+**/
+UINT64
+EFIAPI
+FvbStatsStart (
+  VOID
+  );
+
+/**
+   Records a call. Lets callers measure other calls, like SetVariable(), the
+   same way as the wrapped FVB functions.
+
+   @param[in out]  Data          Pointer to the call's statistics.
+   @param[in]      StartTicks    Value returned by FvbStatsStart() when the call started.
+   @param[in]      Status        Status returned by the call.
+   @param[in]      Bytes         Bytes moved, if the call succeeded.
+**/
+VOID
+EFIAPI
+FvbStatsRecord (
+  IN OUT FVB_STATS_CALL_DATA  *Data,
+  IN     UINT64               StartTicks,
+  IN     EFI_STATUS           Status,
+  IN     UINT64               Bytes
+  );
+
+/**
+   Returns the frequency of the performance counter the calls are timed with.
+
+   @return Frequency in Hz.
+**/
+UINT64
+EFIAPI
+FvbStatsCounterFrequency (
+  VOID
+  );
+
+#endif
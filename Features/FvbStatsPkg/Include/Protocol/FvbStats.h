@@ -0,0 +1,98 @@
+/** @file
+  FVB statistics protocol
+
+  Installed by FvbStatsLib on the handle that carries the Firmware Volume
+  Block protocol instance it wraps. Lets tools (like FvbStats) see how often,
+  and how fast, the instance's Read(), Write() and EraseBlocks() functions
+  are called.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef FVB_STATS_PROTOCOL_H_
+#define FVB_STATS_PROTOCOL_H_
+
+#define FVB_STATS_PROTOCOL_GUID \
+  { 0xb3c19084, 0x6951, 0x4d11, { 0x92, 0x28, 0xce, 0xe0, 0xfd, 0x19, 0x9b, 0x15 } }
+
+//
+// Each power of two of the latency histograms is split in this many buckets,
+// so that percentiles can be estimated to within a quarter of an octave.
+//
+#define FVB_STATS_HISTOGRAM_SUB_BUCKETS  4
+
+//
+// Number of buckets of each latency histogram. Bucket N, for N below
+// FVB_STATS_HISTOGRAM_SUB_BUCKETS, counts the calls that took N performance
+// counter ticks. Above that, bucket N counts the calls that took
+// [FvbStatsBucketStart (N), FvbStatsBucketStart (N + 1)) ticks, see
+// FvbStatsLib.
+//
+#define FVB_STATS_HISTOGRAM_BUCKETS  (64 * FVB_STATS_HISTOGRAM_SUB_BUCKETS)
+
+typedef struct _FVB_STATS_PROTOCOL FVB_STATS_PROTOCOL;
+
+typedef enum {
+  FvbStatsRead,
+  FvbStatsWrite,
+  FvbStatsErase,
+  FvbStatsCallMax
+} FVB_STATS_CALL;
+
+typedef struct {
+  // Number of calls
+  UINT64    Calls;
+  // Calls that failed
+  UINT64    Errors;
+  // Bytes read, written or erased by the successful calls
+  UINT64    Bytes;
+  // Sum and maximum of the calls' durations, in performance counter ticks
+  UINT64    TotalTicks;
+  UINT64    MaxTicks;
+  UINT64    Histogram[FVB_STATS_HISTOGRAM_BUCKETS];
+} FVB_STATS_CALL_DATA;
+
+typedef struct {
+  // Frequency of the performance counter the durations are measured with,
+  // in Hz
+  UINT64                 CounterFrequency;
+  FVB_STATS_CALL_DATA    Call[FvbStatsCallMax];
+} FVB_STATS;
+
+/**
+   Retrieves the FVB instance's statistics.
+
+   @param[in]      This          Pointer to the FVB_STATS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *FVB_STATS_GET)(
+  IN  FVB_STATS_PROTOCOL  *This,
+  OUT FVB_STATS           *Statistics
+  );
+
+/**
+   Resets the FVB instance's statistics to zero.
+
+   @param[in]      This          Pointer to the FVB_STATS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *FVB_STATS_RESET)(
+  IN FVB_STATS_PROTOCOL  *This
+  );
+
+struct _FVB_STATS_PROTOCOL {
+  FVB_STATS_GET      GetStatistics;
+  FVB_STATS_RESET    ResetStatistics;
+};
+
+extern EFI_GUID  gFvbStatsProtocolGuid;
+
+#endif
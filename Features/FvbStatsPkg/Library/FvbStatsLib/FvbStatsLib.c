@@ -0,0 +1,706 @@
+/** @file
+  FVB statistics library
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/FvbStatsLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#define FVB_STATS_CONTEXT_SIGNATURE  SIGNATURE_32 ('F', 'V', 'B', 'S')
+
+//
+// log2 (FVB_STATS_HISTOGRAM_SUB_BUCKETS)
+//
+#define FVB_STATS_SUB_BUCKET_SHIFT  2
+
+//
+// Largest number of LBA ranges passed to the original EraseBlocks() at once.
+// Longer lists are split, which no FVB user in practice needs.
+//
+#define FVB_STATS_MAX_ERASE_RANGES  4
+
+struct _FVB_STATS_CONTEXT {
+  UINT32                                 Signature;
+  LIST_ENTRY                             Link;
+  FVB_STATS_PROTOCOL                     Protocol;
+  EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL    *Fvb;
+  EFI_FVB_READ                           OriginalRead;
+  EFI_FVB_WRITE                          OriginalWrite;
+  EFI_FVB_ERASE_BLOCKS                   OriginalEraseBlocks;
+  FVB_STATS                              Stats;
+};
+
+#define FVB_STATS_CONTEXT_FROM_PROTOCOL(This) \
+  CR (This, FVB_STATS_CONTEXT, Protocol, FVB_STATS_CONTEXT_SIGNATURE)
+
+#define FVB_STATS_CONTEXT_FROM_LINK(Node) \
+  CR (Node, FVB_STATS_CONTEXT, Link, FVB_STATS_CONTEXT_SIGNATURE)
+
+//
+// The wrapped instances belong to other drivers, so the wrappers can't find
+// their context from This with CR (); look it up in the list instead.
+//
+STATIC LIST_ENTRY  mContexts = INITIALIZE_LIST_HEAD_VARIABLE (mContexts);
+
+STATIC UINT64   mCounterFrequency;
+// TRUE if the performance counter counts down
+STATIC BOOLEAN  mCountsDown;
+
+/**
+   Finds the statistics context of a wrapped FVB instance.
+
+   @param[in]      Fvb           Pointer to the wrapped FVB instance.
+
+   @return Pointer to the context, or NULL if the instance isn't wrapped.
+**/
+STATIC
+FVB_STATS_CONTEXT *
+FvbStatsFindContext (
+  IN CONST EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL  *Fvb
+  )
+{
+  LIST_ENTRY         *Node;
+  FVB_STATS_CONTEXT  *Context;
+
+  BASE_LIST_FOR_EACH (Node, &mContexts) {
+    Context = FVB_STATS_CONTEXT_FROM_LINK (Node);
+
+    if (Context->Fvb == Fvb) {
+      return Context;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+   Returns the histogram bucket that counts a duration.
+
+   @param[in]      Ticks         Duration in performance counter ticks.
+
+   @return Index of the bucket.
+**/
+STATIC
+UINTN
+FvbStatsBucket (
+  IN UINT64  Ticks
+  )
+{
+  UINTN  Msb;
+
+  if (Ticks < FVB_STATS_HISTOGRAM_SUB_BUCKETS) {
+    return (UINTN)Ticks;
+  }
+
+  // The most significant bit selects the octave, the bits below it the
+  // bucket within the octave
+  Msb = (UINTN)HighBitSet64 (Ticks);
+  return Msb * FVB_STATS_HISTOGRAM_SUB_BUCKETS +
+         ((UINTN)RShiftU64 (Ticks, Msb - FVB_STATS_SUB_BUCKET_SHIFT) & (FVB_STATS_HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+/**
+   Returns the smallest duration counted by a latency histogram bucket.
+
+   @param[in]      Bucket        Index of the bucket, up to FVB_STATS_HISTOGRAM_BUCKETS.
+
+   @return Duration in performance counter ticks. MAX_UINT64 for
+           FVB_STATS_HISTOGRAM_BUCKETS, the end of the last bucket.
+**/
+UINT64
+EFIAPI
+FvbStatsBucketStart (
+  IN UINTN  Bucket
+  )
+{
+  UINTN  Octave;
+
+  if (Bucket >= FVB_STATS_HISTOGRAM_BUCKETS) {
+    return MAX_UINT64;
+  }
+
+  if (Bucket < FVB_STATS_HISTOGRAM_SUB_BUCKETS) {
+    return Bucket;
+  }
+
+  // The octaves below FVB_STATS_SUB_BUCKET_SHIFT are counted exactly by the
+  // first buckets, so their buckets stay empty
+  Octave = Bucket / FVB_STATS_HISTOGRAM_SUB_BUCKETS;
+  if (Octave < FVB_STATS_SUB_BUCKET_SHIFT) {
+    return FVB_STATS_HISTOGRAM_SUB_BUCKETS;
+  }
+
+  return LShiftU64 (
+           FVB_STATS_HISTOGRAM_SUB_BUCKETS + Bucket % FVB_STATS_HISTOGRAM_SUB_BUCKETS,
+           Octave - FVB_STATS_SUB_BUCKET_SHIFT
+           );
+}
+
+/**
+   Estimates a percentile of the durations counted by a latency histogram.
+
+   @param[in]      Data          Pointer to the call's statistics.
+   @param[in]      Percentile    Percentile to estimate, from 0 to 100.
+
+   @return Duration in performance counter ticks, interpolated within the
+           bucket that holds the percentile. 0 if there were no calls.
+**/
+UINT64
+EFIAPI
+FvbStatsPercentile (
+  IN CONST FVB_STATS_CALL_DATA  *Data,
+  IN UINTN                      Percentile
+  )
+{
+  UINT64  Rank;
+  UINT64  Below;
+  UINT64  Start;
+  UINT64  Width;
+  UINT64  Ticks;
+  UINTN   Bucket;
+
+  if (Data->Calls == 0) {
+    return 0;
+  }
+
+  ASSERT (Percentile <= 100);
+
+  // The rank of the call that has the percentile's duration, counting from 1
+  Rank = DivU64x32 (MultU64x32 (Data->Calls, (UINT32)Percentile) + 99, 100);
+  if (Rank == 0) {
+    Rank = 1;
+  }
+
+  Below = 0;
+  for (Bucket = 0; Bucket < FVB_STATS_HISTOGRAM_BUCKETS; Bucket++) {
+    if (Below + Data->Histogram[Bucket] >= Rank) {
+      break;
+    }
+
+    Below += Data->Histogram[Bucket];
+  }
+
+  if (Bucket == FVB_STATS_HISTOGRAM_BUCKETS) {
+    return Data->MaxTicks;
+  }
+
+  Start = FvbStatsBucketStart (Bucket);
+  Width = FvbStatsBucketStart (Bucket + 1) - Start;
+  Ticks = Start + DivU64x64Remainder (
+                    MultU64x64 (Width, Rank - Below),
+                    Data->Histogram[Bucket],
+                    NULL
+                    );
+
+  return MIN (Ticks, Data->MaxTicks);
+}
+
+/**
+   Starts timing a call.
+
+   @return Performance counter value, to pass to FvbStatsRecord().
+**/
+UINT64
+EFIAPI
+FvbStatsStart (
+  VOID
+  )
+{
+  return GetPerformanceCounter ();
+}
+
+/**
+   Records a call. Lets callers measure other calls, like SetVariable(), the
+   same way as the wrapped FVB functions.
+
+   @param[in out]  Data          Pointer to the call's statistics.
+   @param[in]      StartTicks    Value returned by FvbStatsStart() when the call started.
+   @param[in]      Status        Status returned by the call.
+   @param[in]      Bytes         Bytes moved, if the call succeeded.
+**/
+VOID
+EFIAPI
+FvbStatsRecord (
+  IN OUT FVB_STATS_CALL_DATA  *Data,
+  IN     UINT64               StartTicks,
+  IN     EFI_STATUS           Status,
+  IN     UINT64               Bytes
+  )
+{
+  UINT64  Now;
+  UINT64  Ticks;
+
+  Now   = GetPerformanceCounter ();
+  Ticks = mCountsDown ? StartTicks - Now : Now - StartTicks;
+
+  Data->Calls++;
+  Data->TotalTicks += Ticks;
+
+  if (Ticks > Data->MaxTicks) {
+    Data->MaxTicks = Ticks;
+  }
+
+  Data->Histogram[FvbStatsBucket (Ticks)]++;
+
+  if (EFI_ERROR (Status)) {
+    Data->Errors++;
+  } else {
+    Data->Bytes += Bytes;
+  }
+}
+
+/**
+   Returns the frequency of the performance counter the calls are timed with.
+
+   @return Frequency in Hz.
+**/
+UINT64
+EFIAPI
+FvbStatsCounterFrequency (
+  VOID
+  )
+{
+  return mCounterFrequency;
+}
+
+/**
+   Timed wrapper of EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL.Read().
+
+   @param[in]      This          Indicates the EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL instance.
+   @param[in]      Lba           The starting logical block index from which to read.
+   @param[in]      Offset        Offset into the block at which to begin reading.
+   @param[in, out] NumBytes      At entry, the size of the buffer. At exit, the number
+                                 of bytes read.
+   @param[out]     Buffer        Pointer to a caller-allocated buffer.
+
+   @return Status of the wrapped function.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FvbStatsWrapRead (
+  IN CONST EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL  *This,
+  IN       EFI_LBA                              Lba,
+  IN       UINTN                                Offset,
+  IN OUT   UINTN                                *NumBytes,
+  IN OUT   UINT8                                *Buffer
+  )
+{
+  FVB_STATS_CONTEXT  *Context;
+  EFI_STATUS         Status;
+  UINT64             StartTicks;
+
+  Context = FvbStatsFindContext (This);
+  ASSERT (Context != NULL);
+  if (Context == NULL) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  StartTicks = FvbStatsStart ();
+  Status     = Context->OriginalRead (This, Lba, Offset, NumBytes, Buffer);
+  FvbStatsRecord (&Context->Stats.Call[FvbStatsRead], StartTicks, Status, *NumBytes);
+
+  return Status;
+}
+
+/**
+   Timed wrapper of EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL.Write().
+
+   @param[in]      This          Indicates the EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL instance.
+   @param[in]      Lba           The starting logical block index to write to.
+   @param[in]      Offset        Offset into the block at which to begin writing.
+   @param[in, out] NumBytes      At entry, the size of the buffer. At exit, the number
+                                 of bytes written.
+   @param[in]      Buffer        Pointer to a caller-allocated buffer.
+
+   @return Status of the wrapped function.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FvbStatsWrapWrite (
+  IN CONST EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL  *This,
+  IN       EFI_LBA                              Lba,
+  IN       UINTN                                Offset,
+  IN OUT   UINTN                                *NumBytes,
+  IN       UINT8                                *Buffer
+  )
+{
+  FVB_STATS_CONTEXT  *Context;
+  EFI_STATUS         Status;
+  UINT64             StartTicks;
+
+  Context = FvbStatsFindContext (This);
+  ASSERT (Context != NULL);
+  if (Context == NULL) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  StartTicks = FvbStatsStart ();
+  Status     = Context->OriginalWrite (This, Lba, Offset, NumBytes, Buffer);
+  FvbStatsRecord (&Context->Stats.Call[FvbStatsWrite], StartTicks, Status, *NumBytes);
+
+  return Status;
+}
+
+/**
+   Passes a list of LBA ranges to the wrapped EraseBlocks().
+
+   @param[in]      Context       Statistics context of the wrapped instance.
+   @param[in]      This          Indicates the EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL instance.
+   @param[in]      Lba           Starting LBAs of the ranges.
+   @param[in]      NumLba        Number of blocks of the ranges.
+   @param[in]      NumRanges     Number of ranges, from 1 to FVB_STATS_MAX_ERASE_RANGES.
+
+   @return Status of the wrapped function.
+**/
+STATIC
+EFI_STATUS
+FvbStatsEraseRanges (
+  IN FVB_STATS_CONTEXT                          *Context,
+  IN CONST EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL  *This,
+  IN EFI_LBA                                    *Lba,
+  IN UINTN                                      *NumLba,
+  IN UINTN                                      NumRanges
+  )
+{
+  // A variable argument list can't be passed on as is, so spell it out
+  switch (NumRanges) {
+    case 1:
+      return Context->OriginalEraseBlocks (
+                        This,
+                        Lba[0], NumLba[0],
+                        EFI_LBA_LIST_TERMINATOR
+                        );
+    case 2:
+      return Context->OriginalEraseBlocks (
+                        This,
+                        Lba[0], NumLba[0],
+                        Lba[1], NumLba[1],
+                        EFI_LBA_LIST_TERMINATOR
+                        );
+    case 3:
+      return Context->OriginalEraseBlocks (
+                        This,
+                        Lba[0], NumLba[0],
+                        Lba[1], NumLba[1],
+                        Lba[2], NumLba[2],
+                        EFI_LBA_LIST_TERMINATOR
+                        );
+    default:
+      ASSERT (NumRanges == FVB_STATS_MAX_ERASE_RANGES);
+      return Context->OriginalEraseBlocks (
+                        This,
+                        Lba[0], NumLba[0],
+                        Lba[1], NumLba[1],
+                        Lba[2], NumLba[2],
+                        Lba[3], NumLba[3],
+                        EFI_LBA_LIST_TERMINATOR
+                        );
+  }
+}
+
+/**
+   Timed wrapper of EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL.EraseBlocks().
+
+   Lists of more than FVB_STATS_MAX_ERASE_RANGES ranges are passed on in
+   several calls, each of which is recorded.
+
+   @param[in]      This          Indicates the EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL instance.
+   @param[in]      ...           List of LBA ranges, terminated by EFI_LBA_LIST_TERMINATOR.
+
+   @return Status of the wrapped function.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FvbStatsWrapEraseBlocks (
+  IN CONST EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL  *This,
+  ...
+  )
+{
+  FVB_STATS_CONTEXT  *Context;
+  EFI_STATUS         Status;
+  VA_LIST            Args;
+  EFI_LBA            Lba[FVB_STATS_MAX_ERASE_RANGES];
+  UINTN              NumLba[FVB_STATS_MAX_ERASE_RANGES];
+  UINTN              NumRanges;
+  UINTN              BlockSize;
+  UINTN              NumBlocks;
+  UINT64             Bytes;
+  UINT64             StartTicks;
+  BOOLEAN            Done;
+
+  Context = FvbStatsFindContext (This);
+  ASSERT (Context != NULL);
+  if (Context == NULL) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = EFI_SUCCESS;
+  Done   = FALSE;
+
+  VA_START (Args, This);
+
+  while (!Done && !EFI_ERROR (Status)) {
+    Bytes = 0;
+    for (NumRanges = 0; NumRanges < FVB_STATS_MAX_ERASE_RANGES; NumRanges++) {
+      Lba[NumRanges] = VA_ARG (Args, EFI_LBA);
+      if (Lba[NumRanges] == EFI_LBA_LIST_TERMINATOR) {
+        Done = TRUE;
+        break;
+      }
+
+      NumLba[NumRanges] = VA_ARG (Args, UINTN);
+
+      // Only for counting the bytes; the wrapped function checks the range
+      if (!EFI_ERROR (This->GetBlockSize (This, Lba[NumRanges], &BlockSize, &NumBlocks))) {
+        Bytes += MultU64x64 (BlockSize, NumLba[NumRanges]);
+      }
+    }
+
+    if (NumRanges == 0) {
+      break;
+    }
+
+    StartTicks = FvbStatsStart ();
+    Status     = FvbStatsEraseRanges (Context, This, Lba, NumLba, NumRanges);
+    FvbStatsRecord (&Context->Stats.Call[FvbStatsErase], StartTicks, Status, Bytes);
+  }
+
+  VA_END (Args);
+
+  return Status;
+}
+
+/**
+   Retrieves the FVB instance's statistics.
+
+   @param[in]      This          Pointer to the FVB_STATS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FvbStatsGetStatistics (
+  IN  FVB_STATS_PROTOCOL  *This,
+  OUT FVB_STATS           *Statistics
+  )
+{
+  FVB_STATS_CONTEXT  *Context;
+  EFI_TPL            OldTpl;
+
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Context = FVB_STATS_CONTEXT_FROM_PROTOCOL (This);
+
+  // FVB functions may be called up to TPL_NOTIFY; don't copy the counters
+  // half-updated
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  CopyMem (Statistics, &Context->Stats, sizeof (*Statistics));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Resets the FVB instance's statistics to zero.
+
+   @param[in]      This          Pointer to the FVB_STATS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FvbStatsResetStatistics (
+  IN FVB_STATS_PROTOCOL  *This
+  )
+{
+  FVB_STATS_CONTEXT  *Context;
+  EFI_TPL            OldTpl;
+
+  Context = FVB_STATS_CONTEXT_FROM_PROTOCOL (This);
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  ZeroMem (Context->Stats.Call, sizeof (Context->Stats.Call));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Wraps the Firmware Volume Block protocol instance of a handle, and
+   installs the FVB statistics protocol on the handle.
+
+   @param[in]      Handle        Handle the Firmware Volume Block protocol is installed on.
+   @param[out]     Context       Pointer to where the statistics context will be stored.
+
+   @retval EFI_SUCCESS           The instance was wrapped.
+   @retval EFI_ALREADY_STARTED   The handle already has the FVB statistics protocol.
+   @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+   @return Status of locating or installing the protocols.
+**/
+EFI_STATUS
+EFIAPI
+FvbStatsInstall (
+  IN  EFI_HANDLE         Handle,
+  OUT FVB_STATS_CONTEXT  **Context
+  )
+{
+  FVB_STATS_CONTEXT                    *NewContext;
+  EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL  *Fvb;
+  FVB_STATS_PROTOCOL                   *Protocol;
+  EFI_STATUS                           Status;
+  EFI_TPL                              OldTpl;
+
+  Status = gBS->HandleProtocol (Handle, &gFvbStatsProtocolGuid, (VOID **)&Protocol);
+
+  if (!EFI_ERROR (Status)) {
+    return EFI_ALREADY_STARTED;
+  }
+
+  Status = gBS->HandleProtocol (Handle, &gEfiFirmwareVolumeBlock2ProtocolGuid, (VOID **)&Fvb);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  NewContext = AllocateZeroPool (sizeof (*NewContext));
+
+  if (NewContext == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewContext->Signature                 = FVB_STATS_CONTEXT_SIGNATURE;
+  NewContext->Protocol.GetStatistics    = FvbStatsGetStatistics;
+  NewContext->Protocol.ResetStatistics  = FvbStatsResetStatistics;
+  NewContext->Fvb                       = Fvb;
+  NewContext->Stats.CounterFrequency    = mCounterFrequency;
+
+  Status = gBS->InstallMultipleProtocolInterfaces (
+                  &Handle,
+                  &gFvbStatsProtocolGuid,
+                  &NewContext->Protocol,
+                  NULL
+                  );
+
+  if (EFI_ERROR (Status)) {
+    FreePool (NewContext);
+    return Status;
+  }
+
+  // Don't let a call in a notification see the instance half-wrapped
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  NewContext->OriginalRead        = Fvb->Read;
+  NewContext->OriginalWrite       = Fvb->Write;
+  NewContext->OriginalEraseBlocks = Fvb->EraseBlocks;
+  InsertTailList (&mContexts, &NewContext->Link);
+  Fvb->Read        = FvbStatsWrapRead;
+  Fvb->Write       = FvbStatsWrapWrite;
+  Fvb->EraseBlocks = FvbStatsWrapEraseBlocks;
+  gBS->RestoreTPL (OldTpl);
+
+  *Context = NewContext;
+  return EFI_SUCCESS;
+}
+
+/**
+   Restores the wrapped Firmware Volume Block protocol instance, uninstalls
+   the FVB statistics protocol, and frees the statistics.
+
+   @param[in]      Handle        Handle passed to FvbStatsInstall().
+   @param[in]      Context       Statistics context, may be NULL.
+
+   @retval EFI_SUCCESS           The instance was restored.
+   @retval EFI_ACCESS_DENIED     The instance was wrapped again by someone else,
+                                 and can't be restored.
+   @return Status of uninstalling the protocol.
+**/
+EFI_STATUS
+EFIAPI
+FvbStatsUninstall (
+  IN EFI_HANDLE         Handle,
+  IN FVB_STATS_CONTEXT  *Context OPTIONAL
+  )
+{
+  EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL  *Fvb;
+  EFI_STATUS                           Status;
+  EFI_TPL                              OldTpl;
+
+  if (Context == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  Fvb = Context->Fvb;
+
+  // Restoring the original functions would drop whoever wrapped them after
+  // us; keep forwarding to them instead
+  if ((Fvb->Read != FvbStatsWrapRead) ||
+      (Fvb->Write != FvbStatsWrapWrite) ||
+      (Fvb->EraseBlocks != FvbStatsWrapEraseBlocks))
+  {
+    DEBUG ((DEBUG_WARN, "%a: FVB instance was wrapped again, can't restore it\n", __func__));
+    return EFI_ACCESS_DENIED;
+  }
+
+  Status = gBS->UninstallMultipleProtocolInterfaces (
+                  Handle,
+                  &gFvbStatsProtocolGuid,
+                  &Context->Protocol,
+                  NULL
+                  );
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: failed to uninstall the protocol: %r\n", __func__, Status));
+    return Status;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  Fvb->Read        = Context->OriginalRead;
+  Fvb->Write       = Context->OriginalWrite;
+  Fvb->EraseBlocks = Context->OriginalEraseBlocks;
+  RemoveEntryList (&Context->Link);
+  gBS->RestoreTPL (OldTpl);
+
+  FreePool (Context);
+  return EFI_SUCCESS;
+}
+
+/**
+   Constructor of the library; reads the properties of the performance
+   counter once, since some timer libraries calibrate it on every query.
+
+   @param[in]      ImageHandle   The firmware allocated handle for the image.
+   @param[in]      SystemTable   A pointer to the EFI System Table.
+
+   @retval EFI_SUCCESS           The constructor always succeeds.
+**/
+EFI_STATUS
+EFIAPI
+FvbStatsLibConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  UINT64  CounterStart;
+  UINT64  CounterEnd;
+
+  mCounterFrequency = GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  mCountsDown       = CounterStart > CounterEnd;
+
+  return EFI_SUCCESS;
+}
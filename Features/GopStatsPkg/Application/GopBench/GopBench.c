@@ -0,0 +1,681 @@
+/** @file
+  GopBench - benchmarks the BLTs of Graphics Output Protocol drivers
+
+  Lists the handles with the Graphics Output Protocol, their modes, and the
+  BLT statistics recorded by the drivers that use GopStatsLib, or runs a set
+  of BLT patterns on one of them at each of its modes and reports, for each
+  pattern, how many calls it made, their average and maximum latency, and
+  the pixel rate. The patterns are:
+   - fill: full screen EfiBltVideoFill, i.e. clearing the screen,
+   - to-video: full screen EfiBltBufferToVideo, i.e. drawing a frame,
+   - to-buffer: full screen EfiBltVideoToBltBuffer, i.e. a screenshot,
+   - scroll: EfiBltVideoToVideo of all but one line of text, one line up,
+     i.e. scrolling the console,
+   - glyph: EfiBltBufferToVideo of a line of 8x19 character cells, one call
+     per cell, i.e. printing to the console.
+  The average latency of the full screen patterns is their frame time.
+
+  Usage: GopBench [-d Device [-m Mode] [-n Iterations]] [-r]
+    Without -d, lists the graphics devices, and the statistics of their
+    drivers.
+    -d sets the index of the device to benchmark, as listed. The screen is
+       overwritten, and the original mode restored at the end.
+    -m only benchmarks that mode, instead of every mode.
+    -n sets the number of iterations of each pattern (default: 16).
+    -r resets the statistics of the drivers after listing them.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Protocol/DevicePath.h>
+#include <Protocol/GopStats.h>
+#include <Protocol/GraphicsOutput.h>
+
+#include <Library/BaseLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/ShellCEntryLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+#define BENCH_DEFAULT_ITERATIONS  16
+#define BENCH_MAX_ITERATIONS      SIZE_64KB
+
+// Size of a character cell, as drawn by the graphics console
+#define BENCH_GLYPH_WIDTH   8
+#define BENCH_GLYPH_HEIGHT  19
+
+typedef enum {
+  BenchFill,
+  BenchBufferToVideo,
+  BenchVideoToBuffer,
+  BenchScroll,
+  BenchGlyph,
+  BenchPatternMax
+} BENCH_PATTERN;
+
+STATIC CONST CHAR16  *mPatternNames[BenchPatternMax] = {
+  L"fill",
+  L"to-video",
+  L"to-buffer",
+  L"scroll",
+  L"glyph"
+};
+
+STATIC CONST CHAR16  *mOperationNames[EfiGraphicsOutputBltOperationMax] = {
+  L"VideoFill",
+  L"VideoToBltBuffer",
+  L"BufferToVideo",
+  L"VideoToVideo"
+};
+
+typedef struct {
+  UINT64        Calls;
+  UINT64        Errors;
+  UINT64        Pixels;
+  // Sum and maximum of the calls' latencies, in nanoseconds
+  UINT64        TotalNs;
+  UINT64        MaxNs;
+  EFI_STATUS    LastError;
+} BENCH_RESULT;
+
+typedef struct {
+  // Mode number, and its resolution
+  UINT32          Mode;
+  UINT32          Width;
+  UINT32          Height;
+  // EFI_SUCCESS, or why the mode couldn't be benchmarked
+  EFI_STATUS      Status;
+  BENCH_RESULT    Result[BenchPatternMax];
+} BENCH_MODE_RESULT;
+
+STATIC BOOLEAN  mCounterCountsDown;
+
+/**
+   Returns the time elapsed between two readings of the performance counter.
+
+   @param[in]      StartTicks    First reading.
+   @param[in]      EndTicks      Second reading.
+
+   @return Nanoseconds.
+**/
+STATIC
+UINT64
+ElapsedNs (
+  IN UINT64  StartTicks,
+  IN UINT64  EndTicks
+  )
+{
+  return GetTimeInNanoSecond (mCounterCountsDown ? StartTicks - EndTicks : EndTicks - StartTicks);
+}
+
+/**
+   Converts performance counter ticks of a driver's statistics to
+   nanoseconds.
+
+   @param[in]      Ticks         Number of ticks.
+   @param[in]      Frequency     Frequency of the performance counter, in Hz.
+
+   @return Nanoseconds.
+**/
+STATIC
+UINT64
+TicksToNs (
+  IN UINT64  Ticks,
+  IN UINT64  Frequency
+  )
+{
+  UINT64  Seconds;
+  UINT64  Remainder;
+
+  if (Frequency == 0) {
+    return 0;
+  }
+
+  // Split the conversion so that it doesn't overflow for large tick counts
+  Seconds = DivU64x64Remainder (Ticks, Frequency, &Remainder);
+  return MultU64x32 (Seconds, 1000000000) +
+         DivU64x64Remainder (MultU64x32 (Remainder, 1000000000), Frequency, NULL);
+}
+
+/**
+   Runs Blt() once, and accounts for the call in a result.
+
+   @param[in]      Gop           Graphics Output Protocol instance.
+   @param[in out]  Result        Result of the pattern the call belongs to.
+   @param[in]      BltBuffer     Blt() parameters.
+   @param[in]      BltOperation
+   @param[in]      SourceX
+   @param[in]      SourceY
+   @param[in]      DestinationX
+   @param[in]      DestinationY
+   @param[in]      Width
+   @param[in]      Height
+   @param[in]      Delta
+**/
+STATIC
+VOID
+TimedBlt (
+  IN     EFI_GRAPHICS_OUTPUT_PROTOCOL       *Gop,
+  IN OUT BENCH_RESULT                       *Result,
+  IN     EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *BltBuffer,
+  IN     EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN     UINTN                              SourceX,
+  IN     UINTN                              SourceY,
+  IN     UINTN                              DestinationX,
+  IN     UINTN                              DestinationY,
+  IN     UINTN                              Width,
+  IN     UINTN                              Height,
+  IN     UINTN                              Delta
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      StartTicks;
+  UINT64      Ns;
+
+  StartTicks = GetPerformanceCounter ();
+  Status     = Gop->Blt (
+                      Gop,
+                      BltBuffer,
+                      BltOperation,
+                      SourceX,
+                      SourceY,
+                      DestinationX,
+                      DestinationY,
+                      Width,
+                      Height,
+                      Delta
+                      );
+  Ns = ElapsedNs (StartTicks, GetPerformanceCounter ());
+
+  Result->Calls++;
+  Result->TotalNs += Ns;
+  Result->MaxNs    = MAX (Result->MaxNs, Ns);
+
+  if (EFI_ERROR (Status)) {
+    Result->Errors++;
+    Result->LastError = Status;
+  } else {
+    Result->Pixels += MultU64x64 (Width, Height);
+  }
+}
+
+/**
+   Runs every pattern at the current mode.
+
+   @param[in]      Gop           Graphics Output Protocol instance.
+   @param[in]      Iterations    Number of iterations of each pattern.
+   @param[out]     ModeResult    Results of the mode.
+**/
+STATIC
+VOID
+BenchmarkMode (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL  *Gop,
+  IN  UINTN                         Iterations,
+  OUT BENCH_MODE_RESULT             *ModeResult
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Buffer;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Color;
+  UINTN                          Width;
+  UINTN                          Height;
+  UINTN                          Delta;
+  UINTN                          Iteration;
+  UINTN                          X;
+  UINTN                          Y;
+
+  Width  = ModeResult->Width;
+  Height = ModeResult->Height;
+  Delta  = Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+
+  if (Height <= BENCH_GLYPH_HEIGHT) {
+    ModeResult->Status = EFI_UNSUPPORTED;
+    return;
+  }
+
+  Buffer = AllocatePool (Delta * Height);
+
+  if (Buffer == NULL) {
+    ModeResult->Status = EFI_OUT_OF_RESOURCES;
+    return;
+  }
+
+  // A gradient, so that drivers that compress or skip unchanged pixels
+  // don't have it too easy
+  for (Y = 0; Y < Height; Y++) {
+    for (X = 0; X < Width; X++) {
+      Buffer[Y * Width + X].Blue     = (UINT8)X;
+      Buffer[Y * Width + X].Green    = (UINT8)Y;
+      Buffer[Y * Width + X].Red      = (UINT8)(X + Y);
+      Buffer[Y * Width + X].Reserved = 0;
+    }
+  }
+
+  for (Iteration = 0; Iteration < Iterations; Iteration++) {
+    Color.Blue     = (UINT8)(Iteration * 0x35);
+    Color.Green    = (UINT8)(Iteration * 0x59);
+    Color.Red      = (UINT8)(Iteration * 0x7B);
+    Color.Reserved = 0;
+    TimedBlt (Gop, &ModeResult->Result[BenchFill], &Color, EfiBltVideoFill, 0, 0, 0, 0, Width, Height, 0);
+  }
+
+  for (Iteration = 0; Iteration < Iterations; Iteration++) {
+    TimedBlt (Gop, &ModeResult->Result[BenchBufferToVideo], Buffer, EfiBltBufferToVideo, 0, 0, 0, 0, Width, Height, Delta);
+  }
+
+  for (Iteration = 0; Iteration < Iterations; Iteration++) {
+    TimedBlt (Gop, &ModeResult->Result[BenchVideoToBuffer], Buffer, EfiBltVideoToBltBuffer, 0, 0, 0, 0, Width, Height, Delta);
+  }
+
+  for (Iteration = 0; Iteration < Iterations; Iteration++) {
+    TimedBlt (
+      Gop,
+      &ModeResult->Result[BenchScroll],
+      NULL,
+      EfiBltVideoToVideo,
+      0,
+      BENCH_GLYPH_HEIGHT,
+      0,
+      0,
+      Width,
+      Height - BENCH_GLYPH_HEIGHT,
+      0
+      );
+  }
+
+  for (Iteration = 0; Iteration < Iterations; Iteration++) {
+    Y = (Iteration % (Height / BENCH_GLYPH_HEIGHT)) * BENCH_GLYPH_HEIGHT;
+
+    for (X = 0; X + BENCH_GLYPH_WIDTH <= Width; X += BENCH_GLYPH_WIDTH) {
+      TimedBlt (
+        Gop,
+        &ModeResult->Result[BenchGlyph],
+        Buffer,
+        EfiBltBufferToVideo,
+        X,
+        Y,
+        X,
+        Y,
+        BENCH_GLYPH_WIDTH,
+        BENCH_GLYPH_HEIGHT,
+        Delta
+        );
+    }
+  }
+
+  FreePool (Buffer);
+  ModeResult->Status = EFI_SUCCESS;
+}
+
+/**
+   Prints the results of a mode.
+
+   @param[in]      ModeResult    Results of the mode.
+**/
+STATIC
+VOID
+PrintModeResult (
+  IN CONST BENCH_MODE_RESULT  *ModeResult
+  )
+{
+  CONST BENCH_RESULT  *Result;
+  UINTN               Pattern;
+
+  Print (L"Mode %u: %u x %u\n", ModeResult->Mode, ModeResult->Width, ModeResult->Height);
+
+  if (EFI_ERROR (ModeResult->Status)) {
+    Print (L"  not benchmarked: %r\n", ModeResult->Status);
+    return;
+  }
+
+  for (Pattern = 0; Pattern < BenchPatternMax; Pattern++) {
+    Result = &ModeResult->Result[Pattern];
+
+    if (Result->Calls == 0) {
+      continue;
+    }
+
+    Print (
+      L"  %-9s %7lu calls %10lu ns avg %10lu ns max %6lu Mpixel/s",
+      mPatternNames[Pattern],
+      Result->Calls,
+      DivU64x64Remainder (Result->TotalNs, Result->Calls, NULL),
+      Result->MaxNs,
+      Result->TotalNs == 0 ? 0 : DivU64x64Remainder (MultU64x32 (Result->Pixels, 1000), Result->TotalNs, NULL)
+      );
+
+    if (Result->Errors != 0) {
+      Print (L" %lu errors (%r)", Result->Errors, Result->LastError);
+    }
+
+    Print (L"\n");
+  }
+}
+
+/**
+   Prints the statistics a driver recorded for one BLT operation.
+
+   @param[in]      Name          Name of the operation.
+   @param[in]      Data          Pointer to the operation's statistics.
+   @param[in]      Frequency     Frequency of the performance counter, in Hz.
+**/
+STATIC
+VOID
+PrintOperation (
+  IN CONST CHAR16                    *Name,
+  IN CONST GOP_STATS_OPERATION_DATA  *Data,
+  IN UINT64                          Frequency
+  )
+{
+  UINTN  Bucket;
+
+  Print (
+    L"  %-16s %10lu calls %6lu errors %14lu pixels\n",
+    Name,
+    Data->Calls,
+    Data->Errors,
+    Data->Pixels
+    );
+
+  if (Data->Calls == 0) {
+    return;
+  }
+
+  Print (
+    L"                   %10lu ns avg %10lu ns max\n",
+    TicksToNs (DivU64x64Remainder (Data->TotalTicks, Data->Calls, NULL), Frequency),
+    TicksToNs (Data->MaxTicks, Frequency)
+    );
+
+  for (Bucket = 0; Bucket < GOP_STATS_HISTOGRAM_BUCKETS; Bucket++) {
+    if (Data->Histogram[Bucket] == 0) {
+      continue;
+    }
+
+    Print (
+      L"                   < %10lu ns: %10lu\n",
+      TicksToNs (LShiftU64 (2, Bucket), Frequency),
+      Data->Histogram[Bucket]
+      );
+  }
+}
+
+/**
+   Lists the graphics devices, their modes, and the statistics of their
+   drivers.
+
+   @param[in]      Handles       Handles with the Graphics Output Protocol.
+   @param[in]      NumberHandles Number of handles.
+   @param[in]      Reset         Set to TRUE to reset the statistics.
+**/
+STATIC
+VOID
+ListDevices (
+  IN EFI_HANDLE  *Handles,
+  IN UINTN       NumberHandles,
+  IN BOOLEAN     Reset
+  )
+{
+  EFI_GRAPHICS_OUTPUT_PROTOCOL          *Gop;
+  EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  *Info;
+  GOP_STATS_PROTOCOL                    *Protocol;
+  GOP_STATS                             *Stats;
+  EFI_DEVICE_PATH_PROTOCOL              *DevicePath;
+  CHAR16                                *DevicePathText;
+  UINTN                                 Index;
+  UINTN                                 SizeOfInfo;
+  UINT32                                Mode;
+  UINTN                                 Operation;
+  EFI_STATUS                            Status;
+
+  // GOP_STATS is too large to comfortably live on the stack
+  Stats = AllocatePool (sizeof (*Stats));
+
+  for (Index = 0; Index < NumberHandles; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiGraphicsOutputProtocolGuid, (VOID **)&Gop);
+
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiDevicePathProtocolGuid, (VOID **)&DevicePath);
+
+    DevicePathText = EFI_ERROR (Status) ? NULL : ConvertDevicePathToText (DevicePath, TRUE, TRUE);
+    Print (L"%u: %s\n", Index, DevicePathText != NULL ? DevicePathText : L"(no device path)");
+
+    if (DevicePathText != NULL) {
+      FreePool (DevicePathText);
+    }
+
+    for (Mode = 0; Mode < Gop->Mode->MaxMode; Mode++) {
+      Status = Gop->QueryMode (Gop, Mode, &SizeOfInfo, &Info);
+
+      if (EFI_ERROR (Status)) {
+        Print (L"   mode %u: %r\n", Mode, Status);
+        continue;
+      }
+
+      Print (
+        L"   mode %u: %u x %u%s\n",
+        Mode,
+        Info->HorizontalResolution,
+        Info->VerticalResolution,
+        Mode == Gop->Mode->Mode ? L" (current)" : L""
+        );
+      FreePool (Info);
+    }
+
+    Status = gBS->HandleProtocol (Handles[Index], &gGopStatsProtocolGuid, (VOID **)&Protocol);
+
+    if (EFI_ERROR (Status) || (Stats == NULL)) {
+      continue;
+    }
+
+    Status = Protocol->GetStatistics (Protocol, Stats);
+
+    if (EFI_ERROR (Status)) {
+      Print (L"   failed to get statistics: %r\n", Status);
+      continue;
+    }
+
+    for (Operation = 0; Operation < EfiGraphicsOutputBltOperationMax; Operation++) {
+      PrintOperation (mOperationNames[Operation], &Stats->Operation[Operation], Stats->CounterFrequency);
+    }
+
+    if (Reset) {
+      Protocol->ResetStatistics (Protocol);
+    }
+  }
+
+  if (Stats != NULL) {
+    FreePool (Stats);
+  }
+}
+
+/**
+   Parses the value of a numeric command line option.
+
+   @param[in]      Argc          The number of items in Argv.
+   @param[in]      Argv          Array of pointers to the arguments.
+   @param[in out]  Index         On input, the index of the option. On output,
+                                 the index of its value.
+   @param[out]     Value         The value of the option.
+
+   @retval TRUE                  The value is valid.
+   @retval FALSE                 The value is missing, or isn't a number.
+**/
+STATIC
+BOOLEAN
+GetOptionValue (
+  IN     UINTN   Argc,
+  IN     CHAR16  **Argv,
+  IN OUT UINTN   *Index,
+  OUT    UINT64  *Value
+  )
+{
+  if (*Index + 1 >= Argc) {
+    return FALSE;
+  }
+
+  (*Index)++;
+  return !EFI_ERROR (StrDecimalToUint64S (Argv[*Index], NULL, Value));
+}
+
+/**
+   The main entry point of the application.
+
+   @param[in] Argc             The number of items in Argv.
+   @param[in] Argv             Array of pointers to the arguments.
+
+   @retval 0                   The devices were listed or benchmarked.
+   @retval Other               An error occurred.
+**/
+INTN
+EFIAPI
+ShellAppMain (
+  IN UINTN   Argc,
+  IN CHAR16  **Argv
+  )
+{
+  EFI_STATUS                            Status;
+  EFI_HANDLE                            *Handles;
+  EFI_GRAPHICS_OUTPUT_PROTOCOL          *Gop;
+  EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  *Info;
+  BENCH_MODE_RESULT                     *ModeResults;
+  UINTN                                 NumberHandles;
+  UINTN                                 NumberModes;
+  UINTN                                 Index;
+  UINTN                                 SizeOfInfo;
+  UINT64                                DeviceIndex;
+  UINT64                                OnlyMode;
+  UINT64                                Iterations;
+  UINT64                                CounterStart;
+  UINT64                                CounterEnd;
+  UINT32                                OriginalMode;
+  UINT32                                Mode;
+  BOOLEAN                               Reset;
+  BOOLEAN                               Valid;
+
+  DeviceIndex = MAX_UINT64;
+  OnlyMode    = MAX_UINT64;
+  Iterations  = BENCH_DEFAULT_ITERATIONS;
+  Reset       = FALSE;
+  Valid       = TRUE;
+
+  for (Index = 1; Index < Argc && Valid; Index++) {
+    if (StrCmp (Argv[Index], L"-r") == 0) {
+      Reset = TRUE;
+    } else if (StrCmp (Argv[Index], L"-d") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &DeviceIndex);
+    } else if (StrCmp (Argv[Index], L"-m") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &OnlyMode);
+    } else if (StrCmp (Argv[Index], L"-n") == 0) {
+      Valid = GetOptionValue (Argc, Argv, &Index, &Iterations) && (Iterations != 0) &&
+              (Iterations <= BENCH_MAX_ITERATIONS);
+    } else {
+      Valid = FALSE;
+    }
+  }
+
+  if (!Valid || (Reset && (DeviceIndex != MAX_UINT64))) {
+    Print (L"Usage: %s [-d Device [-m Mode] [-n Iterations]] [-r]\n", Argv[0]);
+    return 1;
+  }
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiGraphicsOutputProtocolGuid,
+                  NULL,
+                  &NumberHandles,
+                  &Handles
+                  );
+
+  if (EFI_ERROR (Status)) {
+    Print (L"No graphics devices found: %r\n", Status);
+    return 1;
+  }
+
+  if (DeviceIndex == MAX_UINT64) {
+    ListDevices (Handles, NumberHandles, Reset);
+    FreePool (Handles);
+    return 0;
+  }
+
+  if (DeviceIndex >= NumberHandles) {
+    Print (L"Device %lu doesn't exist (%u graphics devices found)\n", DeviceIndex, NumberHandles);
+    FreePool (Handles);
+    return 1;
+  }
+
+  Status = gBS->HandleProtocol (Handles[DeviceIndex], &gEfiGraphicsOutputProtocolGuid, (VOID **)&Gop);
+  FreePool (Handles);
+
+  if (EFI_ERROR (Status)) {
+    Print (L"Failed to open device %lu: %r\n", DeviceIndex, Status);
+    return 1;
+  }
+
+  if ((OnlyMode != MAX_UINT64) && (OnlyMode >= Gop->Mode->MaxMode)) {
+    Print (L"Mode %lu doesn't exist (%u modes)\n", OnlyMode, Gop->Mode->MaxMode);
+    return 1;
+  }
+
+  ModeResults = AllocateZeroPool (Gop->Mode->MaxMode * sizeof (*ModeResults));
+
+  if (ModeResults == NULL) {
+    return 1;
+  }
+
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  mCounterCountsDown = CounterStart > CounterEnd;
+
+  //
+  // The results are only printed once the original mode is back, as the
+  // console may not be readable, or even shown, in the other modes.
+  //
+  OriginalMode = Gop->Mode->Mode;
+  NumberModes  = 0;
+
+  for (Mode = 0; Mode < Gop->Mode->MaxMode; Mode++) {
+    if ((OnlyMode != MAX_UINT64) && (Mode != OnlyMode)) {
+      continue;
+    }
+
+    Status = Gop->QueryMode (Gop, Mode, &SizeOfInfo, &Info);
+
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    ModeResults[NumberModes].Mode   = Mode;
+    ModeResults[NumberModes].Width  = Info->HorizontalResolution;
+    ModeResults[NumberModes].Height = Info->VerticalResolution;
+    FreePool (Info);
+
+    Status = Gop->SetMode (Gop, Mode);
+
+    if (EFI_ERROR (Status)) {
+      ModeResults[NumberModes].Status = Status;
+    } else {
+      BenchmarkMode (Gop, (UINTN)Iterations, &ModeResults[NumberModes]);
+    }
+
+    NumberModes++;
+  }
+
+  Status = Gop->SetMode (Gop, OriginalMode);
+
+  if (EFI_ERROR (Status)) {
+    Print (L"Failed to restore mode %u: %r\n", OriginalMode, Status);
+  }
+
+  for (Index = 0; Index < NumberModes; Index++) {
+    PrintModeResult (&ModeResults[Index]);
+  }
+
+  FreePool (ModeResults);
+  return 0;
+}
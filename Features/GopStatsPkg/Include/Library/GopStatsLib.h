@@ -0,0 +1,86 @@
+/** @file
+  GOP statistics library
+
+  Counts the Blt() calls of a Graphics Output Protocol driver, per operation,
+  the pixels they moved, and how long each call took. Recording a call costs
+  two reads of the performance counter and a few additions, so it can stay
+  enabled on every BLT.
+
+  The counters are published through the GOP statistics protocol.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef GOP_STATS_LIB_H_
+#define GOP_STATS_LIB_H_
+
+#include <Protocol/GraphicsOutput.h>
+#include <Protocol/GopStats.h>
+
+typedef struct _GOP_STATS_CONTEXT GOP_STATS_CONTEXT;
+
+/**
+   Creates the statistics of a Graphics Output Protocol instance, and
+   installs the GOP statistics protocol on its handle.
+
+   @param[in]      Handle        Handle the Graphics Output Protocol is installed on.
+   @param[out]     Context       Pointer to where the statistics context will be stored.
+
+   @retval EFI_SUCCESS           The statistics were created.
+   @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+   @return Status of installing the protocol.
+**/
+EFI_STATUS
+EFIAPI
+GopStatsInstall (
+  IN  EFI_HANDLE         Handle,
+  OUT GOP_STATS_CONTEXT  **Context
+  );
+
+/**
+   Uninstalls the GOP statistics protocol, and frees the statistics.
+
+   @param[in]      Handle        Handle passed to GopStatsInstall().
+   @param[in]      Context       Statistics context, may be NULL.
+**/
+VOID
+EFIAPI
+GopStatsUninstall (
+  IN EFI_HANDLE         Handle,
+  IN GOP_STATS_CONTEXT  *Context OPTIONAL
+  );
+
+/**
+   Starts timing a call.
+
+   @return Performance counter value, to pass to GopStatsRecord().
+**/
+UINT64
+EFIAPI
+GopStatsStart (
+  VOID
+  );
+
+/**
+   Records a Blt() call.
+
+   @param[in]      Context       Statistics context, may be NULL.
+   @param[in]      BltOperation  The operation that was requested. Calls with
+                                 an invalid operation aren't recorded.
+   @param[in]      StartTicks    Value returned by GopStatsStart() when the call started.
+   @param[in]      Status        Status returned by the call.
+   @param[in]      Width         Width of the rectangle, in pixels.
+   @param[in]      Height        Height of the rectangle, in pixels.
+**/
+VOID
+EFIAPI
+GopStatsRecord (
+  IN GOP_STATS_CONTEXT                  *Context OPTIONAL,
+  IN EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN UINT64                             StartTicks,
+  IN EFI_STATUS                         Status,
+  IN UINTN                              Width,
+  IN UINTN                              Height
+  );
+
+#endif
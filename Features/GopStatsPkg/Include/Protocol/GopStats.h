@@ -0,0 +1,86 @@
+/** @file
+  GOP statistics protocol
+
+  Installed by Graphics Output Protocol drivers that use GopStatsLib, on the
+  handle that carries their Graphics Output Protocol instance. Lets tools
+  (like GopBench) see how often the driver's Blt() function is called for
+  each operation, how many pixels it moved, and how long it took.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef GOP_STATS_PROTOCOL_H_
+#define GOP_STATS_PROTOCOL_H_
+
+#include <Protocol/GraphicsOutput.h>
+
+#define GOP_STATS_PROTOCOL_GUID \
+  { 0x5733b166, 0x8222, 0x499d, { 0x95, 0xeb, 0x8c, 0x26, 0xba, 0x8e, 0xcc, 0xed } }
+
+//
+// Number of buckets of each latency histogram. Bucket N counts the calls
+// that took [2^N, 2^(N+1)) performance counter ticks; bucket 0 also counts
+// the calls that took less than a tick.
+//
+#define GOP_STATS_HISTOGRAM_BUCKETS  64
+
+typedef struct _GOP_STATS_PROTOCOL GOP_STATS_PROTOCOL;
+
+typedef struct {
+  // Number of calls
+  UINT64    Calls;
+  // Calls that failed
+  UINT64    Errors;
+  // Pixels filled or copied by the successful calls
+  UINT64    Pixels;
+  // Sum and maximum of the calls' durations, in performance counter ticks
+  UINT64    TotalTicks;
+  UINT64    MaxTicks;
+  UINT64    Histogram[GOP_STATS_HISTOGRAM_BUCKETS];
+} GOP_STATS_OPERATION_DATA;
+
+typedef struct {
+  // Frequency of the performance counter the durations are measured with,
+  // in Hz
+  UINT64                      CounterFrequency;
+  // Indexed by EFI_GRAPHICS_OUTPUT_BLT_OPERATION
+  GOP_STATS_OPERATION_DATA    Operation[EfiGraphicsOutputBltOperationMax];
+} GOP_STATS;
+
+/**
+   Retrieves the driver's statistics.
+
+   @param[in]      This          Pointer to the GOP_STATS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *GOP_STATS_GET)(
+  IN  GOP_STATS_PROTOCOL  *This,
+  OUT GOP_STATS           *Statistics
+  );
+
+/**
+   Resets the driver's statistics to zero.
+
+   @param[in]      This          Pointer to the GOP_STATS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *GOP_STATS_RESET)(
+  IN GOP_STATS_PROTOCOL  *This
+  );
+
+struct _GOP_STATS_PROTOCOL {
+  GOP_STATS_GET      GetStatistics;
+  GOP_STATS_RESET    ResetStatistics;
+};
+
+extern EFI_GUID  gGopStatsProtocolGuid;
+
+#endif
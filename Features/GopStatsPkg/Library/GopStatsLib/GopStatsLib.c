@@ -0,0 +1,246 @@
+/** @file
+  GOP statistics library
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/GopStatsLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#define GOP_STATS_CONTEXT_SIGNATURE  SIGNATURE_32 ('G', 'O', 'P', 'S')
+
+struct _GOP_STATS_CONTEXT {
+  UINT32                Signature;
+  GOP_STATS_PROTOCOL    Protocol;
+  // TRUE if the performance counter counts down
+  BOOLEAN               CountsDown;
+  GOP_STATS             Stats;
+};
+
+#define GOP_STATS_CONTEXT_FROM_PROTOCOL(This) \
+  CR (This, GOP_STATS_CONTEXT, Protocol, GOP_STATS_CONTEXT_SIGNATURE)
+
+/**
+   Retrieves the driver's statistics.
+
+   @param[in]      This          Pointer to the GOP_STATS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+GopStatsGetStatistics (
+  IN  GOP_STATS_PROTOCOL  *This,
+  OUT GOP_STATS           *Statistics
+  )
+{
+  GOP_STATS_CONTEXT  *Context;
+  EFI_TPL            OldTpl;
+
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Context = GOP_STATS_CONTEXT_FROM_PROTOCOL (This);
+
+  // The counters are updated at TPL_NOTIFY; don't copy them half-updated
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  CopyMem (Statistics, &Context->Stats, sizeof (*Statistics));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Resets the driver's statistics to zero.
+
+   @param[in]      This          Pointer to the GOP_STATS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+GopStatsResetStatistics (
+  IN GOP_STATS_PROTOCOL  *This
+  )
+{
+  GOP_STATS_CONTEXT  *Context;
+  EFI_TPL            OldTpl;
+
+  Context = GOP_STATS_CONTEXT_FROM_PROTOCOL (This);
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  ZeroMem (Context->Stats.Operation, sizeof (Context->Stats.Operation));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Creates the statistics of a Graphics Output Protocol instance, and
+   installs the GOP statistics protocol on its handle.
+
+   @param[in]      Handle        Handle the Graphics Output Protocol is installed on.
+   @param[out]     Context       Pointer to where the statistics context will be stored.
+
+   @retval EFI_SUCCESS           The statistics were created.
+   @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+   @return Status of installing the protocol.
+**/
+EFI_STATUS
+EFIAPI
+GopStatsInstall (
+  IN  EFI_HANDLE         Handle,
+  OUT GOP_STATS_CONTEXT  **Context
+  )
+{
+  GOP_STATS_CONTEXT  *NewContext;
+  EFI_STATUS         Status;
+  UINT64             CounterStart;
+  UINT64             CounterEnd;
+
+  NewContext = AllocateZeroPool (sizeof (*NewContext));
+
+  if (NewContext == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewContext->Signature                 = GOP_STATS_CONTEXT_SIGNATURE;
+  NewContext->Protocol.GetStatistics    = GopStatsGetStatistics;
+  NewContext->Protocol.ResetStatistics  = GopStatsResetStatistics;
+  NewContext->Stats.CounterFrequency    = GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  NewContext->CountsDown                = CounterStart > CounterEnd;
+
+  Status = gBS->InstallMultipleProtocolInterfaces (
+                  &Handle,
+                  &gGopStatsProtocolGuid,
+                  &NewContext->Protocol,
+                  NULL
+                  );
+
+  if (EFI_ERROR (Status)) {
+    FreePool (NewContext);
+    return Status;
+  }
+
+  *Context = NewContext;
+  return EFI_SUCCESS;
+}
+
+/**
+   Uninstalls the GOP statistics protocol, and frees the statistics.
+
+   @param[in]      Handle        Handle passed to GopStatsInstall().
+   @param[in]      Context       Statistics context, may be NULL.
+**/
+VOID
+EFIAPI
+GopStatsUninstall (
+  IN EFI_HANDLE         Handle,
+  IN GOP_STATS_CONTEXT  *Context OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+
+  if (Context == NULL) {
+    return;
+  }
+
+  Status = gBS->UninstallMultipleProtocolInterfaces (
+                  Handle,
+                  &gGopStatsProtocolGuid,
+                  &Context->Protocol,
+                  NULL
+                  );
+
+  // Someone still uses the statistics; leak them, rather than pull them out
+  // from under their feet
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: failed to uninstall the protocol: %r\n", __func__, Status));
+    return;
+  }
+
+  FreePool (Context);
+}
+
+/**
+   Starts timing a call.
+
+   @return Performance counter value, to pass to GopStatsRecord().
+**/
+UINT64
+EFIAPI
+GopStatsStart (
+  VOID
+  )
+{
+  return GetPerformanceCounter ();
+}
+
+/**
+   Records a Blt() call.
+
+   @param[in]      Context       Statistics context, may be NULL.
+   @param[in]      BltOperation  The operation that was requested. Calls with
+                                 an invalid operation aren't recorded.
+   @param[in]      StartTicks    Value returned by GopStatsStart() when the call started.
+   @param[in]      Status        Status returned by the call.
+   @param[in]      Width         Width of the rectangle, in pixels.
+   @param[in]      Height        Height of the rectangle, in pixels.
+**/
+VOID
+EFIAPI
+GopStatsRecord (
+  IN GOP_STATS_CONTEXT                  *Context OPTIONAL,
+  IN EFI_GRAPHICS_OUTPUT_BLT_OPERATION  BltOperation,
+  IN UINT64                             StartTicks,
+  IN EFI_STATUS                         Status,
+  IN UINTN                              Width,
+  IN UINTN                              Height
+  )
+{
+  GOP_STATS_OPERATION_DATA  *Data;
+  UINT64                    Now;
+  UINT64                    Ticks;
+  EFI_TPL                   OldTpl;
+
+  if ((Context == NULL) || ((UINTN)BltOperation >= EfiGraphicsOutputBltOperationMax)) {
+    return;
+  }
+
+  Now   = GetPerformanceCounter ();
+  Ticks = Context->CountsDown ? StartTicks - Now : Now - StartTicks;
+  Data  = &Context->Stats.Operation[BltOperation];
+
+  // Blt() may be called at up to TPL_NOTIFY, e.g. by a cursor timer, and
+  // interrupt a call that is being recorded
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  Data->Calls++;
+  Data->TotalTicks += Ticks;
+
+  if (Ticks > Data->MaxTicks) {
+    Data->MaxTicks = Ticks;
+  }
+
+  Data->Histogram[Ticks == 0 ? 0 : HighBitSet64 (Ticks)]++;
+
+  if (EFI_ERROR (Status)) {
+    Data->Errors++;
+  } else {
+    Data->Pixels += MultU64x64 (Width, Height);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
@@ -18,6 +18,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SmmBase2.h>
 #include <Protocol/SmmEndOfDxe.h>
 #include <Protocol/SmmSwDispatch2.h>
+#include <Protocol/SmmPeriodicTimerDispatch2.h>
 
 #define ACPI_DEBUG_STR      "INTEL ACPI DEBUG"
 
@@ -61,13 +62,15 @@ EFI_SMM_SYSTEM_TABLE2       *mSmst = NULL;
   @param[in] AcpiDebugAddress   Address of Acpi debug memory buffer.
   @param[in] BufferIndex        Index that starts after the Acpi Debug head.
   @param[in] BufferEnd          End of Acpi debug memory buffer.
+  @param[in] SmiThreshold       Pending bytes in the buffer that make ASL trigger the SMI.
 
 **/
 VOID
 PatchAndLoadAcpiTable (
   IN ACPI_DEBUG_HEAD            *AcpiDebugAddress,
   IN UINT32                     BufferIndex,
-  IN UINT32                     BufferEnd
+  IN UINT32                     BufferEnd,
+  IN UINT32                     SmiThreshold
   )
 {
   EFI_STATUS                    Status;
@@ -102,10 +105,10 @@ PatchAndLoadAcpiTable (
   //
 
   //
-  // Count pointer updates, so we can stop after all three pointers are patched.
+  // Count pointer updates, so we can stop after all four names are patched.
   //
   UpdateCounter = 1;
-  for (CurrPtr = (UINT8 *) TableHeader; CurrPtr <= ((UINT8 *) TableHeader + TableHeader->Length) && UpdateCounter < 4; CurrPtr++) {
+  for (CurrPtr = (UINT8 *) TableHeader; CurrPtr <= ((UINT8 *) TableHeader + TableHeader->Length) && UpdateCounter < 5; CurrPtr++) {
     Signature = (UINT32 *) (CurrPtr + 1);
     //
     // patch DPTR (address of Acpi debug memory buffer)
@@ -131,6 +134,14 @@ PatchAndLoadAcpiTable (
       NamePtr->Value  = BufferIndex;
       UpdateCounter++;
     }
+    //
+    // patch HWMK (pending bytes that trigger the SMI to print)
+    //
+    if ((*CurrPtr == AML_NAME_OP) && *Signature == SIGNATURE_32 ('H', 'W', 'M', 'K')) {
+      NamePtr = (NAME_LAYOUT *) CurrPtr;
+      NamePtr->Value  = SmiThreshold;
+      UpdateCounter++;
+    }
   }
 
   //
@@ -226,6 +237,7 @@ AcpiDebugEndOfDxeNotification (
 {
   UINT32        BufferSize;
   UINT32        BufferIndex;
+  UINT32        SmiThreshold;
 
   mAcpiDebug = (ACPI_DEBUG_HEAD *) (UINTN) AllocateAcpiDebugMemory (&BufferSize);
   if (mAcpiDebug != NULL) {
@@ -252,10 +264,17 @@ AcpiDebugEndOfDxeNotification (
     //
     BufferIndex += AD_SIZE;
 
+    //
+    // ASL only triggers the SMI once this many strings are pending, so the SMM handler prints
+    // them in a batch. Keep one string location free, so a full buffer is never seen as empty.
+    //
+    SmiThreshold = MAX (PcdGet32 (PcdAcpiDebugSmiThreshold), 1) * MAX_BUFFER_SIZE;
+    SmiThreshold = MIN (SmiThreshold, BufferSize - AD_SIZE - MAX_BUFFER_SIZE);
+
     //
     // Patch and Load the SSDT ACPI Tables.
     //
-    PatchAndLoadAcpiTable (mAcpiDebug, BufferIndex, mBufferEnd);
+    PatchAndLoadAcpiTable (mAcpiDebug, BufferIndex, mBufferEnd, SmiThreshold);
 
     mAcpiDebug->Head = BufferIndex;
     mAcpiDebug->Tail = BufferIndex;
@@ -333,85 +352,150 @@ AcpiDebugSmmCallback (
   )
 {
   UINT8             Buffer[MAX_BUFFER_SIZE];
+  UINT32            BufferStart;
+  UINT32            Head;
+  UINT32            Tail;
+
+  BufferStart = (UINT32) ((UINTN) mAcpiDebug + AD_SIZE);
 
   //
   // Validate the fields in mAcpiDebug to ensure there is no harm to SMI handler.
   // mAcpiDebug is below 4GB and the start address of whole buffer.
   //
+  Head = mAcpiDebug->Head;
+  Tail = mAcpiDebug->Tail;
   if ((mAcpiDebug->BufferSize != (mBufferEnd - (UINT32) (UINTN) mAcpiDebug)) ||
-      (mAcpiDebug->Head < (UINT32) ((UINTN) mAcpiDebug + AD_SIZE)) ||
-      (mAcpiDebug->Head > mBufferEnd) ||
-      (mAcpiDebug->Tail < (UINT32) ((UINTN) mAcpiDebug + AD_SIZE)) ||
-      (mAcpiDebug->Tail > mBufferEnd)) {
+      (Head < BufferStart) ||
+      (Head >= mBufferEnd) ||
+      (Tail < BufferStart) ||
+      (Tail >= mBufferEnd) ||
+      (((Head - BufferStart) % MAX_BUFFER_SIZE) != 0) ||
+      (((Tail - BufferStart) % MAX_BUFFER_SIZE) != 0)) {
     //
     // If some fields in mAcpiDebug are invaid, return directly.
     //
     return EFI_SUCCESS;
   }
 
-  if (!(BOOLEAN)mAcpiDebug->Wrap && ((mAcpiDebug->Head >= (UINT32) ((UINTN) mAcpiDebug + AD_SIZE))
-    && (mAcpiDebug->Head < mAcpiDebug->Tail))){
-    //
-    // If curent ----- buffer + 020
-    //                 ...
-    //                 ... Head
-    //                 ... Data for SMM print
-    //                 ... Tail
-    //                 ... Vacant for ASL input
-    //           ----- buffer end
-    //
-    // skip NULL block
-    //
-    while ((*(CHAR8 *) (UINTN) mAcpiDebug->Head == '\0') && (mAcpiDebug->Head < mAcpiDebug->Tail)) {
-      mAcpiDebug->Head ++;
-    }
-
-    if (mAcpiDebug->Head < mAcpiDebug->Tail) {
-      ZeroMem (Buffer, MAX_BUFFER_SIZE);
-      AsciiStrnCpyS ((CHAR8 *) Buffer, MAX_BUFFER_SIZE, (CHAR8 *) (UINTN) mAcpiDebug->Head, MAX_BUFFER_SIZE - 1);
-
-      DEBUG ((DEBUG_INFO | DEBUG_ERROR, "%a%a\n", Buffer, (BOOLEAN) mAcpiDebug->Truncate ? "..." : ""));
-      mAcpiDebug->Head += MAX_BUFFER_SIZE;
+  //
+  // Print every string ASL has queued since the last SMI. ASL only moves the Tail and
+  // this handler only moves the Head, so the strings from Head up to Tail are complete.
+  //
+  // If curent ----- buffer + 020          ----- buffer + 020
+  //                 ... Head                    ... Tail
+  //                 ... Data for SMM print      ... Vacant for ASL input
+  //                 ... Tail                    ... Head
+  //                 ... Vacant for ASL input    ... Data for SMM print
+  //           ----- buffer end            ----- buffer end
+  //
+  while (Head != Tail) {
+    CopyMem (Buffer, (VOID *) (UINTN) Head, MAX_BUFFER_SIZE);
 
-      if (mAcpiDebug->Head >= (mAcpiDebug->Tail)) {
-        //
-        // When head == tail, we do nothing in handler.
-        //
-        mAcpiDebug->Head = mAcpiDebug->Tail;
-      }
-    }
-  } else if ((BOOLEAN) mAcpiDebug->Wrap && ((mAcpiDebug->Head > mAcpiDebug->Tail)
-    && (mAcpiDebug->Head < (UINT32) ((UINTN) mAcpiDebug + mAcpiDebug->BufferSize)))){
     //
-    // If curent ----- buffer + 020
-    //                 ... Tail
-    //                 ... Vacant for ASL input
-    //                 ... Head
-    //                 ... Data for SMM print
-    //           ----- buffer end
+    // The last byte of each string location is its truncate status.
     //
-    while ((*(CHAR8 *) (UINTN) mAcpiDebug->Head == '\0') && (mAcpiDebug->Head < (UINT32) ((UINTN) mAcpiDebug + mAcpiDebug->BufferSize))) {
-      mAcpiDebug->Head ++;
+    if (Buffer[0] != '\0') {
+      Buffer[MAX_BUFFER_SIZE - 1] = '\0';
+      DEBUG ((DEBUG_INFO | DEBUG_ERROR, "%a%a\n", Buffer, (*(UINT8 *) (UINTN) (Head + MAX_BUFFER_SIZE - 1) != 0) ? "..." : ""));
     }
-    if (mAcpiDebug->Head < (UINT32) ((UINTN) mAcpiDebug + mAcpiDebug->BufferSize)){
-      ZeroMem (Buffer, MAX_BUFFER_SIZE);
-      AsciiStrnCpyS ((CHAR8 *) Buffer, MAX_BUFFER_SIZE, (CHAR8 *) (UINTN) mAcpiDebug->Head, MAX_BUFFER_SIZE - 1);
-      DEBUG ((DEBUG_INFO | DEBUG_ERROR, "%a%a\n", Buffer, (BOOLEAN) mAcpiDebug->Truncate ? "..." : ""));
-      mAcpiDebug->Head += MAX_BUFFER_SIZE;
-
-      if (mAcpiDebug->Head >= (UINT32) ((UINTN) mAcpiDebug + mAcpiDebug->BufferSize)) {
-        //
-        // We met end of buffer.
-        //
-        mAcpiDebug->Wrap = 0;
-        mAcpiDebug->Head = (UINT32) ((UINTN) mAcpiDebug + AD_SIZE);
-      }
+
+    Head += MAX_BUFFER_SIZE;
+    if (Head >= mBufferEnd) {
+      //
+      // We met end of buffer.
+      //
+      mAcpiDebug->Wrap = 0;
+      Head = BufferStart;
     }
   }
 
+  mAcpiDebug->Head = Head;
+
   return EFI_SUCCESS;
 }
 
+/**
+  Periodic timer SMI callback for ACPI Debug, which prints the strings ASL queued below
+  the SMI threshold.
+
+  @param[in]      DispatchHandle    The unique handle assigned to this handler by SmiHandlerRegister().
+  @param[in]      Context           Points to an optional handler context which was specified when the
+                                    handler was registered.
+  @param[in, out] CommBuffer        A pointer to a collection of data in memory that will
+                                    be conveyed from a non-SMM environment into an SMM environment.
+  @param[in, out] CommBufferSize    The size of the CommBuffer.
+
+  @retval EFI_SUCCESS               The interrupt was handled successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+AcpiDebugSmmPeriodicCallback (
+  IN EFI_HANDLE     DispatchHandle,
+  IN CONST VOID     *Context,
+  IN OUT VOID       *CommBuffer,
+  IN OUT UINTN      *CommBufferSize
+  )
+{
+  if (mAcpiDebug->Head == mAcpiDebug->Tail) {
+    return EFI_SUCCESS;
+  }
+
+  return AcpiDebugSmmCallback (DispatchHandle, NULL, NULL, NULL);
+}
+
+/**
+  Register the periodic timer SMI that prints the strings ASL queued below the SMI threshold.
+
+  This is optional: nothing is registered if PcdAcpiDebugSmmPeriod is zero or if
+  the platform does not produce the periodic timer dispatch protocol.
+
+**/
+VOID
+AcpiDebugRegisterPeriodicTimer (
+  VOID
+  )
+{
+  EFI_STATUS                                  Status;
+  EFI_SMM_PERIODIC_TIMER_DISPATCH2_PROTOCOL   *PeriodicTimerDispatch;
+  EFI_SMM_PERIODIC_TIMER_REGISTER_CONTEXT     PeriodicTimerContext;
+  UINT64                                      *SmiTickInterval;
+  EFI_HANDLE                                  PeriodicTimerHandle;
+
+  PeriodicTimerContext.Period = PcdGet64 (PcdAcpiDebugSmmPeriod);
+  if (PeriodicTimerContext.Period == 0) {
+    return;
+  }
+
+  PeriodicTimerDispatch = NULL;
+  Status = mSmst->SmmLocateProtocol (&gEfiSmmPeriodicTimerDispatch2ProtocolGuid, NULL, (VOID **) &PeriodicTimerDispatch);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "AcpiDebug - No periodic timer SMI, strings are printed at the SMI threshold only\n"));
+    return;
+  }
+
+  //
+  // Use the longest SMI tick interval the platform supports that is not longer than the period.
+  //
+  SmiTickInterval = NULL;
+  do {
+    Status = PeriodicTimerDispatch->GetNextShorterInterval (PeriodicTimerDispatch, &SmiTickInterval);
+  } while (!EFI_ERROR (Status) && (SmiTickInterval != NULL) && (*SmiTickInterval > PeriodicTimerContext.Period));
+
+  if (EFI_ERROR (Status) || (SmiTickInterval == NULL)) {
+    return;
+  }
+
+  PeriodicTimerContext.SmiTickInterval = *SmiTickInterval;
+  Status = PeriodicTimerDispatch->Register (
+                                    PeriodicTimerDispatch,
+                                    AcpiDebugSmmPeriodicCallback,
+                                    &PeriodicTimerContext,
+                                    &PeriodicTimerHandle
+                                    );
+  ASSERT_EFI_ERROR (Status);
+}
+
 /**
   Acpi Debug SmmEndOfDxe notification.
 
@@ -457,6 +541,8 @@ AcpiDebugSmmEndOfDxeNotification (
 
     mAcpiDebug->SmiTrigger = (UINT8) SwContext.SwSmiInputValue;
     mAcpiDebug->SmmVersion = 1;
+
+    AcpiDebugRegisterPeriodicTimer ();
   }
 
   return EFI_SUCCESS;
@@ -0,0 +1,46 @@
+/** @file
+  Definitions of the POST code trace.
+
+  The trace is a ring of the POST codes emitted during boot, each one
+  with a performance counter timestamp. It is kept in a GUID HOB in PEI
+  and copied to a buffer installed as an EFI configuration table in DXE,
+  both identified by gPostCodeTraceGuid.
+
+  Copyright (c) 2020, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __POST_CODE_TRACE_H__
+#define __POST_CODE_TRACE_H__
+
+#define POST_CODE_TRACE_GUID \
+  { \
+    0x60bdf472, 0xc699, 0x45f6, { 0xb8, 0xb2, 0xed, 0x13, 0x60, 0xd0, 0xfe, 0x45 } \
+  }
+
+#define POST_CODE_TRACE_SIGNATURE  SIGNATURE_32 ('P', 'C', 'T', 'R')
+
+typedef struct {
+  UINT64    Timestamp;      ///< Performance counter value when the POST code was emitted
+  UINT32    PostCode;
+  UINT32    Reserved;
+} POST_CODE_TRACE_ENTRY;
+
+typedef struct {
+  UINT32    Signature;      ///< POST_CODE_TRACE_SIGNATURE
+  UINT32    Capacity;       ///< Number of entries in the ring
+  UINT32    Count;          ///< Number of POST codes recorded so far, entry Count % Capacity is the next one written
+  UINT32    Reserved;
+  UINT64    Frequency;      ///< Performance counter frequency in Hz
+  //
+  // POST_CODE_TRACE_ENTRY  Entries[Capacity];
+  //
+} POST_CODE_TRACE_HEADER;
+
+#define POST_CODE_TRACE_SIZE(Capacity) \
+  (sizeof (POST_CODE_TRACE_HEADER) + (Capacity) * sizeof (POST_CODE_TRACE_ENTRY))
+
+extern EFI_GUID gPostCodeTraceGuid;
+
+#endif
@@ -10,12 +10,43 @@
 #include <Library/PeimEntryPoint.h>
 #include <Library/PcdLib.h>
 #include <Library/DebugLib.h>
+#include <Library/HobLib.h>
+#include <Library/TimerLib.h>
 #include <Library/ReportStatusCodeLib.h>
 #include <Ppi/ReportStatusCodeHandler.h>
+#include <Guid/PostCodeTrace.h>
 
 #include <Library/PostCodeMapLib.h>
 #include <Library/PostCodeLib.h>
 
+/**
+  Record a post code with its timestamp in the post code trace HOB.
+
+  @param  PostCodeValue    The post code to record.
+
+**/
+VOID
+PostCodeTraceRecord (
+  IN UINT32                         PostCodeValue
+  )
+{
+  EFI_HOB_GUID_TYPE                 *GuidHob;
+  POST_CODE_TRACE_HEADER            *Trace;
+  POST_CODE_TRACE_ENTRY             *Entry;
+
+  GuidHob = GetFirstGuidHob (&gPostCodeTraceGuid);
+  if (GuidHob == NULL) {
+    return;
+  }
+
+  Trace = GET_GUID_HOB_DATA (GuidHob);
+  Entry = (POST_CODE_TRACE_ENTRY *) (Trace + 1) + (Trace->Count % Trace->Capacity);
+  Entry->Timestamp = GetPerformanceCounter ();
+  Entry->PostCode  = PostCodeValue;
+  Entry->Reserved  = 0;
+  Trace->Count++;
+}
+
 /**
   Convert status code value and write data to post code.
 
@@ -56,6 +87,7 @@ PostCodeStatusCodeReportWorker (
   if (PostCodeValue != 0) {
     DEBUG ((EFI_D_INFO, "POSTCODE=<%02x>\n", PostCodeValue));
     PostCode (PostCodeValue);
+    PostCodeTraceRecord (PostCodeValue);
   }
 
   return EFI_SUCCESS;
@@ -82,11 +114,29 @@ PeiPostCodeStatusCodeHandlerLibConstructor (
 {
   EFI_STATUS                  Status;
   EFI_PEI_RSC_HANDLER_PPI     *RscHandlerPpi;
+  POST_CODE_TRACE_HEADER      *Trace;
+  UINT32                      Capacity;
 
   if (!PcdGetBool (PcdStatusCodeUsePostCode)) {
     return RETURN_SUCCESS;
   }
 
+  //
+  // Create the post code trace HOB, unless an earlier instance of this
+  // library already did.
+  //
+  Capacity = PcdGet32 (PcdPostCodeTraceEntries);
+  if ((Capacity != 0) && (GetFirstGuidHob (&gPostCodeTraceGuid) == NULL)) {
+    Trace = BuildGuidHob (&gPostCodeTraceGuid, POST_CODE_TRACE_SIZE (Capacity));
+    if (Trace != NULL) {
+      Trace->Signature = POST_CODE_TRACE_SIGNATURE;
+      Trace->Capacity  = Capacity;
+      Trace->Count     = 0;
+      Trace->Reserved  = 0;
+      Trace->Frequency = GetPerformanceCounterProperties (NULL, NULL);
+    }
+  }
+
   Status = PeiServicesLocatePpi (
              &gEfiPeiRscHandlerPpiGuid,
              0,
@@ -12,8 +12,11 @@
 #include <Library/HobLib.h>
 #include <Library/PcdLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
 #include <Library/ReportStatusCodeLib.h>
 #include <Protocol/ReportStatusCodeHandler.h>
+#include <Guid/PostCodeTrace.h>
 
 #include <Library/PostCodeMapLib.h>
 #include <Library/PostCodeLib.h>
@@ -21,6 +24,90 @@
 EFI_RSC_HANDLER_PROTOCOL  *mPostCodeRscHandlerProtocol       = NULL;
 EFI_EVENT                 mPostCodeExitBootServicesEvent     = NULL;
 BOOLEAN                   mPostCodeRegisted                  = FALSE;
+POST_CODE_TRACE_HEADER    *mPostCodeTrace                    = NULL;
+
+/**
+  Record a post code with its timestamp in the post code trace.
+
+  @param  Trace            Pointer to the post code trace.
+  @param  PostCodeValue    The post code to record.
+  @param  Timestamp        Performance counter value when it was emitted.
+
+**/
+VOID
+PostCodeTraceRecord (
+  IN OUT POST_CODE_TRACE_HEADER     *Trace,
+  IN     UINT32                     PostCodeValue,
+  IN     UINT64                     Timestamp
+  )
+{
+  POST_CODE_TRACE_ENTRY             *Entry;
+
+  Entry = (POST_CODE_TRACE_ENTRY *) (Trace + 1) + (Trace->Count % Trace->Capacity);
+  Entry->Timestamp = Timestamp;
+  Entry->PostCode  = PostCodeValue;
+  Entry->Reserved  = 0;
+  Trace->Count++;
+}
+
+/**
+  Allocate the post code trace in runtime memory, carry over the post codes
+  recorded in PEI and publish the trace as an EFI configuration table, so
+  that it stays available to OS tools after boot.
+
+**/
+VOID
+PostCodeTraceInstall (
+  VOID
+  )
+{
+  EFI_HOB_GUID_TYPE                 *GuidHob;
+  POST_CODE_TRACE_HEADER            *Trace;
+  POST_CODE_TRACE_HEADER            *PeiTrace;
+  POST_CODE_TRACE_ENTRY             *PeiEntries;
+  UINT32                            Capacity;
+  UINT32                            Index;
+  EFI_STATUS                        Status;
+
+  Capacity = PcdGet32 (PcdPostCodeTraceEntries);
+  if (Capacity == 0) {
+    return;
+  }
+
+  Trace = AllocateRuntimeZeroPool (POST_CODE_TRACE_SIZE (Capacity));
+  if (Trace == NULL) {
+    return;
+  }
+
+  Trace->Signature = POST_CODE_TRACE_SIGNATURE;
+  Trace->Capacity  = Capacity;
+  Trace->Frequency = GetPerformanceCounterProperties (NULL, NULL);
+
+  //
+  // Replay the PEI entries oldest first
+  //
+  GuidHob = GetFirstGuidHob (&gPostCodeTraceGuid);
+  if (GuidHob != NULL) {
+    PeiTrace   = GET_GUID_HOB_DATA (GuidHob);
+    PeiEntries = (POST_CODE_TRACE_ENTRY *) (PeiTrace + 1);
+    Index      = (PeiTrace->Count > PeiTrace->Capacity) ? PeiTrace->Count - PeiTrace->Capacity : 0;
+    for (; Index < PeiTrace->Count; Index++) {
+      PostCodeTraceRecord (
+        Trace,
+        PeiEntries[Index % PeiTrace->Capacity].PostCode,
+        PeiEntries[Index % PeiTrace->Capacity].Timestamp
+        );
+    }
+  }
+
+  Status = gBS->InstallConfigurationTable (&gPostCodeTraceGuid, Trace);
+  if (EFI_ERROR (Status)) {
+    FreePool (Trace);
+    return;
+  }
+
+  mPostCodeTrace = Trace;
+}
 
 /**
   Convert status code value and write data to post code.
@@ -60,6 +147,9 @@ PostCodeStatusCodeReportWorker (
   if (PostCodeValue != 0) {
     DEBUG ((EFI_D_INFO, "POSTCODE=<%02x>\n", PostCodeValue));
     PostCode (PostCodeValue);
+    if (mPostCodeTrace != NULL) {
+      PostCodeTraceRecord (mPostCodeTrace, PostCodeValue, GetPerformanceCounter ());
+    }
   }
 
   return EFI_SUCCESS;
@@ -155,6 +245,8 @@ RuntimeDxePostCodeStatusCodeHandlerLibConstructor (
     return EFI_SUCCESS;
   }
 
+  PostCodeTraceInstall ();
+
   Status = gBS->LocateProtocol (
                   &gEfiRscHandlerProtocolGuid,
                   NULL,
@@ -584,7 +584,6 @@ XhcCreateUrb (
   Urb->Direction = Direction;
   Urb->Data = DataAddress;
 
-  ZeroMem ((VOID*)(UINTN) Urb->Data, DataLen);
   CopyMem ((VOID*)(UINTN) Urb->Data, Data, DataLen);
 
   Urb->DataLen  = (UINT32) DataLen;
@@ -57,9 +57,11 @@
 #define XHC_USBSTS_HALT               BIT0
 
 //
-// Transfer the data of 8 bytes each time
+// Transfer up to one max packet of the debug capability bulk endpoints
+// (1024 bytes) each time, so that a whole DEBUG () line is normally sent
+// with a single URB rather than one round trip for every 8 bytes.
 //
-#define XHC_DEBUG_PORT_DATA_LENGTH   8
+#define XHC_DEBUG_PORT_DATA_LENGTH   1024
 
 //
 // Indicate the timeout when data is transferred. 0 means infinite timeout.
@@ -13,6 +13,15 @@ ASF_PROTOCOL              gAsfProtocol   = { AsfPushEvent, NULL };
 EFI_SMBUS_DEVICE_ADDRESS  mFixedTargetAddress;
 EFI_SMBUS_HC_PROTOCOL     *mSmBus = NULL;
 
+//
+// Progress and error events are queued by the status code handler and sent
+// from a timer, so reporting a status code never waits for the SMBus.
+//
+ASF_MESSAGE  *mAsfEventQueue[ASF_EVENT_QUEUE_SIZE];
+UINTN        mAsfEventQueueHead  = 0;
+UINTN        mAsfEventQueueCount = 0;
+EFI_EVENT    mAsfEventQueueTimer = NULL;
+
 /**
   Send message through SmBus to lan card.
 
@@ -53,6 +62,105 @@ AsfPushEvent  (
   return Status;
 }
 
+/**
+  Send all queued System Firmware Progress/Error Events to the lan card.
+
+  The caller must be running at TPL_CALLBACK.
+**/
+VOID
+AsfFlushEventQueueLocked (
+  VOID
+  )
+{
+  ASF_MESSAGE  *AsfMessage;
+
+  while (mAsfEventQueueCount > 0) {
+    AsfMessage          = mAsfEventQueue[mAsfEventQueueHead];
+    mAsfEventQueueHead  = (mAsfEventQueueHead + 1) % ASF_EVENT_QUEUE_SIZE;
+    mAsfEventQueueCount--;
+
+    AsfPushEvent (
+      AsfMessage->Message.Command,
+      AsfMessage->Message.ByteCount,
+      (UINT8 *)&(AsfMessage->Message.SubCommand)
+      );
+  }
+}
+
+/**
+  Send all queued System Firmware Progress/Error Events to the lan card.
+
+**/
+VOID
+AsfFlushEventQueue (
+  VOID
+  )
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  AsfFlushEventQueueLocked ();
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Queue a System Firmware Progress/Error Event for the lan card.
+
+  An event identical to the last queued one is not queued again. If the queue
+  is full, it is flushed first.
+
+  @param[in] AsfMessage   ASF message to send.
+
+**/
+VOID
+AsfQueueEvent (
+  IN ASF_MESSAGE  *AsfMessage
+  )
+{
+  EFI_TPL  OldTpl;
+  UINTN    Tail;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  if (mAsfEventQueueCount > 0) {
+    Tail = (mAsfEventQueueHead + mAsfEventQueueCount - 1) % ASF_EVENT_QUEUE_SIZE;
+    if (mAsfEventQueue[Tail]->Type == AsfMessage->Type) {
+      gBS->RestoreTPL (OldTpl);
+      return;
+    }
+  }
+
+  if (mAsfEventQueueCount == ASF_EVENT_QUEUE_SIZE) {
+    AsfFlushEventQueueLocked ();
+  }
+
+  mAsfEventQueue[(mAsfEventQueueHead + mAsfEventQueueCount) % ASF_EVENT_QUEUE_SIZE] = AsfMessage;
+  mAsfEventQueueCount++;
+
+  // Without the timer, send the event right away.
+  if (mAsfEventQueueTimer == NULL) {
+    AsfFlushEventQueueLocked ();
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  This Event Callback sends the queued System Firmware Progress/Error Events.
+
+  @param[in]  Event      A pointer to the Event that triggered the callback.
+  @param[in]  Context    A pointer to private data registered with the callback function.
+**/
+VOID
+EFIAPI
+AsfEventQueueTimerEvent (
+  IN  EFI_EVENT  Event,
+  IN  VOID       *Context
+  )
+{
+  AsfFlushEventQueueLocked ();
+}
+
 /**
   This function pushes the System Firmware State Events.
 
@@ -65,6 +173,9 @@ AsfPushSystemState  (
   IN  UINT8  SystemState
   )
 {
+  // Keep the state event ordered after the queued progress/error events.
+  AsfFlushEventQueue ();
+
   mAsfSystemState.EventSensorType = SystemState;
   AsfPushEvent (
     mAsfSystemState.Command,
@@ -95,11 +206,7 @@ AsfPushSystemErrorProgressEvent  (
   {
     for ( i = 0; i < mAsfMessagesSize; i++ ) {
       if ( mAsfMessages[i].Type == MessageType ) {
-        AsfPushEvent (
-          mAsfMessages[i].Message.Command,
-          mAsfMessages[i].Message.ByteCount,
-          (UINT8 *)&(mAsfMessages[i].Message.SubCommand)
-          );
+        AsfQueueEvent (&mAsfMessages[i]);
         break;
       }
     }
@@ -314,6 +421,21 @@ AsfDxeEntry (
 
   InstallAsfAcpiTable ();
 
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  AsfEventQueueTimerEvent,
+                  NULL,
+                  &mAsfEventQueueTimer
+                  );
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->SetTimer (mAsfEventQueueTimer, TimerPeriodic, ASF_EVENT_QUEUE_PERIOD);
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (mAsfEventQueueTimer);
+      mAsfEventQueueTimer = NULL;
+    }
+  }
+
   // Send mother board initialization message.
   AsfPushSystemErrorProgressEvent (MESSAGE_ERROR_LEVEL_PROGRESS, MsgMotherBoardInit);
 
@@ -24,6 +24,13 @@
 #include <Protocol/AcpiTable.h>
 #include <AsfMessages.h>
 
+//
+// Number of progress/error events that can wait for the SMBus, and how often
+// they are sent, in 100ns units.
+//
+#define ASF_EVENT_QUEUE_SIZE    16
+#define ASF_EVENT_QUEUE_PERIOD  EFI_TIMER_PERIOD_MILLISECONDS (10)
+
 extern MESSAGE_DATA_HUB_MAP     mMsgProgressMap[];
 extern MESSAGE_DATA_HUB_MAP     mMsgErrorMap[];
 extern ASF_MESSAGE              mAsfMessages[];
@@ -0,0 +1,345 @@
+/** @file
+  IpmiPerf - dumps the IPMI transport statistics and measures BMC turnaround
+
+  Prints, for each NetFn/Cmd pair sent through the GenericIpmi DXE driver,
+  how many commands were sent, how many bytes went each way and how long the
+  request and response phases took on average.
+
+  Usage: IpmiPerf [-r] [-l <count>]
+    -r resets the statistics after printing them.
+    -l sends <count> Get Device ID commands and prints their round-trip time,
+       split into the driver's request and response phases.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <IndustryStandard/Ipmi.h>
+#include <Protocol/IpmiTransportProtocol.h>
+#include <Protocol/IpmiTransportStats.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/ShellCEntryLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+/**
+  Get the time elapsed since a performance counter value was read.
+
+  @param[in]  StartTicks  Performance counter value at the start of the interval.
+
+  @return Elapsed time in nanoseconds.
+**/
+STATIC
+UINT64
+ElapsedNs (
+  IN UINT64  StartTicks
+  )
+{
+  UINT64  Now;
+  UINT64  CounterStart;
+  UINT64  CounterEnd;
+
+  Now = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  if (CounterEnd < CounterStart) {
+    return GetTimeInNanoSecond (StartTicks - Now);
+  }
+
+  return GetTimeInNanoSecond (Now - StartTicks);
+}
+
+/**
+  Divide a duration by a count and convert it to microseconds.
+
+  @param[in]  Ns     Total duration in nanoseconds.
+  @param[in]  Count  Number of samples, may be 0.
+
+  @return Average duration in microseconds.
+**/
+STATIC
+UINT64
+AverageUs (
+  IN UINT64  Ns,
+  IN UINT64  Count
+  )
+{
+  if (Count == 0) {
+    return 0;
+  }
+
+  return DivU64x64Remainder (Ns, MultU64x32 (Count, 1000), NULL);
+}
+
+/**
+  Find the statistics of a NetFn/Cmd pair.
+
+  @param[in]  Stats        Statistics returned by the driver.
+  @param[in]  NetFunction  Net Function of the command.
+  @param[in]  Command      IPMI command.
+
+  @return Pointer to the entry, or NULL if the command was never sent.
+**/
+STATIC
+IPMI_TRANSPORT_COMMAND_STATS *
+FindCommand (
+  IN IPMI_TRANSPORT_STATS  *Stats,
+  IN UINT8                 NetFunction,
+  IN UINT8                 Command
+  )
+{
+  UINT32  Index;
+
+  for (Index = 0; Index < Stats->CommandCount; Index++) {
+    if ((Stats->Command[Index].NetFunction == NetFunction) &&
+        (Stats->Command[Index].Command == Command)) {
+      return &Stats->Command[Index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Print the statistics of every command sent so far.
+
+  @param[in]  Stats  Statistics returned by the driver.
+**/
+STATIC
+VOID
+PrintStats (
+  IN IPMI_TRANSPORT_STATS  *Stats
+  )
+{
+  UINT32                        Index;
+  IPMI_TRANSPORT_COMMAND_STATS  *Command;
+
+  Print (L"NetFn Cmd      Calls Errors Retries   Bytes out    Bytes in  Send us  Recv us  Max us\n");
+  for (Index = 0; Index < Stats->CommandCount; Index++) {
+    Command = &Stats->Command[Index];
+    Print (
+      L"   %02x  %02x %10lu %6lu %7lu %11lu %11lu %8lu %8lu %7lu\n",
+      Command->NetFunction,
+      Command->Command,
+      Command->Calls,
+      Command->Errors,
+      Command->Retries,
+      Command->BytesSent,
+      Command->BytesReceived,
+      AverageUs (Command->SendNs, Command->Calls),
+      AverageUs (Command->ReceiveNs, Command->Calls),
+      AverageUs (Command->MaxReceiveNs, 1)
+      );
+  }
+
+  if (Stats->Untracked != 0) {
+    Print (L"%lu commands not tracked, the table is full\n", Stats->Untracked);
+  }
+}
+
+/**
+  Send Get Device ID commands and print their round-trip time.
+
+  The time measured here covers the whole transport call. The driver's own
+  statistics for the same commands tell how much of it went to writing the
+  request and how much to waiting for and reading the response.
+
+  @param[in]  IpmiTransport  IPMI transport protocol.
+  @param[in]  StatsProtocol  IPMI transport statistics protocol, may be NULL.
+  @param[in]  Count          Number of commands to send.
+
+  @retval EFI_SUCCESS  Every command completed.
+  @retval Others       A command failed.
+**/
+STATIC
+EFI_STATUS
+RunDeviceIdLoop (
+  IN IPMI_TRANSPORT                 *IpmiTransport,
+  IN IPMI_TRANSPORT_STATS_PROTOCOL  *StatsProtocol,
+  IN UINTN                          Count
+  )
+{
+  EFI_STATUS                    Status;
+  UINTN                         Index;
+  UINT64                        StartTicks;
+  UINT64                        Ns;
+  UINT64                        MinNs;
+  UINT64                        MaxNs;
+  UINT64                        TotalNs;
+  IPMI_GET_DEVICE_ID_RESPONSE   DeviceId;
+  UINT32                        DataSize;
+  IPMI_TRANSPORT_STATS          *Before;
+  IPMI_TRANSPORT_STATS          *After;
+  IPMI_TRANSPORT_COMMAND_STATS  *BeforeCommand;
+  IPMI_TRANSPORT_COMMAND_STATS  *AfterCommand;
+  UINT64                        Calls;
+
+  Before = NULL;
+  After  = NULL;
+  if (StatsProtocol != NULL) {
+    //
+    // IPMI_TRANSPORT_STATS is too large to comfortably live on the stack
+    //
+    Before = AllocatePool (sizeof (*Before));
+    After  = AllocatePool (sizeof (*After));
+    if ((Before == NULL) || (After == NULL) ||
+        EFI_ERROR (StatsProtocol->GetStatistics (StatsProtocol, Before))) {
+      StatsProtocol = NULL;
+    }
+  }
+
+  MinNs   = MAX_UINT64;
+  MaxNs   = 0;
+  TotalNs = 0;
+  Status  = EFI_SUCCESS;
+  for (Index = 0; Index < Count; Index++) {
+    DataSize   = sizeof (DeviceId);
+    StartTicks = GetPerformanceCounter ();
+    Status     = IpmiTransport->IpmiSubmitCommand (
+                                  IpmiTransport,
+                                  IPMI_NETFN_APP,
+                                  0,
+                                  IPMI_APP_GET_DEVICE_ID,
+                                  NULL,
+                                  0,
+                                  (UINT8 *)&DeviceId,
+                                  &DataSize
+                                  );
+    Ns = ElapsedNs (StartTicks);
+    if (EFI_ERROR (Status)) {
+      Print (L"Get Device ID %u failed: %r\n", Index, Status);
+      break;
+    }
+
+    MinNs    = MIN (MinNs, Ns);
+    MaxNs    = MAX (MaxNs, Ns);
+    TotalNs += Ns;
+  }
+
+  if (Index != 0) {
+    Print (
+      L"Get Device ID x%u: %lu us avg %lu us min %lu us max\n",
+      Index,
+      AverageUs (TotalNs, Index),
+      AverageUs (MinNs, 1),
+      AverageUs (MaxNs, 1)
+      );
+  }
+
+  if ((Index != 0) && (StatsProtocol != NULL) &&
+      !EFI_ERROR (StatsProtocol->GetStatistics (StatsProtocol, After))) {
+    BeforeCommand = FindCommand (Before, IPMI_NETFN_APP, IPMI_APP_GET_DEVICE_ID);
+    AfterCommand  = FindCommand (After, IPMI_NETFN_APP, IPMI_APP_GET_DEVICE_ID);
+    if (AfterCommand != NULL) {
+      if (BeforeCommand != NULL) {
+        AfterCommand->Calls     -= BeforeCommand->Calls;
+        AfterCommand->SendNs    -= BeforeCommand->SendNs;
+        AfterCommand->ReceiveNs -= BeforeCommand->ReceiveNs;
+      }
+
+      Calls = AfterCommand->Calls;
+      Print (
+        L"  request %lu us avg, response %lu us avg, other %lu us avg\n",
+        AverageUs (AfterCommand->SendNs, Calls),
+        AverageUs (AfterCommand->ReceiveNs, Calls),
+        AverageUs (TotalNs - MIN (TotalNs, AfterCommand->SendNs + AfterCommand->ReceiveNs), Index)
+        );
+    }
+  }
+
+  if (Before != NULL) {
+    FreePool (Before);
+  }
+
+  if (After != NULL) {
+    FreePool (After);
+  }
+
+  return Status;
+}
+
+/**
+  The main entry point of the application.
+
+  @param[in] Argc             The number of items in Argv.
+  @param[in] Argv             Array of pointers to the arguments.
+
+  @retval 0                   The statistics were printed.
+  @retval Other               An error occurred.
+**/
+INTN
+EFIAPI
+ShellAppMain (
+  IN UINTN   Argc,
+  IN CHAR16  **Argv
+  )
+{
+  EFI_STATUS                     Status;
+  UINTN                          Index;
+  BOOLEAN                        Reset;
+  UINTN                          LoopCount;
+  IPMI_TRANSPORT                 *IpmiTransport;
+  IPMI_TRANSPORT_STATS_PROTOCOL  *StatsProtocol;
+  IPMI_TRANSPORT_STATS           *Stats;
+
+  Reset     = FALSE;
+  LoopCount = 0;
+
+  for (Index = 1; Index < Argc; Index++) {
+    if (StrCmp (Argv[Index], L"-r") == 0) {
+      Reset = TRUE;
+    } else if ((StrCmp (Argv[Index], L"-l") == 0) && (Index + 1 < Argc)) {
+      LoopCount = StrDecimalToUintn (Argv[++Index]);
+    } else {
+      Print (L"Usage: %s [-r] [-l <count>]\n", Argv[0]);
+      return 1;
+    }
+  }
+
+  Status = gBS->LocateProtocol (&gIpmiTransportStatsProtocolGuid, NULL, (VOID **)&StatsProtocol);
+  if (EFI_ERROR (Status)) {
+    StatsProtocol = NULL;
+  }
+
+  if (LoopCount != 0) {
+    Status = gBS->LocateProtocol (&gIpmiTransportProtocolGuid, NULL, (VOID **)&IpmiTransport);
+    if (EFI_ERROR (Status)) {
+      Print (L"IPMI transport not found: %r\n", Status);
+      return 1;
+    }
+
+    Status = RunDeviceIdLoop (IpmiTransport, StatsProtocol, LoopCount);
+    if (EFI_ERROR (Status)) {
+      return 1;
+    }
+  }
+
+  if (StatsProtocol == NULL) {
+    Print (L"IPMI transport statistics not found\n");
+    return (LoopCount != 0) ? 0 : 1;
+  }
+
+  Stats = AllocatePool (sizeof (*Stats));
+  if (Stats == NULL) {
+    return 1;
+  }
+
+  Status = StatsProtocol->GetStatistics (StatsProtocol, Stats);
+  if (EFI_ERROR (Status)) {
+    Print (L"Failed to get statistics: %r\n", Status);
+    FreePool (Stats);
+    return 1;
+  }
+
+  PrintStats (Stats);
+
+  if (Reset) {
+    StatsProtocol->ResetStatistics (StatsProtocol);
+  }
+
+  FreePool (Stats);
+  return 0;
+}
@@ -13,7 +13,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
+#include <Library/UefiLib.h>
 #include <Library/IpmiCommandLib.h>
+#include <Protocol/IpmiTransportProtocol.h>
+#include <Protocol/ReportStatusCodeHandler.h>
 
 EFI_STATUS
 EFIAPI
@@ -170,6 +173,317 @@ Returns:
   return EFI_SUCCESS;
 }
 
+//
+// Error status codes reported during POST are kept in memory and written to
+// the SEL at ReadyToBoot. Repeats of the same code only bump a counter, and
+// once BMC_ELOG_MAX_EVENTS different codes are buffered further ones are
+// only counted, so a flood of errors never waits on the BMC.
+//
+#define BMC_ELOG_MAX_EVENTS         64
+
+//
+// The events are written as OEM timestamped SEL records: record ID,
+// record type, timestamp (filled in by the BMC), manufacturer ID, then the
+// status code value, the repeat count and the status code severity.
+//
+#define BMC_ELOG_SEL_RECORD_SIZE    16
+#define BMC_ELOG_SEL_RECORD_TYPE    0xC0
+#define BMC_ELOG_MANUFACTURER_ID    0x000157
+
+typedef struct {
+  EFI_STATUS_CODE_TYPE              CodeType;
+  EFI_STATUS_CODE_VALUE             Value;
+  UINT8                             Count;
+} BMC_ELOG_EVENT;
+
+typedef struct {
+  IPMI_COMMAND_TOKEN                Token;
+  UINT8                             Record[BMC_ELOG_SEL_RECORD_SIZE];
+  UINT8                             Response[4];
+} BMC_ELOG_SEL_WRITE;
+
+EFI_RSC_HANDLER_PROTOCOL            *mRscHandler = NULL;
+BMC_ELOG_EVENT                      mBmcElogEvents[BMC_ELOG_MAX_EVENTS];
+UINTN                               mBmcElogEventCount = 0;
+UINTN                               mBmcElogEventsDropped = 0;
+BMC_ELOG_SEL_WRITE                  *mBmcElogSelWrites = NULL;
+UINTN                               mBmcElogSelWritesPending = 0;
+
+EFI_STATUS
+EFIAPI
+BmcElogStatusCodeListener (
+  IN EFI_STATUS_CODE_TYPE           CodeType,
+  IN EFI_STATUS_CODE_VALUE          Value,
+  IN UINT32                         Instance,
+  IN EFI_GUID                       *CallerId,
+  IN EFI_STATUS_CODE_DATA           *Data
+  )
+/*++
+
+Routine Description:
+
+  Buffer an error status code for the SEL, coalescing repeats
+
+Arguments:
+
+  CodeType  - Status code type
+  Value     - Status code value
+  Instance  - Status code instance
+  CallerId  - Caller of the status code
+  Data      - Extended data
+
+Returns:
+
+  EFI_SUCCESS
+
+--*/
+{
+  EFI_TPL     OldTpl;
+  UINTN       Index;
+
+  if ((CodeType & EFI_STATUS_CODE_TYPE_MASK) != EFI_ERROR_CODE) {
+    return EFI_SUCCESS;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  for (Index = 0; Index < mBmcElogEventCount; Index++) {
+    if ((mBmcElogEvents[Index].CodeType == CodeType) && (mBmcElogEvents[Index].Value == Value)) {
+      if (mBmcElogEvents[Index].Count < MAX_UINT8) {
+        mBmcElogEvents[Index].Count++;
+      }
+      break;
+    }
+  }
+
+  if (Index == mBmcElogEventCount) {
+    if (mBmcElogEventCount < BMC_ELOG_MAX_EVENTS) {
+      mBmcElogEvents[Index].CodeType = CodeType;
+      mBmcElogEvents[Index].Value    = Value;
+      mBmcElogEvents[Index].Count    = 1;
+      mBmcElogEventCount++;
+    } else {
+      mBmcElogEventsDropped++;
+    }
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+VOID
+EFIAPI
+BmcElogSelWriteDone (
+  IN EFI_EVENT                      Event,
+  IN VOID                           *Context
+  )
+/*++
+
+Routine Description:
+
+  Completion of a queued Add SEL Entry. The buffers are freed with the last one.
+
+Arguments:
+
+  Event    - The token event
+  Context  - The SEL write
+
+Returns:
+
+  None
+
+--*/
+{
+  BMC_ELOG_SEL_WRITE  *SelWrite;
+
+  SelWrite = Context;
+  if (EFI_ERROR (SelWrite->Token.Status)) {
+    DEBUG ((DEBUG_ERROR, "BmcElog: Add SEL Entry failed: %r\n", SelWrite->Token.Status));
+  }
+
+  gBS->CloseEvent (Event);
+
+  if (--mBmcElogSelWritesPending == 0) {
+    FreePool (mBmcElogSelWrites);
+    mBmcElogSelWrites = NULL;
+  }
+}
+
+VOID
+EFIAPI
+BmcElogFlush (
+  IN EFI_EVENT                      Event,
+  IN VOID                           *Context
+  )
+/*++
+
+Routine Description:
+
+  Write the buffered events to the SEL at ReadyToBoot, without waiting for
+  the BMC if the transport can queue commands
+
+Arguments:
+
+  Event    - The ReadyToBoot event
+  Context  - Not used
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_STATUS                  Status;
+  IPMI_TRANSPORT              *IpmiTransport;
+  IPMI_GET_SEL_INFO_RESPONSE  SelInfo;
+  BMC_ELOG_SEL_WRITE          *SelWrite;
+  BMC_ELOG_EVENT              *ElogEvent;
+  UINTN                       Count;
+  UINTN                       Index;
+  UINT32                      ResponseSize;
+  BOOLEAN                     Async;
+
+  gBS->CloseEvent (Event);
+
+  if (mRscHandler != NULL) {
+    mRscHandler->Unregister (BmcElogStatusCodeListener);
+  }
+
+  if (mBmcElogEventsDropped != 0) {
+    DEBUG ((DEBUG_WARN, "BmcElog: %d error codes were not buffered\n", mBmcElogEventsDropped));
+  }
+
+  Count = mBmcElogEventCount;
+  if (Count == 0) {
+    return;
+  }
+
+  Status = gBS->LocateProtocol (&gIpmiTransportProtocolGuid, NULL, (VOID **) &IpmiTransport);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  //
+  // Don't write more than the SEL can take.
+  //
+  Status = IpmiGetSelInfo (&SelInfo);
+  if (EFI_ERROR (Status) || ((SelInfo.OperationSupport & 0x80) != 0)) {
+    DEBUG ((DEBUG_ERROR, "BmcElog: SEL is full or not available, %d events lost\n", Count));
+    return;
+  }
+
+  Count = MIN (Count, SelInfo.FreeSpace / BMC_ELOG_SEL_RECORD_SIZE);
+  if (Count == 0) {
+    return;
+  }
+
+  mBmcElogSelWrites = AllocateZeroPool (Count * sizeof (BMC_ELOG_SEL_WRITE));
+  if (mBmcElogSelWrites == NULL) {
+    return;
+  }
+
+  Async = (BOOLEAN) ((IpmiTransport->Revision >= IPMI_TRANSPORT_REVISION_ASYNC) &&
+                     (IpmiTransport->IpmiSubmitCommandAsync != NULL));
+
+  for (Index = 0; Index < Count; Index++) {
+    SelWrite  = &mBmcElogSelWrites[Index];
+    ElogEvent = &mBmcElogEvents[Index];
+
+    SelWrite->Record[2]  = BMC_ELOG_SEL_RECORD_TYPE;
+    SelWrite->Record[7]  = (UINT8) BMC_ELOG_MANUFACTURER_ID;
+    SelWrite->Record[8]  = (UINT8) (BMC_ELOG_MANUFACTURER_ID >> 8);
+    SelWrite->Record[9]  = (UINT8) (BMC_ELOG_MANUFACTURER_ID >> 16);
+    CopyMem (&SelWrite->Record[10], &ElogEvent->Value, sizeof (UINT32));
+    SelWrite->Record[14] = ElogEvent->Count;
+    SelWrite->Record[15] = (UINT8) ((ElogEvent->CodeType & EFI_STATUS_CODE_SEVERITY_MASK) >> 24);
+
+    SelWrite->Token.NetFunction      = IPMI_NETFN_STORAGE;
+    SelWrite->Token.Command          = IPMI_STORAGE_ADD_SEL_ENTRY;
+    SelWrite->Token.CommandData      = SelWrite->Record;
+    SelWrite->Token.CommandDataSize  = sizeof (SelWrite->Record);
+    SelWrite->Token.ResponseData     = SelWrite->Response;
+    SelWrite->Token.ResponseDataSize = sizeof (SelWrite->Response);
+
+    if (!Async) {
+      ResponseSize = sizeof (SelWrite->Response);
+      IpmiTransport->IpmiSubmitCommand (
+                       IpmiTransport,
+                       IPMI_NETFN_STORAGE,
+                       0,
+                       IPMI_STORAGE_ADD_SEL_ENTRY,
+                       SelWrite->Record,
+                       sizeof (SelWrite->Record),
+                       SelWrite->Response,
+                       &ResponseSize
+                       );
+      continue;
+    }
+
+    Status = gBS->CreateEvent (
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    BmcElogSelWriteDone,
+                    SelWrite,
+                    &SelWrite->Token.Event
+                    );
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    mBmcElogSelWritesPending++;
+    Status = IpmiTransport->IpmiSubmitCommandAsync (IpmiTransport, &SelWrite->Token);
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (SelWrite->Token.Event);
+      mBmcElogSelWritesPending--;
+      break;
+    }
+  }
+
+  if (mBmcElogSelWritesPending == 0) {
+    FreePool (mBmcElogSelWrites);
+    mBmcElogSelWrites = NULL;
+  }
+}
+
+VOID
+EFIAPI
+BmcElogRscHandlerInstalled (
+  IN EFI_EVENT                      Event,
+  IN VOID                           *Context
+  )
+/*++
+
+Routine Description:
+
+  Register the status code listener once the RSC handler protocol is there
+
+Arguments:
+
+  Event    - The protocol notify event
+  Context  - Not used
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_STATUS  Status;
+
+  Status = gBS->LocateProtocol (&gEfiRscHandlerProtocolGuid, NULL, (VOID **) &mRscHandler);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  gBS->CloseEvent (Event);
+
+  Status = mRscHandler->Register (BmcElogStatusCodeListener, TPL_HIGH_LEVEL);
+  if (EFI_ERROR (Status)) {
+    mRscHandler = NULL;
+  }
+}
+
 EFI_STATUS
 EFIAPI
 InitializeBmcElogLayer (
@@ -191,9 +505,29 @@ Returns:
 
 --*/
 {
+  VOID        *Registration;
+  EFI_EVENT   ReadyToBootEvent;
+
   SetElogRedirInstall ();
 
-  CheckIfSelIsFull ();
+  //
+  // The SEL space is checked when the buffered events are written, so the
+  // BMC isn't asked during driver dispatch.
+  //
+  EfiCreateProtocolNotifyEvent (
+    &gEfiRscHandlerProtocolGuid,
+    TPL_CALLBACK,
+    BmcElogRscHandlerInstalled,
+    NULL,
+    &Registration
+    );
+
+  EfiCreateEventReadyToBootEx (
+    TPL_CALLBACK,
+    BmcElogFlush,
+    NULL,
+    &ReadyToBootEvent
+    );
 
   return EFI_SUCCESS;
 }
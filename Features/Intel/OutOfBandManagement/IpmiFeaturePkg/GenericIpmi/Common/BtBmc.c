@@ -0,0 +1,261 @@
+/** @file
+  BT Transport Hook.
+
+  The Block Transfer interface moves a whole message through a FIFO, so a
+  request and its response each take a single handshake instead of one
+  handshake per byte as with KCS.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "BtBmc.h"
+
+STATIC
+EFI_STATUS
+BtWaitStatus (
+  UINT64                            BtTimeoutPeriod,
+  UINT16                            BtPort,
+  UINT8                             Mask,
+  UINT8                             Value,
+  UINT8                             *BtCtrl
+  )
+/*++
+
+Routine Description:
+
+  Wait until the bits of BT_CTRL selected by Mask are equal to Value.
+  Spins on the control register first, then backs off exponentially up to
+  BT_DELAY_UNIT between reads.
+
+Arguments:
+
+  BtTimeoutPeriod - The timeout, in units of BT_DELAY_UNIT
+  BtPort          - The base port of BT
+  Mask            - The control bits to check
+  Value           - The value the control bits must have
+  BtCtrl          - The last BT_CTRL value read
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC is not present, or BT_CTRL didn't change in time
+  EFI_SUCCESS      - The control bits have the expected value
+
+--*/
+{
+  UINT64          Waited;
+  UINT64          Timeout;
+  UINTN           Delay;
+  UINTN           Spin;
+
+  Timeout = MultU64x32 (BtTimeoutPeriod, BT_DELAY_UNIT);
+  Waited  = 0;
+  Delay   = BT_MIN_DELAY;
+  Spin    = 0;
+
+  while (TRUE) {
+    *BtCtrl = IoRead8 (BtPort + BT_CTRL_REG);
+    if (*BtCtrl == 0xFF) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    if ((*BtCtrl & Mask) == Value) {
+      return EFI_SUCCESS;
+    }
+
+    if (Spin < BT_SPIN_COUNT) {
+      Spin++;
+      continue;
+    }
+
+    if (Waited >= Timeout) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    MicroSecondDelay (Delay);
+    Waited += Delay;
+    Delay   = MIN (Delay * 2, BT_DELAY_UNIT);
+  }
+}
+
+EFI_STATUS
+SendDataToBtBmcPort (
+  UINT64                                    BtTimeoutPeriod,
+  UINT16                                    BtPort,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     DataSize
+  )
+/*++
+
+Routine Description:
+
+  Send a whole request message to the BMC through the BT FIFO
+
+Arguments:
+
+  BtTimeoutPeriod - The timeout, in units of BT_DELAY_UNIT
+  BtPort          - The base port of BT
+  Context         - The context of this operation
+  Data            - The request, starting with NetFn/LUN
+  DataSize        - The request size
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC did not accept the request in time
+  EFI_SUCCESS      - Send out the data successfully
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT8       BtCtrl;
+  UINT8       Index;
+  UINT8       Sequence;
+
+  if ((DataSize < 2) || (DataSize == MAX_UINT8)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // A response to an earlier, abandoned request would be mistaken for the
+  // response to this one, so throw it away first.
+  //
+  BtCtrl = IoRead8 (BtPort + BT_CTRL_REG);
+  if (BtCtrl == 0xFF) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  if ((BtCtrl & BT_CTRL_H_BUSY) != 0) {
+    IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_H_BUSY);
+  }
+
+  if ((BtCtrl & BT_CTRL_B2H_ATN) != 0) {
+    IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_B2H_ATN);
+  }
+
+  Status = BtWaitStatus (
+             BtTimeoutPeriod,
+             BtPort,
+             BT_CTRL_B_BUSY | BT_CTRL_H2B_ATN,
+             0,
+             &BtCtrl
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Sequence = (Context != NULL) ? *(UINT8 *) Context : BT_SEQUENCE_NUMBER;
+
+  //
+  // Length, NetFn/LUN, Seq, Cmd, Data. The length counts the bytes after it.
+  //
+  IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_CLR_WR_PTR);
+  IoWrite8 (BtPort + BT_BUFFER_REG, DataSize + 1);
+  IoWrite8 (BtPort + BT_BUFFER_REG, Data[0]);
+  IoWrite8 (BtPort + BT_BUFFER_REG, Sequence);
+  for (Index = 1; Index < DataSize; Index++) {
+    IoWrite8 (BtPort + BT_BUFFER_REG, Data[Index]);
+  }
+
+  IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_H2B_ATN);
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+ReceiveBmcDataFromBtPort (
+  UINT64                                    BtTimeoutPeriod,
+  UINT16                                    BtPort,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     *DataSize
+  )
+/*++
+
+Routine Description:
+
+  Receive a whole response message from the BMC through the BT FIFO
+
+Arguments:
+
+  BtTimeoutPeriod - The timeout, in units of BT_DELAY_UNIT
+  BtPort          - The base port of BT
+  Context         - The context of this operation
+  Data            - The buffer pointer
+  DataSize        - On input the buffer size, on output the response size
+
+Returns:
+
+  EFI_DEVICE_ERROR     - The BMC did not respond in time
+  EFI_BUFFER_TOO_SMALL - The response doesn't fit in the buffer
+  EFI_SUCCESS          - Received data successfully
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT8       BtCtrl;
+  UINT8       Length;
+  UINT8       Byte;
+  UINT8       Index;
+  UINT8       Count;
+  UINT8       Sequence;
+
+  do {
+    Status = BtWaitStatus (
+               BtTimeoutPeriod,
+               BtPort,
+               BT_CTRL_B2H_ATN,
+               BT_CTRL_B2H_ATN,
+               &BtCtrl
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    //
+    // Tell the BMC the buffer is being read, then acknowledge the response.
+    //
+    if ((BtCtrl & BT_CTRL_H_BUSY) == 0) {
+      IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_H_BUSY);
+    }
+
+    IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_B2H_ATN);
+    IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_CLR_RD_PTR);
+
+    //
+    // Length, NetFn/LUN, Seq, Cmd, CompletionCode, Data. The sequence number
+    // is dropped, so the caller gets the same layout as from KCS. The whole
+    // message is always drained so the BMC can take the next request.
+    //
+    Length   = IoRead8 (BtPort + BT_BUFFER_REG);
+    Count    = 0;
+    Sequence = 0;
+    for (Index = 0; Index < Length; Index++) {
+      Byte = IoRead8 (BtPort + BT_BUFFER_REG);
+      if (Index == 1) {
+        Sequence = Byte;
+        continue;
+      }
+
+      if (Count < *DataSize) {
+        Data[Count] = Byte;
+      }
+
+      Count++;
+    }
+
+    IoWrite8 (BtPort + BT_CTRL_REG, BT_CTRL_H_BUSY);
+  } while ((Context != NULL) && (Length >= 4) && (Sequence != *(UINT8 *) Context));
+
+  if (Length < 4) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  if (Count > *DataSize) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  *DataSize = Count;
+
+  return EFI_SUCCESS;
+}
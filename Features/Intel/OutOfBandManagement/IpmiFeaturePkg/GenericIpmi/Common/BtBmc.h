@@ -0,0 +1,118 @@
+/** @file
+  BT Transport Hook head file.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _BT_BMC_H
+#define _BT_BMC_H
+
+#include <Library/BaseLib.h>
+#include <Library/IoLib.h>
+#include <Library/DebugLib.h>
+#include <Library/TimerLib.h>
+
+//
+// BT interface registers, relative to the BT base port
+//
+#define BT_CTRL_REG           0
+#define BT_BUFFER_REG         1
+#define BT_INTMASK_REG        2
+
+//
+// BT_CTRL bits. H2B_ATN is set by writing 1, B2H_ATN and SMS_ATN are cleared
+// by writing 1 and H_BUSY is toggled by writing 1. Writing 0 has no effect.
+//
+#define BT_CTRL_CLR_WR_PTR    BIT0
+#define BT_CTRL_CLR_RD_PTR    BIT1
+#define BT_CTRL_H2B_ATN       BIT2
+#define BT_CTRL_B2H_ATN       BIT3
+#define BT_CTRL_SMS_ATN       BIT4
+#define BT_CTRL_OEM0          BIT5
+#define BT_CTRL_H_BUSY        BIT6
+#define BT_CTRL_B_BUSY        BIT7
+
+//
+// The BT timeout is shared with KCS, so it counts the same delay unit.
+// Polling spins first and then backs off the same way as KCS does.
+//
+#define BT_DELAY_UNIT         50  // [s] Each BT IO delay
+#define BT_SPIN_COUNT         64
+#define BT_MIN_DELAY          1   // [s] First delay after spinning
+
+//
+// The generic layer hands over [NetFn/LUN, Cmd, Data...] and expects
+// [NetFn/LUN, Cmd, CompletionCode, Data...] back. On the wire, BT adds a
+// length byte in front and a sequence number after NetFn/LUN. Context, when
+// not NULL, points to the UINT8 sequence number of the request, and responses
+// with another sequence number are dropped. Otherwise BT_SEQUENCE_NUMBER is
+// used and any response is taken.
+//
+#define BT_SEQUENCE_NUMBER    0
+
+//
+//External Fucntion List
+//
+EFI_STATUS
+SendDataToBtBmcPort (
+  UINT64                                    BtTimeoutPeriod,
+  UINT16                                    BtPort,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     DataSize
+  )
+/*++
+
+Routine Description:
+
+  Send a whole request message to the BMC through the BT FIFO
+
+Arguments:
+
+  BtTimeoutPeriod - The timeout, in units of BT_DELAY_UNIT
+  BtPort          - The base port of BT
+  Context         - The context of this operation
+  Data            - The request, starting with NetFn/LUN
+  DataSize        - The request size
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC did not accept the request in time
+  EFI_SUCCESS      - Send out the data successfully
+
+--*/
+;
+
+EFI_STATUS
+ReceiveBmcDataFromBtPort (
+  UINT64                                    BtTimeoutPeriod,
+  UINT16                                    BtPort,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     *DataSize
+  )
+/*++
+
+Routine Description:
+
+  Receive a whole response message from the BMC through the BT FIFO
+
+Arguments:
+
+  BtTimeoutPeriod - The timeout, in units of BT_DELAY_UNIT
+  BtPort          - The base port of BT
+  Context         - The context of this operation
+  Data            - The buffer pointer
+  DataSize        - On input the buffer size, on output the response size
+
+Returns:
+
+  EFI_DEVICE_ERROR     - The BMC did not respond in time
+  EFI_BUFFER_TOO_SMALL - The response doesn't fit in the buffer
+  EFI_SUCCESS          - Received data successfully
+
+--*/
+;
+
+#endif
@@ -53,181 +53,322 @@ Returns:
   return EFI_SUCCESS;
 }
 
+UINT64
+IpmiBmcElapsedNs (
+  IN UINT64                     StartTicks
+  )
+/*++
+
+Routine Description:
+
+  Get the time elapsed since a performance counter value was read
+
+Arguments:
+
+  StartTicks  - Performance counter value at the start of the interval
+
+Returns:
+
+  Elapsed time in nanoseconds
+
+--*/
+{
+  UINT64  Now;
+  UINT64  CounterStart;
+  UINT64  CounterEnd;
+
+  Now = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  if (CounterEnd < CounterStart) {
+    return GetTimeInNanoSecond (StartTicks - Now);
+  }
+
+  return GetTimeInNanoSecond (Now - StartTicks);
+}
+
+IPMI_TRANSPORT_COMMAND_STATS *
+IpmiBmcCommandStats (
+  IN IPMI_BMC_INSTANCE_DATA     *IpmiInstance,
+  IN UINT8                      NetFunction,
+  IN UINT8                      Command
+  )
+/*++
+
+Routine Description:
+
+  Find the statistics entry of a NetFn/Cmd pair, adding it if it is new
+
+Arguments:
+
+  IpmiInstance  - BMC instance data
+  NetFunction   - Net Function of the command
+  Command       - IPMI command
+
+Returns:
+
+  Pointer to the entry, or NULL if commands are not traced or the table is full
+
+--*/
+{
+  IPMI_TRANSPORT_STATS  *Stats;
+  UINT32                Index;
+
+  Stats = IpmiInstance->Stats;
+  if (Stats == NULL) {
+    return NULL;
+  }
+
+  for (Index = 0; Index < Stats->CommandCount; Index++) {
+    if ((Stats->Command[Index].NetFunction == NetFunction) &&
+        (Stats->Command[Index].Command == Command)) {
+      return &Stats->Command[Index];
+    }
+  }
+
+  if (Stats->CommandCount == IPMI_TRANSPORT_STATS_MAX_COMMANDS) {
+    Stats->Untracked++;
+    return NULL;
+  }
+
+  Stats->Command[Index].NetFunction = NetFunction;
+  Stats->Command[Index].Command     = Command;
+  Stats->CommandCount++;
+  return &Stats->Command[Index];
+}
+
 EFI_STATUS
-EFIAPI
-IpmiSendCommandToBmc (
-  IN      IPMI_TRANSPORT            *This,
+IpmiBmcSendRequest (
+  IN      IPMI_BMC_INSTANCE_DATA        *IpmiInstance,
   IN      UINT8                         NetFunction,
   IN      UINT8                         Lun,
   IN      UINT8                         Command,
   IN      UINT8                         *CommandData,
   IN      UINT8                         CommandDataSize,
-  IN OUT  UINT8                         *ResponseData,
-  IN OUT  UINT8                         *ResponseDataSize,
   IN      VOID                          *Context
   )
 /*++
 
 Routine Description:
 
-  Send IPMI command to BMC
+  Send the request half of an IPMI command to BMC
 
 Arguments:
 
-  This              - Pointer to IPMI protocol instance
+  IpmiInstance      - BMC instance data
   NetFunction       - Net Function of command to send
   Lun               - LUN of command to send
   Command           - IPMI command to send
   CommandData       - Pointer to command data buffer, if needed
   CommandDataSize   - Size of command data buffer
+  Context           - Context
+
+Returns:
+
+  EFI_INVALID_PARAMETER - One of the input values is bad
+  EFI_DEVICE_ERROR      - IPMI command failed
+  EFI_SUCCESS           - Request sent successfully
+
+--*/
+{
+  EFI_STATUS              Status;
+  IPMI_COMMAND            *IpmiCommand;
+  IPMI_TRANSPORT_COMMAND_STATS *Stats;
+  UINT64                  StartTicks;
+
+  //
+  // The TempData buffer is used for both sending command data and receiving
+  // response data.  Since the command format is different from the response
+  // format, the buffer is cast to both structure definitions.
+  //
+  IpmiCommand = (IPMI_COMMAND*) IpmiInstance->TempData;
+
+  //
+  // Send IPMI command to BMC
+  //
+  IpmiCommand->Lun = Lun;
+  IpmiCommand->NetFunction = NetFunction;
+  IpmiCommand->Command = Command;
+
+  //
+  // Ensure that the buffer is valid before attempting to copy the command data
+  // buffer into the IpmiCommand structure.
+  //
+  if (CommandDataSize > 0) {
+    if (CommandData == NULL) {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    CopyMem (
+      IpmiCommand->CommandData,
+      CommandData,
+      CommandDataSize
+      );
+  }
+
+  StartTicks = GetPerformanceCounter ();
+  Status = SendDataToBmcInterface (
+             IpmiInstance->KcsTimeoutPeriod,
+             IpmiInstance->IpmiIoBase,
+             Context,
+             (UINT8 *) IpmiCommand,
+             (CommandDataSize + IPMI_COMMAND_HEADER_SIZE)
+             );
+
+  Stats = IpmiBmcCommandStats (IpmiInstance, NetFunction, Command);
+  if (Stats != NULL) {
+    Stats->Calls++;
+    Stats->SendNs += IpmiBmcElapsedNs (StartTicks);
+    if (Status == EFI_SUCCESS) {
+      Stats->BytesSent += CommandDataSize + IPMI_COMMAND_HEADER_SIZE;
+    } else {
+      Stats->Errors++;
+    }
+  }
+
+  if (Status != EFI_SUCCESS) {
+    IpmiInstance->BmcStatus = BMC_SOFTFAIL;
+    IpmiInstance->SoftErrorCount++;
+  }
+
+  return Status;
+}
+
+EFI_STATUS
+IpmiBmcReceiveResponse (
+  IN      IPMI_BMC_INSTANCE_DATA        *IpmiInstance,
+  IN      UINT8                         NetFunction,
+  IN      UINT8                         Command,
+  IN OUT  UINT8                         *ResponseData,
+  IN OUT  UINT8                         *ResponseDataSize,
+  IN      VOID                          *Context
+  )
+/*++
+
+Routine Description:
+
+  Receive the response half of an IPMI command from BMC
+
+Arguments:
+
+  IpmiInstance      - BMC instance data
+  NetFunction       - Net Function of the command sent
+  Command           - IPMI command sent
   ResponseData      - Pointer to response data buffer
   ResponseDataSize  - Pointer to response data buffer size
   Context           - Context
 
 Returns:
 
-  EFI_INVALID_PARAMETER - One of the input values is bad
   EFI_DEVICE_ERROR      - IPMI command failed
   EFI_BUFFER_TOO_SMALL  - Response buffer is too small
   EFI_UNSUPPORTED       - Command is not supported by BMC
+  EFI_NOT_FOUND         - The response doesn't belong to the command, it
+                          should be sent again
   EFI_SUCCESS           - Command completed successfully
 
 --*/
 {
-  IPMI_BMC_INSTANCE_DATA  *IpmiInstance;
   UINT8                   DataSize;
   EFI_STATUS              Status;
-  IPMI_COMMAND            *IpmiCommand;
   IPMI_RESPONSE           *IpmiResponse;
-  UINT8                   RetryCnt = IPMI_SEND_COMMAND_MAX_RETRY;
   UINT8                   Index;
+  IPMI_TRANSPORT_COMMAND_STATS *Stats;
+  UINT64                  StartTicks;
+  UINT64                  ElapsedNs;
 
-  IpmiInstance = INSTANCE_FROM_SM_IPMI_BMC_THIS (This);
-
-  while (RetryCnt--) {
-    //
-    // The TempData buffer is used for both sending command data and receiving
-    // response data.  Since the command format is different from the response
-    // format, the buffer is cast to both structure definitions.
-    //
-    IpmiCommand  = (IPMI_COMMAND*)  IpmiInstance->TempData;
-    IpmiResponse = (IPMI_RESPONSE*) IpmiInstance->TempData;
-
-    //
-    // Send IPMI command to BMC
-    //
-    IpmiCommand->Lun = Lun;
-    IpmiCommand->NetFunction = NetFunction;
-    IpmiCommand->Command = Command;
-
-    //
-    // Ensure that the buffer is valid before attempting to copy the command data
-    // buffer into the IpmiCommand structure.
-    //
-    if (CommandDataSize > 0) {
-      if (CommandData == NULL) {
-        return EFI_INVALID_PARAMETER;
-      }
+  IpmiResponse = (IPMI_RESPONSE*) IpmiInstance->TempData;
 
-      CopyMem (
-        IpmiCommand->CommandData,
-        CommandData,
-        CommandDataSize
-        );
+  //
+  // Get Response to IPMI Command from BMC.
+  // Subtract 1 from DataSize so memory past the end of the buffer can't be written
+  //
+  DataSize = MAX_TEMP_DATA - 1;
+  StartTicks = GetPerformanceCounter ();
+  Status = ReceiveBmcDataFromInterface (
+             IpmiInstance->KcsTimeoutPeriod,
+             IpmiInstance->IpmiIoBase,
+             Context,
+             (UINT8 *) IpmiResponse,
+             &DataSize
+             );
+
+  Stats = IpmiBmcCommandStats (IpmiInstance, NetFunction, Command);
+  if (Stats != NULL) {
+    ElapsedNs = IpmiBmcElapsedNs (StartTicks);
+    Stats->ReceiveNs += ElapsedNs;
+    Stats->MaxReceiveNs = MAX (Stats->MaxReceiveNs, ElapsedNs);
+    if (Status == EFI_SUCCESS) {
+      Stats->BytesReceived += DataSize;
+    } else {
+      Stats->Errors++;
     }
+  }
 
-    Status = SendDataToBmcPort (
-               IpmiInstance->KcsTimeoutPeriod,
-               IpmiInstance->IpmiIoBase,
-               Context,
-               (UINT8 *) IpmiCommand,
-               (CommandDataSize + IPMI_COMMAND_HEADER_SIZE)
-               );
+  if (Status != EFI_SUCCESS) {
+    IpmiInstance->BmcStatus = BMC_SOFTFAIL;
+    IpmiInstance->SoftErrorCount++;
+    return Status;
+  }
 
-    if (Status != EFI_SUCCESS) {
-      IpmiInstance->BmcStatus = BMC_SOFTFAIL;
-      IpmiInstance->SoftErrorCount++;
-      return Status;
+  //
+  // If we got this far without any error codes, but the DataSize less than IPMI_RESPONSE_HEADER_SIZE, then the
+  // command response failed, so do not continue.
+  //
+  if (DataSize < IPMI_RESPONSE_HEADER_SIZE) {
+    if (Stats != NULL) {
+      Stats->Errors++;
     }
+    return EFI_DEVICE_ERROR;
+  }
 
+  if ((IpmiResponse->CompletionCode != COMP_CODE_NORMAL) &&
+      (IpmiInstance->BmcStatus == BMC_UPDATE_IN_PROGRESS)) {
     //
-    // Get Response to IPMI Command from BMC.
-    // Subtract 1 from DataSize so memory past the end of the buffer can't be written
+    // If the completion code is not normal and the BMC is in Force Update
+    // mode, then update the error status and return EFI_UNSUPPORTED.
     //
-    DataSize = MAX_TEMP_DATA - 1;
-    Status = ReceiveBmcDataFromPort (
-               IpmiInstance->KcsTimeoutPeriod,
-               IpmiInstance->IpmiIoBase,
-               Context,
-               (UINT8 *) IpmiResponse,
-               &DataSize
-               );
-
-    if (Status != EFI_SUCCESS) {
-      IpmiInstance->BmcStatus = BMC_SOFTFAIL;
-      IpmiInstance->SoftErrorCount++;
-      return Status;
-    }
-
+    UpdateErrorStatus (
+      IpmiResponse->CompletionCode,
+      IpmiInstance
+      );
+    return EFI_UNSUPPORTED;
+  } else if (IpmiResponse->CompletionCode != COMP_CODE_NORMAL) {
+    //
+    // Otherwise if the BMC is in normal mode, but the completion code
+    // is not normal, then update the error status and return device error.
+    //
+    UpdateErrorStatus (
+      IpmiResponse->CompletionCode,
+      IpmiInstance
+      );
     //
-    // If we got this far without any error codes, but the DataSize less than IPMI_RESPONSE_HEADER_SIZE, then the
-    // command response failed, so do not continue.
+    // Intel Server System Integrated Baseboard Management Controller (BMC) Firmware v0.62
+    // D4h C Insufficient privilege, in KCS channel this indicates KCS Policy Control Mode is Deny All.
+    // In authenticated channels this indicates invalid authentication/privilege.
     //
-    if (DataSize < IPMI_RESPONSE_HEADER_SIZE) {
+    if (IpmiResponse->CompletionCode == COMP_INSUFFICIENT_PRIVILEGE) {
+      return EFI_SECURITY_VIOLATION;
+    } else {
       return EFI_DEVICE_ERROR;
     }
+  }
 
-    if ((IpmiResponse->CompletionCode != COMP_CODE_NORMAL) &&
-        (IpmiInstance->BmcStatus == BMC_UPDATE_IN_PROGRESS)) {
-      //
-      // If the completion code is not normal and the BMC is in Force Update
-      // mode, then update the error status and return EFI_UNSUPPORTED.
-      //
-      UpdateErrorStatus (
-        IpmiResponse->CompletionCode,
-        IpmiInstance
-        );
-      return EFI_UNSUPPORTED;
-    } else if (IpmiResponse->CompletionCode != COMP_CODE_NORMAL) {
-      //
-      // Otherwise if the BMC is in normal mode, but the completion code
-      // is not normal, then update the error status and return device error.
-      //
-      UpdateErrorStatus (
-        IpmiResponse->CompletionCode,
-        IpmiInstance
-        );
-      //
-      // Intel Server System Integrated Baseboard Management Controller (BMC) Firmware v0.62
-      // D4h C Insufficient privilege, in KCS channel this indicates KCS Policy Control Mode is Deny All.
-      // In authenticated channels this indicates invalid authentication/privilege.
-      //
-      if (IpmiResponse->CompletionCode == COMP_INSUFFICIENT_PRIVILEGE) {
-        return EFI_SECURITY_VIOLATION;
-      } else {
-        return EFI_DEVICE_ERROR;
-      }
-    }
-
+  //
+  // Verify the response data buffer passed in is big enough.
+  //
+  if ((DataSize - IPMI_RESPONSE_HEADER_SIZE) > *ResponseDataSize) {
     //
-    // Verify the response data buffer passed in is big enough.
+    //Verify the response data matched with the cmd sent.
     //
-    if ((DataSize - IPMI_RESPONSE_HEADER_SIZE) > *ResponseDataSize) {
-      //
-      //Verify the response data matched with the cmd sent.
-      //
-      if ((IpmiResponse->NetFunction != (NetFunction | 0x1)) || (IpmiResponse->Command != Command)) {
-        if (0 == RetryCnt) {
-          return EFI_DEVICE_ERROR;
-        } else {
-          continue;
-        }
+    if ((IpmiResponse->NetFunction != (NetFunction | 0x1)) || (IpmiResponse->Command != Command)) {
+      if (Stats != NULL) {
+        Stats->Retries++;
       }
-      return EFI_BUFFER_TOO_SMALL;
+      return EFI_NOT_FOUND;
     }
-
-    break;
+    return EFI_BUFFER_TOO_SMALL;
   }
+
   //
   // Copy data over to the response data buffer.
   //
@@ -251,6 +392,155 @@ Returns:
   return EFI_SUCCESS;
 }
 
+EFI_STATUS
+EFIAPI
+IpmiSendCommandToBmc (
+  IN      IPMI_TRANSPORT            *This,
+  IN      UINT8                         NetFunction,
+  IN      UINT8                         Lun,
+  IN      UINT8                         Command,
+  IN      UINT8                         *CommandData,
+  IN      UINT8                         CommandDataSize,
+  IN OUT  UINT8                         *ResponseData,
+  IN OUT  UINT8                         *ResponseDataSize,
+  IN      VOID                          *Context
+  )
+/*++
+
+Routine Description:
+
+  Send IPMI command to BMC
+
+Arguments:
+
+  This              - Pointer to IPMI protocol instance
+  NetFunction       - Net Function of command to send
+  Lun               - LUN of command to send
+  Command           - IPMI command to send
+  CommandData       - Pointer to command data buffer, if needed
+  CommandDataSize   - Size of command data buffer
+  ResponseData      - Pointer to response data buffer
+  ResponseDataSize  - Pointer to response data buffer size
+  Context           - Context
+
+Returns:
+
+  EFI_INVALID_PARAMETER - One of the input values is bad
+  EFI_DEVICE_ERROR      - IPMI command failed
+  EFI_BUFFER_TOO_SMALL  - Response buffer is too small
+  EFI_UNSUPPORTED       - Command is not supported by BMC
+  EFI_SUCCESS           - Command completed successfully
+
+--*/
+{
+  IPMI_BMC_INSTANCE_DATA  *IpmiInstance;
+  EFI_STATUS              Status;
+  CHAR8                   PerfToken[sizeof ("IpmiCmd 00:00")];
+
+  IpmiInstance = INSTANCE_FROM_SM_IPMI_BMC_THIS (This);
+
+  //
+  // Log each command as an FPDT in-module measurement named after its NetFn
+  // and Cmd.
+  //
+  AsciiSPrint (PerfToken, sizeof (PerfToken), "IpmiCmd %02x:%02x", NetFunction, Command);
+  PERF_INMODULE_BEGIN (PerfToken);
+  Status = IpmiBmcSendReceive (
+             IpmiInstance,
+             NetFunction,
+             Lun,
+             Command,
+             CommandData,
+             CommandDataSize,
+             ResponseData,
+             ResponseDataSize,
+             Context
+             );
+  PERF_INMODULE_END (PerfToken);
+
+  return Status;
+}
+
+EFI_STATUS
+IpmiBmcSendReceive (
+  IN      IPMI_BMC_INSTANCE_DATA        *IpmiInstance,
+  IN      UINT8                         NetFunction,
+  IN      UINT8                         Lun,
+  IN      UINT8                         Command,
+  IN      UINT8                         *CommandData,
+  IN      UINT8                         CommandDataSize,
+  IN OUT  UINT8                         *ResponseData,
+  IN OUT  UINT8                         *ResponseDataSize,
+  IN      VOID                          *Context
+  )
+/*++
+
+Routine Description:
+
+  Send IPMI command to BMC and wait for its response, sending it again if
+  the BMC answers a different command
+
+Arguments:
+
+  IpmiInstance      - BMC instance data
+  NetFunction       - Net Function of command to send
+  Lun               - LUN of command to send
+  Command           - IPMI command to send
+  CommandData       - Pointer to command data buffer, if needed
+  CommandDataSize   - Size of command data buffer
+  ResponseData      - Pointer to response data buffer
+  ResponseDataSize  - Pointer to response data buffer size
+  Context           - Context
+
+Returns:
+
+  EFI_INVALID_PARAMETER - One of the input values is bad
+  EFI_DEVICE_ERROR      - IPMI command failed
+  EFI_BUFFER_TOO_SMALL  - Response buffer is too small
+  EFI_UNSUPPORTED       - Command is not supported by BMC
+  EFI_SUCCESS           - Command completed successfully
+
+--*/
+{
+  EFI_STATUS              Status;
+  UINT8                   RetryCnt = IPMI_SEND_COMMAND_MAX_RETRY;
+
+  while (RetryCnt--) {
+    Status = IpmiBmcSendRequest (
+               IpmiInstance,
+               NetFunction,
+               Lun,
+               Command,
+               CommandData,
+               CommandDataSize,
+               Context
+               );
+    if (Status != EFI_SUCCESS) {
+      return Status;
+    }
+
+    Status = IpmiBmcReceiveResponse (
+               IpmiInstance,
+               NetFunction,
+               Command,
+               ResponseData,
+               ResponseDataSize,
+               Context
+               );
+    if (Status == EFI_NOT_FOUND) {
+      if (0 == RetryCnt) {
+        return EFI_DEVICE_ERROR;
+      } else {
+        continue;
+      }
+    }
+
+    return Status;
+  }
+
+  return EFI_DEVICE_ERROR;
+}
+
 
 EFI_STATUS
 EFIAPI
@@ -18,12 +18,15 @@
 #include <Library/UefiLib.h>
 #include <Library/BaseLib.h>
 #include <Library/IoLib.h>
+#include <Library/TimerLib.h>
+#include <Library/PrintLib.h>
+#include <Library/PerformanceLib.h>
 #include <Library/ReportStatusCodeLib.h>
 #include <Library/IpmiBaseLib.h>
 #include <Protocol/IpmiTransportProtocol.h>
 
 #include "IpmiBmcCommon.h"
-#include "KcsBmc.h"
+#include "IpmiInterface.h"
 
 
 #define BMC_KCS_TIMEOUT  5   // [s] Single KSC request timeout
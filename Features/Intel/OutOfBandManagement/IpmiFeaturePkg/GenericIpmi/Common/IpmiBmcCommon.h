@@ -9,6 +9,8 @@
 #ifndef _IPMI_COMMON_BMC_H_
 #define _IPMI_COMMON_BMC_H_
 
+#include <Protocol/IpmiTransportStats.h>
+
 #define MAX_TEMP_DATA     255 // 160 Modified to increase number of bytes transfered per command
 #define BMC_SLAVE_ADDRESS 0x20
 #define MAX_SOFT_COUNT    10
@@ -57,6 +59,7 @@ typedef struct {
   UINT16              IpmiIoBase;
   IPMI_TRANSPORT      IpmiTransport;
   EFI_HANDLE          IpmiSmmHandle;
+  IPMI_TRANSPORT_STATS *Stats;          // NULL if commands are not traced
 } IPMI_BMC_INSTANCE_DATA;
 
 //
@@ -125,6 +128,119 @@ Returns:
 --*/
 ;
 
+EFI_STATUS
+IpmiBmcSendRequest (
+  IN      IPMI_BMC_INSTANCE_DATA        *IpmiInstance,
+  IN      UINT8                         NetFunction,
+  IN      UINT8                         Lun,
+  IN      UINT8                         Command,
+  IN      UINT8                         *CommandData,
+  IN      UINT8                         CommandDataSize,
+  IN      VOID                          *Context
+  )
+/*++
+
+Routine Description:
+
+  Send the request half of an IPMI command to BMC
+
+Arguments:
+
+  IpmiInstance      - BMC instance data
+  NetFunction       - Net Function of command to send
+  Lun               - LUN of command to send
+  Command           - IPMI command to send
+  CommandData       - Pointer to command data buffer, if needed
+  CommandDataSize   - Size of command data buffer
+  Context           - Context
+
+Returns:
+
+  EFI_INVALID_PARAMETER - One of the input values is bad
+  EFI_DEVICE_ERROR      - IPMI command failed
+  EFI_SUCCESS           - Request sent successfully
+
+--*/
+;
+
+EFI_STATUS
+IpmiBmcReceiveResponse (
+  IN      IPMI_BMC_INSTANCE_DATA        *IpmiInstance,
+  IN      UINT8                         NetFunction,
+  IN      UINT8                         Command,
+  IN OUT  UINT8                         *ResponseData,
+  IN OUT  UINT8                         *ResponseDataSize,
+  IN      VOID                          *Context
+  )
+/*++
+
+Routine Description:
+
+  Receive the response half of an IPMI command from BMC
+
+Arguments:
+
+  IpmiInstance      - BMC instance data
+  NetFunction       - Net Function of the command sent
+  Command           - IPMI command sent
+  ResponseData      - Pointer to response data buffer
+  ResponseDataSize  - Pointer to response data buffer size
+  Context           - Context
+
+Returns:
+
+  EFI_DEVICE_ERROR      - IPMI command failed
+  EFI_BUFFER_TOO_SMALL  - Response buffer is too small
+  EFI_UNSUPPORTED       - Command is not supported by BMC
+  EFI_NOT_FOUND         - The response doesn't belong to the command, it
+                          should be sent again
+  EFI_SUCCESS           - Command completed successfully
+
+--*/
+;
+
+EFI_STATUS
+IpmiBmcSendReceive (
+  IN      IPMI_BMC_INSTANCE_DATA        *IpmiInstance,
+  IN      UINT8                         NetFunction,
+  IN      UINT8                         Lun,
+  IN      UINT8                         Command,
+  IN      UINT8                         *CommandData,
+  IN      UINT8                         CommandDataSize,
+  IN OUT  UINT8                         *ResponseData,
+  IN OUT  UINT8                         *ResponseDataSize,
+  IN      VOID                          *Context
+  )
+/*++
+
+Routine Description:
+
+  Send IPMI command to BMC and wait for its response, sending it again if
+  the BMC answers a different command
+
+Arguments:
+
+  IpmiInstance      - BMC instance data
+  NetFunction       - Net Function of command to send
+  Lun               - LUN of command to send
+  Command           - IPMI command to send
+  CommandData       - Pointer to command data buffer, if needed
+  CommandDataSize   - Size of command data buffer
+  ResponseData      - Pointer to response data buffer
+  ResponseDataSize  - Pointer to response data buffer size
+  Context           - Context
+
+Returns:
+
+  EFI_INVALID_PARAMETER - One of the input values is bad
+  EFI_DEVICE_ERROR      - IPMI command failed
+  EFI_BUFFER_TOO_SMALL  - Response buffer is too small
+  EFI_UNSUPPORTED       - Command is not supported by BMC
+  EFI_SUCCESS           - Command completed successfully
+
+--*/
+;
+
 
 EFI_STATUS
 EFIAPI
@@ -0,0 +1,142 @@
+/** @file
+  IPMI system interface selection.
+
+  KCS moves one byte per handshake. BT moves a whole message through its
+  FIFO and SSIF moves up to 32 bytes per SMBus transfer, which makes large
+  responses such as FRU reads and SEL dumps much cheaper. The interface is
+  picked at build time with PcdIpmiInterfaceType.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "IpmiInterface.h"
+
+EFI_STATUS
+SendDataToBmcInterface (
+  UINT64                                    TimeoutPeriod,
+  UINT16                                    IoBase,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     DataSize
+  )
+/*++
+
+Routine Description:
+
+  Send a request message to the BMC through the interface selected by
+  PcdIpmiInterfaceType
+
+Arguments:
+
+  TimeoutPeriod - The timeout, in units of KCS_DELAY_UNIT
+  IoBase        - The base port of KCS or BT, unused for SSIF
+  Context       - The context of this operation
+  Data          - The request, starting with NetFn/LUN
+  DataSize      - The request size
+
+Returns:
+
+  EFI_UNSUPPORTED - PcdIpmiInterfaceType is not a known interface
+  EFI_SUCCESS     - Send out the data successfully
+
+--*/
+{
+  switch (FixedPcdGet8 (PcdIpmiInterfaceType)) {
+  case IPMI_INTERFACE_KCS:
+    return SendDataToBmcPort (TimeoutPeriod, IoBase, Context, Data, DataSize);
+
+  case IPMI_INTERFACE_BT:
+    return SendDataToBtBmcPort (TimeoutPeriod, IoBase, Context, Data, DataSize);
+
+  case IPMI_INTERFACE_SSIF:
+    return SendDataToSsifBmc (TimeoutPeriod, FixedPcdGet8 (PcdIpmiSsifSmbusSlaveAddr), Context, Data, DataSize);
+
+  default:
+    return EFI_UNSUPPORTED;
+  }
+}
+
+EFI_STATUS
+ReceiveBmcDataFromInterface (
+  UINT64                                    TimeoutPeriod,
+  UINT16                                    IoBase,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     *DataSize
+  )
+/*++
+
+Routine Description:
+
+  Receive a response message from the BMC through the interface selected by
+  PcdIpmiInterfaceType
+
+Arguments:
+
+  TimeoutPeriod - The timeout, in units of KCS_DELAY_UNIT
+  IoBase        - The base port of KCS or BT, unused for SSIF
+  Context       - The context of this operation
+  Data          - The buffer pointer
+  DataSize      - On input the buffer size, on output the response size
+
+Returns:
+
+  EFI_UNSUPPORTED - PcdIpmiInterfaceType is not a known interface
+  EFI_SUCCESS     - Received data successfully
+
+--*/
+{
+  switch (FixedPcdGet8 (PcdIpmiInterfaceType)) {
+  case IPMI_INTERFACE_KCS:
+    return ReceiveBmcDataFromPort (TimeoutPeriod, IoBase, Context, Data, DataSize);
+
+  case IPMI_INTERFACE_BT:
+    return ReceiveBmcDataFromBtPort (TimeoutPeriod, IoBase, Context, Data, DataSize);
+
+  case IPMI_INTERFACE_SSIF:
+    return ReceiveBmcDataFromSsif (TimeoutPeriod, FixedPcdGet8 (PcdIpmiSsifSmbusSlaveAddr), Context, Data, DataSize);
+
+  default:
+    return EFI_UNSUPPORTED;
+  }
+}
+
+BOOLEAN
+BmcResponseReadyOnInterface (
+  UINT16                                    IoBase
+  )
+/*++
+
+Routine Description:
+
+  Check, without waiting, whether the BMC has a response ready after a
+  request was sent
+
+Arguments:
+
+  IoBase        - The base port of KCS or BT, unused for SSIF
+
+Returns:
+
+  TRUE          - The response is ready, the BMC is gone, or the interface
+                  can't tell without reading the response
+  FALSE         - The BMC is still working on the request
+
+--*/
+{
+  UINT8   Status;
+
+  switch (FixedPcdGet8 (PcdIpmiInterfaceType)) {
+  case IPMI_INTERFACE_KCS:
+    Status = IoRead8 (IoBase + 1);
+    return (BOOLEAN) ((Status == 0xFF) || ((Status & KCS_STATUS_OBF) != 0));
+
+  case IPMI_INTERFACE_BT:
+    Status = IoRead8 (IoBase + BT_CTRL_REG);
+    return (BOOLEAN) ((Status == 0xFF) || ((Status & BT_CTRL_B2H_ATN) != 0));
+
+  default:
+    return TRUE;
+  }
+}
@@ -0,0 +1,110 @@
+/** @file
+  IPMI system interface selection head file.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _IPMI_INTERFACE_H
+#define _IPMI_INTERFACE_H
+
+#include <Library/PcdLib.h>
+
+#include "KcsBmc.h"
+#include "BtBmc.h"
+#include "SsifBmc.h"
+
+//
+// Values of PcdIpmiInterfaceType
+//
+#define IPMI_INTERFACE_KCS    0
+#define IPMI_INTERFACE_BT     1
+#define IPMI_INTERFACE_SSIF   2
+
+EFI_STATUS
+SendDataToBmcInterface (
+  UINT64                                    TimeoutPeriod,
+  UINT16                                    IoBase,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     DataSize
+  )
+/*++
+
+Routine Description:
+
+  Send a request message to the BMC through the interface selected by
+  PcdIpmiInterfaceType
+
+Arguments:
+
+  TimeoutPeriod - The timeout, in units of KCS_DELAY_UNIT
+  IoBase        - The base port of KCS or BT, unused for SSIF
+  Context       - The context of this operation
+  Data          - The request, starting with NetFn/LUN
+  DataSize      - The request size
+
+Returns:
+
+  EFI_UNSUPPORTED - PcdIpmiInterfaceType is not a known interface
+  EFI_SUCCESS     - Send out the data successfully
+
+--*/
+;
+
+EFI_STATUS
+ReceiveBmcDataFromInterface (
+  UINT64                                    TimeoutPeriod,
+  UINT16                                    IoBase,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     *DataSize
+  )
+/*++
+
+Routine Description:
+
+  Receive a response message from the BMC through the interface selected by
+  PcdIpmiInterfaceType
+
+Arguments:
+
+  TimeoutPeriod - The timeout, in units of KCS_DELAY_UNIT
+  IoBase        - The base port of KCS or BT, unused for SSIF
+  Context       - The context of this operation
+  Data          - The buffer pointer
+  DataSize      - On input the buffer size, on output the response size
+
+Returns:
+
+  EFI_UNSUPPORTED - PcdIpmiInterfaceType is not a known interface
+  EFI_SUCCESS     - Received data successfully
+
+--*/
+;
+
+BOOLEAN
+BmcResponseReadyOnInterface (
+  UINT16                                    IoBase
+  )
+/*++
+
+Routine Description:
+
+  Check, without waiting, whether the BMC has a response ready after a
+  request was sent
+
+Arguments:
+
+  IoBase        - The base port of KCS or BT, unused for SSIF
+
+Returns:
+
+  TRUE          - The response is ready, the BMC is gone, or the interface
+                  can't tell without reading the response
+  FALSE         - The BMC is still working on the request
+
+--*/
+;
+
+#endif
@@ -8,6 +8,73 @@
 
 #include "KcsBmc.h"
 
+STATIC
+EFI_STATUS
+KcsWaitStatus (
+  UINT64                            KcsTimeoutPeriod,
+  UINT16                            KcsPort,
+  UINT8                             Mask,
+  UINT8                             Value,
+  KCS_STATUS                        *KcsStatus
+  )
+/*++
+
+Routine Description:
+
+  Wait until the bits of the KCS status selected by Mask are equal to Value.
+  Spins on the status register first, then backs off exponentially up to
+  KCS_DELAY_UNIT between reads.
+
+Arguments:
+
+  KcsTimeoutPeriod - The timeout, in units of KCS_DELAY_UNIT
+  KcsPort          - The base port of KCS
+  Mask             - The status bits to check
+  Value            - The value the status bits must have
+  KcsStatus        - The last status read
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC is not present, or the status didn't change in time
+  EFI_SUCCESS      - The status bits have the expected value
+
+--*/
+{
+  UINT64          Waited;
+  UINT64          Timeout;
+  UINTN           Delay;
+  UINTN           Spin;
+
+  Timeout = MultU64x32 (KcsTimeoutPeriod, KCS_DELAY_UNIT);
+  Waited  = 0;
+  Delay   = KCS_MIN_DELAY;
+  Spin    = 0;
+
+  while (TRUE) {
+    KcsStatus->RawData = IoRead8 (KcsPort + 1);
+    if (KcsStatus->RawData == 0xFF) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    if ((KcsStatus->RawData & Mask) == Value) {
+      return EFI_SUCCESS;
+    }
+
+    if (Spin < KCS_SPIN_COUNT) {
+      Spin++;
+      continue;
+    }
+
+    if (Waited >= Timeout) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    MicroSecondDelay (Delay);
+    Waited += Delay;
+    Delay   = MIN (Delay * 2, KCS_DELAY_UNIT);
+  }
+}
+
 EFI_STATUS
 KcsErrorExit (
   UINT64                            KcsTimeoutPeriod,
@@ -37,96 +104,55 @@ Returns:
   UINT8           KcsData;
   KCS_STATUS      KcsStatus;
   UINT8           RetryCount;
-  UINT64          TimeOut;
 
-  TimeOut     = 0;
   RetryCount  = 0;
   while (RetryCount < KCS_ABORT_RETRY_COUNT) {
 
-    TimeOut = 0;
-    do {
-      MicroSecondDelay (KCS_DELAY_UNIT);
-      KcsStatus.RawData = IoRead8 (KcsPort + 1);
-      if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-        RetryCount = KCS_ABORT_RETRY_COUNT;
-        break;
-      }
-      TimeOut++;
-    } while (KcsStatus.Status.Ibf);
-
-    if (RetryCount >= KCS_ABORT_RETRY_COUNT) {
+    Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_IBF, 0, &KcsStatus);
+    if (EFI_ERROR (Status)) {
+      RetryCount = KCS_ABORT_RETRY_COUNT;
       break;
     }
 
     KcsData = KCS_ABORT;
     IoWrite8 ((KcsPort + 1), KcsData);
 
-    TimeOut = 0;
-    do {
-      MicroSecondDelay (KCS_DELAY_UNIT);
-      KcsStatus.RawData = IoRead8 (KcsPort + 1);
-      if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-        Status = EFI_DEVICE_ERROR;
-        goto LabelError;
-      }
-      TimeOut++;
-    } while (KcsStatus.Status.Ibf);
+    Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_IBF, 0, &KcsStatus);
+    if (EFI_ERROR (Status)) {
+      goto LabelError;
+    }
 
     KcsData = IoRead8 (KcsPort);
 
     KcsData = 0x0;
     IoWrite8 (KcsPort, KcsData);
 
-    TimeOut = 0;
-    do {
-      MicroSecondDelay (KCS_DELAY_UNIT);
-      KcsStatus.RawData = IoRead8 (KcsPort + 1);
-      if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-        Status = EFI_DEVICE_ERROR;
-        goto LabelError;
-      }
-      TimeOut++;
-    } while (KcsStatus.Status.Ibf);
+    Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_IBF, 0, &KcsStatus);
+    if (EFI_ERROR (Status)) {
+      goto LabelError;
+    }
 
     if (KcsStatus.Status.State == KcsReadState) {
-      TimeOut = 0;
-      do {
-        MicroSecondDelay (KCS_DELAY_UNIT);
-        KcsStatus.RawData = IoRead8 (KcsPort + 1);
-        if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-          Status = EFI_DEVICE_ERROR;
-          goto LabelError;
-        }
-        TimeOut++;
-      } while (!KcsStatus.Status.Obf);
+      Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_OBF, KCS_STATUS_OBF, &KcsStatus);
+      if (EFI_ERROR (Status)) {
+        goto LabelError;
+      }
 
       IoRead8 (KcsPort);
 
       KcsData = KCS_READ;
       IoWrite8 (KcsPort, KcsData);
 
-      TimeOut = 0;
-      do {
-        MicroSecondDelay (KCS_DELAY_UNIT);
-        KcsStatus.RawData = IoRead8 (KcsPort + 1);
-        if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-          Status = EFI_DEVICE_ERROR;
-          goto LabelError;
-        }
-        TimeOut++;
-      } while (KcsStatus.Status.Ibf);
+      Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_IBF, 0, &KcsStatus);
+      if (EFI_ERROR (Status)) {
+        goto LabelError;
+      }
 
       if (KcsStatus.Status.State == KcsIdleState) {
-        TimeOut = 0;
-        do {
-          MicroSecondDelay (KCS_DELAY_UNIT);
-          KcsStatus.RawData = IoRead8 (KcsPort + 1);
-          if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-            Status = EFI_DEVICE_ERROR;
-            goto LabelError;
-          }
-          TimeOut++;
-        } while (!KcsStatus.Status.Obf);
+        Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_OBF, KCS_STATUS_OBF, &KcsStatus);
+        if (EFI_ERROR (Status)) {
+          goto LabelError;
+        }
 
         KcsData = IoRead8 (KcsPort);
         break;
@@ -183,7 +209,6 @@ Returns:
 {
   EFI_STATUS      Status;
   KCS_STATUS      KcsStatus;
-  UINT64          TimeOut;
 
   if (Idle == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -191,16 +216,10 @@ Returns:
 
   *Idle = FALSE;
 
-  TimeOut = 0;
-  do {
-    MicroSecondDelay (KCS_DELAY_UNIT);
-    KcsStatus.RawData = IoRead8 (KcsPort + 1);
-    if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-      Status = EFI_DEVICE_ERROR;
-      goto LabelError;
-    }
-    TimeOut++;
-  } while (KcsStatus.Status.Ibf);
+  Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_IBF, 0, &KcsStatus);
+  if (EFI_ERROR (Status)) {
+    goto LabelError;
+  }
 
   if (KcsState == KcsWriteState) {
     IoRead8 (KcsPort);
@@ -216,16 +235,10 @@ Returns:
   }
 
   if (KcsState == KcsReadState) {
-    TimeOut = 0;
-    do {
-      MicroSecondDelay (KCS_DELAY_UNIT);
-      KcsStatus.RawData = IoRead8 (KcsPort + 1);
-      if (KcsStatus.RawData == 0xFF || (TimeOut >= KcsTimeoutPeriod)) {
-        Status = EFI_DEVICE_ERROR;
-        goto LabelError;
-      }
-      TimeOut++;
-    } while (!KcsStatus.Status.Obf);
+    Status = KcsWaitStatus (KcsTimeoutPeriod, KcsPort, KCS_STATUS_OBF, KCS_STATUS_OBF, &KcsStatus);
+    if (EFI_ERROR (Status)) {
+      goto LabelError;
+    }
   }
 
   if (KcsState == KcsWriteState || (*Idle == TRUE)) {
@@ -271,22 +284,18 @@ Returns:
   EFI_STATUS      Status;
   UINT8           i;
   BOOLEAN         Idle;
-  UINT64          TimeOut;
 
   KcsIoBase = KcsPort;
 
-  TimeOut = 0;
-
-  do {
-    MicroSecondDelay (KCS_DELAY_UNIT);
-    KcsStatus.RawData = IoRead8 (KcsIoBase + 1);
-    if ((KcsStatus.RawData == 0xFF) || (TimeOut >= KcsTimeoutPeriod)) {
-      if ((Status = KcsErrorExit (KcsTimeoutPeriod, KcsIoBase, Context)) != EFI_SUCCESS) {
-        return Status;
-      }
+  //
+  // If the BMC doesn't get ready, abort whatever it is doing
+  //
+  Status = KcsWaitStatus (KcsTimeoutPeriod, KcsIoBase, KCS_STATUS_IBF, 0, &KcsStatus);
+  if (EFI_ERROR (Status)) {
+    if ((Status = KcsErrorExit (KcsTimeoutPeriod, KcsIoBase, Context)) != EFI_SUCCESS) {
+      return Status;
     }
-    TimeOut++;
-  } while (KcsStatus.Status.Ibf);
+  }
 
   KcsData = KCS_WRITE_START;
   IoWrite8 ((KcsIoBase + 1), KcsData);
@@ -21,6 +21,16 @@
 #define KCS_ABORT             0x60
 #define KCS_DELAY_UNIT        50  // [s] Each KSC IO delay
 
+//
+// The BMC usually updates the KCS status within a few microseconds, so the
+// status register is first read back to back KCS_SPIN_COUNT times. After that
+// the delay between reads starts at KCS_MIN_DELAY and doubles up to
+// KCS_DELAY_UNIT, so a busy BMC isn't polled more often than it used to be.
+// The timeouts still count KCS_DELAY_UNIT steps.
+//
+#define KCS_SPIN_COUNT        64
+#define KCS_MIN_DELAY         1   // [s] First delay after spinning
+
 //
 // In OpenBMC, UpdateMode: the bit 7 of byte 4 in get device id command is used for the BMC status:
 // 0 means BMC is ready, 1 means BMC is not ready.
@@ -40,6 +50,9 @@ typedef enum {
   KcsErrorState
 } KCS_STATE;
 
+#define KCS_STATUS_OBF        BIT0
+#define KCS_STATUS_IBF        BIT1
+
 typedef union {
   UINT8     RawData;
   struct {
@@ -0,0 +1,273 @@
+/** @file
+  SSIF Transport Hook.
+
+  The SMBus System Interface moves up to SSIF_BLOCK_SIZE bytes per SMBus
+  block transfer, so large requests and responses take a few transactions.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "SsifBmc.h"
+
+STATIC
+EFI_STATUS
+SsifBlockWrite (
+  UINT64                            SsifTimeoutPeriod,
+  UINT8                             SsifSlaveAddress,
+  UINT8                             SsifCommand,
+  UINT8                             *Data,
+  UINT8                             DataSize
+  )
+/*++
+
+Routine Description:
+
+  Do one SMBus block write, retrying while the BMC NAKs it.
+
+Arguments:
+
+  SsifTimeoutPeriod - The timeout, in units of SSIF_DELAY_UNIT
+  SsifSlaveAddress  - The 7-bit SMBus address of the BMC
+  SsifCommand       - The SSIF command
+  Data              - The block data
+  DataSize          - The block size, 1 to SSIF_BLOCK_SIZE
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC did not accept the block in time
+  EFI_SUCCESS      - The block was written
+
+--*/
+{
+  RETURN_STATUS   Status;
+  UINT64          Waited;
+  UINT64          Timeout;
+
+  Timeout = MultU64x32 (SsifTimeoutPeriod, SSIF_DELAY_UNIT);
+  Waited  = 0;
+
+  while (TRUE) {
+    SmBusBlockWrite (
+      SMBUS_LIB_ADDRESS (SsifSlaveAddress, SsifCommand, DataSize, FALSE),
+      Data,
+      &Status
+      );
+    if (!RETURN_ERROR (Status)) {
+      return EFI_SUCCESS;
+    }
+
+    if (Waited >= Timeout) {
+      DEBUG ((DEBUG_ERROR, "[IPMI] SSIF write 0x%x failed: %r\n", SsifCommand, Status));
+      return EFI_DEVICE_ERROR;
+    }
+
+    MicroSecondDelay (SSIF_RETRY_DELAY);
+    Waited += SSIF_RETRY_DELAY;
+  }
+}
+
+STATIC
+EFI_STATUS
+SsifBlockRead (
+  UINT64                            SsifTimeoutPeriod,
+  UINT8                             SsifSlaveAddress,
+  UINT8                             SsifCommand,
+  UINT8                             *Block,
+  UINTN                             *BlockSize
+  )
+/*++
+
+Routine Description:
+
+  Do one SMBus block read, retrying while the BMC NAKs it.
+
+Arguments:
+
+  SsifTimeoutPeriod - The timeout, in units of SSIF_DELAY_UNIT
+  SsifSlaveAddress  - The 7-bit SMBus address of the BMC
+  SsifCommand       - The SSIF command
+  Block             - The buffer, SSIF_BLOCK_SIZE bytes
+  BlockSize         - The number of bytes read
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC did not return a block in time
+  EFI_SUCCESS      - The block was read
+
+--*/
+{
+  RETURN_STATUS   Status;
+  UINT64          Waited;
+  UINT64          Timeout;
+
+  Timeout = MultU64x32 (SsifTimeoutPeriod, SSIF_DELAY_UNIT);
+  Waited  = 0;
+
+  while (TRUE) {
+    *BlockSize = SmBusBlockRead (
+                   SMBUS_LIB_ADDRESS (SsifSlaveAddress, SsifCommand, 0, FALSE),
+                   Block,
+                   &Status
+                   );
+    if (!RETURN_ERROR (Status) && (*BlockSize > 0) && (*BlockSize <= SSIF_BLOCK_SIZE)) {
+      return EFI_SUCCESS;
+    }
+
+    if (Waited >= Timeout) {
+      DEBUG ((DEBUG_ERROR, "[IPMI] SSIF read 0x%x failed: %r\n", SsifCommand, Status));
+      return EFI_DEVICE_ERROR;
+    }
+
+    MicroSecondDelay (SSIF_RETRY_DELAY);
+    Waited += SSIF_RETRY_DELAY;
+  }
+}
+
+EFI_STATUS
+SendDataToSsifBmc (
+  UINT64                                    SsifTimeoutPeriod,
+  UINT8                                     SsifSlaveAddress,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     DataSize
+  )
+/*++
+
+Routine Description:
+
+  Send a request message to the BMC in SSIF block writes
+
+Arguments:
+
+  SsifTimeoutPeriod - The timeout, in units of SSIF_DELAY_UNIT
+  SsifSlaveAddress  - The 7-bit SMBus address of the BMC
+  Context           - The context of this operation
+  Data              - The request, starting with NetFn/LUN
+  DataSize          - The request size
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC did not accept the request in time
+  EFI_SUCCESS      - Send out the data successfully
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT8       Offset;
+
+  if (DataSize < 2) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (DataSize <= SSIF_BLOCK_SIZE) {
+    return SsifBlockWrite (SsifTimeoutPeriod, SsifSlaveAddress, SSIF_WRITE_SINGLE, Data, DataSize);
+  }
+
+  //
+  // Multi-part write: a full start block, full middle blocks, and an end
+  // block holding the remaining 1 to SSIF_BLOCK_SIZE bytes.
+  //
+  Status = SsifBlockWrite (SsifTimeoutPeriod, SsifSlaveAddress, SSIF_WRITE_MULTI_START, Data, SSIF_BLOCK_SIZE);
+  Offset = SSIF_BLOCK_SIZE;
+  while (!EFI_ERROR (Status) && (DataSize - Offset > SSIF_BLOCK_SIZE)) {
+    Status = SsifBlockWrite (SsifTimeoutPeriod, SsifSlaveAddress, SSIF_WRITE_MULTI_MIDDLE, &Data[Offset], SSIF_BLOCK_SIZE);
+    Offset += SSIF_BLOCK_SIZE;
+  }
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return SsifBlockWrite (SsifTimeoutPeriod, SsifSlaveAddress, SSIF_WRITE_MULTI_END, &Data[Offset], DataSize - Offset);
+}
+
+EFI_STATUS
+ReceiveBmcDataFromSsif (
+  UINT64                                    SsifTimeoutPeriod,
+  UINT8                                     SsifSlaveAddress,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     *DataSize
+  )
+/*++
+
+Routine Description:
+
+  Receive a response message from the BMC in SSIF block reads
+
+Arguments:
+
+  SsifTimeoutPeriod - The timeout, in units of SSIF_DELAY_UNIT
+  SsifSlaveAddress  - The 7-bit SMBus address of the BMC
+  Context           - The context of this operation
+  Data              - The buffer pointer
+  DataSize          - On input the buffer size, on output the response size
+
+Returns:
+
+  EFI_DEVICE_ERROR     - The BMC did not respond in time
+  EFI_BUFFER_TOO_SMALL - The response doesn't fit in the buffer
+  EFI_SUCCESS          - Received data successfully
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT8       Block[SSIF_BLOCK_SIZE];
+  UINTN       BlockSize;
+  UINTN       Count;
+  UINTN       Skip;
+  BOOLEAN     Last;
+
+  //
+  // The BMC NAKs the first read until the response is ready.
+  //
+  Status = SsifBlockRead (SsifTimeoutPeriod, SsifSlaveAddress, SSIF_READ_START, Block, &BlockSize);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if ((BlockSize == SSIF_BLOCK_SIZE) &&
+      (Block[0] == SSIF_READ_MULTI_START_0) &&
+      (Block[1] == SSIF_READ_MULTI_START_1)) {
+    Skip = 2;
+    Last = FALSE;
+  } else {
+    Skip = 0;
+    Last = TRUE;
+  }
+
+  Count = 0;
+  while (TRUE) {
+    if (BlockSize < Skip) {
+      return EFI_DEVICE_ERROR;
+    }
+
+    if (Count + BlockSize - Skip > *DataSize) {
+      return EFI_BUFFER_TOO_SMALL;
+    }
+
+    CopyMem (&Data[Count], &Block[Skip], BlockSize - Skip);
+    Count += BlockSize - Skip;
+
+    if (Last) {
+      break;
+    }
+
+    Status = SsifBlockRead (SsifTimeoutPeriod, SsifSlaveAddress, SSIF_READ_MIDDLE, Block, &BlockSize);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Skip = 1;
+    Last = (BOOLEAN) (Block[0] == SSIF_READ_MULTI_END);
+  }
+
+  if (Count < 3) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  *DataSize = (UINT8) Count;
+
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/** @file
+  SSIF Transport Hook head file.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _SSIF_BMC_H
+#define _SSIF_BMC_H
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/SmbusLib.h>
+#include <Library/TimerLib.h>
+
+//
+// SSIF SMBus commands
+//
+#define SSIF_WRITE_SINGLE       0x02
+#define SSIF_READ_START         0x03
+#define SSIF_WRITE_MULTI_START  0x06
+#define SSIF_WRITE_MULTI_MIDDLE 0x07
+#define SSIF_WRITE_MULTI_END    0x08
+#define SSIF_READ_MIDDLE        0x09
+
+//
+// Each SMBus block transfer carries up to SSIF_BLOCK_SIZE bytes. A multi-part
+// read starts with SSIF_READ_MULTI_START_0/1, the following blocks start
+// with their block number and the last one is numbered SSIF_READ_MULTI_END.
+//
+#define SSIF_BLOCK_SIZE         32
+#define SSIF_READ_MULTI_START_0 0x00
+#define SSIF_READ_MULTI_START_1 0x01
+#define SSIF_READ_MULTI_END     0xFF
+
+//
+// The BMC NAKs its address while it is busy, so a failed transfer is retried
+// every SSIF_RETRY_DELAY until the timeout, which is shared with KCS and
+// counts SSIF_DELAY_UNIT steps, runs out.
+//
+#define SSIF_DELAY_UNIT         50    // [s] Unit of the timeout
+#define SSIF_RETRY_DELAY        1000  // [s] Delay between retries
+
+//
+//External Fucntion List
+//
+EFI_STATUS
+SendDataToSsifBmc (
+  UINT64                                    SsifTimeoutPeriod,
+  UINT8                                     SsifSlaveAddress,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     DataSize
+  )
+/*++
+
+Routine Description:
+
+  Send a request message to the BMC in SSIF block writes
+
+Arguments:
+
+  SsifTimeoutPeriod - The timeout, in units of SSIF_DELAY_UNIT
+  SsifSlaveAddress  - The 7-bit SMBus address of the BMC
+  Context           - The context of this operation
+  Data              - The request, starting with NetFn/LUN
+  DataSize          - The request size
+
+Returns:
+
+  EFI_DEVICE_ERROR - The BMC did not accept the request in time
+  EFI_SUCCESS      - Send out the data successfully
+
+--*/
+;
+
+EFI_STATUS
+ReceiveBmcDataFromSsif (
+  UINT64                                    SsifTimeoutPeriod,
+  UINT8                                     SsifSlaveAddress,
+  VOID                                      *Context,
+  UINT8                                     *Data,
+  UINT8                                     *DataSize
+  )
+/*++
+
+Routine Description:
+
+  Receive a response message from the BMC in SSIF block reads
+
+Arguments:
+
+  SsifTimeoutPeriod - The timeout, in units of SSIF_DELAY_UNIT
+  SsifSlaveAddress  - The 7-bit SMBus address of the BMC
+  Context           - The context of this operation
+  Data              - The buffer pointer
+  DataSize          - On input the buffer size, on output the response size
+
+Returns:
+
+  EFI_DEVICE_ERROR     - The BMC did not respond in time
+  EFI_BUFFER_TOO_SMALL - The response doesn't fit in the buffer
+  EFI_SUCCESS          - Received data successfully
+
+--*/
+;
+
+#endif
@@ -0,0 +1,368 @@
+/** @file
+  Queued IPMI command submission for the DXE transport.
+
+  IpmiSubmitCommandAsync queues a command and returns; a timer sends the
+  queued commands one at a time and polls the system interface for the
+  response without waiting on it, so drivers keep dispatching while the BMC
+  works. KCS, BT and SSIF allow a single outstanding request, so the queue
+  is strictly in order. Each request gets a sequence number, which BT
+  carries on the wire and checks in the response; KCS and SSIF responses
+  are matched on NetFn and Cmd.
+
+  Synchronous commands go through the same transport. They finish the
+  request in flight, if any, and then run ahead of the queue.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "IpmiAsync.h"
+
+#define IPMI_ASYNC_REQUEST_SIGNATURE  SIGNATURE_32 ('i', 'p', 'm', 'q')
+
+typedef struct {
+  UINTN                   Signature;
+  LIST_ENTRY              Link;
+  IPMI_COMMAND_TOKEN      *Token;
+  UINT8                   Sequence;
+  UINT8                   RetryCnt;
+  UINT8                   CommandData[MAX_TEMP_DATA - IPMI_COMMAND_HEADER_SIZE];
+} IPMI_ASYNC_REQUEST;
+
+#define IPMI_ASYNC_REQUEST_FROM_LINK(a) \
+  CR ( \
+  a, \
+  IPMI_ASYNC_REQUEST, \
+  Link, \
+  IPMI_ASYNC_REQUEST_SIGNATURE \
+  )
+
+STATIC IPMI_BMC_INSTANCE_DATA   *mIpmiAsyncInstance;
+STATIC LIST_ENTRY               mIpmiCommandQueue = INITIALIZE_LIST_HEAD_VARIABLE (mIpmiCommandQueue);
+STATIC IPMI_ASYNC_REQUEST       *mIpmiActiveRequest;
+STATIC UINT64                   mIpmiActiveWaited;
+STATIC EFI_EVENT                mIpmiQueueTimer;
+STATIC BOOLEAN                  mIpmiQueueTimerSet;
+STATIC BOOLEAN                  mIpmiBusy;
+STATIC UINT8                    mIpmiSequence;
+
+/**
+  Complete a queued request and free it.
+
+  @param[in] Request  The request.
+  @param[in] Status   The status of the command.
+**/
+STATIC
+VOID
+IpmiAsyncComplete (
+  IN IPMI_ASYNC_REQUEST     *Request,
+  IN EFI_STATUS             Status
+  )
+{
+  IPMI_COMMAND_TOKEN  *Token;
+
+  Token         = Request->Token;
+  Token->Status = Status;
+  FreePool (Request);
+
+  if (Token->Event != NULL) {
+    gBS->SignalEvent (Token->Event);
+  }
+}
+
+/**
+  Send the request at the head of the queue, if the transport is idle.
+**/
+STATIC
+VOID
+IpmiAsyncStartNext (
+  VOID
+  )
+{
+  EFI_STATUS          Status;
+  IPMI_ASYNC_REQUEST  *Request;
+
+  while ((mIpmiActiveRequest == NULL) && !IsListEmpty (&mIpmiCommandQueue)) {
+    Request = IPMI_ASYNC_REQUEST_FROM_LINK (GetFirstNode (&mIpmiCommandQueue));
+    RemoveEntryList (&Request->Link);
+
+    Status = IpmiBmcSendRequest (
+               mIpmiAsyncInstance,
+               Request->Token->NetFunction,
+               Request->Token->Lun,
+               Request->Token->Command,
+               Request->CommandData,
+               (UINT8) Request->Token->CommandDataSize,
+               &Request->Sequence
+               );
+    if (EFI_ERROR (Status)) {
+      IpmiAsyncComplete (Request, Status);
+      continue;
+    }
+
+    mIpmiActiveRequest = Request;
+    mIpmiActiveWaited  = 0;
+  }
+}
+
+/**
+  Read the response to the request in flight.
+
+  @param[in] Wait  TRUE to wait for the response, FALSE to only read it if
+                   the BMC has it ready or the request has timed out.
+**/
+STATIC
+VOID
+IpmiAsyncFinishActive (
+  IN BOOLEAN    Wait
+  )
+{
+  EFI_STATUS          Status;
+  IPMI_ASYNC_REQUEST  *Request;
+  UINT8               ResponseDataSize;
+
+  Request = mIpmiActiveRequest;
+  if (Request == NULL) {
+    return;
+  }
+
+  //
+  // Once the timeout has passed, the receive below fails and recovers the
+  // interface the same way as for a synchronous command.
+  //
+  if (!Wait &&
+      !BmcResponseReadyOnInterface (mIpmiAsyncInstance->IpmiIoBase) &&
+      (mIpmiActiveWaited < MultU64x32 (mIpmiAsyncInstance->KcsTimeoutPeriod, KCS_DELAY_UNIT))) {
+    mIpmiActiveWaited += IPMI_ASYNC_POLL_PERIOD / 10;
+    return;
+  }
+
+  mIpmiActiveRequest = NULL;
+
+  //
+  // Leave room for the completion code that is put in front of the data.
+  //
+  ResponseDataSize = (UINT8) (MIN (Request->Token->ResponseDataSize, MAX_TEMP_DATA) - 1);
+
+  Status = IpmiBmcReceiveResponse (
+             mIpmiAsyncInstance,
+             Request->Token->NetFunction,
+             Request->Token->Command,
+             Request->Token->ResponseData,
+             &ResponseDataSize,
+             &Request->Sequence
+             );
+  if (Status == EFI_NOT_FOUND) {
+    if (--Request->RetryCnt == 0) {
+      IpmiAsyncComplete (Request, EFI_DEVICE_ERROR);
+    } else {
+      InsertHeadList (&mIpmiCommandQueue, &Request->Link);
+    }
+
+    return;
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Request->Token->ResponseDataSize = ResponseDataSize;
+  }
+
+  IpmiAsyncComplete (Request, Status);
+}
+
+/**
+  Timer notification that moves the command queue along.
+
+  @param[in] Event    The timer event.
+  @param[in] Context  Not used.
+**/
+STATIC
+VOID
+EFIAPI
+IpmiAsyncPoll (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  if (mIpmiBusy) {
+    return;
+  }
+
+  mIpmiBusy = TRUE;
+
+  IpmiAsyncFinishActive (FALSE);
+  IpmiAsyncStartNext ();
+
+  if ((mIpmiActiveRequest == NULL) && IsListEmpty (&mIpmiCommandQueue)) {
+    gBS->SetTimer (mIpmiQueueTimer, TimerCancel, 0);
+    mIpmiQueueTimerSet = FALSE;
+  }
+
+  mIpmiBusy = FALSE;
+}
+
+/**
+  Raise the TPL to the TPL of the queue timer, unless it is already higher.
+
+  @return The TPL to restore.
+**/
+STATIC
+EFI_TPL
+IpmiAsyncRaiseTpl (
+  VOID
+  )
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  gBS->RestoreTPL (OldTpl);
+
+  if (OldTpl < TPL_CALLBACK) {
+    gBS->RaiseTPL (TPL_CALLBACK);
+  }
+
+  return OldTpl;
+}
+
+/**
+  Prepare queued command submission for the transport.
+
+  @param[in] IpmiInstance  The BMC instance data.
+
+  @retval EFI_SUCCESS  Commands can be queued.
+  @retval Other        The queue timer could not be created.
+**/
+EFI_STATUS
+IpmiAsyncInitialize (
+  IN IPMI_BMC_INSTANCE_DATA        *IpmiInstance
+  )
+{
+  mIpmiAsyncInstance = IpmiInstance;
+
+  return gBS->CreateEvent (
+                EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                TPL_CALLBACK,
+                IpmiAsyncPoll,
+                NULL,
+                &mIpmiQueueTimer
+                );
+}
+
+/**
+  Send an IPMI command and wait for the response.
+
+  The request in flight on the queue, if any, is finished first.
+
+  @param[in]      This              Pointer to IPMI protocol instance.
+  @param[in]      NetFunction       Net Function of command to send.
+  @param[in]      Lun               LUN of command to send.
+  @param[in]      Command           IPMI command to send.
+  @param[in]      CommandData       Pointer to command data buffer, if needed.
+  @param[in]      CommandDataSize   Size of command data buffer.
+  @param[out]     ResponseData      Pointer to response data buffer.
+  @param[in, out] ResponseDataSize  Pointer to response data buffer size.
+
+  @retval EFI_NOT_READY  Called at a TPL above TPL_CALLBACK while a queued
+                         command was being processed.
+  @retval Other          See IPMI_SEND_COMMAND.
+**/
+EFI_STATUS
+EFIAPI
+IpmiSendCommandSync (
+  IN      IPMI_TRANSPORT               *This,
+  IN      UINT8                        NetFunction,
+  IN      UINT8                        Lun,
+  IN      UINT8                        Command,
+  IN      UINT8                        *CommandData,
+  IN      UINT32                       CommandDataSize,
+  IN OUT  UINT8                        *ResponseData,
+  IN OUT  UINT32                       *ResponseDataSize
+  )
+{
+  EFI_STATUS  Status;
+  EFI_TPL     OldTpl;
+
+  OldTpl = IpmiAsyncRaiseTpl ();
+
+  if (mIpmiBusy) {
+    gBS->RestoreTPL (OldTpl);
+    return EFI_NOT_READY;
+  }
+
+  mIpmiBusy = TRUE;
+
+  IpmiAsyncFinishActive (TRUE);
+
+  Status = IpmiSendCommand (
+             This,
+             NetFunction,
+             Lun,
+             Command,
+             CommandData,
+             CommandDataSize,
+             ResponseData,
+             ResponseDataSize
+             );
+
+  mIpmiBusy = FALSE;
+  gBS->RestoreTPL (OldTpl);
+
+  return Status;
+}
+
+/**
+  Queue an IPMI command and return without waiting for the response.
+
+  @param[in]      This   Pointer to IPMI protocol instance.
+  @param[in, out] Token  The command token.
+
+  @retval EFI_SUCCESS            The command is queued.
+  @retval EFI_INVALID_PARAMETER  The token is not valid. The response buffer
+                                 must have room for the completion code.
+  @retval EFI_OUT_OF_RESOURCES   The command could not be queued.
+**/
+EFI_STATUS
+EFIAPI
+IpmiSendCommandAsync (
+  IN      IPMI_TRANSPORT               *This,
+  IN OUT  IPMI_COMMAND_TOKEN           *Token
+  )
+{
+  IPMI_ASYNC_REQUEST  *Request;
+  EFI_TPL             OldTpl;
+
+  if ((Token == NULL) ||
+      (Token->CommandDataSize > sizeof (Request->CommandData)) ||
+      ((Token->CommandDataSize > 0) && (Token->CommandData == NULL)) ||
+      (Token->ResponseData == NULL) ||
+      (Token->ResponseDataSize == 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Request = AllocateZeroPool (sizeof (*Request));
+  if (Request == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Request->Signature = IPMI_ASYNC_REQUEST_SIGNATURE;
+  Request->Token     = Token;
+  Request->RetryCnt  = IPMI_SEND_COMMAND_MAX_RETRY;
+  if (Token->CommandDataSize > 0) {
+    CopyMem (Request->CommandData, Token->CommandData, Token->CommandDataSize);
+  }
+
+  Token->Status = EFI_NOT_READY;
+
+  OldTpl = IpmiAsyncRaiseTpl ();
+
+  Request->Sequence = mIpmiSequence++;
+  InsertTailList (&mIpmiCommandQueue, &Request->Link);
+
+  if (!mIpmiQueueTimerSet) {
+    gBS->SetTimer (mIpmiQueueTimer, TimerPeriodic, IPMI_ASYNC_POLL_PERIOD);
+    mIpmiQueueTimerSet = TRUE;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/** @file
+  Queued IPMI command submission for the DXE transport head file.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _IPMI_ASYNC_H_
+#define _IPMI_ASYNC_H_
+
+#include "IpmiHooks.h"
+
+//
+// How often the queue is polled for a BMC response, in 100ns units
+//
+#define IPMI_ASYNC_POLL_PERIOD  10000
+
+EFI_STATUS
+IpmiAsyncInitialize (
+  IN IPMI_BMC_INSTANCE_DATA        *IpmiInstance
+  );
+
+EFI_STATUS
+EFIAPI
+IpmiSendCommandSync (
+  IN      IPMI_TRANSPORT               *This,
+  IN      UINT8                        NetFunction,
+  IN      UINT8                        Lun,
+  IN      UINT8                        Command,
+  IN      UINT8                        *CommandData,
+  IN      UINT32                       CommandDataSize,
+  IN OUT  UINT8                        *ResponseData,
+  IN OUT  UINT32                       *ResponseDataSize
+  );
+
+EFI_STATUS
+EFIAPI
+IpmiSendCommandAsync (
+  IN      IPMI_TRANSPORT               *This,
+  IN OUT  IPMI_COMMAND_TOKEN           *Token
+  );
+
+#endif
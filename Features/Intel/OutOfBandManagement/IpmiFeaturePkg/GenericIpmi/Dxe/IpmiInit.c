@@ -12,7 +12,10 @@
 #include "IpmiBmcCommon.h"
 #include "IpmiBmc.h"
 #include "IpmiPhysicalLayer.h"
+#include "IpmiAsync.h"
 #include <Library/TimerLib.h>
+#include <Library/HobLib.h>
+#include <Guid/IpmiBmcInfoHob.h>
 #ifdef FAST_VIDEO_SUPPORT
   #include <Protocol/VideoPrint.h>
 #endif
@@ -25,6 +28,24 @@
 IPMI_BMC_INSTANCE_DATA       *mIpmiInstance = NULL;
 EFI_HANDLE                    mImageHandle;
 
+EFI_STATUS
+EFIAPI
+IpmiGetTransportStats (
+  IN  IPMI_TRANSPORT_STATS_PROTOCOL    *This,
+  OUT IPMI_TRANSPORT_STATS             *Statistics
+  );
+
+EFI_STATUS
+EFIAPI
+IpmiResetTransportStats (
+  IN  IPMI_TRANSPORT_STATS_PROTOCOL    *This
+  );
+
+IPMI_TRANSPORT_STATS_PROTOCOL mIpmiTransportStats = {
+  IpmiGetTransportStats,
+  IpmiResetTransportStats
+};
+
 //
 // Specific test interface
 //
@@ -52,6 +73,113 @@ Returns:
   return;
 }
 
+EFI_STATUS
+EFIAPI
+IpmiGetTransportStats (
+  IN  IPMI_TRANSPORT_STATS_PROTOCOL    *This,
+  OUT IPMI_TRANSPORT_STATS             *Statistics
+  )
+/*++
+
+Routine Description:
+
+  Copy the statistics of the commands sent to the BMC so far
+
+Arguments:
+
+  This        - Pointer to IPMI transport statistics protocol instance
+  Statistics  - Receives the statistics
+
+Returns:
+
+  EFI_SUCCESS           - The statistics were copied
+  EFI_INVALID_PARAMETER - Statistics is NULL
+
+--*/
+{
+  EFI_TPL  OldTpl;
+
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Keep queued commands from updating the counters while they are copied.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  CopyMem (Statistics, mIpmiInstance->Stats, sizeof (*Statistics));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+IpmiResetTransportStats (
+  IN  IPMI_TRANSPORT_STATS_PROTOCOL    *This
+  )
+/*++
+
+Routine Description:
+
+  Reset the statistics of the commands sent to the BMC
+
+Arguments:
+
+  This        - Pointer to IPMI transport statistics protocol instance
+
+Returns:
+
+  EFI_SUCCESS - The statistics were reset
+
+--*/
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  ZeroMem (mIpmiInstance->Stats, sizeof (*mIpmiInstance->Stats));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+IPMI_BMC_INFO_HOB *
+GetBmcInfoHob (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  Find the BMC information PeiIpmiInit collected, if the BMC was ready then.
+
+Arguments:
+
+  None
+
+Returns:
+
+  Pointer to the HOB data, or NULL if the BMC has to be queried again.
+
+--*/
+{
+  EFI_HOB_GUID_TYPE  *GuidHob;
+  IPMI_BMC_INFO_HOB  *BmcInfoHob;
+
+  GuidHob = GetFirstGuidHob (&gIpmiBmcInfoHobGuid);
+  if ((GuidHob == NULL) || (GET_GUID_HOB_DATA_SIZE (GuidHob) < sizeof (IPMI_BMC_INFO_HOB))) {
+    return NULL;
+  }
+
+  BmcInfoHob = (IPMI_BMC_INFO_HOB *) GET_GUID_HOB_DATA (GuidHob);
+  if (!BmcInfoHob->BmcReady ||
+      (BmcInfoHob->InterfaceType != FixedPcdGet8 (PcdIpmiInterfaceType))) {
+    return NULL;
+  }
+
+  return BmcInfoHob;
+}
+
 EFI_STATUS
 GetSelfTest (
   IN      IPMI_BMC_INSTANCE_DATA     *IpmiInstance,
@@ -84,6 +212,7 @@ Returns:
   UINT8       *TempPtr;
   UINT32      Retries;
   BOOLEAN     bResultFlag = FALSE;
+  IPMI_BMC_INFO_HOB  *BmcInfoHob;
 
   //
   // Get the SELF TEST Results.
@@ -101,37 +230,47 @@ Returns:
 
   IpmiInstance->TempData[1] = 0;
 
-  do {
-    Status = IpmiSendCommand (
-               &IpmiInstance->IpmiTransport,
-               IPMI_NETFN_APP,
-               0,
-               IPMI_APP_GET_SELFTEST_RESULTS,
-               NULL,
-               0,
-               IpmiInstance->TempData,
-               &DataSize
-               );
-    if (Status == EFI_SUCCESS) {
-      switch (IpmiInstance->TempData[1]) {
-        case IPMI_APP_SELFTEST_NO_ERROR:
-        case IPMI_APP_SELFTEST_NOT_IMPLEMENTED:
-        case IPMI_APP_SELFTEST_ERROR:
-        case IPMI_APP_SELFTEST_FATAL_HW_ERROR:
-          bResultFlag = TRUE;
-          break;
-
-        default:
+  //
+  // Use the results PEI got, if any, rather than asking the BMC again.
+  //
+  BmcInfoHob = GetBmcInfoHob ();
+  if ((BmcInfoHob != NULL) && BmcInfoHob->SelfTestValid) {
+    DataSize = sizeof (BmcInfoHob->SelfTest);
+    CopyMem (IpmiInstance->TempData, &BmcInfoHob->SelfTest, DataSize);
+    Status = EFI_SUCCESS;
+  } else {
+    do {
+      Status = IpmiSendCommand (
+                 &IpmiInstance->IpmiTransport,
+                 IPMI_NETFN_APP,
+                 0,
+                 IPMI_APP_GET_SELFTEST_RESULTS,
+                 NULL,
+                 0,
+                 IpmiInstance->TempData,
+                 &DataSize
+                 );
+      if (Status == EFI_SUCCESS) {
+        switch (IpmiInstance->TempData[1]) {
+          case IPMI_APP_SELFTEST_NO_ERROR:
+          case IPMI_APP_SELFTEST_NOT_IMPLEMENTED:
+          case IPMI_APP_SELFTEST_ERROR:
+          case IPMI_APP_SELFTEST_FATAL_HW_ERROR:
+            bResultFlag = TRUE;
+            break;
+
+          default:
+            break;
+        } //switch
+
+        if (bResultFlag) {
           break;
-      } //switch
-
-      if (bResultFlag) {
-        break;
+        }
       }
-    }
 
-    MicroSecondDelay (500 * 1000);
-  } while (--Retries > 0);
+      MicroSecondDelay (500 * 1000);
+    } while (--Retries > 0);
+  }
 
   //
   // If Status indicates a Device error, then the BMC is not responding, so send an error.
@@ -244,6 +383,7 @@ Returns:
   SM_CTRL_INFO                    *pBmcInfo;
   IPMI_MSG_GET_BMC_EXEC_RSP       *pBmcExecContext;
   UINT32                          Retries;
+  IPMI_BMC_INFO_HOB               *BmcInfoHob;
 #ifdef FAST_VIDEO_SUPPORT
   EFI_VIDEOPRINT_PROTOCOL         *VideoPrintProtocol;
   EFI_STATUS                      VideoPrintStatus;
@@ -257,6 +397,19 @@ Returns:
                             );
 #endif
 
+  //
+  // If the BMC was already ready in PEI there is no need to ask, or to wait
+  // for it, again.
+  //
+  BmcInfoHob = GetBmcInfoHob ();
+  if (BmcInfoHob != NULL) {
+    CopyMem (IpmiInstance->TempData, &BmcInfoHob->DeviceId, sizeof (BmcInfoHob->DeviceId));
+    pBmcInfo = (SM_CTRL_INFO*)&IpmiInstance->TempData[0];
+    DEBUG ((EFI_D_INFO, "[IPMI] BMC Device ID: 0x%02X, firmware version: %d.%02X (from PEI)\n", pBmcInfo->DeviceId, pBmcInfo->MajorFirmwareRev, pBmcInfo->MinorFirmwareRev));
+    IpmiInstance->BmcStatus = BMC_OK;
+    return EFI_SUCCESS;
+  }
+
   //
   // Set up a loop to retry for up to PcdIpmiBmcReadyDelayTimer seconds. Calculate retries not timeout
   // so that in case KCS is not enabled and IpmiSendCommand() returns
@@ -398,6 +551,13 @@ InitializeIpmiKcsPhysicalLayer (
     mIpmiInstance->BmcStatus                        = BMC_NOTREADY;
     mIpmiInstance->IpmiTransport.IpmiSubmitCommand  = IpmiSendCommand;
     mIpmiInstance->IpmiTransport.GetBmcStatus       = IpmiGetBmcStatus;
+    mIpmiInstance->IpmiTransport.Revision           = IPMI_TRANSPORT_REVISION_ASYNC;
+
+    //
+    // Trace the commands from the first one on. Without the table the
+    // transport just doesn't keep statistics.
+    //
+    mIpmiInstance->Stats = AllocateZeroPool (sizeof (*mIpmiInstance->Stats));
 
     //
     // Get the Device ID and check if the system is in Force Update mode.
@@ -436,6 +596,15 @@ InitializeIpmiKcsPhysicalLayer (
     // Now install the Protocol if the BMC is not in a HardFail State and not in Force Update mode
     //
     if ((mIpmiInstance->BmcStatus != BMC_HARDFAIL) && (mIpmiInstance->BmcStatus != BMC_UPDATE_IN_PROGRESS)) {
+      //
+      // From now on commands may be queued, so synchronous ones have to wait
+      // for the request in flight.
+      //
+      if (!EFI_ERROR (IpmiAsyncInitialize (mIpmiInstance))) {
+        mIpmiInstance->IpmiTransport.IpmiSubmitCommand      = IpmiSendCommandSync;
+        mIpmiInstance->IpmiTransport.IpmiSubmitCommandAsync = IpmiSendCommandAsync;
+      }
+
       Handle = NULL;
       Status = gBS->InstallProtocolInterface (
                       &Handle,
@@ -444,6 +613,16 @@ InitializeIpmiKcsPhysicalLayer (
                       &mIpmiInstance->IpmiTransport
                       );
       ASSERT_EFI_ERROR (Status);
+
+      if (mIpmiInstance->Stats != NULL) {
+        Status = gBS->InstallProtocolInterface (
+                        &Handle,
+                        &gIpmiTransportStatsProtocolGuid,
+                        EFI_NATIVE_INTERFACE,
+                        &mIpmiTransportStats
+                        );
+        ASSERT_EFI_ERROR (Status);
+      }
     }
 
     return EFI_SUCCESS;
@@ -133,7 +133,7 @@ Returns:
       );
   }
 
-  Status = SendDataToBmcPort (
+  Status = SendDataToBmcInterface (
              IpmiInstance->KcsTimeoutPeriod,
              IpmiInstance->IpmiIoBase,
              Context,
@@ -152,7 +152,7 @@ Returns:
   // Get Response to IPMI Command from BMC.
   //
   DataSize = MAX_TEMP_DATA;
-  Status = ReceiveBmcDataFromPort (
+  Status = ReceiveBmcDataFromInterface (
              IpmiInstance->KcsTimeoutPeriod,
              IpmiInstance->IpmiIoBase,
              Context,
@@ -20,7 +20,7 @@
 #include <Ppi/IpmiTransportPpi.h>
 
 #include "PeiIpmiBmcDef.h"
-#include "KcsBmc.h"
+#include "IpmiInterface.h"
 
 //
 // IPMI Instance signature
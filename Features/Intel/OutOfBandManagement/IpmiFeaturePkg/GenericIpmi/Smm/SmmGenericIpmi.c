@@ -19,6 +19,8 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/IpmiBaseLib.h>
+#include <Library/HobLib.h>
+#include <Guid/IpmiBmcInfoHob.h>
 #include <SmStatusCodes.h>
 #include "IpmiHooks.h"
 #include "IpmiBmcCommon.h"
@@ -56,6 +58,22 @@ Returns:
   SM_CTRL_INFO             *ControllerInfo;
   UINT8                    TimeOut;
   UINT8                    Retries;
+  EFI_HOB_GUID_TYPE        *GuidHob;
+  IPMI_BMC_INFO_HOB        *BmcInfoHob;
+
+  //
+  // If the BMC was already ready in PEI, reuse its Get Device ID response.
+  //
+  GuidHob = GetFirstGuidHob (&gIpmiBmcInfoHobGuid);
+  if ((GuidHob != NULL) && (GET_GUID_HOB_DATA_SIZE (GuidHob) >= sizeof (IPMI_BMC_INFO_HOB))) {
+    BmcInfoHob = (IPMI_BMC_INFO_HOB *) GET_GUID_HOB_DATA (GuidHob);
+    if (BmcInfoHob->BmcReady &&
+        (BmcInfoHob->InterfaceType == FixedPcdGet8 (PcdIpmiInterfaceType))) {
+      CopyMem (IpmiInstance->TempData, &BmcInfoHob->DeviceId, sizeof (BmcInfoHob->DeviceId));
+      DEBUG ((EFI_D_INFO, "IPMI: BMC Device ID taken from PEI\n"));
+      return EFI_SUCCESS;
+    }
+  }
 
   TimeOut = 0;
   Retries = PcdGet8 (PcdIpmiBmcReadyDelayTimer);
@@ -167,6 +185,7 @@ Returns:
     mIpmiInstance->SlaveAddress                     = BMC_SLAVE_ADDRESS;
     mIpmiInstance->BmcStatus                        = BMC_NOTREADY;
     mIpmiInstance->IpmiTransport.IpmiSubmitCommand  = IpmiSendCommand;
+    mIpmiInstance->IpmiTransport.Revision           = IPMI_TRANSPORT_REVISION_ASYNC;
     mIpmiInstance->IpmiTransport.GetBmcStatus       = IpmiGetBmcStatus;
 
     DEBUG ((DEBUG_INFO,"IPMI: Waiting for Getting BMC DID in SMM \n"));
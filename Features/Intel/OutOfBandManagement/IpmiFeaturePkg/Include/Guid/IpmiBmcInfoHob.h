@@ -0,0 +1,42 @@
+/** @file
+  IPMI BMC Information HOB GUID Header File.
+
+  Built by PeiIpmiInit once the BMC has answered Get Device ID and Get Self
+  Test Results, so the DXE and SMM IPMI drivers can start from those results
+  instead of sending the same commands and waiting for the BMC again.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _IPMI_BMC_INFO_HOB_H_
+#define _IPMI_BMC_INFO_HOB_H_
+
+#include <IndustryStandard/Ipmi.h>
+
+#define IPMI_BMC_INFO_HOB_GUID \
+  { \
+    0x879b8cc0, 0x7549, 0x440c, 0xac, 0x52, 0xaf, 0x0e, 0x1f, 0x35, 0xfe, 0xfc \
+  }
+
+#define IPMI_BMC_INFO_HOB_REVISION  1
+
+//
+// BmcReady is TRUE when Get Device ID succeeded with the update mode bit
+// clear; the consumers only trust the cached data in that case and query the
+// BMC themselves otherwise. SelfTestValid is TRUE when Get Self Test Results
+// succeeded as well. InterfaceType is the PcdIpmiInterfaceType the results
+// were obtained over.
+//
+typedef struct {
+  UINT8                           Revision;
+  BOOLEAN                         BmcReady;
+  BOOLEAN                         SelfTestValid;
+  UINT8                           InterfaceType;
+  IPMI_GET_DEVICE_ID_RESPONSE     DeviceId;
+  IPMI_SELF_TEST_RESULT_RESPONSE  SelfTest;
+} IPMI_BMC_INFO_HOB;
+
+extern EFI_GUID gIpmiBmcInfoHobGuid;
+
+#endif
@@ -0,0 +1,62 @@
+/** @file
+  IPMI FRU Inventory Protocol Header File.
+
+  Published by IpmiFru once every FRU device has been read from the BMC, so
+  SMBIOS producers and setup pages can use the inventory without sending
+  their own Read FRU Data commands.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _IPMI_FRU_INVENTORY_PROTOCOL_H_
+#define _IPMI_FRU_INVENTORY_PROTOCOL_H_
+
+#define IPMI_FRU_INVENTORY_PROTOCOL_GUID \
+  { \
+    0x95963ac6, 0x2165, 0x44ed, 0x81, 0x0c, 0x34, 0xad, 0xb0, 0x70, 0x4b, 0xfc \
+  }
+
+#define IPMI_FRU_INVENTORY_PROTOCOL_REVISION  1
+
+//
+// Parsed FRU device. Raw holds the whole inventory area as read from the
+// BMC. The strings are NULL-terminated ASCII, decoded from the info areas,
+// and NULL when the area or the field is absent or fails its checksum.
+// BoardMfgDateTime is in minutes since 0:00 1/1/96, 0 if unspecified.
+//
+typedef struct {
+  UINT8                       DeviceId;
+  UINT16                      RawSize;
+  UINT8                       *Raw;
+
+  UINT8                       ChassisType;
+  CHAR8                       *ChassisPartNumber;
+  CHAR8                       *ChassisSerialNumber;
+
+  UINT32                      BoardMfgDateTime;
+  CHAR8                       *BoardManufacturer;
+  CHAR8                       *BoardProductName;
+  CHAR8                       *BoardSerialNumber;
+  CHAR8                       *BoardPartNumber;
+
+  CHAR8                       *ProductManufacturer;
+  CHAR8                       *ProductName;
+  CHAR8                       *ProductPartNumber;
+  CHAR8                       *ProductVersion;
+  CHAR8                       *ProductSerialNumber;
+  CHAR8                       *ProductAssetTag;
+} IPMI_FRU_DEVICE_INFO;
+
+//
+// IPMI FRU INVENTORY PROTOCOL
+//
+typedef struct {
+  UINT64                      Revision;
+  UINTN                       DeviceCount;
+  IPMI_FRU_DEVICE_INFO        *Devices;
+} IPMI_FRU_INVENTORY_PROTOCOL;
+
+extern EFI_GUID gIpmiFruInventoryProtocolGuid;
+
+#endif
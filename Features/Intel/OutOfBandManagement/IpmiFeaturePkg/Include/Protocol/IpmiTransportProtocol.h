@@ -34,6 +34,31 @@ typedef UINT32  BMC_STATUS;
 #define BMC_UPDATE_IN_PROGRESS  3
 #define BMC_NOTREADY            4
 
+//
+// Transports with this revision or later have the IpmiSubmitCommandAsync
+// member. It is NULL if the transport can't queue commands.
+//
+#define IPMI_TRANSPORT_REVISION_ASYNC  1
+
+//
+// Command token for IpmiSubmitCommandAsync. The command data is copied when
+// the command is queued, the response buffer must stay valid until Event is
+// signaled. Status is EFI_NOT_READY until then, and ResponseDataSize is
+// updated the same way as for IpmiSubmitCommand. Event may be NULL, in which
+// case the caller polls Status.
+//
+typedef struct {
+  UINT8                       NetFunction;
+  UINT8                       Lun;
+  UINT8                       Command;
+  UINT8                       *CommandData;
+  UINT32                      CommandDataSize;
+  UINT8                       *ResponseData;
+  UINT32                      ResponseDataSize;
+  EFI_EVENT                   Event;
+  EFI_STATUS                  Status;
+} IPMI_COMMAND_TOKEN;
+
 //
 //  IPMI Function Prototypes
 //
@@ -50,6 +75,17 @@ EFI_STATUS
   OUT UINT32                           *ResponseDataSize
   );
 
+//
+// Queue a command and return without waiting for the BMC. Commands are sent
+// in the order they are queued and completed by signaling Token->Event.
+//
+typedef
+EFI_STATUS
+(EFIAPI *IPMI_SEND_COMMAND_ASYNC) (
+  IN IPMI_TRANSPORT                    *This,
+  IN OUT IPMI_COMMAND_TOKEN            *Token
+  );
+
 typedef
 EFI_STATUS
 (EFIAPI *IPMI_GET_CHANNEL_STATUS) (
@@ -67,6 +103,7 @@ struct _IPMI_TRANSPORT {
   IPMI_GET_CHANNEL_STATUS     GetBmcStatus;
   EFI_HANDLE                  IpmiHandle;
   UINT8                       CompletionCode;
+  IPMI_SEND_COMMAND_ASYNC     IpmiSubmitCommandAsync;
 };
 
 extern EFI_GUID gIpmiTransportProtocolGuid;
@@ -0,0 +1,81 @@
+/** @file
+  IPMI Transport Statistics Protocol Header File.
+
+  Installed by the GenericIpmi DXE driver next to the IPMI transport
+  protocol. It reports, per NetFn/Cmd pair, how many commands were sent, how
+  many bytes went each way, and how long the request and the response phases
+  took, so BMC turnaround can be told apart from host-side overhead.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _IPMI_TRANSPORT_STATS_PROTOCOL_H_
+#define _IPMI_TRANSPORT_STATS_PROTOCOL_H_
+
+#define IPMI_TRANSPORT_STATS_PROTOCOL_GUID \
+  { \
+    0xa1f4a688, 0x2942, 0x43d0, 0x9a, 0x3c, 0xec, 0xe5, 0xd3, 0xa7, 0x24, 0x66 \
+  }
+
+//
+// Number of distinct NetFn/Cmd pairs tracked. Commands beyond that are only
+// counted in IPMI_TRANSPORT_STATS.Untracked.
+//
+#define IPMI_TRANSPORT_STATS_MAX_COMMANDS  64
+
+typedef struct _IPMI_TRANSPORT_STATS_PROTOCOL IPMI_TRANSPORT_STATS_PROTOCOL;
+
+//
+// SendNs is the time spent writing requests to the interface, including the
+// waits for the BMC to take each byte. ReceiveNs is the time spent waiting
+// for and reading responses; for synchronous commands it includes the BMC's
+// processing time, for queued commands only the read itself. Retries counts
+// responses that did not match the command and made it send the request again.
+//
+typedef struct {
+  UINT8                       NetFunction;
+  UINT8                       Command;
+  UINT64                      Calls;
+  UINT64                      Errors;
+  UINT64                      Retries;
+  UINT64                      BytesSent;
+  UINT64                      BytesReceived;
+  UINT64                      SendNs;
+  UINT64                      ReceiveNs;
+  UINT64                      MaxReceiveNs;
+} IPMI_TRANSPORT_COMMAND_STATS;
+
+typedef struct {
+  UINT32                      CommandCount;
+  UINT64                      Untracked;
+  IPMI_TRANSPORT_COMMAND_STATS Command[IPMI_TRANSPORT_STATS_MAX_COMMANDS];
+} IPMI_TRANSPORT_STATS;
+
+//
+//  IPMI Transport Statistics Function Prototypes
+//
+typedef
+EFI_STATUS
+(EFIAPI *IPMI_TRANSPORT_STATS_GET) (
+  IN  IPMI_TRANSPORT_STATS_PROTOCOL    *This,
+  OUT IPMI_TRANSPORT_STATS             *Statistics
+  );
+
+typedef
+EFI_STATUS
+(EFIAPI *IPMI_TRANSPORT_STATS_RESET) (
+  IN  IPMI_TRANSPORT_STATS_PROTOCOL    *This
+  );
+
+//
+// IPMI TRANSPORT STATISTICS PROTOCOL
+//
+struct _IPMI_TRANSPORT_STATS_PROTOCOL {
+  IPMI_TRANSPORT_STATS_GET    GetStatistics;
+  IPMI_TRANSPORT_STATS_RESET  ResetStatistics;
+};
+
+extern EFI_GUID gIpmiTransportStatsProtocolGuid;
+
+#endif
@@ -1,6 +1,10 @@
 /** @file
   IPMI FRU Driver.
 
+  Reads each FRU device from the BMC once, in the largest chunks the BMC
+  accepts, and publishes the parsed inventory with the IPMI FRU Inventory
+  protocol.
+
 Copyright (c) 2018 - 2019, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -11,8 +15,450 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/PcdLib.h>
 #include <Library/IpmiCommandLib.h>
 #include <IndustryStandard/Ipmi.h>
+#include <Protocol/IpmiFruInventory.h>
+
+//
+// Read FRU Data chunk sizes. Reads start with the largest chunk that fits in
+// the transport buffer and halve on failure, since BMCs differ in how much
+// they return at once.
+//
+#define FRU_MAX_CHUNK_SIZE          240
+#define FRU_MIN_CHUNK_SIZE          16
+
+#define FRU_COMMON_HEADER_SIZE      8
+#define FRU_COMMON_HEADER_VERSION   0x01
+#define FRU_AREA_UNIT               8
+#define FRU_FIELD_END               0xC1
+
+//
+// Type/length byte of the info area fields
+//
+#define FRU_FIELD_TYPE(a)           (((a) >> 6) & 0x3)
+#define FRU_FIELD_LENGTH(a)         ((a) & 0x3F)
+#define FRU_FIELD_TYPE_BINARY       0
+#define FRU_FIELD_TYPE_BCD_PLUS     1
+#define FRU_FIELD_TYPE_6BIT_ASCII   2
+#define FRU_FIELD_TYPE_8BIT_ASCII   3
+
+STATIC UINT8                        mFruChunkSize = FRU_MAX_CHUNK_SIZE;
+STATIC IPMI_FRU_INVENTORY_PROTOCOL  mFruInventory = {
+  IPMI_FRU_INVENTORY_PROTOCOL_REVISION,
+  0,
+  NULL
+};
+
+BOOLEAN
+FruChecksumValid (
+  IN UINT8                  *Data,
+  IN UINTN                  Size
+  )
+/*++
+
+Routine Description:
+
+  Check the zero checksum of a FRU header or info area
+
+Arguments:
+
+  Data - Pointer to the data, including the checksum byte
+  Size - Size of the data
+
+Returns:
+
+  TRUE if the bytes add up to zero
+
+--*/
+{
+  UINT8   Sum;
+  UINTN   Index;
+
+  Sum = 0;
+  for (Index = 0; Index < Size; Index++) {
+    Sum = (UINT8) (Sum + Data[Index]);
+  }
+
+  return (BOOLEAN) (Sum == 0);
+}
+
+EFI_STATUS
+FruReadDevice (
+  IN  UINT8                 DeviceId,
+  OUT UINT8                 **Raw,
+  OUT UINT16                *RawSize
+  )
+/*++
+
+Routine Description:
+
+  Read a whole FRU device from the BMC
+
+Arguments:
+
+  DeviceId - FRU device ID
+  Raw      - Returns the allocated inventory area
+  RawSize  - Returns the size of the inventory area
+
+Returns:
+
+  EFI_STATUS
+
+--*/
+{
+  EFI_STATUS                                 Status;
+  IPMI_GET_FRU_INVENTORY_AREA_INFO_REQUEST   GetFruInventoryAreaInfoRequest;
+  IPMI_GET_FRU_INVENTORY_AREA_INFO_RESPONSE  GetFruInventoryAreaInfoResponse;
+  IPMI_READ_FRU_DATA_REQUEST                 ReadFruDataRequest;
+  IPMI_READ_FRU_DATA_RESPONSE                *ReadFruDataResponse;
+  UINT8                                      Response[sizeof (IPMI_READ_FRU_DATA_RESPONSE) + FRU_MAX_CHUNK_SIZE];
+  UINT32                                     ResponseSize;
+  UINT8                                      *Data;
+  UINT16                                     Size;
+  UINT16                                     Offset;
+  UINT16                                     Count;
+  UINT16                                     Returned;
+  UINT8                                      Shift;
+
+  GetFruInventoryAreaInfoRequest.DeviceId = DeviceId;
+  Status = IpmiGetFruInventoryAreaInfo (&GetFruInventoryAreaInfoRequest, &GetFruInventoryAreaInfoResponse);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (GetFruInventoryAreaInfoResponse.CompletionCode != IPMI_COMP_CODE_NORMAL) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Size = GetFruInventoryAreaInfoResponse.InventoryAreaSize;
+  if (Size < FRU_COMMON_HEADER_SIZE) {
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // Bit 0 of the access type is set for devices accessed by words, in which
+  // case offsets and counts are in words. The extra byte takes the odd half
+  // of the last word.
+  //
+  Shift = (GetFruInventoryAreaInfoResponse.AccessType & BIT0) ? 1 : 0;
+
+  Data = AllocateZeroPool (Size + 1);
+  if (Data == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ReadFruDataResponse = (IPMI_READ_FRU_DATA_RESPONSE *) Response;
+  Offset = 0;
+  while (Offset < Size) {
+    Count = MIN (mFruChunkSize, Size - Offset);
+    Count = (Count >> Shift) << Shift;
+    if (Count == 0) {
+      Count = 1 << Shift;
+    }
+
+    ReadFruDataRequest.DeviceId        = DeviceId;
+    ReadFruDataRequest.InventoryOffset = Offset >> Shift;
+    ReadFruDataRequest.CountToRead     = (UINT8) (Count >> Shift);
+    ResponseSize = (UINT32) (sizeof (IPMI_READ_FRU_DATA_RESPONSE) + Count);
+
+    Status = IpmiReadFruData (&ReadFruDataRequest, ReadFruDataResponse, &ResponseSize);
+    if (EFI_ERROR (Status) || (ReadFruDataResponse->CompletionCode != IPMI_COMP_CODE_NORMAL)) {
+      if (mFruChunkSize > FRU_MIN_CHUNK_SIZE) {
+        mFruChunkSize /= 2;
+        continue;
+      }
+
+      FreePool (Data);
+      return EFI_DEVICE_ERROR;
+    }
+
+    Returned = (UINT16) (ReadFruDataResponse->CountReturned << Shift);
+    if ((Returned == 0) || (Returned > Count) ||
+        (ResponseSize < sizeof (IPMI_READ_FRU_DATA_RESPONSE) + Returned)) {
+      FreePool (Data);
+      return EFI_DEVICE_ERROR;
+    }
+
+    CopyMem (&Data[Offset], ReadFruDataResponse->Data, Returned);
+    Offset = Offset + Returned;
+  }
+
+  DEBUG ((DEBUG_INFO, "IpmiFru: Read FRU %d, %d bytes in chunks of %d\n", DeviceId, Size, mFruChunkSize));
+
+  *Raw     = Data;
+  *RawSize = Size;
+  return EFI_SUCCESS;
+}
+
+BOOLEAN
+FruNextField (
+  IN     UINT8              *Area,
+  IN     UINTN              AreaSize,
+  IN OUT UINTN              *Offset,
+  OUT    CHAR8              **String
+  )
+/*++
+
+Routine Description:
+
+  Decode the next type/length field of a FRU info area
+
+Arguments:
+
+  Area     - Pointer to the info area
+  AreaSize - Size of the info area
+  Offset   - Offset of the field, updated to the next field
+  String   - Returns the allocated ASCII string, NULL for empty and binary fields
+
+Returns:
+
+  FALSE at the end of the fields
+
+--*/
+{
+  UINT8   TypeLength;
+  UINTN   Length;
+  UINT8   *Field;
+  CHAR8   *Buffer;
+  UINTN   Index;
+  UINTN   Chars;
+  UINT8   Nibble;
+  UINT32  Bits;
+  CHAR8   BcdPlus[] = "0123456789 -.???";
+
+  *String = NULL;
+
+  if (*Offset >= AreaSize) {
+    return FALSE;
+  }
+
+  TypeLength = Area[*Offset];
+  if (TypeLength == FRU_FIELD_END) {
+    return FALSE;
+  }
+
+  Length = FRU_FIELD_LENGTH (TypeLength);
+  if (*Offset + 1 + Length > AreaSize) {
+    return FALSE;
+  }
+
+  Field    = &Area[*Offset + 1];
+  *Offset += 1 + Length;
+  if (Length == 0) {
+    return TRUE;
+  }
+
+  switch (FRU_FIELD_TYPE (TypeLength)) {
+  case FRU_FIELD_TYPE_8BIT_ASCII:
+    Buffer = AllocateZeroPool (Length + 1);
+    if (Buffer != NULL) {
+      CopyMem (Buffer, Field, Length);
+    }
+    break;
+
+  case FRU_FIELD_TYPE_6BIT_ASCII:
+    //
+    // Four characters are packed into every three bytes, LSB first.
+    //
+    Chars  = (Length * 8) / 6;
+    Buffer = AllocateZeroPool (Chars + 1);
+    if (Buffer != NULL) {
+      for (Index = 0; Index < Chars; Index++) {
+        Bits = Field[(Index * 6) / 8];
+        if (((Index * 6) / 8) + 1 < Length) {
+          Bits |= (UINT32) Field[((Index * 6) / 8) + 1] << 8;
+        }
+
+        Buffer[Index] = (CHAR8) (0x20 + ((Bits >> ((Index * 6) % 8)) & 0x3F));
+      }
+    }
+    break;
+
+  case FRU_FIELD_TYPE_BCD_PLUS:
+    Buffer = AllocateZeroPool (Length * 2 + 1);
+    if (Buffer != NULL) {
+      for (Index = 0; Index < Length * 2; Index++) {
+        Nibble = (Index % 2 == 0) ? (Field[Index / 2] >> 4) : (Field[Index / 2] & 0xF);
+        Buffer[Index] = BcdPlus[Nibble];
+      }
+    }
+    break;
+
+  default:
+    Buffer = NULL;
+    break;
+  }
+
+  *String = Buffer;
+  return TRUE;
+}
+
+UINT8 *
+FruGetArea (
+  IN  IPMI_FRU_DEVICE_INFO  *Info,
+  IN  UINT8                 HeaderOffset,
+  OUT UINTN                 *AreaSize
+  )
+/*++
+
+Routine Description:
+
+  Locate and verify a FRU info area
+
+Arguments:
+
+  Info          - FRU device
+  HeaderOffset  - Index of the area offset in the common header
+  AreaSize      - Returns the size of the area
+
+Returns:
+
+  Pointer to the area, NULL if it is absent or invalid
+
+--*/
+{
+  UINTN   Offset;
+  UINTN   Size;
+
+  Offset = Info->Raw[HeaderOffset] * FRU_AREA_UNIT;
+  if ((Offset == 0) || (Offset + 2 > Info->RawSize)) {
+    return NULL;
+  }
+
+  Size = Info->Raw[Offset + 1] * FRU_AREA_UNIT;
+  if ((Size == 0) || (Offset + Size > Info->RawSize)) {
+    return NULL;
+  }
+
+  if (!FruChecksumValid (&Info->Raw[Offset], Size)) {
+    DEBUG ((DEBUG_ERROR, "IpmiFru: FRU %d area at 0x%x has a bad checksum\n", Info->DeviceId, Offset));
+    return NULL;
+  }
+
+  *AreaSize = Size;
+  return &Info->Raw[Offset];
+}
+
+VOID
+FruParseFields (
+  IN UINT8                  *Area,
+  IN UINTN                  AreaSize,
+  IN UINTN                  Offset,
+  IN CHAR8                  **Fields[],
+  IN UINTN                  FieldCount
+  )
+/*++
+
+Routine Description:
+
+  Decode the fixed fields of a FRU info area, in order
+
+Arguments:
+
+  Area       - Pointer to the info area
+  AreaSize   - Size of the info area
+  Offset     - Offset of the first field
+  Fields     - Strings to fill in
+  FieldCount - Number of strings
+
+Returns:
+
+  None
+
+--*/
+{
+  UINTN   Index;
+
+  for (Index = 0; Index < FieldCount; Index++) {
+    if (!FruNextField (Area, AreaSize, &Offset, Fields[Index])) {
+      break;
+    }
+  }
+}
+
+EFI_STATUS
+FruParseDevice (
+  IN OUT IPMI_FRU_DEVICE_INFO  *Info
+  )
+/*++
+
+Routine Description:
+
+  Parse the chassis, board and product info areas of a FRU device
+
+Arguments:
+
+  Info - FRU device, with Raw and RawSize filled in
+
+Returns:
+
+  EFI_VOLUME_CORRUPTED if the common header is not valid
+
+--*/
+{
+  UINT8   *Area;
+  UINTN   AreaSize;
+  CHAR8   **ChassisFields[] = {
+            &Info->ChassisPartNumber,
+            &Info->ChassisSerialNumber
+            };
+  CHAR8   **BoardFields[] = {
+            &Info->BoardManufacturer,
+            &Info->BoardProductName,
+            &Info->BoardSerialNumber,
+            &Info->BoardPartNumber
+            };
+  CHAR8   **ProductFields[] = {
+            &Info->ProductManufacturer,
+            &Info->ProductName,
+            &Info->ProductPartNumber,
+            &Info->ProductVersion,
+            &Info->ProductSerialNumber,
+            &Info->ProductAssetTag
+            };
+
+  //
+  // Common header: version, internal use, chassis, board, product and
+  // multi record area offsets, pad and checksum.
+  //
+  if (((Info->Raw[0] & 0x0F) != FRU_COMMON_HEADER_VERSION) ||
+      !FruChecksumValid (Info->Raw, FRU_COMMON_HEADER_SIZE)) {
+    DEBUG ((DEBUG_ERROR, "IpmiFru: FRU %d has no valid common header\n", Info->DeviceId));
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Area = FruGetArea (Info, 2, &AreaSize);
+  if ((Area != NULL) && (AreaSize > 3)) {
+    Info->ChassisType = Area[2];
+    FruParseFields (Area, AreaSize, 3, ChassisFields, ARRAY_SIZE (ChassisFields));
+  }
+
+  Area = FruGetArea (Info, 3, &AreaSize);
+  if ((Area != NULL) && (AreaSize > 6)) {
+    Info->BoardMfgDateTime = Area[3] | (Area[4] << 8) | (Area[5] << 16);
+    FruParseFields (Area, AreaSize, 6, BoardFields, ARRAY_SIZE (BoardFields));
+  }
+
+  Area = FruGetArea (Info, 4, &AreaSize);
+  if ((Area != NULL) && (AreaSize > 3)) {
+    FruParseFields (Area, AreaSize, 3, ProductFields, ARRAY_SIZE (ProductFields));
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "IpmiFru: FRU %d Board %a %a SN %a, Product %a %a SN %a\n",
+    Info->DeviceId,
+    (Info->BoardManufacturer != NULL) ? Info->BoardManufacturer : "",
+    (Info->BoardProductName != NULL) ? Info->BoardProductName : "",
+    (Info->BoardSerialNumber != NULL) ? Info->BoardSerialNumber : "",
+    (Info->ProductManufacturer != NULL) ? Info->ProductManufacturer : "",
+    (Info->ProductName != NULL) ? Info->ProductName : "",
+    (Info->ProductSerialNumber != NULL) ? Info->ProductSerialNumber : ""
+    ));
+
+  return EFI_SUCCESS;
+}
 
 EFI_STATUS
 EFIAPI
@@ -39,8 +485,10 @@ Returns:
 {
   EFI_STATUS                                 Status;
   IPMI_GET_DEVICE_ID_RESPONSE                ControllerInfo;
-  IPMI_GET_FRU_INVENTORY_AREA_INFO_REQUEST   GetFruInventoryAreaInfoRequest;
-  IPMI_GET_FRU_INVENTORY_AREA_INFO_RESPONSE  GetFruInventoryAreaInfoResponse;
+  IPMI_FRU_DEVICE_INFO                       *Info;
+  UINT8                                      DeviceCount;
+  UINT8                                      DeviceId;
+  EFI_HANDLE                                 Handle;
 
   //
   //  Get all the SDR Records from BMC and retrieve the Record ID from the structure for future use.
@@ -53,15 +501,50 @@ Returns:
 
   DEBUG((DEBUG_ERROR, "!!! IpmiFru  FruInventorySupport %x\n", ControllerInfo.DeviceSupport.Bits.FruInventorySupport));
 
-  if (ControllerInfo.DeviceSupport.Bits.FruInventorySupport) {
-    GetFruInventoryAreaInfoRequest.DeviceId = 0;
-    Status = IpmiGetFruInventoryAreaInfo (&GetFruInventoryAreaInfoRequest, &GetFruInventoryAreaInfoResponse);
+  if (!ControllerInfo.DeviceSupport.Bits.FruInventorySupport) {
+    return EFI_SUCCESS;
+  }
+
+  DeviceCount = PcdGet8 (PcdIpmiFruDeviceCount);
+  mFruInventory.Devices = AllocateZeroPool (DeviceCount * sizeof (IPMI_FRU_DEVICE_INFO));
+  if (mFruInventory.Devices == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (DeviceId = 0; DeviceId < DeviceCount; DeviceId++) {
+    Info = &mFruInventory.Devices[mFruInventory.DeviceCount];
+    Info->DeviceId = DeviceId;
+
+    Status = FruReadDevice (DeviceId, &Info->Raw, &Info->RawSize);
+    if (EFI_ERROR (Status)) {
+      DEBUG((DEBUG_ERROR, "!!! IpmiFru  FRU %d read Status=%r\n", DeviceId, Status));
+      continue;
+    }
+
+    Status = FruParseDevice (Info);
     if (EFI_ERROR (Status)) {
-      DEBUG((DEBUG_ERROR, "!!! IpmiFru  IpmiGetFruInventoryAreaInfo Status=%x\n", Status));
-      return Status;
+      FreePool (Info->Raw);
+      ZeroMem (Info, sizeof (*Info));
+      continue;
     }
-    DEBUG((DEBUG_ERROR, "!!! IpmiFru  InventoryAreaSize=%x\n", GetFruInventoryAreaInfoResponse.InventoryAreaSize));
+
+    mFruInventory.DeviceCount++;
   }
 
+  if (mFruInventory.DeviceCount == 0) {
+    FreePool (mFruInventory.Devices);
+    mFruInventory.Devices = NULL;
+    return EFI_SUCCESS;
+  }
+
+  Handle = NULL;
+  Status = gBS->InstallProtocolInterface (
+                  &Handle,
+                  &gIpmiFruInventoryProtocolGuid,
+                  EFI_NATIVE_INTERFACE,
+                  &mFruInventory
+                  );
+  ASSERT_EFI_ERROR (Status);
+
   return EFI_SUCCESS;
 }
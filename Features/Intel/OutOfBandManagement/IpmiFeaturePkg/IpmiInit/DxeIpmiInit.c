@@ -9,8 +9,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <PiDxe.h>
 #include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
+#include <Library/HobLib.h>
 #include <Library/TimerLib.h>
 #include <Library/IpmiCommandLib.h>
+#include <Guid/IpmiBmcInfoHob.h>
 
 #define BMC_TIMEOUT          30  // [s] How long shall BIOS wait for BMC
 #define BMC_KCS_TIMEOUT      5   // [s] Single KSC request timeout
@@ -125,8 +127,30 @@ IpmiInterfaceInit (
   IN EFI_SYSTEM_TABLE       *SystemTable
   )
 {
-  BOOLEAN      UpdateMode;
-  EFI_STATUS   Status;
+  BOOLEAN            UpdateMode;
+  EFI_STATUS         Status;
+  EFI_HOB_GUID_TYPE  *GuidHob;
+  IPMI_BMC_INFO_HOB  *BmcInfoHob;
+
+  //
+  // PEI already asked the BMC. Only query it again if it was not ready then.
+  //
+  GuidHob = GetFirstGuidHob (&gIpmiBmcInfoHobGuid);
+  if ((GuidHob != NULL) && (GET_GUID_HOB_DATA_SIZE (GuidHob) >= sizeof (IPMI_BMC_INFO_HOB))) {
+    BmcInfoHob = (IPMI_BMC_INFO_HOB *)GET_GUID_HOB_DATA (GuidHob);
+    if (BmcInfoHob->BmcReady && BmcInfoHob->SelfTestValid) {
+      DEBUG((
+        DEBUG_INFO,
+        "[IPMI] BMC Device ID: 0x%02X, firmware version: %d.%02X, self-test result: %02X-%02X (from PEI)\n",
+        BmcInfoHob->DeviceId.DeviceId,
+        BmcInfoHob->DeviceId.FirmwareRev1.Bits.MajorFirmwareRev,
+        BmcInfoHob->DeviceId.MinorFirmwareRev,
+        BmcInfoHob->SelfTest.Result,
+        BmcInfoHob->SelfTest.Param
+        ));
+      return EFI_SUCCESS;
+    }
+  }
 
   DEBUG((DEBUG_ERROR,"IPMI Dxe:Get BMC Device Id\n"));
 
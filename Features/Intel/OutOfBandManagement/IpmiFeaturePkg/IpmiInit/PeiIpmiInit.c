@@ -8,16 +8,56 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <PiPei.h>
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/HobLib.h>
+#include <Library/PcdLib.h>
 #include <Library/TimerLib.h>
 #include <Library/IpmiCommandLib.h>
+#include <Guid/IpmiBmcInfoHob.h>
 
 #define BMC_TIMEOUT_PEI      50  // [s] How long shall BIOS wait for BMC
 #define BMC_KCS_TIMEOUT      5   // [s] Single KSC request timeout
 
+EFI_STATUS
+GetSelfTest (
+  OUT IPMI_SELF_TEST_RESULT_RESPONSE  *TestResult
+  )
+/*++
+
+Routine Description:
+
+  Execute the Get Self Test results command to determine whether or not the BMC self tests
+  have passed
+
+Arguments:
+
+  TestResult      - Receives the self test results returned by the BMC.
+
+Returns:
+
+  EFI_SUCCESS       - BMC Self test results are retrieved and saved into TestResult
+  Others            - BMC failed to return self test results.
+
+--*/
+{
+  EFI_STATUS  Status;
+
+  Status = IpmiGetSelfTestResult (TestResult);
+  if (EFI_ERROR(Status)) {
+    DEBUG((DEBUG_ERROR, "[IPMI] BMC self-test does not respond (status: %r)\n", Status));
+    return Status;
+  }
+
+  DEBUG((DEBUG_INFO, "[IPMI] BMC self-test result: %02X-%02X\n", TestResult->Result, TestResult->Param));
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 GetDeviceId (
-  OUT BOOLEAN *UpdateMode
+  OUT IPMI_GET_DEVICE_ID_RESPONSE  *BmcInfo,
+  OUT BOOLEAN                      *UpdateMode
   )
 /*++
 
@@ -26,6 +66,8 @@ Routine Description:
   Mode.  If it is, then report it to the error manager.
 
 Arguments:
+  BmcInfo    - Receives the Get Device ID response.
+  UpdateMode - Set to TRUE if the BMC reported it is not ready yet.
 
 Returns:
   Status
@@ -33,7 +75,6 @@ Returns:
 --*/
 {
   EFI_STATUS                   Status;
-  IPMI_GET_DEVICE_ID_RESPONSE  BmcInfo;
   UINT32                       Retries;
 
   //
@@ -46,7 +87,7 @@ Returns:
   // Get the device ID information for the BMC.
   //
   do {
-    Status = IpmiGetDeviceId (&BmcInfo);
+    Status = IpmiGetDeviceId (BmcInfo);
     if (!EFI_ERROR(Status)) {
       break;
     }
@@ -59,17 +100,20 @@ Returns:
   DEBUG((
     DEBUG_INFO,
     "[IPMI] BMC Device ID: 0x%02X, firmware version: %d.%02X\n",
-    BmcInfo.DeviceId,
-    BmcInfo.FirmwareRev1.Bits.MajorFirmwareRev,
-    BmcInfo.MinorFirmwareRev
+    BmcInfo->DeviceId,
+    BmcInfo->FirmwareRev1.Bits.MajorFirmwareRev,
+    BmcInfo->MinorFirmwareRev
     ));
-  *UpdateMode = (BOOLEAN)BmcInfo.FirmwareRev1.Bits.UpdateMode;
+  *UpdateMode = (BOOLEAN)BmcInfo->FirmwareRev1.Bits.UpdateMode;
   return Status;
 }
 
 /**
   The entry point of the Ipmi PEIM.
 
+  The Get Device ID and Get Self Test results are published in a GUIDed HOB
+  so that the DXE and SMM IPMI drivers do not have to ask the BMC again.
+
   @param  FileHandle  Handle of the file being invoked.
   @param  PeiServices Describes the list of possible PEI Services.
 
@@ -83,14 +127,33 @@ PeimIpmiInterfaceInit (
   IN CONST EFI_PEI_SERVICES     **PeiServices
   )
 {
-  BOOLEAN      UpdateMode;
-  EFI_STATUS   Status;
+  BOOLEAN            UpdateMode;
+  EFI_STATUS         Status;
+  IPMI_BMC_INFO_HOB  BmcInfoHob;
 
   DEBUG ((DEBUG_INFO, "IPMI Peim:Get BMC Device Id\n"));
 
+  ZeroMem (&BmcInfoHob, sizeof (BmcInfoHob));
+  BmcInfoHob.Revision      = IPMI_BMC_INFO_HOB_REVISION;
+  BmcInfoHob.InterfaceType = FixedPcdGet8 (PcdIpmiInterfaceType);
+
   //
   // Get the Device ID and check if the system is in Force Update mode.
   //
-  Status = GetDeviceId (&UpdateMode);
+  Status = GetDeviceId (&BmcInfoHob.DeviceId, &UpdateMode);
+  if (!EFI_ERROR (Status) && !UpdateMode) {
+    BmcInfoHob.BmcReady = TRUE;
+    //
+    // Get the SELF TEST Results.
+    //
+    BmcInfoHob.SelfTestValid = (BOOLEAN)!EFI_ERROR (GetSelfTest (&BmcInfoHob.SelfTest));
+  }
+
+  //
+  // Still publish the HOB when the BMC is not ready, BmcReady tells DXE to
+  // query the BMC again.
+  //
+  BuildGuidDataHob (&gIpmiBmcInfoHobGuid, &BmcInfoHob, sizeof (BmcInfoHob));
+
   return Status;
 }
@@ -0,0 +1,473 @@
+/** @file
+  Buffered console output for the serial port mirrored by Serial Over LAN.
+
+  Console output reaches the UART as many small Write() calls, each of which
+  polls the line status for every byte. The serial ports' Write() is replaced
+  by one that only copies into a ring; a periodic timer hands the ring to the
+  UART in bursts of what the SOL bit rate can carry in one period, so POST
+  doesn't wait for the serial line on every string.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Library/PcdLib.h>
+#include "SolConsole.h"
+
+LIST_ENTRY  mSolConsoles = INITIALIZE_LIST_HEAD_VARIABLE (mSolConsoles);
+UINT32      mSolBaudRate;
+EFI_EVENT   mSolDrainEvent;
+VOID        *mSolSerialIoRegistration;
+
+UINT32
+SolBitRateToBaudRate (
+  IN UINT8                             BitRate
+  )
+/*++
+
+Routine Description:
+
+    Convert a SOL bit rate parameter value to a baud rate.
+
+Arguments:
+    BitRate         - SOL bit rate as returned by the BMC.
+Returns:
+    The baud rate, or 0 if the BMC uses the IPMI over serial setting or
+    the value is unknown.
+
+--*/
+{
+  switch (BitRate & 0x0F) {
+    case SOL_BIT_RATE_9600:
+      return 9600;
+    case SOL_BIT_RATE_19200:
+      return 19200;
+    case SOL_BIT_RATE_38400:
+      return 38400;
+    case SOL_BIT_RATE_57600:
+      return 57600;
+    case SOL_BIT_RATE_115200:
+      return 115200;
+    default:
+      return 0;
+  }
+}
+
+SOL_CONSOLE *
+SolConsoleFind (
+  IN EFI_SERIAL_IO_PROTOCOL            *SerialIo
+  )
+/*++
+
+Routine Description:
+
+    Find the buffered console of a serial port.
+
+Arguments:
+    SerialIo        - Serial port.
+Returns:
+    The console, or NULL if the serial port is not buffered.
+
+--*/
+{
+  LIST_ENTRY   *Link;
+  SOL_CONSOLE  *Console;
+
+  for (Link = GetFirstNode (&mSolConsoles); !IsNull (&mSolConsoles, Link); Link = GetNextNode (&mSolConsoles, Link)) {
+    Console = SOL_CONSOLE_FROM_LINK (Link);
+    if (Console->SerialIo == SerialIo) {
+      return Console;
+    }
+  }
+
+  return NULL;
+}
+
+VOID
+SolConsoleDrain (
+  IN SOL_CONSOLE                       *Console,
+  IN UINTN                             Budget
+  )
+/*++
+
+Routine Description:
+
+    Hand up to Budget bytes of the ring to the UART, oldest first. The ring
+    is only locked while a chunk is taken out of it, so Write() may add to it
+    while the UART is busy.
+
+Arguments:
+    Console         - Buffered console.
+    Budget          - Maximum number of bytes to write.
+Returns:
+    None.
+
+--*/
+{
+  EFI_TPL  OldTpl;
+  UINT8    Chunk[SOL_CONSOLE_CHUNK_SIZE];
+  UINTN    Size;
+  UINTN    Tail;
+  UINTN    RingSize;
+
+  RingSize = FixedPcdGet32 (PcdSolConsoleBufferSize);
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (Console->Draining) {
+    gBS->RestoreTPL (OldTpl);
+    return;
+  }
+  Console->Draining = TRUE;
+
+  while ((Console->Count != 0) && (Budget != 0)) {
+    Tail = (Console->Head + RingSize - Console->Count) % RingSize;
+    Size = MIN (MIN (Console->Count, Budget), MIN (sizeof (Chunk), RingSize - Tail));
+    CopyMem (Chunk, &Console->Ring[Tail], Size);
+    Console->Count -= Size;
+    Budget         -= Size;
+    gBS->RestoreTPL (OldTpl);
+
+    Console->OriginalWrite (Console->SerialIo, &Size, Chunk);
+
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  }
+
+  Console->Draining = FALSE;
+  gBS->RestoreTPL (OldTpl);
+}
+
+EFI_STATUS
+EFIAPI
+SolConsoleWrite (
+  IN EFI_SERIAL_IO_PROTOCOL            *This,
+  IN OUT UINTN                         *BufferSize,
+  IN VOID                              *Buffer
+  )
+/*++
+
+Routine Description:
+
+    Serial I/O Write() of a buffered serial port. Copies the data into the
+    ring, draining it first if there is no room.
+
+Arguments:
+    This            - Serial port.
+    BufferSize      - Number of bytes to write, all of them are taken.
+    Buffer          - Data to write.
+Returns:
+    EFI_SUCCESS     - The data was queued.
+    Others          - Result of writing to the UART directly.
+
+--*/
+{
+  SOL_CONSOLE  *Console;
+  EFI_TPL      OldTpl;
+  UINT8        *Data;
+  UINTN        Remaining;
+  UINTN        Size;
+  UINTN        RingSize;
+
+  Console = SolConsoleFind (This);
+  ASSERT (Console != NULL);
+
+  RingSize  = FixedPcdGet32 (PcdSolConsoleBufferSize);
+  Data      = Buffer;
+  Remaining = *BufferSize;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  while (Remaining != 0) {
+    if (Console->Count == RingSize) {
+      if (Console->Draining) {
+        //
+        // The ring is full and the drain it interrupted won't make room, so
+        // this part goes straight to the UART.
+        //
+        gBS->RestoreTPL (OldTpl);
+        Size = Remaining;
+        return Console->OriginalWrite (This, &Size, Data);
+      }
+
+      gBS->RestoreTPL (OldTpl);
+      SolConsoleDrain (Console, Remaining);
+      OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+      continue;
+    }
+
+    Size = MIN (MIN (Remaining, RingSize - Console->Count), RingSize - Console->Head);
+    CopyMem (&Console->Ring[Console->Head], Data, Size);
+    Console->Head   = (Console->Head + Size) % RingSize;
+    Console->Count += Size;
+    Data           += Size;
+    Remaining      -= Size;
+  }
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+SolConsoleReset (
+  IN EFI_SERIAL_IO_PROTOCOL            *This
+  )
+/*++
+
+Routine Description:
+
+    Serial I/O Reset() of a buffered serial port. Drains the ring first.
+
+Arguments:
+    This            - Serial port.
+Returns:
+    Result of the serial port's Reset().
+
+--*/
+{
+  SOL_CONSOLE  *Console;
+
+  Console = SolConsoleFind (This);
+  ASSERT (Console != NULL);
+
+  SolConsoleDrain (Console, MAX_UINTN);
+  return Console->OriginalReset (This);
+}
+
+EFI_STATUS
+EFIAPI
+SolConsoleSetAttributes (
+  IN EFI_SERIAL_IO_PROTOCOL            *This,
+  IN UINT64                            BaudRate,
+  IN UINT32                            ReceiveFifoDepth,
+  IN UINT32                            Timeout,
+  IN EFI_PARITY_TYPE                   Parity,
+  IN UINT8                             DataBits,
+  IN EFI_STOP_BITS_TYPE                StopBits
+  )
+/*++
+
+Routine Description:
+
+    Serial I/O SetAttributes() of a buffered serial port. Drains the ring
+    first, so the queued data goes out with the settings it was written for.
+
+Arguments:
+    This            - Serial port.
+    Others          - As for EFI_SERIAL_SET_ATTRIBUTES.
+Returns:
+    Result of the serial port's SetAttributes().
+
+--*/
+{
+  SOL_CONSOLE  *Console;
+
+  Console = SolConsoleFind (This);
+  ASSERT (Console != NULL);
+
+  SolConsoleDrain (Console, MAX_UINTN);
+  return Console->OriginalSetAttributes (This, BaudRate, ReceiveFifoDepth, Timeout, Parity, DataBits, StopBits);
+}
+
+VOID
+EFIAPI
+SolConsoleDrainTimer (
+  IN EFI_EVENT                         Event,
+  IN VOID                              *Context
+  )
+/*++
+
+Routine Description:
+
+    Periodic drain of every buffered console, one burst per period.
+
+Arguments:
+    Event           - Timer event.
+    Context         - Not used.
+Returns:
+    None.
+
+--*/
+{
+  LIST_ENTRY   *Link;
+  SOL_CONSOLE  *Console;
+  UINT64       BaudRate;
+
+  for (Link = GetFirstNode (&mSolConsoles); !IsNull (&mSolConsoles, Link); Link = GetNextNode (&mSolConsoles, Link)) {
+    Console  = SOL_CONSOLE_FROM_LINK (Link);
+    BaudRate = mSolBaudRate;
+    if (BaudRate == 0) {
+      BaudRate = (Console->SerialIo->Mode->BaudRate != 0) ? Console->SerialIo->Mode->BaudRate : SOL_CONSOLE_DEFAULT_BAUD;
+    }
+    //
+    // 10 bits per character: start, 8 data and stop.
+    //
+    SolConsoleDrain (Console, (UINTN) DivU64x32 (BaudRate, 10 * SOL_CONSOLE_DRAINS_PER_SECOND) + 1);
+  }
+}
+
+VOID
+EFIAPI
+SolConsoleSerialIoNotify (
+  IN EFI_EVENT                         Event,
+  IN VOID                              *Context
+  )
+/*++
+
+Routine Description:
+
+    Start buffering the serial ports installed since the last notification.
+
+Arguments:
+    Event           - Protocol notification event.
+    Context         - Not used.
+Returns:
+    None.
+
+--*/
+{
+  EFI_STATUS              Status;
+  EFI_HANDLE              Handle;
+  UINTN                   BufferSize;
+  EFI_SERIAL_IO_PROTOCOL  *SerialIo;
+  SOL_CONSOLE             *Console;
+
+  while (TRUE) {
+    BufferSize = sizeof (Handle);
+    Status = gBS->LocateHandle (ByRegisterNotify, NULL, mSolSerialIoRegistration, &BufferSize, &Handle);
+    if (EFI_ERROR (Status)) {
+      return;
+    }
+
+    Status = gBS->HandleProtocol (Handle, &gEfiSerialIoProtocolGuid, (VOID **) &SerialIo);
+    if (EFI_ERROR (Status) || (SolConsoleFind (SerialIo) != NULL)) {
+      continue;
+    }
+
+    Console = AllocateZeroPool (sizeof (*Console));
+    if (Console == NULL) {
+      return;
+    }
+
+    Console->Ring = AllocatePool (FixedPcdGet32 (PcdSolConsoleBufferSize));
+    if (Console->Ring == NULL) {
+      FreePool (Console);
+      return;
+    }
+
+    Console->Signature             = SOL_CONSOLE_SIGNATURE;
+    Console->SerialIo              = SerialIo;
+    Console->OriginalReset         = SerialIo->Reset;
+    Console->OriginalSetAttributes = SerialIo->SetAttributes;
+    Console->OriginalWrite         = SerialIo->Write;
+    InsertTailList (&mSolConsoles, &Console->Link);
+
+    SerialIo->Reset         = SolConsoleReset;
+    SerialIo->SetAttributes = SolConsoleSetAttributes;
+    SerialIo->Write         = SolConsoleWrite;
+
+    DEBUG ((DEBUG_INFO, "[SOL] Buffering console output of serial port %p\n", SerialIo));
+  }
+}
+
+VOID
+EFIAPI
+SolConsoleExitBootServices (
+  IN EFI_EVENT                         Event,
+  IN VOID                              *Context
+  )
+/*++
+
+Routine Description:
+
+    Write out everything still queued and give the serial ports their own
+    Write() back, as the timer stops with the boot services.
+
+Arguments:
+    Event           - ExitBootServices event.
+    Context         - Not used.
+Returns:
+    None.
+
+--*/
+{
+  LIST_ENTRY   *Link;
+  SOL_CONSOLE  *Console;
+
+  gBS->SetTimer (mSolDrainEvent, TimerCancel, 0);
+
+  for (Link = GetFirstNode (&mSolConsoles); !IsNull (&mSolConsoles, Link); Link = GetNextNode (&mSolConsoles, Link)) {
+    Console = SOL_CONSOLE_FROM_LINK (Link);
+    SolConsoleDrain (Console, MAX_UINTN);
+    Console->SerialIo->Reset         = Console->OriginalReset;
+    Console->SerialIo->SetAttributes = Console->OriginalSetAttributes;
+    Console->SerialIo->Write         = Console->OriginalWrite;
+  }
+}
+
+EFI_STATUS
+SolConsoleInitialize (
+  IN UINT32                            BaudRate
+  )
+/*++
+
+Routine Description:
+
+    Start buffering the output of every serial port, and drain it in
+    bursts sized for the SOL baud rate.
+
+Arguments:
+    BaudRate        - SOL baud rate, 0 to use the serial port's own rate.
+Returns:
+    EFI_SUCCESS     - Serial ports will be buffered as they appear.
+    Others          - The events could not be created.
+
+--*/
+{
+  EFI_STATUS  Status;
+  EFI_EVENT   Event;
+
+  mSolBaudRate = BaudRate;
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  SolConsoleDrainTimer,
+                  NULL,
+                  &mSolDrainEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                  TPL_NOTIFY,
+                  SolConsoleExitBootServices,
+                  NULL,
+                  &Event
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (mSolDrainEvent);
+    return Status;
+  }
+
+  Status = gBS->SetTimer (mSolDrainEvent, TimerPeriodic, SOL_CONSOLE_DRAIN_PERIOD);
+  ASSERT_EFI_ERROR (Status);
+
+  Event = EfiCreateProtocolNotifyEvent (
+            &gEfiSerialIoProtocolGuid,
+            TPL_CALLBACK,
+            SolConsoleSerialIoNotify,
+            NULL,
+            &mSolSerialIoRegistration
+            );
+  ASSERT (Event != NULL);
+
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/** @file
+  Buffered console output for the serial port mirrored by Serial Over LAN.
+
+  @copyright
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _SOL_CONSOLE_H_
+#define _SOL_CONSOLE_H_
+
+#include <Protocol/SerialIo.h>
+
+//
+// SOL configuration parameter 5, non-volatile bit rate, and its encodings.
+//
+#define SOL_PARAM_NV_BIT_RATE         5
+#define SOL_BIT_RATE_SERIAL_SETTING   0x00
+#define SOL_BIT_RATE_9600             0x06
+#define SOL_BIT_RATE_19200            0x07
+#define SOL_BIT_RATE_38400            0x08
+#define SOL_BIT_RATE_57600            0x09
+#define SOL_BIT_RATE_115200           0x0A
+
+#define SOL_CONSOLE_SIGNATURE         SIGNATURE_32 ('s', 'o', 'l', 'c')
+#define SOL_CONSOLE_DRAIN_PERIOD      100000    // 10ms, in 100ns units
+#define SOL_CONSOLE_DRAINS_PER_SECOND 100
+#define SOL_CONSOLE_CHUNK_SIZE        64        // Bytes handed to the UART per Write()
+#define SOL_CONSOLE_DEFAULT_BAUD      115200
+
+//
+// A serial port whose Write() goes through the ring. The original member
+// functions are called to drain it and are put back at ExitBootServices.
+//
+typedef struct {
+  UINTN                       Signature;
+  LIST_ENTRY                  Link;
+  EFI_SERIAL_IO_PROTOCOL      *SerialIo;
+  EFI_SERIAL_RESET            OriginalReset;
+  EFI_SERIAL_SET_ATTRIBUTES   OriginalSetAttributes;
+  EFI_SERIAL_WRITE            OriginalWrite;
+  UINT8                       *Ring;
+  UINTN                       Head;
+  UINTN                       Count;
+  BOOLEAN                     Draining;
+} SOL_CONSOLE;
+
+#define SOL_CONSOLE_FROM_LINK(a)  CR (a, SOL_CONSOLE, Link, SOL_CONSOLE_SIGNATURE)
+
+UINT32
+SolBitRateToBaudRate (
+  IN UINT8                             BitRate
+  )
+/*++
+
+Routine Description:
+
+    Convert a SOL bit rate parameter value to a baud rate.
+
+Arguments:
+    BitRate         - SOL bit rate as returned by the BMC.
+Returns:
+    The baud rate, or 0 if the BMC uses the IPMI over serial setting or
+    the value is unknown.
+
+--*/
+;
+
+EFI_STATUS
+SolConsoleInitialize (
+  IN UINT32                            BaudRate
+  )
+/*++
+
+Routine Description:
+
+    Start buffering the output of every serial port, and drain it in
+    bursts sized for the SOL baud rate.
+
+Arguments:
+    BaudRate        - SOL baud rate, 0 to use the serial port's own rate.
+Returns:
+    EFI_SUCCESS     - Serial ports will be buffered as they appear.
+    Others          - The events could not be created.
+
+--*/
+;
+
+#endif
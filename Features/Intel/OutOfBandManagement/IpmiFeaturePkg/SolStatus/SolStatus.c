@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/IpmiCommandLib.h>
 #include <IndustryStandard/Ipmi.h>
+#include "SolConsole.h"
 
 #define SOL_CMD_RETRY_COUNT           10
 
@@ -150,6 +151,9 @@ SolStatusEntryPoint (
   EFI_STATUS  Status = EFI_SUCCESS;
   UINT8       Channel;
   BOOLEAN     SolEnabled = FALSE;
+  BOOLEAN     AnySolEnabled = FALSE;
+  UINT8       BitRate;
+  UINT32      BaudRate = 0;
 
   for (Channel = 1; Channel <= PcdGet8 (PcdMaxSOLChannels); Channel++) {
     Status = GetSOLStatus (Channel, IPMI_SOL_CONFIGURATION_PARAMETER_SOL_ENABLE, &SolEnabled);
@@ -158,6 +162,21 @@ SolStatusEntryPoint (
     } else {
       DEBUG ((DEBUG_ERROR, "Failed to get channel %x SOL status from BMC!, status is %x\n", Channel, Status));
     }
+
+    if ((Status == EFI_SUCCESS) && ((SolEnabled & BIT0) != 0)) {
+      AnySolEnabled = TRUE;
+      //
+      // Console output is drained at the fastest rate an enabled channel runs at.
+      //
+      if (GetSOLStatus (Channel, SOL_PARAM_NV_BIT_RATE, &BitRate) == EFI_SUCCESS) {
+        DEBUG ((DEBUG_INFO, "SOL bit rate for channel %x is %d\n", Channel, SolBitRateToBaudRate (BitRate)));
+        BaudRate = MAX (BaudRate, SolBitRateToBaudRate (BitRate));
+      }
+    }
+  }
+
+  if (AnySolEnabled && (FixedPcdGet32 (PcdSolConsoleBufferSize) != 0)) {
+    SolConsoleInitialize (BaudRate);
   }
 
   return Status;
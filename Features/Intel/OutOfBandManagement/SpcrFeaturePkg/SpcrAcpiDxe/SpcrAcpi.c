@@ -417,6 +417,11 @@ OutOfBandACPITableConstruction (
     goto out;
   }
 
+  //
+  // SPCR can only name these four rates. For any other one, including the
+  // faster rates a BMC may mirror the port at, advertise "as is" so the OS
+  // keeps the rate the firmware programmed instead of dropping to 115200.
+  //
   switch (SerialIo->Mode->BaudRate) {
     case 9600:
       gSpcrInfo.BaudRate = 3;
@@ -427,10 +432,13 @@ OutOfBandACPITableConstruction (
     case 57600:
       gSpcrInfo.BaudRate = 6;
       break;
+    case 0:
     case 115200:
-    default:
       gSpcrInfo.BaudRate = 7;
       break;
+    default:
+      gSpcrInfo.BaudRate = 0;
+      break;
   }
 
   gSpcrInfo.FlowControl = 0;
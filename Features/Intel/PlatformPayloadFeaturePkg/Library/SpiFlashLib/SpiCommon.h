@@ -31,6 +31,12 @@
 #define WAIT_TIME    6000000    ///< Wait Time = 6 seconds = 6000000 microseconds
 #define WAIT_PERIOD  10         ///< Wait Period = 10 microseconds
 
+///
+/// Number of status polls done back to back before waiting WAIT_PERIOD between polls.
+/// Short cycles such as 64 byte reads complete well within a single wait period.
+///
+#define WAIT_FAST_POLL_COUNT  1000
+
 ///
 /// Flash cycle Type
 ///
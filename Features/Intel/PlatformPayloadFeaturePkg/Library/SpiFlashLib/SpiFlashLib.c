@@ -614,7 +614,7 @@ SendSpiCmd (
 
   do {
     SpiDataCount = ByteCount;
-    if ((FlashCycleType == FlashCycleRead) || (FlashCycleType == FlashCycleWrite)) {
+    if (FlashCycleType == FlashCycleWrite) {
       //
       // Trim at 256 byte boundary per operation,
       // - SC SPI controller requires trimming at 4KB boundary
@@ -625,6 +625,19 @@ SendSpiCmd (
       if (HardwareSpiAddr + ByteCount > ((HardwareSpiAddr + BIT8) &~(BIT8 - 1))) {
         SpiDataCount = (((UINT32)(HardwareSpiAddr) + BIT8) &~(BIT8 - 1)) - (UINT32)(HardwareSpiAddr);
       }
+    }
+
+    if (FlashCycleType == FlashCycleRead) {
+      //
+      // Reads only need trimming at the 4KB boundary required by the SC SPI controller,
+      // so an unaligned read gets back to full 64 byte cycles as soon as possible.
+      //
+      if (HardwareSpiAddr + ByteCount > ((HardwareSpiAddr + SIZE_4KB) &~(SIZE_4KB - 1))) {
+        SpiDataCount = (((UINT32)(HardwareSpiAddr) + SIZE_4KB) &~(SIZE_4KB - 1)) - (UINT32)(HardwareSpiAddr);
+      }
+    }
+
+    if ((FlashCycleType == FlashCycleRead) || (FlashCycleType == FlashCycleWrite)) {
 
       //
       // Calculate the number of bytes to shift in/out during the SPI data cycle.
@@ -785,9 +798,10 @@ WaitForSpiCycleComplete (
   //
   WaitCount = WAIT_TIME / WAIT_PERIOD;
   //
-  // Wait for the SPI cycle to complete.
+  // Wait for the SPI cycle to complete. Poll back to back first, so that
+  // short cycles can be followed by the next one without any delay.
   //
-  for (WaitTicks = 0; WaitTicks < WaitCount; WaitTicks++) {
+  for (WaitTicks = 0; WaitTicks < WAIT_FAST_POLL_COUNT + WaitCount; WaitTicks++) {
     Data32 = MmioRead32 (ScSpiBar0 + R_SPI_HSFS);
     if ((Data32 & B_SPI_HSFS_SCIP) == 0) {
       MmioWrite32 (ScSpiBar0 + R_SPI_HSFS, B_SPI_HSFS_FCERR | B_SPI_HSFS_FDONE);
@@ -798,7 +812,9 @@ WaitForSpiCycleComplete (
       }
     }
 
-    MicroSecondDelay (WAIT_PERIOD);
+    if (WaitTicks >= WAIT_FAST_POLL_COUNT) {
+      MicroSecondDelay (WAIT_PERIOD);
+    }
   }
 
   return FALSE;
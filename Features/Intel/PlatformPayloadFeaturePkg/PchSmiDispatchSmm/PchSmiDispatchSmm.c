@@ -22,6 +22,12 @@ SMM_PCH_REGISTER  mSmiPchReg;
 EFI_SMM_CPU_PROTOCOL  *mSmmCpuProtocol;
 LIST_ENTRY            mSmmSwDispatch2Queue = INITIALIZE_LIST_HEAD_VARIABLE (mSmmSwDispatch2Queue);
 
+//
+// Registered contexts indexed by SW SMI value, so that dispatching doesn't
+// depend on the number of registered handlers.
+//
+EFI_SMM_SW_DISPATCH2_CONTEXT  *mSmmSwDispatch2Table[MAXIMUM_SWI_VALUE + 1];
+
 /**
   Find SmmSwDispatch2Context by SwSmiInputValue.
 
@@ -34,18 +40,11 @@ FindContextBySwSmiInputValue (
   IN UINTN  SwSmiInputValue
   )
 {
-  LIST_ENTRY                    *Node;
-  EFI_SMM_SW_DISPATCH2_CONTEXT  *Dispatch2Context;
-
-  Node = mSmmSwDispatch2Queue.ForwardLink;
-  for ( ; Node != &mSmmSwDispatch2Queue; Node = Node->ForwardLink) {
-    Dispatch2Context = BASE_CR (Node, EFI_SMM_SW_DISPATCH2_CONTEXT, Link);
-    if (Dispatch2Context->SwSmiInputValue == SwSmiInputValue) {
-      return Dispatch2Context;
-    }
+  if (SwSmiInputValue > MAXIMUM_SWI_VALUE) {
+    return NULL;
   }
 
-  return NULL;
+  return mSmmSwDispatch2Table[SwSmiInputValue];
 }
 
 /**
@@ -103,11 +102,31 @@ SmmSwDispatcher (
   UINTN                         Size;
   EFI_SMM_SAVE_STATE_IO_INFO    IoInfo;
 
+  //
+  // The command port alone tells whether there is anything to dispatch,
+  // check it before doing any other access.
+  //
+  SwContext.CommandPort = IoRead8 (SMM_CONTROL_PORT);
+  if (SwContext.CommandPort == 0) {
+    DEBUG ((DEBUG_VERBOSE, "NOT SW SMI\n"));
+    Status = EFI_SUCCESS;
+    goto End;
+  }
+
+  //
+  // Search context
+  //
+  Context = FindContextBySwSmiInputValue (SwContext.CommandPort);
+  if (Context == NULL) {
+    DEBUG ((DEBUG_INFO, "No handler for SMI value 0x%x\n", SwContext.CommandPort));
+    Status = EFI_SUCCESS;
+    goto End;
+  }
+
   //
   // Construct new context
   //
   SwContext.SwSmiCpuIndex = 0;
-  SwContext.CommandPort   = IoRead8 (SMM_CONTROL_PORT);
   SwContext.DataPort      = IoRead8 (SMM_DATA_PORT);
 
   //
@@ -135,22 +154,6 @@ SmmSwDispatcher (
     }
   }
 
-  if (SwContext.CommandPort == 0) {
-    DEBUG ((DEBUG_VERBOSE, "NOT SW SMI\n"));
-    Status = EFI_SUCCESS;
-    goto End;
-  }
-
-  //
-  // Search context
-  //
-  Context = FindContextBySwSmiInputValue (SwContext.CommandPort);
-  if (Context == NULL) {
-    DEBUG ((DEBUG_INFO, "No handler for SMI value 0x%x\n", SwContext.CommandPort));
-    Status = EFI_SUCCESS;
-    goto End;
-  }
-
   DEBUG ((DEBUG_VERBOSE, "Prepare to call handler for 0x%x\n", SwContext.CommandPort));
 
   //
@@ -189,15 +192,8 @@ SmiInputValueCheck (
   IN UINTN  SwSmiInputValue
   )
 {
-  LIST_ENTRY                    *Node;
-  EFI_SMM_SW_DISPATCH2_CONTEXT  *Dispatch2Context;
-
-  Node = mSmmSwDispatch2Queue.ForwardLink;
-  for ( ; Node != &mSmmSwDispatch2Queue; Node = Node->ForwardLink) {
-    Dispatch2Context = BASE_CR (Node, EFI_SMM_SW_DISPATCH2_CONTEXT, Link);
-    if (Dispatch2Context->SwSmiInputValue == SwSmiInputValue) {
-      return EFI_INVALID_PARAMETER;
-    }
+  if (FindContextBySwSmiInputValue (SwSmiInputValue) != NULL) {
+    return EFI_INVALID_PARAMETER;
   }
 
   return EFI_SUCCESS;
@@ -268,6 +264,14 @@ SmmSwDispatch2Register (
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Only one handler can be dispatched for each value
+  //
+  if (EFI_ERROR (SmiInputValueCheck (RegContext->SwSmiInputValue))) {
+    DEBUG ((DEBUG_ERROR, "ERROR: SMI value 0x%x is already registered\n", RegContext->SwSmiInputValue));
+    return EFI_INVALID_PARAMETER;
+  }
+
   //
   // Register
   //
@@ -283,6 +287,7 @@ SmmSwDispatch2Register (
   Context->DispatchFunction = (UINTN)DispatchFunction;
   Context->DispatchHandle   = *DispatchHandle;
   InsertTailList (&mSmmSwDispatch2Queue, &Context->Link);
+  mSmmSwDispatch2Table[Context->SwSmiInputValue] = Context;
 
   return Status;
 }
@@ -315,6 +320,7 @@ SmmSwDispatch2UnRegister (
   ASSERT (Context != NULL);
   if (Context != NULL) {
     RemoveEntryList (&Context->Link);
+    mSmmSwDispatch2Table[Context->SwSmiInputValue] = NULL;
     gSmst->SmmFreePool (Context);
   }
 
@@ -8,6 +8,161 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Library/PeiServicesLib.h>
 #include <Library/SmmAccessLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PerformanceLib.h>
+#include <Library/TimerLib.h>
+
+#include <Ppi/EndOfPeiPhase.h>
+#include <Ppi/PostBootScriptTable.h>
+
+typedef struct {
+  EFI_PEI_NOTIFY_DESCRIPTOR  EndOfPeiNotify;
+  EFI_PEI_NOTIFY_DESCRIPTOR  PostScriptTableNotify;
+  UINT64                     MemoryDiscoveredTicks;
+  UINT64                     EndOfPeiTicks;
+} S3_RESUME_PROFILE;
+
+/**
+  Return the time in microseconds between two performance counter values.
+
+  @param[in]  StartTicks  The performance counter value at the start.
+  @param[in]  EndTicks    The performance counter value at the end.
+
+  @return The elapsed time in microseconds.
+**/
+UINT64
+S3PeiElapsedMicroseconds (
+  IN UINT64  StartTicks,
+  IN UINT64  EndTicks
+  )
+{
+  UINT64  StartValue;
+  UINT64  EndValue;
+
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  if (StartValue > EndValue) {
+    //
+    // The performance counter counts down.
+    //
+    return DivU64x32 (GetTimeInNanoSecond (StartTicks - EndTicks), 1000);
+  }
+  return DivU64x32 (GetTimeInNanoSecond (EndTicks - StartTicks), 1000);
+}
+
+/**
+  End of PEI notification on S3 resume. The S3 resume PEIM signals it right before
+  the boot script is replayed.
+
+  @param[in]  PeiServices       General purpose services available to every PEIM.
+  @param[in]  NotifyDescriptor  Pointer to the descriptor of the notification event.
+  @param[in]  Ppi               Pointer to the PPI associated with the descriptor.
+
+  @retval     EFI_SUCCESS       The function completes successfully
+**/
+EFI_STATUS
+EFIAPI
+S3PeiEndOfPeiNotify (
+  IN EFI_PEI_SERVICES           **PeiServices,
+  IN EFI_PEI_NOTIFY_DESCRIPTOR  *NotifyDescriptor,
+  IN VOID                       *Ppi
+  )
+{
+  S3_RESUME_PROFILE  *Profile;
+
+  Profile = BASE_CR (NotifyDescriptor, S3_RESUME_PROFILE, EndOfPeiNotify);
+  Profile->EndOfPeiTicks = GetPerformanceCounter ();
+
+  DEBUG ((
+    DEBUG_INFO,
+    "S3 resume: memory discovered to end of PEI - %ld us\n",
+    S3PeiElapsedMicroseconds (Profile->MemoryDiscoveredTicks, Profile->EndOfPeiTicks)
+    ));
+
+  PERF_INMODULE_BEGIN ("S3BootScriptReplay");
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Post boot script table notification on S3 resume. The S3 resume PEIM installs it
+  once the boot script has been replayed, right before waking the OS.
+
+  @param[in]  PeiServices       General purpose services available to every PEIM.
+  @param[in]  NotifyDescriptor  Pointer to the descriptor of the notification event.
+  @param[in]  Ppi               Pointer to the PPI associated with the descriptor.
+
+  @retval     EFI_SUCCESS       The function completes successfully
+**/
+EFI_STATUS
+EFIAPI
+S3PeiPostScriptTableNotify (
+  IN EFI_PEI_SERVICES           **PeiServices,
+  IN EFI_PEI_NOTIFY_DESCRIPTOR  *NotifyDescriptor,
+  IN VOID                       *Ppi
+  )
+{
+  S3_RESUME_PROFILE  *Profile;
+  UINT64             Ticks;
+
+  PERF_INMODULE_END ("S3BootScriptReplay");
+
+  Ticks   = GetPerformanceCounter ();
+  Profile = BASE_CR (NotifyDescriptor, S3_RESUME_PROFILE, PostScriptTableNotify);
+
+  if (Profile->EndOfPeiTicks != 0) {
+    DEBUG ((
+      DEBUG_INFO,
+      "S3 resume: boot script replay - %ld us\n",
+      S3PeiElapsedMicroseconds (Profile->EndOfPeiTicks, Ticks)
+      ));
+  }
+  DEBUG ((
+    DEBUG_INFO,
+    "S3 resume: memory discovered to OS waking vector - %ld us\n",
+    S3PeiElapsedMicroseconds (Profile->MemoryDiscoveredTicks, Ticks)
+    ));
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Timestamp the phases of the S3 resume path that run after memory is discovered.
+
+  @retval     EFI_SUCCESS          The notifications are registered.
+  @retval     EFI_OUT_OF_RESOURCES Insufficient resources to allocate the profile.
+**/
+EFI_STATUS
+S3PeiRegisterResumeProfile (
+  VOID
+  )
+{
+  EFI_STATUS         Status;
+  S3_RESUME_PROFILE  *Profile;
+
+  //
+  // The descriptors are allocated rather than global, as the module may run in place.
+  //
+  Profile = AllocateZeroPool (sizeof (S3_RESUME_PROFILE));
+  if (Profile == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Profile->MemoryDiscoveredTicks = GetPerformanceCounter ();
+
+  Profile->EndOfPeiNotify.Flags  = EFI_PEI_PPI_DESCRIPTOR_NOTIFY_CALLBACK | EFI_PEI_PPI_DESCRIPTOR_TERMINATE_LIST;
+  Profile->EndOfPeiNotify.Guid   = &gEfiEndOfPeiSignalPpiGuid;
+  Profile->EndOfPeiNotify.Notify = S3PeiEndOfPeiNotify;
+  Status = PeiServicesNotifyPpi (&Profile->EndOfPeiNotify);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Profile->PostScriptTableNotify.Flags  = EFI_PEI_PPI_DESCRIPTOR_NOTIFY_CALLBACK | EFI_PEI_PPI_DESCRIPTOR_TERMINATE_LIST;
+  Profile->PostScriptTableNotify.Guid   = &gPeiPostScriptTablePpiGuid;
+  Profile->PostScriptTableNotify.Notify = S3PeiPostScriptTableNotify;
+  return PeiServicesNotifyPpi (&Profile->PostScriptTableNotify);
+}
 
 /**
   S3 PEI module entry point
@@ -25,12 +180,21 @@ S3PeiEntryPoint (
   IN CONST EFI_PEI_SERVICES     **PeiServices
   )
 {
-  EFI_STATUS Status;
+  EFI_STATUS     Status;
+  EFI_BOOT_MODE  BootMode;
 
   //
   // Install EFI_PEI_MM_ACCESS_PPI for S3 resume case
   //
   Status = PeiInstallSmmAccessPpi ();
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (!EFI_ERROR (PeiServicesGetBootMode (&BootMode)) && (BootMode == BOOT_ON_S3_RESUME)) {
+    Status = S3PeiRegisterResumeProfile ();
+    ASSERT_EFI_ERROR (Status);
+  }
 
-  return Status;
+  return EFI_SUCCESS;
 }
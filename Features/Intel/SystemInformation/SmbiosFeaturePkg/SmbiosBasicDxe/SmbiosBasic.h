@@ -42,4 +42,27 @@ AddSmbiosRecord (
   IN EFI_SMBIOS_TABLE_HEADER    *Record
   );
 
+/**
+  Create an SMBIOS record from a template and its strings, in a single allocation.
+
+  @param  Template              The template for the formatted area of the record.
+  @param  TemplateSize          The size of Template in bytes.
+  @param  Type                  The SMBIOS structure type of the record.
+  @param  Length                The length of the formatted area of the record.
+  @param  Strings               The strings following the formatted area, in string number order.
+  @param  StringCount           The number of strings in Strings.
+
+  @return The record, which the caller must free with FreePool, or NULL if out of resources.
+
+**/
+EFI_SMBIOS_TABLE_HEADER *
+CreateSmbiosRecord (
+  IN CONST VOID                 *Template,
+  IN UINTN                      TemplateSize,
+  IN UINT8                      Type,
+  IN UINT8                      Length,
+  IN CHAR8                      **Strings,
+  IN UINTN                      StringCount
+  );
+
 #endif
@@ -123,3 +123,64 @@ AddSmbiosRecord (
                    Record
                    );
 }
+
+/**
+  Create an SMBIOS record from a template and its strings, in a single allocation.
+
+  @param  Template              The template for the formatted area of the record.
+  @param  TemplateSize          The size of Template in bytes.
+  @param  Type                  The SMBIOS structure type of the record.
+  @param  Length                The length of the formatted area of the record.
+  @param  Strings               The strings following the formatted area, in string number order.
+  @param  StringCount           The number of strings in Strings.
+
+  @return The record, which the caller must free with FreePool, or NULL if out of resources.
+
+**/
+EFI_SMBIOS_TABLE_HEADER *
+CreateSmbiosRecord (
+  IN CONST VOID                 *Template,
+  IN UINTN                      TemplateSize,
+  IN UINT8                      Type,
+  IN UINT8                      Length,
+  IN CHAR8                      **Strings,
+  IN UINTN                      StringCount
+  )
+{
+  EFI_SMBIOS_TABLE_HEADER       *Record;
+  UINTN                         Index;
+  UINTN                         StringLength;
+  UINTN                         TotalSize;
+  UINTN                         StringOffset;
+
+  //
+  // Two zeros following the last string.
+  //
+  TotalSize = Length + 1 + 1;
+  for (Index = 0; Index < StringCount; Index++) {
+    StringLength = AsciiStrLen (Strings[Index]);
+    ASSERT (StringLength <= SMBIOS_STRING_MAX_LENGTH);
+    TotalSize += StringLength + 1;
+  }
+
+  Record = AllocateZeroPool (TotalSize);
+  if (Record == NULL) {
+    ASSERT_EFI_ERROR (EFI_OUT_OF_RESOURCES);
+    return NULL;
+  }
+
+  CopyMem (Record, Template, MIN (TemplateSize, Length));
+
+  Record->Type   = Type;
+  Record->Length = Length;
+  Record->Handle = 0;
+
+  StringOffset = Length;
+  for (Index = 0; Index < StringCount; Index++) {
+    StringLength = AsciiStrLen (Strings[Index]);
+    CopyMem ((UINT8 *) Record + StringOffset, Strings[Index], StringLength);
+    StringOffset += StringLength + 1;
+  }
+
+  return Record;
+}
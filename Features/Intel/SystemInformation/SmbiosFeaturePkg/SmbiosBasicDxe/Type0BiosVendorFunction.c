@@ -24,53 +24,26 @@ BiosVendorFunction(
   )
 {
   EFI_STATUS            Status;
-  CHAR8                 *VendorStr;
-  UINTN                 VendorStrLen;
-  CHAR8                 *VersionStr;
-  UINTN                 VerStrLen;
-  CHAR8                 *DateStr;
-  UINTN                 DateStrLen;
+  CHAR8                 *Strings[3];
   SMBIOS_TABLE_TYPE0    *SmbiosRecord;
-  SMBIOS_TABLE_TYPE0    *PcdSmbiosRecord;
   EFI_SMBIOS_HANDLE     SmbiosHandle;
-  UINTN                 StringOffset;
 
-  PcdSmbiosRecord = PcdGetPtr (PcdSmbiosType0BiosInformation);
-
-  VendorStr = PcdGetPtr (PcdSmbiosType0StringVendor);
-  VendorStrLen = AsciiStrLen (VendorStr);
-  ASSERT (VendorStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  VersionStr = PcdGetPtr (PcdSmbiosType0StringBiosVersion);
-  VerStrLen = AsciiStrLen (VersionStr);
-  ASSERT (VerStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  DateStr = PcdGetPtr (PcdSmbiosType0StringBiosReleaseDate);
-  DateStrLen = AsciiStrLen (DateStr);
-  ASSERT (DateStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  //
-  // Two zeros following the last string.
-  //
-  SmbiosRecord = AllocateZeroPool (sizeof (SMBIOS_TABLE_TYPE0) + VendorStrLen + 1 + VerStrLen + 1 + DateStrLen + 1 + 1);
+  Strings[0] = PcdGetPtr (PcdSmbiosType0StringVendor);
+  Strings[1] = PcdGetPtr (PcdSmbiosType0StringBiosVersion);
+  Strings[2] = PcdGetPtr (PcdSmbiosType0StringBiosReleaseDate);
+
+  SmbiosRecord = (SMBIOS_TABLE_TYPE0 *) CreateSmbiosRecord (
+                                          PcdGetPtr (PcdSmbiosType0BiosInformation),
+                                          sizeof (SMBIOS_TABLE_TYPE0),
+                                          SMBIOS_TYPE_BIOS_INFORMATION,
+                                          sizeof (SMBIOS_TABLE_TYPE0),
+                                          Strings,
+                                          ARRAY_SIZE (Strings)
+                                          );
   if (SmbiosRecord == NULL) {
-    ASSERT_EFI_ERROR (EFI_OUT_OF_RESOURCES);
     return EFI_OUT_OF_RESOURCES;
   }
 
-  CopyMem (SmbiosRecord, PcdSmbiosRecord, sizeof(SMBIOS_TABLE_TYPE0));
-
-  SmbiosRecord->Hdr.Type = SMBIOS_TYPE_BIOS_INFORMATION;
-  SmbiosRecord->Hdr.Length = sizeof (SMBIOS_TABLE_TYPE0);
-  SmbiosRecord->Hdr.Handle = 0;
-
-  StringOffset = SmbiosRecord->Hdr.Length;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, VendorStr, VendorStrLen);
-  StringOffset += VendorStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, VersionStr, VerStrLen);
-  StringOffset += VerStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, DateStr, DateStrLen);
-
   //
   // Now we have got the full smbios record, call smbios protocol to add this record.
   //
@@ -24,86 +24,29 @@ SystemManufacturerFunction(
   )
 {
   EFI_STATUS                      Status;
-  CHAR8                           *ManufacturerStr;
-  CHAR8                           *ProductNameStr;
-  CHAR8                           *VersionStr;
-  CHAR8                           *SerialNumberStr;
-  CHAR8                           *SKUNumberStr;
-  CHAR8                           *FamilyStr;
-  UINTN                           ManufacturerStrLen;
-  UINTN                           ProductNameStrLen;
-  UINTN                           VersionStrLen;
-  UINTN                           SerialNumberStrLen;
-  UINTN                           SKUNumberStrLen;
-  UINTN                           FamilyStrLen;
-  UINTN                           TableSize;
-  SMBIOS_TABLE_TYPE1              *PcdSmbiosRecord;
+  CHAR8                           *Strings[6];
   SMBIOS_TABLE_TYPE1              *SmbiosRecord;
   EFI_SMBIOS_HANDLE               SmbiosHandle;
-  UINTN                           StringOffset;
 
-  PcdSmbiosRecord = PcdGetPtr (PcdSmbiosType1SystemInformation);
-
-  ManufacturerStr = PcdGetPtr (PcdSmbiosType1StringManufacturer);
-  ManufacturerStrLen = AsciiStrLen (ManufacturerStr);
-  ASSERT (ManufacturerStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  ProductNameStr = PcdGetPtr (PcdSmbiosType1StringProductName);
-  ProductNameStrLen = AsciiStrLen (ProductNameStr);
-  ASSERT (ProductNameStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  VersionStr = PcdGetPtr (PcdSmbiosType1StringVersion);
-  VersionStrLen = AsciiStrLen (VersionStr);
-  ASSERT (VersionStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  SerialNumberStr = PcdGetPtr (PcdSmbiosType1StringSerialNumber);
-  SerialNumberStrLen = AsciiStrLen (SerialNumberStr);
-  ASSERT (SerialNumberStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  SKUNumberStr = PcdGetPtr (PcdSmbiosType1StringSKUNumber);
-  SKUNumberStrLen = AsciiStrLen (SKUNumberStr);
-  ASSERT (SKUNumberStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  FamilyStr = PcdGetPtr (PcdSmbiosType1StringFamily);
-  FamilyStrLen = AsciiStrLen (FamilyStr);
-  ASSERT (FamilyStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  //
-  // Create table size based on string lengths
-  //
-  TableSize = sizeof (SMBIOS_TABLE_TYPE1) + ManufacturerStrLen + 1 + ProductNameStrLen + 1 + VersionStrLen + 1 + SerialNumberStrLen + 1 + SKUNumberStrLen + 1 + FamilyStrLen + 1 + 1;
-  SmbiosRecord = AllocateZeroPool (TableSize);
+  Strings[0] = PcdGetPtr (PcdSmbiosType1StringManufacturer);
+  Strings[1] = PcdGetPtr (PcdSmbiosType1StringProductName);
+  Strings[2] = PcdGetPtr (PcdSmbiosType1StringVersion);
+  Strings[3] = PcdGetPtr (PcdSmbiosType1StringSerialNumber);
+  Strings[4] = PcdGetPtr (PcdSmbiosType1StringSKUNumber);
+  Strings[5] = PcdGetPtr (PcdSmbiosType1StringFamily);
+
+  SmbiosRecord = (SMBIOS_TABLE_TYPE1 *) CreateSmbiosRecord (
+                                          PcdGetPtr (PcdSmbiosType1SystemInformation),
+                                          sizeof (SMBIOS_TABLE_TYPE1),
+                                          SMBIOS_TYPE_SYSTEM_INFORMATION,
+                                          sizeof (SMBIOS_TABLE_TYPE1),
+                                          Strings,
+                                          ARRAY_SIZE (Strings)
+                                          );
   if (SmbiosRecord == NULL) {
-    ASSERT_EFI_ERROR (EFI_OUT_OF_RESOURCES);
     return EFI_OUT_OF_RESOURCES;
   }
 
-  CopyMem (SmbiosRecord, PcdSmbiosRecord, sizeof(SMBIOS_TABLE_TYPE1));
-
-  //
-  // Fill in Type 1 fields
-  //
-
-  SmbiosRecord->Hdr.Type = SMBIOS_TYPE_SYSTEM_INFORMATION;
-  SmbiosRecord->Hdr.Length = sizeof (SMBIOS_TABLE_TYPE1);
-  SmbiosRecord->Hdr.Handle = 0;
-
-  //
-  // Add strings to bottom of data block
-  //
-  StringOffset = SmbiosRecord->Hdr.Length;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, ManufacturerStr, ManufacturerStrLen);
-  StringOffset += ManufacturerStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, ProductNameStr, ProductNameStrLen);
-  StringOffset += ProductNameStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, VersionStr, VersionStrLen);
-  StringOffset += VersionStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, SerialNumberStr, SerialNumberStrLen);
-  StringOffset += SerialNumberStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, SKUNumberStr, SKUNumberStrLen);
-  StringOffset += SKUNumberStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, FamilyStr, FamilyStrLen);
-
   //
   // Now we have got the full smbios record, call smbios protocol to add this record.
   //
@@ -26,26 +26,20 @@ BootInfoStatusFunction(
 {
   EFI_STATUS                         Status;
   EFI_SMBIOS_HANDLE                  SmbiosHandle;
-  SMBIOS_TABLE_TYPE32                *PcdSmbiosRecord;
   SMBIOS_TABLE_TYPE32                *SmbiosRecord;
 
-  PcdSmbiosRecord = PcdGetPtr (PcdSmbiosType32SystemBootInformation);
-
-  //
-  // Two zeros following the last string.
-  //
-  SmbiosRecord = AllocateZeroPool(sizeof (SMBIOS_TABLE_TYPE32) + 1 + 1);
+  SmbiosRecord = (SMBIOS_TABLE_TYPE32 *) CreateSmbiosRecord (
+                                           PcdGetPtr (PcdSmbiosType32SystemBootInformation),
+                                           sizeof (SMBIOS_TABLE_TYPE32),
+                                           EFI_SMBIOS_TYPE_SYSTEM_BOOT_INFORMATION,
+                                           sizeof (SMBIOS_TABLE_TYPE32),
+                                           NULL,
+                                           0
+                                           );
   if (SmbiosRecord == NULL) {
-    ASSERT_EFI_ERROR (EFI_OUT_OF_RESOURCES);
     return EFI_OUT_OF_RESOURCES;
   }
 
-  CopyMem (SmbiosRecord, PcdSmbiosRecord, sizeof(SMBIOS_TABLE_TYPE32));
-
-  SmbiosRecord->Hdr.Type = EFI_SMBIOS_TYPE_SYSTEM_BOOT_INFORMATION;
-  SmbiosRecord->Hdr.Length = sizeof (SMBIOS_TABLE_TYPE32);
-  SmbiosRecord->Hdr.Handle = 0;
-
   //
   // Now we have got the full smbios record, call smbios protocol to add this record.
   //
@@ -23,97 +23,46 @@ ChassisManufacturerFunction(
   IN  EFI_SMBIOS_PROTOCOL   *Smbios
   )
 {
-  UINTN                           ManuStrLen;
-  UINTN                           VerStrLen;
-  UINTN                           AssertTagStrLen;
-  UINTN                           SerialNumStrLen;
-  UINTN                           SKUNumberStrLen;
   EFI_STATUS                      Status;
-  CHAR8                           *ManufacturerStr;
-  CHAR8                           *VersionStr;
-  CHAR8                           *SerialNumberStr;
-  CHAR8                           *AssertTagStr;
-  CHAR8                           *SKUNumberStr;
+  CHAR8                           *Strings[5];
   SMBIOS_TABLE_STRING             *SKUNumberPtr;
   EFI_SMBIOS_HANDLE               SmbiosHandle;
   SMBIOS_TABLE_TYPE3              *SmbiosRecord;
   SMBIOS_TABLE_TYPE3              *PcdSmbiosRecord;
   UINTN                           SourceSize;
-  UINTN                           TotalSize;
-  UINTN                           StringOffset;
+  UINT8                           Length;
 
   PcdSmbiosRecord = PcdGetPtr (PcdSmbiosType3SystemEnclosureChassis);
-
-  //
-  // Get ChassisManufacturer String.
-  //
-  ManufacturerStr = PcdGetPtr (PcdSmbiosType3StringManufacturer);
-  ManuStrLen = AsciiStrLen (ManufacturerStr);
-  ASSERT (ManuStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  //
-  // Get ChassisVersion String.
-  //
-  VersionStr = PcdGetPtr (PcdSmbiosType3StringVersion);
-  VerStrLen = AsciiStrLen (VersionStr);
-  ASSERT (VerStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  //
-  // Get ChassisSerialNumber String.
-  //
-  SerialNumberStr = PcdGetPtr (PcdSmbiosType3StringSerialNumber);
-  SerialNumStrLen = AsciiStrLen (SerialNumberStr);
-  ASSERT (SerialNumStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  //
-  // Get ChassisAssetTag String.
-  //
-  AssertTagStr = PcdGetPtr (PcdSmbiosType3StringAssetTag);
-  AssertTagStrLen = AsciiStrLen (AssertTagStr);
-  ASSERT (AssertTagStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  //
-  // Get ChassisSKUNumber String.
-  //
-  SKUNumberStr = PcdGetPtr (PcdSmbiosType3StringSKUNumber);
-  SKUNumberStrLen = AsciiStrLen (SKUNumberStr);
-  ASSERT (SKUNumberStrLen <= SMBIOS_STRING_MAX_LENGTH);
-
-  //
-  // Two zeros following the last string.
-  //
   SourceSize = PcdGetSize(PcdSmbiosType3SystemEnclosureChassis);
-  TotalSize = SourceSize + sizeof(SMBIOS_TABLE_STRING) + ManuStrLen + 1 + VerStrLen + 1 + SerialNumStrLen + 1 + AssertTagStrLen + 1 + SKUNumberStrLen + 1 + 1;
-  SmbiosRecord = AllocateZeroPool(TotalSize);
-  if (SmbiosRecord == NULL) {
-    ASSERT_EFI_ERROR (EFI_OUT_OF_RESOURCES);
-    return EFI_OUT_OF_RESOURCES;
-  }
 
-  CopyMem (SmbiosRecord, PcdSmbiosRecord, SourceSize);
+  Strings[0] = PcdGetPtr (PcdSmbiosType3StringManufacturer);
+  Strings[1] = PcdGetPtr (PcdSmbiosType3StringVersion);
+  Strings[2] = PcdGetPtr (PcdSmbiosType3StringSerialNumber);
+  Strings[3] = PcdGetPtr (PcdSmbiosType3StringAssetTag);
+  Strings[4] = PcdGetPtr (PcdSmbiosType3StringSKUNumber);
 
-  SmbiosRecord->Hdr.Type = EFI_SMBIOS_TYPE_SYSTEM_ENCLOSURE;
-  SmbiosRecord->Hdr.Length = OFFSET_OF (SMBIOS_TABLE_TYPE3, ContainedElements) + sizeof(SMBIOS_TABLE_STRING);
+  Length = OFFSET_OF (SMBIOS_TABLE_TYPE3, ContainedElements) + sizeof(SMBIOS_TABLE_STRING);
   if (PcdSmbiosRecord->ContainedElementCount >= 1) {
-    SmbiosRecord->Hdr.Length += PcdSmbiosRecord->ContainedElementCount * PcdSmbiosRecord->ContainedElementRecordLength;
+    Length += PcdSmbiosRecord->ContainedElementCount * PcdSmbiosRecord->ContainedElementRecordLength;
   }
-  SmbiosRecord->Hdr.Handle = 0;
 
-  if ((PcdSmbiosRecord->ContainedElementCount == 0) || (SourceSize < (UINTN)SmbiosRecord + SmbiosRecord->Hdr.Length)) {
-    SKUNumberPtr = (SMBIOS_TABLE_STRING *)((UINTN)SmbiosRecord + SmbiosRecord->Hdr.Length - sizeof(SMBIOS_TABLE_STRING));
-    *SKUNumberPtr = 5;
+  SmbiosRecord = (SMBIOS_TABLE_TYPE3 *) CreateSmbiosRecord (
+                                          PcdSmbiosRecord,
+                                          SourceSize,
+                                          EFI_SMBIOS_TYPE_SYSTEM_ENCLOSURE,
+                                          Length,
+                                          Strings,
+                                          ARRAY_SIZE (Strings)
+                                          );
+  if (SmbiosRecord == NULL) {
+    return EFI_OUT_OF_RESOURCES;
   }
 
-  StringOffset = SmbiosRecord->Hdr.Length;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, ManufacturerStr, ManuStrLen);
-  StringOffset += ManuStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, VersionStr, VerStrLen);
-  StringOffset += VerStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, SerialNumberStr, SerialNumStrLen);
-  StringOffset += SerialNumStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, AssertTagStr, AssertTagStrLen);
-  StringOffset += AssertTagStrLen + 1;
-  CopyMem ((UINT8 *)SmbiosRecord + StringOffset, SKUNumberStr, SKUNumberStrLen);
+  //
+  // The SKU number string follows the contained elements, so it is not part of the template.
+  //
+  SKUNumberPtr = (SMBIOS_TABLE_STRING *)((UINTN)SmbiosRecord + SmbiosRecord->Hdr.Length - sizeof(SMBIOS_TABLE_STRING));
+  *SKUNumberPtr = 5;
 
   //
   // Now we have got the full smbios record, call smbios protocol to add this record.
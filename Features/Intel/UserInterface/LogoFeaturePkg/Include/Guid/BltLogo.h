@@ -0,0 +1,55 @@
+/** @file
+  Layout of the pre-converted logo consumed by BltLogoDxe.
+
+  The logo is stored in the raw section of a FREEFORM file named by
+  gBltLogoFileGuid. It is produced at build time by Tools/LogoToBlt, already
+  scaled and in the EFI_GRAPHICS_OUTPUT_BLT_PIXEL format, so that it can be
+  drawn with a single Blt() without any decoding.
+
+Copyright (c) 2016 - 2020, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _BLT_LOGO_H_
+#define _BLT_LOGO_H_
+
+#define BLT_LOGO_FILE_GUID \
+  { \
+    0x3c4f3e1a, 0x5b0d, 0x4e8f, { 0x9a, 0x61, 0x2e, 0x7d, 0x4b, 0x90, 0xc1, 0x58 } \
+  }
+
+#define BLT_LOGO_SIGNATURE  SIGNATURE_32 ('B', 'L', 'T', 'L')
+
+///
+/// The pixels are run-length encoded.
+///
+#define BLT_LOGO_FLAG_RLE   BIT0
+
+///
+/// Each run-length encoded packet starts with a UINT32 holding the number of
+/// pixels. If BLT_LOGO_RLE_LITERAL is set, that many pixels follow, otherwise
+/// a single pixel follows that is repeated that many times.
+///
+#define BLT_LOGO_RLE_LITERAL     BIT31
+#define BLT_LOGO_RLE_COUNT_MASK  0x7FFFFFFF
+
+typedef struct {
+  UINT32    Signature;
+  UINT16    Width;
+  UINT16    Height;
+  UINT32    Flags;
+  ///
+  /// EDKII_PLATFORM_LOGO_DISPLAY_ATTRIBUTE and offsets the logo is shown with.
+  ///
+  UINT32    Attribute;
+  INT32     OffsetX;
+  INT32     OffsetY;
+  //
+  // EFI_GRAPHICS_OUTPUT_BLT_PIXEL pixels, or RLE packets, follow.
+  //
+} BLT_LOGO_HEADER;
+
+extern EFI_GUID  gBltLogoFileGuid;
+
+#endif
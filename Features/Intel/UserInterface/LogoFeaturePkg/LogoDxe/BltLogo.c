@@ -0,0 +1,211 @@
+/** @file
+  Logo DXE Driver, install Edkii Platform Logo protocol for a logo that was
+  converted to the BLT pixel format at build time.
+
+Copyright (c) 2016 - 2020, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include <Uefi.h>
+#include <Protocol/GraphicsOutput.h>
+#include <Protocol/PlatformLogo.h>
+#include <Guid/BltLogo.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/BaseLib.h>
+#include <Library/DxeServicesLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+
+BLT_LOGO_HEADER               mLogo;
+EFI_GRAPHICS_OUTPUT_BLT_PIXEL *mLogoBitmap;
+
+/**
+  Decode the logo found in the FV into mLogoBitmap.
+
+  @param Blob              The raw section holding the logo.
+  @param BlobSize          Size of the raw section in bytes.
+
+  @retval EFI_SUCCESS           The logo was decoded.
+  @retval EFI_VOLUME_CORRUPTED  The logo is malformed.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory to hold the logo.
+**/
+EFI_STATUS
+DecodeLogo (
+  IN UINT8                     *Blob,
+  IN UINTN                     BlobSize
+  )
+{
+  UINTN                         PixelCount;
+  UINTN                         Index;
+  UINTN                         Count;
+  UINT32                        Packet;
+  UINT8                         *Data;
+  UINT8                         *End;
+
+  if (BlobSize < sizeof (BLT_LOGO_HEADER)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+  CopyMem (&mLogo, Blob, sizeof (BLT_LOGO_HEADER));
+  if (mLogo.Signature != BLT_LOGO_SIGNATURE || mLogo.Width == 0 || mLogo.Height == 0) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  PixelCount = (UINTN) mLogo.Width * mLogo.Height;
+  Data       = Blob + sizeof (BLT_LOGO_HEADER);
+  End        = Blob + BlobSize;
+
+  if ((mLogo.Flags & BLT_LOGO_FLAG_RLE) == 0) {
+    if ((UINTN) (End - Data) < PixelCount * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+    mLogoBitmap = AllocateCopyPool (PixelCount * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL), Data);
+    return (mLogoBitmap == NULL) ? EFI_OUT_OF_RESOURCES : EFI_SUCCESS;
+  }
+
+  mLogoBitmap = AllocatePool (PixelCount * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  if (mLogoBitmap == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < PixelCount; Index += Count) {
+    if ((UINTN) (End - Data) < sizeof (Packet) + sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) {
+      break;
+    }
+    Packet = ReadUnaligned32 ((UINT32 *) Data);
+    Data  += sizeof (Packet);
+    Count  = Packet & BLT_LOGO_RLE_COUNT_MASK;
+    if (Count == 0 || Count > PixelCount - Index) {
+      break;
+    }
+
+    if ((Packet & BLT_LOGO_RLE_LITERAL) != 0) {
+      if ((UINTN) (End - Data) < Count * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) {
+        break;
+      }
+      CopyMem (&mLogoBitmap[Index], Data, Count * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      Data += Count * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+    } else {
+      SetMem32 (&mLogoBitmap[Index], Count * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL), ReadUnaligned32 ((UINT32 *) Data));
+      Data += sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+    }
+  }
+
+  if (Index != PixelCount) {
+    FreePool (mLogoBitmap);
+    mLogoBitmap = NULL;
+    return EFI_VOLUME_CORRUPTED;
+  }
+  return EFI_SUCCESS;
+}
+
+/**
+  Load a platform logo image and return its data and attributes.
+
+  @param This              The pointer to this protocol instance.
+  @param Instance          The visible image instance is found.
+  @param Image             Points to the image.
+  @param Attribute         The display attributes of the image returned.
+  @param OffsetX           The X offset of the image regarding the Attribute.
+  @param OffsetY           The Y offset of the image regarding the Attribute.
+
+  @retval EFI_SUCCESS          The image was fetched successfully.
+  @retval EFI_NOT_FOUND        The specified image could not be found.
+  @retval EFI_OUT_OF_RESOURCES There is not enough memory to return the image.
+**/
+EFI_STATUS
+EFIAPI
+GetImage (
+  IN     EDKII_PLATFORM_LOGO_PROTOCOL          *This,
+  IN OUT UINT32                                *Instance,
+     OUT EFI_IMAGE_INPUT                       *Image,
+     OUT EDKII_PLATFORM_LOGO_DISPLAY_ATTRIBUTE *Attribute,
+     OUT INTN                                  *OffsetX,
+     OUT INTN                                  *OffsetY
+  )
+{
+  if (Instance == NULL || Image == NULL ||
+      Attribute == NULL || OffsetX == NULL || OffsetY == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (*Instance >= 1) {
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // The caller owns and frees the bitmap, hand it a copy of the decoded logo.
+  //
+  Image->Bitmap = AllocateCopyPool (
+                    (UINTN) mLogo.Width * mLogo.Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL),
+                    mLogoBitmap
+                    );
+  if (Image->Bitmap == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  (*Instance)++;
+  Image->Flags  = 0;
+  Image->Width  = mLogo.Width;
+  Image->Height = mLogo.Height;
+  *Attribute    = (EDKII_PLATFORM_LOGO_DISPLAY_ATTRIBUTE) mLogo.Attribute;
+  *OffsetX      = mLogo.OffsetX;
+  *OffsetY      = mLogo.OffsetY;
+  return EFI_SUCCESS;
+}
+
+EDKII_PLATFORM_LOGO_PROTOCOL mPlatformLogo = {
+  GetImage
+};
+
+/**
+  Entrypoint of this module.
+
+  This function is the entrypoint of this module. It decodes the logo once and
+  installs the Edkii Platform Logo protocol.
+
+  @param  ImageHandle       The firmware allocated handle for the EFI image.
+  @param  SystemTable       A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+InitializeBltLogo (
+  IN EFI_HANDLE               ImageHandle,
+  IN EFI_SYSTEM_TABLE         *SystemTable
+  )
+{
+  EFI_STATUS                  Status;
+  VOID                        *Blob;
+  UINTN                       BlobSize;
+  EFI_HANDLE                  Handle;
+
+  Status = GetSectionFromAnyFv (
+             &gBltLogoFileGuid,
+             EFI_SECTION_RAW,
+             0,
+             &Blob,
+             &BlobSize
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "BLT logo file not found in any firmware volume\n"));
+    return Status;
+  }
+
+  Status = DecodeLogo (Blob, BlobSize);
+  FreePool (Blob);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "BLT logo could not be decoded - %r\n", Status));
+    return Status;
+  }
+
+  Handle = NULL;
+  Status = gBS->InstallMultipleProtocolInterfaces (
+                  &Handle,
+                  &gEdkiiPlatformLogoProtocolGuid, &mPlatformLogo,
+                  NULL
+                  );
+  return Status;
+}
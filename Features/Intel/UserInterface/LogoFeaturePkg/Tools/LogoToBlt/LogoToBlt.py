@@ -0,0 +1,191 @@
+## @file
+# Convert a logo picture to the pre-scaled BLT format consumed by BltLogoDxe.
+#
+# Uncompressed 8, 24 and 32 bits per pixel BMP files are read directly. Other
+# formats, such as JPEG or PNG, need the Python Imaging Library (Pillow).
+#
+# Copyright (c) 2020, Intel Corporation. All rights reserved.<BR>
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+'''
+LogoToBlt
+'''
+
+import sys
+import struct
+import argparse
+
+#
+# Globals for help information
+#
+__prog__      = 'LogoToBlt'
+__version__   = '%s Version %s' % (__prog__, '0.1 ')
+__copyright__ = 'Copyright (c) 2020, Intel Corporation. All rights reserved.'
+__usage__     = '%s [options] -o <output_file> <input_file>' % (__prog__)
+
+#
+# Must match LogoFeaturePkg/Include/Guid/BltLogo.h
+#
+BLT_LOGO_SIGNATURE      = b'BLTL'
+BLT_LOGO_FLAG_RLE       = 0x00000001
+BLT_LOGO_RLE_LITERAL    = 0x80000000
+BLT_LOGO_RLE_COUNT_MASK = 0x7FFFFFFF
+BLT_LOGO_HEADER_FORMAT  = '<4sHHIIii'
+
+#
+# EDKII_PLATFORM_LOGO_DISPLAY_ATTRIBUTE
+#
+Attributes = [
+  'LeftTop',
+  'CenterTop',
+  'RightTop',
+  'CenterRight',
+  'RightBottom',
+  'CenterBottom',
+  'LeftBottom',
+  'CenterLeft',
+  'Center'
+  ]
+
+def ReadBmp (Data):
+  '''Return (Width, Height, Pixels) with Pixels a top-down list of (B,G,R).'''
+  if Data[0:2] != b'BM':
+    return None
+  PixelOffset, = struct.unpack_from ('<I', Data, 10)
+  Width, Height, Planes, BitCount, Compression = struct.unpack_from ('<iiHHI', Data, 18)
+  if Compression != 0 or BitCount not in (8, 24, 32):
+    raise ValueError ('only uncompressed 8, 24 and 32 bpp BMP files are supported')
+
+  Palette = []
+  if BitCount == 8:
+    HeaderSize, = struct.unpack_from ('<I', Data, 14)
+    ColorsUsed, = struct.unpack_from ('<I', Data, 46)
+    if ColorsUsed == 0:
+      ColorsUsed = 256
+    for Index in range (ColorsUsed):
+      Palette.append (tuple (Data[14 + HeaderSize + Index * 4:14 + HeaderSize + Index * 4 + 3]))
+
+  TopDown = Height < 0
+  Height  = abs (Height)
+  Stride  = ((Width * BitCount + 31) // 32) * 4
+  Pixels  = []
+  for Y in range (Height):
+    Row = Data[PixelOffset + (Y if TopDown else Height - 1 - Y) * Stride:]
+    for X in range (Width):
+      if BitCount == 8:
+        Pixels.append (Palette[Row[X]])
+      else:
+        Pixel = X * (BitCount // 8)
+        Pixels.append (tuple (Row[Pixel:Pixel + 3]))
+  return Width, Height, Pixels
+
+def ReadImage (FileName):
+  with open (FileName, 'rb') as File:
+    Data = File.read ()
+  Image = ReadBmp (Data)
+  if Image is not None:
+    return Image
+
+  try:
+    from PIL import Image as PilImage
+  except ImportError:
+    raise ValueError ('%s is not a BMP file and Pillow is not installed' % FileName)
+  Picture = PilImage.open (FileName).convert ('RGB')
+  Pixels  = [(B, G, R) for (R, G, B) in Picture.getdata ()]
+  return Picture.size[0], Picture.size[1], Pixels
+
+def Scale (Width, Height, Pixels, NewWidth, NewHeight):
+  '''Nearest neighbour scaling, so that the logo colors are kept exactly.'''
+  Scaled = []
+  for Y in range (NewHeight):
+    Row = (Y * Height // NewHeight) * Width
+    for X in range (NewWidth):
+      Scaled.append (Pixels[Row + X * Width // NewWidth])
+  return Scaled
+
+def EncodeRle (Pixels):
+  Packets = bytearray ()
+  Literal = []
+
+  def FlushLiteral ():
+    if Literal:
+      Packets.extend (struct.pack ('<I', BLT_LOGO_RLE_LITERAL | len (Literal)))
+      for Pixel in Literal:
+        Packets.extend (bytes (Pixel) + b'\0')
+      del Literal[:]
+
+  Index = 0
+  while Index < len (Pixels):
+    Run = 1
+    while Index + Run < len (Pixels) and Pixels[Index + Run] == Pixels[Index] and Run < BLT_LOGO_RLE_COUNT_MASK:
+      Run += 1
+    #
+    # A repeat packet is no larger than two literal pixels.
+    #
+    if Run >= 2:
+      FlushLiteral ()
+      Packets.extend (struct.pack ('<I', Run))
+      Packets.extend (bytes (Pixels[Index]) + b'\0')
+    else:
+      Literal.append (Pixels[Index])
+    Index += Run
+  FlushLiteral ()
+  return bytes (Packets)
+
+if __name__ == '__main__':
+  #
+  # Create command line argument parser object
+  #
+  parser = argparse.ArgumentParser(prog=__prog__, usage=__usage__, description=__copyright__, conflict_handler='resolve')
+  parser.add_argument("-o", "--output", dest='OutputFileName', type=str, metavar='filename', help="specify the output filename", required=True)
+  parser.add_argument("-s", "--size", dest='Size', type=str, metavar='WIDTHxHEIGHT', help="scale the logo to this size")
+  parser.add_argument("-c", "--compress", dest='Compress', action="store_true", help="run-length encode the pixels")
+  parser.add_argument("-a", "--attribute", dest='Attribute', choices=Attributes, default='Center', help="where the logo is displayed, default Center")
+  parser.add_argument("-x", "--offset-x", dest='OffsetX', type=int, default=0, help="horizontal offset regarding the attribute")
+  parser.add_argument("-y", "--offset-y", dest='OffsetY', type=int, default=0, help="vertical offset regarding the attribute")
+  parser.add_argument("-v", "--verbose", dest='Verbose', action="store_true", help="increase output messages")
+  parser.add_argument(metavar="input_file", dest='InputFile', type=str, help="logo picture to convert")
+
+  #
+  # Parse command line arguments
+  #
+  args = parser.parse_args()
+
+  try:
+    Width, Height, Pixels = ReadImage (args.InputFile)
+    if args.Size:
+      NewWidth, NewHeight = [int (Value) for Value in args.Size.lower ().split ('x')]
+      Pixels = Scale (Width, Height, Pixels, NewWidth, NewHeight)
+      Width, Height = NewWidth, NewHeight
+  except (IOError, ValueError) as Error:
+    print ('%s: error: %s' % (__prog__, Error))
+    sys.exit (1)
+
+  if Width <= 0 or Width > 0xFFFF or Height <= 0 or Height > 0xFFFF:
+    print ('%s: error: unsupported logo size %dx%d' % (__prog__, Width, Height))
+    sys.exit (1)
+
+  Flags = 0
+  Body  = b''.join (bytes (Pixel) + b'\0' for Pixel in Pixels)
+  if args.Compress:
+    Packets = EncodeRle (Pixels)
+    if len (Packets) < len (Body):
+      Flags |= BLT_LOGO_FLAG_RLE
+      Body   = Packets
+
+  Header = struct.pack (
+             BLT_LOGO_HEADER_FORMAT,
+             BLT_LOGO_SIGNATURE,
+             Width,
+             Height,
+             Flags,
+             Attributes.index (args.Attribute),
+             args.OffsetX,
+             args.OffsetY
+             )
+  with open (args.OutputFileName, 'wb') as File:
+    File.write (Header + Body)
+
+  if args.Verbose:
+    print ('%s: %dx%d logo, %d bytes%s' % (__prog__, Width, Height, len (Header) + len (Body), ', RLE' if Flags & BLT_LOGO_FLAG_RLE else ''))
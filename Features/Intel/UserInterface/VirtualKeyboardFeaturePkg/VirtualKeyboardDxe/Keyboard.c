@@ -461,8 +461,7 @@ VkTimer (
   CheckScreenCleared (VkContext);
   CheckBackgroundChanged (VkContext);
   if (VkContext->IsRedrawUpdateUI) {
-    HideVkBody (VkContext);
-    DrawKeyboardLayout (VkContext);
+    RedrawVkBody (VkContext);
     VkContext->IsRedrawUpdateUI = FALSE;
   }
 
@@ -964,6 +963,7 @@ VkApiStop (
   EFI_STATUS Status;
   VK_NOTIFY  *NotifyNode;
   LIST_ENTRY *NotifyList;
+  UINTN      Index;
 
   DEBUG ((DEBUG_VK_ROUTINE_ENTRY_EXIT, "VkApiStop Start\n"));
 
@@ -1003,6 +1003,21 @@ VkApiStop (
     }
   }
 
+  for (Index = 0; Index < ARRAY_SIZE (VkContext->SimKeyBodyCache); Index++) {
+    if (VkContext->SimKeyBodyCache[Index] != NULL) {
+      FreePool (VkContext->SimKeyBodyCache[Index]);
+      VkContext->SimKeyBodyCache[Index] = NULL;
+    }
+    if (VkContext->DigKeyBodyCache[Index] != NULL) {
+      FreePool (VkContext->DigKeyBodyCache[Index]);
+      VkContext->DigKeyBodyCache[Index] = NULL;
+    }
+    if (VkContext->CapLeKeyBodyCache[Index] != NULL) {
+      FreePool (VkContext->CapLeKeyBodyCache[Index]);
+      VkContext->CapLeKeyBodyCache[Index] = NULL;
+    }
+  }
+
   DEBUG ((DEBUG_VK_ROUTINE_ENTRY_EXIT, "VkApiStop End\n"));
 }
 
@@ -1241,8 +1256,7 @@ VkKeyboardSetState (
     VkContext->PageNumber = VkContext->IsCapsLockFlag ? VkPage1 : VkPage0;
   }
 
-  HideVkBody (VkContext);
-  DrawKeyboardLayout (VkContext);
+  RedrawVkBody (VkContext);
 
   DEBUG ((DEBUG_VK_KEYS | DEBUG_INFO, "VkContext->KeyToggleState:      %02x\n", VkContext->KeyToggleState));
   DEBUG ((DEBUG_VK_KEYS | DEBUG_INFO, "VkContext->IsCapsLockFlag:      %02x\n", VkContext->IsCapsLockFlag));
@@ -223,6 +223,50 @@ ModifyShiftKeyColor (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the key body with the Shift/CapsLock key colored for the current state,
+  rendering it on first use. VkContext->VkBodyBltWidth and VkBodyBltHeight
+  must already be the size of VkImage.
+
+  @param[in] VkContext          Address of an VK_CONTEXT structure.
+  @param[in] VkImage            Image of the key body.
+
+  @return The cached blt buffer, or NULL if allocating memory failed.
+
+**/
+EFI_GRAPHICS_OUTPUT_BLT_PIXEL *
+GetKeyBodyBltBuffer (
+  IN VK_CONTEXT                    *VkContext,
+  IN EFI_IMAGE_INPUT               *VkImage
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL **Cache;
+  UINTN                         Index;
+
+  if (VkImage == VkContext->SimKeyBody) {
+    Cache = VkContext->SimKeyBodyCache;
+  } else if (VkImage == VkContext->DigKeyBody) {
+    Cache = VkContext->DigKeyBodyCache;
+  } else {
+    Cache = VkContext->CapLeKeyBodyCache;
+  }
+
+  Index = VkContext->PageNumber <= VkPage1 ?
+          VkContext->IsCapsLockFlag :
+          VkContext->IsShiftKeyFlag;
+  if (Cache[Index] == NULL) {
+    Cache[Index] = AllocateCopyPool (
+                     sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL) * VkImage->Width * VkImage->Height,
+                     VkImage->Bitmap
+                     );
+    if (Cache[Index] != NULL) {
+      ModifyShiftKeyColor (VkContext, &Cache[Index]);
+    }
+  }
+
+  return Cache[Index];
+}
+
 /**
   Make the keyboard transparent.
 
@@ -812,11 +856,6 @@ DrawVkBody (
   Height         = VkImage->Height;
   Width          = VkImage->Width;
   BltSize        = sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL) * (UINT32)(Width * Height);
-  BltIn          = AllocateCopyPool (BltSize, VkImage->Bitmap);
-
-  if (BltIn == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
 
   //
   // Calculate the display position according to Attribute.
@@ -865,6 +904,11 @@ DrawVkBody (
     VkContext->VkBodyBltStartY = DestY;
     VkContext->VkBodyBltHeight = Height;
     VkContext->VkBodyBltWidth  = Width;
+    BltIn = GetKeyBodyBltBuffer (VkContext, VkImage);
+    if (BltIn == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto DVKBODY_Exit;
+    }
     SaveVkBodyBackgroundBltBuffer (VkContext, BltSize);
 
     //
@@ -874,7 +918,6 @@ DrawVkBody (
       FreePool (VkContext->VkBodyCompoundBltBuffer);
     }
     VkContext->VkBodyCompoundBltBuffer = NULL;
-    ModifyShiftKeyColor (VkContext, &BltIn);
     MakeKeyboardTransparent (VkContext, TRUE, BltIn, &(VkContext->VkBodyCompoundBltBuffer));
 
     //
@@ -896,10 +939,152 @@ DrawVkBody (
 
 
 DVKBODY_Exit:
-  if (BltIn != NULL) {
-    FreePool (BltIn);
+  return Status;
+}
+
+/**
+  Redraw the keyboard body after the layout or the Shift/CapsLock state changed.
+
+  When the keyboard stays at the same place with the same size, the saved
+  background is reused and only the keys whose pixels changed are drawn again,
+  so toggling Shift or CapsLock redraws just those keys. Otherwise the keyboard
+  is hidden and drawn again from scratch.
+
+  @param[in] VkContext          Pointer to virtual keyboard's context
+
+  @retval EFI_SUCCESS           The keyboard has been redrawn.
+  @retval EFI_OUT_OF_RESOURCES  Allocate memory failed.
+  @retval Others                An unexpected error occurred.
+
+**/
+EFI_STATUS
+RedrawVkBody (
+  IN VK_CONTEXT *VkContext
+  )
+{
+  EFI_STATUS                    Status;
+  EFI_IMAGE_INPUT               *VkImage;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *BltIn;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Compound;
+  VK_STRUCT                     *Key;
+  UINTN                         Index;
+  UINTN                         StartX;
+  UINTN                         StartY;
+  UINTN                         EndX;
+  UINTN                         EndY;
+  UINTN                         Y;
+  UINTN                         Offset;
+
+  switch (VkContext->CurrentKeyboardDisplay) {
+  case VkDisplayAttributeSimpleTop:
+  case VkDisplayAttributeSimpleBottom:
+    VkImage = VkContext->SimKeyBody;
+    break;
+
+  case VkDisplayAttributeFullTop:
+  case VkDisplayAttributeFullBottom:
+    VkImage = VkContext->PageNumber <= VkPage1 ? VkContext->CapLeKeyBody : VkContext->DigKeyBody;
+    break;
+
+  default:
+    VkImage = NULL;
+    break;
+  }
+
+  if ((VkImage == NULL) ||
+      (VkContext->CurrentKeyboardDisplay != VkContext->TargetKeyboardDisplay) ||
+      (VkContext->VkBodyBackgroundBltBuffer == NULL) ||
+      (VkContext->VkBodyCompoundBltBuffer == NULL) ||
+      (VkImage->Width  != VkContext->VkBodyBltWidth) ||
+      (VkImage->Height != VkContext->VkBodyBltHeight)) {
+    HideVkBody (VkContext);
+    return DrawKeyboardLayout (VkContext);
+  }
+
+  BltIn = GetKeyBodyBltBuffer (VkContext, VkImage);
+  if (BltIn == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Compound = NULL;
+  Status   = MakeKeyboardTransparent (VkContext, TRUE, BltIn, &Compound);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Draw the keys that changed, the last 4 entries are the screen corners.
+  //
+  for (Index = 0; Index < (VkContext->NumOfKeysInfo - 4); Index++) {
+    Key = &VkContext->KeyboardBodyPtr[Index];
+    if ((Key->DisStartX < VkContext->VkBodyBltStartX) || (Key->DisStartY < VkContext->VkBodyBltStartY)) {
+      continue;
+    }
+    StartX = Key->DisStartX - VkContext->VkBodyBltStartX;
+    StartY = Key->DisStartY - VkContext->VkBodyBltStartY;
+    EndX   = MIN (Key->DisEndX - VkContext->VkBodyBltStartX, VkContext->VkBodyBltWidth);
+    EndY   = MIN (Key->DisEndY - VkContext->VkBodyBltStartY, VkContext->VkBodyBltHeight);
+    if ((StartX >= EndX) || (StartY >= EndY)) {
+      continue;
+    }
+
+    for (Y = StartY; Y < EndY; Y++) {
+      Offset = Y * VkContext->VkBodyBltWidth + StartX;
+      if (CompareMem (
+            &Compound[Offset],
+            &VkContext->VkBodyCompoundBltBuffer[Offset],
+            (EndX - StartX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+            ) != 0) {
+        break;
+      }
+    }
+    if (Y == EndY) {
+      continue;
+    }
+
+    VkContext->GraphicsOutput->Blt (
+                                 VkContext->GraphicsOutput,
+                                 Compound,
+                                 EfiBltBufferToVideo,
+                                 StartX,
+                                 StartY,
+                                 VkContext->VkBodyBltStartX + StartX,
+                                 VkContext->VkBodyBltStartY + StartY,
+                                 EndX - StartX,
+                                 EndY - StartY,
+                                 VkContext->VkBodyBltWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                                 );
+    for (Y = StartY; Y < EndY; Y++) {
+      Offset = Y * VkContext->VkBodyBltWidth + StartX;
+      CopyMem (
+        &VkContext->VkBodyCompoundBltBuffer[Offset],
+        &Compound[Offset],
+        (EndX - StartX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+        );
+    }
+  }
+
+  //
+  // Anything that changed outside of the keys needs the whole keyboard drawn.
+  //
+  Status = EFI_SUCCESS;
+  if (CompareMem (Compound, VkContext->VkBodyCompoundBltBuffer, VkContext->VkBodyBltSize) != 0) {
+    Status = VkContext->GraphicsOutput->Blt (
+                                          VkContext->GraphicsOutput,
+                                          Compound,
+                                          EfiBltBufferToVideo,
+                                          0,
+                                          0,
+                                          VkContext->VkBodyBltStartX,
+                                          VkContext->VkBodyBltStartY,
+                                          VkContext->VkBodyBltWidth,
+                                          VkContext->VkBodyBltHeight,
+                                          VkContext->VkBodyBltWidth * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                                          );
   }
 
+  FreePool (VkContext->VkBodyCompoundBltBuffer);
+  VkContext->VkBodyCompoundBltBuffer = Compound;
+
   return Status;
 }
 
@@ -327,6 +327,14 @@ struct _VK_CONTEXT {
   ///
   EFI_IMAGE_INPUT                   *CapLeKeyBody;
 
+  ///
+  /// Key bodies with the Shift/CapsLock key colored, indexed by whether
+  /// the key is pressed. They are rendered on first use.
+  ///
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     *SimKeyBodyCache[2];
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     *DigKeyBodyCache[2];
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     *CapLeKeyBodyCache[2];
+
   ///
   /// Screen check buffer.
   /// This is used to check if screen is kept scrolling up.
@@ -660,6 +668,21 @@ DrawVkBody (
   IN VK_DISPLAY_ATTRIBUTE          Attribute
   );
 
+/**
+  Redraw the keyboard body after the layout or the Shift/CapsLock state changed.
+
+  @param[in] VkContext          Pointer to virtual keyboard's context
+
+  @retval EFI_SUCCESS           The keyboard has been redrawn.
+  @retval EFI_OUT_OF_RESOURCES  Allocate memory failed.
+  @retval Others                An unexpected error occurred.
+
+**/
+EFI_STATUS
+RedrawVkBody (
+  IN VK_CONTEXT *VkContext
+  );
+
 /**
   Get unicode by VkContext->PageNumber and VkContext->KeyboardBodyPtr.
 
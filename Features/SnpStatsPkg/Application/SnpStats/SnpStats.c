@@ -0,0 +1,201 @@
+/** @file
+  SnpStats - dumps the statistics of Simple Network Protocol drivers
+
+  Prints, for each network interface whose driver uses SnpStatsLib, how many
+  Transmit(), Receive() and GetStatus() calls were made, what they returned,
+  how long they took on average and at most, and a histogram of their
+  durations.
+
+  Usage: SnpStats [-r]
+    -r resets the statistics after printing them.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Protocol/DevicePath.h>
+#include <Protocol/SnpStats.h>
+
+#include <Library/BaseLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/ShellCEntryLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+STATIC CONST CHAR16  *mCallNames[SnpStatsCallMax] = {
+  L"Transmit",
+  L"Receive",
+  L"GetStatus"
+};
+
+/**
+   Converts performance counter ticks to nanoseconds.
+
+   @param[in]      Ticks         Number of ticks.
+   @param[in]      Frequency     Frequency of the performance counter, in Hz.
+
+   @return Nanoseconds.
+**/
+STATIC
+UINT64
+TicksToNs (
+  IN UINT64  Ticks,
+  IN UINT64  Frequency
+  )
+{
+  UINT64  Seconds;
+  UINT64  Remainder;
+
+  if (Frequency == 0) {
+    return 0;
+  }
+
+  // Split the conversion so that it doesn't overflow for large tick counts
+  Seconds = DivU64x64Remainder (Ticks, Frequency, &Remainder);
+  return MultU64x32 (Seconds, 1000000000) +
+         DivU64x64Remainder (MultU64x32 (Remainder, 1000000000), Frequency, NULL);
+}
+
+/**
+   Prints the statistics of one kind of call.
+
+   @param[in]      Name          Name of the call.
+   @param[in]      Data          Pointer to the call's statistics.
+   @param[in]      Frequency     Frequency of the performance counter, in Hz.
+**/
+STATIC
+VOID
+PrintCall (
+  IN CONST CHAR16               *Name,
+  IN CONST SNP_STATS_CALL_DATA  *Data,
+  IN UINT64                     Frequency
+  )
+{
+  UINTN  Bucket;
+
+  Print (
+    L"  %-9s %10lu calls %10lu not ready %6lu errors %6lu drops %12lu bytes\n",
+    Name,
+    Data->Calls,
+    Data->NotReady,
+    Data->Errors,
+    Data->Drops,
+    Data->Bytes
+    );
+
+  if (Data->Calls == 0) {
+    return;
+  }
+
+  Print (
+    L"            %10lu ns avg %10lu ns max\n",
+    TicksToNs (DivU64x64Remainder (Data->TotalTicks, Data->Calls, NULL), Frequency),
+    TicksToNs (Data->MaxTicks, Frequency)
+    );
+
+  for (Bucket = 0; Bucket < SNP_STATS_HISTOGRAM_BUCKETS; Bucket++) {
+    if (Data->Histogram[Bucket] == 0) {
+      continue;
+    }
+
+    Print (
+      L"            < %10lu ns: %10lu\n",
+      TicksToNs (LShiftU64 (2, Bucket), Frequency),
+      Data->Histogram[Bucket]
+      );
+  }
+}
+
+/**
+   The main entry point of the application.
+
+   @param[in] Argc             The number of items in Argv.
+   @param[in] Argv             Array of pointers to the arguments.
+
+   @retval 0                   The statistics were printed.
+   @retval Other               An error occurred.
+**/
+INTN
+EFIAPI
+ShellAppMain (
+  IN UINTN   Argc,
+  IN CHAR16  **Argv
+  )
+{
+  EFI_STATUS                Status;
+  EFI_HANDLE                *Handles;
+  UINTN                     NumberHandles;
+  UINTN                     Index;
+  UINTN                     Call;
+  BOOLEAN                   Reset;
+  SNP_STATS_PROTOCOL        *Protocol;
+  SNP_STATS                 *Stats;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  CHAR16                    *DevicePathText;
+
+  Reset = FALSE;
+
+  if ((Argc == 2) && (StrCmp (Argv[1], L"-r") == 0)) {
+    Reset = TRUE;
+  } else if (Argc != 1) {
+    Print (L"Usage: %s [-r]\n", Argv[0]);
+    return 1;
+  }
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gSnpStatsProtocolGuid,
+                  NULL,
+                  &NumberHandles,
+                  &Handles
+                  );
+
+  if (EFI_ERROR (Status)) {
+    Print (L"No network interfaces with statistics found: %r\n", Status);
+    return 1;
+  }
+
+  // SNP_STATS is too large to comfortably live on the stack
+  Stats = AllocatePool (sizeof (*Stats));
+
+  if (Stats == NULL) {
+    FreePool (Handles);
+    return 1;
+  }
+
+  for (Index = 0; Index < NumberHandles; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gSnpStatsProtocolGuid, (VOID **)&Protocol);
+
+    if (!EFI_ERROR (Status)) {
+      Status = Protocol->GetStatistics (Protocol, Stats);
+    }
+
+    if (EFI_ERROR (Status)) {
+      Print (L"%u: failed to get statistics: %r\n", Index, Status);
+      continue;
+    }
+
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiDevicePathProtocolGuid, (VOID **)&DevicePath);
+
+    DevicePathText = EFI_ERROR (Status) ? NULL : ConvertDevicePathToText (DevicePath, TRUE, TRUE);
+    Print (L"%u: %s\n", Index, DevicePathText != NULL ? DevicePathText : L"(no device path)");
+
+    if (DevicePathText != NULL) {
+      FreePool (DevicePathText);
+    }
+
+    for (Call = 0; Call < SnpStatsCallMax; Call++) {
+      PrintCall (mCallNames[Call], &Stats->Call[Call], Stats->CounterFrequency);
+    }
+
+    if (Reset) {
+      Protocol->ResetStatistics (Protocol);
+    }
+  }
+
+  FreePool (Stats);
+  FreePool (Handles);
+  return 0;
+}
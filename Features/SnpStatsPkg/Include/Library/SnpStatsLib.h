@@ -0,0 +1,126 @@
+/** @file
+  SNP statistics library
+
+  Counts the Transmit(), Receive() and GetStatus() calls of a Simple Network
+  Protocol driver, the bytes they moved, the frames the driver dropped, and
+  how long each call took. Recording a call costs two reads of the
+  performance counter and a few additions, so it can stay enabled on the
+  hot paths.
+
+  The counters are published through the SNP statistics protocol, and can
+  also back the driver's EFI_SIMPLE_NETWORK_PROTOCOL.Statistics() function.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef SNP_STATS_LIB_H_
+#define SNP_STATS_LIB_H_
+
+#include <Protocol/SimpleNetwork.h>
+#include <Protocol/SnpStats.h>
+
+typedef struct _SNP_STATS_CONTEXT SNP_STATS_CONTEXT;
+
+/**
+   Creates the statistics of a Simple Network Protocol instance, and installs
+   the SNP statistics protocol on its handle.
+
+   @param[in]      Handle        Handle the Simple Network Protocol is installed on.
+   @param[out]     Context       Pointer to where the statistics context will be stored.
+
+   @retval EFI_SUCCESS           The statistics were created.
+   @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+   @return Status of installing the protocol.
+**/
+EFI_STATUS
+EFIAPI
+SnpStatsInstall (
+  IN  EFI_HANDLE         Handle,
+  OUT SNP_STATS_CONTEXT  **Context
+  );
+
+/**
+   Uninstalls the SNP statistics protocol, and frees the statistics.
+
+   @param[in]      Handle        Handle passed to SnpStatsInstall().
+   @param[in]      Context       Statistics context, may be NULL.
+**/
+VOID
+EFIAPI
+SnpStatsUninstall (
+  IN EFI_HANDLE         Handle,
+  IN SNP_STATS_CONTEXT  *Context OPTIONAL
+  );
+
+/**
+   Starts timing a call.
+
+   @return Performance counter value, to pass to SnpStatsRecord().
+**/
+UINT64
+EFIAPI
+SnpStatsStart (
+  VOID
+  );
+
+/**
+   Records a call.
+
+   @param[in]      Context       Statistics context, may be NULL.
+   @param[in]      Call          The function that was called.
+   @param[in]      StartTicks    Value returned by SnpStatsStart() when the call started.
+   @param[in]      Status        Status returned by the call.
+   @param[in]      Bytes         Bytes transmitted or received, if the call succeeded.
+**/
+VOID
+EFIAPI
+SnpStatsRecord (
+  IN SNP_STATS_CONTEXT  *Context OPTIONAL,
+  IN SNP_STATS_CALL     Call,
+  IN UINT64             StartTicks,
+  IN EFI_STATUS         Status,
+  IN UINTN              Bytes
+  );
+
+/**
+   Records a frame dropped by the driver.
+
+   @param[in]      Context       Statistics context, may be NULL.
+   @param[in]      Call          SnpStatsTransmit or SnpStatsReceive.
+**/
+VOID
+EFIAPI
+SnpStatsRecordDrop (
+  IN SNP_STATS_CONTEXT  *Context OPTIONAL,
+  IN SNP_STATS_CALL     Call
+  );
+
+/**
+   Implements EFI_SIMPLE_NETWORK_PROTOCOL.Statistics() from the recorded
+   calls, for drivers that don't get statistics from their hardware.
+   Only the total, good and dropped frame counters and the byte counters are
+   available; the others are reported as not supported (all bits set).
+
+   @param[in]      Context         Statistics context, may be NULL.
+   @param[in]      Reset           Set to TRUE to reset the statistics.
+   @param[in, out] StatisticsSize  On input the size, in bytes, of StatisticsTable.
+                                   On output the size, in bytes, of the resulting
+                                   table of statistics.
+   @param[out]     StatisticsTable Pointer to the statistics table.
+
+   @retval EFI_SUCCESS            The statistics were collected, or reset.
+   @retval EFI_BUFFER_TOO_SMALL   StatisticsSize had to be updated. As much of the
+                                  table as fits was returned.
+   @retval EFI_INVALID_PARAMETER  StatisticsTable is not NULL, but StatisticsSize is.
+   @retval EFI_UNSUPPORTED        Context is NULL.
+**/
+EFI_STATUS
+EFIAPI
+SnpStatsGetNetworkStatistics (
+  IN     SNP_STATS_CONTEXT       *Context OPTIONAL,
+  IN     BOOLEAN                 Reset,
+  IN OUT UINTN                   *StatisticsSize OPTIONAL,
+  OUT    EFI_NETWORK_STATISTICS  *StatisticsTable OPTIONAL
+  );
+
+#endif
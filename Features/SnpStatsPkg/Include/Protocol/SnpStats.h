@@ -0,0 +1,95 @@
+/** @file
+  SNP statistics protocol
+
+  Installed by Simple Network Protocol drivers that use SnpStatsLib, on the
+  handle that carries their Simple Network Protocol instance. Lets tools
+  (like SnpStats) see how often, and how fast, the driver's Transmit(),
+  Receive() and GetStatus() functions are called.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef SNP_STATS_PROTOCOL_H_
+#define SNP_STATS_PROTOCOL_H_
+
+#define SNP_STATS_PROTOCOL_GUID \
+  { 0x55e9a3c7, 0x7a14, 0x4625, { 0x9b, 0x21, 0x24, 0xc3, 0xdd, 0x58, 0xf5, 0x15 } }
+
+//
+// Number of buckets of each latency histogram. Bucket N counts the calls
+// that took [2^N, 2^(N+1)) performance counter ticks; bucket 0 also counts
+// the calls that took less than a tick.
+//
+#define SNP_STATS_HISTOGRAM_BUCKETS  64
+
+typedef struct _SNP_STATS_PROTOCOL SNP_STATS_PROTOCOL;
+
+typedef enum {
+  SnpStatsTransmit,
+  SnpStatsReceive,
+  SnpStatsGetStatus,
+  SnpStatsCallMax
+} SNP_STATS_CALL;
+
+typedef struct {
+  // Number of calls
+  UINT64    Calls;
+  // Calls that returned EFI_NOT_READY: nothing was received, or the
+  // transmit queue was full
+  UINT64    NotReady;
+  // Calls that failed with any other error
+  UINT64    Errors;
+  // Bytes transmitted or received by the successful calls
+  UINT64    Bytes;
+  // Frames the driver dropped, e.g. because they were received with errors
+  UINT64    Drops;
+  // Sum and maximum of the calls' durations, in performance counter ticks
+  UINT64    TotalTicks;
+  UINT64    MaxTicks;
+  UINT64    Histogram[SNP_STATS_HISTOGRAM_BUCKETS];
+} SNP_STATS_CALL_DATA;
+
+typedef struct {
+  // Frequency of the performance counter the durations are measured with,
+  // in Hz
+  UINT64                 CounterFrequency;
+  SNP_STATS_CALL_DATA    Call[SnpStatsCallMax];
+} SNP_STATS;
+
+/**
+   Retrieves the driver's statistics.
+
+   @param[in]      This          Pointer to the SNP_STATS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *SNP_STATS_GET)(
+  IN  SNP_STATS_PROTOCOL  *This,
+  OUT SNP_STATS           *Statistics
+  );
+
+/**
+   Resets the driver's statistics to zero.
+
+   @param[in]      This          Pointer to the SNP_STATS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *SNP_STATS_RESET)(
+  IN SNP_STATS_PROTOCOL  *This
+  );
+
+struct _SNP_STATS_PROTOCOL {
+  SNP_STATS_GET      GetStatistics;
+  SNP_STATS_RESET    ResetStatistics;
+};
+
+extern EFI_GUID  gSnpStatsProtocolGuid;
+
+#endif
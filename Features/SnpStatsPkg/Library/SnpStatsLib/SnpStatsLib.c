@@ -0,0 +1,348 @@
+/** @file
+  SNP statistics library
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/SnpStatsLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#define SNP_STATS_CONTEXT_SIGNATURE  SIGNATURE_32 ('S', 'N', 'P', 'S')
+
+struct _SNP_STATS_CONTEXT {
+  UINT32                Signature;
+  SNP_STATS_PROTOCOL    Protocol;
+  // TRUE if the performance counter counts down
+  BOOLEAN               CountsDown;
+  SNP_STATS             Stats;
+};
+
+#define SNP_STATS_CONTEXT_FROM_PROTOCOL(This) \
+  CR (This, SNP_STATS_CONTEXT, Protocol, SNP_STATS_CONTEXT_SIGNATURE)
+
+/**
+   Resets the statistics of a context to zero.
+
+   @param[in out]  Context       Statistics context.
+**/
+STATIC
+VOID
+SnpStatsReset (
+  IN OUT SNP_STATS_CONTEXT  *Context
+  )
+{
+  ZeroMem (Context->Stats.Call, sizeof (Context->Stats.Call));
+}
+
+/**
+   Retrieves the driver's statistics.
+
+   @param[in]      This          Pointer to the SNP_STATS_PROTOCOL instance.
+   @param[out]     Statistics    Pointer to where the statistics will be stored.
+
+   @retval EFI_SUCCESS            The statistics were retrieved.
+   @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+SnpStatsGetStatistics (
+  IN  SNP_STATS_PROTOCOL  *This,
+  OUT SNP_STATS           *Statistics
+  )
+{
+  SNP_STATS_CONTEXT  *Context;
+  EFI_TPL            OldTpl;
+
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Context = SNP_STATS_CONTEXT_FROM_PROTOCOL (This);
+
+  // The counters are updated at TPL_CALLBACK; don't copy them half-updated
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  CopyMem (Statistics, &Context->Stats, sizeof (*Statistics));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Resets the driver's statistics to zero.
+
+   @param[in]      This          Pointer to the SNP_STATS_PROTOCOL instance.
+
+   @retval EFI_SUCCESS            The statistics were reset.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+SnpStatsResetStatistics (
+  IN SNP_STATS_PROTOCOL  *This
+  )
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  SnpStatsReset (SNP_STATS_CONTEXT_FROM_PROTOCOL (This));
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+   Creates the statistics of a Simple Network Protocol instance, and installs
+   the SNP statistics protocol on its handle.
+
+   @param[in]      Handle        Handle the Simple Network Protocol is installed on.
+   @param[out]     Context       Pointer to where the statistics context will be stored.
+
+   @retval EFI_SUCCESS           The statistics were created.
+   @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+   @return Status of installing the protocol.
+**/
+EFI_STATUS
+EFIAPI
+SnpStatsInstall (
+  IN  EFI_HANDLE         Handle,
+  OUT SNP_STATS_CONTEXT  **Context
+  )
+{
+  SNP_STATS_CONTEXT  *NewContext;
+  EFI_STATUS         Status;
+  UINT64             CounterStart;
+  UINT64             CounterEnd;
+
+  NewContext = AllocateZeroPool (sizeof (*NewContext));
+
+  if (NewContext == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewContext->Signature                 = SNP_STATS_CONTEXT_SIGNATURE;
+  NewContext->Protocol.GetStatistics    = SnpStatsGetStatistics;
+  NewContext->Protocol.ResetStatistics  = SnpStatsResetStatistics;
+  NewContext->Stats.CounterFrequency    = GetPerformanceCounterProperties (&CounterStart, &CounterEnd);
+  NewContext->CountsDown                = CounterStart > CounterEnd;
+
+  Status = gBS->InstallMultipleProtocolInterfaces (
+                  &Handle,
+                  &gSnpStatsProtocolGuid,
+                  &NewContext->Protocol,
+                  NULL
+                  );
+
+  if (EFI_ERROR (Status)) {
+    FreePool (NewContext);
+    return Status;
+  }
+
+  *Context = NewContext;
+  return EFI_SUCCESS;
+}
+
+/**
+   Uninstalls the SNP statistics protocol, and frees the statistics.
+
+   @param[in]      Handle        Handle passed to SnpStatsInstall().
+   @param[in]      Context       Statistics context, may be NULL.
+**/
+VOID
+EFIAPI
+SnpStatsUninstall (
+  IN EFI_HANDLE         Handle,
+  IN SNP_STATS_CONTEXT  *Context OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+
+  if (Context == NULL) {
+    return;
+  }
+
+  Status = gBS->UninstallMultipleProtocolInterfaces (
+                  Handle,
+                  &gSnpStatsProtocolGuid,
+                  &Context->Protocol,
+                  NULL
+                  );
+
+  // Someone still uses the statistics; leak them, rather than pull them out
+  // from under their feet
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: failed to uninstall the protocol: %r\n", __func__, Status));
+    return;
+  }
+
+  FreePool (Context);
+}
+
+/**
+   Starts timing a call.
+
+   @return Performance counter value, to pass to SnpStatsRecord().
+**/
+UINT64
+EFIAPI
+SnpStatsStart (
+  VOID
+  )
+{
+  return GetPerformanceCounter ();
+}
+
+/**
+   Records a call.
+
+   @param[in]      Context       Statistics context, may be NULL.
+   @param[in]      Call          The function that was called.
+   @param[in]      StartTicks    Value returned by SnpStatsStart() when the call started.
+   @param[in]      Status        Status returned by the call.
+   @param[in]      Bytes         Bytes transmitted or received, if the call succeeded.
+**/
+VOID
+EFIAPI
+SnpStatsRecord (
+  IN SNP_STATS_CONTEXT  *Context OPTIONAL,
+  IN SNP_STATS_CALL     Call,
+  IN UINT64             StartTicks,
+  IN EFI_STATUS         Status,
+  IN UINTN              Bytes
+  )
+{
+  SNP_STATS_CALL_DATA  *Data;
+  UINT64               Now;
+  UINT64               Ticks;
+
+  if (Context == NULL) {
+    return;
+  }
+
+  ASSERT (Call < SnpStatsCallMax);
+
+  Now   = GetPerformanceCounter ();
+  Ticks = Context->CountsDown ? StartTicks - Now : Now - StartTicks;
+  Data  = &Context->Stats.Call[Call];
+
+  Data->Calls++;
+  Data->TotalTicks += Ticks;
+
+  if (Ticks > Data->MaxTicks) {
+    Data->MaxTicks = Ticks;
+  }
+
+  Data->Histogram[Ticks == 0 ? 0 : HighBitSet64 (Ticks)]++;
+
+  if (Status == EFI_NOT_READY) {
+    Data->NotReady++;
+  } else if (EFI_ERROR (Status)) {
+    Data->Errors++;
+  } else {
+    Data->Bytes += Bytes;
+  }
+}
+
+/**
+   Records a frame dropped by the driver.
+
+   @param[in]      Context       Statistics context, may be NULL.
+   @param[in]      Call          SnpStatsTransmit or SnpStatsReceive.
+**/
+VOID
+EFIAPI
+SnpStatsRecordDrop (
+  IN SNP_STATS_CONTEXT  *Context OPTIONAL,
+  IN SNP_STATS_CALL     Call
+  )
+{
+  if (Context == NULL) {
+    return;
+  }
+
+  ASSERT (Call < SnpStatsCallMax);
+
+  Context->Stats.Call[Call].Drops++;
+}
+
+/**
+   Implements EFI_SIMPLE_NETWORK_PROTOCOL.Statistics() from the recorded
+   calls, for drivers that don't get statistics from their hardware.
+   Only the total, good and dropped frame counters and the byte counters are
+   available; the others are reported as not supported (all bits set).
+
+   @param[in]      Context         Statistics context, may be NULL.
+   @param[in]      Reset           Set to TRUE to reset the statistics.
+   @param[in, out] StatisticsSize  On input the size, in bytes, of StatisticsTable.
+                                   On output the size, in bytes, of the resulting
+                                   table of statistics.
+   @param[out]     StatisticsTable Pointer to the statistics table.
+
+   @retval EFI_SUCCESS            The statistics were collected, or reset.
+   @retval EFI_BUFFER_TOO_SMALL   StatisticsSize had to be updated. As much of the
+                                  table as fits was returned.
+   @retval EFI_INVALID_PARAMETER  StatisticsTable is not NULL, but StatisticsSize is.
+   @retval EFI_UNSUPPORTED        Context is NULL.
+**/
+EFI_STATUS
+EFIAPI
+SnpStatsGetNetworkStatistics (
+  IN     SNP_STATS_CONTEXT       *Context OPTIONAL,
+  IN     BOOLEAN                 Reset,
+  IN OUT UINTN                   *StatisticsSize OPTIONAL,
+  OUT    EFI_NETWORK_STATISTICS  *StatisticsTable OPTIONAL
+  )
+{
+  EFI_NETWORK_STATISTICS  Table;
+  SNP_STATS_CALL_DATA     *Tx;
+  SNP_STATS_CALL_DATA     *Rx;
+  EFI_STATUS              Status;
+
+  if (Context == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if ((StatisticsSize == NULL) && (StatisticsTable != NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = EFI_SUCCESS;
+
+  if (StatisticsSize != NULL) {
+    Tx = &Context->Stats.Call[SnpStatsTransmit];
+    Rx = &Context->Stats.Call[SnpStatsReceive];
+
+    SetMem (&Table, sizeof (Table), 0xFF);
+    Table.RxGoodFrames    = Rx->Calls - Rx->NotReady - Rx->Errors;
+    Table.RxDroppedFrames = Rx->Drops;
+    Table.RxTotalFrames   = Table.RxGoodFrames + Table.RxDroppedFrames;
+    Table.RxTotalBytes    = Rx->Bytes;
+    Table.TxGoodFrames    = Tx->Calls - Tx->NotReady - Tx->Errors;
+    Table.TxDroppedFrames = Tx->Drops;
+    Table.TxTotalFrames   = Table.TxGoodFrames + Table.TxDroppedFrames;
+    Table.TxTotalBytes    = Tx->Bytes;
+
+    if ((*StatisticsSize < sizeof (Table)) || (StatisticsTable == NULL)) {
+      Status = EFI_BUFFER_TOO_SMALL;
+    }
+
+    if (StatisticsTable != NULL) {
+      CopyMem (StatisticsTable, &Table, MIN (*StatisticsSize, sizeof (Table)));
+    }
+
+    *StatisticsSize = sizeof (Table);
+  }
+
+  if (Reset) {
+    SnpStatsReset (Context);
+  }
+
+  return Status;
+}
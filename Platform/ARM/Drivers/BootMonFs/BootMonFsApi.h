@@ -372,6 +372,20 @@ BootMonGetFileFromAsciiFileName (
   OUT BOOTMON_FS_FILE       **File
   );
 
+/**
+  Invalidate the name index of a volume.
+
+  Must be called whenever a file is added to or removed from the volume, or
+  whenever the name a file is looked up by may have changed.
+
+  @param[in]  Instance  Pointer to the description of the volume.
+
+**/
+VOID
+BootMonFsInvalidateNameIndex (
+  IN  BOOTMON_FS_INSTANCE   *Instance
+  );
+
 EFI_STATUS
 BootMonGetFileFromPosition (
   IN  BOOTMON_FS_INSTANCE   *Instance,
@@ -48,6 +48,101 @@ EFI_FILE_PROTOCOL mBootMonFsFileTemplate = {
   BootMonFsFlushFile
 };
 
+/**
+  Return the name a file is looked up by.
+
+  @param[in]   FileEntry  Pointer to the description of the file.
+  @param[out]  Buffer     Buffer of MAX_NAME_LENGTH characters used to convert
+                          the name of an open file.
+
+  @return  Pointer to the Ascii name of the file.
+
+**/
+STATIC
+CHAR8 *
+BootMonFsGetAsciiFileName (
+  IN  BOOTMON_FS_FILE  *FileEntry,
+  OUT CHAR8            *Buffer
+  )
+{
+  if (FileEntry->Info != NULL) {
+    UnicodeStrToAsciiStrS (FileEntry->Info->FileName, Buffer, MAX_NAME_LENGTH);
+    return Buffer;
+  }
+  return FileEntry->HwDescription.Footer.Filename;
+}
+
+/**
+  Compute the hash of an Ascii file name (FNV-1a).
+
+  @param[in]  AsciiFileName  Name of the file.
+
+  @return  Hash of the name.
+
+**/
+STATIC
+UINT32
+BootMonFsHashName (
+  IN  CONST CHAR8  *AsciiFileName
+  )
+{
+  UINT32  Hash;
+
+  Hash = 2166136261U;
+  while (*AsciiFileName != '\0') {
+    Hash ^= (UINT8)*AsciiFileName++;
+    Hash *= 16777619U;
+  }
+  return Hash;
+}
+
+/**
+  Rebuild the name index of a volume from its list of files.
+
+  @param[in]  Instance  Pointer to the description of the volume.
+
+**/
+STATIC
+VOID
+BootMonFsBuildNameIndex (
+  IN  BOOTMON_FS_INSTANCE  *Instance
+  )
+{
+  LIST_ENTRY       *Entry;
+  BOOTMON_FS_FILE  *FileEntry;
+  CHAR8            OpenFileAsciiFileName[MAX_NAME_LENGTH];
+  UINTN            Index;
+
+  for (Index = 0; Index < BOOTMON_FS_NAME_INDEX_SIZE; Index++) {
+    InitializeListHead (&Instance->NameIndex[Index]);
+  }
+
+  for (Entry = GetFirstNode (&Instance->RootFile->Link);
+       !IsNull (&Instance->RootFile->Link, Entry);
+       Entry = GetNextNode (&Instance->RootFile->Link, Entry)
+       )
+  {
+    FileEntry = BOOTMON_FS_FILE_FROM_LINK_THIS (Entry);
+    FileEntry->NameHash = BootMonFsHashName (
+                            BootMonFsGetAsciiFileName (FileEntry, OpenFileAsciiFileName)
+                            );
+    InsertTailList (
+      &Instance->NameIndex[FileEntry->NameHash % BOOTMON_FS_NAME_INDEX_SIZE],
+      &FileEntry->NameIndexLink
+      );
+  }
+
+  Instance->NameIndexValid = TRUE;
+}
+
+VOID
+BootMonFsInvalidateNameIndex (
+  IN  BOOTMON_FS_INSTANCE   *Instance
+  )
+{
+  Instance->NameIndexValid = FALSE;
+}
+
 /**
   Search for a file given its name coded in Ascii.
 
@@ -61,6 +156,9 @@ EFI_FILE_PROTOCOL mBootMonFsFileTemplate = {
   the up to date name of the file is stored in the "Info" field of the file's
   description.
 
+  The files are looked up through the name index of the volume, which is
+  rebuilt from the list of files if it has been invalidated.
+
   @param[in]   Instance       Pointer to the description of the volume in which
                               the file has to be search for.
   @param[in]   AsciiFileName  Name of the file.
@@ -79,27 +177,34 @@ BootMonGetFileFromAsciiFileName (
   OUT BOOTMON_FS_FILE       **File
   )
 {
+  LIST_ENTRY       *Bucket;
   LIST_ENTRY       *Entry;
   BOOTMON_FS_FILE  *FileEntry;
   CHAR8            OpenFileAsciiFileName[MAX_NAME_LENGTH];
-  CHAR8            *AsciiFileNameToCompare;
+  UINT32           Hash;
 
-  // Go through all the files in the list and return the file handle
-  for (Entry = GetFirstNode (&Instance->RootFile->Link);
-       !IsNull (&Instance->RootFile->Link, Entry);
-       Entry = GetNextNode (&Instance->RootFile->Link, Entry)
+  if (!Instance->NameIndexValid) {
+    BootMonFsBuildNameIndex (Instance);
+  }
+
+  Hash   = BootMonFsHashName (AsciiFileName);
+  Bucket = &Instance->NameIndex[Hash % BOOTMON_FS_NAME_INDEX_SIZE];
+
+  // Go through the files with the same hash and return the file handle
+  for (Entry = GetFirstNode (Bucket);
+       !IsNull (Bucket, Entry);
+       Entry = GetNextNode (Bucket, Entry)
        )
   {
-    FileEntry = BOOTMON_FS_FILE_FROM_LINK_THIS (Entry);
-    if (FileEntry->Info != NULL) {
-      UnicodeStrToAsciiStrS (FileEntry->Info->FileName, OpenFileAsciiFileName,
-        MAX_NAME_LENGTH);
-      AsciiFileNameToCompare = OpenFileAsciiFileName;
-    } else {
-      AsciiFileNameToCompare = FileEntry->HwDescription.Footer.Filename;
+    FileEntry = BOOTMON_FS_FILE_FROM_NAME_INDEX_LINK (Entry);
+    if (FileEntry->NameHash != Hash) {
+      continue;
     }
 
-    if (AsciiStrCmp (AsciiFileNameToCompare, AsciiFileName) == 0) {
+    if (AsciiStrCmp (
+          BootMonFsGetAsciiFileName (FileEntry, OpenFileAsciiFileName),
+          AsciiFileName
+          ) == 0) {
       *File = FileEntry;
       return EFI_SUCCESS;
     }
@@ -211,6 +211,7 @@ BootMonFsInitialize (
     ImageCount++;
   }
 
+  BootMonFsInvalidateNameIndex (Instance);
   Instance->Initialized = TRUE;
   return EFI_SUCCESS;
 }
@@ -29,6 +29,9 @@
 
 #define BOOTMON_FS_VOLUME_LABEL   L"NOR Flash"
 
+// Number of hash buckets used to look up the files of a volume by name
+#define BOOTMON_FS_NAME_INDEX_SIZE  32
+
 typedef struct _BOOTMON_FS_INSTANCE BOOTMON_FS_INSTANCE;
 
 typedef struct {
@@ -43,6 +46,11 @@ typedef struct {
   LIST_ENTRY            Link;
   BOOTMON_FS_INSTANCE   *Instance;
 
+  // Link in the name index bucket of the volume, valid only while the
+  // index of the volume is valid
+  LIST_ENTRY            NameIndexLink;
+  UINT32                NameHash;
+
   UINTN                 HwDescAddress;
   HW_IMAGE_DESCRIPTION  HwDescription;
 
@@ -63,6 +71,7 @@ typedef struct {
 #define BOOTMON_FS_FILE_SIGNATURE              SIGNATURE_32('b', 'o', 't', 'f')
 #define BOOTMON_FS_FILE_FROM_FILE_THIS(a)      CR (a, BOOTMON_FS_FILE, File, BOOTMON_FS_FILE_SIGNATURE)
 #define BOOTMON_FS_FILE_FROM_LINK_THIS(a)      CR (a, BOOTMON_FS_FILE, Link, BOOTMON_FS_FILE_SIGNATURE)
+#define BOOTMON_FS_FILE_FROM_NAME_INDEX_LINK(a) CR (a, BOOTMON_FS_FILE, NameIndexLink, BOOTMON_FS_FILE_SIGNATURE)
 
 struct _BOOTMON_FS_INSTANCE {
   UINT32                               Signature;
@@ -83,6 +92,11 @@ struct _BOOTMON_FS_INSTANCE {
 
   BOOTMON_FS_FILE                     *RootFile; // All the other files are linked to this root
   BOOLEAN                              Initialized;
+
+  // Files of the volume hashed by name. The index is rebuilt from the file
+  // list on the next lookup once it has been invalidated.
+  LIST_ENTRY                           NameIndex[BOOTMON_FS_NAME_INDEX_SIZE];
+  BOOLEAN                              NameIndexValid;
 };
 
 #define BOOTMON_FS_SIGNATURE            SIGNATURE_32('b', 'o', 't', 'm')
@@ -457,6 +457,8 @@ BootMonFsCloseFile (
     This->Flush (This);
     FreePool (File->Info);
     File->Info = NULL;
+    // The file is now looked up by the name written in its footer
+    BootMonFsInvalidateNameIndex (File->Instance);
   }
 
   return EFI_SUCCESS;
@@ -672,6 +674,7 @@ BootMonFsOpenFile (
         goto Error;
       }
       InsertHeadList (&Instance->RootFile->Link, &File->Link);
+      BootMonFsInvalidateNameIndex (Instance);
       Info->Attribute = Attributes;
     } else {
       //
@@ -782,6 +785,7 @@ BootMonFsDelete (
 
   // Remove the entry from the list
   RemoveEntryList (&File->Link);
+  BootMonFsInvalidateNameIndex (File->Instance);
   FreePool (File->Info);
   FreePool (File);
 
@@ -60,7 +60,11 @@ BootMonFsReadFile (
 
   // Ensure the file has been written in Flash before reading it.
   // This keeps the code simple and avoids having to manage a non-flushed file.
-  BootMonFsFlushFile (This);
+  // A file already in Flash without pending regions has nothing to flush.
+  if ((File->HwDescription.RegionCount == 0) ||
+      !IsListEmpty (&File->RegionToFlushLink)) {
+    BootMonFsFlushFile (This);
+  }
 
   Instance  = File->Instance;
   DiskIo    = Instance->DiskIo;
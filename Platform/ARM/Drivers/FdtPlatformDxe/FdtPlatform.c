@@ -57,8 +57,11 @@ InstallFdt (
   EFI_STATUS                          Status;
   EFI_DEVICE_PATH_FROM_TEXT_PROTOCOL  *EfiDevicePathFromTextProtocol;
   EFI_DEVICE_PATH                     *DevicePath;
+  MEMMAP_DEVICE_PATH                  *MemMapDevicePath;
   EFI_PHYSICAL_ADDRESS                FdtBlobBase;
   UINTN                               FdtBlobSize;
+  VOID                                *FdtBlob;
+  UINTN                               FdtSize;
   UINTN                               NumPages;
   EFI_PHYSICAL_ADDRESS                FdtConfigurationTableBase;
 
@@ -77,23 +80,42 @@ InstallFdt (
     return EFI_INVALID_PARAMETER;
   }
 
-  //
-  // Load the FDT given its device path.
-  // This operation may fail if the device path is not supported.
-  //
   FdtBlobBase = 0;
-  NumPages    = 0;
-  Status = BdsLoadImage (DevicePath, AllocateAnyPages, &FdtBlobBase, &FdtBlobSize);
-  if (EFI_ERROR (Status)) {
-    goto Error;
+  FdtBlobSize = 0;
+  if ((DevicePathType (DevicePath) == HARDWARE_DEVICE_PATH) &&
+      (DevicePathSubType (DevicePath) == HW_MEMMAP_DP)) {
+    //
+    // The FDT is memory mapped, e.g. in NOR flash. Read it in place instead
+    // of loading an intermediate copy of it first.
+    //
+    MemMapDevicePath = (MEMMAP_DEVICE_PATH*)DevicePath;
+    if (MemMapDevicePath->EndingAddress < MemMapDevicePath->StartingAddress) {
+      Status = EFI_INVALID_PARAMETER;
+      goto Error;
+    }
+    FdtBlob     = (VOID*)(UINTN)MemMapDevicePath->StartingAddress;
+    FdtBlobSize = (UINTN)(MemMapDevicePath->EndingAddress -
+                          MemMapDevicePath->StartingAddress + 1);
+  } else {
+    //
+    // Load the FDT given its device path.
+    // This operation may fail if the device path is not supported.
+    //
+    Status = BdsLoadImage (DevicePath, AllocateAnyPages, &FdtBlobBase, &FdtBlobSize);
+    if (EFI_ERROR (Status)) {
+      FdtBlobBase = 0;
+      goto Error;
+    }
+    FdtBlob = (VOID*)(UINTN)FdtBlobBase;
   }
 
   //
   // Ensure that the FDT header is valid and that the Size of the Device Tree
   // is smaller than the size of the read file
   //
-  if (fdt_check_header ((VOID*)(UINTN)FdtBlobBase) != 0 ||
-      (UINTN)fdt_totalsize ((VOID*)(UINTN)FdtBlobBase) > FdtBlobSize) {
+  if (FdtBlobSize < sizeof (struct fdt_header) ||
+      fdt_check_header (FdtBlob) != 0 ||
+      (UINTN)fdt_totalsize (FdtBlob) > FdtBlobSize) {
     DEBUG ((EFI_D_ERROR, "InstallFdt() - loaded FDT binary image seems corrupt\n"));
     Status = EFI_LOAD_ERROR;
     goto Error;
@@ -101,9 +123,11 @@ InstallFdt (
 
   //
   // Store the FDT as Runtime Service Data to prevent the Kernel from
-  // overwritting its data.
+  // overwritting its data. Only the Device Tree itself is kept, not
+  // the padding that may follow it in the file.
   //
-  NumPages = EFI_SIZE_TO_PAGES (FdtBlobSize);
+  FdtSize  = fdt_totalsize (FdtBlob);
+  NumPages = EFI_SIZE_TO_PAGES (FdtSize);
   Status = gBS->AllocatePages (
                   AllocateAnyPages, EfiRuntimeServicesData,
                   NumPages, &FdtConfigurationTableBase
@@ -113,8 +137,8 @@ InstallFdt (
   }
   CopyMem (
     (VOID*)(UINTN)FdtConfigurationTableBase,
-    (VOID*)(UINTN)FdtBlobBase,
-    FdtBlobSize
+    FdtBlob,
+    FdtSize
     );
 
   //
@@ -130,7 +154,7 @@ InstallFdt (
 
 Error:
   if (FdtBlobBase != 0) {
-    gBS->FreePages (FdtBlobBase, NumPages);
+    gBS->FreePages (FdtBlobBase, EFI_SIZE_TO_PAGES (FdtBlobSize));
   }
   FreePool (DevicePath);
 
@@ -167,7 +167,8 @@ SataSiI3132PortInitialization (
   EFI_STATUS              Status;
   EFI_PCI_IO_PROTOCOL*    PciIo;
 
-  Status = SiI3132HwResetPort (Port);
+  // The port has been taken out of reset by SataSiI3132Initialization ()
+  Status = SiI3132WaitPortReady (Port);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -235,6 +236,12 @@ SataSiI3132Initialization (
   // Clear Global Control Register
   SATA_GLOBAL_WRITE32 (SII3132_GLOBAL_CONTROL_REG, 0x0);
 
+  // Release all the ports from reset before waiting on any of them, so that
+  // their links come up in parallel rather than one after the other
+  for (Index = 0; Index < SATA_SII3132_MAXPORT; Index++) {
+    SiI3132StartPortReset (&(SataSiI3132Instance->Ports[Index]));
+  }
+
   for (Index = 0; Index < SATA_SII3132_MAXPORT; Index++) {
     SataSiI3132PortInitialization (&(SataSiI3132Instance->Ports[Index]));
   }
@@ -183,6 +183,8 @@ SataSiI3132ComponentNameGetControllerName (
   );
 
 EFI_STATUS SiI3132HwResetPort (SATA_SI3132_PORT *Port);
+VOID SiI3132StartPortReset (SATA_SI3132_PORT *Port);
+EFI_STATUS SiI3132WaitPortReady (SATA_SI3132_PORT *Port);
 
 /*
  * Driver Binding Protocol Functions
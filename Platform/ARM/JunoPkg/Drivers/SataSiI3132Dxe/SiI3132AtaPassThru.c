@@ -654,16 +654,15 @@ SiI3132GetDevice (
   }
 }
 
-EFI_STATUS
-SiI3132HwResetPort (
+VOID
+SiI3132StartPortReset (
   IN SATA_SI3132_PORT *SataPort
   )
 {
   EFI_PCI_IO_PROTOCOL *PciIo;
   UINT32              Value32;
-  UINTN               Timeout;
 
-  SATA_TRACE ("SiI3132HwResetPort()");
+  SATA_TRACE ("SiI3132StartPortReset()");
 
   PciIo = SataPort->Instance->PciIo;
 
@@ -683,6 +682,18 @@ SiI3132HwResetPort (
 
   // Clear IRQ
   SATA_PORT_WRITE32 (SataPort->RegBase + SII3132_PORT_ENABLEINT_REG, SII3132_PORT_INT_CMDCOMPL | SII3132_PORT_INT_CMDERR | SII3132_PORT_INT_PORTRDY | (1 << 3));
+}
+
+EFI_STATUS
+SiI3132WaitPortReady (
+  IN SATA_SI3132_PORT *SataPort
+  )
+{
+  EFI_PCI_IO_PROTOCOL *PciIo;
+  UINT32              Value32;
+  UINTN               Timeout;
+
+  PciIo = SataPort->Instance->PciIo;
 
   // Wait until Port Ready
   SATA_PORT_READ32 (SataPort->RegBase + SII3132_PORT_INTSTATUS_REG, &Value32);
@@ -696,16 +707,27 @@ SiI3132HwResetPort (
   SATA_PORT_WRITE32 (SataPort->RegBase + SII3132_PORT_INTSTATUS_REG, SII3132_PORT_INT_PORTRDY);
 
   if (Timeout == 0) {
-    SATA_TRACE ("SiI3132HwResetPort(): Timeout");
+    SATA_TRACE ("SiI3132WaitPortReady(): Timeout");
     return EFI_TIMEOUT;
   } else if ((Value32 & SII3132_PORT_INT_PORTRDY) == 0) {
-    SATA_TRACE ("SiI3132HwResetPort(): Port Not Ready");
+    SATA_TRACE ("SiI3132WaitPortReady(): Port Not Ready");
     return EFI_DEVICE_ERROR;
   } else {
     return EFI_SUCCESS;
   }
 }
 
+EFI_STATUS
+SiI3132HwResetPort (
+  IN SATA_SI3132_PORT *SataPort
+  )
+{
+  SATA_TRACE ("SiI3132HwResetPort()");
+
+  SiI3132StartPortReset (SataPort);
+  return SiI3132WaitPortReady (SataPort);
+}
+
 /**
   Resets a specific port on the ATA controller. This operation also resets all the ATA devices
   connected to the port.
@@ -131,6 +131,50 @@ ElfCheckHeader (
 }
 
 
+/**
+ Add a copy or zero-fill operation to the load list.
+
+ If the operation directly follows the last one in the list, in memory and
+ for a copy also in the file, the last node is extended instead. This way,
+ adjacent segments are processed with a single CopyMem or ZeroMem once boot
+ services have been exited.
+**/
+STATIC
+EFI_STATUS
+ElfAddLoadNode (
+  IN  LIST_ENTRY  *LoadList,
+  IN  UINTN        MemOffset,
+  IN  UINTN        FileOffset,
+  IN  BOOLEAN      Zeroes,
+  IN  UINTN        Length
+  )
+{
+  RUNAXF_LOAD_LIST *LoadNode;
+
+  if (!IsListEmpty (LoadList)) {
+    LoadNode = (RUNAXF_LOAD_LIST *)GetPreviousNode (LoadList, LoadList);
+    if ((LoadNode->Zeroes == Zeroes) &&
+        (LoadNode->MemOffset + LoadNode->Length == MemOffset) &&
+        (Zeroes || (LoadNode->FileOffset + LoadNode->Length == FileOffset))) {
+      LoadNode->Length += Length;
+      return EFI_SUCCESS;
+    }
+  }
+
+  LoadNode = AllocateRuntimeZeroPool (sizeof (RUNAXF_LOAD_LIST));
+  if (LoadNode == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  LoadNode->MemOffset  = MemOffset;
+  LoadNode->FileOffset = FileOffset;
+  LoadNode->Zeroes     = Zeroes;
+  LoadNode->Length     = Length;
+  InsertTailList (LoadList, &LoadNode->Link);
+
+  return EFI_SUCCESS;
+}
+
+
 /**
  Load an ELF segment into memory.
 
@@ -149,7 +193,7 @@ ElfLoadSegment (
   VOID             *MemSegment;
   UINTN             ExtraZeroes;
   UINTN             ExtraZeroesCount;
-  RUNAXF_LOAD_LIST *LoadNode;
+  EFI_STATUS        Status;
 
 #ifdef MDE_CPU_ARM
   Elf32_Phdr  *ProgramHdr;
@@ -180,14 +224,11 @@ ElfLoadSegment (
     DEBUG ((EFI_D_INFO, "Loading segment from 0x%lx to 0x%lx (size = %ld)\n",
                  FileSegment, MemSegment, ProgramHdr->p_filesz));
 
-    LoadNode = AllocateRuntimeZeroPool (sizeof (RUNAXF_LOAD_LIST));
-    if (LoadNode == NULL) {
-      return EFI_OUT_OF_RESOURCES;
+    Status = ElfAddLoadNode (LoadList, (UINTN)MemSegment, (UINTN)FileSegment,
+               FALSE, (UINTN)ProgramHdr->p_filesz);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
-    LoadNode->MemOffset  = (UINTN)MemSegment;
-    LoadNode->FileOffset = (UINTN)FileSegment;
-    LoadNode->Length     = (UINTN)ProgramHdr->p_filesz;
-    InsertTailList (LoadList, &LoadNode->Link);
   }
 
   ExtraZeroes = ((UINTN)MemSegment + ProgramHdr->p_filesz);
@@ -195,14 +236,10 @@ ElfLoadSegment (
   DEBUG ((EFI_D_INFO, "Completing segment with %d zero bytes.\n", ExtraZeroesCount));
   if (ExtraZeroesCount > 0) {
     // Extra Node to add the Zeroes.
-    LoadNode = AllocateRuntimeZeroPool (sizeof (RUNAXF_LOAD_LIST));
-    if (LoadNode == NULL) {
-      return EFI_OUT_OF_RESOURCES;
+    Status = ElfAddLoadNode (LoadList, ExtraZeroes, 0, TRUE, ExtraZeroesCount);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
-    LoadNode->MemOffset  = (UINTN)ExtraZeroes;
-    LoadNode->Zeroes     = TRUE;
-    LoadNode->Length     = ExtraZeroesCount;
-    InsertTailList (LoadList, &LoadNode->Link);
   }
 
   return EFI_SUCCESS;
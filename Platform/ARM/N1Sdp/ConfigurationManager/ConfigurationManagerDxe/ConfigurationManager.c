@@ -1281,6 +1281,47 @@ InitializePlatformRepository (
   return EFI_SUCCESS;
 }
 
+/** Get the index of the array element referenced by a token.
+
+  The tokens of array elements in the platform repository are the addresses
+  of the elements, so the index is computed from the token rather than by
+  comparing the token against every element.
+
+  @param [in]  Token          A token identifying the object.
+  @param [in]  Array          Pointer to the first element of the array.
+  @param [in]  ElementSize    Size of an array element.
+  @param [in]  ElementCount   Number of elements in the array.
+  @param [out] Index          Index of the element referenced by the token.
+
+  @retval TRUE                The token references an element of the array.
+  @retval FALSE               The token does not reference an element of the array.
+**/
+STATIC
+BOOLEAN
+GetTokenArrayIndex (
+  IN  CONST CM_OBJECT_TOKEN          Token,
+  IN  CONST VOID             * CONST Array,
+  IN  CONST UINTN                    ElementSize,
+  IN  CONST UINTN                    ElementCount,
+  OUT       UINTN            * CONST Index
+  )
+{
+  UINTN  Offset;
+
+  if (Token < (CM_OBJECT_TOKEN)Array) {
+    return FALSE;
+  }
+
+  Offset = (UINTN)(Token - (CM_OBJECT_TOKEN)Array);
+  if (((Offset % ElementSize) != 0) ||
+      ((Offset / ElementSize) >= ElementCount)) {
+    return FALSE;
+  }
+
+  *Index = Offset / ElementSize;
+  return TRUE;
+}
+
 /** Return a GT Block timer frame info list.
 
   @param [in]        This        Pointer to the Configuration Manager Protocol.
@@ -1358,17 +1399,21 @@ GetItsIdentifierArray (
 
   Count = ARRAY_SIZE (PlatformRepo->ItsIdentifierArray);
 
-  for (Index = 0; Index < Count; Index++) {
-    if (Token == (CM_OBJECT_TOKEN)&PlatformRepo->ItsIdentifierArray[Index]) {
-      CmObject->ObjectId = CmObjectId;
-      CmObject->Size = sizeof (PlatformRepo->ItsIdentifierArray[0]);
-      CmObject->Data = (VOID*)&PlatformRepo->ItsIdentifierArray[Index];
-      CmObject->Count = 1;
-      return EFI_SUCCESS;
-    }
+  if (!GetTokenArrayIndex (
+         Token,
+         PlatformRepo->ItsIdentifierArray,
+         sizeof (PlatformRepo->ItsIdentifierArray[0]),
+         Count,
+         &Index
+         )) {
+    return EFI_NOT_FOUND;
   }
 
-  return EFI_NOT_FOUND;
+  CmObject->ObjectId = CmObjectId;
+  CmObject->Size = sizeof (PlatformRepo->ItsIdentifierArray[0]);
+  CmObject->Data = (VOID*)&PlatformRepo->ItsIdentifierArray[Index];
+  CmObject->Count = 1;
+  return EFI_SUCCESS;
 }
 
 /** Return an ITS group info.
@@ -1406,17 +1451,21 @@ GetItsGroupInfo (
 
   Count = ARRAY_SIZE (PlatformRepo->ItsGroupInfo);
 
-  for (Index = 0; Index < Count; Index++) {
-    if (Token == (CM_OBJECT_TOKEN)&PlatformRepo->ItsGroupInfo[Index]) {
-      CmObject->ObjectId = CmObjectId;
-      CmObject->Size = sizeof (PlatformRepo->ItsGroupInfo[0]);
-      CmObject->Data = (VOID*)&PlatformRepo->ItsGroupInfo[Index];
-      CmObject->Count = 1;
-      return EFI_SUCCESS;
-    }
+  if (!GetTokenArrayIndex (
+         Token,
+         PlatformRepo->ItsGroupInfo,
+         sizeof (PlatformRepo->ItsGroupInfo[0]),
+         Count,
+         &Index
+         )) {
+    return EFI_NOT_FOUND;
   }
 
-  return EFI_NOT_FOUND;
+  CmObject->ObjectId = CmObjectId;
+  CmObject->Size = sizeof (PlatformRepo->ItsGroupInfo[0]);
+  CmObject->Data = (VOID*)&PlatformRepo->ItsGroupInfo[Index];
+  CmObject->Count = 1;
+  return EFI_SUCCESS;
 }
 
 /** Return a device Id mapping array.
@@ -1514,7 +1563,7 @@ GetGicCInfo (
   EDKII_PLATFORM_REPOSITORY_INFO  * PlatformRepo;
   NEOVERSEN1SOC_PLAT_INFO           *PlatInfo;
   UINT32                            TotalObjCount;
-  UINT32                            ObjIndex;
+  UINTN                             ObjIndex;
 
   if ((This == NULL) || (CmObject == NULL)) {
     ASSERT (This != NULL);
@@ -1531,17 +1580,21 @@ GetGicCInfo (
     TotalObjCount = PLAT_CPU_COUNT;
   }
 
-  for (ObjIndex = 0; ObjIndex < TotalObjCount; ObjIndex++) {
-    if (SearchToken == (CM_OBJECT_TOKEN)&PlatformRepo->GicCInfo[ObjIndex]) {
-      CmObject->ObjectId = CmObjectId;
-      CmObject->Size = sizeof (PlatformRepo->GicCInfo[ObjIndex]);
-      CmObject->Data = (VOID*)&PlatformRepo->GicCInfo[ObjIndex];
-      CmObject->Count = 1;
-      return EFI_SUCCESS;
-    }
+  if (!GetTokenArrayIndex (
+         SearchToken,
+         PlatformRepo->GicCInfo,
+         sizeof (PlatformRepo->GicCInfo[0]),
+         TotalObjCount,
+         &ObjIndex
+         )) {
+    return EFI_NOT_FOUND;
   }
 
-  return EFI_NOT_FOUND;
+  CmObject->ObjectId = CmObjectId;
+  CmObject->Size = sizeof (PlatformRepo->GicCInfo[ObjIndex]);
+  CmObject->Data = (VOID*)&PlatformRepo->GicCInfo[ObjIndex];
+  CmObject->Count = 1;
+  return EFI_SUCCESS;
 }
 
 /** Return a list of Configuration Manager object references pointed to by the
@@ -39,6 +39,42 @@ typedef struct _FASTBOOT_PARTITION_LIST {
 
 STATIC LIST_ENTRY mPartitionListHead;
 
+//
+// Android sparse image format, as produced by img2simg and sent by the
+// fastboot host tool for large partitions.
+//
+#define SPARSE_HEADER_MAGIC       0xED26FF3A
+#define SPARSE_MAJOR_VERSION      1
+
+#define CHUNK_TYPE_RAW            0xCAC1
+#define CHUNK_TYPE_FILL           0xCAC2
+#define CHUNK_TYPE_DONT_CARE      0xCAC3
+#define CHUNK_TYPE_CRC32          0xCAC4
+
+// Size of the pattern buffer used to write FILL chunks
+#define SPARSE_FILL_BUFFER_SIZE   SIZE_1MB
+
+#pragma pack(1)
+typedef struct {
+  UINT32  Magic;
+  UINT16  MajorVersion;
+  UINT16  MinorVersion;
+  UINT16  FileHeaderSize;
+  UINT16  ChunkHeaderSize;
+  UINT32  BlockSize;
+  UINT32  TotalBlocks;
+  UINT32  TotalChunks;
+  UINT32  ImageChecksum;
+} SPARSE_HEADER;
+
+typedef struct {
+  UINT16  ChunkType;
+  UINT16  Reserved;
+  UINT32  ChunkSize;  // in blocks of SPARSE_HEADER.BlockSize
+  UINT32  TotalSize;  // in bytes, including this header
+} CHUNK_HEADER;
+#pragma pack()
+
 /*
   Helper to free the partition list
 */
@@ -307,6 +343,146 @@ ArmFastbootPlatformUnInit (
   FreePartitionList ();
 }
 
+/*
+  Write an Android sparse image to a partition.
+
+  RAW chunks are written straight from the download buffer, FILL chunks are
+  written from a pattern buffer of bounded size, and DONT_CARE chunks are
+  skipped, so that the expanded image never needs to exist in memory and
+  the unused parts of the partition are not written at all.
+
+  @param[in] DiskIo         Disk IO protocol of the partition.
+  @param[in] MediaId        Media ID of the partition.
+  @param[in] PartitionSize  Size of the partition in bytes.
+  @param[in] Size           Size of Image in bytes.
+  @param[in] Image          Sparse image, starting with a SPARSE_HEADER.
+
+  @retval EFI_SUCCESS       The image was written.
+  @retval EFI_UNSUPPORTED   The sparse image is malformed or of an unknown
+                            version.
+  @retval EFI_VOLUME_FULL   The expanded image doesn't fit the partition.
+*/
+STATIC
+EFI_STATUS
+FlashSparseImage (
+  IN EFI_DISK_IO_PROTOCOL *DiskIo,
+  IN UINT32                MediaId,
+  IN UINT64                PartitionSize,
+  IN UINTN                 Size,
+  IN VOID                 *Image
+  )
+{
+  SPARSE_HEADER *SparseHeader;
+  CHUNK_HEADER  *ChunkHeader;
+  UINT8         *Data;
+  UINT8         *End;
+  UINT32        *FillBuffer;
+  UINT64         Offset;
+  UINT64         ChunkBytes;
+  UINTN          WriteSize;
+  UINT32         Chunk;
+  EFI_STATUS     Status;
+
+  SparseHeader = (SPARSE_HEADER *) Image;
+  End = (UINT8 *) Image + Size;
+
+  if (SparseHeader->MajorVersion != SPARSE_MAJOR_VERSION ||
+      SparseHeader->FileHeaderSize < sizeof (SPARSE_HEADER) ||
+      SparseHeader->ChunkHeaderSize < sizeof (CHUNK_HEADER) ||
+      SparseHeader->BlockSize == 0 ||
+      (SparseHeader->BlockSize % sizeof (UINT32)) != 0 ||
+      SparseHeader->FileHeaderSize > Size) {
+    DEBUG ((EFI_D_ERROR, "Fastboot platform: unsupported sparse image\n"));
+    return EFI_UNSUPPORTED;
+  }
+
+  if (MultU64x32 (SparseHeader->TotalBlocks, SparseHeader->BlockSize) >
+      PartitionSize) {
+    DEBUG ((EFI_D_ERROR, "Partition not big enough.\n"));
+    return EFI_VOLUME_FULL;
+  }
+
+  FillBuffer = NULL;
+  Offset = 0;
+  Status = EFI_SUCCESS;
+  Data = (UINT8 *) Image + SparseHeader->FileHeaderSize;
+
+  for (Chunk = 0; Chunk < SparseHeader->TotalChunks; Chunk++) {
+    ChunkHeader = (CHUNK_HEADER *) Data;
+    if ((UINTN) (End - Data) < SparseHeader->ChunkHeaderSize ||
+        ChunkHeader->TotalSize < SparseHeader->ChunkHeaderSize ||
+        ChunkHeader->TotalSize > (UINTN) (End - Data)) {
+      Status = EFI_UNSUPPORTED;
+      break;
+    }
+
+    ChunkBytes = MultU64x32 (ChunkHeader->ChunkSize, SparseHeader->BlockSize);
+    if (ChunkHeader->ChunkType != CHUNK_TYPE_CRC32 &&
+        Offset + ChunkBytes > PartitionSize) {
+      Status = EFI_VOLUME_FULL;
+      break;
+    }
+
+    Data += SparseHeader->ChunkHeaderSize;
+
+    switch (ChunkHeader->ChunkType) {
+    case CHUNK_TYPE_RAW:
+      if (ChunkHeader->TotalSize - SparseHeader->ChunkHeaderSize != ChunkBytes) {
+        Status = EFI_UNSUPPORTED;
+        break;
+      }
+      Status = DiskIo->WriteDisk (DiskIo, MediaId, Offset, (UINTN) ChunkBytes, Data);
+      break;
+
+    case CHUNK_TYPE_FILL:
+      if (ChunkHeader->TotalSize - SparseHeader->ChunkHeaderSize != sizeof (UINT32)) {
+        Status = EFI_UNSUPPORTED;
+        break;
+      }
+      if (FillBuffer == NULL) {
+        FillBuffer = AllocatePool (SPARSE_FILL_BUFFER_SIZE);
+        if (FillBuffer == NULL) {
+          Status = EFI_OUT_OF_RESOURCES;
+          break;
+        }
+      }
+      SetMem32 (FillBuffer, SPARSE_FILL_BUFFER_SIZE, *(UINT32 *) Data);
+      while (ChunkBytes > 0 && !EFI_ERROR (Status)) {
+        WriteSize = (UINTN) MIN (ChunkBytes, SPARSE_FILL_BUFFER_SIZE);
+        Status = DiskIo->WriteDisk (DiskIo, MediaId, Offset, WriteSize, FillBuffer);
+        Offset += WriteSize;
+        ChunkBytes -= WriteSize;
+      }
+      break;
+
+    case CHUNK_TYPE_DONT_CARE:
+    case CHUNK_TYPE_CRC32:
+      break;
+
+    default:
+      Status = EFI_UNSUPPORTED;
+      break;
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Offset += ChunkBytes;
+    Data += ChunkHeader->TotalSize - SparseHeader->ChunkHeaderSize;
+  }
+
+  if (Status == EFI_UNSUPPORTED) {
+    DEBUG ((EFI_D_ERROR, "Fastboot platform: malformed sparse image chunk %d\n", Chunk));
+  }
+
+  if (FillBuffer != NULL) {
+    FreePool (FillBuffer);
+  }
+
+  return Status;
+}
+
 /*
   Flash the partition named (according to a platform-specific scheme)
   PartitionName, with the image pointed to by Buffer, whose size is BufferSize.
@@ -331,6 +507,7 @@ ArmFastbootPlatformFlashPartition (
   EFI_DISK_IO_PROTOCOL    *DiskIo;
   UINT32                   MediaId;
   UINTN                    PartitionSize;
+  BOOLEAN                  IsSparse;
   FASTBOOT_PARTITION_LIST *Entry;
   CHAR16                   PartitionNameUnicode[60];
   BOOLEAN                  PartitionFound;
@@ -366,9 +543,13 @@ ArmFastbootPlatformFlashPartition (
     return EFI_NOT_FOUND;
   }
 
-  // Check image will fit on device
+  IsSparse = (Size >= sizeof (SPARSE_HEADER) &&
+              ((SPARSE_HEADER *) Image)->Magic == SPARSE_HEADER_MAGIC);
+
+  // Check image will fit on device. Sparse images are checked against their
+  // expanded size when they are written.
   PartitionSize = (BlockIo->Media->LastBlock + 1) * BlockIo->Media->BlockSize;
-  if (PartitionSize < Size) {
+  if (!IsSparse && PartitionSize < Size) {
     DEBUG ((EFI_D_ERROR, "Partition not big enough.\n"));
     DEBUG ((EFI_D_ERROR, "Partition Size:\t%d\nImage Size:\t%d\n", PartitionSize, Size));
 
@@ -387,7 +568,11 @@ ArmFastbootPlatformFlashPartition (
                   );
   ASSERT_EFI_ERROR (Status);
 
-  Status = DiskIo->WriteDisk (DiskIo, MediaId, 0, Size, Image);
+  if (IsSparse) {
+    Status = FlashSparseImage (DiskIo, MediaId, PartitionSize, Size, Image);
+  } else {
+    Status = DiskIo->WriteDisk (DiskIo, MediaId, 0, Size, Image);
+  }
   if (EFI_ERROR (Status)) {
     return Status;
   }
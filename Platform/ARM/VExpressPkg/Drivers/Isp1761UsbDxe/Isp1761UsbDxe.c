@@ -313,6 +313,7 @@ HandleSetConfiguration (
   USB_ENDPOINT_DESCRIPTOR  *EPDesc;
   UINTN                     Index;
   UINT8                     EndpointIndex;
+  UINT32                    EndpointType;
 
   ASSERT (Request->RequestType == USB_DEV_SET_CONFIGURATION_REQ_TYPE);
   DEBUG ((EFI_D_INFO, "USB: Setting configuration.\n"));
@@ -339,8 +340,15 @@ HandleSetConfiguration (
     // register sounds like it might fix this problem, but it doesn't
     // (it's "applicable only in the DMA mode").
     WRITE_REG32 (ISP1761_BUFFER_LENGTH, EPDesc->MaxPacketSize);
-    WRITE_REG32 (ISP1761_ENDPOINT_TYPE, (EPDesc->Attributes & 0x3) |
-                                        ISP1761_ENDPOINT_TYPE_ENABLE);
+    EndpointType = (EPDesc->Attributes & 0x3) | ISP1761_ENDPOINT_TYPE_ENABLE;
+    // Double-buffer bulk OUT endpoints, so that the controller can ACK the
+    // next packet from the host while we are still draining the previous one
+    // out of the FIFO. This is what bounds the throughput of large downloads.
+    if ((EPDesc->Attributes & 0x3) == USB_ENDPOINT_BULK &&
+        (EPDesc->EndpointAddress & BIT7) == 0) {
+      EndpointType |= ISP1761_ENDPOINT_TYPE_DBLBUF;
+    }
+    WRITE_REG32 (ISP1761_ENDPOINT_TYPE, EndpointType);
   }
 
   StatusAcknowledge (ISP1761_EP0TX);
@@ -394,6 +402,7 @@ CheckInterrupts (
   VOID       *DataPacket;
   UINT32      HandledInterrupts;
   UINT32      UnhandledInterrupts;
+  UINTN       Index;
   EFI_STATUS  Status;
 
   // Set bits in HandledInterrupts to mark the interrupt source handled.
@@ -432,15 +441,22 @@ CheckInterrupts (
     HandledInterrupts |= ISP1761_DC_INTERRUPT_EP0TX;
   }
   if (DcInterrupts & ISP1761_DC_INTERRUPT_EP1RX) {
-    NumBytes = 512;
-    DataPacket = AllocatePool (NumBytes);
-    Status = ReadEndpointBuffer (ISP1761_EP1RX, &NumBytes, DataPacket);
-    if (EFI_ERROR (Status) || NumBytes == 0) {
-      if (EFI_ERROR (Status)) {
-        DEBUG ((EFI_D_ERROR, "Couldn't read EP1RX data: %r\n", Status));
+    // The endpoint is double-buffered, so drain every packet that has been
+    // received rather than waiting for the next poll to pick up the second.
+    for (Index = 0; Index < ISP1761_DBLBUF_COUNT; Index++) {
+      NumBytes = 512;
+      DataPacket = AllocatePool (NumBytes);
+      if (DataPacket == NULL) {
+        break;
+      }
+      Status = ReadEndpointBuffer (ISP1761_EP1RX, &NumBytes, DataPacket);
+      if (EFI_ERROR (Status) || NumBytes == 0) {
+        if (EFI_ERROR (Status)) {
+          DEBUG ((EFI_D_ERROR, "Couldn't read EP1RX data: %r\n", Status));
+        }
+        FreePool (DataPacket);
+        break;
       }
-      FreePool (DataPacket);
-    } else {
       // Signal this event again so we poll again ASAP
       gBS->SignalEvent (Event);
       mDataReceivedCallback (NumBytes, DataPacket);
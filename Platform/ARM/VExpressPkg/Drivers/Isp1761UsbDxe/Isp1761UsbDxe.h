@@ -70,6 +70,10 @@
 #define ISP1761_ENDPOINT_TYPE               0x208
 #define ISP1761_ENDPOINT_TYPE_NOEMPKT       BIT4
 #define ISP1761_ENDPOINT_TYPE_ENABLE        BIT3
+#define ISP1761_ENDPOINT_TYPE_DBLBUF        BIT2
+
+// Number of packet buffers of a double-buffered endpoint
+#define ISP1761_DBLBUF_COUNT                2
 
 #define ISP1761_INTERRUPT_CONFIG            0x210
 // Interrupt config value to only interrupt on ACK of IN and OUT tokens
@@ -1121,7 +1121,7 @@ SnpTransmit (
   LAN9118_DRIVER *LanDriver;
   UINT32 TxFreeSpace;
   UINT32 TxStatusSpace;
-  INT32 Count;
+  UINT32 TxFifoInf;
   UINT32 CommandA;
   UINT32 CommandB;
   UINT16 LocalProtocol;
@@ -1176,14 +1176,16 @@ SnpTransmit (
     return EFI_NOT_READY;
   }*/
 
-  // Get DATA FIFO free space in bytes
-  TxFreeSpace = TxDataFreeSpace (0, Snp);
+  // Get DATA FIFO free space and STATUS FIFO used space in bytes, from a
+  // single read of the TX FIFO information register
+  TxFifoInf = Lan9118MmioRead32 (LAN9118_TX_FIFO_INF);
+
+  TxFreeSpace = TxFifoInf & TXFIFOINF_TDFREE_MASK;
   if (TxFreeSpace < BuffSize) {
     return EFI_NOT_READY;
   }
 
-  // Get STATUS FIFO used space in bytes
-  TxStatusSpace = TxStatusUsedSpace (0, Snp);
+  TxStatusSpace = ((TxFifoInf & TXFIFOINF_TXSUSED_MASK) >> 16) << 2;
   if (TxStatusSpace > 500) {
     return EFI_NOT_READY;
   }
@@ -1256,9 +1258,7 @@ SnpTransmit (
     Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandB);
 
     // Write the payload
-    for (Count = 0; Count < ((BuffSize + 3) >> 2) - 3; Count++) {
-      Lan9118MmioWrite32 (LAN9118_TX_DATA, LocalData[Count + 3]);
-    }
+    Lan9118WriteTxFifo (&LocalData[3], ((BuffSize + 3) >> 2) - 3);
   } else {
     // Format pointer
     LocalData = (UINT32*) Data;
@@ -1272,9 +1272,7 @@ SnpTransmit (
     Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandB);
 
     // Write all the data
-    for (Count = 0; Count < ((BuffSize + 3) >> 2); Count++) {
-      Lan9118MmioWrite32 (LAN9118_TX_DATA, LocalData[Count]);
-    }
+    Lan9118WriteTxFifo (LocalData, (BuffSize + 3) >> 2);
   }
 
   // Save the address of the submitted packet so we can notify the consumer that
@@ -1316,7 +1314,6 @@ SnpReceive (
   UINT32          RxCfgValue;
   UINT32          PLength; // Packet length
   UINT32          ReadLimit;
-  UINT32          Count;
   UINT32          Padding;
   UINT32          *RawData;
   EFI_MAC_ADDRESS Dst;
@@ -1469,9 +1466,7 @@ SnpReceive (
   RawData = (UINT32*)Data;
 
   // Read Rx Packet
-  for (Count = 0; Count < ReadLimit; Count++) {
-    RawData[Count] = Lan9118MmioRead32 (LAN9118_RX_DATA);
-  }
+  Lan9118ReadRxFifo (RawData, ReadLimit);
 
   // Get the destination address
   if (DstAddr != NULL) {
@@ -164,6 +164,39 @@ Lan9118RawMmioWrite32(
   return Value;
 }
 
+/*
+ * The data FIFO ports only need the read/write delays of Tables 6.1 and 6.2
+ * before a *different* register is accessed, so consecutive FIFO accesses can
+ * be issued back to back, with a single delay after the last one.
+ */
+VOID
+Lan9118ReadRxFifo (
+  OUT UINT32 *Buffer,
+  IN  UINTN  Count
+  )
+{
+  UINTN Index;
+
+  for (Index = 0; Index < Count; Index++) {
+    Buffer[Index] = MmioRead32 (LAN9118_RX_DATA);
+  }
+  WaitDummyReads (LAN9118_RX_DATA_RD_DELAY);
+}
+
+VOID
+Lan9118WriteTxFifo (
+  IN CONST UINT32 *Buffer,
+  IN       UINTN  Count
+  )
+{
+  UINTN Index;
+
+  for (Index = 0; Index < Count; Index++) {
+    MmioWrite32 (LAN9118_TX_DATA, Buffer[Index]);
+  }
+  WaitDummyReads (LAN9118_TX_DATA_WR_DELAY);
+}
+
 // Function to write to MAC indirect registers
 UINT32
 IndirectMACWrite32 (
@@ -56,6 +56,20 @@ Lan9118RawMmioWrite32(
 #define Lan9118MmioWrite32(a, v) \
   Lan9118RawMmioWrite32(a, v, a ## _WR_DELAY)
 
+// Read Count DWORDs from the RX data FIFO
+VOID
+Lan9118ReadRxFifo (
+  OUT UINT32 *Buffer,
+  IN  UINTN  Count
+  );
+
+// Write Count DWORDs to the TX data FIFO
+VOID
+Lan9118WriteTxFifo (
+  IN CONST UINT32 *Buffer,
+  IN       UINTN  Count
+  );
+
 /* ------------------ MAC CSR Access ------------------- */
 
 // Read from MAC indirect registers
@@ -28,9 +28,18 @@ EFI_MMC_HOST_PROTOCOL     *gpMmcHost;
 #define MMCI0_POW2_BLOCKLEN     9
 #define MMCI0_TIMEOUT           1000
 
+// MCIDataLength is 16-bit: multi-block transfers are split into data path
+// transfers of at most this many bytes
+#define MMCI0_MAX_DATA_LENGTH   (0xFFFF & ~(MMCI0_BLOCKLEN - 1))
+
+// Burst size of the FIFO half-full/half-empty accesses, in words
+#define MMCI0_FIFO_BURST        8
+
 #define SYS_MCI_CARDIN          BIT0
 #define SYS_MCI_WPROT           BIT1
 
+STATIC BOOLEAN mDataPathArmed;
+
 BOOLEAN
 MciIsPowerOn (
   VOID
@@ -86,12 +95,15 @@ GetPow2BlockLen (
 
 VOID
 MciPrepareDataPath (
-  IN UINTN TransferDirection
+  IN UINTN TransferDirection,
+  IN UINTN Length
   )
 {
+  ASSERT ((Length <= MMCI0_MAX_DATA_LENGTH) && ((Length % MMCI0_BLOCKLEN) == 0));
+
   // Set Data Length & Data Timer
   MmioWrite32 (MCI_DATA_TIMER_REG, 0xFFFFFFF);
-  MmioWrite32 (MCI_DATA_LENGTH_REG, MMCI0_BLOCKLEN);
+  MmioWrite32 (MCI_DATA_LENGTH_REG, Length);
 
 #ifndef USE_STREAM
   //Note: we are using a hardcoded BlockLen (==512). If we decide to use a variable size, we could
@@ -100,6 +112,47 @@ MciPrepareDataPath (
 #else
   MmioWrite32 (MCI_DATA_CTL_REG, MCI_DATACTL_ENABLE | MCI_DATACTL_DMA_ENABLE | TransferDirection | MCI_DATACTL_STREAM_TRANS);
 #endif
+
+  mDataPathArmed = TRUE;
+}
+
+VOID
+MciDisableDataPath (
+  VOID
+  )
+{
+  UINTN  DataCtrlReg;
+
+  DataCtrlReg = MmioRead32 (MCI_DATA_CTL_REG);
+  MmioWrite32 (MCI_DATA_CTL_REG, (DataCtrlReg & MCI_DATACTL_DISABLE_MASK));
+
+  mDataPathArmed = FALSE;
+}
+
+// Wait for the data path to complete the transfer it was armed for
+STATIC
+EFI_STATUS
+MciWaitDataEnd (
+  VOID
+  )
+{
+  UINTN   Timer;
+  UINT32  Status;
+
+  Timer  = MMCI0_TIMEOUT * 60;
+  Status = MmioRead32 (MCI_STATUS_REG);
+  while (((Status & MCI_STATUS_CMD_DATAEND) != MCI_STATUS_CMD_DATAEND) && Timer) {
+    NanoSecondDelay(10);
+    Status = MmioRead32 (MCI_STATUS_REG);
+    Timer--;
+  }
+
+  if (Timer == 0) {
+    return EFI_TIMEOUT;
+  }
+
+  MmioWrite32 (MCI_CLEAR_STATUS_REG, MCI_STATUS_TXDONE);
+  return EFI_SUCCESS;
 }
 
 EFI_STATUS
@@ -118,9 +171,18 @@ MciSendCommand (
   RetVal = EFI_SUCCESS;
 
   if ((MmcCmd == MMC_CMD17) || (MmcCmd == MMC_CMD11)) {
-    MciPrepareDataPath (MCI_DATACTL_CARD_TO_CONT);
+    MciPrepareDataPath (MCI_DATACTL_CARD_TO_CONT, MMCI0_BLOCKLEN);
+  } else if (MmcCmd == MMC_CMD18) {
+    // The card starts sending as soon as it gets the command, but only
+    // MciReadBlockData () knows the length: arm the data path for as much as
+    // it can take. MciReadBlockData () re-arms it or stops it early.
+    MciPrepareDataPath (MCI_DATACTL_CARD_TO_CONT, MMCI0_MAX_DATA_LENGTH);
   } else if ((MmcCmd == MMC_CMD24) || (MmcCmd == MMC_CMD20)) {
-    MciPrepareDataPath (MCI_DATACTL_CONT_TO_CARD);
+    MciPrepareDataPath (MCI_DATACTL_CONT_TO_CARD, MMCI0_BLOCKLEN);
+  } else if (MmcCmd == MMC_CMD25) {
+    // The card waits for the data, so MciWriteBlockData () arms the data path
+    // once it knows the length
+    MciDisableDataPath ();
   } else if (MmcCmd == MMC_CMD6) {
     MmioWrite32 (MCI_DATA_TIMER_REG, 0xFFFFFFF);
     MmioWrite32 (MCI_DATA_LENGTH_REG, 64);
@@ -226,46 +288,42 @@ MciReadBlockData (
 {
   UINTN Loop;
   UINTN Finish;
+  UINTN ChunkEnd;
   UINTN Status;
   EFI_STATUS RetVal;
-  UINTN  DataCtrlReg;
   EFI_TPL Tpl;
 
   RetVal = EFI_SUCCESS;
 
   // Read data from the RX FIFO
-  Loop   = 0;
-  if (Length < MMCI0_BLOCKLEN) {
-    Finish = Length / 4;
-  } else {
-    Finish = MMCI0_BLOCKLEN / 4;
-  }
+  Loop     = 0;
+  Finish   = Length / 4;
+  ChunkEnd = MIN (Finish, MMCI0_MAX_DATA_LENGTH / 4);
 
   // Raise the TPL at the highest level to disable Interrupts.
   Tpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
   do {
+    if (Loop == ChunkEnd) {
+      // Re-arm the data path for the next chunk of a multi-block read
+      RetVal = MciWaitDataEnd ();
+      if (EFI_ERROR (RetVal)) {
+        DEBUG ((EFI_D_ERROR, "MciReadBlockData(): Data End timeout Number of words read 0x%x\n", Loop));
+        break;
+      }
+      MciPrepareDataPath (MCI_DATACTL_CARD_TO_CONT, MIN ((Finish - Loop) * 4, MMCI0_MAX_DATA_LENGTH));
+      ChunkEnd = MIN (Finish, ChunkEnd + MMCI0_MAX_DATA_LENGTH / 4);
+    }
+
     // Read the Status flags
     Status = MmioRead32 (MCI_STATUS_REG);
 
-    // Do eight reads if possible else a single read
-    if (Status & MCI_STATUS_CMD_RXFIFOHALFFULL) {
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
-      Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
-      Loop++;
+    // Do a burst of reads if possible else a single read. The FIFO is
+    // aliased over consecutive words, so a burst can use incrementing
+    // addresses.
+    if ((Status & MCI_STATUS_CMD_RXFIFOHALFFULL) && ((ChunkEnd - Loop) >= MMCI0_FIFO_BURST)) {
+      MmioReadBuffer32 (MCI_FIFO_REG, MMCI0_FIFO_BURST * 4, &Buffer[Loop]);
+      Loop += MMCI0_FIFO_BURST;
     } else if (Status & MCI_STATUS_CMD_RXDATAAVAILBL) {
       Buffer[Loop] = MmioRead32(MCI_FIFO_REG);
       Loop++;
@@ -294,13 +352,18 @@ MciReadBlockData (
   // Restore Tpl
   gBS->RestoreTPL (Tpl);
 
+  //Disable Data path
+  MciDisableDataPath ();
+
+  // A multi-block read may have been armed for more than was read: drop
+  // whatever the card sent before it was told to stop
+  while (MmioRead32 (MCI_STATUS_REG) & MCI_STATUS_CMD_RXDATAAVAILBL) {
+    MmioRead32 (MCI_FIFO_REG);
+  }
+
   // Clear Status flags
   MmioWrite32 (MCI_CLEAR_STATUS_REG, MCI_CLR_ALL_STATUS);
 
-  //Disable Data path
-  DataCtrlReg = MmioRead32 (MCI_DATA_CTL_REG);
-  MmioWrite32 (MCI_DATA_CTL_REG, (DataCtrlReg & MCI_DATACTL_DISABLE_MASK));
-
   return RetVal;
 }
 
@@ -314,44 +377,46 @@ MciWriteBlockData (
 {
   UINTN Loop;
   UINTN Finish;
+  UINTN ChunkEnd;
   UINTN Timer;
   UINTN Status;
   EFI_STATUS RetVal;
-  UINTN  DataCtrlReg;
   EFI_TPL Tpl;
 
   RetVal = EFI_SUCCESS;
 
   // Write the data to the TX FIFO
-  Loop   = 0;
-  Finish = MMCI0_BLOCKLEN / 4;
-  Timer  = MMCI0_TIMEOUT * 100;
+  Loop     = 0;
+  Finish   = Length / 4;
+  ChunkEnd = MIN (Finish, MMCI0_MAX_DATA_LENGTH / 4);
+
+  // Multi-block write: arm the data path for the first chunk
+  if (!mDataPathArmed) {
+    MciPrepareDataPath (MCI_DATACTL_CONT_TO_CARD, ChunkEnd * 4);
+  }
 
   // Raise the TPL at the highest level to disable Interrupts.
   Tpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
   do {
+    if (Loop == ChunkEnd) {
+      // Re-arm the data path for the next chunk of a multi-block write
+      RetVal = MciWaitDataEnd ();
+      if (EFI_ERROR (RetVal)) {
+        DEBUG ((EFI_D_ERROR, "MciWriteBlockData(): Data End timeout Number of words written 0x%x\n", Loop));
+        break;
+      }
+      MciPrepareDataPath (MCI_DATACTL_CONT_TO_CARD, MIN ((Finish - Loop) * 4, MMCI0_MAX_DATA_LENGTH));
+      ChunkEnd = MIN (Finish, ChunkEnd + MMCI0_MAX_DATA_LENGTH / 4);
+    }
+
     // Read the Status flags
     Status = MmioRead32 (MCI_STATUS_REG);
 
-    // Do eight writes if possible else a single write
-    if (Status & MCI_STATUS_CMD_TXFIFOHALFEMPTY) {
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
-      MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
-      Loop++;
+    // Do a burst of writes if possible else a single write
+    if ((Status & MCI_STATUS_CMD_TXFIFOHALFEMPTY) && ((ChunkEnd - Loop) >= MMCI0_FIFO_BURST)) {
+      MmioWriteBuffer32 (MCI_FIFO_REG, MMCI0_FIFO_BURST * 4, &Buffer[Loop]);
+      Loop += MMCI0_FIFO_BURST;
     } else if (!(Status & MCI_STATUS_CMD_TXFIFOFULL)) {
         MmioWrite32(MCI_FIFO_REG, Buffer[Loop]);
         Loop++;
@@ -377,6 +442,10 @@ MciWriteBlockData (
   // Restore Tpl
   gBS->RestoreTPL (Tpl);
 
+  if (EFI_ERROR (RetVal)) {
+    goto Exit;
+  }
+
   // Wait for FIFO to drain
   Timer  = MMCI0_TIMEOUT * 60;
   Status = MmioRead32 (MCI_STATUS_REG);
@@ -402,8 +471,7 @@ MciWriteBlockData (
 
 Exit:
   // Disable Data path
-  DataCtrlReg = MmioRead32 (MCI_DATA_CTL_REG);
-  MmioWrite32 (MCI_DATA_CTL_REG, (DataCtrlReg & MCI_DATACTL_DISABLE_MASK));
+  MciDisableDataPath ();
   return RetVal;
 }
 
@@ -516,6 +584,14 @@ MciBuildDevicePath (
   return EFI_SUCCESS;
 }
 
+BOOLEAN
+MciIsMultiBlock (
+  IN EFI_MMC_HOST_PROTOCOL      *This
+  )
+{
+  return TRUE;
+}
+
 EFI_MMC_HOST_PROTOCOL gMciHost = {
   MMC_HOST_PROTOCOL_REVISION,
   MciIsCardPresent,
@@ -525,7 +601,9 @@ EFI_MMC_HOST_PROTOCOL gMciHost = {
   MciSendCommand,
   MciReceiveResponse,
   MciReadBlockData,
-  MciWriteBlockData
+  MciWriteBlockData,
+  NULL,
+  MciIsMultiBlock
 };
 
 EFI_STATUS
@@ -231,7 +231,8 @@ HttpGetImage (
   Status = LoadFile->LoadFile (LoadFile, NewDevicePath, \
     TRUE, FileSize, *FileBuffer);
   if (EFI_ERROR (Status)) {
-    FreePool (FileBuffer);
+    FreePool (*FileBuffer);
+    *FileBuffer = NULL;
     goto Exit;
   }
 
@@ -26,6 +26,13 @@ GLOBAL_REMOVE_IF_UNREFERENCED EFI_BOOT_MODE    gBootMode;
 BOOLEAN                                        gPPRequireUIConfirm;
 extern UINTN                                   mBootMenuOptionNumber;
 
+//
+// Set when ConnectSequence only connected the device of boot option
+// mFastConnectOption, rather than all devices.
+//
+STATIC BOOLEAN                                 mFastConnectDone = FALSE;
+STATIC UINT16                                  mFastConnectOption;
+
 
 GLOBAL_REMOVE_IF_UNREFERENCED USB_CLASS_FORMAT_DEVICE_PATH gUsbClassKeyboardDevicePath = {
   {
@@ -980,10 +987,74 @@ EnumUsbKeyboard (
 }
 
 
+/**
+  Connect the device of the boot option that BDS is going to boot first,
+  which is BootNext if it is set, or the first entry of BootOrder otherwise.
+
+  @retval TRUE    The device path of the boot option has been connected.
+  @retval FALSE   There is no such boot option, or its device path could not
+                  be connected. This is the case for short-form device paths.
+**/
+BOOLEAN
+ConnectBootTarget (
+  VOID
+  )
+{
+  UINT16                        *BootNext;
+  UINT16                        *BootOrder;
+  UINTN                         VarSize;
+  UINT16                        OptionNumber;
+  CHAR16                        OptionName[sizeof ("Boot####")];
+  EFI_BOOT_MANAGER_LOAD_OPTION  BootOption;
+  EFI_STATUS                    Status;
+
+  GetEfiGlobalVariable2 (L"BootNext", (VOID **) &BootNext, &VarSize);
+  if (BootNext != NULL && VarSize == sizeof (UINT16)) {
+    OptionNumber = *BootNext;
+    FreePool (BootNext);
+  } else {
+    if (BootNext != NULL) {
+      FreePool (BootNext);
+    }
+    GetEfiGlobalVariable2 (EFI_BOOT_ORDER_VARIABLE_NAME, (VOID **) &BootOrder, &VarSize);
+    if (BootOrder == NULL) {
+      return FALSE;
+    }
+    if (VarSize < sizeof (UINT16)) {
+      FreePool (BootOrder);
+      return FALSE;
+    }
+    OptionNumber = BootOrder[0];
+    FreePool (BootOrder);
+  }
+
+  UnicodeSPrint (OptionName, sizeof (OptionName), L"Boot%04x", OptionNumber);
+  Status = EfiBootManagerVariableToLoadOption (OptionName, &BootOption);
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  Status = EfiBootManagerConnectDevicePath (BootOption.FilePath, NULL);
+  EfiBootManagerFreeLoadOption (&BootOption);
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  DEBUG ((DEBUG_INFO, "[Bds] Fast connect: connected %s\n", OptionName));
+  mFastConnectOption = OptionNumber;
+
+  return TRUE;
+}
+
 /**
   Connect with predeined platform connect sequence,
   the OEM/IBV can customize with their own connect sequence.
 
+  If PcdFastConnectBoot is set and the boot mode assumes that the
+  configuration didn't change, only the device of the boot option about
+  to be booted is connected (the consoles have been connected already).
+  BdsReadyToBootCallback connects all devices if another option is booted.
+
   @param[in] BootMode          Boot mode of this boot.
 **/
 VOID
@@ -991,6 +1062,17 @@ ConnectSequence (
   IN EFI_BOOT_MODE         BootMode
   )
 {
+  if (PcdGetBool (PcdFastConnectBoot) &&
+      (BootMode == BOOT_ASSUMING_NO_CONFIGURATION_CHANGES ||
+       BootMode == BOOT_WITH_MINIMAL_CONFIGURATION ||
+       BootMode == BOOT_ON_S4_RESUME)) {
+    if (ConnectBootTarget ()) {
+      mFastConnectDone = TRUE;
+      return;
+    }
+    DEBUG ((DEBUG_INFO, "[Bds] Fast connect not possible, connecting all devices\n"));
+  }
+
   EfiBootManagerConnectAll ();
 }
 
@@ -1005,18 +1087,25 @@ ConnectRootBridge (
   UINTN                            RootBridgeHandleCount;
   EFI_HANDLE                       *RootBridgeHandleBuffer;
   UINTN                            RootBridgeIndex;
+  EFI_STATUS                       Status;
 
   RootBridgeHandleCount = 0;
-  gBS->LocateHandleBuffer (
-         ByProtocol,
-         &gEfiPciRootBridgeIoProtocolGuid,
-         NULL,
-         &RootBridgeHandleCount,
-         &RootBridgeHandleBuffer
-         );
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiPciRootBridgeIoProtocolGuid,
+                  NULL,
+                  &RootBridgeHandleCount,
+                  &RootBridgeHandleBuffer
+                  );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
   for (RootBridgeIndex = 0; RootBridgeIndex < RootBridgeHandleCount; RootBridgeIndex++) {
     gBS->ConnectController (RootBridgeHandleBuffer[RootBridgeIndex], NULL, NULL, Recursive);
   }
+
+  FreePool (RootBridgeHandleBuffer);
 }
 
 VOID
@@ -1241,8 +1330,32 @@ BdsReadyToBootCallback (
   IN  VOID                      *Context
   )
 {
+  UINTN                         VarSize;
+  UINT16                        BootCurrent;
+  EFI_STATUS                    Status;
+
   DEBUG ((DEBUG_INFO, "BdsReadyToBootCallback\n"));
 
+  //
+  // Only the device of the boot option chosen by ConnectSequence has been
+  // connected. If that option failed, or a different one (e.g. setup) is
+  // being booted, connect everything so that it can find its device.
+  //
+  if (mFastConnectDone) {
+    VarSize = sizeof (UINT16);
+    Status = gRT->GetVariable (
+                    L"BootCurrent",
+                    &gEfiGlobalVariableGuid,
+                    NULL,
+                    &VarSize,
+                    &BootCurrent
+                    );
+    if (EFI_ERROR (Status) || BootCurrent != mFastConnectOption) {
+      mFastConnectDone = FALSE;
+      EfiBootManagerConnectAll ();
+    }
+  }
+
   if (BootCurrentIsInternalShell ()) {
 
     ChangeModeForInternalShell ();
@@ -165,6 +165,58 @@ CmosAccessLibGetChecksumLocation (
   ASSERT (Location->Length <= 2);
 }
 
+/**
+  Read a byte value from a CMOS address.
+
+  It's an internal function that doesn't check the accessibility.
+
+  @param [in] Address   Location to read from CMOS
+
+  @return The byte value read from the CMOS address.
+**/
+UINT8
+CmosAccessLibICmosRead8 (
+  IN  UINT8 Address
+  )
+{
+  if (Address <= CMOS_BANK0_LIMIT) {
+    if (PlatformCmosGetNmiState ()) {
+      Address |= BIT7;
+    }
+    IoWrite8 (PORT_70, Address);
+    return IoRead8 (PORT_71);
+  } else {
+    IoWrite8 (PORT_72, Address);
+    return IoRead8 (PORT_73);
+  }
+}
+
+/**
+  Write a byte value to a CMOS address.
+
+  It's an internal function that doesn't update the checksum.
+
+  @param [in] Address Location to write to CMOS.
+  @param [in] Data    The byte value write to the CMOS address.
+**/
+VOID
+CmosAccessLibICmosWrite8 (
+  IN UINT8 Address,
+  IN UINT8 Data
+  )
+{
+  if (Address <= CMOS_BANK0_LIMIT) {
+    if (PlatformCmosGetNmiState ()) {
+      Address |= BIT7;
+    }
+    IoWrite8 (PORT_70, Address);
+    IoWrite8 (PORT_71, Data);
+  } else {
+    IoWrite8 (PORT_72, Address);
+    IoWrite8 (PORT_73, Data);
+  }
+}
+
 /**
   Calculate the sum of CMOS values who need checksum calculation.
 
@@ -190,7 +242,10 @@ CmosAccessLibCalculateSum (
   Entries = PlatformCmosGetEntry (&Count);
   for (Index = 0; Index < Count; Index++) {
     if (CmosAccessLibNeedChecksum (Entries[Index].Address, &Entries[Index])) {
-      Sum += CmosRead8 (Entries[Index].Address);
+      //
+      // Locations that need checksum calculation are accessible, read them directly.
+      //
+      Sum += CmosAccessLibICmosRead8 (Entries[Index].Address);
     }
   }
 
@@ -219,12 +274,12 @@ CmosAccessLibReadChecksum (
 
   switch (Location->Length) {
   case 2:
-    Checksum = (CmosRead8 (Location->HighByteAddress) << 8);
+    Checksum = (CmosAccessLibICmosRead8 (Location->HighByteAddress) << 8);
     //
     // Fall to case 1 to get the low byte value
     //
   case 1:
-    Checksum += CmosRead8 (Location->LowByteAddress);
+    Checksum += CmosAccessLibICmosRead8 (Location->LowByteAddress);
     break;
 
   default:
@@ -251,12 +306,12 @@ CmosAccessLibWriteChecksum (
   case 0:
     break;
   case 2:
-    CmosWrite8 (Location->HighByteAddress, Checksum >> 8);
+    CmosAccessLibICmosWrite8 (Location->HighByteAddress, (UINT8) (Checksum >> 8));
     //
     // Fall to case 1 to update low byte value
     //
   case 1:
-    CmosWrite8 (Location->LowByteAddress, (UINT8) Checksum);
+    CmosAccessLibICmosWrite8 (Location->LowByteAddress, (UINT8) Checksum);
     break;
   }
 }
@@ -278,72 +333,61 @@ CmosRead8 (
     return 0xFF;
   }
 
-  if (Address <= CMOS_BANK0_LIMIT) {
-    if (PlatformCmosGetNmiState ()) {
-      Address |= BIT7;
-    }
-    IoWrite8 (PORT_70, Address);
-    return IoRead8 (PORT_71);
-  } else {
-    IoWrite8 (PORT_72, Address);
-    return IoRead8 (PORT_73);
-  }
+  return CmosAccessLibICmosRead8 (Address);
 }
 
 /**
-  Write a byte value to a CMOS address.
+  Write a value of up to 4 bytes to consecutive CMOS addresses.
 
-  It's an internal function that doesn't update the checksum.
+  Bytes that already hold the requested value are not written, and the
+  checksum is updated at most once for all the bytes.
 
   @param [in] Address Location to write to CMOS.
-  @param [in] Data    The byte value write to the CMOS address.
+  @param [in] Data    The value write to the CMOS address.
+  @param [in] Width   Number of bytes of Data to write.
 **/
 VOID
-CmosAccessLibICmosWrite8 (
-  IN UINT8 Address,
-  IN UINT8 Data
-  )
-{
-  if (Address <= CMOS_BANK0_LIMIT) {
-    if (PlatformCmosGetNmiState ()) {
-      Address |= BIT7;
-    }
-    IoWrite8 (PORT_70, Address);
-    IoWrite8 (PORT_71, Data);
-  } else {
-    IoWrite8 (PORT_72, Address);
-    IoWrite8 (PORT_73, Data);
-  }
-}
-
-/**
-  Write a byte value to a CMOS address.
-
-  @param [in] Address Location to write to CMOS.
-  @param [in] Data    The byte value write to the CMOS address.
-**/
-VOID
-EFIAPI
-CmosWrite8 (
-  IN UINT8 Address,
-  IN UINT8 Data
+CmosAccessLibWrite (
+  IN UINT8  Address,
+  IN UINT32 Data,
+  IN UINTN  Width
   )
 {
+  UINTN                       Index;
+  UINT8                       ByteAddress;
   UINT8                       OriginalData;
+  UINT16                      SumDelta;
+  BOOLEAN                     ChecksumChanged;
   CMOS_ENTRY                  *Entry;
   CMOS_CHECKSUM_LOCATION_INFO ChecksumLocation;
 
-  Entry = CmosAccessLibLocateEntry (Address);
+  ASSERT (Width <= sizeof (UINT32));
 
-  if (!CmosAccessLibIsAccessible (Address, Entry)) {
-    return;
-  }
+  SumDelta        = 0;
+  ChecksumChanged = FALSE;
 
-  OriginalData = CmosRead8 (Address);
+  for (Index = 0; Index < Width; Index++, Data >>= 8) {
+    ByteAddress = (UINT8) (Address + Index);
+    Entry = CmosAccessLibLocateEntry (ByteAddress);
 
-  CmosAccessLibICmosWrite8 (Address, Data);
+    if (!CmosAccessLibIsAccessible (ByteAddress, Entry)) {
+      continue;
+    }
+
+    OriginalData = CmosAccessLibICmosRead8 (ByteAddress);
+    if (OriginalData == (UINT8) Data) {
+      continue;
+    }
+
+    CmosAccessLibICmosWrite8 (ByteAddress, (UINT8) Data);
 
-  if (CmosAccessLibNeedChecksum (Address, Entry)) {
+    if (CmosAccessLibNeedChecksum (ByteAddress, Entry)) {
+      SumDelta        += (UINT16) ((UINT8) Data - OriginalData);
+      ChecksumChanged  = TRUE;
+    }
+  }
+
+  if (ChecksumChanged) {
     //
     // Sum of Data + Checksum = New Sum of Data + New Checksum = 0
     // New Sum of Data - Sum of Data = Checksum - New Checksum
@@ -352,11 +396,27 @@ CmosWrite8 (
     CmosAccessLibGetChecksumLocation (&ChecksumLocation);
     CmosAccessLibWriteChecksum (
       &ChecksumLocation,
-      CmosAccessLibReadChecksum (&ChecksumLocation) - (Data - OriginalData)
+      CmosAccessLibReadChecksum (&ChecksumLocation) - SumDelta
       );
   }
 }
 
+/**
+  Write a byte value to a CMOS address.
+
+  @param [in] Address Location to write to CMOS.
+  @param [in] Data    The byte value write to the CMOS address.
+**/
+VOID
+EFIAPI
+CmosWrite8 (
+  IN UINT8 Address,
+  IN UINT8 Data
+  )
+{
+  CmosAccessLibWrite (Address, Data, sizeof (UINT8));
+}
+
 /**
   Read a word value from a CMOS address.
 
@@ -386,8 +446,7 @@ CmosWrite16 (
   IN UINT16 Data
   )
 {
-  CmosWrite8 (Address, (UINT8) Data);
-  CmosWrite8 (Address + 1, (UINT8) (Data >> 8));
+  CmosAccessLibWrite (Address, Data, sizeof (UINT16));
 }
 
 /**
@@ -419,8 +478,7 @@ CmosWrite32 (
   IN UINT32 Data
   )
 {
-  CmosWrite16 (Address, (UINT16) Data);
-  CmosWrite16 (Address + 2, (UINT16) (Data >> 16));
+  CmosAccessLibWrite (Address, Data, sizeof (UINT32));
 }
 
 
@@ -441,7 +499,11 @@ CmosInit (
   )
 {
   UINTN                       Address;
-  CMOS_ENTRY                  *Entry;
+  UINTN                       Index;
+  UINTN                       Count;
+  CMOS_ENTRY                  *Entries;
+  UINT8                       DefaultData[CMOS_BANK1_LIMIT + 1];
+  UINT8                       SkipFill[(CMOS_BANK1_LIMIT + 1) / 8];
   CMOS_CHECKSUM_LOCATION_INFO ChecksumLocation;
   UINT16                      Checksum;
 
@@ -462,13 +524,28 @@ CmosInit (
   }
 
   if (Force) {
+    //
+    // Collect the default data of entire CMOS location in one pass over the platform entries,
+    // instead of locating the entry of every address.
+    //
+    SetMem (DefaultData, sizeof (DefaultData), CMOS_DEFAULT_VALUE);
+    ZeroMem (SkipFill, sizeof (SkipFill));
+    Entries = PlatformCmosGetEntry (&Count);
+    for (Index = 0; Index < Count; Index++) {
+      Address = Entries[Index].Address;
+      if (CmosAccessLibNeedFillDefault ((UINT8) Address, &Entries[Index])) {
+        DefaultData[Address] = Entries[Index].DefaultValue;
+      } else {
+        SkipFill[Address / 8] |= (UINT8) (1 << (Address % 8));
+      }
+    }
+
     //
     // Traverse through entire CMOS location and fill it with zero
     //
     for (Address = 0; Address <= CMOS_BANK1_LIMIT; Address++) {
-      Entry = CmosAccessLibLocateEntry ((UINT8) Address);
-      if (CmosAccessLibNeedFillDefault ((UINT8) Address, Entry)) {
-        CmosAccessLibICmosWrite8 ((UINT8) Address, (Entry == NULL) ? CMOS_DEFAULT_VALUE : Entry->DefaultValue);
+      if ((SkipFill[Address / 8] & (1 << (Address % 8))) == 0) {
+        CmosAccessLibICmosWrite8 ((UINT8) Address, DefaultData[Address]);
       }
     }
 
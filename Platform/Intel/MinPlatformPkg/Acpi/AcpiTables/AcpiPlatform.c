@@ -38,6 +38,25 @@ typedef union {
 
 #pragma pack()
 
+//
+// The MADT built on a previous boot is kept in a variable, prefixed by this
+// header. It is installed as is when the signature of the processor topology
+// and the platform settings the MADT is built from did not change.
+//
+#define MADT_CACHE_VARIABLE_NAME  L"MadtCache"
+#define MADT_CACHE_SIGNATURE      SIGNATURE_32 ('M', 'A', 'D', 'C')
+
+typedef struct {
+  UINT32   CacheSignature;
+  UINT32   TopologySignature;
+} MADT_CACHE_HEADER;
+
+//
+// Number of UINT32 values in the topology signature that do not depend on
+// the number of processors.
+//
+#define MADT_TOPOLOGY_FIXED_COUNT  19
+
 extern EFI_ACPI_6_3_FIRMWARE_ACPI_CONTROL_STRUCTURE     Facs;
 extern EFI_ACPI_6_3_FIXED_ACPI_DESCRIPTION_TABLE        Fadt;
 extern EFI_ACPI_HIGH_PRECISION_EVENT_TIMER_TABLE_HEADER Hpet;
@@ -72,9 +91,13 @@ DebugDisplayReOrderTable (
 {
   UINT32 Index;
 
-  DEBUG ((DEBUG_INFO, "Index  AcpiProcId  ApicId   Thread  Flags   Skt\n"));
+  //
+  // One line per thread takes seconds on a serial console with hundreds of
+  // threads, so the table is only dumped at verbose level.
+  //
+  DEBUG ((DEBUG_VERBOSE, "Index  AcpiProcId  ApicId   Thread  Flags   Skt\n"));
   for (Index = 0; Index < mNumberOfCpus; Index++) {
-    DEBUG ((DEBUG_INFO, " %02d       0x%02X      0x%02X       %d      %d      %d\n",
+    DEBUG ((DEBUG_VERBOSE, " %02d       0x%02X      0x%02X       %d      %d      %d\n",
                            Index,
                            CpuApicIdOrderTable[Index].AcpiProcessorUid,
                            CpuApicIdOrderTable[Index].ApicId,
@@ -147,6 +170,7 @@ CreateCpuLocalApicInTable (
   UINT32                                    CurrProcessor;
   EFI_CPU_ID_ORDER_MAP                      *CpuIdMapPtr;
   UINT32                                    Socket;
+  UINT32                                    SocketThreadCount[FixedPcdGet32 (PcdMaxCpuSocketCount)];
 
   Status     = EFI_SUCCESS;
 
@@ -186,14 +210,16 @@ CreateCpuLocalApicInTable (
 
 
   //
-  // Fill in AcpiProcessorUid.
+  // Fill in AcpiProcessorUid. The enabled threads of each socket are numbered
+  // in processor order, so a running count per socket assigns all of them in
+  // a single pass instead of one pass over all processors per socket.
   //
-  for (Socket = 0; Socket < FixedPcdGet32 (PcdMaxCpuSocketCount); Socket++) {
-    for (CurrProcessor = 0, Index = 0; CurrProcessor < mNumberOfCpus; CurrProcessor++) {
-      if (CpuApicIdOrderTable[CurrProcessor].Flags && (CpuApicIdOrderTable[CurrProcessor].SocketNum == Socket)) {
-        CpuApicIdOrderTable[CurrProcessor].AcpiProcessorUid = (CpuApicIdOrderTable[CurrProcessor].SocketNum << mNumOfBitShift) + Index;
-        Index++;
-      }
+  ZeroMem (SocketThreadCount, sizeof (SocketThreadCount));
+  for (CurrProcessor = 0; CurrProcessor < mNumberOfCpus; CurrProcessor++) {
+    Socket = CpuApicIdOrderTable[CurrProcessor].SocketNum;
+    if (CpuApicIdOrderTable[CurrProcessor].Flags && (Socket < FixedPcdGet32 (PcdMaxCpuSocketCount))) {
+      CpuApicIdOrderTable[CurrProcessor].AcpiProcessorUid = (Socket << mNumOfBitShift) + SocketThreadCount[Socket];
+      SocketThreadCount[Socket]++;
     }
   }
 
@@ -630,6 +656,203 @@ BuildAcpiTable (
   return EFI_SUCCESS;
 }
 
+/**
+  Calculate a signature of everything the MADT is built from: the location and
+  state of every processor, the APIC mode and the platform PCDs that describe
+  the I/O APICs and the table header.
+
+  The processor information is cached by the MP services, so reading it does
+  not involve the APs.
+
+  @retval 0                     The signature could not be calculated.
+  @retval Others                The CRC32 of the MADT inputs.
+**/
+UINT32
+CalculateMadtTopologySignature (
+  VOID
+  )
+{
+  EFI_STATUS                                Status;
+  EFI_PROCESSOR_INFORMATION                 ProcessorInfoBuffer;
+  UINT32                                    *TopologyData;
+  UINTN                                     DataIndex;
+  UINTN                                     Index;
+  UINT64                                    OemId;
+  UINT64                                    OemTableId;
+  UINT32                                    Signature;
+
+  TopologyData = AllocateZeroPool ((mNumberOfCpus * 4 + MADT_TOPOLOGY_FIXED_COUNT) * sizeof (UINT32));
+  if (TopologyData == NULL) {
+    return 0;
+  }
+
+  DataIndex = 0;
+  for (Index = 0; Index < mNumberOfCpus; Index++) {
+    Status = mMpService->GetProcessorInfo (
+                           mMpService,
+                           Index,
+                           &ProcessorInfoBuffer
+                           );
+    if (EFI_ERROR (Status)) {
+      FreePool (TopologyData);
+      return 0;
+    }
+    TopologyData[DataIndex++] = (UINT32) ProcessorInfoBuffer.ProcessorId;
+    TopologyData[DataIndex++] = ProcessorInfoBuffer.StatusFlag;
+    TopologyData[DataIndex++] = ProcessorInfoBuffer.Location.Package;
+    TopologyData[DataIndex++] = ProcessorInfoBuffer.Location.Thread;
+  }
+
+  OemId = 0;
+  CopyMem (&OemId, PcdGetPtr (PcdAcpiDefaultOemId), sizeof (((EFI_ACPI_DESCRIPTION_HEADER *) 0)->OemId));
+  OemTableId = PcdGet64 (PcdAcpiDefaultOemTableId);
+
+  TopologyData[DataIndex++] = (UINT32) mNumberOfCpus;
+  TopologyData[DataIndex++] = mX2ApicEnabled;
+  TopologyData[DataIndex++] = mForceX2ApicId;
+  TopologyData[DataIndex++] = mNumOfBitShift;
+  TopologyData[DataIndex++] = FixedPcdGet32 (PcdMaxCpuSocketCount);
+  TopologyData[DataIndex++] = PcdGet32 (PcdLocalApicAddress);
+  TopologyData[DataIndex++] = PcdGet32 (PcdIoApicAddress);
+  TopologyData[DataIndex++] = PcdGet8 (PcdIoApicId);
+  TopologyData[DataIndex++] = PcdGet32 (PcdPcIoApicEnable);
+  TopologyData[DataIndex++] = PcdGet8 (PcdPcIoApicCount);
+  TopologyData[DataIndex++] = PcdGet8 (PcdPcIoApicIdBase);
+  TopologyData[DataIndex++] = PcdGet32 (PcdPcIoApicAddressBase);
+  TopologyData[DataIndex++] = (UINT32) OemId;
+  TopologyData[DataIndex++] = (UINT32) RShiftU64 (OemId, 32);
+  TopologyData[DataIndex++] = (UINT32) OemTableId;
+  TopologyData[DataIndex++] = (UINT32) RShiftU64 (OemTableId, 32);
+  TopologyData[DataIndex++] = PcdGet32 (PcdAcpiDefaultCreatorId);
+  TopologyData[DataIndex++] = PcdGet32 (PcdAcpiDefaultCreatorRevision);
+  TopologyData[DataIndex++] = EFI_ACPI_6_3_MULTIPLE_APIC_DESCRIPTION_TABLE_REVISION;
+  ASSERT (DataIndex == mNumberOfCpus * 4 + MADT_TOPOLOGY_FIXED_COUNT);
+
+  Signature = 0;
+  Status = gBS->CalculateCrc32 (TopologyData, DataIndex * sizeof (UINT32), &Signature);
+  FreePool (TopologyData);
+  if (EFI_ERROR (Status)) {
+    return 0;
+  }
+
+  DEBUG ((DEBUG_INFO, "MADT topology signature = 0x%08x\n", Signature));
+  return Signature;
+}
+
+/**
+  Install the MADT saved on a previous boot, if it was built from the same topology.
+
+  @param[in]  TopologySignature The signature of the current MADT inputs.
+
+  @retval EFI_SUCCESS           The cached MADT was installed.
+  @retval EFI_NOT_FOUND         There is no cached MADT, or it was built from a different topology.
+  @retval Others                The cached MADT could not be read or installed.
+**/
+EFI_STATUS
+InstallCachedMadt (
+  IN UINT32                         TopologySignature
+  )
+{
+  EFI_STATUS                        Status;
+  MADT_CACHE_HEADER                 *Cache;
+  EFI_ACPI_DESCRIPTION_HEADER       *CachedTable;
+  UINTN                             CacheSize;
+  UINTN                             TableHandle;
+
+  Cache     = NULL;
+  CacheSize = 0;
+  Status = gRT->GetVariable (
+                  MADT_CACHE_VARIABLE_NAME,
+                  &gEfiCallerIdGuid,
+                  NULL,
+                  &CacheSize,
+                  NULL
+                  );
+  if (Status != EFI_BUFFER_TOO_SMALL) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (CacheSize < sizeof (MADT_CACHE_HEADER) + sizeof (EFI_ACPI_6_3_MULTIPLE_APIC_DESCRIPTION_TABLE_HEADER)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Cache = AllocatePool (CacheSize);
+  if (Cache == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = gRT->GetVariable (
+                  MADT_CACHE_VARIABLE_NAME,
+                  &gEfiCallerIdGuid,
+                  NULL,
+                  &CacheSize,
+                  Cache
+                  );
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  CachedTable = (EFI_ACPI_DESCRIPTION_HEADER *) (Cache + 1);
+  if ((Cache->CacheSignature != MADT_CACHE_SIGNATURE) ||
+      (Cache->TopologySignature != TopologySignature) ||
+      (CachedTable->Signature != EFI_ACPI_6_3_MULTIPLE_APIC_DESCRIPTION_TABLE_SIGNATURE) ||
+      (CachedTable->Length != CacheSize - sizeof (MADT_CACHE_HEADER))) {
+    DEBUG ((DEBUG_INFO, "Cached MADT does not match the current topology\n"));
+    Status = EFI_NOT_FOUND;
+    goto Done;
+  }
+
+  Status = mAcpiTable->InstallAcpiTable (
+                         mAcpiTable,
+                         CachedTable,
+                         CachedTable->Length,
+                         &TableHandle
+                         );
+  DEBUG ((DEBUG_INFO, "Install cached MADT - %r\n", Status));
+
+Done:
+  FreePool (Cache);
+  return Status;
+}
+
+/**
+  Save the MADT built on this boot, so that it can be installed as is on the
+  next boot if the topology does not change.
+
+  @param[in]  TopologySignature The signature of the MADT inputs.
+  @param[in]  MadtTable         The MADT that was installed.
+**/
+VOID
+SaveMadtCache (
+  IN UINT32                         TopologySignature,
+  IN EFI_ACPI_DESCRIPTION_HEADER    *MadtTable
+  )
+{
+  EFI_STATUS                        Status;
+  MADT_CACHE_HEADER                 *Cache;
+  UINTN                             CacheSize;
+
+  CacheSize = sizeof (MADT_CACHE_HEADER) + MadtTable->Length;
+  Cache = AllocatePool (CacheSize);
+  if (Cache == NULL) {
+    return;
+  }
+
+  Cache->CacheSignature    = MADT_CACHE_SIGNATURE;
+  Cache->TopologySignature = TopologySignature;
+  CopyMem (Cache + 1, MadtTable, MadtTable->Length);
+
+  Status = gRT->SetVariable (
+                  MADT_CACHE_VARIABLE_NAME,
+                  &gEfiCallerIdGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  CacheSize,
+                  Cache
+                  );
+  DEBUG ((DEBUG_INFO, "Save MADT cache - %r\n", Status));
+  FreePool (Cache);
+}
+
 /**
   Build from scratch and install the MADT.
 
@@ -660,11 +883,27 @@ InstallMadtFromScratch (
   UINT32                                              PcIoApicEnable;
   UINT32                                              PcIoApicMask;
   UINTN                                               PcIoApicIndex;
+  UINT32                                              TopologySignature;
 
   MadtStructs = NULL;
   NewMadtTable = NULL;
   CpuApicIdOrderTable = NULL;
   MaxMadtStructCount = 0;
+  TopologySignature = 0;
+
+  //
+  // On an unchanged system, install the MADT built on a previous boot instead
+  // of building it again structure by structure.
+  //
+  if (FeaturePcdGet (PcdAcpiMadtCacheEnable)) {
+    TopologySignature = CalculateMadtTopologySignature ();
+    if (TopologySignature != 0) {
+      Status = InstallCachedMadt (TopologySignature);
+      if (!EFI_ERROR (Status)) {
+        return EFI_SUCCESS;
+      }
+    }
+  }
 
   CpuApicIdOrderTable = AllocateZeroPool (mNumberOfCpus * sizeof (EFI_CPU_ID_ORDER_MAP));
   if (CpuApicIdOrderTable == NULL) {
@@ -919,6 +1158,9 @@ InstallMadtFromScratch (
                          NewMadtTable->Header.Length,
                          &TableHandle
                          );
+  if (!EFI_ERROR (Status) && (TopologySignature != 0)) {
+    SaveMadtCache (TopologySignature, &NewMadtTable->Header);
+  }
 
 Done:
   //
@@ -670,13 +670,19 @@ PostFspsHobProcess (
   }
   CheckFspGraphicsDeviceInfoHob ();
   DEBUG_CODE_BEGIN ();
-    DumpFspSmbiosMemoryInfoHob ();
-    DumpFspSmbiosProcessorInfoHob();
-    DumpFspSmbiosCacheInfoHob();
-    DumpFspGraphicsInfoHob ();
-    DumpFspGraphicsDeviceInfoHob ();
-    DumpFspHobList ();
-    DumpFspMemoryResource ();
+    //
+    // The dumps walk the whole HOB list several times, only do it when
+    // their output is actually printed.
+    //
+    if (DebugPrintLevelEnabled (DEBUG_INFO)) {
+      DumpFspSmbiosMemoryInfoHob ();
+      DumpFspSmbiosProcessorInfoHob();
+      DumpFspSmbiosCacheInfoHob();
+      DumpFspGraphicsInfoHob ();
+      DumpFspGraphicsDeviceInfoHob ();
+      DumpFspHobList ();
+      DumpFspMemoryResource ();
+    }
   DEBUG_CODE_END ();
 
   Status = PeiServicesInstallPpi (&mSiliconInitializedDesc);
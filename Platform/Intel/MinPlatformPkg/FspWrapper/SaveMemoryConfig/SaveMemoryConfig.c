@@ -113,6 +113,11 @@ SaveMemoryConfigEntryPoint (
       Status = EFI_SUCCESS;
 
       if (!DataIsIdentical) {
+        //
+        // Usually only a small part of the training data changes between boots.
+        // SetLargeVariable() leaves the variables holding unchanged parts of the
+        // data alone, so only the changed parts are written to the flash.
+        //
         Status = SetLargeVariable (L"FspNvsBuffer", &gFspNvsBufferVariableGuid, TRUE, DataSize, HobData);
         if (Status == EFI_ABORTED) {
           //
@@ -0,0 +1,124 @@
+/** @file
+  Boot performance capture library.
+
+  Collects the boot performance records published through the FPDT into a
+  compact capture, which can be saved and compared against captures taken on
+  other boards or firmware releases.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _BOOT_PERF_CAPTURE_LIB_H_
+#define _BOOT_PERF_CAPTURE_LIB_H_
+
+#include <Uefi.h>
+
+#define BOOT_PERF_CAPTURE_SIGNATURE    SIGNATURE_32 ('B', 'P', 'C', 'T')
+#define BOOT_PERF_CAPTURE_VERSION      0x00000001
+
+#define BOOT_PERF_CAPTURE_NAME_LENGTH  32
+
+//
+// One measured item: a boot phase, a module entry point, a driver binding
+// Start(), an in-module measurement, ... Every occurrence of the same item is
+// summed up into a single entry.
+//
+typedef struct {
+  UINT16      ProgressId;   // ProgressID of the start record
+  UINT16      Reserved;
+  UINT32      Count;        // Number of start/end pairs summed up
+  EFI_GUID    Guid;         // Module or FFS file GUID
+  CHAR8       Name[BOOT_PERF_CAPTURE_NAME_LENGTH];
+  UINT64      Duration;     // Nanoseconds
+} BOOT_PERF_CAPTURE_ENTRY;
+
+typedef struct {
+  UINT32    Signature;
+  UINT32    Version;
+  UINT32    EntryCount;
+  UINT32    Reserved;
+  //
+  // Taken from the FPDT basic boot record, in nanoseconds
+  //
+  UINT64    ResetEnd;
+  UINT64    OsLoaderLoadImageStart;
+  UINT64    OsLoaderStartImageStart;
+//BOOT_PERF_CAPTURE_ENTRY  Entries[EntryCount];
+} BOOT_PERF_CAPTURE;
+
+/**
+  Collect the boot performance records of the current boot.
+
+  @param[out] Capture   The capture, allocated from pool. The caller frees it.
+
+  @retval EFI_SUCCESS           The capture was taken.
+  @retval EFI_NOT_FOUND         There is no FPDT or no boot performance table.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory for the capture.
+**/
+EFI_STATUS
+EFIAPI
+BootPerfCaptureCollect (
+  OUT BOOT_PERF_CAPTURE  **Capture
+  );
+
+/**
+  Return the size of a capture, including its entries.
+
+  @param[in] Capture    The capture.
+
+  @return The size of the capture, in bytes.
+**/
+UINTN
+EFIAPI
+BootPerfCaptureSize (
+  IN CONST BOOT_PERF_CAPTURE  *Capture
+  );
+
+/**
+  Check that a buffer, such as one read back from a file, holds a capture.
+
+  @param[in] Buffer     The buffer.
+  @param[in] Size       The size of the buffer, in bytes.
+
+  @retval TRUE   The buffer holds a well formed capture.
+  @retval FALSE  The buffer doesn't hold a capture.
+**/
+BOOLEAN
+EFIAPI
+BootPerfCaptureIsValid (
+  IN CONST VOID  *Buffer,
+  IN UINTN       Size
+  );
+
+/**
+  Find the entry of a capture which measures the same item as another entry,
+  usually from another capture.
+
+  @param[in] Capture    The capture to search.
+  @param[in] Entry      The entry to look for.
+
+  @return The matching entry, or NULL if the capture doesn't have one.
+**/
+CONST BOOT_PERF_CAPTURE_ENTRY *
+EFIAPI
+BootPerfCaptureFindEntry (
+  IN CONST BOOT_PERF_CAPTURE        *Capture,
+  IN CONST BOOT_PERF_CAPTURE_ENTRY  *Entry
+  );
+
+/**
+  Return a short name for the kind of item an entry measures.
+
+  @param[in] Entry      The entry.
+
+  @return An ASCII name, such as "Phase" or "Entry".
+**/
+CONST CHAR8 *
+EFIAPI
+BootPerfCaptureEntryType (
+  IN CONST BOOT_PERF_CAPTURE_ENTRY  *Entry
+  );
+
+#endif
@@ -9,6 +9,19 @@
 #ifndef _EFI_COMPRESS_LIB_H_
 #define _EFI_COMPRESS_LIB_H_
 
+//
+// Compression levels of CompressEx(). They all produce the format Compress()
+// does, which UefiDecompressLib decodes.
+//
+// COMPRESS_LEVEL_TREE uses the binary tree match finder of Compress(). The other
+// levels use hash chains, trading ratio for speed from COMPRESS_LEVEL_MAX
+// down to COMPRESS_LEVEL_FAST.
+//
+#define COMPRESS_LEVEL_TREE     0
+#define COMPRESS_LEVEL_FAST     1
+#define COMPRESS_LEVEL_DEFAULT  6
+#define COMPRESS_LEVEL_MAX      9
+
 /**
   The compression routine.
 
@@ -30,5 +43,31 @@ Compress (
   IN OUT  UINT64  *DstSize
   );
 
+/**
+  The compression routine, with a choice of match finder and effort.
+
+  @param[in]       SrcBuffer     The buffer containing the source data.
+  @param[in]       SrcSize       Number of bytes in SrcBuffer.
+  @param[in]       DstBuffer     The buffer to put the compressed image in.
+  @param[in, out]  DstSize       On input the size (in bytes) of DstBuffer, on
+                                 return the number of bytes placed in DstBuffer.
+  @param[in]       Level         COMPRESS_LEVEL_TREE, or from COMPRESS_LEVEL_FAST
+                                 to COMPRESS_LEVEL_MAX.
+
+  @retval EFI_SUCCESS           The compression was sucessful.
+  @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+  @retval EFI_INVALID_PARAMETER Level is not valid, or SrcSize is 4GB or more.
+  @retval EFI_OUT_OF_RESOURCES  Not enough memory for the compression.
+**/
+EFI_STATUS
+EFIAPI
+CompressEx (
+  IN      VOID    *SrcBuffer,
+  IN      UINT64  SrcSize,
+  IN      VOID    *DstBuffer,
+  IN OUT  UINT64  *DstSize,
+  IN      UINTN   Level
+  );
+
 #endif
 
@@ -607,6 +607,22 @@ TestPointSmmReadyToBootSmmPageProtection (
   VOID
   );
 
+/**
+  This service runs the checks the DXE test points deferred when PcdTestPointDeferredReport is set.
+  It must be called after the other Ready To Boot test points.
+
+  Test subject: Data collected by the test points.
+  Test overview: Analyze the data on all enabled processors.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+
+  @retval EFI_SUCCESS         The deferred checks were performed successfully.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootDeferredChecks (
+  VOID
+  );
+
 /**
   This service verifies the system state after Exit Boot Services is invoked.
 
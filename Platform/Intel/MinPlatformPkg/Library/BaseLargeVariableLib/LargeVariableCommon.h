@@ -51,4 +51,22 @@
 //
 #define MAX_VARIABLE_NAME_PAD_SIZE  3
 
+//
+// When the data is split across multiple variables, a small header variable
+// records how many variables were used and the total size of the data. This
+// allows the data to be read back without probing for every variable in the
+// set. The name of the header variable is the variable name followed by '#',
+// which can never be produced by appending an integer number. Data sets
+// written without a header are still found by probing.
+//
+#define LARGE_VARIABLE_HEADER_NAME_FORMAT   L"%s#"
+
+#define LARGE_VARIABLE_HEADER_SIGNATURE     SIGNATURE_32 ('L', 'V', 'H', 'D')
+
+typedef struct {
+  UINT32    Signature;
+  UINT32    NumVariables;
+  UINT64    TotalSize;
+} LARGE_VARIABLE_HEADER;
+
 #endif  // _LARGE_VARIABLE_COMMON_H_
@@ -24,6 +24,98 @@
 
 #include "LargeVariableCommon.h"
 
+/**
+  Reads the header variable of a large variable stored using multiple variables.
+
+  @param[in]   VariableName  A Null-terminated string that is the name of the vendor's
+                             variable.
+  @param[in]   VendorGuid    A unique identifier for the vendor.
+  @param[out]  Header        The header of the large variable.
+
+  @retval EFI_SUCCESS        The header was found and is valid.
+  @retval EFI_NOT_FOUND      There is no valid header for this large variable.
+
+**/
+STATIC
+EFI_STATUS
+GetLargeVariableHeader (
+  IN  CHAR16                      *VariableName,
+  IN  EFI_GUID                    *VendorGuid,
+  OUT LARGE_VARIABLE_HEADER       *Header
+  )
+{
+  CHAR16        HeaderVariableName[MAX_VARIABLE_NAME_SIZE];
+  EFI_STATUS    Status;
+  UINTN         HeaderSize;
+
+  ZeroMem (HeaderVariableName, MAX_VARIABLE_NAME_SIZE);
+  UnicodeSPrint (HeaderVariableName, MAX_VARIABLE_NAME_SIZE, LARGE_VARIABLE_HEADER_NAME_FORMAT, VariableName);
+  HeaderSize = sizeof (LARGE_VARIABLE_HEADER);
+  Status = VarLibGetVariable (HeaderVariableName, VendorGuid, NULL, &HeaderSize, Header);
+  if (EFI_ERROR (Status) ||
+      (HeaderSize != sizeof (LARGE_VARIABLE_HEADER)) ||
+      (Header->Signature != LARGE_VARIABLE_HEADER_SIGNATURE) ||
+      (Header->NumVariables == 0) ||
+      (Header->NumVariables > MAX_VARIABLE_SPLIT) ||
+      (Header->TotalSize > MAX_UINTN)) {
+    return EFI_NOT_FOUND;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Reads the data of a large variable using the information from its header, which
+  requires exactly one variable lookup per variable in the set.
+
+  @param[in]   VariableName  A Null-terminated string that is the name of the vendor's
+                             variable.
+  @param[in]   VendorGuid    A unique identifier for the vendor.
+  @param[in]   Header        The header of the large variable.
+  @param[out]  Data          The buffer to return the contents of the variable. Must be
+                             at least Header->TotalSize bytes large.
+
+  @retval EFI_SUCCESS        All data has been read.
+  @retval EFI_NOT_FOUND      The variables don't match the header.
+
+**/
+STATIC
+EFI_STATUS
+GetLargeVariableFromHeader (
+  IN  CHAR16                      *VariableName,
+  IN  EFI_GUID                    *VendorGuid,
+  IN  LARGE_VARIABLE_HEADER       *Header,
+  OUT VOID                        *Data
+  )
+{
+  CHAR16        TempVariableName[MAX_VARIABLE_NAME_SIZE];
+  EFI_STATUS    Status;
+  UINTN         Index;
+  UINTN         VariableSize;
+  UINTN         BytesRemaining;
+  UINT8         *OffsetPtr;
+
+  OffsetPtr       = (UINT8 *) Data;
+  BytesRemaining  = (UINTN) Header->TotalSize;
+  for (Index = 0; Index < Header->NumVariables; Index++) {
+    ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
+    UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, L"%s%d", VariableName, Index);
+    VariableSize = BytesRemaining;
+    Status = VarLibGetVariable (TempVariableName, VendorGuid, NULL, &VariableSize, (VOID *) OffsetPtr);
+    if (EFI_ERROR (Status)) {
+      return EFI_NOT_FOUND;
+    }
+    BytesRemaining -= VariableSize;
+    OffsetPtr += VariableSize;
+  }
+
+  if (BytesRemaining != 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Returns the value of a large variable.
 
@@ -56,6 +148,7 @@ GetLargeVariable (
   )
 {
   CHAR16        TempVariableName[MAX_VARIABLE_NAME_SIZE];
+  LARGE_VARIABLE_HEADER Header;
   EFI_STATUS    Status;
   UINTN         TotalSize;
   UINTN         VarDataSize;
@@ -95,6 +188,29 @@ GetLargeVariable (
       goto Done;
     }
 
+    //
+    // Use the header variable if there is one
+    //
+    Status = GetLargeVariableHeader (VariableName, VendorGuid, &Header);
+    if (!EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_VERBOSE, "GetLargeVariable: Header Found, NumVariables = %d\n", Header.NumVariables));
+      if (*DataSize < Header.TotalSize) {
+        *DataSize = (UINTN) Header.TotalSize;
+        Status = EFI_BUFFER_TOO_SMALL;
+        goto Done;
+      }
+      if (Data == NULL) {
+        Status = EFI_INVALID_PARAMETER;
+        goto Done;
+      }
+      Status = GetLargeVariableFromHeader (VariableName, VendorGuid, &Header, Data);
+      if (!EFI_ERROR (Status)) {
+        *DataSize = (UINTN) Header.TotalSize;
+        goto Done;
+      }
+      DEBUG ((DEBUG_WARN, "GetLargeVariable: Header does not match the variables, probing\n"));
+    }
+
     VarDataSize = 0;
     Index       = 0;
     ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
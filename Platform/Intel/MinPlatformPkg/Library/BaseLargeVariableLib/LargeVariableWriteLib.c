@@ -19,6 +19,7 @@
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/PrintLib.h>
 #include <Library/VariableReadLib.h>
 #include <Library/VariableWriteLib.h>
@@ -118,6 +119,86 @@ GetVariableSplitSize (
   return VariableSplitSize;
 }
 
+/**
+  Deletes the header variable of a large variable stored using multiple variables.
+
+  @param[in]  VariableName       A Null-terminated string that is the name of the vendor's variable.
+  @param[in]  VendorGuid         A unique identifier for the vendor.
+
+  @retval EFI_SUCCESS            The header variable was deleted.
+  @retval EFI_NOT_FOUND          There was no header variable.
+  @retval Others                 The header variable could not be deleted.
+
+**/
+STATIC
+EFI_STATUS
+DeleteLargeVariableHeader (
+  IN  CHAR16                       *VariableName,
+  IN  EFI_GUID                     *VendorGuid
+  )
+{
+  CHAR16        HeaderVariableName[MAX_VARIABLE_NAME_SIZE];
+
+  ZeroMem (HeaderVariableName, MAX_VARIABLE_NAME_SIZE);
+  UnicodeSPrint (HeaderVariableName, MAX_VARIABLE_NAME_SIZE, LARGE_VARIABLE_HEADER_NAME_FORMAT, VariableName);
+  return VarLibSetVariable (
+           HeaderVariableName,
+           VendorGuid,
+           EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS,
+           0,
+           NULL
+           );
+}
+
+/**
+  Checks whether one of the variables of a large variable set already holds
+  the given data, so that it does not need to be written again.
+
+  @param[in]  VariableName       A Null-terminated string that is the name of the variable.
+  @param[in]  VendorGuid         A unique identifier for the vendor.
+  @param[in]  DataSize           The size in bytes of the Data buffer.
+  @param[in]  Data               The data that is about to be stored in the variable.
+  @param[in]  Buffer             Scratch buffer of at least DataSize bytes used to read the variable.
+
+  @retval TRUE                   The variable exists with the same attributes, size and data.
+  @retval FALSE                  The variable must be written.
+
+**/
+STATIC
+BOOLEAN
+IsLargeVariableChunkIdentical (
+  IN  CHAR16                       *VariableName,
+  IN  EFI_GUID                     *VendorGuid,
+  IN  UINTN                        DataSize,
+  IN  VOID                         *Data,
+  IN  VOID                         *Buffer
+  )
+{
+  EFI_STATUS    Status;
+  UINT32        Attributes;
+  UINTN         VarDataSize;
+
+  //
+  // Probe the size first so a larger stale variable is not read into Buffer.
+  //
+  VarDataSize = 0;
+  Status = VarLibGetVariable (VariableName, VendorGuid, NULL, &VarDataSize, NULL);
+  if ((Status != EFI_BUFFER_TOO_SMALL) || (VarDataSize != DataSize)) {
+    return FALSE;
+  }
+
+  Status = VarLibGetVariable (VariableName, VendorGuid, &Attributes, &VarDataSize, Buffer);
+  if (EFI_ERROR (Status) || (VarDataSize != DataSize)) {
+    return FALSE;
+  }
+
+  if (Attributes != (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN) (CompareMem (Buffer, Data, DataSize) == 0);
+}
+
 /**
   Deletes a large variable.
 
@@ -210,6 +291,12 @@ DeleteLargeVariableInternal (
           Status = Status2;
         }
       }   // End of for loop
+
+      Status2 = DeleteLargeVariableHeader (VariableName, VendorGuid);
+      if (EFI_ERROR (Status2) && (Status2 != EFI_NOT_FOUND)) {
+        DEBUG ((DEBUG_ERROR, "DeleteLargeVariableInternal: Error deleting header: Status = %r\n", Status2));
+        Status = Status2;
+      }
     } else {
       Status = EFI_NOT_FOUND;
     }
@@ -260,6 +347,7 @@ SetLargeVariable (
   )
 {
   CHAR16        TempVariableName[MAX_VARIABLE_NAME_SIZE];
+  LARGE_VARIABLE_HEADER Header;
   UINT64        VariableSplitSize;
   UINT64        RemainingVariableStorage;
   EFI_STATUS    Status;
@@ -270,6 +358,8 @@ SetLargeVariable (
   UINT8         *OffsetPtr;
   UINTN         BytesRemaining;
   UINTN         SizeToSave;
+  VOID          *CompareBuffer;
+  UINTN         VariablesSkipped;
 
   //
   // Check input parameters.
@@ -288,6 +378,7 @@ SetLargeVariable (
   }
 
   VariablesSaved = 0;
+  CompareBuffer  = NULL;
   if (LockVariable && !VarLibIsVariableRequestToLockSupported ()) {
       Status = EFI_INVALID_PARAMETER;
       DEBUG ((DEBUG_ERROR, "SetLargeVariable: Variable locking is not currently supported\n"));
@@ -371,10 +462,30 @@ SetLargeVariable (
       goto Done;
     }
 
+    //
+    // Make sure a stale header does not survive a failed update
+    //
+    Status = DeleteLargeVariableHeader (VariableName, VendorGuid);
+    if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND)) {
+      DEBUG ((DEBUG_ERROR, "SetLargeVariable: Error deleting header: Status = %r\n", Status));
+      goto Done;
+    }
+
     DEBUG ((DEBUG_VERBOSE, "SetLargeVariable: Saving using multiple variables.\n"));
     OffsetPtr         = (UINT8 *) Data;
     BytesRemaining    = DataSize;
     VariablesSaved    = 0;
+    VariablesSkipped  = 0;
+
+    //
+    // Rewriting a variable with the data it already holds still consumes NV
+    // storage and flash erase cycles, so each chunk is compared against what is
+    // stored from a previous save and only the chunks that changed are written.
+    // The split size only shrinks as the index gets more digits, so a buffer
+    // sized for the shortest name is large enough for every chunk. If it cannot
+    // be allocated, all chunks are simply written.
+    //
+    CompareBuffer = AllocatePool ((UINTN) VariableSplitSize);
 
     //
     // Store chunks of data in UEFI variables until all data is stored
@@ -397,22 +508,72 @@ SetLargeVariable (
       } else {
         SizeToSave = BytesRemaining;
       }
-      DEBUG ((DEBUG_INFO, "Saving %s, Guid = %g, Size %d\n", TempVariableName, VendorGuid, SizeToSave));
-      Status = VarLibSetVariable (
-                TempVariableName,
-                VendorGuid,
-                EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS,
-                SizeToSave,
-                (VOID *) OffsetPtr
-                );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "SetLargeVariable: Error writting variable: Status = %r\n", Status));
-        goto Done;
+      if ((CompareBuffer != NULL) &&
+          IsLargeVariableChunkIdentical (TempVariableName, VendorGuid, SizeToSave, OffsetPtr, CompareBuffer)) {
+        DEBUG ((DEBUG_INFO, "Keeping %s, Guid = %g, Size %d, data is unchanged\n", TempVariableName, VendorGuid, SizeToSave));
+        VariablesSkipped++;
+      } else {
+        DEBUG ((DEBUG_INFO, "Saving %s, Guid = %g, Size %d\n", TempVariableName, VendorGuid, SizeToSave));
+        Status = VarLibSetVariable (
+                  TempVariableName,
+                  VendorGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS,
+                  SizeToSave,
+                  (VOID *) OffsetPtr
+                  );
+        if (EFI_ERROR (Status)) {
+          DEBUG ((DEBUG_ERROR, "SetLargeVariable: Error writting variable: Status = %r\n", Status));
+          goto Done;
+        }
       }
       VariablesSaved++;
       BytesRemaining -= SizeToSave;
       OffsetPtr += SizeToSave;
     }   // End of for loop
+    DEBUG ((DEBUG_INFO, "SetLargeVariable: %d of %d variables were unchanged\n", VariablesSkipped, VariablesSaved));
+
+    //
+    // Variables beyond the new end of the data are left over from a larger
+    // previous save. Remove them so probing readers do not pick them up.
+    //
+    for (Index = VariablesSaved; Index < MAX_VARIABLE_SPLIT; Index++) {
+      ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
+      UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, L"%s%d", VariableName, Index);
+      Status2 = VarLibSetVariable (
+                  TempVariableName,
+                  VendorGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS,
+                  0,
+                  NULL
+                  );
+      if (EFI_ERROR (Status2)) {
+        if (Status2 != EFI_NOT_FOUND) {
+          DEBUG ((DEBUG_WARN, "SetLargeVariable: Error deleting stale variable %s: Status = %r\n", TempVariableName, Status2));
+        }
+        break;
+      }
+      DEBUG ((DEBUG_INFO, "Deleted stale %s, Guid = %g\n", TempVariableName, VendorGuid));
+    }
+
+    //
+    // Record the layout of the data, so it can be read back without probing.
+    // Readers fall back to probing if the header is missing.
+    //
+    ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
+    UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, LARGE_VARIABLE_HEADER_NAME_FORMAT, VariableName);
+    Header.Signature    = LARGE_VARIABLE_HEADER_SIGNATURE;
+    Header.NumVariables = (UINT32) VariablesSaved;
+    Header.TotalSize    = DataSize;
+    Status2 = VarLibSetVariable (
+                TempVariableName,
+                VendorGuid,
+                EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_RUNTIME_ACCESS,
+                sizeof (Header),
+                &Header
+                );
+    if (EFI_ERROR (Status2)) {
+      DEBUG ((DEBUG_WARN, "SetLargeVariable: Error writting header: Status = %r\n", Status2));
+    }
 
     //
     // If the user requested that the variables be locked, lock them now that
@@ -435,10 +596,24 @@ SetLargeVariable (
           goto Done;
         }
       }
+
+      ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
+      UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, LARGE_VARIABLE_HEADER_NAME_FORMAT, VariableName);
+      DEBUG ((DEBUG_INFO, "Locking %s, Guid = %g\n", TempVariableName, VendorGuid));
+      Status = VarLibVariableRequestToLock (TempVariableName, VendorGuid);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "SetLargeVariable: Error locking header: Status = %r\n", Status));
+        Status = EFI_ABORTED;
+        VariablesSaved = 0;
+        goto Done;
+      }
     }
   }
 
 Done:
+  if (CompareBuffer != NULL) {
+    FreePool (CompareBuffer);
+  }
   if (EFI_ERROR (Status) && VariablesSaved > 0) {
     DEBUG ((DEBUG_ERROR, "SetLargeVariable: An error was encountered, deleting variables with partially stored data\n"));
     for (Index = 0; Index < VariablesSaved; Index++) {
@@ -457,6 +632,7 @@ Done:
         DEBUG ((DEBUG_ERROR, "SetLargeVariable: Error deleting variable: Status = %r\n", Status2));
       }
     }
+    DeleteLargeVariableHeader (VariableName, VendorGuid);
   }
   DEBUG ((DEBUG_ERROR, "SetLargeVariable: Status = %r\n", Status));
   return Status;
@@ -568,8 +744,16 @@ LockLargeVariable (
           }
         } else if (Status == EFI_NOT_FOUND) {
           //
-          // No more variables need to lock.
+          // No more variables need to lock, lock the header as well.
           //
+          ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
+          UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, LARGE_VARIABLE_HEADER_NAME_FORMAT, VariableName);
+          DEBUG ((DEBUG_INFO, "Locking %s, Guid = %g\n", TempVariableName, VendorGuid));
+          Status = VarLibVariableRequestToLock (TempVariableName, VendorGuid);
+          if (EFI_ERROR (Status)) {
+            DEBUG ((DEBUG_ERROR, "LockLargeVariable: Failed! Satus = %r\n", Status));
+            return EFI_ABORTED;
+          }
           return EFI_SUCCESS;
         }
       }   // End of for loop
@@ -15,6 +15,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/CompressLib.h>
 #include <Uefi/UefiBaseType.h>
 
 #define SHELL_FREE_NON_NULL(Pointer)  \
@@ -60,6 +61,33 @@ typedef INT16             NODE;
 #else
   #define                 NPT NP
 #endif
+
+//
+// Hash chain match finder. Chains link every position of the last WNDSIZ
+// bytes with the same first THRESHOLD bytes, newest first.
+//
+#define HASH_CHAIN_BIT    15
+#define HASH_CHAIN_SIZ    (1U << HASH_CHAIN_BIT)
+#define HASH_CHAIN(Ptr)   ((((UINT32) (Ptr)[0] << 10) ^ ((UINT32) (Ptr)[1] << 5) ^ (Ptr)[2]) & (HASH_CHAIN_SIZ - 1))
+
+typedef struct {
+  UINT16  MaxChain;   // Candidates tried for each position
+  UINT16  NiceLen;    // Stop looking once a match this long is found
+  BOOLEAN Lazy;       // Look one position ahead for a longer match
+} COMPRESS_LEVEL_CONFIG;
+
+STATIC CONST COMPRESS_LEVEL_CONFIG  mLevelConfig[COMPRESS_LEVEL_MAX + 1] = {
+  {    0,        0, FALSE },  // COMPRESS_LEVEL_TREE, not used
+  {    4,       16, FALSE },  // COMPRESS_LEVEL_FAST
+  {    8,       32, FALSE },
+  {   16,       32, TRUE  },
+  {   16,       64, TRUE  },
+  {   32,      128, TRUE  },
+  {   64,      128, TRUE  },  // COMPRESS_LEVEL_DEFAULT
+  {  128,      256, TRUE  },
+  {  512, MAXMATCH, TRUE  },
+  { 4096, MAXMATCH, TRUE  }   // COMPRESS_LEVEL_MAX
+};
 //
 // Function Prototypes
 //
@@ -123,6 +151,8 @@ STATIC NODE   *mPosition;
 STATIC NODE   *mParent;
 STATIC NODE   *mPrev;
 STATIC NODE   *mNext = NULL;
+STATIC UINT32 *mHashHead = NULL;
+STATIC UINT32 *mHashPrev = NULL;
 INT32         mHuffmanDepth = 0;
 
 /**
@@ -237,6 +267,8 @@ FreeMemory (
   SHELL_FREE_NON_NULL (mPrev);
   SHELL_FREE_NON_NULL (mNext);
   SHELL_FREE_NON_NULL (mBuf);
+  SHELL_FREE_NON_NULL (mHashHead);
+  SHELL_FREE_NON_NULL (mHashPrev);
 }
 
 /**
@@ -1351,6 +1383,186 @@ Encode (
   return (Status);
 }
 
+/**
+  Add a position of the source data to the hash chains.
+
+  @param[in] Src       The source data.
+  @param[in] Pos       The position. At least THRESHOLD bytes must follow it.
+**/
+VOID
+EFIAPI
+HashChainInsert (
+  IN CONST UINT8  *Src,
+  IN UINT32       Pos
+  )
+{
+  UINT32  Hash;
+
+  Hash                              = HASH_CHAIN (&Src[Pos]);
+  mHashPrev[Pos & (WNDSIZ - 1)]     = mHashHead[Hash];
+  mHashHead[Hash]                   = Pos + 1;
+}
+
+/**
+  Find the longest earlier string matching the source data at a position.
+
+  @param[in]  Src       The source data.
+  @param[in]  SrcSize   The number of bytes in the source data.
+  @param[in]  Pos       The position.
+  @param[in]  Config    The compression level settings.
+  @param[out] MatchDist The distance back to the match.
+
+  @return The length of the match, less than THRESHOLD if there is none.
+**/
+UINT32
+EFIAPI
+HashChainFindMatch (
+  IN  CONST UINT8                  *Src,
+  IN  UINT32                       SrcSize,
+  IN  UINT32                       Pos,
+  IN  CONST COMPRESS_LEVEL_CONFIG  *Config,
+  OUT UINT32                       *MatchDist
+  )
+{
+  UINT32  MaxLen;
+  UINT32  BestLen;
+  UINT32  Len;
+  UINT32  Cand;
+  UINT32  Chain;
+
+  MaxLen = SrcSize - Pos;
+  if (MaxLen > MAXMATCH) {
+    MaxLen = MAXMATCH;
+  }
+  if (MaxLen < THRESHOLD) {
+    return 0;
+  }
+
+  BestLen = 0;
+  Cand    = mHashHead[HASH_CHAIN (&Src[Pos])];
+  for (Chain = Config->MaxChain; Cand != 0 && Chain > 0; Chain--) {
+    Cand--;
+    //
+    // The chain is stale past the window, or if the slot was reused.
+    //
+    if (Cand >= Pos || Pos - Cand > WNDSIZ) {
+      break;
+    }
+
+    if (Src[Cand + BestLen] == Src[Pos + BestLen] && Src[Cand] == Src[Pos]) {
+      for (Len = 1; Len < MaxLen && Src[Cand + Len] == Src[Pos + Len]; Len++) {
+      }
+      if (Len > BestLen) {
+        BestLen    = Len;
+        *MatchDist = Pos - Cand;
+        if (Len >= Config->NiceLen || Len == MaxLen) {
+          break;
+        }
+      }
+    }
+
+    Cand = mHashPrev[Cand & (WNDSIZ - 1)];
+  }
+
+  return BestLen;
+}
+
+/**
+  The main controlling routine for compression with the hash chain match finder.
+
+  The whole source is in memory, so unlike Encode() the matches are searched
+  in place instead of through a sliding copy of it.
+
+  @param[in] Level    The compression level, from COMPRESS_LEVEL_FAST to COMPRESS_LEVEL_MAX.
+
+  @retval EFI_SUCCESS           The compression is successful.
+  @retval EFI_OUT_0F_RESOURCES  Not enough memory for compression process.
+**/
+EFI_STATUS
+EFIAPI
+EncodeHashChain (
+  IN UINTN  Level
+  )
+{
+  CONST COMPRESS_LEVEL_CONFIG  *Config;
+  CONST UINT8                  *Src;
+  UINT32                       SrcSize;
+  UINT32                       Pos;
+  UINT32                       Len;
+  UINT32                       Dist;
+  UINT32                       NextLen;
+  UINT32                       NextDist;
+  BOOLEAN                      HaveNext;
+  UINT32                       Index;
+
+  Config    = &mLevelConfig[Level];
+  Src       = mSrc;
+  SrcSize   = (UINT32) (mSrcUpperLimit - mSrc);
+  mOrigSize = SrcSize;
+
+  mHashHead = AllocateZeroPool (HASH_CHAIN_SIZ * sizeof (*mHashHead));
+  mHashPrev = AllocateZeroPool (WNDSIZ * sizeof (*mHashPrev));
+  mBufSiz   = BLKSIZ;
+  mBuf      = AllocateZeroPool (mBufSiz);
+  if (mHashHead == NULL || mHashPrev == NULL || mBuf == NULL) {
+    FreeMemory ();
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  HufEncodeStart ();
+
+  Pos      = 0;
+  NextLen  = 0;
+  NextDist = 0;
+  Dist     = 0;
+  HaveNext = FALSE;
+  while (Pos < SrcSize) {
+    if (HaveNext) {
+      Len      = NextLen;
+      Dist     = NextDist;
+      HaveNext = FALSE;
+    } else {
+      Len = HashChainFindMatch (Src, SrcSize, Pos, Config, &Dist);
+      if (Pos + THRESHOLD <= SrcSize) {
+        HashChainInsert (Src, Pos);
+      }
+    }
+
+    //
+    // Lazy matching: emit a character instead if the next position starts
+    // a longer match.
+    //
+    if (Config->Lazy && Len >= THRESHOLD && Len < Config->NiceLen && Pos + 1 < SrcSize) {
+      NextLen = HashChainFindMatch (Src, SrcSize, Pos + 1, Config, &NextDist);
+      if (Pos + 1 + THRESHOLD <= SrcSize) {
+        HashChainInsert (Src, Pos + 1);
+      }
+      HaveNext = TRUE;
+      if (NextLen > Len) {
+        CompressOutput (Src[Pos], 0);
+        Pos++;
+        continue;
+      }
+    }
+
+    if (Len >= THRESHOLD) {
+      CompressOutput (Len + (MAX_UINT8 + 1 - THRESHOLD), (Dist - 1) & (WNDSIZ - 1));
+      for (Index = HaveNext ? Pos + 2 : Pos + 1; Index < Pos + Len && Index + THRESHOLD <= SrcSize; Index++) {
+        HashChainInsert (Src, Index);
+      }
+      HaveNext = FALSE;
+      Pos     += Len;
+    } else {
+      CompressOutput (Src[Pos], 0);
+      Pos++;
+    }
+  }
+
+  HufEncodeEnd ();
+  FreeMemory ();
+  return EFI_SUCCESS;
+}
+
 /**
   The compression routine.
 
@@ -1371,9 +1583,41 @@ Compress (
   IN       VOID   *DstBuffer,
   IN OUT   UINT64 *DstSize
   )
+{
+  return CompressEx (SrcBuffer, SrcSize, DstBuffer, DstSize, COMPRESS_LEVEL_TREE);
+}
+
+/**
+  The compression routine, with a choice of match finder and effort.
+
+  @param[in]       SrcBuffer     The buffer containing the source data.
+  @param[in]       SrcSize       The number of bytes in SrcBuffer.
+  @param[in]       DstBuffer     The buffer to put the compressed image in.
+  @param[in, out]  DstSize       On input the size (in bytes) of DstBuffer, on
+                                return the number of bytes placed in DstBuffer.
+  @param[in]       Level         COMPRESS_LEVEL_TREE, or from COMPRESS_LEVEL_FAST
+                                 to COMPRESS_LEVEL_MAX.
+
+  @retval EFI_SUCCESS           The compression was sucessful.
+  @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+  @retval EFI_INVALID_PARAMETER Level is not valid, or SrcSize is 4GB or more.
+**/
+EFI_STATUS
+EFIAPI
+CompressEx (
+  IN       VOID   *SrcBuffer,
+  IN       UINT64 SrcSize,
+  IN       VOID   *DstBuffer,
+  IN OUT   UINT64 *DstSize,
+  IN       UINTN  Level
+  )
 {
   EFI_STATUS  Status;
 
+  if (Level > COMPRESS_LEVEL_MAX || SrcSize > MAX_UINT32) {
+    return EFI_INVALID_PARAMETER;
+  }
+
   //
   // Initializations
   //
@@ -1386,6 +1630,8 @@ Compress (
   mParent         = NULL;
   mPrev           = NULL;
   mNext           = NULL;
+  mHashHead       = NULL;
+  mHashPrev       = NULL;
 
   mSrc            = SrcBuffer;
   mSrcUpperLimit  = mSrc + SrcSize;
@@ -1403,7 +1649,11 @@ Compress (
   //
   // Compress it
   //
-  Status = Encode ();
+  if (Level == COMPRESS_LEVEL_TREE) {
+    Status = Encode ();
+  } else {
+    Status = EncodeHashChain (Level);
+  }
   if (EFI_ERROR (Status)) {
     return EFI_OUT_OF_RESOURCES;
   }
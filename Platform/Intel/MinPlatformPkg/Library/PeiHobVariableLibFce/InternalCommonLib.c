@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Uefi.h>
 #include <PiPei.h>
 #include <Library/PeiServicesTablePointerLib.h>
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/HobVariableLib.h>
@@ -406,6 +407,161 @@ EFI_PEI_NOTIFY_DESCRIPTOR mMemoryNotifyList = {
   BuildDefaultDataHobForRecoveryVariable 
 };
 
+/**
+  Computes the hash index key of a variable.
+
+  @param[in]  Name              Pointer to the variable name.
+  @param[in]  NameSize          Size of the variable name in bytes.
+  @param[in]  VendorGuid        A unique identifier for the vendor.
+
+  @return 32-bit FNV-1a hash of the variable name and vendor GUID.
+
+**/
+STATIC
+UINT32
+HashVariable (
+  IN CONST VOID                 *Name,
+  IN UINTN                      NameSize,
+  IN CONST EFI_GUID             *VendorGuid
+  )
+{
+  CONST UINT8                   *Ptr;
+  UINTN                         Index;
+  UINT32                        Hash;
+
+  Hash = 0x811C9DC5;
+  Ptr  = (CONST UINT8 *) Name;
+  for (Index = 0; Index < NameSize; Index++) {
+    Hash = (Hash ^ Ptr[Index]) * 0x01000193;
+  }
+  Ptr = (CONST UINT8 *) VendorGuid;
+  for (Index = 0; Index < sizeof (EFI_GUID); Index++) {
+    Hash = (Hash ^ Ptr[Index]) * 0x01000193;
+  }
+
+  return Hash;
+}
+
+/**
+  Gets the hash index of the default variable HOB, building it on first use.
+
+  @param[in]  StoreHob          Pointer to the GUID HOB holding the variable store.
+  @param[in]  VariableStoreHeader  Pointer to the variable store.
+  @param[in]  AuthFlag          Authenticated variable flag.
+
+  @return Pointer to the index, NULL if the variable store can't be indexed.
+
+**/
+STATIC
+VARIABLE_INDEX_HEADER *
+GetVariableIndex (
+  IN EFI_HOB_GUID_TYPE          *StoreHob,
+  IN VARIABLE_STORE_HEADER      *VariableStoreHeader,
+  IN BOOLEAN                    AuthFlag
+  )
+{
+  EFI_HOB_GUID_TYPE             *GuidHob;
+  VARIABLE_INDEX_HEADER         *VariableIndex;
+  UINT32                        *Buckets;
+  VARIABLE_INDEX_ENTRY          *Entries;
+  AUTHENTICATED_VARIABLE_HEADER *StartPtr;
+  AUTHENTICATED_VARIABLE_HEADER *EndPtr;
+  AUTHENTICATED_VARIABLE_HEADER *CurrPtr;
+  UINT32                        EntryCount;
+  UINT32                        BucketCount;
+  UINT32                        Bucket;
+  UINT32                        Entry;
+  UINTN                         IndexSize;
+
+  GuidHob = GetFirstGuidHob (&gHobVariableIndexGuid);
+  if (GuidHob != NULL) {
+    VariableIndex = (VARIABLE_INDEX_HEADER *) GET_GUID_HOB_DATA (GuidHob);
+    if ((VariableIndex->BucketCount == 0) ||
+        (VariableIndex->StoreSize != VariableStoreHeader->Size) ||
+        !CompareGuid (&VariableIndex->StoreGuid, &StoreHob->Name)) {
+      return NULL;
+    }
+    return VariableIndex;
+  }
+
+  StartPtr = GetStartPointer (VariableStoreHeader);
+  EndPtr   = GetEndPointer (VariableStoreHeader);
+
+  //
+  // Size the index for a load factor of at most one entry per bucket.
+  //
+  EntryCount = 0;
+  for ( CurrPtr = StartPtr
+      ; (CurrPtr < EndPtr) && IsValidVariableHeader (CurrPtr)
+      ; CurrPtr = GetNextVariablePtr (CurrPtr, AuthFlag)
+      ) {
+    if (CurrPtr->State == VAR_ADDED) {
+      EntryCount++;
+    }
+  }
+  BucketCount = 1;
+  while (BucketCount < EntryCount) {
+    BucketCount <<= 1;
+  }
+  IndexSize = sizeof (VARIABLE_INDEX_HEADER) +
+              BucketCount * sizeof (UINT32) +
+              EntryCount * sizeof (VARIABLE_INDEX_ENTRY);
+  if (IndexSize > MAX_VARIABLE_INDEX_SIZE) {
+    //
+    // Publish an empty index so that the store is not counted again.
+    //
+    DEBUG ((DEBUG_INFO, "Variable HOB has too many variables (%d) to index\n", EntryCount));
+    BucketCount = 0;
+    EntryCount  = 0;
+    IndexSize   = sizeof (VARIABLE_INDEX_HEADER);
+  }
+
+  VariableIndex = (VARIABLE_INDEX_HEADER *) BuildGuidHob (&gHobVariableIndexGuid, IndexSize);
+  if (VariableIndex == NULL) {
+    return NULL;
+  }
+  CopyGuid (&VariableIndex->StoreGuid, &StoreHob->Name);
+  VariableIndex->StoreSize   = VariableStoreHeader->Size;
+  VariableIndex->BucketCount = BucketCount;
+  VariableIndex->EntryCount  = EntryCount;
+  if (BucketCount == 0) {
+    return NULL;
+  }
+
+  Buckets = (UINT32 *) (VariableIndex + 1);
+  Entries = (VARIABLE_INDEX_ENTRY *) (Buckets + BucketCount);
+  ZeroMem (Buckets, BucketCount * sizeof (UINT32));
+
+  Entry = 0;
+  for ( CurrPtr = StartPtr
+      ; (CurrPtr < EndPtr) && IsValidVariableHeader (CurrPtr)
+      ; CurrPtr = GetNextVariablePtr (CurrPtr, AuthFlag)
+      ) {
+    if (CurrPtr->State == VAR_ADDED) {
+      Entries[Entry].Offset = (UINT32) ((UINTN) CurrPtr - (UINTN) VariableStoreHeader);
+      Entry++;
+    }
+  }
+
+  //
+  // Link the entries in reverse, so that each chain is in store order and the
+  // first matching variable is found, as with a linear walk.
+  //
+  while (Entry > 0) {
+    CurrPtr = (AUTHENTICATED_VARIABLE_HEADER *) ((UINT8 *) VariableStoreHeader + Entries[Entry - 1].Offset);
+    Bucket  = HashVariable (
+                GetVariableNamePtr (CurrPtr, AuthFlag),
+                NameSizeOfVariable (CurrPtr, AuthFlag),
+                GetVendorGuidPtr (CurrPtr, AuthFlag)
+                ) & (BucketCount - 1);
+    Entries[Entry - 1].Next = Buckets[Bucket];
+    Buckets[Bucket]         = Entry;
+    Entry--;
+  }
+
+  return VariableIndex;
+}
+
 /**
   Find variable from default variable HOB.
 
@@ -430,6 +586,11 @@ FindVariableFromHob (
   AUTHENTICATED_VARIABLE_HEADER *EndPtr;
   AUTHENTICATED_VARIABLE_HEADER *CurrPtr;
   VOID                          *Point;
+  VARIABLE_INDEX_HEADER         *VariableIndex;
+  UINT32                        *Buckets;
+  VARIABLE_INDEX_ENTRY          *Entries;
+  UINT32                        Entry;
+  UINTN                         NameSize;
 
   VariableStoreHeader = NULL;
 
@@ -449,6 +610,24 @@ FindVariableFromHob (
     return NULL;
   }
 
+  VariableIndex = GetVariableIndex (GuidHob, VariableStoreHeader, *AuthFlag);
+  if (VariableIndex != NULL) {
+    Buckets  = (UINT32 *) (VariableIndex + 1);
+    Entries  = (VARIABLE_INDEX_ENTRY *) (Buckets + VariableIndex->BucketCount);
+    NameSize = StrSize (VariableName);
+    Entry    = Buckets[HashVariable (VariableName, NameSize, VendorGuid) & (VariableIndex->BucketCount - 1)];
+    while (Entry != 0) {
+      CurrPtr = (AUTHENTICATED_VARIABLE_HEADER *) ((UINT8 *) VariableStoreHeader + Entries[Entry - 1].Offset);
+      if ((NameSizeOfVariable (CurrPtr, *AuthFlag) == NameSize) &&
+          CompareGuid (VendorGuid, GetVendorGuidPtr (CurrPtr, *AuthFlag)) &&
+          (CompareMem (VariableName, GetVariableNamePtr (CurrPtr, *AuthFlag), NameSize) == 0)) {
+        return CurrPtr;
+      }
+      Entry = Entries[Entry - 1].Next;
+    }
+    return NULL;
+  }
+
   StartPtr = GetStartPointer (VariableStoreHeader);
   EndPtr   = GetEndPointer (VariableStoreHeader);
   for ( CurrPtr = StartPtr
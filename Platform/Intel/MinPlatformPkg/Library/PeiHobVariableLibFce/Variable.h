@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 extern EFI_GUID gEfiVariableGuid;
 extern EFI_GUID gEfiAuthenticatedVariableGuid;
+extern EFI_GUID gHobVariableIndexGuid;
 
 ///
 /// Alignment of variable name and data, according to the architecture:
@@ -169,4 +170,44 @@ typedef struct {
 
 #pragma pack()
 
+///
+/// Hash index of the default variable HOB, built on the first lookup and
+/// published as a GUID HOB so that later lookups, including those made from
+/// later phases, don't need to walk the whole variable store.
+///
+/// The index HOB data starts with VARIABLE_INDEX_HEADER, followed by BucketCount
+/// UINT32 bucket heads and EntryCount VARIABLE_INDEX_ENTRY entries. A bucket head
+/// or Next value is the entry index plus one, with 0 terminating the chain.
+/// Offsets are relative to the variable store header, so the index stays valid
+/// when the HOB list is migrated to permanent memory.
+///
+typedef struct {
+  ///
+  /// Name of the GUID HOB holding the variable store that is indexed.
+  ///
+  EFI_GUID    StoreGuid;
+  ///
+  /// Size of the variable store that is indexed.
+  ///
+  UINT32      StoreSize;
+  ///
+  /// Number of hash buckets, a power of two. 0 if the store is too large to index.
+  ///
+  UINT32      BucketCount;
+  UINT32      EntryCount;
+} VARIABLE_INDEX_HEADER;
+
+typedef struct {
+  ///
+  /// Offset of the variable header from the start of the variable store.
+  ///
+  UINT32      Offset;
+  UINT32      Next;
+} VARIABLE_INDEX_ENTRY;
+
+///
+/// Largest data size of a GUID HOB.
+///
+#define MAX_VARIABLE_INDEX_SIZE   (0xFFF8 - sizeof (EFI_HOB_GUID_TYPE))
+
 #endif
@@ -19,6 +19,87 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/PeiServicesLib.h>
 #include <Guid/SmramMemoryReserve.h>
 
+//
+// The memory ranges of each MTRR setting are collected first and handed to
+// MtrrLib in one call. MtrrLib then solves for the MTRRs of all ranges at once,
+// instead of growing the solution range by range, which needs fewer variable
+// MTRRs for fragmented memory maps.
+//
+#define MAX_CACHE_MTRR_RANGES        8
+#define CACHE_MTRR_SCRATCH_SIZE      SIZE_16KB
+
+/**
+  Add a memory range to the list of ranges to program.
+  Later ranges take precedence over earlier ranges they overlap.
+
+  @param[in, out] Ranges        The list of memory ranges.
+  @param[in, out] RangeCount    The number of memory ranges in the list.
+  @param[in]      BaseAddress   The base address of the memory range.
+  @param[in]      Length        The length of the memory range.
+  @param[in]      Type          The cache type of the memory range.
+**/
+STATIC
+VOID
+AddCacheMtrrRange (
+  IN OUT MTRR_MEMORY_RANGE      *Ranges,
+  IN OUT UINTN                  *RangeCount,
+  IN     UINT64                 BaseAddress,
+  IN     UINT64                 Length,
+  IN     MTRR_MEMORY_CACHE_TYPE Type
+  )
+{
+  ASSERT (*RangeCount < MAX_CACHE_MTRR_RANGES);
+  if (*RangeCount >= MAX_CACHE_MTRR_RANGES) {
+    return;
+  }
+
+  Ranges[*RangeCount].BaseAddress = BaseAddress;
+  Ranges[*RangeCount].Length      = Length;
+  Ranges[*RangeCount].Type        = Type;
+  (*RangeCount)++;
+}
+
+/**
+  Solve the MTRR settings for all memory ranges and program them with a
+  single cache flush.
+
+  @param[in, out] MtrrSetting   The MTRR settings to update and program.
+  @param[in]      Ranges        The list of memory ranges.
+  @param[in]      RangeCount    The number of memory ranges in the list.
+
+  @retval  EFI_SUCCESS  The MTRRs were programmed.
+  @retval  Others       The memory ranges could not be described by the MTRRs.
+**/
+STATIC
+EFI_STATUS
+ProgramCacheMtrrRanges (
+  IN OUT MTRR_SETTINGS          *MtrrSetting,
+  IN     MTRR_MEMORY_RANGE      *Ranges,
+  IN     UINTN                  RangeCount
+  )
+{
+  EFI_STATUS                  Status;
+  UINT8                       Scratch[CACHE_MTRR_SCRATCH_SIZE];
+  UINTN                       ScratchSize;
+
+  ScratchSize = sizeof (Scratch);
+  Status = MtrrSetMemoryAttributesInMtrrSettings (
+             MtrrSetting,
+             Scratch,
+             &ScratchSize,
+             Ranges,
+             RangeCount
+             );
+  ASSERT_EFI_ERROR (Status);
+
+  ///
+  /// Update MTRR setting from MTRR buffer
+  ///
+  MtrrSetAllMtrrs (MtrrSetting);
+
+  return Status;
+}
+
 /**
   Set Cache Mtrr.
 **/
@@ -38,27 +119,25 @@ SetCacheMtrr (
   EFI_BOOT_MODE               BootMode;
   EFI_RESOURCE_ATTRIBUTE_TYPE ResourceAttribute;
   UINT64                      CacheMemoryLength;
+  MTRR_MEMORY_RANGE           Ranges[MAX_CACHE_MTRR_RANGES];
+  UINTN                       RangeCount;
 
   ///
   /// Reset all MTRR setting.
   ///
   ZeroMem(&MtrrSetting, sizeof(MTRR_SETTINGS));
+  RangeCount = 0;
 
   ///
   /// Cache the Flash area as WP to boost performance
   ///
-  Status = MtrrSetMemoryAttributeInMtrrSettings (
-                &MtrrSetting,
-                (UINTN) PcdGet32 (PcdFlashAreaBaseAddress),
-                (UINTN) PcdGet32 (PcdFlashAreaSize),
-                CacheWriteProtected
-                );
-  ASSERT_EFI_ERROR (Status);
-
-  ///
-  /// Update MTRR setting from MTRR buffer for Flash Region to be WP to boost performance
-  ///
-  MtrrSetAllMtrrs (&MtrrSetting);
+  AddCacheMtrrRange (
+    Ranges,
+    &RangeCount,
+    (UINTN) PcdGet32 (PcdFlashAreaBaseAddress),
+    (UINTN) PcdGet32 (PcdFlashAreaSize),
+    CacheWriteProtected
+    );
 
   ///
   /// Set low to 1 MB. Since 1MB cacheability will always be set
@@ -116,66 +195,33 @@ SetCacheMtrr (
   ///
   if (MemoryLength > 0xDC000000) {
      CacheMemoryLength = 0xC0000000;
-     Status = MtrrSetMemoryAttributeInMtrrSettings (
-                &MtrrSetting,
-                MemoryBase,
-                CacheMemoryLength,
-                CacheWriteBack
-                );
-     ASSERT_EFI_ERROR (Status);
+     AddCacheMtrrRange (Ranges, &RangeCount, MemoryBase, CacheMemoryLength, CacheWriteBack);
 
      MemoryBase = 0xC0000000;
      CacheMemoryLength = MemoryLength - 0xC0000000;
      if (MemoryLength > 0xE0000000) {
         CacheMemoryLength = 0x20000000;
-        Status = MtrrSetMemoryAttributeInMtrrSettings (
-                 &MtrrSetting,
-                 MemoryBase,
-                 CacheMemoryLength,
-                 CacheWriteBack
-                 );
-        ASSERT_EFI_ERROR (Status);
+        AddCacheMtrrRange (Ranges, &RangeCount, MemoryBase, CacheMemoryLength, CacheWriteBack);
 
         MemoryBase = 0xE0000000;
         CacheMemoryLength = MemoryLength - 0xE0000000;
      }
   }
 
-  Status = MtrrSetMemoryAttributeInMtrrSettings (
-                &MtrrSetting,
-                MemoryBase,
-                CacheMemoryLength,
-                CacheWriteBack
-                );
-  ASSERT_EFI_ERROR (Status);
+  AddCacheMtrrRange (Ranges, &RangeCount, MemoryBase, CacheMemoryLength, CacheWriteBack);
 
   if (LowMemoryLength != MemoryLength) {
      MemoryBase = LowMemoryLength;
      MemoryLength -= LowMemoryLength;
-     Status = MtrrSetMemoryAttributeInMtrrSettings (
-                   &MtrrSetting,
-                   MemoryBase,
-                   MemoryLength,
-                   CacheUncacheable
-                   );
-      ASSERT_EFI_ERROR (Status);
+     AddCacheMtrrRange (Ranges, &RangeCount, MemoryBase, MemoryLength, CacheUncacheable);
   }
 
   ///
   /// VGA-MMIO - 0xA0000 to 0xC0000 to be UC
   ///
-  Status = MtrrSetMemoryAttributeInMtrrSettings (
-                &MtrrSetting,
-                0xA0000,
-                0x20000,
-                CacheUncacheable
-                );
-  ASSERT_EFI_ERROR (Status);
+  AddCacheMtrrRange (Ranges, &RangeCount, 0xA0000, 0x20000, CacheUncacheable);
 
-  ///
-  /// Update MTRR setting from MTRR buffer
-  ///
-  MtrrSetAllMtrrs (&MtrrSetting);
+  ProgramCacheMtrrRanges (&MtrrSetting, Ranges, RangeCount);
 
   return ;
 }
@@ -199,12 +245,13 @@ SetCacheMtrrAfterEndOfPei (
   EFI_PEI_HOB_POINTERS                  Hob;
   UINT64                                MemoryBase;
   UINT64                                MemoryLength;
-  UINT64                                Power2Length;
   EFI_BOOT_MODE                         BootMode;
   UINTN                                 Index;
   UINT64                                SmramSize;
   UINT64                                SmramBase;
   EFI_SMRAM_HOB_DESCRIPTOR_BLOCK        *SmramHobDescriptorBlock;
+  MTRR_MEMORY_RANGE                     Ranges[MAX_CACHE_MTRR_RANGES];
+  UINTN                                 RangeCount;
   Status = PeiServicesGetBootMode (&BootMode);
   ASSERT_EFI_ERROR (Status);
 
@@ -221,33 +268,14 @@ SetCacheMtrrAfterEndOfPei (
   //
   MtrrSetting.MtrrDefType &= ~((UINT64)(0xFF));
   MtrrSetting.MtrrDefType |= (UINT64) CacheWriteBack;
+  RangeCount = 0;
 
   //
   // Set fixed cache for memory range below 1MB
   //
-  Status = MtrrSetMemoryAttributeInMtrrSettings (
-                         &MtrrSetting,
-                         0x0,
-                         0xA0000,
-                         CacheWriteBack
-                         );
-  ASSERT_EFI_ERROR (Status);
-
-  Status = MtrrSetMemoryAttributeInMtrrSettings (
-                         &MtrrSetting,
-                         0xA0000,
-                         0x20000,
-                         CacheUncacheable
-                         );
-  ASSERT_EFI_ERROR (Status);
-
-  Status = MtrrSetMemoryAttributeInMtrrSettings (
-                         &MtrrSetting,
-                         0xC0000,
-                         0x40000,
-                         CacheWriteProtected
-                         );
-  ASSERT_EFI_ERROR ( Status);
+  AddCacheMtrrRange (Ranges, &RangeCount, 0x0, 0xA0000, CacheWriteBack);
+  AddCacheMtrrRange (Ranges, &RangeCount, 0xA0000, 0x20000, CacheUncacheable);
+  AddCacheMtrrRange (Ranges, &RangeCount, 0xC0000, 0x40000, CacheWriteProtected);
 
   //
   // PI SMM IPL can't set SMRAM to WB because at that time CPU ARCH protocol is not available.
@@ -280,50 +308,39 @@ SetCacheMtrrAfterEndOfPei (
   MemoryBase   = 0x100000000;
 
   //
-  // Add IED size to set whole SMRAM as WB to save MTRR count
+  // Add IED size to set whole SMRAM as WB to save MTRR count.
+  // MtrrLib splits the range into the fewest MTRRs itself.
   //
   MemoryLength = MemoryBase - (SmramBase + SmramSize);
-  while (MemoryLength != 0) {
-    Power2Length = GetPowerOfTwo64 (MemoryLength);
-    MemoryBase -= Power2Length;
-    Status = MtrrSetMemoryAttributeInMtrrSettings (
-                &MtrrSetting,
-                MemoryBase,
-                Power2Length,
-                CacheUncacheable
-                );
-    ASSERT_EFI_ERROR (Status);
-    MemoryLength -= Power2Length;
+  if (MemoryLength != 0) {
+    AddCacheMtrrRange (Ranges, &RangeCount, SmramBase + SmramSize, MemoryLength, CacheUncacheable);
   }
 
   DEBUG ((DEBUG_INFO, "PcdPciReservedMemAbove4GBLimit - 0x%lx\n", PcdGet64 (PcdPciReservedMemAbove4GBLimit)));
   DEBUG ((DEBUG_INFO, "PcdPciReservedMemAbove4GBBase - 0x%lx\n", PcdGet64 (PcdPciReservedMemAbove4GBBase)));
   if (PcdGet64 (PcdPciReservedMemAbove4GBLimit) > PcdGet64 (PcdPciReservedMemAbove4GBBase)) {
-    Status = MtrrSetMemoryAttributeInMtrrSettings (
-                           &MtrrSetting,
-                           PcdGet64 (PcdPciReservedMemAbove4GBBase),
-                           PcdGet64 (PcdPciReservedMemAbove4GBLimit) - PcdGet64 (PcdPciReservedMemAbove4GBBase) + 1,
-                           CacheUncacheable
-                           );
-    ASSERT_EFI_ERROR ( Status);
+    AddCacheMtrrRange (
+      Ranges,
+      &RangeCount,
+      PcdGet64 (PcdPciReservedMemAbove4GBBase),
+      PcdGet64 (PcdPciReservedMemAbove4GBLimit) - PcdGet64 (PcdPciReservedMemAbove4GBBase) + 1,
+      CacheUncacheable
+      );
   }
 
   DEBUG ((DEBUG_INFO, "PcdPciReservedPMemAbove4GBLimit - 0x%lx\n", PcdGet64 (PcdPciReservedPMemAbove4GBLimit)));
   DEBUG ((DEBUG_INFO, "PcdPciReservedPMemAbove4GBBase - 0x%lx\n", PcdGet64 (PcdPciReservedPMemAbove4GBBase)));
   if (PcdGet64 (PcdPciReservedPMemAbove4GBLimit) > PcdGet64 (PcdPciReservedPMemAbove4GBBase)) {
-    Status = MtrrSetMemoryAttributeInMtrrSettings (
-                           &MtrrSetting,
-                           PcdGet64 (PcdPciReservedPMemAbove4GBBase),
-                           PcdGet64 (PcdPciReservedPMemAbove4GBLimit) - PcdGet64 (PcdPciReservedPMemAbove4GBBase) + 1,
-                           CacheUncacheable
-                           );
-    ASSERT_EFI_ERROR ( Status);
+    AddCacheMtrrRange (
+      Ranges,
+      &RangeCount,
+      PcdGet64 (PcdPciReservedPMemAbove4GBBase),
+      PcdGet64 (PcdPciReservedPMemAbove4GBLimit) - PcdGet64 (PcdPciReservedPMemAbove4GBBase) + 1,
+      CacheUncacheable
+      );
   }
 
-  //
-  // Update MTRR setting from MTRR buffer
-  //
-  MtrrSetAllMtrrs (&MtrrSetting);
+  Status = ProgramCacheMtrrRanges (&MtrrSetting, Ranges, RangeCount);
 
   return Status;
 }
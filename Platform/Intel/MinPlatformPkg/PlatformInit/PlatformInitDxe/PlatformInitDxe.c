@@ -154,6 +154,8 @@ OnReadyToBootLater (
   TestPointReadyToBootTcgTrustedBootEnabled ();
   TestPointReadyToBootTcgMorEnabled ();
   TestPointReadyToBootEsrtTableFunctional ();
+
+  TestPointReadyToBootDeferredChecks ();
 }
 
 /**
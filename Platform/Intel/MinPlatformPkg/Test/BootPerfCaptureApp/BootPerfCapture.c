@@ -0,0 +1,339 @@
+/** @file
+  Shell application to capture the boot performance of the current boot, and
+  to compare captures taken on different boards or firmware releases.
+
+  BootPerfCaptureApp [-o File]
+    Print the current boot as CSV, and optionally save it to File.
+  BootPerfCaptureApp -i File
+    Print a saved capture as CSV.
+  BootPerfCaptureApp -c BaseFile NewFile [Percent]
+    Report every item that got slower than Percent (10 by default). Returns
+    EFI_ABORTED if anything regressed, so that scripts can check lasterror.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Guid/ZeroGuid.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BootPerfCaptureLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Protocol/Shell.h>
+#include <Protocol/ShellParameters.h>
+
+#define BOOT_PERF_DEFAULT_THRESHOLD  10
+
+//
+// Items shorter than this in both captures are noise, don't compare them.
+//
+#define BOOT_PERF_COMPARE_FLOOR_NS   1000000
+
+EFI_SHELL_PROTOCOL  *mShell;
+
+VOID
+PrintUsage (
+  VOID
+  )
+{
+  Print (L"BootPerfCaptureApp [-o File]\n");
+  Print (L"BootPerfCaptureApp -i File\n");
+  Print (L"BootPerfCaptureApp -c BaseFile NewFile [Percent]\n");
+}
+
+VOID
+PrintCapture (
+  IN CONST BOOT_PERF_CAPTURE  *Capture
+  )
+{
+  CONST BOOT_PERF_CAPTURE_ENTRY  *Entries;
+  UINTN                          Index;
+
+  Print (L"Type,Guid,Name,Count,DurationUs\n");
+  Print (L"Boot,%g,ResetEnd,1,%ld\n", &gZeroGuid, DivU64x32 (Capture->ResetEnd, 1000));
+  Print (L"Boot,%g,OsLoaderLoadImageStart,1,%ld\n", &gZeroGuid, DivU64x32 (Capture->OsLoaderLoadImageStart, 1000));
+  Print (L"Boot,%g,OsLoaderStartImageStart,1,%ld\n", &gZeroGuid, DivU64x32 (Capture->OsLoaderStartImageStart, 1000));
+
+  Entries = (CONST BOOT_PERF_CAPTURE_ENTRY *)(Capture + 1);
+  for (Index = 0; Index < Capture->EntryCount; Index++) {
+    Print (
+      L"%a,%g,%a,%d,%ld\n",
+      BootPerfCaptureEntryType (&Entries[Index]),
+      &Entries[Index].Guid,
+      Entries[Index].Name,
+      Entries[Index].Count,
+      DivU64x32 (Entries[Index].Duration, 1000)
+      );
+  }
+}
+
+EFI_STATUS
+SaveCapture (
+  IN CONST CHAR16             *FileName,
+  IN CONST BOOT_PERF_CAPTURE  *Capture
+  )
+{
+  EFI_STATUS         Status;
+  SHELL_FILE_HANDLE  FileHandle;
+  UINTN              Size;
+
+  mShell->DeleteFileByName (FileName);
+  Status = mShell->CreateFile (FileName, 0, &FileHandle);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Size   = BootPerfCaptureSize (Capture);
+  Status = mShell->WriteFile (FileHandle, &Size, (VOID *)Capture);
+  mShell->CloseFile (FileHandle);
+  return Status;
+}
+
+EFI_STATUS
+LoadCapture (
+  IN  CONST CHAR16       *FileName,
+  OUT BOOT_PERF_CAPTURE  **Capture
+  )
+{
+  EFI_STATUS         Status;
+  SHELL_FILE_HANDLE  FileHandle;
+  UINT64             FileSize;
+  UINTN              Size;
+  VOID               *Buffer;
+
+  Status = mShell->OpenFileByName (FileName, &FileHandle, EFI_FILE_MODE_READ);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Buffer = NULL;
+  Size   = 0;
+  Status = mShell->GetFileSize (FileHandle, &FileSize);
+  if (!EFI_ERROR (Status)) {
+    Size   = (UINTN)FileSize;
+    Buffer = AllocatePool (Size);
+    if (Buffer == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+    } else {
+      Status = mShell->ReadFile (FileHandle, &Size, Buffer);
+    }
+  }
+
+  mShell->CloseFile (FileHandle);
+
+  if (!EFI_ERROR (Status) && !BootPerfCaptureIsValid (Buffer, Size)) {
+    Status = EFI_VOLUME_CORRUPTED;
+  }
+
+  if (EFI_ERROR (Status)) {
+    if (Buffer != NULL) {
+      FreePool (Buffer);
+    }
+
+    return Status;
+  }
+
+  *Capture = Buffer;
+  return EFI_SUCCESS;
+}
+
+/**
+  Check whether a duration regressed over the threshold.
+
+  @param[in] Base       Duration in the base capture, in nanoseconds.
+  @param[in] New        Duration in the new capture, in nanoseconds.
+  @param[in] Threshold  Allowed increase, in percent.
+
+  @return TRUE if the new duration is a regression.
+**/
+BOOLEAN
+IsRegression (
+  IN UINT64  Base,
+  IN UINT64  New,
+  IN UINTN   Threshold
+  )
+{
+  if ((New < BOOT_PERF_COMPARE_FLOOR_NS) || (New <= Base)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)(MultU64x32 (New - Base, 100) > MultU64x32 (Base, (UINT32)Threshold));
+}
+
+/**
+  Compare two captures, and print every item that regressed.
+
+  @param[in] Base       The base capture.
+  @param[in] New        The new capture.
+  @param[in] Threshold  Allowed increase, in percent.
+
+  @return The number of regressions.
+**/
+UINTN
+CompareCaptures (
+  IN CONST BOOT_PERF_CAPTURE  *Base,
+  IN CONST BOOT_PERF_CAPTURE  *New,
+  IN UINTN                    Threshold
+  )
+{
+  CONST BOOT_PERF_CAPTURE_ENTRY  *Entries;
+  CONST BOOT_PERF_CAPTURE_ENTRY  *BaseEntry;
+  UINTN                          Index;
+  UINTN                          Regressions;
+
+  Regressions = 0;
+  Print (L"Status,Type,Guid,Name,BaseUs,NewUs\n");
+
+  if (IsRegression (Base->OsLoaderStartImageStart, New->OsLoaderStartImageStart, Threshold)) {
+    Print (
+      L"Regressed,Boot,%g,OsLoaderStartImageStart,%ld,%ld\n",
+      &gZeroGuid,
+      DivU64x32 (Base->OsLoaderStartImageStart, 1000),
+      DivU64x32 (New->OsLoaderStartImageStart, 1000)
+      );
+    Regressions++;
+  }
+
+  Entries = (CONST BOOT_PERF_CAPTURE_ENTRY *)(New + 1);
+  for (Index = 0; Index < New->EntryCount; Index++) {
+    BaseEntry = BootPerfCaptureFindEntry (Base, &Entries[Index]);
+    if (BaseEntry == NULL) {
+      if (Entries[Index].Duration >= BOOT_PERF_COMPARE_FLOOR_NS) {
+        Print (
+          L"Added,%a,%g,%a,0,%ld\n",
+          BootPerfCaptureEntryType (&Entries[Index]),
+          &Entries[Index].Guid,
+          Entries[Index].Name,
+          DivU64x32 (Entries[Index].Duration, 1000)
+          );
+      }
+
+      continue;
+    }
+
+    if (IsRegression (BaseEntry->Duration, Entries[Index].Duration, Threshold)) {
+      Print (
+        L"Regressed,%a,%g,%a,%ld,%ld\n",
+        BootPerfCaptureEntryType (&Entries[Index]),
+        &Entries[Index].Guid,
+        Entries[Index].Name,
+        DivU64x32 (BaseEntry->Duration, 1000),
+        DivU64x32 (Entries[Index].Duration, 1000)
+        );
+      Regressions++;
+    }
+  }
+
+  Entries = (CONST BOOT_PERF_CAPTURE_ENTRY *)(Base + 1);
+  for (Index = 0; Index < Base->EntryCount; Index++) {
+    if ((Entries[Index].Duration >= BOOT_PERF_COMPARE_FLOOR_NS) &&
+        (BootPerfCaptureFindEntry (New, &Entries[Index]) == NULL))
+    {
+      Print (
+        L"Removed,%a,%g,%a,%ld,0\n",
+        BootPerfCaptureEntryType (&Entries[Index]),
+        &Entries[Index].Guid,
+        Entries[Index].Name,
+        DivU64x32 (Entries[Index].Duration, 1000)
+        );
+    }
+  }
+
+  Print (L"%d regression(s) over %d%%\n", Regressions, Threshold);
+  return Regressions;
+}
+
+EFI_STATUS
+EFIAPI
+BootPerfCaptureAppEntrypoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_SHELL_PARAMETERS_PROTOCOL  *ShellParameters;
+  BOOT_PERF_CAPTURE              *Capture;
+  BOOT_PERF_CAPTURE              *BaseCapture;
+  UINTN                          Argc;
+  CHAR16                         **Argv;
+  UINTN                          Threshold;
+
+  Status = gBS->HandleProtocol (ImageHandle, &gEfiShellParametersProtocolGuid, (VOID **)&ShellParameters);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->LocateProtocol (&gEfiShellProtocolGuid, NULL, (VOID **)&mShell);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Argc = ShellParameters->Argc;
+  Argv = ShellParameters->Argv;
+
+  if ((Argc == 1) || ((Argc == 3) && (StrCmp (Argv[1], L"-o") == 0))) {
+    Status = BootPerfCaptureCollect (&Capture);
+    if (EFI_ERROR (Status)) {
+      Print (L"No boot performance data - %r\n", Status);
+      return Status;
+    }
+
+    PrintCapture (Capture);
+    if (Argc == 3) {
+      Status = SaveCapture (Argv[2], Capture);
+      if (EFI_ERROR (Status)) {
+        Print (L"Can't save %s - %r\n", Argv[2], Status);
+      }
+    }
+
+    FreePool (Capture);
+    return Status;
+  }
+
+  if ((Argc == 3) && (StrCmp (Argv[1], L"-i") == 0)) {
+    Status = LoadCapture (Argv[2], &Capture);
+    if (EFI_ERROR (Status)) {
+      Print (L"Can't load %s - %r\n", Argv[2], Status);
+      return Status;
+    }
+
+    PrintCapture (Capture);
+    FreePool (Capture);
+    return EFI_SUCCESS;
+  }
+
+  if (((Argc == 4) || (Argc == 5)) && (StrCmp (Argv[1], L"-c") == 0)) {
+    Threshold = BOOT_PERF_DEFAULT_THRESHOLD;
+    if (Argc == 5) {
+      Threshold = StrDecimalToUintn (Argv[4]);
+    }
+
+    Status = LoadCapture (Argv[2], &BaseCapture);
+    if (EFI_ERROR (Status)) {
+      Print (L"Can't load %s - %r\n", Argv[2], Status);
+      return Status;
+    }
+
+    Status = LoadCapture (Argv[3], &Capture);
+    if (EFI_ERROR (Status)) {
+      Print (L"Can't load %s - %r\n", Argv[3], Status);
+      FreePool (BaseCapture);
+      return Status;
+    }
+
+    if (CompareCaptures (BaseCapture, Capture, Threshold) != 0) {
+      Status = EFI_ABORTED;
+    }
+
+    FreePool (BaseCapture);
+    FreePool (Capture);
+    return Status;
+  }
+
+  PrintUsage ();
+  return EFI_INVALID_PARAMETER;
+}
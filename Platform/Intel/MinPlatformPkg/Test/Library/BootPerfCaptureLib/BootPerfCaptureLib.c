@@ -0,0 +1,600 @@
+/** @file
+  Collect the boot performance records published through the FPDT.
+
+  The firmware basic boot performance table (FBPT) is followed by the
+  extended records logged by the core performance libraries. Each start
+  record is paired with its end record, and the time spent between them is
+  summed up per boot phase, module and measurement.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <IndustryStandard/Acpi.h>
+#include <Guid/ExtendedFirmwarePerformance.h>
+#include <Guid/FirmwarePerformance.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BootPerfCaptureLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiLib.h>
+
+typedef struct {
+  UINT16            ProgressId;
+  UINT64            Timestamp;
+  CONST EFI_GUID    *Guid;
+  UINT64            Qword;
+  CONST CHAR8       *Name;
+  UINTN             NameLength;
+  BOOLEAN           Paired;
+} BOOT_PERF_RECORD;
+
+/**
+  Check whether a ProgressID starts a measurement.
+  Below 0x10, start IDs are odd and end IDs even. From 0x10 on, it's the other
+  way around. ID 0 is a standalone event.
+
+  @param[in] ProgressId   The ProgressID of a record.
+
+  @return TRUE if the record starts a measurement.
+**/
+STATIC
+BOOLEAN
+IsStartProgressId (
+  IN UINT16  ProgressId
+  )
+{
+  if (ProgressId < PERF_EVENTSIGNAL_START_ID) {
+    return (BOOLEAN)((ProgressId & 1) != 0);
+  }
+
+  return (BOOLEAN)((ProgressId & 1) == 0);
+}
+
+/**
+  Check whether a ProgressID ends a measurement.
+
+  @param[in] ProgressId   The ProgressID of a record.
+
+  @return TRUE if the record ends a measurement.
+**/
+STATIC
+BOOLEAN
+IsEndProgressId (
+  IN UINT16  ProgressId
+  )
+{
+  return (BOOLEAN)((ProgressId != PERF_EVENT_ID) && !IsStartProgressId (ProgressId));
+}
+
+/**
+  Check whether a ProgressID starts a driver binding measurement, whose end
+  record is named after the controller rather than the driver.
+
+  @param[in] ProgressId   The ProgressID of a start record.
+
+  @return TRUE if the record starts a driver binding measurement.
+**/
+STATIC
+BOOLEAN
+IsDriverBindingProgressId (
+  IN UINT16  ProgressId
+  )
+{
+  return (BOOLEAN)((ProgressId == MODULE_DB_START_ID) ||
+                   (ProgressId == MODULE_DB_SUPPORT_START_ID) ||
+                   (ProgressId == MODULE_DB_STOP_START_ID));
+}
+
+/**
+  Decode the fields of an extended FPDT record that matter for pairing.
+
+  @param[in]  Header    The record.
+  @param[out] Record    The decoded record.
+
+  @retval TRUE   The record was decoded.
+  @retval FALSE  The record isn't a known extended record.
+**/
+STATIC
+BOOLEAN
+DecodeRecord (
+  IN  CONST EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *Header,
+  OUT BOOT_PERF_RECORD                                   *Record
+  )
+{
+  CONST FPDT_GUID_EVENT_RECORD               *GuidEvent;
+  CONST FPDT_DYNAMIC_STRING_EVENT_RECORD     *StringEvent;
+  CONST FPDT_DUAL_GUID_STRING_EVENT_RECORD   *DualGuidEvent;
+  CONST FPDT_GUID_QWORD_EVENT_RECORD         *QwordEvent;
+  CONST FPDT_GUID_QWORD_STRING_EVENT_RECORD  *QwordStringEvent;
+  UINTN                                      StringOffset;
+
+  //
+  // Every extended record starts like FPDT_GUID_EVENT_RECORD.
+  //
+  if (Header->Length < sizeof (FPDT_GUID_EVENT_RECORD)) {
+    return FALSE;
+  }
+
+  ZeroMem (Record, sizeof (*Record));
+  GuidEvent          = (CONST FPDT_GUID_EVENT_RECORD *)Header;
+  Record->ProgressId = GuidEvent->ProgressID;
+  Record->Timestamp  = GuidEvent->Timestamp;
+  Record->Guid       = &GuidEvent->Guid;
+  StringOffset       = 0;
+
+  switch (Header->Type) {
+    case FPDT_GUID_EVENT_TYPE:
+      break;
+
+    case FPDT_DYNAMIC_STRING_EVENT_TYPE:
+      StringEvent  = (CONST FPDT_DYNAMIC_STRING_EVENT_RECORD *)Header;
+      Record->Name = StringEvent->String;
+      StringOffset = OFFSET_OF (FPDT_DYNAMIC_STRING_EVENT_RECORD, String);
+      break;
+
+    case FPDT_DUAL_GUID_STRING_EVENT_TYPE:
+      if (Header->Length < sizeof (FPDT_DUAL_GUID_STRING_EVENT_RECORD)) {
+        return FALSE;
+      }
+
+      DualGuidEvent = (CONST FPDT_DUAL_GUID_STRING_EVENT_RECORD *)Header;
+      Record->Guid  = &DualGuidEvent->Guid1;
+      Record->Name  = DualGuidEvent->String;
+      StringOffset  = OFFSET_OF (FPDT_DUAL_GUID_STRING_EVENT_RECORD, String);
+      break;
+
+    case FPDT_GUID_QWORD_EVENT_TYPE:
+      if (Header->Length < sizeof (FPDT_GUID_QWORD_EVENT_RECORD)) {
+        return FALSE;
+      }
+
+      QwordEvent    = (CONST FPDT_GUID_QWORD_EVENT_RECORD *)Header;
+      Record->Qword = QwordEvent->Qword;
+      break;
+
+    case FPDT_GUID_QWORD_STRING_EVENT_TYPE:
+      if (Header->Length < sizeof (FPDT_GUID_QWORD_STRING_EVENT_RECORD)) {
+        return FALSE;
+      }
+
+      QwordStringEvent = (CONST FPDT_GUID_QWORD_STRING_EVENT_RECORD *)Header;
+      Record->Qword    = QwordStringEvent->Qword;
+      Record->Name     = QwordStringEvent->String;
+      StringOffset     = OFFSET_OF (FPDT_GUID_QWORD_STRING_EVENT_RECORD, String);
+      break;
+
+    default:
+      return FALSE;
+  }
+
+  if (Record->Name != NULL) {
+    if (Header->Length <= StringOffset) {
+      Record->Name = NULL;
+    } else {
+      Record->NameLength = AsciiStrnLenS (Record->Name, Header->Length - StringOffset);
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Compare the names of two records.
+
+  @param[in] Record1    The first record.
+  @param[in] Record2    The second record.
+
+  @return TRUE if both records have the same name.
+**/
+STATIC
+BOOLEAN
+RecordNamesMatch (
+  IN CONST BOOT_PERF_RECORD  *Record1,
+  IN CONST BOOT_PERF_RECORD  *Record2
+  )
+{
+  if (Record1->NameLength != Record2->NameLength) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)((Record1->NameLength == 0) ||
+                   (CompareMem (Record1->Name, Record2->Name, Record1->NameLength) == 0));
+}
+
+/**
+  Check whether an end record closes a start record.
+
+  @param[in] Start    The start record.
+  @param[in] End      The end record.
+
+  @return TRUE if the records form a pair.
+**/
+STATIC
+BOOLEAN
+RecordsArePair (
+  IN CONST BOOT_PERF_RECORD  *Start,
+  IN CONST BOOT_PERF_RECORD  *End
+  )
+{
+  if (Start->Paired || (Start->ProgressId + 1 != End->ProgressId)) {
+    return FALSE;
+  }
+
+  //
+  // Boot phases begin in one module and end in another one.
+  //
+  if (Start->ProgressId == PERF_CROSSMODULE_START_ID) {
+    return RecordNamesMatch (Start, End);
+  }
+
+  //
+  // LoadImage() is logged before the image has a GUID, driver binding calls
+  // carry the controller handle. Both are identified by their Qword.
+  //
+  if ((Start->Qword != 0) || (End->Qword != 0)) {
+    return (BOOLEAN)((Start->Qword == End->Qword) &&
+                     (IsZeroGuid (Start->Guid) || CompareGuid (Start->Guid, End->Guid)));
+  }
+
+  if (!CompareGuid (Start->Guid, End->Guid)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)((Start->NameLength == 0) || RecordNamesMatch (Start, End));
+}
+
+/**
+  Add the duration of a measurement to the capture.
+
+  @param[in, out] Capture     The capture.
+  @param[in]      MaxEntries  The number of entries the capture has room for.
+  @param[in]      Start       The start record, or NULL if the measurement
+                              began at reset.
+  @param[in]      End         The end record.
+**/
+STATIC
+VOID
+AddMeasurement (
+  IN OUT BOOT_PERF_CAPTURE       *Capture,
+  IN     UINTN                   MaxEntries,
+  IN     CONST BOOT_PERF_RECORD  *Start OPTIONAL,
+  IN     CONST BOOT_PERF_RECORD  *End
+  )
+{
+  BOOT_PERF_CAPTURE_ENTRY  Key;
+  BOOT_PERF_CAPTURE_ENTRY  *Entry;
+  CONST BOOT_PERF_RECORD   *Named;
+  CONST EFI_GUID           *Guid;
+  UINT64                   StartTime;
+
+  ZeroMem (&Key, sizeof (Key));
+  Key.ProgressId = (UINT16)(End->ProgressId - 1);
+  StartTime      = 0;
+  Guid           = End->Guid;
+  Named          = End;
+
+  if (Start != NULL) {
+    StartTime = Start->Timestamp;
+    if (!IsZeroGuid (Start->Guid)) {
+      Guid = Start->Guid;
+    }
+
+    if ((Start->NameLength != 0) || IsDriverBindingProgressId (Start->ProgressId)) {
+      Named = Start;
+    }
+  }
+
+  //
+  // Phases are compared by name only, so don't tie them to a module.
+  //
+  if (Key.ProgressId != PERF_CROSSMODULE_START_ID) {
+    CopyGuid (&Key.Guid, Guid);
+  }
+
+  CopyMem (Key.Name, Named->Name, MIN (Named->NameLength, sizeof (Key.Name) - 1));
+
+  Entry = (BOOT_PERF_CAPTURE_ENTRY *)BootPerfCaptureFindEntry (Capture, &Key);
+  if (Entry == NULL) {
+    if (Capture->EntryCount == MaxEntries) {
+      ASSERT (FALSE);
+      return;
+    }
+
+    Entry = (BOOT_PERF_CAPTURE_ENTRY *)(Capture + 1) + Capture->EntryCount++;
+    CopyMem (Entry, &Key, sizeof (Key));
+  }
+
+  if (End->Timestamp >= StartTime) {
+    Entry->Duration += End->Timestamp - StartTime;
+  }
+
+  Entry->Count++;
+}
+
+/**
+  Locate the firmware basic boot performance table through the FPDT.
+
+  @return The boot performance table, or NULL if there is none.
+**/
+STATIC
+BOOT_PERFORMANCE_TABLE *
+LocateBootPerformanceTable (
+  VOID
+  )
+{
+  EFI_ACPI_DESCRIPTION_HEADER                  *Fpdt;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *Header;
+  EFI_ACPI_5_0_FPDT_BOOT_TABLE_POINTER_RECORD  *Pointer;
+  BOOT_PERFORMANCE_TABLE                       *Fbpt;
+  UINTN                                        Offset;
+
+  Fpdt = (EFI_ACPI_DESCRIPTION_HEADER *)EfiLocateFirstAcpiTable (EFI_ACPI_5_0_FIRMWARE_PERFORMANCE_DATA_TABLE_SIGNATURE);
+  if (Fpdt == NULL) {
+    return NULL;
+  }
+
+  for (Offset = sizeof (*Fpdt); Offset + sizeof (*Header) <= Fpdt->Length; Offset += Header->Length) {
+    Header = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *)((UINT8 *)Fpdt + Offset);
+    if (Header->Length == 0) {
+      break;
+    }
+
+    if ((Header->Type == EFI_ACPI_5_0_FPDT_RECORD_TYPE_FIRMWARE_BASIC_BOOT_POINTER) &&
+        (Header->Length >= sizeof (*Pointer)))
+    {
+      Pointer = (EFI_ACPI_5_0_FPDT_BOOT_TABLE_POINTER_RECORD *)Header;
+      Fbpt    = (BOOT_PERFORMANCE_TABLE *)(UINTN)Pointer->BootPerformanceTablePointer;
+      if ((Fbpt == NULL) ||
+          (Fbpt->Header.Signature != EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_SIGNATURE) ||
+          (Fbpt->Header.Length < sizeof (*Fbpt)))
+      {
+        return NULL;
+      }
+
+      return Fbpt;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Collect the boot performance records of the current boot.
+
+  @param[out] Capture   The capture, allocated from pool. The caller frees it.
+
+  @retval EFI_SUCCESS           The capture was taken.
+  @retval EFI_NOT_FOUND         There is no FPDT or no boot performance table.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory for the capture.
+**/
+EFI_STATUS
+EFIAPI
+BootPerfCaptureCollect (
+  OUT BOOT_PERF_CAPTURE  **Capture
+  )
+{
+  BOOT_PERFORMANCE_TABLE                       *Fbpt;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *Header;
+  BOOT_PERF_CAPTURE                            *NewCapture;
+  BOOT_PERF_RECORD                             *Starts;
+  BOOT_PERF_RECORD                             Record;
+  UINTN                                        StartCount;
+  UINTN                                        RecordCount;
+  UINTN                                        Offset;
+  UINTN                                        Index;
+
+  Fbpt = LocateBootPerformanceTable ();
+  if (Fbpt == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // Records vary in size, count them to size the buffers.
+  //
+  RecordCount = 0;
+  for (Offset = sizeof (*Fbpt); Offset + sizeof (*Header) <= Fbpt->Header.Length; Offset += Header->Length) {
+    Header = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *)((UINT8 *)Fbpt + Offset);
+    if (Header->Length == 0) {
+      break;
+    }
+
+    RecordCount++;
+  }
+
+  NewCapture = AllocateZeroPool (sizeof (*NewCapture) + RecordCount * sizeof (BOOT_PERF_CAPTURE_ENTRY));
+  Starts     = AllocatePool (RecordCount * sizeof (*Starts));
+  if ((NewCapture == NULL) || (Starts == NULL)) {
+    if (NewCapture != NULL) {
+      FreePool (NewCapture);
+    }
+
+    if (Starts != NULL) {
+      FreePool (Starts);
+    }
+
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewCapture->Signature               = BOOT_PERF_CAPTURE_SIGNATURE;
+  NewCapture->Version                 = BOOT_PERF_CAPTURE_VERSION;
+  NewCapture->ResetEnd                = Fbpt->BasicBoot.ResetEnd;
+  NewCapture->OsLoaderLoadImageStart  = Fbpt->BasicBoot.OsLoaderLoadImageStart;
+  NewCapture->OsLoaderStartImageStart = Fbpt->BasicBoot.OsLoaderStartImageStart;
+
+  StartCount = 0;
+  for (Offset = sizeof (*Fbpt); Offset + sizeof (*Header) <= Fbpt->Header.Length; Offset += Header->Length) {
+    Header = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *)((UINT8 *)Fbpt + Offset);
+    if (Header->Length == 0) {
+      break;
+    }
+
+    if ((Offset + Header->Length > Fbpt->Header.Length) || !DecodeRecord (Header, &Record)) {
+      continue;
+    }
+
+    if (IsStartProgressId (Record.ProgressId)) {
+      CopyMem (&Starts[StartCount++], &Record, sizeof (Record));
+      continue;
+    }
+
+    if (!IsEndProgressId (Record.ProgressId)) {
+      continue;
+    }
+
+    //
+    // Measurements nest, so the latest pending start is the right one.
+    //
+    for (Index = StartCount; Index > 0; Index--) {
+      if (RecordsArePair (&Starts[Index - 1], &Record)) {
+        break;
+      }
+    }
+
+    if (Index > 0) {
+      Starts[Index - 1].Paired = TRUE;
+      AddMeasurement (NewCapture, RecordCount, &Starts[Index - 1], &Record);
+    } else if (Record.ProgressId == PERF_CROSSMODULE_END_ID) {
+      //
+      // SEC doesn't log its own start, it begins at reset.
+      //
+      AddMeasurement (NewCapture, RecordCount, NULL, &Record);
+    }
+  }
+
+  FreePool (Starts);
+
+  DEBUG ((DEBUG_INFO, "BootPerfCapture: %d records, %d entries\n", RecordCount, NewCapture->EntryCount));
+
+  *Capture = NewCapture;
+  return EFI_SUCCESS;
+}
+
+/**
+  Return the size of a capture, including its entries.
+
+  @param[in] Capture    The capture.
+
+  @return The size of the capture, in bytes.
+**/
+UINTN
+EFIAPI
+BootPerfCaptureSize (
+  IN CONST BOOT_PERF_CAPTURE  *Capture
+  )
+{
+  return sizeof (*Capture) + Capture->EntryCount * sizeof (BOOT_PERF_CAPTURE_ENTRY);
+}
+
+/**
+  Check that a buffer, such as one read back from a file, holds a capture.
+
+  @param[in] Buffer     The buffer.
+  @param[in] Size       The size of the buffer, in bytes.
+
+  @retval TRUE   The buffer holds a well formed capture.
+  @retval FALSE  The buffer doesn't hold a capture.
+**/
+BOOLEAN
+EFIAPI
+BootPerfCaptureIsValid (
+  IN CONST VOID  *Buffer,
+  IN UINTN       Size
+  )
+{
+  CONST BOOT_PERF_CAPTURE        *Capture;
+  CONST BOOT_PERF_CAPTURE_ENTRY  *Entries;
+  UINTN                          Index;
+
+  Capture = Buffer;
+  if ((Size < sizeof (*Capture)) ||
+      (Capture->Signature != BOOT_PERF_CAPTURE_SIGNATURE) ||
+      (Capture->Version != BOOT_PERF_CAPTURE_VERSION) ||
+      (Capture->EntryCount > (Size - sizeof (*Capture)) / sizeof (BOOT_PERF_CAPTURE_ENTRY)))
+  {
+    return FALSE;
+  }
+
+  Entries = (CONST BOOT_PERF_CAPTURE_ENTRY *)(Capture + 1);
+  for (Index = 0; Index < Capture->EntryCount; Index++) {
+    if (Entries[Index].Name[BOOT_PERF_CAPTURE_NAME_LENGTH - 1] != '\0') {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Find the entry of a capture which measures the same item as another entry,
+  usually from another capture.
+
+  @param[in] Capture    The capture to search.
+  @param[in] Entry      The entry to look for.
+
+  @return The matching entry, or NULL if the capture doesn't have one.
+**/
+CONST BOOT_PERF_CAPTURE_ENTRY *
+EFIAPI
+BootPerfCaptureFindEntry (
+  IN CONST BOOT_PERF_CAPTURE        *Capture,
+  IN CONST BOOT_PERF_CAPTURE_ENTRY  *Entry
+  )
+{
+  CONST BOOT_PERF_CAPTURE_ENTRY  *Entries;
+  UINTN                          Index;
+
+  Entries = (CONST BOOT_PERF_CAPTURE_ENTRY *)(Capture + 1);
+  for (Index = 0; Index < Capture->EntryCount; Index++) {
+    if ((Entries[Index].ProgressId == Entry->ProgressId) &&
+        CompareGuid (&Entries[Index].Guid, &Entry->Guid) &&
+        (AsciiStrnCmp (Entries[Index].Name, Entry->Name, BOOT_PERF_CAPTURE_NAME_LENGTH) == 0))
+    {
+      return &Entries[Index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Return a short name for the kind of item an entry measures.
+
+  @param[in] Entry      The entry.
+
+  @return An ASCII name, such as "Phase" or "Entry".
+**/
+CONST CHAR8 *
+EFIAPI
+BootPerfCaptureEntryType (
+  IN CONST BOOT_PERF_CAPTURE_ENTRY  *Entry
+  )
+{
+  switch (Entry->ProgressId) {
+    case MODULE_START_ID:
+      return "Entry";
+    case MODULE_LOADIMAGE_START_ID:
+      return "LoadImage";
+    case MODULE_DB_START_ID:
+      return "Start";
+    case MODULE_DB_SUPPORT_START_ID:
+      return "Supported";
+    case MODULE_DB_STOP_START_ID:
+      return "Stop";
+    case PERF_EVENTSIGNAL_START_ID:
+      return "Event";
+    case PERF_CALLBACK_START_ID:
+      return "Callback";
+    case PERF_FUNCTION_START_ID:
+      return "Function";
+    case PERF_INMODULE_START_ID:
+      return "InModule";
+    case PERF_CROSSMODULE_START_ID:
+      return "Phase";
+    default:
+      return "Custom";
+  }
+}
@@ -771,17 +771,24 @@ TestPointCheckAcpi (
   )
 {
   EFI_STATUS  Status;
+  BOOLEAN     DumpPrint;
 
   DEBUG ((DEBUG_INFO, "==== TestPointCheckAcpi - Enter\n"));
 
-  DEBUG ((DEBUG_INFO, "AcpiTable :\n"));
-  DEBUG ((DEBUG_INFO, "  Table         Address        Rev   OemId   OemTableId   OemRev   Creat  CreatorRev\n"));
+  //
+  // With deferred reporting on, only check the tables are there.
+  //
+  DumpPrint = !PcdGetBool (PcdTestPointDeferredReport);
+  if (DumpPrint) {
+    DEBUG ((DEBUG_INFO, "AcpiTable :\n"));
+    DEBUG ((DEBUG_INFO, "  Table         Address        Rev   OemId   OemTableId   OemRev   Creat  CreatorRev\n"));
+  }
   //
   // First dump
   //
-  Status = DumpAcpiWithGuid (&gEfiAcpi20TableGuid, NULL, NULL, TRUE, FALSE);
+  Status = DumpAcpiWithGuid (&gEfiAcpi20TableGuid, NULL, NULL, DumpPrint, FALSE);
   if (Status == EFI_NOT_FOUND) {
-    Status = DumpAcpiWithGuid (&gEfiAcpi10TableGuid, NULL, NULL, TRUE, FALSE);
+    Status = DumpAcpiWithGuid (&gEfiAcpi10TableGuid, NULL, NULL, DumpPrint, FALSE);
   }
 
   if (EFI_ERROR(Status)) {
@@ -18,6 +18,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Guid/MemoryAttributesTable.h>
 #include <Protocol/Runtime.h>
 
+#include "TestPointInternal.h"
+
 CHAR8 *
 ShortNameOfMemoryType(
   IN UINT32 Type
@@ -72,43 +74,43 @@ TestPointCheckMemoryAttribute (
   UINTN                 Index;
   EFI_MEMORY_DESCRIPTOR *Entry;
   
-  DEBUG ((DEBUG_ERROR, "Attribute Checking 0x%lx - 0x%lx\n", Base, Size));
+  TEST_POINT_DEBUG ((DEBUG_ERROR, "Attribute Checking 0x%lx - 0x%lx\n", Base, Size));
   Entry = (EFI_MEMORY_DESCRIPTOR *)(MemoryAttributesTable + 1);
   for (Index = 0; Index < MemoryAttributesTable->NumberOfEntries; Index++) {
     if (Base >= Entry->PhysicalStart && Base+Size <= Entry->PhysicalStart+MultU64x64 (SIZE_4KB,Entry->NumberOfPages)) {
       if (IsFromSmm) {
         if (IsCode) {
           if (Entry->Type != EfiRuntimeServicesCode) {
-            DEBUG ((DEBUG_ERROR, "Invalid Entry->Type %d\n", Entry->Type));
+            TEST_POINT_DEBUG ((DEBUG_ERROR, "Invalid Entry->Type %d\n", Entry->Type));
             return EFI_INVALID_PARAMETER;
           }
           if ((Entry->Attribute & (EFI_MEMORY_RO | EFI_MEMORY_XP)) != EFI_MEMORY_RO) {
-            DEBUG ((DEBUG_ERROR, "Invalid Code Entry->Attribute 0x%lx\n", Entry->Attribute));
+            TEST_POINT_DEBUG ((DEBUG_ERROR, "Invalid Code Entry->Attribute 0x%lx\n", Entry->Attribute));
             return EFI_INVALID_PARAMETER;
           }
         } else {
           if (Entry->Type != EfiRuntimeServicesData) {
-            DEBUG ((DEBUG_ERROR, "Invalid Entry->Type %d\n", Entry->Type));
+            TEST_POINT_DEBUG ((DEBUG_ERROR, "Invalid Entry->Type %d\n", Entry->Type));
             return EFI_INVALID_PARAMETER;
           }
           if ((Entry->Attribute & (EFI_MEMORY_RO | EFI_MEMORY_XP)) != EFI_MEMORY_XP) {
-            DEBUG ((DEBUG_ERROR, "Invalid Data Entry->Attribute 0x%lx\n", Entry->Attribute));
+            TEST_POINT_DEBUG ((DEBUG_ERROR, "Invalid Data Entry->Attribute 0x%lx\n", Entry->Attribute));
             return EFI_INVALID_PARAMETER;
           }
         }
       } else {
         if (Entry->Type != EfiRuntimeServicesCode) {
-          DEBUG ((DEBUG_ERROR, "Invalid Entry->Type %d\n", Entry->Type));
+          TEST_POINT_DEBUG ((DEBUG_ERROR, "Invalid Entry->Type %d\n", Entry->Type));
           return EFI_INVALID_PARAMETER;
         }
         if (IsCode) {
           if ((Entry->Attribute & (EFI_MEMORY_RO | EFI_MEMORY_XP)) != EFI_MEMORY_RO) {
-            DEBUG ((DEBUG_ERROR, "Invalid Code Entry->Attribute 0x%lx\n", Entry->Attribute));
+            TEST_POINT_DEBUG ((DEBUG_ERROR, "Invalid Code Entry->Attribute 0x%lx\n", Entry->Attribute));
             return EFI_INVALID_PARAMETER;
           }
         } else {
           if ((Entry->Attribute & (EFI_MEMORY_RO | EFI_MEMORY_XP)) != EFI_MEMORY_XP) {
-            DEBUG ((DEBUG_ERROR, "Invalid Data Entry->Attribute 0x%lx\n", Entry->Attribute));
+            TEST_POINT_DEBUG ((DEBUG_ERROR, "Invalid Data Entry->Attribute 0x%lx\n", Entry->Attribute));
             return EFI_INVALID_PARAMETER;
           }
         }
@@ -147,7 +149,7 @@ TestPointCheckImageMemoryAttribute (
 
   PdbPointer = PeCoffLoaderGetPdbPointer (ImageAddress);
   if (PdbPointer != NULL) {
-    DEBUG ((EFI_D_INFO, "  Image - %a\n", PdbPointer));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "  Image - %a\n", PdbPointer));
   }
 
   //
@@ -161,7 +163,7 @@ TestPointCheckImageMemoryAttribute (
 
   Hdr.Pe32 = (EFI_IMAGE_NT_HEADERS32 *)((UINT8 *) (UINTN) ImageAddress + PeCoffHeaderOffset);
   if (Hdr.Pe32->Signature != EFI_IMAGE_NT_SIGNATURE) {
-    DEBUG ((EFI_D_INFO, "Hdr.Pe32->Signature invalid - 0x%x\n", Hdr.Pe32->Signature));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "Hdr.Pe32->Signature invalid - 0x%x\n", Hdr.Pe32->Signature));
     return EFI_INVALID_PARAMETER;
   }
   
@@ -183,10 +185,10 @@ TestPointCheckImageMemoryAttribute (
   }
 
   if ((SectionAlignment & (RUNTIME_PAGE_ALLOCATION_GRANULARITY - 1)) != 0) {
-    DEBUG ((EFI_D_INFO, "!!!!!!!!  RecordImageMemoryMap - Section Alignment(0x%x) is not %dK  !!!!!!!!\n", SectionAlignment, RUNTIME_PAGE_ALLOCATION_GRANULARITY >> 10));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "!!!!!!!!  RecordImageMemoryMap - Section Alignment(0x%x) is not %dK  !!!!!!!!\n", SectionAlignment, RUNTIME_PAGE_ALLOCATION_GRANULARITY >> 10));
     PdbPointer = PeCoffLoaderGetPdbPointer ((VOID*) (UINTN) ImageAddress);
     if (PdbPointer != NULL) {
-      DEBUG ((EFI_D_INFO, "!!!!!!!!  Image - %a  !!!!!!!!\n", PdbPointer));
+      TEST_POINT_DEBUG ((EFI_D_INFO, "!!!!!!!!  Image - %a  !!!!!!!!\n", PdbPointer));
     }
     return EFI_INVALID_PARAMETER;
   }
@@ -212,7 +214,7 @@ TestPointCheckImageMemoryAttribute (
 
   for (Index = 0; Index < Hdr.Pe32->FileHeader.NumberOfSections; Index++) {
     Name = Section[Index].Name;
-    DEBUG ((
+    TEST_POINT_DEBUG ((
       EFI_D_INFO,
       "  Section - '%c%c%c%c%c%c%c%c'\n",
       Name[0],
@@ -225,15 +227,15 @@ TestPointCheckImageMemoryAttribute (
       Name[7]
       ));
       
-    DEBUG ((EFI_D_INFO, "    VirtualSize          - 0x%08x\n", Section[Index].Misc.VirtualSize));
-    DEBUG ((EFI_D_INFO, "    VirtualAddress       - 0x%08x\n", Section[Index].VirtualAddress));
-    DEBUG ((EFI_D_INFO, "    SizeOfRawData        - 0x%08x\n", Section[Index].SizeOfRawData));
-    DEBUG ((EFI_D_INFO, "    PointerToRawData     - 0x%08x\n", Section[Index].PointerToRawData));
-    DEBUG ((EFI_D_INFO, "    PointerToRelocations - 0x%08x\n", Section[Index].PointerToRelocations));
-    DEBUG ((EFI_D_INFO, "    PointerToLinenumbers - 0x%08x\n", Section[Index].PointerToLinenumbers));
-    DEBUG ((EFI_D_INFO, "    NumberOfRelocations  - 0x%08x\n", Section[Index].NumberOfRelocations));
-    DEBUG ((EFI_D_INFO, "    NumberOfLinenumbers  - 0x%08x\n", Section[Index].NumberOfLinenumbers));
-    DEBUG ((EFI_D_INFO, "    Characteristics      - 0x%08x\n", Section[Index].Characteristics));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    VirtualSize          - 0x%08x\n", Section[Index].Misc.VirtualSize));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    VirtualAddress       - 0x%08x\n", Section[Index].VirtualAddress));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    SizeOfRawData        - 0x%08x\n", Section[Index].SizeOfRawData));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    PointerToRawData     - 0x%08x\n", Section[Index].PointerToRawData));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    PointerToRelocations - 0x%08x\n", Section[Index].PointerToRelocations));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    PointerToLinenumbers - 0x%08x\n", Section[Index].PointerToLinenumbers));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    NumberOfRelocations  - 0x%08x\n", Section[Index].NumberOfRelocations));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    NumberOfLinenumbers  - 0x%08x\n", Section[Index].NumberOfLinenumbers));
+    TEST_POINT_DEBUG ((EFI_D_INFO, "    Characteristics      - 0x%08x\n", Section[Index].Characteristics));
     if ((Section[Index].Characteristics & EFI_IMAGE_SCN_CNT_CODE) != 0) {
       //
       // Check code section
@@ -330,3 +332,32 @@ TestPointCheckUefiMemAttribute (
 
   return Status;
 }
+
+BOOLEAN
+TestPointAnalyzeUefiMemAttribute (
+  IN VOID  *Context
+  )
+{
+  TEST_POINT_UEFI_MEM_ATTRIBUTE_CONTEXT  *MemAttributeContext;
+  TEST_POINT_RUNTIME_IMAGE               *RuntimeImage;
+  EFI_MEMORY_ATTRIBUTES_TABLE            *MemoryAttributesTable;
+  UINTN                                  Index;
+  BOOLEAN                                Result;
+
+  MemAttributeContext   = Context;
+  RuntimeImage          = (TEST_POINT_RUNTIME_IMAGE *)(MemAttributeContext + 1);
+  MemoryAttributesTable = (EFI_MEMORY_ATTRIBUTES_TABLE *)&RuntimeImage[MemAttributeContext->NumberOfRuntimeImages];
+
+  Result = TRUE;
+  for (Index = 0; Index < MemAttributeContext->NumberOfRuntimeImages; Index++) {
+    if (EFI_ERROR (TestPointCheckImageMemoryAttribute (
+                     MemoryAttributesTable,
+                     RuntimeImage[Index].ImageBase,
+                     RuntimeImage[Index].ImageSize,
+                     FALSE
+                     ))) {
+      Result = FALSE;
+    }
+  }
+  return Result;
+}
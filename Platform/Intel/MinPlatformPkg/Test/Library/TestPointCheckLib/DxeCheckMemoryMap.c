@@ -16,6 +16,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
 
+#include "TestPointInternal.h"
+
 CHAR8 *mMemoryTypeShortName[] = {
   "Reserved  ",
   "LoaderCode",
@@ -132,16 +134,16 @@ TestPointCheckUefiMemoryMapEntry (
     Entry = NEXT_MEMORY_DESCRIPTOR (Entry, DescriptorSize);
   }
   if (EntryCount[EfiRuntimeServicesCode] > 1) {
-    DEBUG ((DEBUG_ERROR, "EfiRuntimeServicesCode entry - %d\n", EntryCount[EfiRuntimeServicesCode]));
+    TEST_POINT_DEBUG ((DEBUG_ERROR, "EfiRuntimeServicesCode entry - %d\n", EntryCount[EfiRuntimeServicesCode]));
   }
   if (EntryCount[EfiRuntimeServicesData] > 1) {
-    DEBUG ((DEBUG_ERROR, "EfiRuntimeServicesData entry - %d\n", EntryCount[EfiRuntimeServicesData]));
+    TEST_POINT_DEBUG ((DEBUG_ERROR, "EfiRuntimeServicesData entry - %d\n", EntryCount[EfiRuntimeServicesData]));
   }
   if (EntryCount[EfiACPIMemoryNVS] > 1) {
-    DEBUG ((DEBUG_ERROR, "EfiACPIMemoryNVS entry - %d\n", EntryCount[EfiACPIMemoryNVS]));
+    TEST_POINT_DEBUG ((DEBUG_ERROR, "EfiACPIMemoryNVS entry - %d\n", EntryCount[EfiACPIMemoryNVS]));
   }
   if (EntryCount[EfiACPIReclaimMemory] > 1) {
-    DEBUG ((DEBUG_ERROR, "EfiACPIReclaimMemory entry - %d\n", EntryCount[EfiACPIReclaimMemory]));
+    TEST_POINT_DEBUG ((DEBUG_ERROR, "EfiACPIReclaimMemory entry - %d\n", EntryCount[EfiACPIReclaimMemory]));
   }
   if ((EntryCount[EfiRuntimeServicesCode] > 1) ||
       (EntryCount[EfiRuntimeServicesData] > 1) ||
@@ -301,3 +303,18 @@ Done:
   DEBUG ((DEBUG_INFO, "==== TestPointCheckUefiMemoryMap - Exit\n"));
   return Status;
 }
+
+BOOLEAN
+TestPointAnalyzeUefiMemoryMap (
+  IN VOID  *Context
+  )
+{
+  TEST_POINT_UEFI_MEMORY_MAP_CONTEXT  *MemoryMapContext;
+
+  MemoryMapContext = Context;
+  return TestPointCheckUefiMemoryMapEntry (
+           (EFI_MEMORY_DESCRIPTOR *)(MemoryMapContext + 1),
+           MemoryMapContext->MemoryMapSize,
+           MemoryMapContext->DescriptorSize
+           );
+}
@@ -153,6 +153,16 @@ TestPointGetAcpi (
   IN UINT32  Signature
   );
 
+VOID
+TestPointDeferCheckUefiMemoryMap (
+  IN BOOLEAN  Result
+  );
+
+VOID
+TestPointDeferCheckUefiMemAttribute (
+  VOID
+  );
+
 GLOBAL_REMOVE_IF_UNREFERENCED ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT  mTestPointStruct = {
   PLATFORM_TEST_POINT_VERSION,
   PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
@@ -811,6 +821,11 @@ TestPointReadyToBootMemoryTypeInformationFunctional (
   if (EFI_ERROR(Status)) {
     Result = FALSE;
   }
+  if (PcdGetBool (PcdTestPointDeferredReport)) {
+    TestPointDeferCheckUefiMemoryMap (Result);
+    DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootMemoryTypeInformationFunctional - Deferred\n"));
+    return EFI_SUCCESS;
+  }
   TestPointDumpUefiMemoryMap (NULL, NULL, NULL, TRUE);
   Status = TestPointCheckUefiMemoryMap ();
   if (EFI_ERROR(Status)) {
@@ -857,6 +872,12 @@ TestPointReadyToBootUefiMemoryAttributeTableFunctional (
 
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiMemoryAttributeTableFunctional - Enter\n"));
 
+  if (PcdGetBool (PcdTestPointDeferredReport)) {
+    TestPointDeferCheckUefiMemAttribute ();
+    DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiMemoryAttributeTableFunctional - Deferred\n"));
+    return EFI_SUCCESS;
+  }
+
   Result = TRUE;
   TestPointDumpUefiMemoryMap (NULL, NULL, NULL, TRUE);
   TestPointDumpGcd (NULL, NULL, NULL, NULL, TRUE);
@@ -905,8 +926,10 @@ TestPointReadyToBootUefiBootVariableFunctional (
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiBootVariableFunctional - Enter\n"));
 
   Result = TRUE;
-  TestPointDumpDevicePath ();
-  TestPointDumpVariable ();
+  if (!PcdGetBool (PcdTestPointDeferredReport)) {
+    TestPointDumpDevicePath ();
+    TestPointDumpVariable ();
+  }
   Status = TestPointCheckBootVariable ();
   if (EFI_ERROR(Status)) {
     Result = FALSE;
@@ -952,8 +975,10 @@ TestPointReadyToBootUefiConsoleVariableFunctional (
   DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootUefiConsoleVariableFunctional - Enter\n"));
 
   Result = TRUE;
-  TestPointDumpDevicePath ();
-  TestPointDumpVariable ();
+  if (!PcdGetBool (PcdTestPointDeferredReport)) {
+    TestPointDumpDevicePath ();
+    TestPointDumpVariable ();
+  }
   Status = TestPointCheckConsoleVariable ();
   if (EFI_ERROR(Status)) {
     Result = FALSE;
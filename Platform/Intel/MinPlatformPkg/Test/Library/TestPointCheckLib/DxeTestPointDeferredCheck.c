@@ -0,0 +1,354 @@
+/** @file
+  Deferred test point checks.
+
+  When PcdTestPointDeferredReport is set, the test points only collect the data
+  they check and queue the analysis of it. The queue is run at the end of Ready
+  To Boot on every enabled processor, and the results are reported through the
+  test point table, which TestPointDumpApp prints, instead of the debug log.
+
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <PiDxe.h>
+#include <Library/TestPointCheckLib.h>
+#include <Library/TestPointLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Protocol/MpService.h>
+#include <Protocol/Runtime.h>
+#include <Guid/MemoryAttributesTable.h>
+
+#include "TestPointInternal.h"
+
+#define TEST_POINT_MAX_DEFERRED_CHECKS  16
+
+VOID
+TestPointDumpUefiMemoryMap (
+  OUT EFI_MEMORY_DESCRIPTOR **UefiMemoryMap, OPTIONAL
+  OUT UINTN                 *UefiMemoryMapSize, OPTIONAL
+  OUT UINTN                 *UefiDescriptorSize, OPTIONAL
+  IN  BOOLEAN               DumpPrint
+  );
+
+GLOBAL_REMOVE_IF_UNREFERENCED TEST_POINT_DEFERRED_CHECK  mTestPointDeferredCheck[TEST_POINT_MAX_DEFERRED_CHECKS];
+GLOBAL_REMOVE_IF_UNREFERENCED UINT32                     mTestPointDeferredCheckCount;
+GLOBAL_REMOVE_IF_UNREFERENCED volatile UINT32            mTestPointDeferredCheckNext;
+
+/**
+  Report the result of a check and free its data.
+
+  @param[in]  Check   The check.
+**/
+VOID
+TestPointReportDeferredCheck (
+  IN TEST_POINT_DEFERRED_CHECK  *Check
+  )
+{
+  if (!Check->AnalysisResult) {
+    DEBUG ((DEBUG_ERROR, "TestPoint %s - analysis failed\n", Check->Name));
+    TestPointLibAppendErrorString (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      Check->ErrorString
+      );
+  }
+
+  if (Check->Result && Check->AnalysisResult) {
+    TestPointLibSetFeaturesVerified (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      Check->ByteIndex,
+      Check->BitMask
+      );
+  }
+
+  if (Check->Context != NULL) {
+    FreePool (Check->Context);
+  }
+  ZeroMem (Check, sizeof(*Check));
+}
+
+/**
+  Run queued analyses until none is left.
+
+  This runs on the BSP and on the APs at the same time, so the analyses must not
+  use any UEFI services, and must not log.
+
+  @param[in]  Buffer  Not used.
+**/
+VOID
+EFIAPI
+TestPointDeferredCheckWorker (
+  IN VOID  *Buffer
+  )
+{
+  UINT32                     Index;
+  TEST_POINT_DEFERRED_CHECK  *Check;
+
+  while (TRUE) {
+    Index = InterlockedIncrement (&mTestPointDeferredCheckNext) - 1;
+    if (Index >= mTestPointDeferredCheckCount) {
+      break;
+    }
+    Check = &mTestPointDeferredCheck[Index];
+    if ((Check->Analysis == NULL) || (Check->Context == NULL)) {
+      Check->AnalysisResult = FALSE;
+    } else {
+      Check->AnalysisResult = Check->Analysis (Check->Context);
+    }
+  }
+}
+
+/**
+  Run the queued checks and report their results.
+
+  @param[in]  UseAps  Whether the APs may help running the analyses.
+**/
+VOID
+TestPointRunDeferredChecks (
+  IN BOOLEAN  UseAps
+  )
+{
+  EFI_STATUS                Status;
+  EFI_MP_SERVICES_PROTOCOL  *MpServices;
+  UINTN                     NumberOfProcessors;
+  UINTN                     NumberOfEnabledProcessors;
+  EFI_EVENT                 ApDoneEvent;
+  UINT32                    Index;
+
+  if (mTestPointDeferredCheckCount == 0) {
+    return ;
+  }
+
+  NumberOfEnabledProcessors = 1;
+  ApDoneEvent = NULL;
+  mTestPointDeferredCheckNext = 0;
+
+  if (UseAps && (mTestPointDeferredCheckCount > 1)) {
+    Status = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpServices);
+    if (!EFI_ERROR (Status)) {
+      Status = MpServices->GetNumberOfProcessors (MpServices, &NumberOfProcessors, &NumberOfEnabledProcessors);
+    }
+    if (!EFI_ERROR (Status) && (NumberOfEnabledProcessors > 1)) {
+      Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &ApDoneEvent);
+    }
+    if (!EFI_ERROR (Status) && (ApDoneEvent != NULL)) {
+      Status = MpServices->StartupAllAPs (
+                             MpServices,
+                             TestPointDeferredCheckWorker,
+                             FALSE,
+                             ApDoneEvent,
+                             0,
+                             NULL,
+                             NULL
+                             );
+      if (EFI_ERROR (Status)) {
+        gBS->CloseEvent (ApDoneEvent);
+        ApDoneEvent = NULL;
+      }
+    }
+    if (ApDoneEvent == NULL) {
+      NumberOfEnabledProcessors = 1;
+    }
+  }
+
+  //
+  // The BSP takes its share of the queue, then waits for the APs to finish theirs.
+  //
+  TestPointDeferredCheckWorker (NULL);
+  if (ApDoneEvent != NULL) {
+    while (gBS->CheckEvent (ApDoneEvent) == EFI_NOT_READY) {
+      CpuPause ();
+    }
+    gBS->CloseEvent (ApDoneEvent);
+  }
+
+  DEBUG ((DEBUG_INFO, "TestPoint - %d deferred checks on %d processors\n", mTestPointDeferredCheckCount, NumberOfEnabledProcessors));
+
+  for (Index = 0; Index < mTestPointDeferredCheckCount; Index++) {
+    TestPointReportDeferredCheck (&mTestPointDeferredCheck[Index]);
+  }
+  mTestPointDeferredCheckCount = 0;
+}
+
+/**
+  Queue the analysis of the data a test point collected.
+
+  The analysis is run at once when deferred reporting is off, or the queue is full.
+
+  @param[in]  Name            Name of the test point, for the debug log.
+  @param[in]  Analysis        The analysis. It must not use any UEFI services and must not log.
+  @param[in]  Context         Data for the analysis, allocated from pool. It is freed by this service.
+                              NULL if the test point could not collect it, which fails the check.
+  @param[in]  Result          Result of the part of the test point that already ran.
+  @param[in]  ByteIndex       Byte index of the feature the test point verifies.
+  @param[in]  BitMask         Bit mask of the feature the test point verifies.
+  @param[in]  ErrorString     Error string to report when the analysis fails.
+**/
+VOID
+TestPointDeferCheck (
+  IN CHAR16                        *Name,
+  IN TEST_POINT_DEFERRED_ANALYSIS  Analysis,
+  IN VOID                          *Context, OPTIONAL
+  IN BOOLEAN                       Result,
+  IN UINT32                        ByteIndex,
+  IN UINT8                         BitMask,
+  IN CHAR16                        *ErrorString
+  )
+{
+  TEST_POINT_DEFERRED_CHECK  *Check;
+
+  if (!PcdGetBool (PcdTestPointDeferredReport) ||
+      (mTestPointDeferredCheckCount == TEST_POINT_MAX_DEFERRED_CHECKS)) {
+    //
+    // Run the queue first, so the results stay in order.
+    //
+    TestPointRunDeferredChecks (FALSE);
+  }
+
+  Check = &mTestPointDeferredCheck[mTestPointDeferredCheckCount];
+  Check->Name        = Name;
+  Check->Analysis    = Analysis;
+  Check->Context     = Context;
+  Check->Result      = Result;
+  Check->ByteIndex   = ByteIndex;
+  Check->BitMask     = BitMask;
+  Check->ErrorString = ErrorString;
+  mTestPointDeferredCheckCount++;
+
+  if (!PcdGetBool (PcdTestPointDeferredReport)) {
+    TestPointRunDeferredChecks (FALSE);
+  }
+}
+
+/**
+  Take a copy of the UEFI memory map and queue its check.
+
+  @param[in]  Result    Result of the rest of the memory type information test point.
+**/
+VOID
+TestPointDeferCheckUefiMemoryMap (
+  IN BOOLEAN  Result
+  )
+{
+  EFI_MEMORY_DESCRIPTOR               *MemoryMap;
+  UINTN                               MemoryMapSize;
+  UINTN                               DescriptorSize;
+  TEST_POINT_UEFI_MEMORY_MAP_CONTEXT  *Context;
+
+  Context = NULL;
+  TestPointDumpUefiMemoryMap (&MemoryMap, &MemoryMapSize, &DescriptorSize, FALSE);
+  if (MemoryMap != NULL) {
+    Context = AllocatePool (sizeof(*Context) + MemoryMapSize);
+    if (Context != NULL) {
+      Context->MemoryMapSize  = MemoryMapSize;
+      Context->DescriptorSize = DescriptorSize;
+      CopyMem (Context + 1, MemoryMap, MemoryMapSize);
+    }
+    FreePool (MemoryMap);
+  }
+
+  TestPointDeferCheck (
+    L"ReadyToBootMemoryTypeInformationFunctional",
+    TestPointAnalyzeUefiMemoryMap,
+    Context,
+    Result,
+    4,
+    TEST_POINT_BYTE4_READY_TO_BOOT_MEMORY_TYPE_INFORMATION_FUNCTIONAL,
+    TEST_POINT_BYTE4_READY_TO_BOOT_MEMORY_TYPE_INFORMATION_FUNCTIONAL_ERROR_CODE \
+      TEST_POINT_READY_TO_BOOT \
+      TEST_POINT_BYTE4_READY_TO_BOOT_MEMORY_TYPE_INFORMATION_FUNCTIONAL_ERROR_STRING
+    );
+}
+
+/**
+  Take a copy of the UEFI memory attributes table and of the runtime image list,
+  and queue their check.
+**/
+VOID
+TestPointDeferCheckUefiMemAttribute (
+  VOID
+  )
+{
+  EFI_STATUS                             Status;
+  EFI_MEMORY_ATTRIBUTES_TABLE            *MemoryAttributesTable;
+  UINTN                                  MemoryAttributesTableSize;
+  EFI_RUNTIME_ARCH_PROTOCOL              *RuntimeArch;
+  LIST_ENTRY                             *Link;
+  EFI_RUNTIME_IMAGE_ENTRY                *RuntimeImageEntry;
+  UINTN                                  NumberOfRuntimeImages;
+  TEST_POINT_UEFI_MEM_ATTRIBUTE_CONTEXT  *Context;
+  TEST_POINT_RUNTIME_IMAGE               *RuntimeImage;
+
+  Context = NULL;
+  Status = EfiGetSystemConfigurationTable (&gEfiMemoryAttributesTableGuid, (VOID **)&MemoryAttributesTable);
+  if (!EFI_ERROR (Status)) {
+    MemoryAttributesTableSize = sizeof(EFI_MEMORY_ATTRIBUTES_TABLE) + MemoryAttributesTable->DescriptorSize * MemoryAttributesTable->NumberOfEntries;
+
+    RuntimeArch = NULL;
+    NumberOfRuntimeImages = 0;
+    Status = gBS->LocateProtocol (&gEfiRuntimeArchProtocolGuid, NULL, (VOID **)&RuntimeArch);
+    if (!EFI_ERROR (Status)) {
+      for (Link = RuntimeArch->ImageHead.ForwardLink; Link != &(RuntimeArch->ImageHead); Link = Link->ForwardLink) {
+        NumberOfRuntimeImages++;
+      }
+    }
+
+    Context = AllocatePool (sizeof(*Context) + NumberOfRuntimeImages * sizeof(TEST_POINT_RUNTIME_IMAGE) + MemoryAttributesTableSize);
+    if (Context != NULL) {
+      Context->NumberOfRuntimeImages = NumberOfRuntimeImages;
+      RuntimeImage = (TEST_POINT_RUNTIME_IMAGE *)(Context + 1);
+      if (RuntimeArch != NULL) {
+        for (Link = RuntimeArch->ImageHead.ForwardLink; Link != &(RuntimeArch->ImageHead); Link = Link->ForwardLink) {
+          RuntimeImageEntry = BASE_CR (Link, EFI_RUNTIME_IMAGE_ENTRY, Link);
+          RuntimeImage->ImageBase = (EFI_PHYSICAL_ADDRESS)(UINTN)RuntimeImageEntry->ImageBase;
+          RuntimeImage->ImageSize = RuntimeImageEntry->ImageSize;
+          RuntimeImage++;
+        }
+      }
+      CopyMem (RuntimeImage, MemoryAttributesTable, MemoryAttributesTableSize);
+    }
+  }
+
+  TestPointDeferCheck (
+    L"ReadyToBootUefiMemoryAttributeTableFunctional",
+    TestPointAnalyzeUefiMemAttribute,
+    Context,
+    TRUE,
+    4,
+    TEST_POINT_BYTE4_READY_TO_BOOT_UEFI_MEMORY_ATTRIBUTE_TABLE_FUNCTIONAL,
+    TEST_POINT_BYTE4_READY_TO_BOOT_UEFI_MEMORY_ATTRIBUTE_TABLE_FUNCTIONAL_ERROR_CODE \
+      TEST_POINT_READY_TO_BOOT \
+      TEST_POINT_BYTE4_READY_TO_BOOT_UEFI_MEMORY_ATTRIBUTE_TABLE_FUNCTIONAL_ERROR_STRING
+    );
+}
+
+/**
+  This service runs the checks the DXE test points deferred when PcdTestPointDeferredReport is set.
+  It must be called after the other Ready To Boot test points.
+
+  Test subject: Data collected by the test points.
+  Test overview: Analyze the data on all enabled processors.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+
+  @retval EFI_SUCCESS         The deferred checks were performed successfully.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootDeferredChecks (
+  VOID
+  )
+{
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootDeferredChecks - Enter\n"));
+
+  TestPointRunDeferredChecks (TRUE);
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootDeferredChecks - Exit\n"));
+  return EFI_SUCCESS;
+}
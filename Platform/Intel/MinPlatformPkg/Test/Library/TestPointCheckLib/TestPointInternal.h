@@ -40,4 +40,85 @@ typedef struct {
 
 extern EFI_GUID  mTestPointSmmCommunciationGuid;
 
+/**
+  Analyze the data a test point collected.
+
+  It may run on an AP, so it must not use any UEFI services, and must not log.
+
+  @param[in]  Context   The data.
+
+  @retval TRUE          The check passed.
+  @retval FALSE         The check failed.
+**/
+typedef
+BOOLEAN
+(*TEST_POINT_DEFERRED_ANALYSIS) (
+  IN VOID  *Context
+  );
+
+typedef struct {
+  CHAR16                        *Name;
+  TEST_POINT_DEFERRED_ANALYSIS  Analysis;
+  VOID                          *Context;
+  BOOLEAN                       Result;
+  BOOLEAN                       AnalysisResult;
+  UINT32                        ByteIndex;
+  UINT8                         BitMask;
+  CHAR16                        *ErrorString;
+} TEST_POINT_DEFERRED_CHECK;
+
+typedef struct {
+  UINTN                    MemoryMapSize;
+  UINTN                    DescriptorSize;
+//EFI_MEMORY_DESCRIPTOR    MemoryMap[];
+} TEST_POINT_UEFI_MEMORY_MAP_CONTEXT;
+
+typedef struct {
+  EFI_PHYSICAL_ADDRESS     ImageBase;
+  UINT64                   ImageSize;
+} TEST_POINT_RUNTIME_IMAGE;
+
+typedef struct {
+  UINTN                    NumberOfRuntimeImages;
+//TEST_POINT_RUNTIME_IMAGE RuntimeImage[NumberOfRuntimeImages];
+//EFI_MEMORY_ATTRIBUTES_TABLE MemoryAttributesTable;
+} TEST_POINT_UEFI_MEM_ATTRIBUTE_CONTEXT;
+
+BOOLEAN
+TestPointAnalyzeUefiMemoryMap (
+  IN VOID  *Context
+  );
+
+BOOLEAN
+TestPointAnalyzeUefiMemAttribute (
+  IN VOID  *Context
+  );
+
+VOID
+TestPointDeferCheck (
+  IN CHAR16                        *Name,
+  IN TEST_POINT_DEFERRED_ANALYSIS  Analysis,
+  IN VOID                          *Context, OPTIONAL
+  IN BOOLEAN                       Result,
+  IN UINT32                        ByteIndex,
+  IN UINT8                         BitMask,
+  IN CHAR16                        *ErrorString
+  );
+
+VOID
+TestPointRunDeferredChecks (
+  IN BOOLEAN  UseAps
+  );
+
+//
+// Debug output of code that may run as a deferred analysis. With deferred
+// reporting on, the results are found in the test point table instead.
+//
+#define TEST_POINT_DEBUG(Expression)                  \
+  do {                                                \
+    if (!PcdGetBool (PcdTestPointDeferredReport)) {   \
+      DEBUG (Expression);                             \
+    }                                                 \
+  } while (FALSE)
+
 #endif
\ No newline at end of file
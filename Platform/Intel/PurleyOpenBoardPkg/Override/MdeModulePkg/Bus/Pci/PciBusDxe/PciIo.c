@@ -119,6 +119,56 @@ PciIoVerifyBarAccess (
   return EFI_SUCCESS;
 }
 
+/**
+  Widens a plain incrementing read from a prefetchable memory BAR.
+
+  Reads from prefetchable memory have no side effects, so a sequential copy
+  done in small units can be issued to the root bridge with the widest access
+  that the address, length and buffer alignment allow.
+
+  @param PciIoDevice  Pci device instance.
+  @param BarIndex     The BAR index of the standard PCI Configuration header.
+  @param Address      The absolute address of the read.
+  @param Buffer       The destination buffer of the read.
+  @param Width        On input, the requested width. On output, the width to use.
+  @param Count        On input, the requested count. On output, the count to use.
+
+**/
+VOID
+PciIoWidenMemRead (
+  IN     PCI_IO_DEVICE                   *PciIoDevice,
+  IN     UINT8                           BarIndex,
+  IN     UINT64                          Address,
+  IN     VOID                            *Buffer,
+  IN OUT EFI_PCI_IO_PROTOCOL_WIDTH       *Width,
+  IN OUT UINTN                           *Count
+  )
+{
+  UINT64                     Length;
+  UINT64                     Alignment;
+  EFI_PCI_IO_PROTOCOL_WIDTH  NewWidth;
+
+  if (BarIndex >= PCI_MAX_BAR || *Width > EfiPciIoWidthUint32) {
+    return;
+  }
+
+  if (PciIoDevice->PciBar[BarIndex].BarType != PciBarTypePMem32 &&
+      PciIoDevice->PciBar[BarIndex].BarType != PciBarTypePMem64) {
+    return;
+  }
+
+  Length    = MultU64x32 (*Count, (UINT32)(1 << *Width));
+  Alignment = Address | Length | (UINTN) Buffer;
+
+  for (NewWidth = EfiPciIoWidthUint64; NewWidth > *Width; NewWidth--) {
+    if ((Alignment & ((1 << NewWidth) - 1)) == 0) {
+      *Count = (UINTN) RShiftU64 (Length, NewWidth);
+      *Width = NewWidth;
+      return;
+    }
+  }
+}
+
 /**
   Verifies access to a PCI Configuration Header.
 
@@ -440,6 +490,7 @@ PciIoMemRead (
     }
   }
 
+  PciIoWidenMemRead (PciIoDevice, BarIndex, Offset, Buffer, &Width, &Count);
 
   Status = PciIoDevice->PciRootBridgeIo->Mem.Read (
                                               PciIoDevice->PciRootBridgeIo,
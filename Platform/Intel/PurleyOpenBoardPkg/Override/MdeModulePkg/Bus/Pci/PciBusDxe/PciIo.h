@@ -45,6 +45,31 @@ PciIoVerifyBarAccess (
   IN UINT64                          *Offset
   );
 
+/**
+  Widens a plain incrementing read from a prefetchable memory BAR.
+
+  Reads from prefetchable memory have no side effects, so a sequential copy
+  done in small units can be issued to the root bridge with the widest access
+  that the address, length and buffer alignment allow.
+
+  @param PciIoDevice  Pci device instance.
+  @param BarIndex     The BAR index of the standard PCI Configuration header.
+  @param Address      The absolute address of the read.
+  @param Buffer       The destination buffer of the read.
+  @param Width        On input, the requested width. On output, the width to use.
+  @param Count        On input, the requested count. On output, the count to use.
+
+**/
+VOID
+PciIoWidenMemRead (
+  IN     PCI_IO_DEVICE                   *PciIoDevice,
+  IN     UINT8                           BarIndex,
+  IN     UINT64                          Address,
+  IN     VOID                            *Buffer,
+  IN OUT EFI_PCI_IO_PROTOCOL_WIDTH       *Width,
+  IN OUT UINTN                           *Count
+  );
+
 /**
   Verifies access to a PCI Configuration Header.
 
@@ -362,6 +362,13 @@ MemoryInit (
         MrcData.boot_mode = bmCold;
         break;
       }
+    } else if (BootMode == BOOT_WITH_FULL_CONFIGURATION) {
+      //
+      // Restore the trained timings instead of training again. MRC still
+      // verifies them with a memory test and falls back to full training
+      // if that fails or the DDR speed changed.
+      //
+      MrcData.boot_mode = bmFast;
     }
   }
 
@@ -619,6 +619,37 @@ Returns:
   return Status;
 }
 
+BOOLEAN
+IsFlashRangeErased (
+  IN  UINTN                               Address,
+  IN  UINTN                               Length
+  )
+/*++
+
+Routine Description:
+  Checks whether a range of the flash device already reads back as erased
+
+Arguments:
+  Address               - Memory mapped address of the range, 4 byte aligned
+  Length                - Length of the range in bytes, multiple of 4
+
+Returns:
+  TRUE                  - Every byte in the range is 0xFF
+  FALSE                 - At least one byte in the range is programmed
+
+--*/
+{
+  UINTN  Offset;
+
+  for (Offset = 0; Offset < Length; Offset += sizeof (UINT32)) {
+    if (MmioRead32 (Address + Offset) != MAX_UINT32) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 EFI_STATUS
 FvbWriteBlock (
   IN UINTN                                Instance,
@@ -666,6 +697,9 @@ Returns:
   EFI_FW_VOL_INSTANCE *FwhInstance;
   EFI_STATUS          Status;
   EFI_STATUS          ReturnStatus;
+  UINTN               Start;
+  UINTN               End;
+  UINTN               WriteBytes;
 
   FwhInstance = NULL;
 
@@ -716,11 +750,31 @@ Returns:
     Status    = EFI_BAD_BUFFER_SIZE;
   }
 
+  //
+  // Only program the bytes that differ from what the flash already holds.
+  // The variable driver often rewrites a header or state byte together with
+  // data that is unchanged, and every SPI program cycle is slow.
+  //
+  for (Start = 0; Start < *NumBytes; Start++) {
+    if (MmioRead8 (LbaAddress + BlockOffset + Start) != Buffer[Start]) {
+      break;
+    }
+  }
+  if (Start == *NumBytes) {
+    return Status;
+  }
+  for (End = *NumBytes; End > Start; End--) {
+    if (MmioRead8 (LbaAddress + BlockOffset + End - 1) != Buffer[End - 1]) {
+      break;
+    }
+  }
+
+  WriteBytes = End - Start;
   ReturnStatus = FlashFdWrite (
-                  LbaWriteAddress + BlockOffset,
+                  LbaWriteAddress + BlockOffset + Start,
                   LbaAddress,
-                  NumBytes,
-                  Buffer,
+                  &WriteBytes,
+                  Buffer + Start,
                   LbaLength
                   );
   if (EFI_ERROR (ReturnStatus)) {
@@ -802,6 +856,13 @@ Returns:
 
   SectorNum = LbaLength / SPI_ERASE_SECTOR_SIZE;
   for (Index = 0; Index < SectorNum; Index++){
+    //
+    // Erasing a sector takes far longer than reading it, skip sectors
+    // that are blank already.
+    //
+    if (IsFlashRangeErased (LbaAddress + Index * SPI_ERASE_SECTOR_SIZE, SPI_ERASE_SECTOR_SIZE)) {
+      continue;
+    }
     Status = FlashFdErase (
                LbaWriteAddress + Index * SPI_ERASE_SECTOR_SIZE,
                LbaAddress,
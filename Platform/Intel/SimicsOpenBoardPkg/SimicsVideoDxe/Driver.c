@@ -420,6 +420,11 @@ QemuVideoControllerDriverStart (
     goto UninstallGop;
   }
 
+  //
+  // Statistics are optional, the display works without them
+  //
+  GopStatsInstall (Private->Handle, &Private->GopStats);
+
 #if defined MDE_CPU_IA32 || defined MDE_CPU_X64
   if (Private->Variant == QEMU_VIDEO_BOCHS_MMIO ||
       Private->Variant == QEMU_VIDEO_BOCHS) {
@@ -528,6 +533,8 @@ QemuVideoControllerDriverStop (
   ASSERT (Private->Handle == ChildHandleBuffer[0]);
 
   QemuVideoGraphicsOutputDestructor (Private);
+  GopStatsUninstall (Private->Handle, Private->GopStats);
+  Private->GopStats = NULL;
   //
   // Remove the GOP protocol interface from the system
   //
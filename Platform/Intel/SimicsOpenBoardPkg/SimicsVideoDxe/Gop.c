@@ -280,7 +280,9 @@ Returns:
   EFI_STATUS                      Status;
   EFI_TPL                         OriginalTPL;
   QEMU_VIDEO_PRIVATE_DATA         *Private;
+  UINT64                          StartTicks;
 
+  StartTicks = GopStatsStart ();
   Private = QEMU_VIDEO_PRIVATE_DATA_FROM_GRAPHICS_OUTPUT_THIS (This);
   //
   // We have to raise to TPL Notify, so we make an atomic write the frame buffer.
@@ -315,6 +317,8 @@ Returns:
 
   gBS->RestoreTPL (OriginalTPL);
 
+  GopStatsRecord (Private->GopStats, BltOperation, StartTicks, Status, Width, Height);
+
   return Status;
 }
 
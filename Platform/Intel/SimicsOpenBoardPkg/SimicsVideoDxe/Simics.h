@@ -30,6 +30,7 @@
 #include <Library/DevicePathLib.h>
 #include <Library/TimerLib.h>
 #include <Library/FrameBufferBltLib.h>
+#include <Library/GopStatsLib.h>
 
 #include <IndustryStandard/Pci.h>
 #include <IndustryStandard/Acpi.h>
@@ -116,6 +117,7 @@ typedef struct {
   QEMU_VIDEO_VARIANT                    Variant;
   FRAME_BUFFER_CONFIGURE                *FrameBufferBltConfigure;
   UINTN                                 FrameBufferBltConfigureSize;
+  GOP_STATS_CONTEXT                     *GopStats;
 } QEMU_VIDEO_PRIVATE_DATA;
 
 ///
@@ -263,6 +263,7 @@ ConfigurePlatformClocks (
   UINT8                         ClockAddress = CLOCK_GENERATOR_ADDRESS;
   UINTN                         VariableSize;
   EFI_PEI_READ_ONLY_VARIABLE2_PPI   *Variable;
+  VOID                          *GuidHob;
 
   //
   // Obtain Platform Info from HOB.
@@ -307,36 +308,45 @@ ConfigurePlatformClocks (
   VariableSize = sizeof (SYSTEM_CONFIGURATION);
   ZeroMem (&SystemConfiguration, sizeof (SYSTEM_CONFIGURATION));
 
-  Status = (*PeiServices)->LocatePpi (
-                             (CONST EFI_PEI_SERVICES **) PeiServices,
-                             &gEfiPeiReadOnlyVariable2PpiGuid,
-                             0,
-                             NULL,
-                             (VOID **) &Variable
-                             );
   //
-  // Use normal setup default from NVRAM variable,
-  // the Platform Mode (manufacturing/safe/normal) is handle in PeiGetVariable.
+  // Use the setup configuration already resolved by PlatformInitPei if it is published.
   //
-  VariableSize = sizeof(SYSTEM_CONFIGURATION);
-  Status = Variable->GetVariable (Variable,
-                                   L"Setup",
-                                   &gEfiSetupVariableGuid,
-                                   NULL,
-                                   &VariableSize,
-                                   &SystemConfiguration);
-  if (EFI_ERROR (Status) || VariableSize != sizeof(SYSTEM_CONFIGURATION)) {
-    //The setup variable is corrupted
+  GuidHob = GetFirstGuidHob (&gEfiSetupVariableGuid);
+  if ((GuidHob != NULL) && (GET_GUID_HOB_DATA_SIZE (GuidHob) == sizeof (SYSTEM_CONFIGURATION))) {
+    CopyMem (&SystemConfiguration, GET_GUID_HOB_DATA (GuidHob), sizeof (SYSTEM_CONFIGURATION));
+    Status = EFI_SUCCESS;
+  } else {
+    Status = (*PeiServices)->LocatePpi (
+                               (CONST EFI_PEI_SERVICES **) PeiServices,
+                               &gEfiPeiReadOnlyVariable2PpiGuid,
+                               0,
+                               NULL,
+                               (VOID **) &Variable
+                               );
+    //
+    // Use normal setup default from NVRAM variable,
+    // the Platform Mode (manufacturing/safe/normal) is handle in PeiGetVariable.
+    //
     VariableSize = sizeof(SYSTEM_CONFIGURATION);
-    Status = Variable->GetVariable(Variable,
-              L"SetupRecovery",
-              &gEfiSetupVariableGuid,
-              NULL,
-              &VariableSize,
-              &SystemConfiguration
-              );
-    ASSERT_EFI_ERROR (Status);
-  }  
+    Status = Variable->GetVariable (Variable,
+                                     L"Setup",
+                                     &gEfiSetupVariableGuid,
+                                     NULL,
+                                     &VariableSize,
+                                     &SystemConfiguration);
+    if (EFI_ERROR (Status) || VariableSize != sizeof(SYSTEM_CONFIGURATION)) {
+      //The setup variable is corrupted
+      VariableSize = sizeof(SYSTEM_CONFIGURATION);
+      Status = Variable->GetVariable(Variable,
+                L"SetupRecovery",
+                &gEfiSetupVariableGuid,
+                NULL,
+                &VariableSize,
+                &SystemConfiguration
+                );
+      ASSERT_EFI_ERROR (Status);
+    }
+  }
   if(!EFI_ERROR (Status)){
     EnableSpreadSpectrum = SystemConfiguration.EnableClockSpreadSpec;
   }
@@ -859,6 +859,16 @@ PlatformEarlyInitEntry (
     ASSERT_EFI_ERROR (Status);
   }
 
+  //
+  // Publish the resolved setup configuration, so later PEI consumers
+  // don't have to look up and validate the variable again.
+  //
+  BuildGuidDataHob (
+    &gEfiSetupVariableGuid,
+    &SystemConfiguration,
+    sizeof (SYSTEM_CONFIGURATION)
+    );
+
   CheckOsSelection(PeiServices, &SystemConfiguration);
 
   //
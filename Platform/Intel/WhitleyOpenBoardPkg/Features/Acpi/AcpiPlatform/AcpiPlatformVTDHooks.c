@@ -408,6 +408,108 @@ DMAR_ATSR* GetDmarAtsrTablePointer (
   return pAtsr;
 }
 
+//
+// Root ports of each socket, scanned once and used by both the DRHD and the
+// ATSR device scopes.
+//
+typedef struct {
+  BOOLEAN   Present;
+  UINT8     Stack;
+  UINT8     Bus;
+  UINT8     Dev;
+  UINT8     Func;
+  UINT8     DeviceType;
+} DMAR_ROOT_PORT;
+
+DMAR_ROOT_PORT            mDmarRootPorts[MAX_SOCKET][NUMBER_PORTS_PER_SOCKET];
+UINT8                     mDmarRootPortCount[MAX_SOCKET];
+
+/**
+  Scan the root ports of a socket, and record the ones to report in the DMAR.
+
+  Ports in a stack which isn't present, ports which don't respond to PCI
+  configuration cycles, dummy VMD functions and ports without link width are
+  left out.
+
+  @param DynamicSiLibraryProtocol2 - pointer to the silicon library protocol
+  @param IioIndex                  - IIO index to be processed
+  @param PciRootBridgePtr          - pointer to PciRootBridgeIo protocol for PCI access
+**/
+VOID
+ScanDmarRootPorts (
+  DYNAMIC_SI_LIBARY_PROTOCOL2     *DynamicSiLibraryProtocol2,
+  UINT8                           IioIndex,
+  EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL *PciRootBridgePtr
+  )
+{
+  EFI_STATUS                  Status;
+  DMAR_ROOT_PORT              *RootPort;
+  UINT8                       PortIndex;
+  UINT8                       MaxPortNumberPerSocket;
+  UINT32                      VidDid;
+
+  ZeroMem (&mDmarRootPorts[IioIndex][0], sizeof (mDmarRootPorts[IioIndex]));
+  mDmarRootPortCount[IioIndex] = 0;
+
+  if (PciRootBridgePtr == NULL) {
+    ASSERT (!(PciRootBridgePtr == NULL));
+    return;
+  }
+
+  MaxPortNumberPerSocket = DynamicSiLibraryProtocol2->GetMaxPortPerSocket (IioIndex);
+  if (MaxPortNumberPerSocket > MIN (NUMBER_PORTS_PER_SOCKET, ARRAY_SIZE (mDevScopeATSR10nm))) {
+    ASSERT (FALSE);
+    MaxPortNumberPerSocket = (UINT8) MIN (NUMBER_PORTS_PER_SOCKET, ARRAY_SIZE (mDevScopeATSR10nm));
+  }
+  mDmarRootPortCount[IioIndex] = MaxPortNumberPerSocket;
+
+  for (PortIndex = 1; PortIndex < MaxPortNumberPerSocket; PortIndex++) {
+
+    RootPort = &mDmarRootPorts[IioIndex][PortIndex];
+    RootPort->Stack = DynamicSiLibraryProtocol2->GetStackPerPort (IioIndex, PortIndex);
+    if (!DynamicSiLibraryProtocol2->IfStackPresent (IioIndex, RootPort->Stack)) {
+      DEBUG ((DEBUG_WARN, "[ACPI](DMAR) [%d.%d p%d] Stack not present\n", IioIndex, RootPort->Stack, PortIndex));
+      continue;
+    }
+
+    RootPort->Bus  = DynamicSiLibraryProtocol2->GetSocketPortBusNum (IioIndex, PortIndex);
+    RootPort->Dev  = mDevScopeATSR10nm[PortIndex].PciNode->Device;
+    RootPort->Func = mDevScopeATSR10nm[PortIndex].PciNode->Function;
+    if (DynamicSiLibraryProtocol2->IioNtbIsEnabled (IioIndex, PortIndex, &RootPort->Dev, &RootPort->Func)) {
+
+      RootPort->DeviceType = EFI_ACPI_DEVICE_SCOPE_ENTRY_TYPE_PCI_ENDPOINT;
+    } else {
+      RootPort->DeviceType = EFI_ACPI_DEVICE_SCOPE_ENTRY_TYPE_PCI_BRIDGE;
+    }
+    //
+    // Skip root ports which do not respond to PCI configuration cycles.
+    //
+    VidDid = 0;
+    Status = PciRootBridgePtr->Pci.Read (
+                PciRootBridgePtr,
+                EfiPciWidthUint32,
+                EFI_PCI_ADDRESS (RootPort->Bus, RootPort->Dev, RootPort->Func, 0),
+                1,
+                &VidDid);
+    if (EFI_ERROR (Status) || VidDid == 0xffffffff) {
+
+      DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] %02X:%02X:%02X.%d Hidden (%X) - skip\n",
+              IioIndex, RootPort->Stack, PortIndex,
+              mIioUds2->IioUdsPtr->PlatformData.CpuQpiInfo[IioIndex].PcieSegment,
+              RootPort->Bus, RootPort->Dev, RootPort->Func, VidDid));
+      continue;
+    }
+    if (DynamicSiLibraryProtocol2->IioVmdPortIsEnabled (IioIndex, PortIndex) || DynamicSiLibraryProtocol2->GetCurrentPXPMap (IioIndex, PortIndex) == 0) {
+
+      DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] %a - skip\n", IioIndex, RootPort->Stack, PortIndex,
+              (DynamicSiLibraryProtocol2->GetCurrentPXPMap (IioIndex, PortIndex) == 0) ? "Link width not set" : "Dummy VMD function"));
+      continue;
+    }
+
+    RootPort->Present = TRUE;
+  }
+}
+
 
 /**
   Enable VT-d interrupt remapping.
@@ -708,17 +810,12 @@ BuildDRHDForStack (
   )
 {
   EFI_STATUS                  Status = EFI_SUCCESS;
-  UINT8                       Bus;
-  UINT8                       Dev;
-  UINT8                       Func;
   UINT8                       DevIndex;
   UINT8                       PciNodeIndex;
   UINT8                       PortIndex;
-  UINT8                       MaxPortNumberPerSocket;
   UINT8                       CBIndex;
   UINT32                      VtdBase;
-  UINT32                      VidDid;
-  DMAR_ATSR                   *pAtsr = NULL;
+  DMAR_ROOT_PORT              *RootPort;
   DYNAMIC_SI_LIBARY_PROTOCOL2  *DynamicSiLibraryProtocol2 = NULL;
 
   Status = gBS->LocateProtocol (&gDynamicSiLibraryProtocol2Guid, NULL, (VOID **) &DynamicSiLibraryProtocol2);
@@ -781,57 +878,20 @@ BuildDRHDForStack (
   }
 
   //
-  // DRHD - PCI-Ex ports
+  // DRHD - PCI-Ex ports, as found by ScanDmarRootPorts()
   //
-  pAtsr = GetDmarAtsrTablePointer ();
-  MaxPortNumberPerSocket = DynamicSiLibraryProtocol2->GetMaxPortPerSocket (IioIndex);
-  for (PortIndex = 1; PortIndex < MaxPortNumberPerSocket; PortIndex++) {
+  for (PortIndex = 1; PortIndex < mDmarRootPortCount[IioIndex]; PortIndex++) {
 
-    if (DynamicSiLibraryProtocol2->GetStackPerPort (IioIndex, PortIndex) != Stack) {
-      continue;
-    }
-    Bus = DynamicSiLibraryProtocol2->GetSocketPortBusNum (IioIndex, PortIndex);
-    Dev = 0;
-    Func = 0;
-    if (pAtsr != NULL) {
-      Dev = pAtsr->DeviceScope[PortIndex].PciNode->Device;
-      Func = pAtsr->DeviceScope[PortIndex].PciNode->Function;
-    }
-    if (DynamicSiLibraryProtocol2->IioNtbIsEnabled (IioIndex, PortIndex, &Dev, &Func)) {
-
-      DevScope[DevIndex].DeviceType = EFI_ACPI_DEVICE_SCOPE_ENTRY_TYPE_PCI_ENDPOINT;
-    } else {
-      DevScope[DevIndex].DeviceType = EFI_ACPI_DEVICE_SCOPE_ENTRY_TYPE_PCI_BRIDGE;
-    }
-    //
-    // Skip root ports which do not respond to PCI configuration cycles.
-    //
-    VidDid = 0;
-    Status = PciRootBridgePtr->Pci.Read (
-                PciRootBridgePtr,
-                EfiPciWidthUint32,
-                EFI_PCI_ADDRESS (Bus, Dev, Func, 0),
-                1,
-                &VidDid);
-    if (EFI_ERROR (Status) || VidDid == 0xffffffff) {
-
-      DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] %02X:%02X:%02X.%d Hidden (%X) - skip\n",
-              IioIndex, Stack, PortIndex,
-              mIioUds2->IioUdsPtr->PlatformData.CpuQpiInfo[IioIndex].PcieSegment,
-              Bus, Dev, Func, VidDid));
-      continue;
-    }
-    if (DynamicSiLibraryProtocol2->IioVmdPortIsEnabled (IioIndex, PortIndex) || DynamicSiLibraryProtocol2->GetCurrentPXPMap (IioIndex, PortIndex) == 0) {
-
-      DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] %a - skip\n", IioIndex, Stack, PortIndex,
-              (DynamicSiLibraryProtocol2->GetCurrentPXPMap (IioIndex, PortIndex) == 0) ? "Link width not set" : "Dummy VMD function"));
+    RootPort = &mDmarRootPorts[IioIndex][PortIndex];
+    if (!RootPort->Present || RootPort->Stack != Stack) {
       continue;
     }
+    DevScope[DevIndex].DeviceType         = RootPort->DeviceType;
     DevScope[DevIndex].EnumerationID      = 00;
-    DevScope[DevIndex].StartBusNumber     = Bus;
+    DevScope[DevIndex].StartBusNumber     = RootPort->Bus;
     DevScope[DevIndex].PciNode            = &PciNode[PciNodeIndex];
-    PciNode[PciNodeIndex].Device          = Dev;
-    PciNode[PciNodeIndex].Function        = Func;
+    PciNode[PciNodeIndex].Device          = RootPort->Dev;
+    PciNode[PciNodeIndex].Function        = RootPort->Func;
     DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] Build DRHD PCI: Type %d, EnumId %d, StartBus 0x%x, PciNode %02X.%X\n",
             IioIndex, Stack, PortIndex,
             DevScope[DevIndex].DeviceType, DevScope[DevIndex].EnumerationID, DevScope[DevIndex].StartBusNumber,
@@ -880,12 +940,12 @@ ReportDmar (
   )
 {
   EFI_STATUS                      Status = EFI_SUCCESS;
-  UINT8                           SocketIndex, Bus;
-  UINT8                           Dev, Func;
+  UINT8                           SocketIndex;
   UINT8                           DevIndex;
   UINT8                           PciNodeIndex;
   UINT8                           PciPortIndex;
-  UINT8                           MaxPortNumberPerSocket;
+  DMAR_ROOT_PORT                  *RootPort;
+  BOOLEAN                         StackDevTlb[MAX_IIO_STACK];
   UINT64                          VtdMmioExtCap;
   UINT32                          VtdBase;
   VTD_SUPPORT_INSTANCE            *DmarPrivateData;
@@ -900,7 +960,6 @@ ReportDmar (
   EFI_CPUID_REGISTER              CpuidRegisters;
   EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL *PciRootBridgePtr;
   EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL *PciRootBridgeTab[MAX_SOCKET];
-  UINT32                          VidDid;
   UINT8                           Index;
   UINT8                           Stack = 0;
   UINT8                           FirstRun = 0;
@@ -1011,6 +1070,8 @@ ReportDmar (
     }
     PciRootBridgePtr = PciRootBridgeTab[mIioUds2->IioUdsPtr->PlatformData.CpuQpiInfo[SocketIndex].PcieSegment];
 
+    ScanDmarRootPorts (DynamicSiLibraryProtocol2, SocketIndex, PciRootBridgePtr);
+
     Stack = IIO_STACK0;
     VtdBase = DynamicSiLibraryProtocol2->GetVtdBar (SocketIndex, Stack);
 
@@ -1191,7 +1252,6 @@ ReportDmar (
       if (mIioUds2->IioUdsPtr->PlatformData.CpuQpiInfo[SocketIndex].PcieSegment >= MAX_SOCKET) {
         return EFI_INVALID_PARAMETER;
       }
-      PciRootBridgePtr = PciRootBridgeTab[mIioUds2->IioUdsPtr->PlatformData.CpuQpiInfo[SocketIndex].PcieSegment];
 
       PciNodeIndex            = 00;
       DevIndex                = 00;
@@ -1209,84 +1269,48 @@ ReportDmar (
       }
 
       //
-      // Loop From Port 1 to 15 for Legacy IOH and 0 to 15 for Non-Legacy IOH
+      // ATSR is applicable only for platform supporting device IOTLBs through the VT-d extended capability register
       //
-      MaxPortNumberPerSocket = DynamicSiLibraryProtocol2->GetMaxPortPerSocket (SocketIndex);
-      for (PciPortIndex = 1; PciPortIndex < MaxPortNumberPerSocket; PciPortIndex++)  {
-        //
-        // Check device IOTLBs supported or not in VT-d Extended capability register
-        //
-        Stack = DynamicSiLibraryProtocol2->GetStackPerPort (SocketIndex, PciPortIndex);
-        //
-        // Check for a valid stack
-        //
-        if (!(DynamicSiLibraryProtocol2->IfStackPresent (SocketIndex, Stack))) {
-          DEBUG ((DEBUG_WARN, "[ACPI](DMAR) [%d.%d p%d] Stack not present\n", SocketIndex, Stack, PciPortIndex));
+      for (Stack = 0; Stack < MAX_IIO_STACK; Stack++) {
+        StackDevTlb[Stack] = FALSE;
+        if (!DynamicSiLibraryProtocol2->IfStackPresent (SocketIndex, Stack)) {
           continue;
         }
 
         VtdBase = DynamicSiLibraryProtocol2->GetVtdBar (SocketIndex, Stack);
         if (VtdBase != 0) {
-
           VtdMmioExtCap = *(volatile UINT64*)((UINTN)VtdBase + R_VTD_EXT_CAP_LOW);
-          //
-          // ATSR is applicable only for platform supporting device IOTLBs through the VT-d extended capability register
-          //
-          if ((VtdMmioExtCap & BIT2) != 0) {
-
-            Bus = DynamicSiLibraryProtocol2->GetSocketPortBusNum (SocketIndex,PciPortIndex);
-            Dev = 0;
-            Func = 0;
-            Dev = mDevScopeATSR10nm[PciPortIndex].PciNode->Device;
-            Func = mDevScopeATSR10nm[PciPortIndex].PciNode->Function;
-            if (DynamicSiLibraryProtocol2->IioNtbIsEnabled (SocketIndex, PciPortIndex, &Dev, &Func)) {
-              DevScope[DevIndex].DeviceType = EFI_ACPI_DEVICE_SCOPE_ENTRY_TYPE_PCI_ENDPOINT;
-            } else {
-              DevScope[DevIndex].DeviceType = EFI_ACPI_DEVICE_SCOPE_ENTRY_TYPE_PCI_BRIDGE;
-            }
-            //
-            // Skip root ports which do not respond to PCI configuration cycles.
-            //
-            VidDid = 0;
-            Status = PciRootBridgePtr->Pci.Read (
-                      PciRootBridgePtr,
-                      EfiPciWidthUint32,
-                      EFI_PCI_ADDRESS (Bus, Dev, Func, 0),
-                      1,
-                      &VidDid);
-            if (EFI_ERROR (Status) || VidDid == 0xffffffff) {
-
-              DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] %02X:%02X:%02X.%d Hidden (%X) - skip\n",
-                      SocketIndex, Stack, PciPortIndex,
-                      mIioUds2->IioUdsPtr->PlatformData.CpuQpiInfo[SocketIndex].PcieSegment,
-                      Bus, Dev, Func, VidDid));
-              continue;
-            }
-            if (DynamicSiLibraryProtocol2->IioVmdPortIsEnabled (SocketIndex, PciPortIndex) || DynamicSiLibraryProtocol2->GetCurrentPXPMap (SocketIndex, PciPortIndex) == 0) {
+          StackDevTlb[Stack] = (BOOLEAN) ((VtdMmioExtCap & BIT2) != 0);
+        }
+      }
 
-              DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] %a - skip\n", SocketIndex, Stack, PciPortIndex,
-                      (DynamicSiLibraryProtocol2->GetCurrentPXPMap (SocketIndex, PciPortIndex) == 0) ? "Link width not set" : "Dummy VMD function"));
-              continue;
-            }
-            DevScope[DevIndex].EnumerationID      = 00;
-            DevScope[DevIndex].StartBusNumber     = Bus;
-            DevScope[DevIndex].PciNode            = &PciNode[PciNodeIndex];
-            PciNode[PciNodeIndex].Device   = Dev;
-            PciNode[PciNodeIndex].Function = Func;
-            DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] Build DRHD PCI: Type %d, EnumId %d, StartBus 0x%x, PciNode %02X.%X\n",
-                    SocketIndex, Stack, PciPortIndex,
-                    DevScope[DevIndex].DeviceType, DevScope[DevIndex].EnumerationID, DevScope[DevIndex].StartBusNumber,
-                    DevScope[DevIndex].PciNode->Device, DevScope[DevIndex].PciNode->Function));
-            DevIndex++;
-            PciNodeIndex++;
-            PciNode[PciNodeIndex].Device    = (UINT8) -1;
-            PciNode[PciNodeIndex].Function  = (UINT8) -1;
-            PciNodeIndex++;
-            if(pAtsr != NULL){
-              pAtsr->DeviceScopeNumber++;
-            }
-          } // End of if ((VtdMmioExtCap & BIT2) != 0)
-        } // End of if VtdBase
+      //
+      // Loop From Port 1 to 15 for Legacy IOH and 0 to 15 for Non-Legacy IOH
+      //
+      for (PciPortIndex = 1; PciPortIndex < mDmarRootPortCount[SocketIndex]; PciPortIndex++)  {
+        RootPort = &mDmarRootPorts[SocketIndex][PciPortIndex];
+        if (!RootPort->Present || RootPort->Stack >= MAX_IIO_STACK || !StackDevTlb[RootPort->Stack]) {
+          continue;
+        }
+        Stack = RootPort->Stack;
+        DevScope[DevIndex].DeviceType         = RootPort->DeviceType;
+        DevScope[DevIndex].EnumerationID      = 00;
+        DevScope[DevIndex].StartBusNumber     = RootPort->Bus;
+        DevScope[DevIndex].PciNode            = &PciNode[PciNodeIndex];
+        PciNode[PciNodeIndex].Device   = RootPort->Dev;
+        PciNode[PciNodeIndex].Function = RootPort->Func;
+        DEBUG ((DEBUG_INFO, "[ACPI](DMAR) [%d.%d p%d] Build DRHD PCI: Type %d, EnumId %d, StartBus 0x%x, PciNode %02X.%X\n",
+                SocketIndex, Stack, PciPortIndex,
+                DevScope[DevIndex].DeviceType, DevScope[DevIndex].EnumerationID, DevScope[DevIndex].StartBusNumber,
+                DevScope[DevIndex].PciNode->Device, DevScope[DevIndex].PciNode->Function));
+        DevIndex++;
+        PciNodeIndex++;
+        PciNode[PciNodeIndex].Device    = (UINT8) -1;
+        PciNode[PciNodeIndex].Function  = (UINT8) -1;
+        PciNodeIndex++;
+        if(pAtsr != NULL){
+          pAtsr->DeviceScopeNumber++;
+        }
       } // for (PciPortIndex...)
 
       if (pAtsr != NULL){
@@ -174,6 +174,32 @@ LastStackWithResources (
 }
 
 
+/**
+  Calculate the padding needed in front of a stack so that its base is aligned
+  the way the stack resource request was sized.
+
+  @param Base              - Base address the stack would start at
+  @param Alignment         - Alignment of the stack resource request
+
+  @return The number of bytes to skip before the stack base.
+*/
+UINT64
+StackAlignmentPadding (
+  IN UINT64             Base,
+  IN UINT64             Alignment
+  )
+{
+  //
+  // Only power of two alignments come from device requests. Other values are
+  // the size of reserved ranges, which do not constrain the placement.
+  //
+  if ((Alignment <= 1) || ((Alignment & (Alignment - 1)) != 0)) {
+    return 0;
+  }
+  return ALIGN_VALUE (Base, Alignment) - Base;
+}
+
+
 /**
   Visit all stacks in this socket and recalculate the resource ranges per stack based on resource
   needs from PCI/PCIe device/functions.
@@ -1140,9 +1166,9 @@ AdjustResourceAmongRootBridges (
     //
     Status = AdjustSocketResources (SocketResources, TypeMem64, ValidSockets);
     if (Status == EFI_SUCCESS) {
-      ChangedBitMap |= (1 << TypeIndex);
+      ChangedBitMap |= (1 << TypeMem64);
     } else {
-      ChangedBitMap &= ~(1 << TypeIndex);
+      ChangedBitMap &= ~(1 << TypeMem64);
     }
   }
 
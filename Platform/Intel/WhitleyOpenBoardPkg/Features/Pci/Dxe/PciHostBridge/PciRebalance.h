@@ -137,6 +137,21 @@ LastStackWithResources (
      OUT UINT64            *ResourceSize
   );
 
+/**
+  Calculate the padding needed in front of a stack so that its base is aligned
+  the way the stack resource request was sized.
+
+  @param Base              - Base address the stack would start at
+  @param Alignment         - Alignment of the stack resource request
+
+  @return The number of bytes to skip before the stack base.
+*/
+UINT64
+StackAlignmentPadding (
+  IN UINT64             Base,
+  IN UINT64             Alignment
+  );
+
 /**
  Find socket and stack index for given PCI Root Bridge protocol pointer.
 
@@ -43,6 +43,8 @@ AdjustSocketMmioL (
   UINT32      UboxMmioSize;
   UINT64      ResourceSize;
   UINT64      TotalResourceSize;
+  UINT64      Padding;
+  UINT8       PrevStack;
   UINT32      TempMmioBase;
   UINT32      TempMmioLimit;
 
@@ -96,26 +98,14 @@ AdjustSocketMmioL (
   DEBUG ((DEBUG_INFO, "Total Request MMIOL Range = %08Xh\n", TotalResourceSize));
   DEBUG ((DEBUG_INFO, "Total System MMIOL Range  = %08Xh\n", (TempMmioLimit - TempMmioBase + 1)));
   if (TotalResourceSize > (TempMmioLimit - TempMmioBase + 1)) {
-    //
-    // Not enough system resources to support the request.
-    // Remove all request to update NVRAM variable for this resource type.
-    //
-    for (Socket = 0; Socket < ValidSockets; Socket ++) {
-      for (Stack = 0; Stack < MAX_IIO_STACK; Stack ++) {
-        if (!(mIioUds->IioUdsPtr->PlatformData.CpuQpiInfo[Socket].stackPresentBitmap & (1 << Stack))) {
-          continue;
-        }
-        SocketResources[Socket].StackRes[Stack].MmiolUpdate = 0;
-      }
-    }
-    DEBUG ((DEBUG_ERROR, "[PCI] ERROR: Out of adjustable MMIOL resources. Can't adjust across sockets\n"));
-    return EFI_OUT_OF_RESOURCES;
+    goto OutOfResources;
   }
 
   DEBUG ((DEBUG_ERROR, "Assigning new socket MMIOL range...\n"));
   for (Socket = 0, TempMmioLimit = TempMmioBase - 1; Socket < ValidSockets; Socket ++) {
 
     SocketResources[Socket].MmiolBase = TempMmioLimit + 1;
+    PrevStack = MAX_IIO_STACK;
     //
     // Update the stacks base and limit values.
     //
@@ -128,6 +118,17 @@ AdjustSocketMmioL (
 
       } else {
 
+        if ((SocketResources[Socket].StackRes[Stack].MmiolLength != 0) && (PrevStack < MAX_IIO_STACK)) {
+          //
+          // The alignment padding of this stack was calculated for its old base. Grow the
+          // previous stack so this one still starts aligned at its new base, otherwise the
+          // request does not fit on the next boot and yet another rebalance reset is needed.
+          //
+          Padding = StackAlignmentPadding (TempMmioLimit + 1, SocketResources[Socket].StackRes[Stack].MmiolAlignment);
+          SocketResources[Socket].StackRes[PrevStack].MmiolLength += (UINT32) Padding;
+          SocketResources[Socket].StackRes[PrevStack].MmiolLimit += (UINT32) Padding;
+          TempMmioLimit += (UINT32) Padding;
+        }
         SocketResources[Socket].StackRes[Stack].MmiolBase = TempMmioLimit + 1;
         if (SocketResources[Socket].StackRes[Stack].MmiolLength != 0) {
           //
@@ -136,6 +137,7 @@ AdjustSocketMmioL (
           //
           TempMmioLimit += SocketResources[Socket].StackRes[Stack].MmiolLength + 1;
           SocketResources[Socket].StackRes[Stack].MmiolLimit = TempMmioLimit;
+          PrevStack = Stack;
 
         } else {
 
@@ -158,6 +160,29 @@ AdjustSocketMmioL (
     SocketResources[Socket].MmiolLimit = TempMmioLimit;
   } // for (Socket...)
 
+  //
+  // The alignment padding added above may push the last stacks past the end of
+  // the system range.
+  //
+  if (TempMmioLimit > mIioUds->IioUdsPtr->PlatformData.PlatGlobalMmio32Limit) {
+    goto OutOfResources;
+  }
   return EFI_SUCCESS;
+
+OutOfResources:
+  //
+  // Not enough system resources to support the request.
+  // Remove all request to update NVRAM variable for this resource type.
+  //
+  for (Socket = 0; Socket < ValidSockets; Socket ++) {
+    for (Stack = 0; Stack < MAX_IIO_STACK; Stack ++) {
+      if (!(mIioUds->IioUdsPtr->PlatformData.CpuQpiInfo[Socket].stackPresentBitmap & (1 << Stack))) {
+        continue;
+      }
+      SocketResources[Socket].StackRes[Stack].MmiolUpdate = 0;
+    }
+  }
+  DEBUG ((DEBUG_ERROR, "[PCI] ERROR: Out of adjustable MMIOL resources. Can't adjust across sockets\n"));
+  return EFI_OUT_OF_RESOURCES;
 }
 
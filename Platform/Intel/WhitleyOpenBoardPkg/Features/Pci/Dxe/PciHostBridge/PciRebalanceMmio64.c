@@ -47,6 +47,8 @@ AdjustSocketMmioH (
   UINT64      MaxMmioh;
   UINT64      ResourceSize;
   UINT64      TotalResourceSize;
+  UINT64      Padding;
+  UINT8       PrevStack;
   UINT64      TempMmioBase;
   UINT64      TempMmioLimit;
 
@@ -142,26 +144,14 @@ AdjustSocketMmioH (
   DEBUG ((DEBUG_INFO, "Total Request MMIOH Range= %016llXh\n", TotalResourceSize));
   DEBUG ((DEBUG_INFO, "Total System MMIOH Range = %016llXh\n", (MaxMmioh - TempMmioBase)));
   if (TotalResourceSize > MaxMmioh) {
-    //
-    // Not enough system resources to support the request.
-    // Remove all request to update NVRAM variable for this resource type.
-    //
-    for (Socket = 0; Socket < ValidSockets; Socket ++) {
-      for (Stack = 0; Stack < MAX_IIO_STACK; Stack ++) {
-        if (!(mIioUds->IioUdsPtr->PlatformData.CpuQpiInfo[Socket].stackPresentBitmap & (1 << Stack))) {
-          continue;
-        }
-        SocketResources[Socket].StackRes[Stack].MmiohUpdate = 0;
-      }
-    }
-    DEBUG ((DEBUG_ERROR, "[PCI] ERROR: Out of adjustable MMIOH resources. Can't adjust across sockets\n"));
-    return EFI_OUT_OF_RESOURCES;
+    goto OutOfResources;
   }
 
   DEBUG ((DEBUG_ERROR, "Assigning new socket MMIOH range...\n"));
   for (Socket = 0, TempMmioLimit = TempMmioBase - 1; Socket < ValidSockets; Socket++) {
 
     SocketResources[Socket].MmiohBase = TempMmioLimit + 1;
+    PrevStack = MAX_IIO_STACK;
     //
     // Update the stacks base and limit values.
     //
@@ -174,6 +164,17 @@ AdjustSocketMmioH (
 
       } else {
 
+        if ((SocketResources[Socket].StackRes[Stack].MmiohLength != 0) && (PrevStack < MAX_IIO_STACK)) {
+          //
+          // The alignment padding of this stack was calculated for its old base. Grow the
+          // previous stack so this one still starts aligned at its new base, otherwise the
+          // request does not fit on the next boot and yet another rebalance reset is needed.
+          //
+          Padding = StackAlignmentPadding (TempMmioLimit + 1, SocketResources[Socket].StackRes[Stack].MmiohAlignment);
+          SocketResources[Socket].StackRes[PrevStack].MmiohLength += Padding;
+          SocketResources[Socket].StackRes[PrevStack].MmiohLimit += Padding;
+          TempMmioLimit += Padding;
+        }
         SocketResources[Socket].StackRes[Stack].MmiohBase = TempMmioLimit + 1;
         if (SocketResources[Socket].StackRes[Stack].MmiohLength != 0) {
           //
@@ -182,6 +183,7 @@ AdjustSocketMmioH (
           //
           TempMmioLimit += SocketResources[Socket].StackRes[Stack].MmiohLength + 1;
           SocketResources[Socket].StackRes[Stack].MmiohLimit = TempMmioLimit;
+          PrevStack = Stack;
 
         } else {
 
@@ -199,6 +201,29 @@ AdjustSocketMmioH (
 
     SocketResources[Socket].MmiohLimit = TempMmioLimit;
   } // for (Socket...)
+  //
+  // The alignment padding added above may push the last stacks past the end of
+  // the system range.
+  //
+  if ((TempMmioLimit - TempMmioBase + 1) > MaxMmioh) {
+    goto OutOfResources;
+  }
   return EFI_SUCCESS;
+
+OutOfResources:
+  //
+  // Not enough system resources to support the request.
+  // Remove all request to update NVRAM variable for this resource type.
+  //
+  for (Socket = 0; Socket < ValidSockets; Socket ++) {
+    for (Stack = 0; Stack < MAX_IIO_STACK; Stack ++) {
+      if (!(mIioUds->IioUdsPtr->PlatformData.CpuQpiInfo[Socket].stackPresentBitmap & (1 << Stack))) {
+        continue;
+      }
+      SocketResources[Socket].StackRes[Stack].MmiohUpdate = 0;
+    }
+  }
+  DEBUG ((DEBUG_ERROR, "[PCI] ERROR: Out of adjustable MMIOH resources. Can't adjust across sockets\n"));
+  return EFI_OUT_OF_RESOURCES;
 }
 
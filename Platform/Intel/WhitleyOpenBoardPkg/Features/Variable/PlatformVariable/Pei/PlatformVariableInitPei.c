@@ -15,6 +15,8 @@
 #include "PlatformVariableInitPei.h"
 #include <Guid/PlatformVariableCommon.h>
 #include <Uefi/UefiInternalFormRepresentation.h>
+#include <Guid/AuthenticatedVariableFormat.h>
+#include <Guid/VariableFormat.h>
 
 UINT16 BoardId = BOARD_ID_DEFAULT;
 
@@ -24,12 +26,35 @@ EFI_PEI_PPI_DESCRIPTOR  mPpiListPlatformVariableInit = {
   NULL
 };
 
+/**
+Check whether the default variable store HOB was already built during this boot.
+
+The FCE generated default store is copied into the HOB as a whole and the core
+variable driver only consumes the first such HOB, so building it a second time
+(for example when both the boot mode and the missing setup variable request
+defaults) only costs another FFS search and copy of every default.
+
+@retval TRUE   A default variable store HOB exists.
+@retval FALSE  No default variable store HOB exists yet.
+**/
+STATIC
+BOOLEAN
+DefaultVariableHobExists (
+  VOID
+  )
+{
+  return (BOOLEAN)((GetFirstGuidHob (&gEfiAuthenticatedVariableGuid) != NULL) ||
+                   (GetFirstGuidHob (&gEfiVariableGuid) != NULL));
+}
+
 /**
 Apply platform variable defaults.
 
 Create HOBs and set PCDs to prompt the (re-)loading of variable defaults.
 Each step is attempted regardless of whether the previous steps succeeded.
 If multiple errors occur, only the last error code is returned.
+If defaults were already applied during this boot, the events are merged into
+the existing HOB and the default variable store is not rebuilt.
 
 @param[in]  Events            Bitmap of events that occurred.
 @param[in]  DefaultId         Default store ID, STANDARD or MANUFACTURING.
@@ -46,6 +71,7 @@ ApplyPlatformVariableDefaults(
   )
 {
   VOID        *Hob;
+  UINT8       *ExistingEvents;
   EFI_STATUS  Status;
   EFI_STATUS  ReturnStatus;
 
@@ -59,22 +85,34 @@ ApplyPlatformVariableDefaults(
   ReturnStatus = EFI_SUCCESS;
 
   //
-  // Send the bitmap of events to the platform variable DXE driver.
+  // Send the bitmap of events to the platform variable DXE driver. The DXE
+  // driver only reads the first HOB, so merge into it if one already exists.
   //
-  Hob = BuildGuidDataHob(&gPlatformVariableHobGuid, &Events, sizeof(Events));
-  if (Hob == NULL) {
-    DEBUG((DEBUG_ERROR, "Create platform var event HOB: %r!\n", EFI_OUT_OF_RESOURCES));
-    ReturnStatus = EFI_OUT_OF_RESOURCES;
+  Hob = GetFirstGuidHob(&gPlatformVariableHobGuid);
+  if (Hob != NULL) {
+    ExistingEvents = GET_GUID_HOB_DATA(Hob);
+    *ExistingEvents |= Events;
+  } else {
+    Hob = BuildGuidDataHob(&gPlatformVariableHobGuid, &Events, sizeof(Events));
+    if (Hob == NULL) {
+      DEBUG((DEBUG_ERROR, "Create platform var event HOB: %r!\n", EFI_OUT_OF_RESOURCES));
+      ReturnStatus = EFI_OUT_OF_RESOURCES;
+    }
   }
 
   //
   // Locate variable default data in FFS and send it to the core variable DXE
-  // driver to write.
+  // driver to write. The whole store is copied at once, so skip it if an
+  // earlier callback already built it.
   //
-  Status = CreateDefaultVariableHob(DefaultId, BoardId);
-  if (EFI_ERROR(Status)) {
-    DEBUG((DEBUG_ERROR, "create default var HOB: %r!\n", Status));
-    ReturnStatus = Status;
+  if (DefaultVariableHobExists()) {
+    DEBUG((DEBUG_INFO, "Default var HOB already built, not rebuilding\n"));
+  } else {
+    Status = CreateDefaultVariableHob(DefaultId, BoardId);
+    if (EFI_ERROR(Status)) {
+      DEBUG((DEBUG_ERROR, "create default var HOB: %r!\n", Status));
+      ReturnStatus = Status;
+    }
   }
 
   //
@@ -168,7 +206,9 @@ PlatformVariablePeiInit(
     // Normal case boot flow
     //
     Events = 0; // no events occurred
-    BuildGuidDataHob (&gPlatformVariableHobGuid, &Events, sizeof (UINT8));
+    if (GetFirstGuidHob (&gPlatformVariableHobGuid) == NULL) {
+      BuildGuidDataHob (&gPlatformVariableHobGuid, &Events, sizeof (UINT8));
+    }
 
     //
     // Patch RP variable value with PC variable in the begining of PEI
@@ -21,6 +21,7 @@ import sys
 import glob
 import signal
 import shutil
+import hashlib
 import argparse
 import traceback
 import subprocess
@@ -463,14 +464,19 @@ def post_build(config):
             if os.name == "posix": # linux
                 shell = False
 
-            _, _, result, return_code = execute_script(command, config, shell=shell)
-            if return_code != 0:
-                print("Error while generating fit")
-            else:
-                # copy output to final binary
-                shutil.copyfile(temp_fd, final_fd)
-                # remove temp file
-                os.remove(temp_fd)
+            def generate_fit():
+                _, _, result, return_code = execute_script(command, config, shell=shell)
+                if return_code != 0:
+                    print("Error while generating fit")
+                else:
+                    # copy output to final binary
+                    shutil.copyfile(temp_fd, final_fd)
+                    # remove temp file
+                    os.remove(temp_fd)
+                return return_code
+
+            run_cached_step(config, "FitGen", " ".join(command),
+                            [final_fd], [final_fd], generate_fit)
         else:
             print("{} does not exist".format(final_fd))
             # remove temp file
@@ -596,7 +602,8 @@ def post_build_ex(config):
             platform_function =\
                 import_platform_lib(config["ADDITIONAL_SCRIPTS"],
                                     "post_build_ex")
-            functions = {"execute_script": execute_script}
+            functions = {"execute_script": execute_script,
+                         "run_cached_step": run_cached_step}
             return platform_function(config, functions)
         except ImportError as error:
             print(config["ADDITIONAL_SCRIPTS"], str(error))
@@ -625,6 +632,83 @@ def clean_ex(config):
     return None
 
 
+def file_digest(path):
+    """Gets the SHA-256 digest of a file's content
+
+        :param path: The file to hash
+        :type path: String
+        :returns: The hex digest of the file's content
+        :rtype: String
+    """
+    sha = hashlib.sha256()
+    with open(path, "rb") as file_obj:
+        for chunk in iter(lambda: file_obj.read(1024 * 1024), b""):
+            sha.update(chunk)
+    return sha.hexdigest()
+
+
+def run_cached_step(config, name, command_key, inputs, outputs, step):
+    """Runs a post build step, or restores its outputs from the last run
+        of the step when the step and its inputs did not change.
+
+        Only enabled with --hash. The digest of the command and the input
+        files is recorded next to a copy of the outputs in
+        BUILD_DIR_PATH/PostBuildCache/<name>. A no-op rebuild regenerates
+        the same inputs, so the outputs are copied back without running
+        the step. An output may also be one of the inputs, for steps that
+        patch a file in place.
+
+        :param config: The environment variables used in the build process
+        :type config: Dictionary
+        :param name: A unique name of the step
+        :type name: String
+        :param command_key: Everything besides the input files that affects
+            the outputs, typically the command line
+        :type command_key: String
+        :param inputs: The files the step reads
+        :type inputs: List:String
+        :param outputs: The files the step writes
+        :type outputs: List:String
+        :param step: Runs the step and returns its return code
+        :type step: Function
+        :returns: The return code of the step, 0 if it was skipped
+        :rtype: Integer
+    """
+    if config.get("POST_BUILD_CACHE", "FALSE") != "TRUE":
+        return step()
+
+    cache_dir = os.path.join(config["BUILD_DIR_PATH"], "PostBuildCache", name)
+    stamp_file = os.path.join(cache_dir, "inputs.sha256")
+    cached_outputs = [os.path.join(cache_dir, "{}_{}".format(index, os.path.basename(item)))
+                      for index, item in enumerate(outputs)]
+
+    sha = hashlib.sha256(command_key.encode())
+    for item in inputs:
+        sha.update(file_digest(item).encode())
+    key = sha.hexdigest()
+
+    if os.path.isfile(stamp_file) and all(os.path.isfile(item) for item in cached_outputs):
+        with open(stamp_file, "r") as stamp:
+            if stamp.read().strip() == key:
+                print("{} inputs unchanged, reusing its outputs".format(name))
+                for cached, output in zip(cached_outputs, outputs):
+                    shutil.copyfile(cached, output)
+                return 0
+
+    return_code = step()
+    if return_code == 0:
+        if not os.path.isdir(cache_dir):
+            os.makedirs(cache_dir)
+        # drop the stamp first, a partially updated cache must not be used
+        if os.path.isfile(stamp_file):
+            os.remove(stamp_file)
+        for cached, output in zip(cached_outputs, outputs):
+            shutil.copyfile(output, cached)
+        with open(stamp_file, "w") as stamp:
+            stamp.write(key)
+    return return_code
+
+
 def get_environment_variables(std_out_str, marker):
     """Gets the environment variables from a process
 
@@ -937,6 +1021,9 @@ def get_cmd_config_arguments(arguments):
     if arguments.fspapi is True:
         result["API_MODE_FSP_WRAPPER_BUILD"] = "TRUE"
 
+    if arguments.UseHashCache:
+        result["POST_BUILD_CACHE"] = "TRUE"
+
     if not arguments.UseHashCache:
         result['BINARY_CACHE_CMD_LINE'] = ''
     elif arguments.BinCacheDest:
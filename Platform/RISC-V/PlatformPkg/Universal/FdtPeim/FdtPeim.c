@@ -16,6 +16,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Guid/FdtHob.h>
 
+//
+// Free space DXE may need to fix up the device tree in place.
+//
+#define FDT_IN_PLACE_MIN_FREE_SPACE  SIZE_1KB
+
 /**
   The entrypoint of the module, it will pass the FDT via a HOB.
 
@@ -61,9 +66,26 @@ PeimPassFdt (
 
   FdtSize  = fdt_totalsize (Base);
   FdtPages = EFI_SIZE_TO_PAGES (FdtSize);
-  NewBase  = AllocatePages (FdtPages);
-  ASSERT (NewBase != NULL);
-  fdt_open_into (Base, NewBase, EFI_PAGES_TO_SIZE (FdtPages));
+
+  //
+  // When the FDT starts on a page boundary and its last page has room for
+  // the DXE fixups, reserve the pages it occupies and hand it over by
+  // reference. Otherwise make a copy in newly allocated pages.
+  //
+  if ((((UINTN)Base & EFI_PAGE_MASK) == 0) &&
+      ((EFI_PAGES_TO_SIZE (FdtPages) - FdtSize) >= FDT_IN_PLACE_MIN_FREE_SPACE))
+  {
+    BuildMemoryAllocationHob (
+      (EFI_PHYSICAL_ADDRESS)(UINTN)Base,
+      EFI_PAGES_TO_SIZE (FdtPages),
+      EfiBootServicesData
+      );
+    NewBase = Base;
+  } else {
+    NewBase = AllocatePages (FdtPages);
+    ASSERT (NewBase != NULL);
+    fdt_open_into (Base, NewBase, EFI_PAGES_TO_SIZE (FdtPages));
+  }
 
   FdtHobData = BuildGuidHob (&gFdtHobGuid, sizeof *FdtHobData);
   ASSERT (FdtHobData != NULL);
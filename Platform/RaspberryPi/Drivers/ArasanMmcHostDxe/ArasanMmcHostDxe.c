@@ -18,6 +18,20 @@ UINT32 LastExecutedCommand = (UINT32) -1;
 STATIC RASPBERRY_PI_FIRMWARE_PROTOCOL *mFwProtocol;
 STATIC UINTN mMmcHsBase;
 
+//
+// ADMA2 state. mAdmaDescriptors is NULL when multi-block transfers use PIO.
+// With ADMA2, CMD18/CMD25 are only recorded by MMCSendCommand and issued
+// by MMCReadBlockData/MMCWriteBlockData, which know the buffer.
+//
+#define NO_PENDING_COMMAND ((UINT32) -1)
+
+STATIC ADMA2_DESCRIPTOR *mAdmaDescriptors;
+STATIC EFI_PHYSICAL_ADDRESS mAdmaDescriptorsBusAddress;
+STATIC VOID *mAdmaDescriptorsMapping;
+STATIC UINTN mDmaBusOffset;
+STATIC UINT32 mPendingCommand = NO_PENDING_COMMAND;
+STATIC UINT32 mPendingArgument;
+
 STATIC
 UINT32
 EFIAPI
@@ -325,32 +339,29 @@ MMCBuildDevicePath (
   return EFI_SUCCESS;
 }
 
+/**
+   Issues an already translated command and waits for its completion.
+
+   A non-zero DmaBlockCount programs the block count and has the data
+   phase done by ADMA2, using the descriptors in mAdmaDescriptors.
+**/
+STATIC
 EFI_STATUS
-MMCSendCommand (
-  IN EFI_MMC_HOST_PROTOCOL    *This,
-  IN MMC_CMD                  MmcCmd,
-  IN UINT32                   Argument
+IssueCommand (
+  IN UINT32 MmcCmd,
+  IN UINT32 Argument,
+  IN UINT32 DmaBlockCount
   )
 {
   UINTN MmcStatus;
   UINTN RetryCount = 0;
   UINTN CmdSendOKMask;
+  UINT32 TransferFlags = 0;
   EFI_STATUS Status = EFI_SUCCESS;
   BOOLEAN IsAppCmd = (LastExecutedCommand == CMD55);
   BOOLEAN IsDATCmd = FALSE;
   BOOLEAN IsADTCCmd = FALSE;
 
-  DEBUG ((DEBUG_MMCHOST_SD, "ArasanMMCHost: MMCSendCommand(MmcCmd: %08x, Argument: %08x)\n", MmcCmd, Argument));
-
-  if (IgnoreCommand (MmcCmd)) {
-    return EFI_SUCCESS;
-  }
-
-  MmcCmd = TranslateCommand (MmcCmd, Argument);
-  if (MmcCmd == 0xffffffff) {
-    return EFI_UNSUPPORTED;
-  }
-
   if ((MmcCmd & CMD_R1_ADTC) == CMD_R1_ADTC) {
     IsADTCCmd = TRUE;
   }
@@ -387,6 +398,11 @@ MMCSendCommand (
     SdMmioWrite32 (MMCHS_BLK, 8);
   } else if (!IsAppCmd && MmcCmd == CMD6) {
     SdMmioWrite32 (MMCHS_BLK, 64);
+  } else if (DmaBlockCount != 0) {
+    ASSERT (IsADTCCmd && DmaBlockCount <= MAX_BLOCK_COUNT);
+    SdMmioWrite32 (MMCHS_BLK, (DmaBlockCount << BLOCK_COUNT_SHIFT) | BLEN_512BYTES);
+    SdMmioWrite32 (MMCHS_ADMA_ADDR, (UINT32) mAdmaDescriptorsBusAddress);
+    TransferFlags = DE_ENABLE | BCE_ENABLE;
   } else if (IsADTCCmd) {
     SdMmioWrite32 (MMCHS_BLK, BLEN_512BYTES);
   }
@@ -404,7 +420,7 @@ MMCSendCommand (
   SdMmioWrite32 (MMCHS_ARG, Argument);
 
   // Send the command
-  SdMmioWrite32 (MMCHS_CMD, MmcCmd);
+  SdMmioWrite32 (MMCHS_CMD, MmcCmd | TransferFlags);
 
   // Check for the command status.
   while (RetryCount < MAX_RETRY_COUNT) {
@@ -456,6 +472,43 @@ Exit:
   return Status;
 }
 
+EFI_STATUS
+MMCSendCommand (
+  IN EFI_MMC_HOST_PROTOCOL    *This,
+  IN MMC_CMD                  MmcCmd,
+  IN UINT32                   Argument
+  )
+{
+  DEBUG ((DEBUG_MMCHOST_SD, "ArasanMMCHost: MMCSendCommand(MmcCmd: %08x, Argument: %08x)\n", MmcCmd, Argument));
+
+  if (IgnoreCommand (MmcCmd)) {
+    return EFI_SUCCESS;
+  }
+
+  MmcCmd = TranslateCommand (MmcCmd, Argument);
+  if (MmcCmd == 0xffffffff) {
+    return EFI_UNSUPPORTED;
+  }
+
+  mPendingCommand = NO_PENDING_COMMAND;
+
+  //
+  // The ADMA2 descriptors and block count must be programmed before the
+  // command is issued, so leave that to the data phase.
+  //
+  if (mAdmaDescriptors != NULL &&
+      LastExecutedCommand != CMD55 &&
+      (MmcCmd == CMD_READ_MULTIPLE_BLOCK ||
+       MmcCmd == CMD_WRITE_MULTIPLE_BLOCK)) {
+    mPendingCommand = MmcCmd;
+    mPendingArgument = Argument;
+    LastExecutedCommand = MmcCmd;
+    return EFI_SUCCESS;
+  }
+
+  return IssueCommand (MmcCmd, Argument, 0);
+}
+
 EFI_STATUS
 MMCNotifyState (
   IN EFI_MMC_HOST_PROTOCOL    *This,
@@ -494,6 +547,11 @@ MMCNotifyState (
       SdMmioAndThenOr32 (MMCHS_HCTL, (UINT32) ~SDBP_MASK, SDVS_3_3_V);
       SdMmioOr32 (MMCHS_HCTL, SDBP_ON);
 
+      // DMA data commands fetch 32-bit ADMA2 descriptors
+      if (mAdmaDescriptors != NULL) {
+        SdMmioAndThenOr32 (MMCHS_HCTL, (UINT32) ~DMAS_MASK, DMAS_ADMA2_32);
+      }
+
       DEBUG ((DEBUG_MMCHOST_SD, "ArasanMMCHost: AC12 %X HCTL %X\n", MmioRead32(MMCHS_AC12),MmioRead32(MMCHS_HCTL)));
 
       // First turn off the clock
@@ -678,6 +736,92 @@ MMCReceiveResponse (
   return EFI_SUCCESS;
 }
 
+/**
+   Issues the pending CMD18/CMD25 and moves its data with ADMA2, one
+   descriptor per 64KB of the mapped buffer.
+
+   @retval EFI_UNSUPPORTED  The buffer can't be transferred with DMA, and the
+                            command has not been issued.
+**/
+STATIC
+EFI_STATUS
+DmaTransfer (
+  IN UINTN                    Length,
+  IN UINT32*                  Buffer,
+  IN BOOLEAN                  IsWrite
+  )
+{
+  EFI_STATUS Status;
+  EFI_PHYSICAL_ADDRESS DeviceAddress;
+  VOID *Mapping;
+  UINTN MappedLength;
+  UINTN Offset;
+  UINTN Index;
+  UINTN Chunk;
+  UINTN MmcStatus;
+  UINTN RetryCount;
+
+  if (Length == 0 ||
+      Length % BLEN_512BYTES != 0 ||
+      Length / BLEN_512BYTES > MAX_BLOCK_COUNT) {
+    return EFI_UNSUPPORTED;
+  }
+
+  MappedLength = Length;
+  Status = DmaMap (IsWrite ? MapOperationBusMasterRead : MapOperationBusMasterWrite,
+             Buffer, &MappedLength, &DeviceAddress, &Mapping);
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  DeviceAddress += mDmaBusOffset;
+  if (MappedLength != Length || (DeviceAddress & 0x3) != 0) {
+    DmaUnmap (Mapping);
+    return EFI_UNSUPPORTED;
+  }
+
+  for (Offset = 0, Index = 0; Offset < Length; Offset += Chunk, Index++) {
+    ASSERT (Index < ADMA2_DESCRIPTOR_COUNT);
+    Chunk = MIN (Length - Offset, ADMA2_MAX_LENGTH);
+    mAdmaDescriptors[Index].Attributes = ADMA2_VALID | ADMA2_ACT_TRAN;
+    mAdmaDescriptors[Index].Length = (UINT16) Chunk;
+    mAdmaDescriptors[Index].Address = (UINT32) (DeviceAddress + Offset);
+  }
+  mAdmaDescriptors[Index - 1].Attributes |= ADMA2_END;
+  MemoryFence ();
+
+  Status = IssueCommand (mPendingCommand, mPendingArgument, Length / BLEN_512BYTES);
+  mPendingCommand = NO_PENDING_COMMAND;
+  if (EFI_ERROR (Status)) {
+    SoftReset (SRD);
+    goto Unmap;
+  }
+
+  mFwProtocol->SetLed (TRUE);
+  for (RetryCount = 0; RetryCount < MAX_DMA_RETRY_COUNT; RetryCount++) {
+    MmcStatus = MmioRead32 (MMCHS_INT_STAT);
+    if ((MmcStatus & (TC | ERRI)) != 0) {
+      break;
+    }
+    gBS->Stall (STALL_AFTER_RETRY_US);
+  }
+  mFwProtocol->SetLed (FALSE);
+
+  if ((MmcStatus & ERRI) != 0 || RetryCount == MAX_DMA_RETRY_COUNT) {
+    DEBUG ((DEBUG_ERROR, "%a(%u): %lu bytes MMCHS_INT_STAT: %08x MMCHS_ADMA_ERR: %08x\n",
+      __FUNCTION__, __LINE__, Length, MmcStatus, MmioRead32 (MMCHS_ADMA_ERR)));
+    // Stop the DMA engine before the buffer is unmapped.
+    SoftReset (SRD);
+    Status = (MmcStatus & ERRI) != 0 ? EFI_DEVICE_ERROR : EFI_TIMEOUT;
+  } else {
+    SdMmioWrite32 (MMCHS_INT_STAT, TC);
+  }
+
+Unmap:
+  DmaUnmap (Mapping);
+  return Status;
+}
+
 EFI_STATUS
 MMCReadBlockData (
   IN EFI_MMC_HOST_PROTOCOL    *This,
@@ -686,6 +830,7 @@ MMCReadBlockData (
   IN UINT32*                  Buffer
   )
 {
+  EFI_STATUS Status;
   UINTN MmcStatus;
   UINTN RemLength;
   UINTN Count;
@@ -703,6 +848,20 @@ MMCReadBlockData (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (mPendingCommand != NO_PENDING_COMMAND) {
+    Status = DmaTransfer (Length, Buffer, FALSE);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+
+    // Fall back to PIO.
+    Status = IssueCommand (mPendingCommand, mPendingArgument, 0);
+    mPendingCommand = NO_PENDING_COMMAND;
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
   RemLength = Length;
   while (RemLength != 0) {
     UINTN RetryCount = 0;
@@ -750,6 +909,7 @@ MMCWriteBlockData (
   IN UINT32*                  Buffer
   )
 {
+  EFI_STATUS Status;
   UINTN MmcStatus;
   UINTN RemLength;
   UINTN Count;
@@ -767,6 +927,20 @@ MMCWriteBlockData (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (mPendingCommand != NO_PENDING_COMMAND) {
+    Status = DmaTransfer (Length, Buffer, TRUE);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+
+    // Fall back to PIO.
+    Status = IssueCommand (mPendingCommand, mPendingArgument, 0);
+    mPendingCommand = NO_PENDING_COMMAND;
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
   RemLength = Length;
   while (RemLength != 0) {
     UINTN RetryCount = 0;
@@ -829,6 +1003,52 @@ EFI_MMC_HOST_PROTOCOL gMMCHost =
   MMCIsMultiBlock
 };
 
+/**
+   Sets up ADMA2 for multi-block transfers. Failing that, they use PIO.
+**/
+STATIC
+VOID
+AdmaInitialize (
+  VOID
+  )
+{
+  EFI_STATUS Status;
+  VOID *Descriptors;
+  UINTN Bytes;
+
+  //
+  // The Arasan controller can't do SDHCI DMA to RAM, only emmc2 can.
+  //
+  if (mMmcHsBase != MMCHS2_BASE ||
+      (MmioRead32 (MMCHS_CAPA) & ADMA2_SUPPORT) == 0) {
+    DEBUG ((DEBUG_INFO, "ArasanMMCHost: using PIO\n"));
+    return;
+  }
+
+  if ((MmioRead32 (ID_CHIPREV) & 0xFF) < ID_CHIPREV_C0) {
+    mDmaBusOffset = EMMC2_LEGACY_DMA_OFFSET;
+  }
+
+  Status = DmaAllocateBuffer (EfiBootServicesData, ADMA2_TABLE_PAGES, &Descriptors);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "ArasanMMCHost: failed to allocate ADMA2 descriptors: %r\n", Status));
+    return;
+  }
+
+  Bytes = EFI_PAGES_TO_SIZE (ADMA2_TABLE_PAGES);
+  Status = DmaMap (MapOperationBusMasterCommonBuffer, Descriptors, &Bytes,
+             &mAdmaDescriptorsBusAddress, &mAdmaDescriptorsMapping);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "ArasanMMCHost: failed to map ADMA2 descriptors: %r\n", Status));
+    DmaFreeBuffer (ADMA2_TABLE_PAGES, Descriptors);
+    return;
+  }
+
+  mAdmaDescriptorsBusAddress += mDmaBusOffset;
+  mAdmaDescriptors = Descriptors;
+  DEBUG ((DEBUG_INFO, "ArasanMMCHost: using ADMA2 for multi-block transfers\n"));
+}
+
 EFI_STATUS
 MMCInitialize (
   IN EFI_HANDLE          ImageHandle,
@@ -858,6 +1078,8 @@ MMCInitialize (
     return Status;
   }
 
+  AdmaInitialize ();
+
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &Handle,
                   &gRaspberryPiMmcHostProtocolGuid,
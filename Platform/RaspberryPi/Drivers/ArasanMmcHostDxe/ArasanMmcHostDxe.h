@@ -27,6 +27,7 @@
 #include <Protocol/RpiMmcHost.h>
 #include <Protocol/RpiFirmware.h>
 
+#include <IndustryStandard/Bcm2711.h>
 #include <IndustryStandard/Bcm2836.h>
 #include <IndustryStandard/Bcm2836Sdio.h>
 #include <IndustryStandard/RpiMbox.h>
@@ -42,4 +43,34 @@
 
 #define MAX_DIVISOR_VALUE 1023
 
+// Polls for the end of an ADMA2 transfer, 10s in STALL_AFTER_RETRY_US steps
+#define MAX_DMA_RETRY_COUNT (10 * 1000 * 1000 / STALL_AFTER_RETRY_US)
+
+//
+// BCM2711 steppings older than C0 see RAM through the legacy 0xC0000000
+// bus alias on emmc2 (see the _DMA method in Emmc.asl).
+//
+#define ID_CHIPREV_C0              0x20
+#define EMMC2_LEGACY_DMA_OFFSET    0xC0000000
+
+//
+// 32-bit ADMA2 descriptor, one per (up to) 64KB physically contiguous chunk.
+// A Length of 0 encodes 64KB.
+//
+#define ADMA2_VALID       BIT0
+#define ADMA2_END         BIT1
+#define ADMA2_ACT_TRAN    (0x2U << 4)
+#define ADMA2_MAX_LENGTH  SIZE_64KB
+
+typedef struct {
+  UINT16 Attributes;
+  UINT16 Length;
+  UINT32 Address;
+} ADMA2_DESCRIPTOR;
+
+// One page of descriptors covers MAX_BLOCK_COUNT 512-byte blocks
+#define ADMA2_TABLE_PAGES 1
+#define ADMA2_DESCRIPTOR_COUNT \
+  (EFI_PAGES_TO_SIZE (ADMA2_TABLE_PAGES) / sizeof (ADMA2_DESCRIPTOR))
+
 #endif
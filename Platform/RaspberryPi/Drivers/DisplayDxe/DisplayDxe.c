@@ -24,6 +24,11 @@
                                 (posY) * This->Mode->Info->PixelsPerScanLine * \
                                 PI3_BYTES_PER_PIXEL +                   \
                                 (posX) * PI3_BYTES_PER_PIXEL))
+#define POS_TO_BUF(Base, posX, posY) ((UINT8*)                          \
+                               ((UINTN)(Base) +                         \
+                                (posY) * This->Mode->Info->PixelsPerScanLine * \
+                                PI3_BYTES_PER_PIXEL +                   \
+                                (posX) * PI3_BYTES_PER_PIXEL))
 
 STATIC
 EFI_STATUS
@@ -125,6 +130,16 @@ STATIC GOP_MODE_DATA mGopModeTemplate[] = {
 STATIC UINTN mLastMode;
 STATIC GOP_MODE_DATA mGopModeData[ARRAY_SIZE (mGopModeTemplate)];
 
+/*
+ * Cacheable copy of the frame buffer of the current mode, or NULL to BLT
+ * straight to and from the frame buffer.
+ */
+STATIC UINT8 *mShadowFb;
+STATIC UINTN mShadowFbPages;
+
+/* BLT call counters and latencies, or NULL. */
+STATIC GOP_STATS_CONTEXT *mGopStats;
+
 STATIC DISPLAY_DEVICE_PATH mDisplayProtoDevicePath =
 {
   {
@@ -282,14 +297,30 @@ DisplaySetMode (
   This->Mode->FrameBufferSize = Mode->Width * Mode->Height * PI3_BYTES_PER_PIXEL;
   DEBUG((DEBUG_INFO, "Reported Mode->FrameBufferSize is %u\n", This->Mode->FrameBufferSize));
 
+  if (mShadowFb != NULL) {
+    FreePages (mShadowFb, mShadowFbPages);
+    mShadowFb = NULL;
+  }
+
+  if (PcdGetBool (PcdDisplayShadowFrameBuffer)) {
+    /*
+     * The shadow starts out in sync with the frame buffer, as ClearScreen ()
+     * below fills both. Without it, BLTs just go to the frame buffer.
+     */
+    mShadowFbPages = EFI_SIZE_TO_PAGES (This->Mode->FrameBufferSize);
+    mShadowFb = AllocatePages (mShadowFbPages);
+    if (mShadowFb == NULL) {
+      DEBUG ((DEBUG_WARN, "Couldn't allocate shadow framebuffer\n"));
+    }
+  }
+
   ClearScreen (This);
   return EFI_SUCCESS;
 }
 
 STATIC
 EFI_STATUS
-EFIAPI
-DisplayBlt (
+DisplayBltInternal (
   IN  EFI_GRAPHICS_OUTPUT_PROTOCOL      *This,
   IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     *BltBuffer, OPTIONAL
   IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION BltOperation,
@@ -303,6 +334,7 @@ DisplayBlt (
   )
 {
   UINT8 *VidBuf, *BltBuf, *VidBuf1;
+  UINT8 *Base;
   UINTN i;
 
   if ((UINTN)BltOperation >= EfiGraphicsOutputBltOperationMax) {
@@ -313,12 +345,19 @@ DisplayBlt (
     return EFI_INVALID_PARAMETER;
   }
 
+  /*
+   * With a shadow, all BLTs read from and write to it, and the rectangle
+   * written to is then copied to the frame buffer, which is never read.
+   */
+  Base = (mShadowFb != NULL) ? mShadowFb :
+           (UINT8*)(UINTN)This->Mode->FrameBufferBase;
+
   switch (BltOperation) {
   case EfiBltVideoFill:
     BltBuf = (UINT8*)BltBuffer;
 
     for (i = 0; i < Height; i++) {
-      VidBuf = POS_TO_FB (DestinationX, DestinationY + i);
+      VidBuf = POS_TO_BUF (Base, DestinationX, DestinationY + i);
 
       SetMem32 (VidBuf, Width * PI3_BYTES_PER_PIXEL, *(UINT32*)BltBuf);
     }
@@ -330,7 +369,7 @@ DisplayBlt (
     }
 
     for (i = 0; i < Height; i++) {
-      VidBuf = POS_TO_FB (SourceX, SourceY + i);
+      VidBuf = POS_TO_BUF (Base, SourceX, SourceY + i);
 
       BltBuf = (UINT8*)((UINTN)BltBuffer + (DestinationY + i) * Delta +
         DestinationX * PI3_BYTES_PER_PIXEL);
@@ -345,7 +384,7 @@ DisplayBlt (
     }
 
     for (i = 0; i < Height; i++) {
-      VidBuf = POS_TO_FB (DestinationX, DestinationY + i);
+      VidBuf = POS_TO_BUF (Base, DestinationX, DestinationY + i);
       BltBuf = (UINT8*)((UINTN)BltBuffer + (SourceY + i) * Delta +
         SourceX * PI3_BYTES_PER_PIXEL);
 
@@ -355,8 +394,8 @@ DisplayBlt (
 
   case EfiBltVideoToVideo:
     for (i = 0; i < Height; i++) {
-      VidBuf = POS_TO_FB (SourceX, SourceY + i);
-      VidBuf1 = POS_TO_FB (DestinationX, DestinationY + i);
+      VidBuf = POS_TO_BUF (Base, SourceX, SourceY + i);
+      VidBuf1 = POS_TO_BUF (Base, DestinationX, DestinationY + i);
 
       gBS->CopyMem ((VOID*)VidBuf1, (VOID*)VidBuf, Width * PI3_BYTES_PER_PIXEL);
     }
@@ -367,9 +406,54 @@ DisplayBlt (
     break;
   }
 
+  if ((mShadowFb != NULL) && (BltOperation != EfiBltVideoToBltBuffer)) {
+    if (DestinationX == 0 && Width == This->Mode->Info->PixelsPerScanLine) {
+      /* Whole lines are contiguous in both buffers. */
+      Width *= Height;
+      Height = 1;
+    }
+
+    for (i = 0; i < Height; i++) {
+      gBS->CopyMem ((VOID*)POS_TO_FB (DestinationX, DestinationY + i),
+        (VOID*)POS_TO_BUF (mShadowFb, DestinationX, DestinationY + i),
+        Width * PI3_BYTES_PER_PIXEL);
+    }
+  }
+
   return EFI_SUCCESS;
 }
 
+/*
+ * Blt () entry point: records every call in the GOP statistics, see
+ * DisplayBltInternal () for the actual BLT.
+ */
+STATIC
+EFI_STATUS
+EFIAPI
+DisplayBlt (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL      *This,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     *BltBuffer, OPTIONAL
+  IN  EFI_GRAPHICS_OUTPUT_BLT_OPERATION BltOperation,
+  IN  UINTN                             SourceX,
+  IN  UINTN                             SourceY,
+  IN  UINTN                             DestinationX,
+  IN  UINTN                             DestinationY,
+  IN  UINTN                             Width,
+  IN  UINTN                             Height,
+  IN  UINTN                             Delta         OPTIONAL
+  )
+{
+  EFI_STATUS Status;
+  UINT64 StartTicks;
+
+  StartTicks = GopStatsStart ();
+  Status = DisplayBltInternal (This, BltBuffer, BltOperation, SourceX, SourceY,
+             DestinationX, DestinationY, Width, Height, Delta);
+  GopStatsRecord (mGopStats, BltOperation, StartTicks, Status, Width, Height);
+
+  return Status;
+}
+
 /**
    Initialize the state information for the Display Dxe
 
@@ -589,6 +673,11 @@ DriverStart (
     goto Done;
   }
 
+  /* Statistics are optional, the display works without them. */
+  if (EFI_ERROR (GopStatsInstall (Controller, &mGopStats))) {
+    DEBUG ((DEBUG_WARN, "No BLT statistics\n"));
+  }
+
   if (PcdGet32 (PcdDisplayEnableSShot)) {
     RegisterScreenshotHandlers ();
   } else {
@@ -632,6 +721,9 @@ DriverStop (
 
   ClearScreen (&gDisplayProto);
 
+  GopStatsUninstall (Controller, mGopStats);
+  mGopStats = NULL;
+
   Status = gBS->UninstallMultipleProtocolInterfaces (
     Controller, &gEfiGraphicsOutputProtocolGuid,
     &gDisplayProto, NULL);
@@ -644,6 +736,11 @@ DriverStop (
   FreePool (gDisplayProto.Mode);
   gDisplayProto.Mode = NULL;
 
+  if (mShadowFb != NULL) {
+    FreePages (mShadowFb, mShadowFbPages);
+    mShadowFb = NULL;
+  }
+
   gBS->CloseProtocol (
          Controller,
          &gEfiCallerIdGuid,
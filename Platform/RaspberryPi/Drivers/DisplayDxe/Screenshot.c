@@ -36,7 +36,7 @@
 #include "DisplayDxe.h"
 #include <Protocol/SimpleFileSystem.h>
 #include <Library/PrintLib.h>
-#include <Library/BmpSupportLib.h>
+#include <IndustryStandard/Bmp.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 
 /*
@@ -150,34 +150,201 @@ FindWritableFs (
   return Status;
 }
 
+/*
+ * Screenshots are streamed to the file SCREENSHOT_CHUNK_LINES lines at a
+ * time. Screens with at most 256 colours, as text and setup screens are,
+ * are written as run-length encoded 8bpp bitmaps (BI_RLE8), others as 24bpp.
+ */
+#define SCREENSHOT_CHUNK_LINES   16
+#define SCREENSHOT_MAX_COLORS    256
+#define SCREENSHOT_HASH_SIZE     1024
+#define SCREENSHOT_RLE8          1
+
+#define PIXEL_TO_COLOR(Pixel)    (*(UINT32*)(Pixel) & 0x00FFFFFF)
+
+typedef struct {
+  UINT32  Colors[SCREENSHOT_MAX_COLORS];
+  UINTN   Count;
+  BOOLEAN Overflow;
+  /*
+   * Open addressing hash of the colours; each slot holds the index
+   * of a colour plus one, or 0 if it is free.
+   */
+  UINT16  Slots[SCREENSHOT_HASH_SIZE];
+} SCREENSHOT_PALETTE;
+
+STATIC
+UINTN
+PaletteSlot (
+  IN SCREENSHOT_PALETTE *Palette,
+  IN UINT32             Color
+  )
+{
+  UINTN Slot;
+
+  Slot = ((Color * 0x9E3779B1) >> 22) & (SCREENSHOT_HASH_SIZE - 1);
+  while (Palette->Slots[Slot] != 0 &&
+         Palette->Colors[Palette->Slots[Slot] - 1] != Color) {
+    Slot = (Slot + 1) & (SCREENSHOT_HASH_SIZE - 1);
+  }
+
+  return Slot;
+}
+
+/*
+ * Adds a colour to the palette, unless it is there already, or the palette
+ * has overflowed.
+ */
+STATIC
+VOID
+PaletteAdd (
+  IN SCREENSHOT_PALETTE *Palette,
+  IN UINT32             Color
+  )
+{
+  UINTN Slot;
+
+  if (Palette->Overflow) {
+    return;
+  }
+
+  Slot = PaletteSlot (Palette, Color);
+  if (Palette->Slots[Slot] == 0) {
+    if (Palette->Count == SCREENSHOT_MAX_COLORS) {
+      Palette->Overflow = TRUE;
+      return;
+    }
+    Palette->Colors[Palette->Count++] = Color;
+    Palette->Slots[Slot] = (UINT16)Palette->Count;
+  }
+}
+
+/*
+ * Returns the palette index of a colour, or 0 if it isn't in the palette.
+ */
+STATIC
+UINT8
+PaletteIndex (
+  IN SCREENSHOT_PALETTE *Palette,
+  IN UINT32             Color
+  )
+{
+  UINTN Slot;
+
+  Slot = PaletteSlot (Palette, Color);
+  if (Palette->Slots[Slot] == 0) {
+    return 0;
+  }
+
+  return (UINT8)(Palette->Slots[Slot] - 1);
+}
+
+/*
+ * Encodes a line as BI_RLE8 runs, followed by an end of line marker.
+ * Needs at most 2 * Width + 2 bytes.
+ */
+STATIC
+UINTN
+EncodeLineRle8 (
+  IN  SCREENSHOT_PALETTE            *Palette,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Line,
+  IN  UINT32                        Width,
+  OUT UINT8                         *Out
+  )
+{
+  UINT8 *Start = Out;
+  UINTN X;
+  UINTN Run;
+  UINT32 Color;
+
+  for (X = 0; X < Width; X += Run) {
+    Color = PIXEL_TO_COLOR (&Line[X]);
+    for (Run = 1; X + Run < Width && Run < 255 &&
+           PIXEL_TO_COLOR (&Line[X + Run]) == Color; Run++);
+
+    *Out++ = (UINT8)Run;
+    *Out++ = PaletteIndex (Palette, Color);
+  }
+
+  // End of line.
+  *Out++ = 0;
+  *Out++ = 0;
+  return Out - Start;
+}
+
+/*
+ * Converts a line to 24bpp, padded to a multiple of 4 bytes.
+ */
+STATIC
+UINTN
+EncodeLine24 (
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Line,
+  IN  UINT32                        Width,
+  OUT UINT8                         *Out
+  )
+{
+  UINT8 *Start = Out;
+  UINTN X;
+
+  for (X = 0; X < Width; X++) {
+    *Out++ = Line[X].Blue;
+    *Out++ = Line[X].Green;
+    *Out++ = Line[X].Red;
+  }
+
+  while (((Out - Start) & 3) != 0) {
+    *Out++ = 0;
+  }
+  return Out - Start;
+}
+
+STATIC
+EFI_STATUS
+WriteFile (
+  IN EFI_FILE_PROTOCOL *File,
+  IN VOID              *Buffer,
+  IN UINTN             Size
+  )
+{
+  return File->Write (File, &Size, Buffer);
+}
+
 STATIC
 VOID
 TakeScreenshot (
   VOID
   )
 {
-  VOID *BmpImage = NULL;
   EFI_FILE_PROTOCOL *Fs = NULL;
   EFI_FILE_PROTOCOL *File = NULL;
   EFI_GRAPHICS_OUTPUT_PROTOCOL *GraphicsOutput = &gDisplayProto;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Image = NULL;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Lines = NULL;
+  SCREENSHOT_PALETTE *Palette = NULL;
+  UINT8 *Out = NULL;
+  BMP_IMAGE_HEADER Header;
+  BMP_COLOR_MAP ColorMap[SCREENSHOT_MAX_COLORS];
   EFI_STATUS Status;
   CHAR16 FileName[8 + 1 + 3 + 1];
   UINT32 ScreenWidth;
   UINT32 ScreenHeight;
+  UINTN Y;
+  UINTN Count;
+  UINTN Line;
+  UINTN OutSize;
   UINTN ImageSize;
-  UINTN BmpSize;
   UINTN Index;
+  BOOLEAN Rle;
+  BOOLEAN Black;
   EFI_TIME Time;
 
   Status = FindWritableFs (&Fs);
   if (EFI_ERROR (Status)) {
     ShowStatus (GraphicsOutput, STATUS_YELLOW);
+    return;
   }
 
   ScreenWidth = GraphicsOutput->Mode->Info->HorizontalResolution;
   ScreenHeight = GraphicsOutput->Mode->Info->VerticalResolution;
-  ImageSize = ScreenWidth * ScreenHeight;
 
   Status = gRT->GetTime (&Time, NULL);
   if (!EFI_ERROR (Status)) {
@@ -187,39 +354,68 @@ TakeScreenshot (
     UnicodeSPrint (FileName, sizeof (FileName), L"scrnshot.bmp");
   }
 
-  Image = AllocatePool (ImageSize * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-  if (Image == NULL) {
+  Lines = AllocatePool (ScreenWidth * SCREENSHOT_CHUNK_LINES *
+            sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  Out = AllocatePool (ALIGN_VALUE (ScreenWidth * 3, 4) * SCREENSHOT_CHUNK_LINES + 2);
+  Palette = AllocateZeroPool (sizeof (*Palette));
+  if (Lines == NULL || Out == NULL || Palette == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
     ShowStatus (GraphicsOutput, STATUS_RED);
     goto Done;
   }
 
-  Status = GraphicsOutput->Blt (GraphicsOutput, Image,
-                             EfiBltVideoToBltBuffer, 0, 0, 0, 0,
-                             ScreenWidth, ScreenHeight, 0);
-  if (EFI_ERROR (Status)) {
-    ShowStatus (GraphicsOutput, STATUS_RED);
-    goto Done;
-  }
+  /*
+   * First pass: build the palette, and check that the screen isn't all black.
+   */
+  Black = TRUE;
+  for (Y = 0; Y < ScreenHeight; Y += Count) {
+    Count = MIN (SCREENSHOT_CHUNK_LINES, ScreenHeight - Y);
+    Status = GraphicsOutput->Blt (GraphicsOutput, Lines,
+                               EfiBltVideoToBltBuffer, 0, Y, 0, 0,
+                               ScreenWidth, Count, 0);
+    if (EFI_ERROR (Status)) {
+      ShowStatus (GraphicsOutput, STATUS_RED);
+      goto Done;
+    }
 
-  for (Index = 0; Index < ImageSize; Index++) {
-    if (Image[Index].Red != 0x00 ||
-        Image[Index].Green != 0x00 ||
-        Image[Index].Blue != 0x00) {
-      break;
+    for (Index = 0; Index < ScreenWidth * Count; Index++) {
+      if (PIXEL_TO_COLOR (&Lines[Index]) != 0) {
+        Black = FALSE;
+      }
+      PaletteAdd (Palette, PIXEL_TO_COLOR (&Lines[Index]));
     }
   }
 
-  if (Index == ImageSize) {
+  if (Black) {
     ShowStatus (GraphicsOutput, STATUS_BLUE);
     goto Done;
   }
 
-  Status = TranslateGopBltToBmp (Image, ScreenHeight, ScreenWidth,
-             &BmpImage, (UINT32*)&BmpSize);
-  if (EFI_ERROR (Status)) {
-    ShowStatus (GraphicsOutput, STATUS_RED);
-    goto Done;
+  Rle = !Palette->Overflow;
+
+  ZeroMem (&Header, sizeof (Header));
+  Header.CharB = 'B';
+  Header.CharM = 'M';
+  Header.HeaderSize = sizeof (Header) - OFFSET_OF (BMP_IMAGE_HEADER, HeaderSize);
+  Header.PixelWidth = ScreenWidth;
+  Header.PixelHeight = ScreenHeight;
+  Header.Planes = 1;
+  Header.ImageOffset = sizeof (Header);
+  if (Rle) {
+    Header.BitPerPixel = 8;
+    Header.CompressionType = SCREENSHOT_RLE8;
+    Header.NumberOfColors = (UINT32)Palette->Count;
+    Header.ImageOffset += (UINT32)(Palette->Count * sizeof (BMP_COLOR_MAP));
+    for (Index = 0; Index < Palette->Count; Index++) {
+      ColorMap[Index].Blue = (UINT8)Palette->Colors[Index];
+      ColorMap[Index].Green = (UINT8)(Palette->Colors[Index] >> 8);
+      ColorMap[Index].Red = (UINT8)(Palette->Colors[Index] >> 16);
+      ColorMap[Index].Reserved = 0;
+    }
+  } else {
+    Header.BitPerPixel = 24;
+    Header.ImageSize = ALIGN_VALUE (ScreenWidth * 3, 4) * ScreenHeight;
+    Header.Size = Header.ImageOffset + Header.ImageSize;
   }
 
   Status = Fs->Open (Fs, &File, FileName, EFI_FILE_MODE_CREATE |
@@ -229,7 +425,59 @@ TakeScreenshot (
     goto Done;
   }
 
-  Status = File->Write (File, &BmpSize, BmpImage);
+  /*
+   * The sizes of a RLE image are only known once it's written, the header
+   * is written again at the end.
+   */
+  Status = WriteFile (File, &Header, sizeof (Header));
+  if (!EFI_ERROR (Status) && Rle) {
+    Status = WriteFile (File, ColorMap, Palette->Count * sizeof (BMP_COLOR_MAP));
+  }
+
+  /*
+   * Second pass: encode the lines, bottom up as BMP stores them. A colour
+   * that only appeared on the screen after the first pass gets index 0.
+   */
+  ImageSize = 0;
+  for (Y = ScreenHeight; Y > 0 && !EFI_ERROR (Status); Y -= Count) {
+    Count = MIN (SCREENSHOT_CHUNK_LINES, Y);
+    Status = GraphicsOutput->Blt (GraphicsOutput, Lines,
+                               EfiBltVideoToBltBuffer, 0, Y - Count, 0, 0,
+                               ScreenWidth, Count, 0);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    OutSize = 0;
+    for (Line = Count; Line > 0; Line--) {
+      if (Rle) {
+        OutSize += EncodeLineRle8 (Palette, &Lines[(Line - 1) * ScreenWidth],
+                     ScreenWidth, Out + OutSize);
+      } else {
+        OutSize += EncodeLine24 (&Lines[(Line - 1) * ScreenWidth],
+                     ScreenWidth, Out + OutSize);
+      }
+    }
+
+    if (Rle && Y == Count) {
+      // End of bitmap.
+      Out[OutSize++] = 0;
+      Out[OutSize++] = 1;
+    }
+
+    Status = WriteFile (File, Out, OutSize);
+    ImageSize += OutSize;
+  }
+
+  if (!EFI_ERROR (Status) && Rle) {
+    Header.ImageSize = (UINT32)ImageSize;
+    Header.Size = (UINT32)(Header.ImageOffset + ImageSize);
+    Status = File->SetPosition (File, 0);
+    if (!EFI_ERROR (Status)) {
+      Status = WriteFile (File, &Header, sizeof (Header));
+    }
+  }
+
   File->Close (File);
   if (EFI_ERROR (Status)) {
     ShowStatus (GraphicsOutput, STATUS_RED);
@@ -239,12 +487,16 @@ TakeScreenshot (
   ShowStatus (GraphicsOutput, STATUS_GREEN);
 
 Done:
-  if (BmpImage != NULL) {
-    FreePool (BmpImage);
+  if (Palette != NULL) {
+    FreePool (Palette);
+  }
+
+  if (Out != NULL) {
+    FreePool (Out);
   }
 
-  if (Image != NULL) {
-    FreePool (Image);
+  if (Lines != NULL) {
+    FreePool (Lines);
   }
 }
 
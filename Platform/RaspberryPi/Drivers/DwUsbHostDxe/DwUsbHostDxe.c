@@ -251,11 +251,40 @@ DwHcTransfer (
   UINT32                          StopTransfer = 0;
   EFI_STATUS                      Status = EFI_SUCCESS;
   SPLIT_CONTROL                   Split = { 0 };
+  VOID                            *Mapping = NULL;
+  EFI_PHYSICAL_ADDRESS            BusAddress = 0;
+  UINTN                           MapLength;
 
   EFI_TPL Tpl = gBS->RaiseTPL (TPL_NOTIFY);
 
   *TransferResult = EFI_USB_NOERROR;
 
+  /*
+   * Bulk data is DMAed straight to/from the caller's buffer, programming
+   * the channel with the largest chunks HCTSIZ allows, instead of bouncing
+   * every chunk through AlignedBuffer. IN transfers must cover whole
+   * packets, as the channel always receives full packets.
+   */
+  if (EpType == DWC2_HCCHAR_EPTYPE_BULK &&
+      *DataLength != 0 &&
+      ((UINTN)Data & 0x3) == 0 &&
+      (!TransferDirection || (*DataLength % MaximumPacketLength) == 0)) {
+    MapLength = *DataLength;
+    Status = DmaMap (TransferDirection ? MapOperationBusMasterWrite :
+                     MapOperationBusMasterRead, Data, &MapLength,
+               &BusAddress, &Mapping);
+    if (!EFI_ERROR (Status) &&
+        (MapLength != *DataLength || (BusAddress & 0x3) != 0)) {
+      DmaUnmap (Mapping);
+      Status = EFI_UNSUPPORTED;
+    }
+
+    if (EFI_ERROR (Status)) {
+      Mapping = NULL;
+    }
+    Status = EFI_SUCCESS;
+  }
+
   do {
   RestartXfer:
     if (DeviceSpeed == EFI_USB_SPEED_LOW ||
@@ -271,7 +300,7 @@ DwHcTransfer (
       TxferLen = DWC2_MAX_TRANSFER_SIZE - MaximumPacketLength + 1;
     }
 
-    if (TxferLen > DWC2_DATA_BUF_SIZE) {
+    if (Mapping == NULL && TxferLen > DWC2_DATA_BUF_SIZE) {
       TxferLen = DWC2_DATA_BUF_SIZE - MaximumPacketLength + 1;
     }
 
@@ -287,14 +316,19 @@ DwHcTransfer (
 
     if (TransferDirection) { // in
       TxferLen = NumPackets * MaximumPacketLength;
-    } else {
+    } else if (Mapping == NULL) {
       CopyMem (DwHc->AlignedBuffer, Data + Done, TxferLen);
       ArmDataSynchronizationBarrier ();
     }
 
   RestartChannel:
-    MmioWrite32 (DwHc->DwUsbBase + HCDMA (Channel),
-      (UINTN)DwHc->AlignedBufferBusAddress);
+    if (Mapping != NULL) {
+      MmioWrite32 (DwHc->DwUsbBase + HCDMA (Channel),
+        (UINTN)(BusAddress + Done));
+    } else {
+      MmioWrite32 (DwHc->DwUsbBase + HCDMA (Channel),
+        (UINTN)DwHc->AlignedBufferBusAddress);
+    }
 
     DwOtgHcInit (DwHc, Channel, Translator, DeviceSpeed,
       DeviceAddress, EpAddress,
@@ -367,9 +401,11 @@ DwHcTransfer (
     }
 
     if (TransferDirection) { // in
-      ArmDataSynchronizationBarrier ();
       TxferLen -= Sub;
-      CopyMem (Data + Done, DwHc->AlignedBuffer, TxferLen);
+      if (Mapping == NULL) {
+        ArmDataSynchronizationBarrier ();
+        CopyMem (Data + Done, DwHc->AlignedBuffer, TxferLen);
+      }
       if (Sub) {
         StopTransfer = 1;
       }
@@ -381,6 +417,10 @@ DwHcTransfer (
   MmioWrite32 (DwHc->DwUsbBase + HCINTMSK (Channel), 0);
   MmioWrite32 (DwHc->DwUsbBase + HCINT (Channel), 0xFFFFFFFF);
 
+  if (Mapping != NULL) {
+    DmaUnmap (Mapping);
+  }
+
   *DataLength = Done;
 
   gBS->RestoreTPL (Tpl);
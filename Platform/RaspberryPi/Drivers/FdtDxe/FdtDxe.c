@@ -501,11 +501,20 @@ FdtDxeInitialize (
     Print (L"Failed to update USB compatible properties: %r\n", Status);
   }
 
-  SyncPcie ();
+  Status = SyncPcie ();
   if (EFI_ERROR (Status)) {
     Print (L"Failed to update PCIe address ranges: %r\n", Status);
   }
 
+  /*
+   * The tree was opened with slack so that the fixups above can grow it
+   * in place. Drop what is left of it once, now that they are all done.
+   */
+  Retval = fdt_pack (mFdtImage);
+  if (Retval != 0) {
+    DEBUG ((DEBUG_ERROR, "fdt_pack failed: %d\n", Retval));
+  }
+
   DEBUG ((DEBUG_INFO, "Installed devicetree at address %p\n", mFdtImage));
   Status = gBS->InstallConfigurationTable (&gFdtTableGuid, mFdtImage);
   if (EFI_ERROR (Status)) {
@@ -7,6 +7,7 @@
  **/
 
 #include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
 
 #include "Mmc.h"
 
@@ -213,6 +214,23 @@ MmcStopTransmission (
   return Status;
 }
 
+/**
+  Tells whether a multi-block transfer may be bounded with CMD23
+  instead of being ended with CMD12.
+**/
+STATIC
+BOOLEAN
+MmcCanSetBlockCount (
+  IN MMC_HOST_INSTANCE *MmcHostInstance
+  )
+{
+  EFI_MMC_HOST_PROTOCOL *MmcHost = MmcHostInstance->MmcHost;
+
+  return MmcHostInstance->CardInfo.SupportsCmd23 &&
+         MMC_HOST_HAS_ISSETBLOCKCOUNT (MmcHost) &&
+         MmcHost->IsSetBlockCount (MmcHost);
+}
+
 STATIC
 EFI_STATUS
 MmcTransferBlock (
@@ -230,6 +248,7 @@ MmcTransferBlock (
   MMC_HOST_INSTANCE       *MmcHostInstance;
   EFI_MMC_HOST_PROTOCOL   *MmcHost;
   UINTN                   CmdArg;
+  BOOLEAN                 SetBlockCount;
 
   MmcHostInstance = MMC_HOST_INSTANCE_FROM_BLOCK_IO_THIS (This);
   MmcHost = MmcHostInstance->MmcHost;
@@ -242,6 +261,21 @@ MmcTransferBlock (
     CmdArg = Lba * This->Media->BlockSize;
   }
 
+  //
+  // With a pre-defined block count the card leaves RECV/DATA on its
+  // own after the last block, which saves the CMD12 round trip.
+  //
+  SetBlockCount = BufferSize > This->Media->BlockSize &&
+                  MmcCanSetBlockCount (MmcHostInstance);
+  if (SetBlockCount) {
+    ASSERT (BufferSize / This->Media->BlockSize <= MMC_SET_BLOCK_COUNT_MAX);
+    Status = MmcHost->SendCommand (MmcHost, MMC_CMD23, BufferSize / This->Media->BlockSize);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a(MMC_CMD23): Error %r\n", __func__, Status));
+      return Status;
+    }
+  }
+
   Status = MmcHost->SendCommand (MmcHost, Cmd, CmdArg);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a(MMC_CMD%d): Error %r\n", __func__, MMC_INDX (Cmd), Status));
@@ -262,10 +296,10 @@ MmcTransferBlock (
   }
 
   if (EFI_ERROR (Status) ||
-      BufferSize > This->Media->BlockSize) {
+      (BufferSize > This->Media->BlockSize && !SetBlockCount)) {
     /*
-     * CMD12 needs to be set for multiblock (to transition from
-     * RECV to PROG) or for errors.
+     * CMD12 needs to be set for open-ended multiblock (to transition
+     * from RECV to PROG) or for errors.
      */
     EFI_STATUS Status2 = MmcStopTransmission (MmcHost);
     if (EFI_ERROR (Status2)) {
@@ -284,13 +318,16 @@ MmcTransferBlock (
   }
 
   //
-  // For reads, should be already in TRAN. For writes, wait
-  // until programming finishes.
+  // For reads, should be already in TRAN, and the next transfer
+  // checks before it starts. For writes, wait until programming
+  // finishes.
   //
-  Status = WaitUntilTran (MmcHostInstance);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "WaitUntilTran after write failed\n"));
-    return Status;
+  if (Transfer != MMC_IOBLOCKS_READ) {
+    Status = WaitUntilTran (MmcHostInstance);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "WaitUntilTran after write failed\n"));
+      return Status;
+    }
   }
 
   Status = MmcNotifyState (MmcHostInstance, MmcTransferState);
@@ -314,25 +351,26 @@ MmcTransferBlock (
   return Status;
 }
 
+/**
+  Checks a block transfer request before it is started or queued.
+
+  @retval EFI_SUCCESS            The request is valid.
+  @retval Others                 The status the request must fail with.
+**/
+STATIC
 EFI_STATUS
-MmcIoBlocks (
+MmcCheckIoBlocks (
   IN EFI_BLOCK_IO_PROTOCOL    *This,
   IN UINTN                    Transfer,
   IN UINT32                   MediaId,
   IN EFI_LBA                  Lba,
   IN UINTN                    BufferSize,
-  OUT VOID                    *Buffer
+  IN VOID                     *Buffer
   )
 {
-  EFI_STATUS              Status;
-  UINTN                   Cmd;
   MMC_HOST_INSTANCE       *MmcHostInstance;
   EFI_MMC_HOST_PROTOCOL   *MmcHost;
-  UINTN                   BytesRemainingToBeTransfered;
-  UINTN                   BlockCount;
-  UINTN                   ConsumeSize;
 
-  BlockCount = 1;
   MmcHostInstance = MMC_HOST_INSTANCE_FROM_BLOCK_IO_THIS (This);
   ASSERT (MmcHostInstance != NULL);
   MmcHost = MmcHostInstance->MmcHost;
@@ -351,12 +389,6 @@ MmcIoBlocks (
     return EFI_NO_MEDIA;
   }
 
-  if (PcdGet32 (PcdMmcDisableMulti) == 0 &&
-      MMC_HOST_HAS_ISMULTIBLOCK (MmcHost) &&
-      MmcHost->IsMultiBlock (MmcHost)) {
-    BlockCount = (BufferSize + This->Media->BlockSize - 1) / This->Media->BlockSize;
-  }
-
   // All blocks must be within the device
   if ((Lba + (BufferSize / This->Media->BlockSize)) > (This->Media->LastBlock + 1)) {
     return EFI_INVALID_PARAMETER;
@@ -381,6 +413,45 @@ MmcIoBlocks (
     return EFI_INVALID_PARAMETER;
   }
 
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+MmcIoBlocks (
+  IN EFI_BLOCK_IO_PROTOCOL    *This,
+  IN UINTN                    Transfer,
+  IN UINT32                   MediaId,
+  IN EFI_LBA                  Lba,
+  IN UINTN                    BufferSize,
+  OUT VOID                    *Buffer
+  )
+{
+  EFI_STATUS              Status;
+  UINTN                   Cmd;
+  MMC_HOST_INSTANCE       *MmcHostInstance;
+  EFI_MMC_HOST_PROTOCOL   *MmcHost;
+  UINTN                   BytesRemainingToBeTransfered;
+  UINTN                   BlockCount;
+  UINTN                   ConsumeSize;
+
+  Status = MmcCheckIoBlocks (This, Transfer, MediaId, Lba, BufferSize, Buffer);
+  if (EFI_ERROR (Status) || BufferSize == 0) {
+    return Status;
+  }
+
+  BlockCount = 1;
+  MmcHostInstance = MMC_HOST_INSTANCE_FROM_BLOCK_IO_THIS (This);
+  MmcHost = MmcHostInstance->MmcHost;
+
+  if (PcdGet32 (PcdMmcDisableMulti) == 0 &&
+      MMC_HOST_HAS_ISMULTIBLOCK (MmcHost) &&
+      MmcHost->IsMultiBlock (MmcHost)) {
+    BlockCount = (BufferSize + This->Media->BlockSize - 1) / This->Media->BlockSize;
+    if (MmcCanSetBlockCount (MmcHostInstance)) {
+      BlockCount = MIN (BlockCount, MMC_SET_BLOCK_COUNT_MAX);
+    }
+  }
+
   BytesRemainingToBeTransfered = BufferSize;
   while (BytesRemainingToBeTransfered > 0) {
     Status = WaitUntilTran (MmcHostInstance);
@@ -389,8 +460,13 @@ MmcIoBlocks (
       return Status;
     }
 
+    ConsumeSize = BlockCount * This->Media->BlockSize;
+    if (BytesRemainingToBeTransfered < ConsumeSize) {
+      ConsumeSize = BytesRemainingToBeTransfered;
+    }
+
     if (Transfer == MMC_IOBLOCKS_READ) {
-      if (BlockCount == 1) {
+      if (ConsumeSize == This->Media->BlockSize) {
         // Read a single block
         Cmd = MMC_CMD17;
       } else {
@@ -398,7 +474,7 @@ MmcIoBlocks (
         Cmd = MMC_CMD18;
       }
     } else {
-      if (BlockCount == 1) {
+      if (ConsumeSize == This->Media->BlockSize) {
         // Write a single block
         Cmd = MMC_CMD24;
       } else {
@@ -407,11 +483,6 @@ MmcIoBlocks (
       }
     }
 
-    ConsumeSize = BlockCount * This->Media->BlockSize;
-    if (BytesRemainingToBeTransfered < ConsumeSize) {
-      ConsumeSize = BytesRemainingToBeTransfered;
-    }
-
     Status = MmcTransferBlock (This, Cmd, Transfer, MediaId, Lba, ConsumeSize, Buffer, &ConsumeSize);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "%a(): Failed to transfer block and Status:%r\n", __func__, Status));
@@ -420,7 +491,7 @@ MmcIoBlocks (
 
     BytesRemainingToBeTransfered -= ConsumeSize;
     if (BytesRemainingToBeTransfered > 0) {
-      Lba += BlockCount;
+      Lba += ConsumeSize / This->Media->BlockSize;
       Buffer = (UINT8*)Buffer + ConsumeSize;
     }
   }
@@ -428,6 +499,156 @@ MmcIoBlocks (
   return EFI_SUCCESS;
 }
 
+/**
+  Runs every queued BlockIo2 request in order, signaling each token as
+  its request completes. Must be called at TPL_CALLBACK.
+**/
+STATIC
+VOID
+MmcProcessIo2Requests (
+  IN MMC_HOST_INSTANCE      *MmcHostInstance
+  )
+{
+  LIST_ENTRY              *Link;
+  MMC_IO2_REQUEST         *Request;
+
+  while (!IsListEmpty (&MmcHostInstance->Io2Queue)) {
+    Link = GetFirstNode (&MmcHostInstance->Io2Queue);
+    Request = MMC_IO2_REQUEST_FROM_LINK (Link);
+    RemoveEntryList (Link);
+
+    if (Request->Transfer == MMC_IOBLOCKS_FLUSH) {
+      Request->Token->TransactionStatus = MmcFlushBlocks (&MmcHostInstance->BlockIo);
+    } else {
+      Request->Token->TransactionStatus = MmcIoBlocks (&MmcHostInstance->BlockIo,
+                                            Request->Transfer, Request->MediaId,
+                                            Request->Lba, Request->BufferSize,
+                                            Request->Buffer);
+    }
+
+    gBS->SignalEvent (Request->Token->Event);
+    FreePool (Request);
+  }
+}
+
+VOID
+MmcAbortIo2Requests (
+  IN MMC_HOST_INSTANCE      *MmcHostInstance
+  )
+{
+  EFI_TPL                 OldTpl;
+  LIST_ENTRY              *Link;
+  MMC_IO2_REQUEST         *Request;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  while (!IsListEmpty (&MmcHostInstance->Io2Queue)) {
+    Link = GetFirstNode (&MmcHostInstance->Io2Queue);
+    Request = MMC_IO2_REQUEST_FROM_LINK (Link);
+    RemoveEntryList (Link);
+
+    Request->Token->TransactionStatus = EFI_ABORTED;
+    gBS->SignalEvent (Request->Token->Event);
+    FreePool (Request);
+  }
+  gBS->RestoreTPL (OldTpl);
+}
+
+VOID
+EFIAPI
+MmcIo2Callback (
+  IN  EFI_EVENT   Event,
+  IN  VOID        *Context
+  )
+{
+  MmcProcessIo2Requests ((MMC_HOST_INSTANCE *)Context);
+}
+
+/**
+  Runs a blocking request behind anything already queued, so that it
+  observes the effect of earlier non-blocking writes.
+**/
+STATIC
+EFI_STATUS
+MmcIoBlocksSync (
+  IN MMC_HOST_INSTANCE        *MmcHostInstance,
+  IN UINTN                    Transfer,
+  IN UINT32                   MediaId,
+  IN EFI_LBA                  Lba,
+  IN UINTN                    BufferSize,
+  IN OUT VOID                 *Buffer
+  )
+{
+  EFI_STATUS              Status;
+  EFI_TPL                 OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  MmcProcessIo2Requests (MmcHostInstance);
+  if (Transfer == MMC_IOBLOCKS_FLUSH) {
+    Status = MmcFlushBlocks (&MmcHostInstance->BlockIo);
+  } else {
+    Status = MmcIoBlocks (&MmcHostInstance->BlockIo, Transfer, MediaId, Lba,
+               BufferSize, Buffer);
+  }
+  gBS->RestoreTPL (OldTpl);
+
+  return Status;
+}
+
+/**
+  Queues a non-blocking request, to be run from the Io2Event callback.
+**/
+STATIC
+EFI_STATUS
+MmcIoBlocksAsync (
+  IN MMC_HOST_INSTANCE        *MmcHostInstance,
+  IN UINTN                    Transfer,
+  IN UINT32                   MediaId,
+  IN EFI_LBA                  Lba,
+  IN EFI_BLOCK_IO2_TOKEN      *Token,
+  IN UINTN                    BufferSize,
+  IN OUT VOID                 *Buffer
+  )
+{
+  EFI_STATUS              Status;
+  EFI_TPL                 OldTpl;
+  MMC_IO2_REQUEST         *Request;
+
+  if (Transfer != MMC_IOBLOCKS_FLUSH) {
+    Status = MmcCheckIoBlocks (&MmcHostInstance->BlockIo, Transfer, MediaId, Lba,
+               BufferSize, Buffer);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (BufferSize == 0) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+      return EFI_SUCCESS;
+    }
+  }
+
+  Request = AllocatePool (sizeof (MMC_IO2_REQUEST));
+  if (Request == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Request->Signature = MMC_IO2_REQUEST_SIGNATURE;
+  Request->Transfer = Transfer;
+  Request->MediaId = MediaId;
+  Request->Lba = Lba;
+  Request->BufferSize = BufferSize;
+  Request->Buffer = Buffer;
+  Request->Token = Token;
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  InsertTailList (&MmcHostInstance->Io2Queue, &Request->Link);
+  Status = gBS->SetTimer (MmcHostInstance->Io2Event, TimerRelative, 0);
+  ASSERT_EFI_ERROR (Status);
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 EFIAPI
 MmcReadBlocks (
@@ -438,7 +659,8 @@ MmcReadBlocks (
   OUT VOID                    *Buffer
   )
 {
-  return MmcIoBlocks (This, MMC_IOBLOCKS_READ, MediaId, Lba, BufferSize, Buffer);
+  return MmcIoBlocksSync (MMC_HOST_INSTANCE_FROM_BLOCK_IO_THIS (This),
+           MMC_IOBLOCKS_READ, MediaId, Lba, BufferSize, Buffer);
 }
 
 EFI_STATUS
@@ -451,7 +673,8 @@ MmcWriteBlocks (
   IN VOID                     *Buffer
   )
 {
-  return MmcIoBlocks (This, MMC_IOBLOCKS_WRITE, MediaId, Lba, BufferSize, Buffer);
+  return MmcIoBlocksSync (MMC_HOST_INSTANCE_FROM_BLOCK_IO_THIS (This),
+           MMC_IOBLOCKS_WRITE, MediaId, Lba, BufferSize, Buffer);
 }
 
 EFI_STATUS
@@ -462,3 +685,84 @@ MmcFlushBlocks (
 {
   return EFI_SUCCESS;
 }
+
+EFI_STATUS
+EFIAPI
+MmcResetEx (
+  IN EFI_BLOCK_IO2_PROTOCOL   *This,
+  IN BOOLEAN                  ExtendedVerification
+  )
+{
+  MMC_HOST_INSTANCE       *MmcHostInstance;
+
+  MmcHostInstance = MMC_HOST_INSTANCE_FROM_BLOCK_IO2_THIS (This);
+
+  MmcAbortIo2Requests (MmcHostInstance);
+  return MmcReset (&MmcHostInstance->BlockIo, ExtendedVerification);
+}
+
+EFI_STATUS
+EFIAPI
+MmcReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL *This,
+  IN     UINT32                 MediaId,
+  IN     EFI_LBA                Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN    *Token,
+  IN     UINTN                  BufferSize,
+  OUT    VOID                   *Buffer
+  )
+{
+  MMC_HOST_INSTANCE       *MmcHostInstance;
+
+  MmcHostInstance = MMC_HOST_INSTANCE_FROM_BLOCK_IO2_THIS (This);
+
+  if ((Token == NULL) || (Token->Event == NULL)) {
+    return MmcIoBlocksSync (MmcHostInstance, MMC_IOBLOCKS_READ, MediaId, Lba,
+             BufferSize, Buffer);
+  }
+
+  return MmcIoBlocksAsync (MmcHostInstance, MMC_IOBLOCKS_READ, MediaId, Lba,
+           Token, BufferSize, Buffer);
+}
+
+EFI_STATUS
+EFIAPI
+MmcWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL *This,
+  IN     UINT32                 MediaId,
+  IN     EFI_LBA                Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN    *Token,
+  IN     UINTN                  BufferSize,
+  IN     VOID                   *Buffer
+  )
+{
+  MMC_HOST_INSTANCE       *MmcHostInstance;
+
+  MmcHostInstance = MMC_HOST_INSTANCE_FROM_BLOCK_IO2_THIS (This);
+
+  if ((Token == NULL) || (Token->Event == NULL)) {
+    return MmcIoBlocksSync (MmcHostInstance, MMC_IOBLOCKS_WRITE, MediaId, Lba,
+             BufferSize, Buffer);
+  }
+
+  return MmcIoBlocksAsync (MmcHostInstance, MMC_IOBLOCKS_WRITE, MediaId, Lba,
+           Token, BufferSize, Buffer);
+}
+
+EFI_STATUS
+EFIAPI
+MmcFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN    *Token
+  )
+{
+  MMC_HOST_INSTANCE       *MmcHostInstance;
+
+  MmcHostInstance = MMC_HOST_INSTANCE_FROM_BLOCK_IO2_THIS (This);
+
+  if ((Token == NULL) || (Token->Event == NULL)) {
+    return MmcIoBlocksSync (MmcHostInstance, MMC_IOBLOCKS_FLUSH, 0, 0, 0, NULL);
+  }
+
+  return MmcIoBlocksAsync (MmcHostInstance, MMC_IOBLOCKS_FLUSH, 0, 0, Token, 0, NULL);
+}
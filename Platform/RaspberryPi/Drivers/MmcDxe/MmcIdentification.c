@@ -45,6 +45,8 @@ typedef union {
 
 #define SD_CCC_SWITCH           (1 << 10)
 
+#define SD_CMD_SUPPORT_CMD23    (1 << 1)
+
 #define DEVICE_STATE(x)         (((x) >> 9) & 0xf)
 typedef enum _EMMC_DEVICE_STATE {
   EMMC_IDLE_STATE = 0,
@@ -242,6 +244,8 @@ EmmcIdentificationMode (
 
   // Setup card type
   MmcHostInstance->CardInfo.CardType = EMMC_CARD;
+  // CMD23 is mandatory for eMMC
+  MmcHostInstance->CardInfo.SupportsCmd23 = TRUE;
   return EFI_SUCCESS;
 
 FreePageExit:
@@ -670,6 +674,8 @@ InitializeSdMmcDevice (
     return Status;
   }
 
+  // SdExecuteScr() leaves Scr untouched if the card didn't take ACMD51
+  ZeroMem (&Scr, sizeof (Scr));
   Status = SdExecuteScr (MmcHostInstance, &Scr);
   if (EFI_ERROR (Status)) {
      return Status;
@@ -706,6 +712,10 @@ InitializeSdMmcDevice (
     return Status;
   }
 
+  if (Scr.CMD_SUPPORT & SD_CMD_SUPPORT_CMD23) {
+    MmcHostInstance->CardInfo.SupportsCmd23 = TRUE;
+  }
+
   if (Scr.SD_BUS_WIDTHS & SD_BUS_WIDTH_4BIT) {
     Status = SdSet4Bit (MmcHostInstance);
     if (EFI_ERROR (Status)) {
@@ -956,6 +966,7 @@ InitializeMmcDevice (
 
   BlockCount = 1;
   MmcHost = MmcHostInstance->MmcHost;
+  MmcHostInstance->CardInfo.SupportsCmd23 = FALSE;
 
   Status = MmcIdentificationMode (MmcHostInstance);
   if (EFI_ERROR (Status)) {
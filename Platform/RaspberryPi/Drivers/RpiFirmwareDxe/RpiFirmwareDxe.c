@@ -37,6 +37,31 @@ STATIC UINTN mDmaBufferBusAddress;
 
 STATIC SPIN_LOCK mMailboxLock;
 
+//
+// Static board information, fetched from the firmware in a single
+// mailbox transaction at driver initialization. Each BOARD_INFO_xxx
+// bit in Valid indicates that the corresponding field is populated.
+//
+#define BOARD_INFO_MODEL            BIT0
+#define BOARD_INFO_MODEL_REVISION   BIT1
+#define BOARD_INFO_FW_REVISION      BIT2
+#define BOARD_INFO_SERIAL           BIT3
+#define BOARD_INFO_MAC_ADDRESS      BIT4
+#define BOARD_INFO_ARM_MEMORY       BIT5
+
+typedef struct {
+  UINT32    Valid;
+  UINT32    Model;
+  UINT32    ModelRevision;
+  UINT32    FirmwareRevision;
+  UINT64    Serial;
+  UINT8     MacAddress[6];
+  UINT32    ArmMemoryBase;
+  UINT32    ArmMemorySize;
+} RPI_FW_BOARD_INFO;
+
+STATIC RPI_FW_BOARD_INFO mBoardInfo;
+
 STATIC
 BOOLEAN
 DrainMailbox (
@@ -249,6 +274,12 @@ RpiFirmwareGetArmMemory (
   EFI_STATUS                  Status;
   UINT32                      Result;
 
+  if ((mBoardInfo.Valid & BOARD_INFO_ARM_MEMORY) != 0) {
+    *Base = mBoardInfo.ArmMemoryBase;
+    *Size = mBoardInfo.ArmMemorySize;
+    return EFI_SUCCESS;
+  }
+
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __FUNCTION__));
     return EFI_DEVICE_ERROR;
@@ -308,6 +339,11 @@ RpiFirmwareGetMacAddress (
   EFI_STATUS                  Status;
   UINT32                      Result;
 
+  if ((mBoardInfo.Valid & BOARD_INFO_MAC_ADDRESS) != 0) {
+    CopyMem (MacAddress, mBoardInfo.MacAddress, sizeof (mBoardInfo.MacAddress));
+    return EFI_SUCCESS;
+  }
+
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __FUNCTION__));
     return EFI_DEVICE_ERROR;
@@ -364,6 +400,12 @@ RpiFirmwareGetSerial (
   EFI_STATUS                  Status;
   UINT32                      Result;
 
+  if ((mBoardInfo.Valid & BOARD_INFO_SERIAL) != 0) {
+    *Serial = mBoardInfo.Serial;
+    Status = EFI_SUCCESS;
+    goto CheckSerial;
+  }
+
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __FUNCTION__));
     return EFI_DEVICE_ERROR;
@@ -392,6 +434,8 @@ RpiFirmwareGetSerial (
 
   *Serial = Cmd->TagBody.Serial;
   ReleaseSpinLock (&mMailboxLock);
+
+CheckSerial:
   // Some platforms return 0 or 0x0000000010000000 for serial.
   // For those, try to use the MAC address.
   if ((*Serial == 0) || ((*Serial & 0xFFFFFFFF0FFFFFFFULL) == 0)) {
@@ -427,6 +471,11 @@ RpiFirmwareGetModel (
   EFI_STATUS                  Status;
   UINT32                      Result;
 
+  if ((mBoardInfo.Valid & BOARD_INFO_MODEL) != 0) {
+    *Model = mBoardInfo.Model;
+    return EFI_SUCCESS;
+  }
+
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __FUNCTION__));
     return EFI_DEVICE_ERROR;
@@ -483,6 +532,11 @@ RpiFirmwareGetModelRevision (
   EFI_STATUS                    Status;
   UINT32                        Result;
 
+  if ((mBoardInfo.Valid & BOARD_INFO_MODEL_REVISION) != 0) {
+    *Revision = mBoardInfo.ModelRevision;
+    return EFI_SUCCESS;
+  }
+
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __FUNCTION__));
     return EFI_DEVICE_ERROR;
@@ -526,6 +580,11 @@ RpiFirmwareGetFirmwareRevision (
   EFI_STATUS                    Status;
   UINT32                        Result;
 
+  if ((mBoardInfo.Valid & BOARD_INFO_FW_REVISION) != 0) {
+    *Revision = mBoardInfo.FirmwareRevision;
+    return EFI_SUCCESS;
+  }
+
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __FUNCTION__));
     return EFI_DEVICE_ERROR;
@@ -1532,6 +1591,105 @@ RpiFirmwareNotifyGpioSetCfg (
   return Status;
 }
 
+#pragma pack(1)
+typedef struct {
+  RPI_FW_BUFFER_HEAD        BufferHead;
+  RPI_FW_TAG_HEAD           ModelTag;
+  RPI_FW_MODEL_TAG          Model;
+  RPI_FW_TAG_HEAD           ModelRevisionTag;
+  RPI_FW_MODEL_REVISION_TAG ModelRevision;
+  RPI_FW_TAG_HEAD           FirmwareRevisionTag;
+  RPI_FW_MODEL_REVISION_TAG FirmwareRevision;
+  RPI_FW_TAG_HEAD           SerialTag;
+  RPI_FW_SERIAL_TAG         Serial;
+  RPI_FW_TAG_HEAD           MacAddressTag;
+  RPI_FW_MAC_ADDR_TAG       MacAddress;
+  RPI_FW_TAG_HEAD           ArmMemoryTag;
+  RPI_FW_ARM_MEMORY_TAG     ArmMemory;
+  UINT32                    EndTag;
+} RPI_FW_GET_BOARD_INFO_CMD;
+#pragma pack()
+
+//
+// Query all the static board properties in a single property buffer,
+// rather than one mailbox round trip per tag when each is first used.
+// A tag the firmware did not answer is simply left out of the cache,
+// and the corresponding getter falls back to querying it directly.
+//
+STATIC
+VOID
+RpiFirmwarePrefetchBoardInfo (
+  VOID
+  )
+{
+  RPI_FW_GET_BOARD_INFO_CMD   *Cmd;
+  EFI_STATUS                  Status;
+  UINT32                      Result;
+
+  if (!AcquireSpinLockOrFail (&mMailboxLock)) {
+    DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __FUNCTION__));
+    return;
+  }
+
+  Cmd = mDmaBuffer;
+  ZeroMem (Cmd, sizeof (*Cmd));
+
+  Cmd->BufferHead.BufferSize            = sizeof (*Cmd);
+  Cmd->BufferHead.Response              = 0;
+  Cmd->ModelTag.TagId                   = RPI_MBOX_GET_BOARD_MODEL;
+  Cmd->ModelTag.TagSize                 = sizeof (Cmd->Model);
+  Cmd->ModelRevisionTag.TagId           = RPI_MBOX_GET_BOARD_REVISION;
+  Cmd->ModelRevisionTag.TagSize         = sizeof (Cmd->ModelRevision);
+  Cmd->FirmwareRevisionTag.TagId        = RPI_MBOX_GET_REVISION;
+  Cmd->FirmwareRevisionTag.TagSize      = sizeof (Cmd->FirmwareRevision);
+  Cmd->SerialTag.TagId                  = RPI_MBOX_GET_BOARD_SERIAL;
+  Cmd->SerialTag.TagSize                = sizeof (Cmd->Serial);
+  Cmd->MacAddressTag.TagId              = RPI_MBOX_GET_MAC_ADDRESS;
+  Cmd->MacAddressTag.TagSize            = sizeof (Cmd->MacAddress);
+  Cmd->ArmMemoryTag.TagId               = RPI_MBOX_GET_ARM_MEMSIZE;
+  Cmd->ArmMemoryTag.TagSize             = sizeof (Cmd->ArmMemory);
+  Cmd->EndTag                           = 0;
+
+  Status = MailboxTransaction (Cmd->BufferHead.BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
+
+  if (EFI_ERROR (Status) ||
+      Cmd->BufferHead.Response != RPI_MBOX_RESP_SUCCESS) {
+    DEBUG ((DEBUG_WARN,
+      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
+      __FUNCTION__, Status, Cmd->BufferHead.Response));
+    ReleaseSpinLock (&mMailboxLock);
+    return;
+  }
+
+  if (Cmd->ModelTag.TagValueSize & RPI_MBOX_VALUE_SIZE_RESPONSE_MASK) {
+    mBoardInfo.Model = Cmd->Model.Model;
+    mBoardInfo.Valid |= BOARD_INFO_MODEL;
+  }
+  if (Cmd->ModelRevisionTag.TagValueSize & RPI_MBOX_VALUE_SIZE_RESPONSE_MASK) {
+    mBoardInfo.ModelRevision = Cmd->ModelRevision.Revision;
+    mBoardInfo.Valid |= BOARD_INFO_MODEL_REVISION;
+  }
+  if (Cmd->FirmwareRevisionTag.TagValueSize & RPI_MBOX_VALUE_SIZE_RESPONSE_MASK) {
+    mBoardInfo.FirmwareRevision = Cmd->FirmwareRevision.Revision;
+    mBoardInfo.Valid |= BOARD_INFO_FW_REVISION;
+  }
+  if (Cmd->SerialTag.TagValueSize & RPI_MBOX_VALUE_SIZE_RESPONSE_MASK) {
+    mBoardInfo.Serial = Cmd->Serial.Serial;
+    mBoardInfo.Valid |= BOARD_INFO_SERIAL;
+  }
+  if (Cmd->MacAddressTag.TagValueSize & RPI_MBOX_VALUE_SIZE_RESPONSE_MASK) {
+    CopyMem (mBoardInfo.MacAddress, Cmd->MacAddress.MacAddress,
+      sizeof (mBoardInfo.MacAddress));
+    mBoardInfo.Valid |= BOARD_INFO_MAC_ADDRESS;
+  }
+  if (Cmd->ArmMemoryTag.TagValueSize & RPI_MBOX_VALUE_SIZE_RESPONSE_MASK) {
+    mBoardInfo.ArmMemoryBase = Cmd->ArmMemory.Base;
+    mBoardInfo.ArmMemorySize = Cmd->ArmMemory.Size;
+    mBoardInfo.Valid |= BOARD_INFO_ARM_MEMORY;
+  }
+  ReleaseSpinLock (&mMailboxLock);
+}
+
 STATIC RASPBERRY_PI_FIRMWARE_PROTOCOL mRpiFirmwareProtocol = {
   RpiFirmwareSetPowerState,
   RpiFirmwareGetMacAddress,
@@ -1607,6 +1765,8 @@ RpiFirmwareDxeInitialize (
   //
   ASSERT (!(mDmaBufferBusAddress & (BCM2836_MBOX_NUM_CHANNELS - 1)));
 
+  RpiFirmwarePrefetchBoardInfo ();
+
   Status = gBS->InstallProtocolInterface (&ImageHandle,
                   &gRaspberryPiFirmwareProtocolGuid, EFI_NATIVE_INTERFACE,
                   &mRpiFirmwareProtocol);
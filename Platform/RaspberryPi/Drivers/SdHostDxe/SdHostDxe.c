@@ -42,6 +42,19 @@
 
 #define IDENT_MODE_SD_CLOCK_FREQ_HZ         400000 // 400KHz
 
+// DMA Parameters
+#define SDHOST_DMA_CHANNEL                  4
+#define SDHOST_DMA_REG(X)                   (BCM2836_DMA_CHANNEL_BASE_ADDRESS (SDHOST_DMA_CHANNEL) + (X))
+#define SDHOST_DMA_MAX_POLL_US              5000000 // 5s
+#define FIFO_READ_THRESHOLD                 4
+#define FIFO_WRITE_THRESHOLD                4
+
+//
+// The controller doesn't raise the DREQ for the last few words of a
+// multi-block read, so those are drained from the FIFO by the CPU.
+//
+#define SDHOST_DMA_READ_DRAIN_BYTES         ((FIFO_READ_THRESHOLD - 1) * sizeof (UINT32))
+
 // Macros adopted from MmcDxe internal header
 #define SDHOST_R0_READY_FOR_DATA            BIT8
 #define SDHOST_R0_CURRENTSTATE(Response)    ((Response >> 9) & 0xF)
@@ -50,8 +63,22 @@
 #define DEBUG_MMCHOST_SD_INFO  DEBUG_INFO
 #define DEBUG_MMCHOST_SD_ERROR DEBUG_ERROR
 
+typedef struct {
+  UINT32 TransferInfo;
+  UINT32 SourceAddress;
+  UINT32 DestinationAddress;
+  UINT32 TransferLength;
+  UINT32 Stride;
+  UINT32 NextControlBlock;
+  UINT32 Reserved[2];
+} SDHOST_DMA_CONTROL_BLOCK;
+
 STATIC RASPBERRY_PI_FIRMWARE_PROTOCOL   *mFwProtocol;
 
+STATIC SDHOST_DMA_CONTROL_BLOCK *mDmaControlBlock;
+STATIC EFI_PHYSICAL_ADDRESS     mDmaControlBlockBusAddress;
+STATIC VOID                     *mDmaControlBlockMapping;
+
 // Per Physical Layer Simplified Specs
 #ifndef NDEBUG
 STATIC CONST CHAR8* mStrSdState[] = { "idle", "ready", "ident", "stby",
@@ -67,6 +94,7 @@ STATIC CONST CHAR8 *mFsmState[] = { "identmode", "datamode", "readdata",
 STATIC BOOLEAN mCardIsPresent = FALSE;
 STATIC CARD_DETECT_STATE mCardDetectState = CardDetectRequired;
 STATIC UINT32 mLastGoodCmd = MMC_GET_INDX (MMC_CMD0);
+STATIC UINT32 mSetBlockCount = 0;
 
 STATIC inline BOOLEAN
 IsAppCmd (
@@ -359,6 +387,11 @@ SdSendCommand (
     } else {
       MmioWrite32 (SDHOST_HBCT, SDHOST_BLOCK_BYTE_LENGTH);
     }
+
+    if (MmcCmd == MMC_CMD18 || MmcCmd == MMC_CMD25) {
+      // Stop after the CMD23 block count, or run until CMD12 if none was set
+      MmioWrite32 (SDHOST_HBLC, (mLastGoodCmd == MMC_CMD23) ? mSetBlockCount : 0);
+    }
   }
 
   DEBUG ((DEBUG_MMCHOST_SD,
@@ -454,6 +487,9 @@ SdSendCommand (
 
   if (IsCmdExecuted && !EFI_ERROR (Status)) {
     ASSERT (!(MmioRead32 (SDHOST_HSTS) & SDHOST_HSTS_ERROR));
+    if (MmcCmd == MMC_CMD23 && !IsAppCmd ()) {
+      mSetBlockCount = Argument & 0xFFFF;
+    }
     mLastGoodCmd = MmcCmd;
   }
 
@@ -495,6 +531,170 @@ SdReceiveResponse (
   return EFI_SUCCESS;
 }
 
+/**
+  Moves words between the buffer and the data FIFO by hand, using the
+  FIFO fill level to move as many words as possible per status read.
+
+  @param[in, out] Buffer    Buffer to fill or drain.
+  @param[in]      NumWords  Number of 32-bit words to transfer.
+  @param[in]      IsWrite   TRUE to write Buffer to the card.
+
+  @retval EFI_SUCCESS       All words were transferred.
+  @retval EFI_DEVICE_ERROR  The controller reported an error.
+  @retval EFI_TIMEOUT       The FIFO stopped making progress.
+**/
+STATIC EFI_STATUS
+SdHostPioTransfer (
+  IN OUT UINT32   *Buffer,
+  IN     UINTN    NumWords,
+  IN     BOOLEAN  IsWrite
+  )
+{
+  UINTN   WordIdx;
+  UINT32  PollCount;
+  UINT32  FifoWords;
+
+  WordIdx = 0;
+  PollCount = 0;
+  while (WordIdx < NumWords) {
+    FifoWords = SDHOST_EDM_FIFO_COUNT (MmioRead32 (SDHOST_EDM));
+    if (IsWrite) {
+      FifoWords = SDHOST_FIFO_WORDS - FifoWords;
+    }
+
+    if (FifoWords == 0) {
+      if ((MmioRead32 (SDHOST_HSTS) & SDHOST_HSTS_ERROR) != 0) {
+        DEBUG ((DEBUG_MMCHOST_SD_ERROR,
+          "SdHost: SdHostPioTransfer(): Block Word%d %a failed\n",
+          WordIdx, IsWrite ? "write" : "read"));
+        return EFI_DEVICE_ERROR;
+      }
+
+      if (++PollCount == FIFO_MAX_POLL_COUNT) {
+        DEBUG ((DEBUG_MMCHOST_SD_ERROR,
+          "SdHost: SdHostPioTransfer(): Block Word%d %a poll timed-out\n",
+          WordIdx, IsWrite ? "write" : "read"));
+        return EFI_TIMEOUT;
+      }
+
+      gBS->Stall (CMD_STALL_AFTER_POLL_US);
+      continue;
+    }
+
+    PollCount = 0;
+    FifoWords = MIN (FifoWords, NumWords - WordIdx);
+    while (FifoWords-- > 0) {
+      if (IsWrite) {
+        MmioWrite32 (SDHOST_DATA, Buffer[WordIdx]);
+      } else {
+        Buffer[WordIdx] = MmioRead32 (SDHOST_DATA);
+      }
+      ++WordIdx;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Moves a run of whole blocks between the buffer and the data FIFO using
+  the DMA engine, paced by the SDHOST DREQ.
+
+  @param[in, out] Buffer    Buffer to fill or drain.
+  @param[in]      Length    Number of bytes to transfer.
+  @param[in]      IsWrite   TRUE to write Buffer to the card.
+
+  @retval EFI_SUCCESS       All bytes were transferred.
+  @retval EFI_UNSUPPORTED   The buffer can't be reached by the DMA engine;
+                            nothing was transferred and PIO should be used.
+  @retval EFI_DEVICE_ERROR  The controller or the DMA engine reported an error.
+  @retval EFI_TIMEOUT       The transfer did not complete in time.
+**/
+STATIC EFI_STATUS
+SdHostDmaTransfer (
+  IN OUT UINT32   *Buffer,
+  IN     UINTN    Length,
+  IN     BOOLEAN  IsWrite
+  )
+{
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  DeviceAddress;
+  UINTN                 MappedLength;
+  VOID                  *Mapping;
+  UINT32                PollCount;
+  UINT32                Cs;
+
+  if (mDmaControlBlock == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  MappedLength = Length;
+  Status = DmaMap (IsWrite ? MapOperationBusMasterRead : MapOperationBusMasterWrite,
+             Buffer, &MappedLength, &DeviceAddress, &Mapping);
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if ((MappedLength != Length) || (DeviceAddress + Length > SIZE_4GB)) {
+    DmaUnmap (Mapping);
+    return EFI_UNSUPPORTED;
+  }
+
+  if (IsWrite) {
+    mDmaControlBlock->TransferInfo = BCM2836_DMA_TI_SRC_INC | BCM2836_DMA_TI_DEST_DREQ;
+    mDmaControlBlock->SourceAddress = (UINT32)DeviceAddress;
+    mDmaControlBlock->DestinationAddress = SDHOST_DATA_BUS_ADDRESS;
+  } else {
+    mDmaControlBlock->TransferInfo = BCM2836_DMA_TI_DEST_INC | BCM2836_DMA_TI_SRC_DREQ;
+    mDmaControlBlock->SourceAddress = SDHOST_DATA_BUS_ADDRESS;
+    mDmaControlBlock->DestinationAddress = (UINT32)DeviceAddress;
+  }
+  mDmaControlBlock->TransferInfo |= BCM2836_DMA_TI_WAIT_RESP |
+                                    BCM2836_DMA_TI_PERMAP (SDHOST_DMA_DREQ);
+  mDmaControlBlock->TransferLength = (UINT32)Length;
+  mDmaControlBlock->Stride = 0;
+  mDmaControlBlock->NextControlBlock = 0;
+  MemoryFence ();
+
+  MmioOr32 (BCM2836_DMA_ENABLE, 1 << SDHOST_DMA_CHANNEL);
+  MmioWrite32 (SDHOST_DMA_REG (BCM2836_DMA_CS), BCM2836_DMA_CS_RESET);
+  MmioWrite32 (SDHOST_DMA_REG (BCM2836_DMA_DEBUG), BCM2836_DMA_DEBUG_ERRORS);
+  MmioWrite32 (SDHOST_DMA_REG (BCM2836_DMA_CONBLK_AD), (UINT32)mDmaControlBlockBusAddress);
+  MmioWrite32 (SDHOST_DMA_REG (BCM2836_DMA_CS),
+    BCM2836_DMA_CS_ACTIVE | BCM2836_DMA_CS_WAIT_FOR_OUTSTANDING_WRITES);
+
+  Status = EFI_TIMEOUT;
+  for (PollCount = 0; PollCount < SDHOST_DMA_MAX_POLL_US; ++PollCount) {
+    Cs = MmioRead32 (SDHOST_DMA_REG (BCM2836_DMA_CS));
+    if ((Cs & BCM2836_DMA_CS_ERROR) != 0 ||
+        (MmioRead32 (SDHOST_HSTS) & SDHOST_HSTS_ERROR) != 0) {
+      Status = EFI_DEVICE_ERROR;
+      break;
+    }
+
+    if ((Cs & BCM2836_DMA_CS_END) != 0) {
+      Status = EFI_SUCCESS;
+      break;
+    }
+
+    gBS->Stall (CMD_STALL_AFTER_POLL_US);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_MMCHOST_SD_ERROR,
+      "SdHost: SdHostDmaTransfer(): %a of 0x%x bytes failed: %r (CS 0x%8.8X, DEBUG 0x%8.8X)\n",
+      IsWrite ? "write" : "read", Length, Status,
+      MmioRead32 (SDHOST_DMA_REG (BCM2836_DMA_CS)),
+      MmioRead32 (SDHOST_DMA_REG (BCM2836_DMA_DEBUG))));
+    MmioWrite32 (SDHOST_DMA_REG (BCM2836_DMA_CS), BCM2836_DMA_CS_RESET);
+  } else {
+    MmioWrite32 (SDHOST_DMA_REG (BCM2836_DMA_CS), BCM2836_DMA_CS_END | BCM2836_DMA_CS_INT);
+  }
+
+  DmaUnmap (Mapping);
+  return Status;
+}
+
 STATIC EFI_STATUS
 SdReadBlockData (
   IN EFI_MMC_HOST_PROTOCOL    *This,
@@ -509,35 +709,36 @@ SdReadBlockData (
   ASSERT (Buffer != NULL);
   ASSERT (Length % 4 == 0);
 
-  EFI_STATUS Status = EFI_SUCCESS;
+  EFI_STATUS Status = EFI_UNSUPPORTED;
 
   mFwProtocol->SetLed (TRUE);
   {
-    UINT32 NumWords = Length / 4;
-    UINT32 WordIdx;
-
-    for (WordIdx = 0; WordIdx < NumWords; ++WordIdx) {
-      UINT32 PollCount = 0;
-      while (PollCount < FIFO_MAX_POLL_COUNT) {
-        UINT32 Hsts = MmioRead32 (SDHOST_HSTS);
-        if ((Hsts & SDHOST_HSTS_DATA_FLAG) != 0) {
-          MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_DATA_FLAG);
-          Buffer[WordIdx] = MmioRead32 (SDHOST_DATA);
-          break;
-        }
-
-        ++PollCount;
-        gBS->Stall (CMD_STALL_AFTER_RETRY_US);
+    UINTN DmaLength = 0;
+
+    //
+    // Only whole blocks go through DMA; the short reads used to fetch
+    // the SCR and switch status stay on PIO.
+    //
+    if (Length % SDHOST_BLOCK_BYTE_LENGTH == 0) {
+      DmaLength = Length;
+      if (Length > SDHOST_BLOCK_BYTE_LENGTH) {
+        DmaLength -= SDHOST_DMA_READ_DRAIN_BYTES;
       }
+      Status = SdHostDmaTransfer (Buffer, DmaLength, FALSE);
+    }
 
-      if (PollCount == FIFO_MAX_POLL_COUNT) {
-        DEBUG ((DEBUG_MMCHOST_SD_ERROR,
-            "SdHost: SdReadBlockData(): Block Word%d read poll timed-out\n", WordIdx));
-        SdHostDumpStatus ();
-        MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_CLEAR);
-        Status = EFI_TIMEOUT;
-        break;
-      }
+    if (Status == EFI_UNSUPPORTED) {
+      DmaLength = 0;
+      Status = EFI_SUCCESS;
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = SdHostPioTransfer (Buffer + DmaLength / 4, (Length - DmaLength) / 4, FALSE);
+    }
+
+    if (EFI_ERROR (Status)) {
+      SdHostDumpStatus ();
+      MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_CLEAR);
     }
   }
   mFwProtocol->SetLed (FALSE);
@@ -560,34 +761,18 @@ SdWriteBlockData (
   ASSERT (Buffer != NULL);
   ASSERT (Length % SDHOST_BLOCK_BYTE_LENGTH == 0);
 
-  EFI_STATUS Status = EFI_SUCCESS;
+  EFI_STATUS Status;
 
   mFwProtocol->SetLed (TRUE);
   {
-    UINT32 NumWords = Length / 4;
-    UINT32 WordIdx;
-
-    for (WordIdx = 0; WordIdx < NumWords; ++WordIdx) {
-      UINT32 PollCount = 0;
-      while (PollCount < FIFO_MAX_POLL_COUNT) {
-        if (MmioRead32 (SDHOST_HSTS) & SDHOST_HSTS_DATA_FLAG) {
-          MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_DATA_FLAG);
-          MmioWrite32 (SDHOST_DATA, Buffer[WordIdx]);
-          break;
-        }
-
-        ++PollCount;
-        gBS->Stall (CMD_STALL_AFTER_RETRY_US);
-      }
+    Status = SdHostDmaTransfer (Buffer, Length, TRUE);
+    if (Status == EFI_UNSUPPORTED) {
+      Status = SdHostPioTransfer (Buffer, Length / 4, TRUE);
+    }
 
-      if (PollCount == FIFO_MAX_POLL_COUNT) {
-        DEBUG ((DEBUG_MMCHOST_SD_ERROR,
-          "SdHost: SdWriteBlockData(): Block Word%d write poll timed-out\n", WordIdx));
-        SdHostDumpStatus ();
-        MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_CLEAR);
-        Status = EFI_TIMEOUT;
-        break;
-      }
+    if (EFI_ERROR (Status)) {
+      SdHostDumpStatus ();
+      MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_CLEAR);
     }
   }
   mFwProtocol->SetLed (FALSE);
@@ -666,6 +851,13 @@ SdNotifyState (
 
     gBS->Stall (STALL_TO_STABILIZE_US);
 
+    // Program the FIFO levels at which the DMA DREQ is raised
+    MmioAndThenOr32 (SDHOST_EDM,
+      ~((SDHOST_EDM_THRESHOLD_MASK << SDHOST_EDM_READ_THRESHOLD_SHIFT) |
+        (SDHOST_EDM_THRESHOLD_MASK << SDHOST_EDM_WRITE_THRESHOLD_SHIFT)),
+      SDHOST_EDM_READ_THRESHOLD (FIFO_READ_THRESHOLD) |
+      SDHOST_EDM_WRITE_THRESHOLD (FIFO_WRITE_THRESHOLD));
+
     // Write controller configs
     UINT32 Hcfg = 0;
     Hcfg |= SDHOST_HCFG_WIDE_INT_BUS;
@@ -787,6 +979,14 @@ SdIsMultiBlock (
   return TRUE;
 }
 
+BOOLEAN
+SdIsSetBlockCount (
+  IN EFI_MMC_HOST_PROTOCOL *This
+  )
+{
+  return TRUE;
+}
+
 EFI_MMC_HOST_PROTOCOL gMmcHost =
   {
     MMC_HOST_PROTOCOL_REVISION,
@@ -799,7 +999,8 @@ EFI_MMC_HOST_PROTOCOL gMmcHost =
     SdReadBlockData,
     SdWriteBlockData,
     SdSetIos,
-    SdIsMultiBlock
+    SdIsMultiBlock,
+    SdIsSetBlockCount
   };
 
 EFI_STATUS
@@ -830,6 +1031,27 @@ SdHostInitialize (
   DEBUG ((DEBUG_MMCHOST_SD, " - CMD_MAX_POLL_COUNT=%d\n", CMD_MAX_POLL_COUNT));
   DEBUG ((DEBUG_MMCHOST_SD, " - CMD_MAX_RETRY_COUNT=%d\n", CMD_MAX_RETRY_COUNT));
   DEBUG ((DEBUG_MMCHOST_SD, " - CMD_STALL_AFTER_RETRY_US=%dus\n", CMD_STALL_AFTER_RETRY_US));
+  DEBUG ((DEBUG_MMCHOST_SD, " - SDHOST_DMA_CHANNEL=%d\n", SDHOST_DMA_CHANNEL));
+
+  //
+  // The DMA engine fetches the control block itself, so it lives in its
+  // own uncached page. Transfers fall back to PIO if this isn't available.
+  //
+  Status = DmaAllocateBuffer (EfiBootServicesData, 1, (VOID**)&mDmaControlBlock);
+  if (!EFI_ERROR (Status)) {
+    UINTN BufferSize = EFI_PAGE_SIZE;
+
+    Status = DmaMap (MapOperationBusMasterCommonBuffer, mDmaControlBlock, &BufferSize,
+               &mDmaControlBlockBusAddress, &mDmaControlBlockMapping);
+    if (EFI_ERROR (Status)) {
+      DmaFreeBuffer (1, mDmaControlBlock);
+      mDmaControlBlock = NULL;
+    }
+  }
+
+  if (mDmaControlBlock == NULL) {
+    DEBUG ((DEBUG_MMCHOST_SD_INFO, "SdHost: DMA unavailable, using PIO: %r\n", Status));
+  }
 
   Status = gBS->InstallMultipleProtocolInterfaces (
     &Handle,
@@ -86,6 +86,34 @@ EFI_FW_VOL_BLOCK_DEVICE mFvbDeviceTemplate = {
 };
 
 
+/*
+ * Grow the range of the store that needs dumping to the backing file
+ * to cover the Length bytes at Address.
+ */
+STATIC
+VOID
+VarStoreMarkDirty (
+  IN UINTN Address,
+  IN UINTN Length
+  )
+{
+  UINTN Start;
+  UINTN End;
+
+  Start = Address - mFvInstance->FvBase;
+  End = Start + Length;
+
+  if (mFvInstance->Dirty) {
+    Start = MIN (Start, mFvInstance->DirtyStart);
+    End = MAX (End, mFvInstance->DirtyEnd);
+  }
+
+  mFvInstance->DirtyStart = Start;
+  mFvInstance->DirtyEnd = End;
+  mFvInstance->Dirty = TRUE;
+}
+
+
 EFI_STATUS
 VarStoreWrite (
   IN     UINTN Address,
@@ -94,7 +122,7 @@ VarStoreWrite (
   )
 {
   CopyMem ((VOID*)Address, Buffer, *NumBytes);
-  mFvInstance->Dirty = TRUE;
+  VarStoreMarkDirty (Address, *NumBytes);
 
   return EFI_SUCCESS;
 }
@@ -107,7 +135,7 @@ VarStoreErase (
   )
 {
   SetMem ((VOID*)Address, LbaLength, 0xff);
-  mFvInstance->Dirty = TRUE;
+  VarStoreMarkDirty (Address, LbaLength);
 
   return EFI_SUCCESS;
 }
@@ -130,10 +130,16 @@ InstallVirtualAddressChangeHandler (
 }
 
 
+/*
+ * Write the Length bytes at offset Start of the store to the
+ * backing file on Device.
+ */
 STATIC
 EFI_STATUS
 DoDump (
-  IN EFI_DEVICE_PATH_PROTOCOL *Device
+  IN EFI_DEVICE_PATH_PROTOCOL *Device,
+  IN UINTN Start,
+  IN UINTN Length
   )
 {
   EFI_STATUS Status;
@@ -149,9 +155,9 @@ DoDump (
   }
 
   Status = FileWrite (File,
-             mFvInstance->Offset,
-             mFvInstance->FvBase,
-             mFvInstance->FvLength);
+             mFvInstance->Offset + Start,
+             mFvInstance->FvBase + Start,
+             Length);
   FileClose (File);
   return Status;
 }
@@ -167,6 +173,9 @@ DumpVars (
 {
   EFI_STATUS Status;
   RETURN_STATUS PcdStatus;
+  UINTN BlockSize;
+  UINTN Start;
+  UINTN End;
 
   if (mFvInstance->Device == NULL) {
     DEBUG ((DEBUG_INFO, "Variable store not found?\n"));
@@ -178,7 +187,18 @@ DumpVars (
     return;
   }
 
-  Status = DoDump (mFvInstance->Device);
+  //
+  // Only write back the blocks that changed since the last dump.
+  //
+  BlockSize = mFvInstance->VolumeHeader->BlockMap[0].Length;
+  Start = (mFvInstance->DirtyStart / BlockSize) * BlockSize;
+  End = ((mFvInstance->DirtyEnd + BlockSize - 1) / BlockSize) * BlockSize;
+  End = MIN (End, mFvInstance->FvLength);
+
+  DEBUG ((DEBUG_INFO, "Dumping variable store range 0x%lx-0x%lx\n",
+    (UINT64)Start, (UINT64)End));
+
+  Status = DoDump (mFvInstance->Device, Start, End - Start);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Couldn't dump '%s'\n", mFvInstance->MappedFile));
     ASSERT_EFI_ERROR (Status);
@@ -305,7 +325,11 @@ OnSimpleFileSystemInstall (
       continue;
     }
 
-    Status = DoDump (Device);
+    //
+    // This may be a different copy of the file than the one loaded at
+    // boot, so write back the whole store.
+    //
+    Status = DoDump (Device, 0, mFvInstance->FvLength);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "Couldn't update '%s'\n", mFvInstance->MappedFile));
       ASSERT_EFI_ERROR (Status);
@@ -178,6 +178,17 @@ BOOLEAN
   IN  EFI_MMC_HOST_PROTOCOL     *This
   );
 
+//
+// Returns TRUE if the host stops a CMD18/CMD25 transfer on its own after
+// the number of blocks given by a preceding CMD23, so that no CMD12 is
+// needed to end it.
+//
+typedef
+BOOLEAN
+(EFIAPI *MMC_ISSETBLOCKCOUNT) (
+  IN  EFI_MMC_HOST_PROTOCOL     *This
+  );
+
 struct _EFI_MMC_HOST_PROTOCOL {
   UINT32                  Revision;
   MMC_ISCARDPRESENT       IsCardPresent;
@@ -194,13 +205,16 @@ struct _EFI_MMC_HOST_PROTOCOL {
 
   MMC_SETIOS              SetIos;
   MMC_ISMULTIBLOCK        IsMultiBlock;
+  MMC_ISSETBLOCKCOUNT     IsSetBlockCount;
 };
 
-#define MMC_HOST_PROTOCOL_REVISION    0x00010002    // 1.2
+#define MMC_HOST_PROTOCOL_REVISION    0x00010003    // 1.3
 
 #define MMC_HOST_HAS_SETIOS(Host)       (Host->Revision >= MMC_HOST_PROTOCOL_REVISION && \
                                          Host->SetIos != NULL)
 #define MMC_HOST_HAS_ISMULTIBLOCK(Host) (Host->Revision >= MMC_HOST_PROTOCOL_REVISION && \
                                          Host->IsMultiBlock != NULL)
+#define MMC_HOST_HAS_ISSETBLOCKCOUNT(Host) (Host->Revision >= MMC_HOST_PROTOCOL_REVISION && \
+                                            Host->IsSetBlockCount != NULL)
 
 #endif /* __RASPBERRY_PI_MMC_HOST_PROTOCOL_H__ */
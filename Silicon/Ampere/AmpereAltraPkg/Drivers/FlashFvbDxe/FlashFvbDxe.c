@@ -6,6 +6,7 @@
 
 **/
 
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/FlashLib.h>
 #include <Library/PcdLib.h>
@@ -41,6 +42,54 @@ FlashFvbAddressChangeEvent (
   EfiConvertPointer (0x0, (VOID **)&mNvStorageBase);
 }
 
+/**
+  Get the in-memory copy of a range of the NV store.
+
+  The copy is loaded from the Flash by FlashPei and kept in sync with the
+  Flash by the write and erase services, so reads never need an MM round trip.
+
+  @param[in] Lba      The logical block index.
+  @param[in] Offset   Offset into the block.
+
+  @retval Pointer to the in-memory copy of the range.
+**/
+STATIC
+UINT8 *
+FlashFvbDxeGetStoragePtr (
+  IN EFI_LBA Lba,
+  IN UINTN   Offset
+  )
+{
+  return (UINT8 *)(UINTN)(mNvStorageBase + Lba * mFlashBlockSize + Offset);
+}
+
+/**
+  Check whether a range of the in-memory copy of the NV store is erased.
+
+  @param[in] Buffer   Pointer to the in-memory copy of the range.
+  @param[in] Length   Number of bytes to check.
+
+  @retval TRUE        All bytes are in the erased state.
+  @retval FALSE       At least one byte has been written.
+**/
+STATIC
+BOOLEAN
+FlashFvbDxeIsErased (
+  IN UINT8 *Buffer,
+  IN UINTN Length
+  )
+{
+  UINTN Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    if (Buffer[Index] != 0xFF) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
   The GetAttributes() function retrieves the attributes and
   current settings of the block.
@@ -250,8 +299,6 @@ FlashFvbDxeRead (
   IN OUT   UINT8                               *Buffer
   )
 {
-  EFI_STATUS Status;
-
   ASSERT (NumBytes != NULL);
   ASSERT (Buffer != NULL);
 
@@ -259,17 +306,17 @@ FlashFvbDxeRead (
     return EFI_BAD_BUFFER_SIZE;
   }
 
-  Status = FlashReadCommand (
-             mNvFlashBase + Lba * mFlashBlockSize + Offset,
-             Buffer,
-             *NumBytes
-             );
-
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "Failed to do flash read\n"));
+  if ((UINTN)Lba >= mNvStorageSize / mFlashBlockSize) {
+    DEBUG ((DEBUG_ERROR, "The requested LBA is out of range\n"));
     return EFI_DEVICE_ERROR;
   }
 
+  //
+  // The in-memory copy mirrors the Flash, read from it instead of
+  // going through the MM interface.
+  //
+  CopyMem (Buffer, FlashFvbDxeGetStoragePtr (Lba, Offset), *NumBytes);
+
   return EFI_SUCCESS;
 }
 
@@ -342,6 +389,9 @@ FlashFvbDxeWrite (
   )
 {
   EFI_STATUS Status;
+  UINT8      *Storage;
+  UINTN      Start;
+  UINTN      End;
 
   ASSERT (NumBytes != NULL);
   ASSERT (Buffer != NULL);
@@ -350,17 +400,50 @@ FlashFvbDxeWrite (
     return EFI_BAD_BUFFER_SIZE;
   }
 
+  if ((UINTN)Lba >= mNvStorageSize / mFlashBlockSize) {
+    DEBUG ((DEBUG_ERROR, "The requested LBA is out of range\n"));
+    return EFI_DEVICE_ERROR;
+  }
+
+  //
+  // Only send the bytes that differ from the Flash content. Variable updates
+  // often rewrite a header with a single changed state byte, and a write that
+  // changes nothing does not need an MM round trip at all.
+  //
+  Storage = FlashFvbDxeGetStoragePtr (Lba, Offset);
+  Start = 0;
+  End = *NumBytes;
+  while (Start < End && Storage[Start] == Buffer[Start]) {
+    Start++;
+  }
+  while (End > Start && Storage[End - 1] == Buffer[End - 1]) {
+    End--;
+  }
+  if (Start == End) {
+    return EFI_SUCCESS;
+  }
+
   Status = FlashWriteCommand (
-             mNvFlashBase + Lba * mFlashBlockSize + Offset,
-             Buffer,
-             *NumBytes
+             mNvFlashBase + Lba * mFlashBlockSize + Offset + Start,
+             Buffer + Start,
+             End - Start
              );
 
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Failed to do flash write\n"));
+    //
+    // The write may have been partially done, resync the in-memory copy.
+    //
+    FlashReadCommand (
+      mNvFlashBase + Lba * mFlashBlockSize + Offset + Start,
+      Storage + Start,
+      End - Start
+      );
     return EFI_DEVICE_ERROR;
   }
 
+  CopyMem (Storage + Start, Buffer + Start, End - Start);
+
   return Status;
 }
 
@@ -422,8 +505,33 @@ FlashFvbDxeErase (
   VA_LIST    Args;
   EFI_LBA    Start;
   UINTN      Length;
+  UINTN      TotalNvStorageBlocks;
+  UINT8      *Storage;
   EFI_STATUS Status;
 
+  TotalNvStorageBlocks = mNvStorageSize / mFlashBlockSize;
+
+  //
+  // Verify the entire list of blocks before erasing any of them.
+  //
+  VA_START (Args, This);
+
+  for (Start = VA_ARG (Args, EFI_LBA);
+       Start != EFI_LBA_LIST_TERMINATOR;
+       Start = VA_ARG (Args, EFI_LBA))
+  {
+    Length = VA_ARG (Args, UINTN);
+    if (Length == 0
+        || (UINTN)Start >= TotalNvStorageBlocks
+        || Length > TotalNvStorageBlocks - (UINTN)Start) {
+      VA_END (Args);
+      DEBUG ((DEBUG_ERROR, "The requested LBA is out of range\n"));
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  VA_END (Args);
+
   Status = EFI_SUCCESS;
 
   VA_START (Args, This);
@@ -433,10 +541,32 @@ FlashFvbDxeErase (
        Start = VA_ARG (Args, EFI_LBA))
   {
     Length = VA_ARG (Args, UINTN);
+
+    //
+    // Skip the MM round trip for blocks which are erased already.
+    //
+    Storage = FlashFvbDxeGetStoragePtr (Start, 0);
+    if (FlashFvbDxeIsErased (Storage, Length * mFlashBlockSize)) {
+      continue;
+    }
+
     Status = FlashEraseCommand (
                mNvFlashBase + Start * mFlashBlockSize,
                Length * mFlashBlockSize
                );
+    if (EFI_ERROR (Status)) {
+      //
+      // The blocks may have been partially erased, resync the in-memory copy.
+      //
+      FlashReadCommand (
+        mNvFlashBase + Start * mFlashBlockSize,
+        Storage,
+        Length * mFlashBlockSize
+        );
+      break;
+    }
+
+    SetMem (Storage, Length * mFlashBlockSize, 0xFF);
   }
 
   VA_END (Args);
@@ -46,7 +46,10 @@ BuildRootComplexData (
   )
 {
   AC01_ROOT_COMPLEX                    *RootComplex;
+  AC01_PCIE_LINK_STATUS                *LinkStatus;
+  AC01_PCIE_LINK_STATUS_DATA           LinkStatusData;
   BOOLEAN                              ConfigFound;
+  BOOLEAN                              LinkStatusFound;
   EFI_PEI_READ_ONLY_VARIABLE2_PPI      *VariablePpi;
   EFI_STATUS                           Status;
   ROOT_COMPLEX_CONFIG_VARSTORE_DATA    RootComplexConfig;
@@ -55,6 +58,7 @@ BuildRootComplexData (
   UINTN                                DataSize;
 
   ConfigFound = FALSE;
+  LinkStatusFound = FALSE;
 
   //
   // Get the Root Complex config from NVRAM
@@ -78,6 +82,22 @@ BuildRootComplexData (
     if (!EFI_ERROR (Status)) {
       ConfigFound = TRUE;
     }
+
+    //
+    // Get the link outcome of the previous boot
+    //
+    DataSize = sizeof (LinkStatusData);
+    Status = VariablePpi->GetVariable (
+                            VariablePpi,
+                            AC01_PCIE_LINK_STATUS_VARIABLE_NAME,
+                            &gRootComplexConfigFormSetGuid,
+                            NULL,
+                            &DataSize,
+                            &LinkStatusData
+                            );
+    if (!EFI_ERROR (Status) && DataSize == sizeof (LinkStatusData)) {
+      LinkStatusFound = TRUE;
+    }
   }
 
   ZeroMem (&mRootComplexList, sizeof (AC01_ROOT_COMPLEX) * AC01_PCIE_MAX_ROOT_COMPLEX);
@@ -120,6 +140,15 @@ BuildRootComplexData (
 
     ParseRootComplexNVParamData (RootComplex);
 
+    //
+    // Slots that were enabled but had no link on the previous boot only get a
+    // short presence-detect check during link polling.
+    //
+    for (PcieIndex = 0; LinkStatusFound && PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+      LinkStatus = &LinkStatusData.Pcie[RCIndex][PcieIndex];
+      RootComplex->Pcie[PcieIndex].EmptyLastBoot = LinkStatus->Active && !LinkStatus->LinkUp;
+    }
+
     DEBUG ((
       DEBUG_INFO,
       " + S%d - RootComplex%a%d, MMCfgBase:0x%lx, MmioBase:0x%lx, Mmio32Base:0x%lx, Enabled:%a\n",
@@ -136,11 +165,12 @@ BuildRootComplexData (
     for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
       DEBUG ((
         DEBUG_INFO,
-        " +     PCIE%d:0x%lx - Enabled:%a - DevNum:0x%x\n",
+        " +     PCIE%d:0x%lx - Enabled:%a - DevNum:0x%x - EmptyLastBoot:%a\n",
         PcieIndex,
         RootComplex->Pcie[PcieIndex].CsrBase,
         (RootComplex->Pcie[PcieIndex].Active) ? "Y" : "N",
-        RootComplex->Pcie[PcieIndex].DevNum
+        RootComplex->Pcie[PcieIndex].DevNum,
+        (RootComplex->Pcie[PcieIndex].EmptyLastBoot) ? "Y" : "N"
         ));
     }
   }
@@ -15,6 +15,100 @@
 #include <Library/UefiBootServicesTableLib.h>
 #include <Protocol/Rng.h>
 
+//
+// Raw TRNG output is fetched ahead of time into a pool, so that the small
+// requests most consumers make are served from memory instead of waiting for
+// SMpro mailbox round trips. Each pooled byte is handed out only once.
+//
+#define RNG_POOL_SIZE             512
+#define RNG_POOL_REFILL_SIZE      64
+#define RNG_POOL_REFILL_PERIOD    (10 * 1000 * 10)   // 10 ms in 100 ns units
+
+STATIC UINT8     mRngPool[RNG_POOL_SIZE];
+STATIC UINTN     mRngPoolLevel;
+STATIC BOOLEAN   mRngPoolBusy;
+STATIC EFI_EVENT mRngPoolRefillEvent;
+STATIC EFI_EVENT mRngExitBootServicesEvent;
+
+/**
+  Arm the refill of the entropy pool if it is below half full.
+**/
+STATIC
+VOID
+RngPoolScheduleRefill (
+  VOID
+  )
+{
+  if (mRngPoolRefillEvent != NULL && mRngPoolLevel < RNG_POOL_SIZE / 2) {
+    gBS->SetTimer (mRngPoolRefillEvent, TimerRelative, RNG_POOL_REFILL_PERIOD);
+  }
+}
+
+/**
+  Top up the entropy pool by one block, and re-arm until it is full.
+
+  @param[in] Event    Event whose notification function is being invoked.
+  @param[in] Context  Pointer to the notification function's context.
+**/
+STATIC
+VOID
+EFIAPI
+RngPoolRefill (
+  IN EFI_EVENT Event,
+  IN VOID      *Context
+  )
+{
+  EFI_STATUS Status;
+  UINTN      RefillSize;
+
+  //
+  // A GetRNG call in progress owns the pool and the TRNG mailbox.
+  //
+  if (mRngPoolBusy) {
+    gBS->SetTimer (mRngPoolRefillEvent, TimerRelative, RNG_POOL_REFILL_PERIOD);
+    return;
+  }
+
+  mRngPoolBusy = TRUE;
+
+  RefillSize = MIN (RNG_POOL_REFILL_SIZE, RNG_POOL_SIZE - mRngPoolLevel);
+  if (RefillSize != 0) {
+    Status = GenerateRandomNumbers (&mRngPool[mRngPoolLevel], RefillSize);
+    if (!EFI_ERROR (Status)) {
+      mRngPoolLevel += RefillSize;
+    }
+  }
+
+  mRngPoolBusy = FALSE;
+
+  if (mRngPoolLevel < RNG_POOL_SIZE) {
+    gBS->SetTimer (mRngPoolRefillEvent, TimerRelative, RNG_POOL_REFILL_PERIOD);
+  }
+}
+
+/**
+  Stop refilling the entropy pool and wipe it before the OS takes over.
+
+  @param[in] Event    Event whose notification function is being invoked.
+  @param[in] Context  Pointer to the notification function's context.
+**/
+STATIC
+VOID
+EFIAPI
+RngExitBootServices (
+  IN EFI_EVENT Event,
+  IN VOID      *Context
+  )
+{
+  if (mRngPoolRefillEvent != NULL) {
+    gBS->CloseEvent (mRngPoolRefillEvent);
+    mRngPoolRefillEvent = NULL;
+  }
+
+  ZeroMem (mRngPool, sizeof (mRngPool));
+  mRngPoolLevel = 0;
+}
+
 /**
   Returns information about the random number generation implementation.
 
@@ -79,6 +173,8 @@ RngGetInfo (
                                       this driver.
   @retval EFI_DEVICE_ERROR            An RNG value could not be retrieved due to a hardware or
                                       firmware error.
+  @retval EFI_NOT_READY               The call interrupted a refill of the entropy pool, retry
+                                      once the caller returns to a lower TPL.
   @retval EFI_INVALID_PARAMETER       RNGValue is NULL or RNGValueLength is zero.
 
 **/
@@ -92,6 +188,7 @@ RngGetRNG (
   )
 {
   EFI_STATUS Status;
+  UINTN      PoolSize;
 
   if (This == NULL || RNGValueLength == 0 || RNGValue == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -106,7 +203,30 @@ RngGetRNG (
     return EFI_UNSUPPORTED;
   }
 
-  Status = GenerateRandomNumbers (RNGValue, RNGValueLength);
+  //
+  // Called from a higher TPL in the middle of a pool refill, neither the pool
+  // nor the TRNG mailbox can be used.
+  //
+  if (mRngPoolBusy) {
+    return EFI_NOT_READY;
+  }
+
+  mRngPoolBusy = TRUE;
+
+  PoolSize = MIN (RNGValueLength, mRngPoolLevel);
+  mRngPoolLevel -= PoolSize;
+  CopyMem (RNGValue, &mRngPool[mRngPoolLevel], PoolSize);
+  ZeroMem (&mRngPool[mRngPoolLevel], PoolSize);
+
+  Status = EFI_SUCCESS;
+  if (RNGValueLength > PoolSize) {
+    Status = GenerateRandomNumbers (RNGValue + PoolSize, RNGValueLength - PoolSize);
+  }
+
+  mRngPoolBusy = FALSE;
+
+  RngPoolScheduleRefill ();
+
   if (EFI_ERROR (Status)) {
     DEBUG ((
       DEBUG_ERROR,
@@ -149,6 +269,29 @@ RngDriverEntry (
   EFI_STATUS Status;
   EFI_HANDLE Handle;
 
+  //
+  // Fill the entropy pool in the background
+  //
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  RngPoolRefill,
+                  NULL,
+                  &mRngPoolRefillEvent
+                  );
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->CreateEvent (
+                    EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                    TPL_NOTIFY,
+                    RngExitBootServices,
+                    NULL,
+                    &mRngExitBootServicesEvent
+                    );
+    ASSERT_EFI_ERROR (Status);
+
+    RngPoolScheduleRefill ();
+  }
+
   //
   // Install UEFI RNG (Random Number Generator) Protocol
   //
@@ -1039,6 +1039,89 @@ NVParamVarstoreInit (
   }
 }
 
+/**
+  Record the link outcome of every PCIe controller so that the next boot can
+  shorten link polling on slots that stay empty. The variable is only written
+  when the outcome has changed.
+
+  @retval EFI_SUCCESS               The operation is successful.
+
+  @retval Others                    An error occurred.
+**/
+EFI_STATUS
+UpdateLinkStatusVariable (
+  VOID
+  )
+{
+  AC01_PCIE_LINK_STATUS_DATA *LinkStatusData;
+  AC01_PCIE_LINK_STATUS_DATA *PrevLinkStatusData;
+  AC01_PCIE_LINK_STATUS      *LinkStatus;
+  AC01_ROOT_COMPLEX          *RootComplex;
+  EFI_STATUS                 Status;
+  UINT8                      RCIndex;
+  UINT8                      PcieIndex;
+  UINTN                      BufferSize;
+
+  if (GetFirstGuidHob (&gRootComplexInfoHobGuid) == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  LinkStatusData = AllocateZeroPool (sizeof (AC01_PCIE_LINK_STATUS_DATA));
+  PrevLinkStatusData = AllocateZeroPool (sizeof (AC01_PCIE_LINK_STATUS_DATA));
+  if (LinkStatusData == NULL || PrevLinkStatusData == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
+  }
+
+  for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
+    RootComplex = GetRootComplex (RCIndex);
+    for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+      LinkStatus = &LinkStatusData->Pcie[RCIndex][PcieIndex];
+      LinkStatus->Active = RootComplex->Active && RootComplex->Pcie[PcieIndex].Active;
+      LinkStatus->LinkUp = LinkStatus->Active && RootComplex->Pcie[PcieIndex].LinkUp;
+      if (LinkStatus->LinkUp) {
+        LinkStatus->Gen = RootComplex->Pcie[PcieIndex].CurrentGen;
+        LinkStatus->Width = RootComplex->Pcie[PcieIndex].CurWidth;
+      }
+    }
+  }
+
+  BufferSize = sizeof (AC01_PCIE_LINK_STATUS_DATA);
+  Status = gRT->GetVariable (
+                  AC01_PCIE_LINK_STATUS_VARIABLE_NAME,
+                  &gPcieFormSetGuid,
+                  NULL,
+                  &BufferSize,
+                  PrevLinkStatusData
+                  );
+  if (!EFI_ERROR (Status) &&
+      BufferSize == sizeof (AC01_PCIE_LINK_STATUS_DATA) &&
+      CompareMem (LinkStatusData, PrevLinkStatusData, BufferSize) == 0)
+  {
+    Status = EFI_SUCCESS;
+    goto Exit;
+  }
+
+  Status = gRT->SetVariable (
+                  AC01_PCIE_LINK_STATUS_VARIABLE_NAME,
+                  &gPcieFormSetGuid,
+                  EFI_VARIABLE_NON_VOLATILE |
+                  EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  sizeof (AC01_PCIE_LINK_STATUS_DATA),
+                  LinkStatusData
+                  );
+
+Exit:
+  if (LinkStatusData != NULL) {
+    FreePool (LinkStatusData);
+  }
+  if (PrevLinkStatusData != NULL) {
+    FreePool (PrevLinkStatusData);
+  }
+
+  return Status;
+}
+
 /**
   Build PCIe menu screen.
 
@@ -1214,6 +1297,12 @@ RootComplexDriverEntry (
       return Status;
     }
   }
+
+  Status = UpdateLinkStatusVariable ();
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to update PCIe link status - %r\n", __FUNCTION__, Status));
+  }
+
   Status = PcieMainScreenSetup (mPrivateData);
   ASSERT_EFI_ERROR (Status);
 
@@ -9,6 +9,8 @@
 #ifndef ROOT_COMPLEX_INFO_HOB_H_
 #define ROOT_COMPLEX_INFO_HOB_H_
 
+#include <Platform/Ac01.h>
+
 #define ROOT_COMPLEX_INFO_HOB_GUID \
   { 0x568a258a, 0xcaa1, 0x47e9, { 0xbb, 0x89, 0x65, 0xa3, 0x73, 0x9b, 0x58, 0x75 } }
 
@@ -103,6 +105,7 @@ typedef struct {
   BOOLEAN           Active;                // Active? Used in bi-furcation mode
   BOOLEAN           LinkUp;                // PHY and PCIE linkup
   BOOLEAN           HotPlug;               // Hotplug support
+  BOOLEAN           EmptyLastBoot;         // No link on the previous boot
 } AC01_PCIE_CONTROLLER;
 
 //
@@ -135,6 +138,29 @@ typedef struct {
   UINT8                  PresetGen4[MaxPcieController];
 } AC01_ROOT_COMPLEX;
 
+//
+// Link outcome of a PCIe controller, kept across boots
+//
+typedef struct {
+  BOOLEAN  Active;
+  BOOLEAN  LinkUp;
+  UINT8    Gen;                            // Negotiated speed, LINK_SPEED_*
+  UINT8    Width;                          // Negotiated lanes, LINK_WIDTH_*
+} AC01_PCIE_LINK_STATUS;
+
+//
+// Data structure of the PCIe link status variable
+//
+typedef struct {
+  AC01_PCIE_LINK_STATUS  Pcie[AC01_PCIE_MAX_ROOT_COMPLEX][MaxPcieController];
+} AC01_PCIE_LINK_STATUS_DATA;
+
 #pragma pack()
 
+//
+// Name of the variable holding AC01_PCIE_LINK_STATUS_DATA, under the
+// Root Complex configuration formset GUID.
+//
+#define AC01_PCIE_LINK_STATUS_VARIABLE_NAME  L"PcieLinkStatus"
+
 #endif /* ROOT_COMPLEX_INFO_HOB_H_ */
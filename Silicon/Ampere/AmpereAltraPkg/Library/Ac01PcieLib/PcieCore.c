@@ -629,6 +629,7 @@ Ac01PcieCoreSetupRC (
   RETURN_STATUS        Status;
   UINT32               Val;
   UINT8                PcieIndex;
+  BOOLEAN              InReset;
 
   DEBUG ((DEBUG_INFO, "Initializing Socket%d RootComplex%d\n", RootComplex->Socket, RootComplex->ID));
 
@@ -640,6 +641,30 @@ Ac01PcieCoreSetupRC (
       DEBUG ((DEBUG_ERROR, "%a: Failed to initialize the PCIe PHY\n", __FUNCTION__));
       return RETURN_DEVICE_ERROR;
     }
+
+    //
+    // Put all controllers into reset up front, so that they share
+    // a single reset delay instead of waiting for each one in turn.
+    //
+    InReset = FALSE;
+    for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+      if (!RootComplex->Pcie[PcieIndex].Active) {
+        continue;
+      }
+
+      TargetAddress = RootComplex->Pcie[PcieIndex].CsrBase + AC01_PCIE_CORE_RESET_REG;
+      Val = MmioRead32 (TargetAddress);
+      if (!(Val & RESET_MASK)) {
+        Val = DWC_PCIE_SET (Val, ASSERT_RESET);
+        MmioWrite32 (TargetAddress, Val);
+        InReset = TRUE;
+      }
+    }
+
+    if (InReset) {
+      // Delay 50ms to ensure controllers finish their reset
+      MicroSecondDelay (50000);
+    }
   }
 
   // Setup each controller
@@ -1210,7 +1235,8 @@ PollLinkUp (
 }
 
 /**
-  Check active PCIe controllers of RootComplex, retrain or soft reset if needed
+  Check active PCIe controllers of RootComplex, retrain or soft reset if needed.
+  If the link is already marked as down, the controller is soft reset right away.
 
   @param RootComplex[in]  Pointer to AC01_ROOT_COMPLEX structure
   @param PcieIndex[in]    PCIe controller index
@@ -1229,9 +1255,9 @@ Ac01PcieCoreQoSLinkCheckRecovery (
   INT32       NumberOfReset = MAX_REINIT;
   UINT8       EpMaxWidth, EpMaxGen;
 
-  // PCIe controller is not active or Link is not up
+  // PCIe controller is not active
   // Nothing to be done
-  if ((!RootComplex->Pcie[PcieIndex].Active) || (!RootComplex->Pcie[PcieIndex].LinkUp)) {
+  if (!RootComplex->Pcie[PcieIndex].Active) {
     return LINK_CHECK_WRONG_PARAMETER;
   }
 
@@ -1293,6 +1319,11 @@ Ac01PcieCoreUpdateLink (
   UINT8                     PcieIndex;
   UINT32                    Index;
   UINT32                    Val;
+  BOOLEAN                   NewLinkUp[MaxPcieControllerOfRootComplexB];
+  INT32                     LinkStatusCheck[MaxPcieControllerOfRootComplexB];
+  INT32                     RasdesChecking;
+  BOOLEAN                   CheckPending;
+  UINT8                     EpMaxWidth, EpMaxGen;
 
   *IsNextRoundNeeded = FALSE;
   *FailedPcieCount   = 0;
@@ -1305,14 +1336,18 @@ Ac01PcieCoreUpdateLink (
   }
 
   // Loop for all controllers
+  CheckPending = FALSE;
   for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
     Pcie = &RootComplex->Pcie[PcieIndex];
     CfgBase = RootComplex->MmcfgBase + (RootComplex->Pcie[PcieIndex].DevNum << DEV_SHIFT);
+    NewLinkUp[PcieIndex] = FALSE;
 
     if (Pcie->Active && !Pcie->LinkUp) {
       if (PcieLinkUpCheck (Pcie)) {
         Pcie->LinkUp = TRUE;
         Val = MmioRead32 (CfgBase + PCIE_CAPABILITY_BASE + LINK_CONTROL_LINK_STATUS_REG);
+        Pcie->CurWidth = CAP_NEGO_LINK_WIDTH_GET (Val);
+        Pcie->CurrentGen = (CAP_LINK_SPEED_GET (Val) != 0) ? (1 << (CAP_LINK_SPEED_GET (Val) - 1)) : LINK_SPEED_NONE;
 
         DEBUG ((
           DEBUG_INFO,
@@ -1325,15 +1360,15 @@ Ac01PcieCoreUpdateLink (
           CAP_LINK_SPEED_GET (Val)
           ));
 
-        // Doing link checking and recovery if needed
-        Ac01PcieCoreQoSLinkCheckRecovery (RootComplex, PcieIndex);
-
-        // Link timeout after 32ms
-        SetLinkTimeout (RootComplex, PcieIndex, 32);
+        // Enable all of RASDES register to detect any training error
+        Ac01PFACommand (RootComplex, PcieIndex, PFA_MODE_ENABLE);
 
-        // Un-mask Completion Timeout
-        DisableCompletionTimeOut (RootComplex, PcieIndex, FALSE);
+        // Accessing Endpoint and checking current link capabilities
+        Ac01PcieCoreGetEndpointInfo (RootComplex, PcieIndex, &EpMaxWidth, &EpMaxGen);
+        LinkStatusCheck[PcieIndex] = Ac01PcieCoreLinkCheck (RootComplex, PcieIndex, EpMaxWidth, EpMaxGen);
 
+        NewLinkUp[PcieIndex] = TRUE;
+        CheckPending = TRUE;
       } else {
         *IsNextRoundNeeded = FALSE;
         FailedPciePtr[*FailedPcieCount] = PcieIndex;
@@ -1341,6 +1376,99 @@ Ac01PcieCoreUpdateLink (
       }
     }
   }
+
+  if (!CheckPending) {
+    return;
+  }
+
+  // Delay to allow the links to perform internal operation and generate
+  // any error status update. All links that came up are evaluated over
+  // the same window rather than one after another.
+  MicroSecondDelay (100000);
+
+  for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+    if (!NewLinkUp[PcieIndex]) {
+      continue;
+    }
+
+    // Check for error, then clear error counter
+    RasdesChecking = Ac01PFACommand (RootComplex, PcieIndex, PFA_MODE_READ);
+    Ac01PFACommand (RootComplex, PcieIndex, PFA_MODE_CLEAR);
+
+    if ((LinkStatusCheck[PcieIndex] == LINK_CHECK_FAILED) ||
+        (RasdesChecking == LINK_CHECK_FAILED) ||
+        !PcieLinkUpCheck (&RootComplex->Pcie[PcieIndex]))
+    {
+      // Soft reset and retry link checking
+      RootComplex->Pcie[PcieIndex].LinkUp = FALSE;
+      Ac01PcieCoreQoSLinkCheckRecovery (RootComplex, PcieIndex);
+    }
+
+    // Link timeout after 32ms
+    SetLinkTimeout (RootComplex, PcieIndex, 32);
+
+    // Un-mask Completion Timeout
+    DisableCompletionTimeOut (RootComplex, PcieIndex, FALSE);
+  }
+}
+
+/**
+  Check whether every active controller that is not linked up yet has settled.
+
+  A controller has settled when its link is up, or, once its Detect time is over,
+  when its LTSSM is still in the Detect state, which means no receiver is on the
+  slot. Slots that were empty on the previous boot and are not hot-plug capable
+  only get a short presence-detect window; a card inserted since then moves the
+  LTSSM out of Detect and falls back to the full training time.
+
+  @param RootComplexList      Pointer to the Root Complex list
+  @param EmptyDetectDone      The short presence-detect window is over
+  @param DetectDone           The LTSSM has had the time to leave the Detect state
+
+  @retval TRUE                All controllers have settled
+  @retval FALSE               At least one controller is still training
+**/
+BOOLEAN
+PcieLinksSettled (
+  IN AC01_ROOT_COMPLEX *RootComplexList,
+  IN BOOLEAN           EmptyDetectDone,
+  IN BOOLEAN           DetectDone
+  )
+{
+  AC01_ROOT_COMPLEX    *RootComplex;
+  AC01_PCIE_CONTROLLER *Pcie;
+  UINT8                RCIndex;
+  UINT8                PcieIndex;
+  UINT32               LtssmState;
+
+  for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
+    RootComplex = &RootComplexList[RCIndex];
+    if (!RootComplex->Active) {
+      continue;
+    }
+
+    for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+      Pcie = &RootComplex->Pcie[PcieIndex];
+      if (!Pcie->Active || Pcie->LinkUp || PcieLinkUpCheck (Pcie)) {
+        continue;
+      }
+
+      if (Pcie->EmptyLastBoot && !Pcie->HotPlug) {
+        if (!EmptyDetectDone) {
+          return FALSE;
+        }
+      } else if (!DetectDone) {
+        return FALSE;
+      }
+
+      LtssmState = SMLH_LTSSM_STATE_GET (MmioRead32 (Pcie->CsrBase + AC01_PCIE_CORE_LINK_STAT_REG));
+      if ((LtssmState != LTSSM_STATE_DETECT_QUIET) && (LtssmState != LTSSM_STATE_DETECT_ACT)) {
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
 }
 
 /**
@@ -1356,7 +1484,7 @@ Ac01PcieCorePostSetupRC (
   UINT8   RCIndex, Idx;
   BOOLEAN IsNextRoundNeeded, NextRoundNeeded;
   UINT64  PrevTick, CurrTick, ElapsedCycle;
-  UINT64  TimerTicks64;
+  UINT64  TimerTicks64, DetectTicks, EmptyDetectTicks, PollTicks, NextPoll;
   UINT8   ReInit;
   INT8    FailedPciePtr[MaxPcieControllerOfRootComplexB];
   INT8    FailedPcieCount;
@@ -1369,9 +1497,17 @@ _link_polling:
   // It is not guaranteed the timer service is ready prior to PCI Dxe.
   // Calculate system ticks for link training.
   //
+  // All controllers train in parallel against this 1 second deadline. Stop
+  // early once every link is up or, after the LTSSM Detect time, sits in Detect
+  // with no receiver, so systems with empty slots don't wait the full second.
+  //
   TimerTicks64 = ArmGenericTimerGetTimerFreq (); /* 1 Second */
+  DetectTicks = DivU64x32 (MultU64x32 (TimerTicks64, LTSSM_TRANSITION_TIMEOUT / 1000), 1000);
+  EmptyDetectTicks = DivU64x32 (MultU64x32 (TimerTicks64, LTSSM_EMPTY_SLOT_DETECT_TIMEOUT / 1000), 1000);
+  PollTicks = DivU64x32 (TimerTicks64, 1000);  /* 1 ms */
   PrevTick = ArmGenericTimerGetSystemCount ();
   ElapsedCycle = 0;
+  NextPoll = PollTicks;
 
   do {
     CurrTick = ArmGenericTimerGetSystemCount ();
@@ -1381,6 +1517,18 @@ _link_polling:
     }
     ElapsedCycle += (CurrTick - PrevTick);
     PrevTick = CurrTick;
+
+    if (ElapsedCycle >= NextPoll) {
+      NextPoll = ElapsedCycle + PollTicks;
+      if (PcieLinksSettled (
+            RootComplexList,
+            ElapsedCycle >= EmptyDetectTicks,
+            ElapsedCycle >= DetectTicks
+            ))
+      {
+        break;
+      }
+    }
   } while (ElapsedCycle < TimerTicks64);
 
   for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
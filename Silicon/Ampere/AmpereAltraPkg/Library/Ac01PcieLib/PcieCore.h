@@ -38,6 +38,7 @@
 #define MEMRDY_TIMEOUT                   10          // 10 us
 #define PIPE_CLOCK_TIMEOUT               20000       // 20,000 us
 #define LTSSM_TRANSITION_TIMEOUT         100000      // 100 ms in total
+#define LTSSM_EMPTY_SLOT_DETECT_TIMEOUT  24000       // 24 ms, two Detect.Quiet periods
 #define EP_LINKUP_TIMEOUT                (10 * 1000) // 10ms
 #define LINK_WAIT_INTERVAL_US            50
 
@@ -96,6 +97,8 @@
 #define PHY_STATUS_MASK                     (1 << 2)
 #define SMLH_LTSSM_STATE_MASK               0x3F00
 #define SMLH_LTSSM_STATE_GET(val)           ((val & SMLH_LTSSM_STATE_MASK) >> 8)
+#define   LTSSM_STATE_DETECT_QUIET          0x00
+#define   LTSSM_STATE_DETECT_ACT            0x01
 #define   LTSSM_STATE_L0                    0x11
 #define RDLH_SMLH_LINKUP_STATUS_GET(val)    (val & 0x3)
 #define PHY_STATUS_MASK_BIT                 0x04
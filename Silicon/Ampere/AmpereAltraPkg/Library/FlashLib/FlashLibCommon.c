@@ -343,7 +343,11 @@ FlashReadCommand (
     MmData[0] = MM_SPINOR_FUNC_READ;
     MmData[1] = ByteAddress + Count;
     MmData[2] = NumRead;
-    MmData[3] = (UINT64)gFlashLibPhysicalBuffer;  // Read data into the temp buffer with specified virtual address
+    if (gFlashLibRuntime) {
+      MmData[3] = (UINT64)gFlashLibPhysicalBuffer;  // Read data into the temp buffer with specified virtual address
+    } else {
+      MmData[3] = (UINT64)(Buffer + Count);         // Identity mapped, read straight into the caller's buffer
+    }
 
     Status = FlashMmCommunicate (
               MmData,
@@ -360,10 +364,12 @@ FlashReadCommand (
       return EFI_DEVICE_ERROR;
     }
 
-    //
-    // Get data from the virtual address of the temp buffer.
-    //
-    CopyMem ((VOID *)(Buffer + Count), (VOID *)gFlashLibVirtualBuffer, NumRead);
+    if (gFlashLibRuntime) {
+      //
+      // Get data from the virtual address of the temp buffer.
+      //
+      CopyMem ((VOID *)(Buffer + Count), (VOID *)gFlashLibVirtualBuffer, NumRead);
+    }
     Remain -= NumRead;
     Count += NumRead;
   }
@@ -51,6 +51,47 @@
 #define DB_STATUS_AVAIL_BIT       BIT16
 #define DB_STATUS_ACK_BIT         BIT0
 
+//
+// Most replies arrive in a few tens of microseconds. Poll at a short interval
+// first so that light requests are not held for a full MAILBOX_POLL_INTERVAL_US.
+//
+#define MAILBOX_FAST_POLL_INTERVAL_US  10
+#define MAILBOX_FAST_POLL_TIMEOUT_US   2000
+
+/**
+  Wait for a status bit of a doorbell to be set.
+
+  @param[in]  DoorbellAddress   The base address of the doorbell.
+  @param[in]  StatusBit         The status bit to wait for.
+
+  @retval EFI_SUCCESS           The status bit is set.
+  @retval EFI_TIMEOUT           Timeout occurred when waiting for the status bit.
+**/
+STATIC
+EFI_STATUS
+MailboxPollStatus (
+  IN UINTN  DoorbellAddress,
+  IN UINT32 StatusBit
+  )
+{
+  UINTN ElapsedUs;
+  UINTN IntervalUs;
+
+  ElapsedUs = 0;
+  while ((MmioRead32 (DoorbellAddress + DB_STATUS_REG_OFST) & StatusBit) == 0) {
+    if (ElapsedUs >= MAILBOX_POLL_TIMEOUT_US) {
+      return EFI_TIMEOUT;
+    }
+
+    IntervalUs = (ElapsedUs < MAILBOX_FAST_POLL_TIMEOUT_US) ?
+                 MAILBOX_FAST_POLL_INTERVAL_US : MAILBOX_POLL_INTERVAL_US;
+    MicroSecondDelay (IntervalUs);
+    ElapsedUs += IntervalUs;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Get the base address of a doorbell.
 
@@ -144,7 +185,6 @@ MailboxRead (
   OUT MAILBOX_MESSAGE_DATA *Message
   )
 {
-  UINTN TimeoutCount;
   UINTN DoorbellAddress;
 
   if (Socket >= GetNumberOfActiveSockets ()
@@ -154,19 +194,14 @@ MailboxRead (
     return EFI_INVALID_PARAMETER;
   }
 
-  TimeoutCount = MAILBOX_POLL_COUNT;
-
   DoorbellAddress = MailboxGetDoorbellAddress (Socket, Doorbell);
   ASSERT (DoorbellAddress != 0);
 
   //
   // Polling Doorbell status
   //
-  while ((MmioRead32 ((DoorbellAddress + DB_STATUS_REG_OFST)) & DB_STATUS_AVAIL_BIT) == 0) {
-    MicroSecondDelay (MAILBOX_POLL_INTERVAL_US);
-    if (--TimeoutCount == 0) {
-      return EFI_TIMEOUT;
-    }
+  if (EFI_ERROR (MailboxPollStatus (DoorbellAddress, DB_STATUS_AVAIL_BIT))) {
+    return EFI_TIMEOUT;
   }
 
   Message->ExtendedData[0] = MmioRead32 (DoorbellAddress + DB_DIN0_REG_OFST);
@@ -200,7 +235,6 @@ MailboxWrite (
   IN MAILBOX_MESSAGE_DATA *Message
   )
 {
-  UINTN TimeoutCount;
   UINTN DoorbellAddress;
 
   if (Socket >= GetNumberOfActiveSockets ()
@@ -210,8 +244,6 @@ MailboxWrite (
     return EFI_INVALID_PARAMETER;
   }
 
-  TimeoutCount = MAILBOX_POLL_COUNT;
-
   DoorbellAddress = MailboxGetDoorbellAddress (Socket, Doorbell);
   ASSERT (DoorbellAddress != 0);
 
@@ -232,11 +264,8 @@ MailboxWrite (
   //
   // Wait for ACK
   //
-  while ((MmioRead32 (DoorbellAddress + DB_STATUS_REG_OFST) & DB_STATUS_ACK_BIT) == 0) {
-    MicroSecondDelay (MAILBOX_POLL_INTERVAL_US);
-    if (--TimeoutCount == 0) {
-      return EFI_TIMEOUT;
-    }
+  if (EFI_ERROR (MailboxPollStatus (DoorbellAddress, DB_STATUS_ACK_BIT))) {
+    return EFI_TIMEOUT;
   }
 
   //
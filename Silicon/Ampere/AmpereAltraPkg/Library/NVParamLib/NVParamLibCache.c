@@ -0,0 +1,118 @@
+/** @file
+
+  Copyright (c) 2021, Ampere Computing LLC. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+  Cache of the NVParam values already read by this module. Setup and platform
+  drivers read the same parameters many times and each read is a round trip
+  to the secure partition, so reads are served from here once done.
+
+**/
+
+#include <Uefi.h>
+
+#include <Library/BaseMemoryLib.h>
+
+#include "NVParamLibCommon.h"
+
+#define NVPARAM_CACHE_ENTRIES             128
+
+typedef struct {
+  BOOLEAN    Valid;
+  UINT16     ACLRd;
+  UINT32     Param;
+  UINT32     Val;
+  EFI_STATUS Status;
+} NVPARAM_CACHE_ENTRY;
+
+STATIC NVPARAM_CACHE_ENTRY mNVParamCache[NVPARAM_CACHE_ENTRIES];
+STATIC UINTN               mNVParamCacheNext;
+
+/**
+  Look up the result of a previous read of a non-volatile parameter.
+
+  @param[in]  Param               Parameter ID
+  @param[in]  ACLRd               Permission for read operation.
+  @param[out] Val                 Pointer to the cached value.
+  @param[out] Status              Pointer to the cached read status.
+
+  @retval TRUE                    The read was found in the cache.
+  @retval FALSE                   The parameter has to be read.
+**/
+BOOLEAN
+NVParamCacheLookup (
+  IN  UINT32     Param,
+  IN  UINT16     ACLRd,
+  OUT UINT32     *Val,
+  OUT EFI_STATUS *Status
+  )
+{
+  UINTN Index;
+
+  for (Index = 0; Index < NVPARAM_CACHE_ENTRIES; Index++) {
+    if (mNVParamCache[Index].Valid
+        && mNVParamCache[Index].Param == Param
+        && mNVParamCache[Index].ACLRd == ACLRd)
+    {
+      *Val = mNVParamCache[Index].Val;
+      *Status = mNVParamCache[Index].Status;
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Record the result of a read of a non-volatile parameter.
+
+  @param[in] Param                Parameter ID
+  @param[in] ACLRd                Permission for read operation.
+  @param[in] Val                  Value read.
+  @param[in] Status               Read status.
+**/
+VOID
+NVParamCacheUpdate (
+  IN UINT32     Param,
+  IN UINT16     ACLRd,
+  IN UINT32     Val,
+  IN EFI_STATUS Status
+  )
+{
+  NVPARAM_CACHE_ENTRY *Entry;
+
+  Entry = &mNVParamCache[mNVParamCacheNext];
+  mNVParamCacheNext = (mNVParamCacheNext + 1) % NVPARAM_CACHE_ENTRIES;
+
+  Entry->Valid = TRUE;
+  Entry->Param = Param;
+  Entry->ACLRd = ACLRd;
+  Entry->Val = Val;
+  Entry->Status = Status;
+}
+
+/**
+  Drop the cached reads of a non-volatile parameter.
+
+  @param[in] Param                Parameter ID, or MAX_UINT32 for all.
+**/
+VOID
+NVParamCacheInvalidate (
+  IN UINT32 Param
+  )
+{
+  UINTN Index;
+
+  if (Param == MAX_UINT32) {
+    ZeroMem (mNVParamCache, sizeof (mNVParamCache));
+    mNVParamCacheNext = 0;
+    return;
+  }
+
+  for (Index = 0; Index < NVPARAM_CACHE_ENTRIES; Index++) {
+    if (mNVParamCache[Index].Param == Param) {
+      mNVParamCache[Index].Valid = FALSE;
+    }
+  }
+}
@@ -0,0 +1,65 @@
+/** @file
+
+  Copyright (c) 2021, Ampere Computing LLC. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+  NVParam read cache stubs for modules that can't keep writable global data,
+  or that must see the current value on every read.
+
+**/
+
+#include <Uefi.h>
+
+#include "NVParamLibCommon.h"
+
+/**
+  Look up the result of a previous read of a non-volatile parameter.
+
+  @param[in]  Param               Parameter ID
+  @param[in]  ACLRd               Permission for read operation.
+  @param[out] Val                 Pointer to the cached value.
+  @param[out] Status              Pointer to the cached read status.
+
+  @retval FALSE                   The parameter has to be read.
+**/
+BOOLEAN
+NVParamCacheLookup (
+  IN  UINT32     Param,
+  IN  UINT16     ACLRd,
+  OUT UINT32     *Val,
+  OUT EFI_STATUS *Status
+  )
+{
+  return FALSE;
+}
+
+/**
+  Record the result of a read of a non-volatile parameter.
+
+  @param[in] Param                Parameter ID
+  @param[in] ACLRd                Permission for read operation.
+  @param[in] Val                  Value read.
+  @param[in] Status               Read status.
+**/
+VOID
+NVParamCacheUpdate (
+  IN UINT32     Param,
+  IN UINT16     ACLRd,
+  IN UINT32     Val,
+  IN EFI_STATUS Status
+  )
+{
+}
+
+/**
+  Drop the cached reads of a non-volatile parameter.
+
+  @param[in] Param                Parameter ID, or MAX_UINT32 for all.
+**/
+VOID
+NVParamCacheInvalidate (
+  IN UINT32 Param
+  )
+{
+}
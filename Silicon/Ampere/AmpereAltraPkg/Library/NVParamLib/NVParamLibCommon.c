@@ -41,11 +41,19 @@ NVParamGet (
   EFI_MM_COMMUNICATE_NVPARAM_RESPONSE MmNVParamRes;
   EFI_STATUS                          Status;
   UINT64                              MmData[5];
+  UINT32                              CachedVal;
 
   if (Val == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
+  if (NVParamCacheLookup (Param, ACLRd, &CachedVal, &Status)) {
+    if (!EFI_ERROR (Status)) {
+      *Val = CachedVal;
+    }
+    return Status;
+  }
+
   MmData[0] = MM_NVPARAM_FUNC_READ;
   MmData[1] = Param;
   MmData[2] = (UINT64)ACLRd;
@@ -63,9 +71,11 @@ NVParamGet (
   switch (MmNVParamRes.Status) {
   case MM_NVPARAM_RES_SUCCESS:
     *Val = (UINT32)MmNVParamRes.Value;
+    NVParamCacheUpdate (Param, ACLRd, *Val, EFI_SUCCESS);
     return EFI_SUCCESS;
 
   case MM_NVPARAM_RES_NOT_SET:
+    NVParamCacheUpdate (Param, ACLRd, 0, EFI_NOT_FOUND);
     return EFI_NOT_FOUND;
 
   case MM_NVPARAM_RES_NO_PERM:
@@ -86,6 +96,8 @@ NVParamGet (
   not being created before, the provied permission is used to create the
   parameter. Otherwise, it is checked for access. It is expected that the
   caller will carry the correct permission over various call sequences.
+  A write of the value already returned by a cached read with the same read
+  permission is skipped, so saving a form only costs a call per changed value.
 
   @param[in] Param                Parameter ID to set
   @param[in] ACLRd                Permission for read operation.
@@ -108,6 +120,16 @@ NVParamSet (
   EFI_MM_COMMUNICATE_NVPARAM_RESPONSE MmNVParamRes;
   EFI_STATUS                          Status;
   UINT64                              MmData[5];
+  UINT32                              CachedVal;
+
+  if (NVParamCacheLookup (Param, ACLRd, &CachedVal, &Status)
+      && !EFI_ERROR (Status)
+      && CachedVal == Val)
+  {
+    return EFI_SUCCESS;
+  }
+
+  NVParamCacheInvalidate (Param);
 
   MmData[0] = MM_NVPARAM_FUNC_WRITE;
   MmData[1] = Param;
@@ -164,6 +186,8 @@ NVParamClr (
   EFI_STATUS                          Status;
   UINT64                              MmData[5];
 
+  NVParamCacheInvalidate (Param);
+
   MmData[0] = MM_NVPARAM_FUNC_CLEAR;
   MmData[1] = Param;
   MmData[2] = 0;
@@ -210,6 +234,8 @@ NVParamClrAll (
   EFI_STATUS                          Status;
   UINT64                              MmData[5];
 
+  NVParamCacheInvalidate (MAX_UINT32);
+
   MmData[0] = MM_NVPARAM_FUNC_CLEAR_ALL;
 
   Status = NVParamMmCommunicate (
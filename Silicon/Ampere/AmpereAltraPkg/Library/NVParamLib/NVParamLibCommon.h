@@ -67,4 +67,50 @@ NVParamMmCommunicate (
   OUT VOID   *Response,
   IN  UINT32 ResponseDataSize
   );
+
+/**
+  Look up the result of a previous read of a non-volatile parameter.
+
+  @param[in]  Param               Parameter ID
+  @param[in]  ACLRd               Permission for read operation.
+  @param[out] Val                 Pointer to the cached value.
+  @param[out] Status              Pointer to the cached read status.
+
+  @retval TRUE                    The read was found in the cache.
+  @retval FALSE                   The parameter has to be read.
+**/
+BOOLEAN
+NVParamCacheLookup (
+  IN  UINT32     Param,
+  IN  UINT16     ACLRd,
+  OUT UINT32     *Val,
+  OUT EFI_STATUS *Status
+  );
+
+/**
+  Record the result of a read of a non-volatile parameter.
+
+  @param[in] Param                Parameter ID
+  @param[in] ACLRd                Permission for read operation.
+  @param[in] Val                  Value read.
+  @param[in] Status               Read status.
+**/
+VOID
+NVParamCacheUpdate (
+  IN UINT32     Param,
+  IN UINT16     ACLRd,
+  IN UINT32     Val,
+  IN EFI_STATUS Status
+  );
+
+/**
+  Drop the cached reads of a non-volatile parameter.
+
+  @param[in] Param                Parameter ID, or MAX_UINT32 for all.
+**/
+VOID
+NVParamCacheInvalidate (
+  IN UINT32 Param
+  );
+
 #endif /* NV_PARAM_LIB_COMMON_H_ */
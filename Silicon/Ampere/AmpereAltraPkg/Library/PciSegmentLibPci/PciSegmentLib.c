@@ -54,6 +54,15 @@
 **/
 #define PCI_SEGMENT_TO_PCI_ADDRESS(A) ((UINTN)(UINT32)A)
 
+//
+// Root complex list from the HOB and the last segment looked up. Enumeration
+// walks one segment at a time, so nearly every access hits the cached entry
+// instead of walking the HOB list and the root complex list again.
+//
+STATIC AC01_ROOT_COMPLEX  *mRootComplexList = NULL;
+STATIC UINT16             mCachedSegment    = MAX_UINT16;
+STATIC UINTN              mCachedMmcfgBase  = 0;
+
 /**
   Get the MCFG Base address from the segment number.
 **/
@@ -62,20 +71,27 @@ GetMmcfgBase (
   IN UINT16  SegmentNumber
   )
 {
-  AC01_ROOT_COMPLEX     *RootComplexList;
   UINTN                 Idx;
   VOID                  *Hob;
 
-  Hob = GetFirstGuidHob (&gRootComplexInfoHobGuid);
-  if (Hob == NULL) {
-    return 0;
+  if ((SegmentNumber == mCachedSegment) && (mCachedMmcfgBase != 0)) {
+    return mCachedMmcfgBase;
   }
 
-  RootComplexList = (AC01_ROOT_COMPLEX *)GET_GUID_HOB_DATA (Hob);
+  if (mRootComplexList == NULL) {
+    Hob = GetFirstGuidHob (&gRootComplexInfoHobGuid);
+    if (Hob == NULL) {
+      return 0;
+    }
+
+    mRootComplexList = (AC01_ROOT_COMPLEX *)GET_GUID_HOB_DATA (Hob);
+  }
 
   for (Idx = 0; Idx < AC01_PCIE_MAX_ROOT_COMPLEX; Idx++) {
-    if (RootComplexList[Idx].Logical == SegmentNumber) {
-      return RootComplexList[Idx].MmcfgBase;
+    if (mRootComplexList[Idx].Logical == SegmentNumber) {
+      mCachedSegment   = SegmentNumber;
+      mCachedMmcfgBase = mRootComplexList[Idx].MmcfgBase;
+      return mCachedMmcfgBase;
     }
   }
 
@@ -1359,6 +1375,7 @@ PciSegmentReadBuffer (
   )
 {
   UINTN                                ReturnValue;
+  UINTN                                CfgBase;
 
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (StartAddress, 0);
   ASSERT (((StartAddress & 0xFFF) + Size) <= SIZE_4KB);
@@ -1394,12 +1411,20 @@ PciSegmentReadBuffer (
     Buffer = (UINT16 *)Buffer + 1;
   }
 
+  CfgBase = GetMmcfgBase (GET_SEG_NUM (StartAddress)) + (StartAddress & 0x0FFFFFFF);
+
   while (Size >= sizeof (UINT32)) {
     //
-    // Read as many double words as possible
+    // Read as many double words as possible. Only register 0 is subject to
+    // the hidden device workaround, the rest is read directly from ECAM.
     //
-    WriteUnaligned32 (Buffer, PciSegmentRead32 (StartAddress));
+    if (GET_REG_NUM (StartAddress) == 0) {
+      WriteUnaligned32 (Buffer, PciSegmentRead32 (StartAddress));
+    } else {
+      WriteUnaligned32 (Buffer, MmioRead32 (CfgBase));
+    }
     StartAddress += sizeof (UINT32);
+    CfgBase += sizeof (UINT32);
     Size -= sizeof (UINT32);
     Buffer = (UINT32 *)Buffer + 1;
   }
@@ -1457,6 +1482,7 @@ PciSegmentWriteBuffer (
   )
 {
   UINTN                                ReturnValue;
+  UINTN                                CfgBase;
 
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (StartAddress, 0);
   ASSERT (((StartAddress & 0xFFF) + Size) <= SIZE_4KB);
@@ -1492,12 +1518,15 @@ PciSegmentWriteBuffer (
     Buffer = (UINT16 *)Buffer + 1;
   }
 
+  CfgBase = GetMmcfgBase (GET_SEG_NUM (StartAddress)) + (StartAddress & 0x0FFFFFFF);
+
   while (Size >= sizeof (UINT32)) {
     //
     // Write as many double words as possible
     //
-    PciSegmentWrite32 (StartAddress, ReadUnaligned32 (Buffer));
+    MmioWrite32 (CfgBase, ReadUnaligned32 (Buffer));
     StartAddress += sizeof (UINT32);
+    CfgBase += sizeof (UINT32);
     Size -= sizeof (UINT32);
     Buffer = (UINT32 *)Buffer + 1;
   }
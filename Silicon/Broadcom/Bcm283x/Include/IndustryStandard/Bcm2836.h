@@ -120,5 +120,35 @@
 #define BCM2836_DMA_CTRL_BASE_ADDRESS                       (BCM2836_SOC_REGISTERS + BCM2836_DMA_CTRL_OFFSET)
 
 #define BCM2836_DMA_CHANNEL_LENGTH                          0x00000100
+#define BCM2836_DMA_CHANNEL_BASE_ADDRESS(N)                 (BCM2836_DMA0_BASE_ADDRESS + (N) * BCM2836_DMA_CHANNEL_LENGTH)
+
+#define BCM2836_DMA_INT_STATUS                              (BCM2836_DMA_CTRL_BASE_ADDRESS + 0x0)
+#define BCM2836_DMA_ENABLE                                  (BCM2836_DMA_CTRL_BASE_ADDRESS + 0x10)
+
+/* dma channel registers, relative to the channel base */
+#define BCM2836_DMA_CS                                      0x00
+#define BCM2836_DMA_CONBLK_AD                               0x04
+#define BCM2836_DMA_TI                                      0x08
+#define BCM2836_DMA_DEBUG                                   0x20
+
+#define BCM2836_DMA_CS_ACTIVE                               BIT0
+#define BCM2836_DMA_CS_END                                  BIT1
+#define BCM2836_DMA_CS_INT                                  BIT2
+#define BCM2836_DMA_CS_ERROR                                BIT8
+#define BCM2836_DMA_CS_WAIT_FOR_OUTSTANDING_WRITES          BIT28
+#define BCM2836_DMA_CS_ABORT                                BIT30
+#define BCM2836_DMA_CS_RESET                                BIT31
+
+#define BCM2836_DMA_TI_WAIT_RESP                            BIT3
+#define BCM2836_DMA_TI_DEST_INC                             BIT4
+#define BCM2836_DMA_TI_DEST_DREQ                            BIT6
+#define BCM2836_DMA_TI_SRC_INC                              BIT8
+#define BCM2836_DMA_TI_SRC_DREQ                             BIT10
+#define BCM2836_DMA_TI_PERMAP(X)                            ((X) << 16)
+
+#define BCM2836_DMA_DEBUG_ERRORS                            (BIT0 | BIT1 | BIT2)
+
+/* peripheral addresses as seen by the dma engine */
+#define BCM2836_SOC_BUS_REGISTERS                           0x7E000000
 
 #endif /*__BCM2836_H__ */
@@ -32,6 +32,10 @@
 #define SDHOST_DATA                 SDHOST_REG(0x40)
 #define SDHOST_HBLC                 SDHOST_REG(0x50)
 
+#define SDHOST_DATA_BUS_ADDRESS     (BCM2836_SOC_BUS_REGISTERS + SDHOST_OFFSET + 0x40)
+#define SDHOST_DMA_DREQ             13
+#define SDHOST_FIFO_WORDS           16
+
 //
 // CMD
 //
@@ -83,6 +87,7 @@
 #define SDHOST_EDM_THRESHOLD_MASK           0x1F
 #define SDHOST_EDM_READ_THRESHOLD(X)        ((X) << SDHOST_EDM_READ_THRESHOLD_SHIFT)
 #define SDHOST_EDM_WRITE_THRESHOLD(X)       ((X) << SDHOST_EDM_WRITE_THRESHOLD_SHIFT)
+#define SDHOST_EDM_FIFO_COUNT(Edm)          (((Edm) >> 4) & 0x1F)
 
 #define CMD8_SD_ARG       (0x0UL << 12 | BIT8 | 0xCEUL << 0)
 #define CMD8_MMC_ARG      (0)
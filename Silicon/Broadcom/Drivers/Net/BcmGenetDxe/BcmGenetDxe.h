@@ -12,8 +12,10 @@
 #define BCM_GENET_DXE_H__
 
 #include <Uefi.h>
+#include <Library/SnpStatsLib.h>
 #include <Library/UefiLib.h>
 #include <Protocol/BcmGenetPlatformDevice.h>
+#include <Protocol/BcmGenetZeroCopyRx.h>
 #include <Protocol/AdapterInformation.h>
 #include <Protocol/ComponentName.h>
 #include <Protocol/ComponentName2.h>
@@ -115,6 +117,10 @@
 #define GENET_DMA_DESC_SIZE                     12
 #define GENET_DMA_DEFAULT_QUEUE                 16
 
+// Spare RX buffers, used to refill the ring while frames are lent out
+#define GENET_RX_LOAN_COUNT                     64
+#define GENET_RX_BUFFER_COUNT                   (GENET_DMA_DESC_COUNT + GENET_RX_LOAN_COUNT)
+
 #define GENET_DMA_RING_SIZE                     0x40
 #define GENET_DMA_RINGS_SIZE                    (GENET_DMA_RING_SIZE * (GENET_DMA_DEFAULT_QUEUE + 1))
 
@@ -212,19 +218,28 @@ typedef struct {
 
   EFI_ADAPTER_INFORMATION_PROTOCOL    Aip;
 
+  BCM_GENET_ZERO_COPY_RX_PROTOCOL     ZeroCopyRx;
+
+  SNP_STATS_CONTEXT                   *SnpStats;
+
   BCM_GENET_PLATFORM_DEVICE_PROTOCOL  *Dev;
 
   GENERIC_PHY_PRIVATE_DATA            Phy;
 
   UINT8                               *TxBuffer[GENET_DMA_DESC_COUNT];
   VOID                                *TxBufferMap[GENET_DMA_DESC_COUNT];
-  UINT8                               TxQueued;
+  UINT16                              TxQueued;
+  UINT16                              TxCompleted;
   UINT16                              TxNext;
   UINT16                              TxConsIndex;
   UINT16                              TxProdIndex;
 
   EFI_PHYSICAL_ADDRESS                RxBuffer;
   GENET_MAP_INFO                      RxBufferMap[GENET_DMA_DESC_COUNT];
+  UINT16                              RxDescBuffer[GENET_DMA_DESC_COUNT];
+  UINT16                              RxFreeBuffer[GENET_RX_LOAN_COUNT];
+  UINT16                              RxFreeCount;
+  BOOLEAN                             RxLoaned[GENET_RX_BUFFER_COUNT];
   UINT16                              RxConsIndex;
   UINT16                              RxProdIndex;
 
@@ -239,12 +254,15 @@ extern EFI_DRIVER_BINDING_PROTOCOL            mGenetDriverBinding;
 
 extern CONST EFI_SIMPLE_NETWORK_PROTOCOL      gGenetSimpleNetworkTemplate;
 extern CONST EFI_ADAPTER_INFORMATION_PROTOCOL gGenetAdapterInfoTemplate;
+extern CONST BCM_GENET_ZERO_COPY_RX_PROTOCOL  gGenetZeroCopyRxTemplate;
 
 #define GENET_DRIVER_SIGNATURE                SIGNATURE_32('G', 'N', 'E', 'T')
 #define GENET_PRIVATE_DATA_FROM_SNP_THIS(a)   CR(a, GENET_PRIVATE_DATA, Snp, GENET_DRIVER_SIGNATURE)
 #define GENET_PRIVATE_DATA_FROM_AIP_THIS(a)   CR(a, GENET_PRIVATE_DATA, Aip, GENET_DRIVER_SIGNATURE)
+#define GENET_PRIVATE_DATA_FROM_ZCRX_THIS(a)  CR(a, GENET_PRIVATE_DATA, ZeroCopyRx, GENET_DRIVER_SIGNATURE)
 
 #define GENET_RX_BUFFER(g, idx)               ((UINT8 *)(UINTN)(g)->RxBuffer + GENET_MAX_PACKET_SIZE * (idx))
+#define GENET_RX_DESC_BUFFER(g, idx)          GENET_RX_BUFFER (g, (g)->RxDescBuffer[idx])
 
 EFI_STATUS
 EFIAPI
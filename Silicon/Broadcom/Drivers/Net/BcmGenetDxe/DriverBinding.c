@@ -164,6 +164,8 @@ GenetDriverBindingStart (
   EfiInitializeLock (&Genet->Lock, TPL_CALLBACK);
   CopyMem (&Genet->Snp, &gGenetSimpleNetworkTemplate, sizeof Genet->Snp);
   CopyMem (&Genet->Aip, &gGenetAdapterInfoTemplate, sizeof Genet->Aip);
+  CopyMem (&Genet->ZeroCopyRx, &gGenetZeroCopyRxTemplate,
+    sizeof Genet->ZeroCopyRx);
 
   Genet->Snp.Mode                       = &Genet->SnpMode;
   Genet->SnpMode.State                  = EfiSimpleNetworkStopped;
@@ -181,7 +183,7 @@ GenetDriverBindingStart (
   Genet->SnpMode.MCastFilterCount       = 0;
   Genet->SnpMode.IfType                 = NET_IFTYPE_ETHERNET;
   Genet->SnpMode.MacAddressChangeable   = TRUE;
-  Genet->SnpMode.MultipleTxSupported    = FALSE;
+  Genet->SnpMode.MultipleTxSupported    = TRUE;
   Genet->SnpMode.MediaPresentSupported  = TRUE;
   Genet->SnpMode.MediaPresent           = FALSE;
 
@@ -206,6 +208,7 @@ GenetDriverBindingStart (
   Status = gBS->InstallMultipleProtocolInterfaces (&ControllerHandle,
                   &gEfiSimpleNetworkProtocolGuid,       &Genet->Snp,
                   &gEfiAdapterInformationProtocolGuid,  &Genet->Aip,
+                  &gBcmGenetZeroCopyRxProtocolGuid,     &Genet->ZeroCopyRx,
                   NULL);
 
   if (EFI_ERROR (Status)) {
@@ -218,6 +221,14 @@ GenetDriverBindingStart (
     goto FreeEvent;
   }
 
+  //
+  // Statistics are optional, the interface works without them.
+  //
+  Status = SnpStatsInstall (ControllerHandle, &Genet->SnpStats);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: no statistics: %r\n", __FUNCTION__, Status));
+  }
+
   Genet->ControllerHandle = ControllerHandle;
   return EFI_SUCCESS;
 
@@ -278,11 +289,14 @@ GenetDriverBindingStop (
   Status = gBS->UninstallMultipleProtocolInterfaces (ControllerHandle,
                   &gEfiSimpleNetworkProtocolGuid,       &Genet->Snp,
                   &gEfiAdapterInformationProtocolGuid,  &Genet->Aip,
+                  &gBcmGenetZeroCopyRxProtocolGuid,     &Genet->ZeroCopyRx,
                   NULL);
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
+  SnpStatsUninstall (ControllerHandle, Genet->SnpStats);
+
   Status = gBS->CloseEvent (Genet->ExitBootServicesEvent);
   ASSERT_EFI_ERROR (Status);
 
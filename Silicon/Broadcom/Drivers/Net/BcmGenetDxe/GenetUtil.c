@@ -544,6 +544,7 @@ GenetDmaInitRings (
   Qid = GENET_DMA_DEFAULT_QUEUE;
 
   Genet->TxQueued = 0;
+  Genet->TxCompleted = 0;
   Genet->TxNext = 0;
   Genet->TxConsIndex = 0;
   Genet->TxProdIndex = 0;
@@ -600,6 +601,10 @@ GenetDmaInitRings (
 /**
   Allocate DMA buffers for RX.
 
+  Each RX descriptor starts out with the buffer of the same index, and
+  the remaining GENET_RX_LOAN_COUNT buffers are kept as spares, which
+  replace the buffers lent out by the zero-copy receive protocol.
+
   @param  Genet[in]  Pointer to GENET_PRIVATE_DATA.
 
   @retval EFI_SUCCESS           DMA buffers allocated.
@@ -611,16 +616,27 @@ GenetDmaAlloc (
   )
 {
   EFI_STATUS              Status;
+  UINTN                   Idx;
 
   Genet->RxBuffer = mDmaAddressLimit;
   Status = gBS->AllocatePages (AllocateMaxAddress, EfiBootServicesData,
-                  EFI_SIZE_TO_PAGES (GENET_MAX_PACKET_SIZE * GENET_DMA_DESC_COUNT),
+                  EFI_SIZE_TO_PAGES (GENET_MAX_PACKET_SIZE * GENET_RX_BUFFER_COUNT),
                   &Genet->RxBuffer);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR,
       "%a: Failed to allocate RX buffer: %r\n", __FUNCTION__, Status));
+    return Status;
   }
-  return Status;
+
+  for (Idx = 0; Idx < GENET_DMA_DESC_COUNT; Idx++) {
+    Genet->RxDescBuffer[Idx] = (UINT16)Idx;
+  }
+  for (Idx = 0; Idx < GENET_RX_LOAN_COUNT; Idx++) {
+    Genet->RxFreeBuffer[Idx] = (UINT16)(GENET_DMA_DESC_COUNT + Idx);
+  }
+  Genet->RxFreeCount = GENET_RX_LOAN_COUNT;
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -647,7 +663,7 @@ GenetDmaMapRxDescriptor (
 
   DmaNumberOfBytes = GENET_MAX_PACKET_SIZE;
   Status = DmaMap (MapOperationBusMasterWrite,
-             GENET_RX_BUFFER (Genet, DescIndex),
+             GENET_RX_DESC_BUFFER (Genet, DescIndex),
              &DmaNumberOfBytes,
              &Genet->RxBufferMap[DescIndex].PhysAddress,
              &Genet->RxBufferMap[DescIndex].Mapping);
@@ -703,7 +719,7 @@ GenetDmaFree (
     GenetDmaUnmapRxDescriptor (Genet, Idx);
   }
   gBS->FreePages (Genet->RxBuffer,
-         EFI_SIZE_TO_PAGES (GENET_MAX_PACKET_SIZE * GENET_DMA_DESC_COUNT));
+         EFI_SIZE_TO_PAGES (GENET_MAX_PACKET_SIZE * GENET_RX_BUFFER_COUNT));
 }
 
 /**
@@ -744,6 +760,10 @@ GenetDmaTriggerTx (
 /**
   Simulate a "TX interrupt", return the next (completed) TX buffer to recycle.
 
+  The hardware consumer index is only read once all the completions it
+  reported last time have been recycled, so draining a batch of completed
+  buffers costs a single MMIO read.
+
   @param  Genet[in]   Pointer to GENET_PRIVATE_DATA.
   @param  TxBuf[out]  Location to store pointer to next TX buffer to recycle.
 
@@ -754,12 +774,15 @@ GenetTxIntr (
   OUT VOID               **TxBuf
   )
 {
-  UINT32 Total;
+  if (Genet->TxCompleted == 0 && Genet->TxQueued > 0) {
+    Genet->TxCompleted = (UINT16)GenetTxPending (Genet);
+    ASSERT (Genet->TxCompleted <= Genet->TxQueued);
+  }
 
-  Total = GenetTxPending (Genet);
-  if (Genet->TxQueued > 0 && Total > 0) {
+  if (Genet->TxCompleted > 0) {
     DmaUnmap (Genet->TxBufferMap[Genet->TxNext]);
     *TxBuf = Genet->TxBuffer[Genet->TxNext];
+    Genet->TxCompleted--;
     Genet->TxQueued--;
     Genet->TxNext = (Genet->TxNext + 1) % GENET_DMA_DESC_COUNT;
     Genet->TxConsIndex = (Genet->TxConsIndex + 1) & 0xFFFF;
@@ -413,7 +413,22 @@ GenetSimpleNetworkStatistics (
   OUT EFI_NETWORK_STATISTICS     *StatisticsTable OPTIONAL
   )
 {
-  return EFI_UNSUPPORTED;
+  GENET_PRIVATE_DATA  *Genet;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Genet = GENET_PRIVATE_DATA_FROM_SNP_THIS (This);
+  if (Genet->SnpMode.State == EfiSimpleNetworkStopped) {
+    return EFI_NOT_STARTED;
+  }
+  if (Genet->SnpMode.State != EfiSimpleNetworkInitialized) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  return SnpStatsGetNetworkStatistics (Genet->SnpStats, Reset, StatisticsSize,
+           StatisticsTable);
 }
 
 /**
@@ -476,8 +491,7 @@ GenetSimpleNetworkNvData (
 **/
 STATIC
 EFI_STATUS
-EFIAPI
-GenetSimpleNetworkGetStatus (
+GenetGetStatus (
   IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
   OUT UINT32                     *InterruptStatus, OPTIONAL
   OUT VOID                       **TxBuf           OPTIONAL
@@ -514,7 +528,7 @@ GenetSimpleNetworkGetStatus (
     if (GenetRxPending (Genet) > 0) {
       *InterruptStatus |= EFI_SIMPLE_NETWORK_RECEIVE_INTERRUPT;
     }
-    if (GenetTxPending (Genet) > 0) {
+    if (Genet->TxCompleted > 0 || GenetTxPending (Genet) > 0) {
       *InterruptStatus |= EFI_SIMPLE_NETWORK_TRANSMIT_INTERRUPT;
     }
   }
@@ -522,6 +536,37 @@ GenetSimpleNetworkGetStatus (
   return EFI_SUCCESS;
 }
 
+/**
+  Reads the current interrupt status and recycled transmit buffer status from
+  a network interface, recording the call in the SNP statistics.
+
+  See GenetGetStatus ().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+GenetSimpleNetworkGetStatus (
+  IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
+  OUT UINT32                     *InterruptStatus, OPTIONAL
+  OUT VOID                       **TxBuf           OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      StartTicks;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = GenetGetStatus (This, InterruptStatus, TxBuf);
+  SnpStatsRecord (GENET_PRIVATE_DATA_FROM_SNP_THIS (This)->SnpStats,
+    SnpStatsGetStatus, StartTicks, Status, 0);
+
+  return Status;
+}
+
 /**
   Places a packet in the transmit queue of a network interface.
 
@@ -557,8 +602,7 @@ GenetSimpleNetworkGetStatus (
 **/
 STATIC
 EFI_STATUS
-EFIAPI
-GenetSimpleNetworkTransmit (
+GenetTransmit (
   IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
   IN UINTN                       HeaderSize,
   IN UINTN                       BufferSize,
@@ -642,7 +686,7 @@ GenetSimpleNetworkTransmit (
     return EFI_ACCESS_DENIED;
   }
 
-  if (Genet->TxQueued == GENET_DMA_DESC_COUNT - 1) {
+  if (Genet->TxQueued == GENET_DMA_DESC_COUNT) {
     EfiReleaseLock (&Genet->Lock);
 
     DEBUG ((DEBUG_ERROR, "%a: Queue full\n", __FUNCTION__));
@@ -681,6 +725,42 @@ GenetSimpleNetworkTransmit (
   return EFI_SUCCESS;
 }
 
+/**
+  Places a packet in the transmit queue of a network interface, recording the
+  call in the SNP statistics.
+
+  See GenetTransmit ().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+GenetSimpleNetworkTransmit (
+  IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
+  IN UINTN                       HeaderSize,
+  IN UINTN                       BufferSize,
+  IN VOID                        *Buffer,
+  IN EFI_MAC_ADDRESS             *SrcAddr,  OPTIONAL
+  IN EFI_MAC_ADDRESS             *DestAddr, OPTIONAL
+  IN UINT16                      *Protocol  OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      StartTicks;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = GenetTransmit (This, HeaderSize, BufferSize, Buffer, SrcAddr,
+             DestAddr, Protocol);
+  SnpStatsRecord (GENET_PRIVATE_DATA_FROM_SNP_THIS (This)->SnpStats,
+    SnpStatsTransmit, StartTicks, Status, BufferSize);
+
+  return Status;
+}
+
 /**
   Receives a packet from a network interface.
 
@@ -714,8 +794,7 @@ GenetSimpleNetworkTransmit (
 **/
 STATIC
 EFI_STATUS
-EFIAPI
-GenetSimpleNetworkReceive (
+GenetReceive (
   IN     EFI_SIMPLE_NETWORK_PROTOCOL *This,
   OUT    UINTN                       *HeaderSize, OPTIONAL
   IN OUT UINTN                       *BufferSize,
@@ -761,7 +840,7 @@ GenetSimpleNetworkReceive (
 
   GenetDmaUnmapRxDescriptor (Genet, DescIndex);
 
-  Frame = GENET_RX_BUFFER (Genet, DescIndex);
+  Frame = GENET_RX_DESC_BUFFER (Genet, DescIndex);
 
   if (FrameLength > 2 + Genet->SnpMode.MediaHeaderSize) {
     // Received frame has 2 bytes of padding at the start
@@ -796,6 +875,7 @@ GenetSimpleNetworkReceive (
   } else {
     DEBUG ((DEBUG_ERROR, "%a: Short packet (FrameLength 0x%X)",
       __FUNCTION__, FrameLength));
+    SnpStatsRecordDrop (Genet->SnpStats, SnpStatsReceive);
     Status = EFI_NOT_READY;
   }
 
@@ -811,6 +891,42 @@ out:
   return Status;
 }
 
+/**
+  Receives a packet from a network interface, recording the call in the SNP
+  statistics.
+
+  See GenetReceive ().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+GenetSimpleNetworkReceive (
+  IN     EFI_SIMPLE_NETWORK_PROTOCOL *This,
+  OUT    UINTN                       *HeaderSize, OPTIONAL
+  IN OUT UINTN                       *BufferSize,
+  OUT    VOID                        *Buffer,
+  OUT    EFI_MAC_ADDRESS             *SrcAddr,    OPTIONAL
+  OUT    EFI_MAC_ADDRESS             *DestAddr,   OPTIONAL
+  OUT    UINT16                      *Protocol    OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      StartTicks;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = GenetReceive (This, HeaderSize, BufferSize, Buffer, SrcAddr,
+             DestAddr, Protocol);
+  SnpStatsRecord (GENET_PRIVATE_DATA_FROM_SNP_THIS (This)->SnpStats,
+    SnpStatsReceive, StartTicks, Status, EFI_ERROR (Status) ? 0 : *BufferSize);
+
+  return Status;
+}
+
 /**
   This function converts a multicast IP address to a multicast HW MAC address
   for all packet transactions.
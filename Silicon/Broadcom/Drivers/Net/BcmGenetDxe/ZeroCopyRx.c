@@ -0,0 +1,177 @@
+/** @file
+  Provides the zero-copy receive functions.
+
+  Copyright (c) 2020, ARM Limited. All rights reserved.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/DebugLib.h>
+#include <Library/DmaLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#include "BcmGenetDxe.h"
+
+/**
+  Receives a frame, lending the caller the buffer it was received into.
+
+  The descriptor the frame was received on is refilled with a spare buffer,
+  so this saves the copy, as well as the DmaMap () of the same buffer, done
+  by the Simple Network Receive ().
+
+  @param  This         The protocol instance pointer.
+  @param  Frame        On exit, points to the frame, media header included.
+  @param  FrameLength  On exit, the size of the frame, in bytes.
+
+  @retval EFI_SUCCESS           A frame was received.
+  @retval EFI_NOT_STARTED       The network interface has not been started.
+  @retval EFI_NOT_READY         No frames received.
+  @retval EFI_OUT_OF_RESOURCES  All spare buffers are lent out.
+  @retval EFI_INVALID_PARAMETER One or more of the parameters is NULL.
+  @retval EFI_DEVICE_ERROR      The network interface is not initialized.
+  @retval EFI_ACCESS_DENIED     The driver is busy.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+GenetZeroCopyRxReceive (
+  IN  BCM_GENET_ZERO_COPY_RX_PROTOCOL *This,
+  OUT VOID                            **Frame,
+  OUT UINTN                           *FrameLength
+  )
+{
+  GENET_PRIVATE_DATA  *Genet;
+  EFI_STATUS          Status;
+  EFI_STATUS          MapStatus;
+  UINT8               DescIndex;
+  UINT16              BufIndex;
+  UINTN               Length;
+
+  if (This == NULL || Frame == NULL || FrameLength == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Genet = GENET_PRIVATE_DATA_FROM_ZCRX_THIS (This);
+  if (Genet->SnpMode.State == EfiSimpleNetworkStopped) {
+    return EFI_NOT_STARTED;
+  }
+  if (Genet->SnpMode.State != EfiSimpleNetworkInitialized) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = EfiAcquireLockOrFail (&Genet->Lock);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Couldn't get lock: %r\n", __FUNCTION__, Status));
+    return EFI_ACCESS_DENIED;
+  }
+
+  if (Genet->RxFreeCount == 0) {
+    EfiReleaseLock (&Genet->Lock);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = GenetRxIntr (Genet, &DescIndex, &Length);
+  if (EFI_ERROR (Status)) {
+    EfiReleaseLock (&Genet->Lock);
+    return Status;
+  }
+
+  ASSERT (Genet->RxBufferMap[DescIndex].Mapping != NULL);
+
+  // Makes the received data visible to the CPU
+  GenetDmaUnmapRxDescriptor (Genet, DescIndex);
+
+  if (Length > 2 + Genet->SnpMode.MediaHeaderSize) {
+    BufIndex = Genet->RxDescBuffer[DescIndex];
+    Genet->RxLoaned[BufIndex] = TRUE;
+    Genet->RxFreeCount--;
+    Genet->RxDescBuffer[DescIndex] = Genet->RxFreeBuffer[Genet->RxFreeCount];
+
+    // Received frame has 2 bytes of padding at the start
+    *Frame = GENET_RX_BUFFER (Genet, BufIndex) + 2;
+    *FrameLength = Length - 2;
+  } else {
+    DEBUG ((DEBUG_ERROR, "%a: Short packet (FrameLength 0x%X)",
+      __FUNCTION__, Length));
+    Status = EFI_NOT_READY;
+  }
+
+  MapStatus = GenetDmaMapRxDescriptor (Genet, DescIndex);
+  if (EFI_ERROR (MapStatus)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to remap RX descriptor!\n", __FUNCTION__));
+  }
+
+  GenetRxComplete (Genet);
+
+  EfiReleaseLock (&Genet->Lock);
+  return Status;
+}
+
+/**
+  Returns a frame obtained from GenetZeroCopyRxReceive () to the spare buffers.
+
+  @param  This   The protocol instance pointer.
+  @param  Frame  The frame, as returned by GenetZeroCopyRxReceive ().
+
+  @retval EFI_SUCCESS           The buffer can be reused by the driver.
+  @retval EFI_INVALID_PARAMETER Frame is not a frame lent out by the driver.
+  @retval EFI_ACCESS_DENIED     The driver is busy.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+GenetZeroCopyRxRelease (
+  IN  BCM_GENET_ZERO_COPY_RX_PROTOCOL *This,
+  IN  VOID                            *Frame
+  )
+{
+  GENET_PRIVATE_DATA  *Genet;
+  EFI_STATUS          Status;
+  UINTN               BufIndex;
+
+  if (This == NULL || Frame == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Genet = GENET_PRIVATE_DATA_FROM_ZCRX_THIS (This);
+  if ((UINTN)Frame < (UINTN)Genet->RxBuffer) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  BufIndex = ((UINTN)Frame - (UINTN)Genet->RxBuffer) / GENET_MAX_PACKET_SIZE;
+  if (BufIndex >= GENET_RX_BUFFER_COUNT) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = EfiAcquireLockOrFail (&Genet->Lock);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Couldn't get lock: %r\n", __FUNCTION__, Status));
+    return EFI_ACCESS_DENIED;
+  }
+
+  if (!Genet->RxLoaned[BufIndex]) {
+    EfiReleaseLock (&Genet->Lock);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ASSERT (Genet->RxFreeCount < GENET_RX_LOAN_COUNT);
+
+  Genet->RxLoaned[BufIndex] = FALSE;
+  Genet->RxFreeBuffer[Genet->RxFreeCount] = (UINT16)BufIndex;
+  Genet->RxFreeCount++;
+
+  EfiReleaseLock (&Genet->Lock);
+  return EFI_SUCCESS;
+}
+
+///
+/// Zero-copy receive protocol instance
+///
+CONST BCM_GENET_ZERO_COPY_RX_PROTOCOL gGenetZeroCopyRxTemplate = {
+  GenetZeroCopyRxReceive,                     // Receive
+  GenetZeroCopyRxRelease                      // Release
+};
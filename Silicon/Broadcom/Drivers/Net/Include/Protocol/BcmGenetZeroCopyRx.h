@@ -0,0 +1,78 @@
+/** @file
+
+  Zero-copy receive protocol, installed by BcmGenetDxe next to the Simple
+  Network protocol.
+
+  Instead of copying each frame into a caller buffer, Receive() lends the
+  caller the RX DMA buffer the frame was received into, and the ring is
+  refilled from a pool of spare buffers. The caller hands the frame back
+  with Release() once it's done with it. Frames must be released before
+  the driver is stopped.
+
+  Copyright (c) 2020, ARM Limited. All rights reserved.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef BCM_GENET_ZERO_COPY_RX_H
+#define BCM_GENET_ZERO_COPY_RX_H
+
+#include <Uefi/UefiBaseType.h>
+
+#define BCM_GENET_ZERO_COPY_RX_PROTOCOL_GUID \
+  {0x2f6e4b5b, 0x381b, 0x4682, {0xb2, 0x45, 0x2e, 0x45, 0x0f, 0x4e, 0x53, 0x7d}}
+
+typedef struct _BCM_GENET_ZERO_COPY_RX_PROTOCOL BCM_GENET_ZERO_COPY_RX_PROTOCOL;
+
+/**
+  Receives a frame, lending the caller the buffer it was received into.
+
+  @param  This         The protocol instance pointer.
+  @param  Frame        On exit, points to the frame, media header included.
+  @param  FrameLength  On exit, the size of the frame, in bytes.
+
+  @retval EFI_SUCCESS           A frame was received.
+  @retval EFI_NOT_STARTED       The network interface has not been started.
+  @retval EFI_NOT_READY         No frames received.
+  @retval EFI_OUT_OF_RESOURCES  All spare buffers are lent out. Release some
+                                frames, or use the Simple Network protocol.
+  @retval EFI_INVALID_PARAMETER One or more of the parameters is NULL.
+  @retval EFI_DEVICE_ERROR      The network interface is not initialized.
+  @retval EFI_ACCESS_DENIED     The driver is busy.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *BCM_GENET_ZERO_COPY_RX_RECEIVE)(
+  IN  BCM_GENET_ZERO_COPY_RX_PROTOCOL *This,
+  OUT VOID                            **Frame,
+  OUT UINTN                           *FrameLength
+  );
+
+/**
+  Returns a frame obtained from Receive() to the driver.
+
+  @param  This   The protocol instance pointer.
+  @param  Frame  The frame, as returned by Receive().
+
+  @retval EFI_SUCCESS           The buffer can be reused by the driver.
+  @retval EFI_INVALID_PARAMETER Frame is not a frame lent out by Receive().
+  @retval EFI_ACCESS_DENIED     The driver is busy.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *BCM_GENET_ZERO_COPY_RX_RELEASE)(
+  IN  BCM_GENET_ZERO_COPY_RX_PROTOCOL *This,
+  IN  VOID                            *Frame
+  );
+
+struct _BCM_GENET_ZERO_COPY_RX_PROTOCOL {
+  BCM_GENET_ZERO_COPY_RX_RECEIVE    Receive;
+  BCM_GENET_ZERO_COPY_RX_RELEASE    Release;
+};
+
+extern EFI_GUID gBcmGenetZeroCopyRxProtocolGuid;
+
+#endif
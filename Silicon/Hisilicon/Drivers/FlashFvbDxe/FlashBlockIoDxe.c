@@ -10,6 +10,85 @@
 
 #include "FlashFvbDxe.h"
 
+//
+// Drop every block kept by the BlockIo read cache, called whenever the flash is modified
+//
+VOID
+FlashBlockCacheInvalidate (
+    IN FLASH_INSTANCE*           Instance
+)
+{
+    UINTN                       Index;
+
+    for (Index = 0; Index < FLASH_BLOCK_CACHE_COUNT; Index++)
+    {
+        Instance->BlockCache[Index].Valid = FALSE;
+    }
+}
+
+//
+// Read a single block through the read cache, evicting the least recently used block on a miss
+//
+STATIC
+EFI_STATUS
+FlashBlockCacheRead (
+    IN  FLASH_INSTANCE*          Instance,
+    IN  EFI_LBA                  Lba,
+    OUT VOID*                    Buffer
+)
+{
+    FLASH_BLOCK_CACHE*          Entry;
+    UINTN                       Index;
+    EFI_STATUS                  Status;
+
+    Entry = &Instance->BlockCache[0];
+    for (Index = 0; Index < FLASH_BLOCK_CACHE_COUNT; Index++)
+    {
+        if (Instance->BlockCache[Index].Valid && (Instance->BlockCache[Index].Lba == Lba))
+        {
+            Entry = &Instance->BlockCache[Index];
+            Entry->LastUsed = ++Instance->BlockCacheTick;
+            CopyMem (Buffer, Entry->Data, Instance->Media.BlockSize);
+            return EFI_SUCCESS;
+        }
+
+        if (!Instance->BlockCache[Index].Valid)
+        {
+            if (Entry->Valid)
+            {
+                Entry = &Instance->BlockCache[Index];
+            }
+        }
+        else if (Entry->Valid && (Instance->BlockCache[Index].LastUsed < Entry->LastUsed))
+        {
+            Entry = &Instance->BlockCache[Index];
+        }
+    }
+
+    Status = FlashReadBlocks (Instance, Lba, Instance->Media.BlockSize, Buffer);
+    if (EFI_ERROR (Status))
+    {
+        return Status;
+    }
+
+    if (Entry->Data == NULL)
+    {
+        Entry->Data = AllocatePool (Instance->Media.BlockSize);
+        if (Entry->Data == NULL)
+        {
+            // The cache is only an optimization, the block has been read anyway
+            return EFI_SUCCESS;
+        }
+    }
+
+    CopyMem (Entry->Data, Buffer, Instance->Media.BlockSize);
+    Entry->Lba      = Lba;
+    Entry->LastUsed = ++Instance->BlockCacheTick;
+    Entry->Valid    = TRUE;
+
+    return EFI_SUCCESS;
+}
+
 //
 // BlockIO Protocol function EFI_BLOCK_IO_PROTOCOL.ReadBlocks
 //
@@ -38,8 +117,14 @@ FlashBlockIoReadBlocks (
     {
         Status = EFI_MEDIA_CHANGED;
     }
+    else if ( (BufferSizeInBytes == This->Media->BlockSize) && (Buffer != NULL) && (Lba <= This->Media->LastBlock) )
+    {
+        // Single block reads (partition table and boot image lookups) are usually repeated
+        Status = FlashBlockCacheRead (Instance, Lba, Buffer);
+    }
     else
     {
+        // Larger reads are streamed from the flash in a single request
         Status = FlashReadBlocks (Instance, Lba, BufferSizeInBytes, Buffer);
     }
 
@@ -680,6 +680,8 @@ FvbWrite (
     BlockAddress = GET_BLOCK_ADDRESS (Instance->RegionBaseAddress, Lba, BlockSize);
     WriteAddress = BlockAddress - Instance->DeviceBaseAddress + Offset;
 
+    FlashBlockCacheInvalidate (Instance);
+
     Status = mFlash->Write(mFlash, (UINT32)WriteAddress, (UINT8*)Buffer, *NumBytes);
     if (EFI_SUCCESS != Status)
     {
@@ -996,6 +998,8 @@ FlashEraseSingleBlock (
     Status = EFI_SUCCESS;
     EraseAddress = BlockAddress - Instance->DeviceBaseAddress;
 
+    FlashBlockCacheInvalidate (Instance);
+
     Status = mFlash->Erase(mFlash, (UINT32)EraseAddress, Instance->Media.BlockSize);
     if (EFI_SUCCESS != Status)
     {
@@ -1088,6 +1092,8 @@ FlashWriteBlocks (
 
     WriteAddress = BlockAddress - Instance->DeviceBaseAddress;
 
+    FlashBlockCacheInvalidate (Instance);
+
     Status = mFlash->Write(mFlash, (UINT32)WriteAddress, (UINT8*)Buffer, BufferSizeInBytes);
     if (EFI_SUCCESS != Status)
     {
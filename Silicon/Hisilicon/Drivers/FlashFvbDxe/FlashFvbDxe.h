@@ -40,6 +40,9 @@
 #define FLASH_ERASE_RETRY                     10
 #define FLASH_DEVICE_COUNT                     1
 
+// Number of recently read blocks kept by the BlockIo read cache
+#define FLASH_BLOCK_CACHE_COUNT                4
+
 // Device access macros
 // These are necessary because we use 2 x 16bit parts to make up 32bit data
 typedef struct
@@ -67,6 +70,14 @@ typedef struct
     EFI_DEVICE_PATH_PROTOCOL            End;
 } FLASH_DEVICE_PATH;
 
+typedef struct
+{
+    BOOLEAN                             Valid;
+    EFI_LBA                             Lba;
+    UINT64                              LastUsed;
+    UINT8*                              Data;     // Boot services pool, only used by BlockIo
+} FLASH_BLOCK_CACHE;
+
 struct _FLASH_INSTANCE
 {
     UINT32                              Signature;
@@ -87,6 +98,9 @@ struct _FLASH_INSTANCE
     EFI_FIRMWARE_VOLUME_BLOCK2_PROTOCOL FvbProtocol;
 
     FLASH_DEVICE_PATH                   DevicePath;
+
+    FLASH_BLOCK_CACHE                   BlockCache[FLASH_BLOCK_CACHE_COUNT];
+    UINT64                              BlockCacheTick;
 };
 
 
@@ -125,6 +139,14 @@ FlashBlockIoFlushBlocks (
     IN EFI_BLOCK_IO_PROTOCOL*    This
 );
 
+//
+// Drop every block kept by the BlockIo read cache, called whenever the flash is modified
+//
+VOID
+FlashBlockCacheInvalidate (
+    IN FLASH_INSTANCE*           Instance
+);
+
 
 //
 // FvbHw.c
@@ -495,11 +495,18 @@ EFIAPI Write(
 
         if (TRUE == IsNeedToWrite(TempBase, Offset, Buffer, TempLength))
         {
-            Status = FlashSectorErase(TempBase, Offset, TempLength);
-            if (EFI_ERROR(Status))
+            //
+            // Only erase (and restore the rest of) the sector if some bit has
+            // to go from 0 to 1, otherwise the new data is programmed in place.
+            //
+            if (TRUE == IsNeedToErase(TempBase, Offset, Buffer, TempLength))
             {
-                DEBUG ((EFI_D_ERROR, "[%a]:[%dL]:FlashErase One Sector Error, Status = %r!\n", __FUNCTION__,__LINE__,Status));
-                return Status;
+                Status = FlashSectorErase(TempBase, Offset, TempLength);
+                if (EFI_ERROR(Status))
+                {
+                    DEBUG ((EFI_D_ERROR, "[%a]:[%dL]:FlashErase One Sector Error, Status = %r!\n", __FUNCTION__,__LINE__,Status));
+                    return Status;
+                }
             }
 
 
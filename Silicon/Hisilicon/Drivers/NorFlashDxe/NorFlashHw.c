@@ -533,6 +533,38 @@ EFI_STATUS IsNeedToWrite(
 }
 
 
+/*
+ * Programming can only clear bits, so the sector only has to be erased
+ * if some bit of the new data is 1 where the flash already holds a 0.
+ */
+BOOLEAN IsNeedToErase(
+    IN  UINT32         Base,
+    IN  UINT32       Offset,
+    IN  UINT8       *Buffer,
+    IN  UINT32       Length
+  )
+{
+    UINTN NewAddr = Base + Offset;
+    UINT8 FlashData = 0;
+    UINT8 BufferData = 0;
+
+    for(; Length > 0; Length --)
+    {
+        BufferData = *Buffer;
+        //lint -epn -e511
+        FlashData = *(UINT8 *)NewAddr;
+        if ((FlashData & BufferData) != BufferData)
+        {
+            return TRUE;
+        }
+        NewAddr ++;
+        Buffer ++;
+    }
+
+    return FALSE;
+}
+
+
 EFI_STATUS BufferWrite(UINT32 Offset, void *pData, UINT32 Length)
 {
     EFI_STATUS Status;
@@ -97,6 +97,7 @@ extern EFI_STATUS FlashInit(UINT32 Base);
 extern EFI_STATUS SectorErase(UINT32 Base, UINT32 Offset);
 extern EFI_STATUS BufferWrite(UINT32 Offset, void *pData, UINT32 Length);
 extern EFI_STATUS IsNeedToWrite(UINT32 Base, UINT32 Offset, UINT8 *Buffer, UINT32 Length);
+extern BOOLEAN IsNeedToErase(UINT32 Base, UINT32 Offset, UINT8 *Buffer, UINT32 Length);
 
 
 extern NOR_FLASH_INFO_TABLE gFlashInfo[FLASH_DEVICE_NUM];
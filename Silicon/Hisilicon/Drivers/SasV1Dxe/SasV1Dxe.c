@@ -184,6 +184,7 @@
 #define upper_32_bits(n) ((UINT32)(((n) >> 16) >> 16))
 #define lower_32_bits(n) ((UINT32)(n))
 #define MAX_TARGET_ID 4
+#define SAS_POLL_INTERVAL EFI_TIMER_PERIOD_MILLISECONDS (1)
 
 // Generic HW DMA host memory structures
 struct hisi_sas_cmd_hdr {
@@ -257,6 +258,12 @@ UINT32 status[260];
 
 struct hisi_sas_slot {
     BOOLEAN used;
+    BOOLEAN done;
+    BOOLEAN sense;
+    EFI_STATUS Status;
+    EFI_EVENT Event;
+    VOID *BufferMap;
+    EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET *Packet;
 };
 
 struct hisi_hba {
@@ -296,9 +303,123 @@ typedef struct {
 #define SAS_DEVICE_SIGNATURE SIGNATURE_32 ('S','A','S','0')
 #define SAS_FROM_PASS_THRU(a) CR (a, SAS_V1_INFO, ExtScsiPassThru, SAS_DEVICE_SIGNATURE)
 
+// Finish a completed slot: release the data buffer, report sense data and
+// either signal the caller's event (non-blocking) or wake the poller.
+STATIC VOID complete_slot (
+  struct hisi_hba *hba,
+  struct hisi_sas_slot *slot,
+  UINT32 slot_idx,
+  UINT32 data
+  )
+{
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET *Packet = slot->Packet;
+  EFI_SCSI_SENSE_DATA *SensePtr = Packet->SenseData;
+  struct hisi_sas_sts *sts;
+  UINT8 *p;
+
+  sts = &hba->status_buf[slot_idx / QUEUE_SLOTS][slot_idx % QUEUE_SLOTS];
+  slot->Status = EFI_SUCCESS;
+
+  // Check whether dma transfer error
+  if ((data & CMPLT_HDR_ERR_RCRD_XFRD_MSK) &&
+    !(data & CMPLT_HDR_RSPNS_XFRD_MSK)) {
+    DEBUG ((EFI_D_VERBOSE, "sas retry data=0x%x\n", data));
+    DEBUG ((EFI_D_VERBOSE, "sts[0]=0x%x\n", sts->status[0]));
+    DEBUG ((EFI_D_VERBOSE, "sts[1]=0x%x\n", sts->status[1]));
+    DEBUG ((EFI_D_VERBOSE, "sts[2]=0x%x\n", sts->status[2]));
+    slot->Status = EFI_NOT_READY;
+  }
+
+  if (slot->BufferMap)
+       DmaUnmap (slot->BufferMap);
+  slot->BufferMap = NULL;
+
+  p = (UINT8 *)&sts->status[0];
+  slot->sense = p[SENSE_DATA_PRES] != 0;
+  if (slot->sense && SensePtr) {
+    // Disk not ready normal return for ScsiDiskTestUnitReady do next try
+    SensePtr->Sense_Key = EFI_SCSI_SK_NOT_READY;
+    SensePtr->Addnl_Sense_Code = EFI_SCSI_ASC_NOT_READY;
+    SensePtr->Addnl_Sense_Code_Qualifier = EFI_SCSI_ASCQ_IN_PROGRESS;
+  }
+
+  if (slot->Event == NULL) {
+    // The blocking caller picks up the result and frees the slot
+    slot->done = TRUE;
+    return;
+  }
+
+  // Non-blocking callers only see the result through the packet
+  if (EFI_ERROR (slot->Status)) {
+    Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+  }
+  gBS->SignalEvent (slot->Event);
+  slot->used = FALSE;
+}
+
+// Drain every completion queue with pending entries. Completions may arrive
+// in any order, the IPTT of each entry identifies the slot it belongs to.
+STATIC VOID drain_cq (
+  struct hisi_hba *hba
+  )
+{
+  struct hisi_sas_complete_hdr *complete_hdr;
+  UINT32 base = hba->base;
+  UINT32 src, rd, wr, data, iptt;
+  EFI_TPL OldTpl;
+  int queue;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  src = READ_REG32(base, OQ_INT_SRC);
+  for (queue = 0; queue < QUEUE_CNT && src; queue++) {
+    if (!(src & BIT(queue)))
+      continue;
+    src &= ~BIT(queue);
+
+    // Clear int before reading the write pointer so no entry is missed
+    WRITE_REG32(base, OQ_INT_SRC, BIT(queue));
+
+    wr = READ_REG32(base, COMPL_Q_0_WR_PTR + (0x14 * queue));
+    rd = READ_REG32(base, COMPL_Q_0_RD_PTR + (0x14 * queue));
+
+    while (rd != wr) {
+      complete_hdr = &hba->complete_hdr[queue][rd];
+      data = complete_hdr->data;
+      iptt = (data & CMPLT_HDR_IPTT_MSK) >> CMPLT_HDR_IPTT_OFF;
+
+      if (iptt < SLOT_ENTRIES && hba->slots[iptt].used &&
+        !hba->slots[iptt].done) {
+        complete_slot (hba, &hba->slots[iptt], iptt, data);
+      } else {
+        DEBUG ((EFI_D_ERROR, "sas spurious completion iptt=0x%x\n", iptt));
+      }
+
+      rd = (rd + 1) % QUEUE_SLOTS;
+    }
+
+    // Update read point
+    WRITE_REG32(base, COMPL_Q_0_RD_PTR + (0x14 * queue), rd);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+STATIC
+VOID
+EFIAPI
+SasV1PollCompletions (
+  IN EFI_EVENT   Event,
+  IN VOID        *Context
+  )
+{
+  drain_cq ((struct hisi_hba *)Context);
+}
+
 STATIC EFI_STATUS prepare_cmd (
   struct hisi_hba *hba,
-  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET    *Packet
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET    *Packet,
+  EFI_EVENT                                     Event
   )
 {
   struct hisi_sas_slot *slot;
@@ -309,15 +430,17 @@ STATIC EFI_STATUS prepare_cmd (
   EFI_SCSI_SENSE_DATA *SensePtr = Packet->SenseData;
   VOID   *Buffer = NULL;
   UINTN BufferSize = 0;
-  int queue = hba->queue;
+  int queue;
   UINT32 r, w = 0, slot_idx = 0;
   UINT32 base = hba->base;
-  UINT8 *p;
   EFI_PHYSICAL_ADDRESS  BufferAddress;
   EFI_STATUS            Status = EFI_SUCCESS;
-  VOID                  *BufferMap = NULL;
+  EFI_TPL               OldTpl;
   DMA_MAP_OPERATION DmaOperation = MapOperationBusMasterCommonBuffer;
 
+  // Callers at different TPLs may race for the same delivery queue slot
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  queue = hba->queue;
   while (1) {
     w = READ_REG32(base, DLVRY_Q_0_WR_PTR + (queue * 0x14));
     r = READ_REG32(base, DLVRY_Q_0_RD_PTR + (queue * 0x14));
@@ -326,6 +449,7 @@ STATIC EFI_STATUS prepare_cmd (
     if (slot->used || (r == (w+1) % QUEUE_SLOTS)) {
       queue = (queue + 1) % QUEUE_CNT;
       if (queue == hba->queue) {
+        gBS->RestoreTPL (OldTpl);
         DEBUG ((EFI_D_ERROR, "could not find free slot\n"));
         return EFI_NOT_READY;
       }
@@ -345,7 +469,13 @@ STATIC EFI_STATUS prepare_cmd (
     ZeroMem (SensePtr, sizeof (EFI_SCSI_SENSE_DATA));
 
   slot->used = TRUE;
+  slot->done = FALSE;
+  slot->sense = FALSE;
+  slot->Event = Event;
+  slot->BufferMap = NULL;
+  slot->Packet = Packet;
   hba->queue = (queue + 1) % QUEUE_CNT;
+  gBS->RestoreTPL (OldTpl);
 
   // Only consider ssp
   hdr->dw0 = (1 << CMD_HDR_RESP_REPORT_OFF) |
@@ -386,8 +516,10 @@ STATIC EFI_STATUS prepare_cmd (
     struct hisi_sas_sge *sg;
     UINT32 remain, len, pos = 0, i = 0;
 
-    Status = DmaMap (DmaOperation, Buffer, &BufferSize, &BufferAddress, &BufferMap);
+    Status = DmaMap (DmaOperation, Buffer, &BufferSize, &BufferAddress, &slot->BufferMap);
     if (EFI_ERROR (Status)) {
+      slot->BufferMap = NULL;
+      slot->used = FALSE;
       return Status;
     }
     remain = len = BufferSize;
@@ -416,51 +548,33 @@ STATIC EFI_STATUS prepare_cmd (
   // Start dma
   WRITE_REG32(base, DLVRY_Q_0_WR_PTR + queue * 0x14, ++w % QUEUE_SLOTS);
 
-  // Wait for dma complete
-  while (slot->used) {
-    if (READ_REG32(base, OQ_INT_SRC) & BIT(queue)) {
-      struct hisi_sas_complete_hdr *complete_hdr;
-      UINT32 data, rd;
-      rd = READ_REG32(base, COMPL_Q_0_RD_PTR + (0x14 * queue));
-
-      complete_hdr = &hba->complete_hdr[queue][rd];
-      data = complete_hdr->data;
+  if (Event != NULL) {
+    // Completion is reported by SasV1PollCompletions
+    return EFI_SUCCESS;
+  }
 
-      // Check whether dma transfer error
-      if ((data & CMPLT_HDR_ERR_RCRD_XFRD_MSK) &&
-        !(data & CMPLT_HDR_RSPNS_XFRD_MSK)) {
-        DEBUG ((EFI_D_VERBOSE, "sas retry data=0x%x\n", data));
-        DEBUG ((EFI_D_VERBOSE, "sts[0]=0x%x\n", sts->status[0]));
-        DEBUG ((EFI_D_VERBOSE, "sts[1]=0x%x\n", sts->status[1]));
-        DEBUG ((EFI_D_VERBOSE, "sts[2]=0x%x\n", sts->status[2]));
-        Status = EFI_NOT_READY;
-        // wait 1 second and retry, some disk need long time to be ready
-        // and ScsiDisk treat retry over 3 times as error
-        MicroSecondDelay(1000000);
-      }
-       // Update read point
-       WRITE_REG32(base, COMPL_Q_0_RD_PTR + (0x14 * queue), w);
-       // Clear int
-       WRITE_REG32(base, OQ_INT_SRC, BIT(queue));
-       slot->used = FALSE;
-       break;
-    }
+  // Wait for dma complete
+  while (!slot->done) {
+    drain_cq (hba);
+    if (slot->done)
+      break;
     // Wait for status change in polling
     NanoSecondDelay (100);
   }
 
-  if (BufferMap)
-       DmaUnmap (BufferMap);
+  Status = slot->Status;
+  if (Status == EFI_NOT_READY) {
+    // wait 1 second and retry, some disk need long time to be ready
+    // and ScsiDisk treat retry over 3 times as error
+    MicroSecondDelay(1000000);
+  }
 
-  p = (UINT8 *)&sts->status[0];
-  if (p[SENSE_DATA_PRES]) {
-    // Disk not ready normal return for ScsiDiskTestUnitReady do next try
-    SensePtr->Sense_Key = EFI_SCSI_SK_NOT_READY;
-    SensePtr->Addnl_Sense_Code = EFI_SCSI_ASC_NOT_READY;
-    SensePtr->Addnl_Sense_Code_Qualifier = EFI_SCSI_ASCQ_IN_PROGRESS;
+  if (slot->sense) {
     // wait 1 second for disk spin up, refer drivers/scsi/sd.c
     MicroSecondDelay(1000000);
   }
+
+  slot->used = FALSE;
   return Status;
 }
 
@@ -672,7 +786,7 @@ SasV1ExtScsiPassThruFunction (
   SAS_V1_INFO *SasV1Info = SAS_FROM_PASS_THRU(This);
   struct hisi_hba *hba = SasV1Info->hba;
 
-  return prepare_cmd(hba, Packet);
+  return prepare_cmd(hba, Packet, Event);
 }
 
 STATIC
@@ -914,9 +1028,23 @@ SasDriverBindingStart (
   val &= ~SL_CONTROL_NOTIFY_EN;
   PHY_WRITE_REG32(base, SL_CONTROL, phy_id, val);
 
+  // Reap completions of non-blocking requests
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_NOTIFY,
+                  SasV1PollCompletions,
+                  hba,
+                  &SasV1Info->TimerEvent
+                  );
+  ASSERT_EFI_ERROR (Status);
+  Status = gBS->SetTimer (SasV1Info->TimerEvent, TimerPeriodic, SAS_POLL_INTERVAL);
+  ASSERT_EFI_ERROR (Status);
+
   CopyMem (&SasV1Info->ExtScsiPassThru, &SasV1ExtScsiPassThruProtocolTemplate, sizeof (EFI_EXT_SCSI_PASS_THRU_PROTOCOL));
   SasV1Info->ExtScsiPassThruMode.AdapterId = 2;
-  SasV1Info->ExtScsiPassThruMode.Attributes = EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_PHYSICAL | EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL;
+  SasV1Info->ExtScsiPassThruMode.Attributes = EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_PHYSICAL |
+                                              EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL |
+                                              EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_NONBLOCKIO;
   SasV1Info->ExtScsiPassThruMode.IoAlign  = 64; //cache line align
   SasV1Info->ExtScsiPassThru.Mode = &SasV1Info->ExtScsiPassThruMode;
 
@@ -986,6 +1114,7 @@ SasDriverBindingStop (
            Controller
            );
 
+    gBS->SetTimer (SasV1Info->TimerEvent, TimerCancel, 0);
     gBS->CloseEvent (SasV1Info->TimerEvent);
 
     for (i = 0; i < QUEUE_CNT; i++) {
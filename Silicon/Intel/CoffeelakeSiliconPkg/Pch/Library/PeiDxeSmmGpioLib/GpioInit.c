@@ -328,7 +328,7 @@ GpioConfigurePch (
       //
       // Write PADCFG DW0 register
       //
-      MmioAndThenOr32 (
+      GpioMmioAndThenOr32 (
         PCH_PCR_ADDRESS (GpioCom, PadCfgReg),
         ~PadCfgDwRegMask[0],
         PadCfgDwReg[0]
@@ -337,7 +337,7 @@ GpioConfigurePch (
       //
       // Write PADCFG DW1 register
       //
-      MmioAndThenOr32 (
+      GpioMmioAndThenOr32 (
         PCH_PCR_ADDRESS (GpioCom, PadCfgReg + 0x4),
         ~PadCfgDwRegMask[1],
         PadCfgDwReg[1]
@@ -346,7 +346,7 @@ GpioConfigurePch (
       //
       // Write PADCFG DW2 register
       //
-      MmioAndThenOr32 (
+      GpioMmioAndThenOr32 (
         PCH_PCR_ADDRESS (GpioCom, PadCfgReg + 0x8),
         ~PadCfgDwRegMask[2],
         PadCfgDwReg[2]
@@ -370,7 +370,7 @@ GpioConfigurePch (
       // Write HOSTSW_OWN registers
       //
       if (GpioGroupInfo[GroupIndex].HostOwnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioMmioAndThenOr32 (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].HostOwnOffset + DwNum * 0x4),
           ~GroupDwData[DwNum].HostSoftOwnRegMask,
           GroupDwData[DwNum].HostSoftOwnReg
@@ -381,7 +381,7 @@ GpioConfigurePch (
       // Write GPI_GPE_EN registers
       //
       if (GpioGroupInfo[GroupIndex].GpiGpeEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioMmioAndThenOr32 (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].GpiGpeEnOffset + DwNum * 0x4),
           ~GroupDwData[DwNum].GpiGpeEnRegMask,
           GroupDwData[DwNum].GpiGpeEnReg
@@ -392,7 +392,7 @@ GpioConfigurePch (
       // Write GPI_NMI_EN registers
       //
       if (GpioGroupInfo[GroupIndex].NmiEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioMmioAndThenOr32 (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].NmiEnOffset + DwNum * 0x4),
           ~GroupDwData[DwNum].GpiNmiEnRegMask,
           GroupDwData[DwNum].GpiNmiEnReg
@@ -406,7 +406,7 @@ GpioConfigurePch (
       // Write GPI_SMI_EN registers
       //
       if (GpioGroupInfo[GroupIndex].SmiEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioMmioAndThenOr32 (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].SmiEnOffset + DwNum * 0x4),
           ~GroupDwData[DwNum].GpiSmiEnRegMask,
           GroupDwData[DwNum].GpiSmiEnReg
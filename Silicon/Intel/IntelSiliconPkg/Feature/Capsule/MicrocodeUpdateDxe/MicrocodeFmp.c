@@ -762,9 +762,33 @@ InitializeProcessorInfo (
   for (Index = 0; Index < NumberOfProcessors; Index++) {
     MicrocodeFmpPrivate->ProcessorInfo[Index].CpuIndex = Index;
     MicrocodeFmpPrivate->ProcessorInfo[Index].MicrocodeIndex = (UINTN)-1;
-    if (Index == BspIndex) {
-      CollectProcessorInfo (&MicrocodeFmpPrivate->ProcessorInfo[Index]);
-    } else {
+  }
+
+  CollectProcessorInfo (&MicrocodeFmpPrivate->ProcessorInfo[BspIndex]);
+
+  //
+  // Let all APs collect their own information at the same time, instead of
+  // waking them up one by one. Fall back to the serial way if that fails.
+  //
+  if (NumberOfProcessors <= 1) {
+    return EFI_SUCCESS;
+  }
+
+  Status = MpService->StartupAllAPs (
+                        MpService,
+                        CollectProcessorInfoAp,
+                        FALSE,
+                        NULL,
+                        0,
+                        MicrocodeFmpPrivate,
+                        NULL
+                        );
+  if (!EFI_ERROR(Status)) {
+    return EFI_SUCCESS;
+  }
+
+  for (Index = 0; Index < NumberOfProcessors; Index++) {
+    if (Index != BspIndex) {
       Status = MpService->StartupThisAP (
                             MpService,
                             CollectProcessorInfo,
@@ -142,6 +142,19 @@ CollectProcessorInfo (
   IN OUT VOID  *Buffer
   );
 
+/**
+  Collect processor information of the calling processor into the
+  ProcessorInfo entry of its own CPU index.
+  The function prototype for invoking a function on all Application Processors.
+
+  @param[in,out] Buffer  The pointer to the Microcode driver private data.
+**/
+VOID
+EFIAPI
+CollectProcessorInfoAp (
+  IN OUT VOID  *Buffer
+  );
+
 /**
   Get current Microcode information.
 
@@ -178,6 +178,89 @@ FvbGetLbaAddress (
   }
 }
 
+/**
+  Releases the memory copy of a firmware volume, so that all further FVB
+  reads of that volume go to the flash.
+
+  @param[in]  FvbInstance   The pointer to the EFI_FVB_INSTANCE.
+
+**/
+STATIC
+VOID
+FvbFreeShadow (
+  IN EFI_FVB_INSTANCE   *FvbInstance
+  )
+{
+  if (FvbInstance->ShadowBuffer != NULL) {
+    FreePool (FvbInstance->ShadowBuffer);
+    FvbInstance->ShadowBuffer = NULL;
+  }
+}
+
+/**
+  Refreshes a range of the memory copy of a firmware volume from the flash.
+  If the range cannot be read back, the copy is released.
+
+  @param[in]  FvbInstance   The pointer to the EFI_FVB_INSTANCE.
+  @param[in]  Address       Flash address of the range to refresh.
+  @param[in]  Length        Length of the range in bytes.
+
+**/
+STATIC
+VOID
+FvbRefreshShadow (
+  IN EFI_FVB_INSTANCE   *FvbInstance,
+  IN UINTN              Address,
+  IN UINTN              Length
+  )
+{
+  EFI_STATUS            Status;
+  UINT32                NumBytes;
+
+  if (FvbInstance->ShadowBuffer == NULL) {
+    return;
+  }
+
+  NumBytes = (UINT32) Length;
+  Status = SpiFlashRead (
+             Address,
+             &NumBytes,
+             FvbInstance->ShadowBuffer + (Address - FvbInstance->FvBase)
+             );
+  if (EFI_ERROR (Status) || (NumBytes != Length)) {
+    DEBUG ((DEBUG_WARN, "[%a] - Dropping FV shadow at 0x%x - %r.\n", __FUNCTION__, FvbInstance->FvBase, Status));
+    FvbFreeShadow (FvbInstance);
+  }
+}
+
+/**
+  Creates a memory copy of a firmware volume, which is used to serve FVB
+  reads of that volume instead of accessing the flash.
+
+  @param[in]  FvbInstance   The pointer to the EFI_FVB_INSTANCE.
+
+**/
+VOID
+FvbInitializeShadow (
+  IN EFI_FVB_INSTANCE   *FvbInstance
+  )
+{
+  UINT32                FvLength;
+
+  if (FvbInstance->FvHeader.FvLength > MAX_UINT32) {
+    return;
+  }
+  FvLength = (UINT32) FvbInstance->FvHeader.FvLength;
+
+  FvbInstance->ShadowBuffer = AllocatePool (FvLength);
+  if (FvbInstance->ShadowBuffer == NULL) {
+    DEBUG ((DEBUG_WARN, "[%a] - Unable to allocate FV shadow at 0x%x.\n", __FUNCTION__, FvbInstance->FvBase));
+    return;
+  }
+
+  FvbRefreshShadow (FvbInstance, FvbInstance->FvBase, FvLength);
+}
+
 /**
   Reads specified number of bytes into a buffer from the specified block.
 
@@ -249,7 +332,12 @@ FvbReadBlock (
     BadBufferSize = TRUE;
   }
 
-  Status = SpiFlashRead (LbaAddress + BlockOffset, (UINT32 *)NumBytes, Buffer);
+  if (FvbInstance->ShadowBuffer != NULL) {
+    CopyMem (Buffer, FvbInstance->ShadowBuffer + (LbaAddress - FvbInstance->FvBase) + BlockOffset, *NumBytes);
+    Status = EFI_SUCCESS;
+  } else {
+    Status = SpiFlashRead (LbaAddress + BlockOffset, (UINT32 *)NumBytes, Buffer);
+  }
 
   if (!EFI_ERROR (Status) && BadBufferSize) {
     return EFI_BAD_BUFFER_SIZE;
@@ -333,16 +421,23 @@ FvbWriteBlock (
 
   Status = SpiFlashWrite (LbaAddress + BlockOffset, (UINT32 *)NumBytes, Buffer);
   if (EFI_ERROR (Status)) {
+    FvbFreeShadow (FvbInstance);
     return Status;
   }
 
   Status = SpiFlashLock ();
   if (EFI_ERROR (Status)) {
+    FvbFreeShadow (FvbInstance);
     return Status;
   }
 
   WriteBackInvalidateDataCacheRange ((VOID *) (LbaAddress + BlockOffset), *NumBytes);
 
+  //
+  // Read back what actually landed in flash, as programming can only clear bits.
+  //
+  FvbRefreshShadow (FvbInstance, LbaAddress + BlockOffset, *NumBytes);
+
   if (!EFI_ERROR (Status) && BadBufferSize) {
     return EFI_BAD_BUFFER_SIZE;
   } else {
@@ -397,16 +492,22 @@ FvbEraseBlock (
 
   Status = SpiFlashBlockErase (LbaAddress, &LbaLength);
   if (EFI_ERROR (Status)) {
+    FvbFreeShadow (FvbInstance);
     return Status;
   }
 
   Status = SpiFlashLock ();
   if (EFI_ERROR (Status)) {
+    FvbFreeShadow (FvbInstance);
     return Status;
   }
 
   WriteBackInvalidateDataCacheRange ((VOID *) LbaAddress, LbaLength);
 
+  if (FvbInstance->ShadowBuffer != NULL) {
+    SetMem (FvbInstance->ShadowBuffer + (LbaAddress - FvbInstance->FvBase), LbaLength, 0xFF);
+  }
+
   return Status;
 }
 
@@ -52,6 +52,7 @@ typedef struct {
   UINTN                                 NumOfBlocks;
   EFI_DEVICE_PATH_PROTOCOL              *DevicePath;
   EFI_FIRMWARE_VOLUME_BLOCK_PROTOCOL    FvbProtocol;
+  UINT8                                 *ShadowBuffer;
   EFI_FIRMWARE_VOLUME_HEADER            FvHeader;
 } EFI_FVB_INSTANCE;
 
@@ -165,6 +166,18 @@ GetVariableFvInfo (
   OUT UINT32                    *Length
   );
 
+/**
+  Creates a memory copy of a firmware volume, which is used to serve FVB
+  reads of that volume instead of accessing the flash.
+
+  @param[in]  FvbInstance   The pointer to the EFI_FVB_INSTANCE.
+
+**/
+VOID
+FvbInitializeShadow (
+  IN EFI_FVB_INSTANCE   *FvbInstance
+  );
+
 extern FVB_GLOBAL                         mFvbModuleGlobal;
 extern FV_MEMMAP_DEVICE_PATH              mFvMemmapDevicePathTemplate;
 extern FV_PIWG_DEVICE_PATH                mFvPIWGDevicePathTemplate;
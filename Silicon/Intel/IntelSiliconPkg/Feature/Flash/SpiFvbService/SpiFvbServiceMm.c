@@ -288,6 +288,13 @@ FvbInitialize (
         FvbInstance->NumOfBlocks += PtrBlockMapEntry->NumBlocks;
       }
 
+      //
+      // Optionally keep a copy of the variable store in SMRAM
+      //
+      if (FeaturePcdGet (PcdSpiFvbShadowVariableStore) && (Idx == 0)) {
+        FvbInitializeShadow (FvbInstance);
+      }
+
       //
       // Add a FVB Protocol Instance
       //
@@ -166,6 +166,44 @@ ShadowMicrocodePatchWorker (
   return;
 }
 
+/**
+  Add a microcode patch to the patch info buffer if it is not already there.
+
+  The same patch may be selected for several processors, or be listed by more
+  than one FIT entry, but it only needs to be shadowed once.
+
+  @param[in, out]  Patches          The pointer to an array of information on
+                                    the microcode patches that will be loaded
+                                    into memory.
+  @param[in, out]  PatchCount       The number of microcode patches in Patches.
+  @param[in, out]  TotalLoadSize    The total size of the microcode patches in
+                                    Patches.
+  @param[in]       Microcode        The microcode patch to add.
+  @param[in]       MicrocodeSize    The size of the microcode patch.
+**/
+VOID
+AddMicrocodePatch (
+  IN OUT MICROCODE_PATCH_INFO    *Patches,
+  IN OUT UINTN                   *PatchCount,
+  IN OUT UINTN                   *TotalLoadSize,
+  IN     CPU_MICROCODE_HEADER    *Microcode,
+  IN     UINTN                   MicrocodeSize
+  )
+{
+  UINTN                             Index;
+
+  for (Index = 0; Index < *PatchCount; Index++) {
+    if (Patches[Index].Address == (UINTN) Microcode) {
+      return;
+    }
+  }
+
+  Patches[*PatchCount].Address = (UINTN) Microcode;
+  Patches[*PatchCount].Size    = MicrocodeSize;
+  *TotalLoadSize += MicrocodeSize;
+  (*PatchCount)++;
+}
+
 /**
   Check if FIT table content is valid according to FIT BIOS specification.
 
@@ -287,7 +325,9 @@ ShadowMicrocode (
   FIRMWARE_INTERFACE_TABLE_ENTRY    *FitEntry;
   UINT32                            EntryNum;
   UINT32                            Index;
+  UINTN                             CpuIdIndex;
   MICROCODE_PATCH_INFO              *PatchInfoBuffer;
+  CPU_MICROCODE_HEADER              **LatestPatch;
   UINTN                             MaxPatchNumber;
   CPU_MICROCODE_HEADER              *MicrocodeEntryPoint;
   UINTN                             PatchCount;
@@ -332,22 +372,60 @@ ShadowMicrocode (
     CpuIdCount     = 0;
   }
 
+  LatestPatch = NULL;
+  if (CpuIdCount != 0) {
+    LatestPatch = AllocateZeroPool (CpuIdCount * sizeof (CPU_MICROCODE_HEADER *));
+    if (LatestPatch == NULL) {
+      FreePool (PatchInfoBuffer);
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+
   //
   // Fill up microcode patch info buffer according to FIT table.
+  // Only the highest revision patch for each requested processor is shadowed,
+  // since that is the one the processor loads. Older revisions are never used
+  // and copying them from flash is slow.
   //
   PatchCount = 0;
   TotalLoadSize = 0;
   for (Index = 0; Index < EntryNum; Index++) {
-    if (FitEntry[Index].Type == FIT_TYPE_01_MICROCODE) {
-      MicrocodeEntryPoint = (CPU_MICROCODE_HEADER *) (UINTN) FitEntry[Index].Address;
-      TotalSize = GetMicrocodeLength (MicrocodeEntryPoint);
-      if (IsValidMicrocode (MicrocodeEntryPoint, TotalSize, 0, MicrocodeCpuId, CpuIdCount, FALSE)) {
-        PatchInfoBuffer[PatchCount].Address = (UINTN) MicrocodeEntryPoint;
-        PatchInfoBuffer[PatchCount].Size    = TotalSize;
-        TotalLoadSize += TotalSize;
-        PatchCount++;
+    if (FitEntry[Index].Type != FIT_TYPE_01_MICROCODE) {
+      continue;
+    }
+    MicrocodeEntryPoint = (CPU_MICROCODE_HEADER *) (UINTN) FitEntry[Index].Address;
+    TotalSize = GetMicrocodeLength (MicrocodeEntryPoint);
+    if (!IsValidMicrocode (MicrocodeEntryPoint, TotalSize, 0, MicrocodeCpuId, CpuIdCount, FALSE)) {
+      continue;
+    }
+
+    if (CpuIdCount == 0) {
+      AddMicrocodePatch (PatchInfoBuffer, &PatchCount, &TotalLoadSize, MicrocodeEntryPoint, TotalSize);
+      continue;
+    }
+
+    for (CpuIdIndex = 0; CpuIdIndex < CpuIdCount; CpuIdIndex++) {
+      if (((LatestPatch[CpuIdIndex] == NULL) ||
+           ((INT32) MicrocodeEntryPoint->UpdateRevision > (INT32) LatestPatch[CpuIdIndex]->UpdateRevision)) &&
+          IsValidMicrocode (MicrocodeEntryPoint, TotalSize, 0, &MicrocodeCpuId[CpuIdIndex], 1, FALSE)) {
+        LatestPatch[CpuIdIndex] = MicrocodeEntryPoint;
+      }
+    }
+  }
+
+  if (LatestPatch != NULL) {
+    for (CpuIdIndex = 0; CpuIdIndex < CpuIdCount; CpuIdIndex++) {
+      if (LatestPatch[CpuIdIndex] != NULL) {
+        AddMicrocodePatch (
+          PatchInfoBuffer,
+          &PatchCount,
+          &TotalLoadSize,
+          LatestPatch[CpuIdIndex],
+          GetMicrocodeLength (LatestPatch[CpuIdIndex])
+          );
       }
     }
+    FreePool (LatestPatch);
   }
 
   if (PatchCount != 0) {
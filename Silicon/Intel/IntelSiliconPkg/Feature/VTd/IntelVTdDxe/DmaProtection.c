@@ -591,11 +591,10 @@ OnExitBootServices (
 
   DEBUG ((DEBUG_INFO, "Invalidate all\n"));
   for (VtdIndex = 0; VtdIndex < mVtdUnitNumber; VtdIndex++) {
-    FlushWriteBuffer (VtdIndex);
-
-    InvalidateContextCache (VtdIndex);
-
-    InvalidateIOTLB (VtdIndex);
+    StartVtdCacheInvalidation (VtdIndex, TRUE);
+  }
+  for (VtdIndex = 0; VtdIndex < mVtdUnitNumber; VtdIndex++) {
+    WaitVtdCacheInvalidation (VtdIndex);
   }
 
   if ((PcdGet8(PcdVTdPolicyPropertyMask) & BIT1) == 0) {
@@ -78,6 +78,7 @@ typedef struct {
   VTD_SECOND_LEVEL_PAGING_ENTRY    *FixedSecondLevelPagingEntry;
   BOOLEAN                          HasDirtyContext;
   BOOLEAN                          HasDirtyPages;
+  BOOLEAN                          HasNewPages;
   PCI_DEVICE_INFORMATION           PciDeviceInfo;
   BOOLEAN                          Is5LevelPaging;
   UINT8                            EnableQueuedInvalidation;
@@ -128,6 +129,7 @@ extern EFI_ACPI_DMAR_HEADER  *mAcpiDmarTable;
 
 extern UINTN                            mVtdUnitNumber;
 extern VTD_UNIT_INFORMATION             *mVtdUnitInformation;
+extern BOOLEAN                          mVtdEnabled;
 
 extern UINT64                           mBelow4GMemoryLimit;
 extern UINT64                           mAbove4GMemoryLimit;
@@ -219,6 +221,38 @@ InvalidateIOTLB (
   IN UINTN  VtdIndex
   );
 
+/**
+  Start a global invalidation of the VTd IOTLB, and optionally of the context cache.
+
+  With the queued invalidation interface the descriptors are only queued, so that
+  the invalidations of several VTd engines can run at the same time. Call
+  WaitVtdCacheInvalidation to wait for their completion.
+
+  @param[in]  VtdIndex              The index of VTd engine.
+  @param[in]  InvalidateContext     TRUE to also invalidate the context cache.
+
+  @retval EFI_SUCCESS           The invalidation is started or done.
+  @retval EFI_DEVICE_ERROR      The invalidation failed.
+**/
+EFI_STATUS
+StartVtdCacheInvalidation (
+  IN UINTN    VtdIndex,
+  IN BOOLEAN  InvalidateContext
+  );
+
+/**
+  Wait for the invalidation started by StartVtdCacheInvalidation to complete.
+
+  @param[in]  VtdIndex              The index of VTd engine.
+
+  @retval EFI_SUCCESS           The invalidation is done.
+  @retval EFI_DEVICE_ERROR      The invalidation failed.
+**/
+EFI_STATUS
+WaitVtdCacheInvalidation (
+  IN UINTN    VtdIndex
+  );
+
 /**
   Invalid VTd global IOTLB.
 
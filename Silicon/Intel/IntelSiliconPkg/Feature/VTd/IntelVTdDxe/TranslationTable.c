@@ -293,6 +293,24 @@ CreateSecondLevelPagingEntryTable (
 
       Lvl3PtEntry = (VTD_SECOND_LEVEL_PAGING_ENTRY *)(UINTN)VTD_64BITS_ADDRESS(Lvl4PtEntry[Index4].Bits.AddressLo, Lvl4PtEntry[Index4].Bits.AddressHi);
       for (Index3 = Lvl3Start; Index3 <= Lvl3End; Index3++) {
+        //
+        // Map a whole 1GB region with a single entry when the engine supports it,
+        // instead of allocating and filling a full LVL2 table.
+        //
+        if ((Lvl3PtEntry[Index3].Uint64 == 0) &&
+            ((mVtdUnitInformation[VtdIndex].CapReg.Bits.SLLPS & BIT1) != 0) &&
+            ((BaseAddress & (SIZE_1GB - 1)) == 0) &&
+            (BaseAddress + SIZE_1GB <= EndAddress)) {
+          Lvl3PtEntry[Index3].Uint64 = BaseAddress;
+          SetSecondLevelPagingEntryAttribute (&Lvl3PtEntry[Index3], IoMmuAccess);
+          Lvl3PtEntry[Index3].Bits.PageSize = 1;
+          BaseAddress += SIZE_1GB;
+          if (BaseAddress >= MemoryLimit) {
+            break;
+          }
+          continue;
+        }
+
         if (Lvl3PtEntry[Index3].Uint64 == 0) {
           Lvl3PtEntry[Index3].Uint64 = (UINT64)(UINTN)AllocateZeroPages (1);
           if (Lvl3PtEntry[Index3].Uint64 == 0) {
@@ -513,6 +531,9 @@ DumpSecondLevelPagingEntry (
         if (Lvl3PtEntry[Index3].Uint64 == 0) {
           continue;
         }
+        if (Lvl3PtEntry[Index3].Bits.PageSize != 0) {
+          continue;
+        }
 
         Lvl2PtEntry = (VTD_SECOND_LEVEL_PAGING_ENTRY *)(UINTN)VTD_64BITS_ADDRESS(Lvl3PtEntry[Index3].Bits.AddressLo, Lvl3PtEntry[Index3].Bits.AddressHi);
         for (Index2 = 0; Index2 < SIZE_4KB/sizeof(VTD_SECOND_LEVEL_PAGING_ENTRY); Index2++) {
@@ -549,9 +570,16 @@ InvalidatePageEntry (
 {
   if (mVtdUnitInformation[VtdIndex].HasDirtyContext || mVtdUnitInformation[VtdIndex].HasDirtyPages) {
     InvalidateVtdIOTLBGlobal (VtdIndex);
+  } else if (mVtdUnitInformation[VtdIndex].HasNewPages && mVtdEnabled) {
+    //
+    // Only not-present entries were made present. They can not be cached
+    // by the IOTLB, so flushing the write buffer is enough.
+    //
+    FlushWriteBuffer (VtdIndex);
   }
   mVtdUnitInformation[VtdIndex].HasDirtyContext = FALSE;
   mVtdUnitInformation[VtdIndex].HasDirtyPages = FALSE;
+  mVtdUnitInformation[VtdIndex].HasNewPages = FALSE;
 }
 
 #define VTD_PG_R                   BIT0
@@ -564,6 +592,8 @@ InvalidatePageEntry (
 
 #define PAGE_PROGATE_BITS          (VTD_PG_TM | VTD_PG_EMT | VTD_PG_W | VTD_PG_R)
 
+#define IS_VTD_PG_PRESENT(Entry)    (((Entry) & (VTD_PG_W | VTD_PG_R)) != 0)
+
 #define PAGING_4K_MASK  0xFFF
 #define PAGING_2M_MASK  0x1FFFFF
 #define PAGING_1G_MASK  0x3FFFFFFF
@@ -868,6 +898,29 @@ SplitSecondLevelPage (
   }
 }
 
+/**
+  Record that a second level page entry was modified.
+
+  A VTd engine without Caching Mode never caches not-present entries, so
+  making a not-present entry present does not need an IOTLB invalidation.
+  Any other change does.
+
+  @param[in]  VtdIndex         The index used to identify a VTd engine.
+  @param[in]  WasPresent       TRUE if the page entry was present before it was modified.
+**/
+VOID
+MarkSecondLevelPageEntryModified (
+  IN UINTN                             VtdIndex,
+  IN BOOLEAN                           WasPresent
+  )
+{
+  if (WasPresent || (mVtdUnitInformation[VtdIndex].CapReg.Bits.CM != 0)) {
+    mVtdUnitInformation[VtdIndex].HasDirtyPages = TRUE;
+  } else {
+    mVtdUnitInformation[VtdIndex].HasNewPages = TRUE;
+  }
+}
+
 /**
   Set VTd attribute for a system memory on second level page entry
 
@@ -904,6 +957,7 @@ SetSecondLevelPagingAttribute (
   PAGE_ATTRIBUTE                 SplitAttribute;
   EFI_STATUS                     Status;
   BOOLEAN                        IsEntryModified;
+  BOOLEAN                        WasPresent;
 
   DEBUG ((DEBUG_VERBOSE,"SetSecondLevelPagingAttribute (%d) (0x%016lx - 0x%016lx : %x) \n", VtdIndex, BaseAddress, Length, IoMmuAccess));
   DEBUG ((DEBUG_VERBOSE,"  SecondLevelPagingEntry Base - 0x%x\n", SecondLevelPagingEntry));
@@ -925,10 +979,11 @@ SetSecondLevelPagingAttribute (
     }
     PageEntryLength = PageAttributeToLength (PageAttribute);
     SplitAttribute = NeedSplitPage (BaseAddress, Length, PageAttribute);
+    WasPresent = IS_VTD_PG_PRESENT (PageEntry->Uint64);
     if (SplitAttribute == PageNone) {
       ConvertSecondLevelPageEntryAttribute (VtdIndex, PageEntry, IoMmuAccess, &IsEntryModified);
       if (IsEntryModified) {
-        mVtdUnitInformation[VtdIndex].HasDirtyPages = TRUE;
+        MarkSecondLevelPageEntryModified (VtdIndex, WasPresent);
       }
       //
       // Convert success, move to next
@@ -941,7 +996,7 @@ SetSecondLevelPagingAttribute (
         DEBUG ((DEBUG_ERROR, "SplitSecondLevelPage - %r\n", Status));
         return RETURN_UNSUPPORTED;
       }
-      mVtdUnitInformation[VtdIndex].HasDirtyPages = TRUE;
+      MarkSecondLevelPageEntryModified (VtdIndex, WasPresent);
       //
       // Just split current page
       // Convert success in next around
@@ -209,33 +209,20 @@ QueuedInvalidationCheckFault (
 }
 
 /**
-  Submit the queued invalidation descriptor to the remapping
-   hardware unit and wait for its completion.
+  Put a queued invalidation descriptor in the invalidation queue.
+  The hardware is not told about it until CommitQueuedInvalidationDescriptors is called.
 
   @param[in]  VtdIndex          The index used to identify a VTd engine.
   @param[in]  Desc              The invalidate descriptor
-
-  @retval EFI_SUCCESS           The operation was successful.
-  @retval RETURN_DEVICE_ERROR   A fault is detected.
-  @retval EFI_INVALID_PARAMETER Parameter is invalid.
 **/
-EFI_STATUS
-SubmitQueuedInvalidationDescriptor (
+VOID
+PostQueuedInvalidationDescriptor (
   IN UINTN    VtdIndex,
   IN QI_DESC  *Desc
   )
 {
-  EFI_STATUS Status;
-  UINT16     QiDescLength;
   QI_DESC    *BaseDesc;
-  UINT64     Reg64Iqt;
-  UINT64     Reg64Iqh;
-
-  if (Desc == NULL) {
-    return EFI_INVALID_PARAMETER;
-  }
 
-  QiDescLength = mVtdUnitInformation[VtdIndex].QiDescLength;
   BaseDesc = mVtdUnitInformation[VtdIndex].QiDesc;
 
   DEBUG((DEBUG_VERBOSE, "[%d] Submit QI Descriptor [0x%08x, 0x%08x] Free Head (%d)\n", VtdIndex, Desc->Low, Desc->High, mVtdUnitInformation[VtdIndex].QiFreeHead));
@@ -244,13 +231,44 @@ SubmitQueuedInvalidationDescriptor (
   BaseDesc[mVtdUnitInformation[VtdIndex].QiFreeHead].High = Desc->High;
   FlushPageTableMemory(VtdIndex, (UINTN) &BaseDesc[mVtdUnitInformation[VtdIndex].QiFreeHead], sizeof(QI_DESC));
 
-  mVtdUnitInformation[VtdIndex].QiFreeHead = (mVtdUnitInformation[VtdIndex].QiFreeHead + 1) % QiDescLength;
+  mVtdUnitInformation[VtdIndex].QiFreeHead = (mVtdUnitInformation[VtdIndex].QiFreeHead + 1) % mVtdUnitInformation[VtdIndex].QiDescLength;
+}
 
-  //
-  // Update the HW tail register indicating the presence of new descriptors.
-  //
-  Reg64Iqt = mVtdUnitInformation[VtdIndex].QiFreeHead << DMAR_IQ_SHIFT;
-  MmioWrite64 (mVtdUnitInformation[VtdIndex].VtdUnitBaseAddress + R_IQT_REG, Reg64Iqt);
+/**
+  Update the HW tail register indicating the presence of new descriptors.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+**/
+VOID
+CommitQueuedInvalidationDescriptors (
+  IN UINTN    VtdIndex
+  )
+{
+  MmioWrite64 (
+    mVtdUnitInformation[VtdIndex].VtdUnitBaseAddress + R_IQT_REG,
+    mVtdUnitInformation[VtdIndex].QiFreeHead << DMAR_IQ_SHIFT
+    );
+}
+
+/**
+  Wait for the remapping hardware unit to process all the committed
+  queued invalidation descriptors.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+
+  @retval EFI_SUCCESS           The operation was successful.
+  @retval RETURN_DEVICE_ERROR   A fault is detected.
+**/
+EFI_STATUS
+WaitQueuedInvalidationDescriptors (
+  IN UINTN    VtdIndex
+  )
+{
+  EFI_STATUS Status;
+  UINT64     Reg64Iqt;
+  UINT64     Reg64Iqh;
+
+  Reg64Iqt = MmioRead64 (mVtdUnitInformation[VtdIndex].VtdUnitBaseAddress + R_IQT_REG);
 
   Status = EFI_SUCCESS;
   do {
@@ -266,6 +284,65 @@ SubmitQueuedInvalidationDescriptor (
   return Status;
 }
 
+/**
+  Submit the queued invalidation descriptor to the remapping
+   hardware unit and wait for its completion.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+  @param[in]  Desc              The invalidate descriptor
+
+  @retval EFI_SUCCESS           The operation was successful.
+  @retval RETURN_DEVICE_ERROR   A fault is detected.
+  @retval EFI_INVALID_PARAMETER Parameter is invalid.
+**/
+EFI_STATUS
+SubmitQueuedInvalidationDescriptor (
+  IN UINTN    VtdIndex,
+  IN QI_DESC  *Desc
+  )
+{
+  if (Desc == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  PostQueuedInvalidationDescriptor (VtdIndex, Desc);
+  CommitQueuedInvalidationDescriptors (VtdIndex);
+
+  return WaitQueuedInvalidationDescriptors (VtdIndex);
+}
+
+/**
+  Get the queued invalidation descriptor for a global context cache invalidation.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+  @param[out] QiDesc            The invalidate descriptor
+**/
+VOID
+GetContextCacheInvalidationDescriptor (
+  IN  UINTN    VtdIndex,
+  OUT QI_DESC  *QiDesc
+  )
+{
+  QiDesc->Low = QI_CC_FM(0) | QI_CC_SID(0) | QI_CC_DID(0) | QI_CC_GRAN(1) | QI_CC_TYPE;
+  QiDesc->High = 0;
+}
+
+/**
+  Get the queued invalidation descriptor for a global IOTLB invalidation.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+  @param[out] QiDesc            The invalidate descriptor
+**/
+VOID
+GetIOTLBInvalidationDescriptor (
+  IN  UINTN    VtdIndex,
+  OUT QI_DESC  *QiDesc
+  )
+{
+  QiDesc->Low = QI_IOTLB_DID(0) | QI_IOTLB_DR(CAP_READ_DRAIN(mVtdUnitInformation[VtdIndex].CapReg.Uint64)) | QI_IOTLB_DW(CAP_WRITE_DRAIN(mVtdUnitInformation[VtdIndex].CapReg.Uint64)) | QI_IOTLB_GRAN(1) | QI_IOTLB_TYPE;
+  QiDesc->High = QI_IOTLB_ADDR(0) | QI_IOTLB_IH(0) | QI_IOTLB_AM(0);
+}
+
 /**
   Invalidate VTd context cache.
 
@@ -300,8 +377,7 @@ InvalidateContextCache (
     //
     // Queued Invalidation
     //
-    QiDesc.Low = QI_CC_FM(0) | QI_CC_SID(0) | QI_CC_DID(0) | QI_CC_GRAN(1) | QI_CC_TYPE;
-    QiDesc.High = 0;
+    GetContextCacheInvalidationDescriptor (VtdIndex, &QiDesc);
 
     return SubmitQueuedInvalidationDescriptor(VtdIndex, &QiDesc);
   }
@@ -342,8 +418,7 @@ InvalidateIOTLB (
     //
     // Queued Invalidation
     //
-    QiDesc.Low = QI_IOTLB_DID(0) | QI_IOTLB_DR(CAP_READ_DRAIN(mVtdUnitInformation[VtdIndex].CapReg.Uint64)) | QI_IOTLB_DW(CAP_WRITE_DRAIN(mVtdUnitInformation[VtdIndex].CapReg.Uint64)) | QI_IOTLB_GRAN(1) | QI_IOTLB_TYPE;
-    QiDesc.High = QI_IOTLB_ADDR(0) | QI_IOTLB_IH(0) | QI_IOTLB_AM(0);
+    GetIOTLBInvalidationDescriptor (VtdIndex, &QiDesc);
 
     return SubmitQueuedInvalidationDescriptor(VtdIndex, &QiDesc);
   }
@@ -351,6 +426,88 @@ InvalidateIOTLB (
   return EFI_SUCCESS;
 }
 
+/**
+  Start a global invalidation of the VTd IOTLB, and optionally of the context cache.
+
+  With the queued invalidation interface the descriptors are only queued, so that
+  the invalidations of several VTd engines can run at the same time. Call
+  WaitVtdCacheInvalidation to wait for their completion.
+
+  @param[in]  VtdIndex              The index of VTd engine.
+  @param[in]  InvalidateContext     TRUE to also invalidate the context cache.
+
+  @retval EFI_SUCCESS           The invalidation is started or done.
+  @retval EFI_DEVICE_ERROR      The invalidation failed.
+**/
+EFI_STATUS
+StartVtdCacheInvalidation (
+  IN UINTN    VtdIndex,
+  IN BOOLEAN  InvalidateContext
+  )
+{
+  EFI_STATUS Status;
+  QI_DESC    QiDesc;
+
+  //
+  // Write Buffer Flush before invalidation
+  //
+  FlushWriteBuffer (VtdIndex);
+
+  if (mVtdUnitInformation[VtdIndex].EnableQueuedInvalidation == 0) {
+    //
+    // Register-based Invalidation
+    //
+    if (InvalidateContext) {
+      Status = InvalidateContextCache (VtdIndex);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+    return InvalidateIOTLB (VtdIndex);
+  }
+
+  //
+  // Queued Invalidation
+  // The fence makes the IOTLB invalidation start only after the context cache
+  // invalidation completed.
+  //
+  if (InvalidateContext) {
+    GetContextCacheInvalidationDescriptor (VtdIndex, &QiDesc);
+    PostQueuedInvalidationDescriptor (VtdIndex, &QiDesc);
+
+    QiDesc.Low = QI_IWD_FENCE | QI_IWD_TYPE;
+    QiDesc.High = 0;
+    PostQueuedInvalidationDescriptor (VtdIndex, &QiDesc);
+  }
+
+  GetIOTLBInvalidationDescriptor (VtdIndex, &QiDesc);
+  PostQueuedInvalidationDescriptor (VtdIndex, &QiDesc);
+
+  CommitQueuedInvalidationDescriptors (VtdIndex);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Wait for the invalidation started by StartVtdCacheInvalidation to complete.
+
+  @param[in]  VtdIndex              The index of VTd engine.
+
+  @retval EFI_SUCCESS           The invalidation is done.
+  @retval EFI_DEVICE_ERROR      The invalidation failed.
+**/
+EFI_STATUS
+WaitVtdCacheInvalidation (
+  IN UINTN    VtdIndex
+  )
+{
+  if (mVtdUnitInformation[VtdIndex].EnableQueuedInvalidation == 0) {
+    return EFI_SUCCESS;
+  }
+
+  return WaitQueuedInvalidationDescriptors (VtdIndex);
+}
+
 /**
   Invalid VTd global IOTLB.
 
@@ -364,32 +521,31 @@ InvalidateVtdIOTLBGlobal (
   IN UINTN  VtdIndex
   )
 {
+  EFI_STATUS Status;
+
   if (!mVtdEnabled) {
     return EFI_SUCCESS;
   }
 
   DEBUG((DEBUG_VERBOSE, "InvalidateVtdIOTLBGlobal(%d)\n", VtdIndex));
 
-  //
-  // Write Buffer Flush before invalidation
-  //
-  FlushWriteBuffer (VtdIndex);
-
-  //
-  // Invalidate the context cache
-  //
-  if (mVtdUnitInformation[VtdIndex].HasDirtyContext) {
-    InvalidateContextCache (VtdIndex);
+  if (!mVtdUnitInformation[VtdIndex].HasDirtyContext && !mVtdUnitInformation[VtdIndex].HasDirtyPages) {
+    //
+    // Write Buffer Flush
+    //
+    FlushWriteBuffer (VtdIndex);
+    return EFI_SUCCESS;
   }
 
   //
-  // Invalidate the IOTLB cache
+  // Invalidate the context cache if needed, and the IOTLB cache
   //
-  if (mVtdUnitInformation[VtdIndex].HasDirtyContext || mVtdUnitInformation[VtdIndex].HasDirtyPages) {
-    InvalidateIOTLB (VtdIndex);
+  Status = StartVtdCacheInvalidation (VtdIndex, mVtdUnitInformation[VtdIndex].HasDirtyContext);
+  if (!EFI_ERROR (Status)) {
+    Status = WaitVtdCacheInvalidation (VtdIndex);
   }
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 /**
@@ -514,19 +670,14 @@ EnableDmar (
     Reg32 = MmioRead32 (mVtdUnitInformation[Index].VtdUnitBaseAddress + R_FEDATA_REG);
 
     //
-    // Write Buffer Flush before invalidation
-    //
-    FlushWriteBuffer (Index);
-
-    //
-    // Invalidate the context cache
+    // Invalidate the context cache and the IOTLB cache.
+    // Queued invalidations of all the engines run at the same time.
     //
-    InvalidateContextCache (Index);
+    StartVtdCacheInvalidation (Index, TRUE);
+  }
 
-    //
-    // Invalidate the IOTLB cache
-    //
-    InvalidateIOTLB (Index);
+  for (Index = 0; Index < mVtdUnitNumber; Index++) {
+    WaitVtdCacheInvalidation (Index);
 
     //
     // Enable VTd
@@ -287,6 +287,7 @@ typedef union {
 
 #define QI_IWD_STATUS_DATA(d)   (((UINT64)d) << 32)
 #define QI_IWD_STATUS_WRITE (((UINT64)1) << 5)
+#define QI_IWD_FENCE        (((UINT64)1) << 6)
 
 //
 // This is the queued invalidate descriptor.
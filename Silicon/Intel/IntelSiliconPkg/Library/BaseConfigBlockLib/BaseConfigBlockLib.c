@@ -7,10 +7,158 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 #include <ConfigBlock.h>
 #include <Library/ConfigBlockLib.h>
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 
+//
+// GetConfigBlock() looks blocks up in a hash index kept at the very end of
+// the table, in the space AvailableSize still counts as free, so the blocks
+// and the header keep the layout every other user of the table expects.
+// Rsvd0 of the table header holds the number of slots, a power of two, or 0
+// when there is no index. The index is the count of blocks it holds followed
+// by the slots, each the offset of a block from the start of the table or 0.
+// It is only trusted while AvailableSize still covers it, and a miss is only
+// trusted while it holds every block; otherwise the table is walked.
+//
+#define CONFIG_BLOCK_INDEX_MIN_SLOTS  16
+
+/**
+  Get the hash index of a config block table.
+
+  @param[in]     ConfigBlkTblAddrPtr          - A pointer to the beginning of Config Block Table Address
+  @param[out]    Slots                        - On return, the number of slots of the index
+
+  @retval NULL   - The table has no usable index
+  @retval Others - Pointer to the index
+**/
+STATIC
+UINT16 *
+ConfigBlockIndex (
+  IN     CONFIG_BLOCK_TABLE_HEADER *ConfigBlkTblAddrPtr,
+  OUT    UINT16                    *Slots
+  )
+{
+  UINT16  Capacity;
+  UINT32  IndexSize;
+
+  Capacity  = ReadUnaligned16 ((UINT16 *)ConfigBlkTblAddrPtr->Rsvd0);
+  IndexSize = ((UINT32)Capacity + 1) * sizeof (UINT16);
+  if ((Capacity == 0) || (ConfigBlkTblAddrPtr->AvailableSize < IndexSize)) {
+    return NULL;
+  }
+
+  *Slots = Capacity;
+  return (UINT16 *)((UINTN)ConfigBlkTblAddrPtr + ConfigBlkTblAddrPtr->Header.GuidHob.Header.HobLength - IndexSize);
+}
+
+/**
+  Get the first index slot to probe for a config block GUID.
+
+  @param[in]     ConfigBlockGuid              - A pointer to the GUID of the Config Block
+  @param[in]     Slots                        - Number of slots of the index, a power of two
+
+  @retval The slot number
+**/
+STATIC
+UINT16
+ConfigBlockIndexSlot (
+  IN     CONST EFI_GUID  *ConfigBlockGuid,
+  IN     UINT16          Slots
+  )
+{
+  UINT32  Hash;
+
+  Hash = ReadUnaligned32 ((CONST UINT32 *)ConfigBlockGuid) ^
+         ReadUnaligned32 ((CONST UINT32 *)ConfigBlockGuid + 1) ^
+         ReadUnaligned32 ((CONST UINT32 *)ConfigBlockGuid + 2) ^
+         ReadUnaligned32 ((CONST UINT32 *)ConfigBlockGuid + 3);
+  Hash *= 0x9E3779B1;
+
+  return (UINT16)((Hash >> 16) & (Slots - 1));
+}
+
+/**
+  Add a config block to the hash index.
+
+  @param[in]     ConfigBlkTblAddrPtr          - A pointer to the beginning of Config Block Table Address
+  @param[in]     Index                        - A pointer to the index
+  @param[in]     Slots                        - Number of slots of the index
+  @param[in]     ConfigBlkOffset              - Offset of the Config Block from the start of the table
+**/
+STATIC
+VOID
+ConfigBlockIndexInsert (
+  IN     CONFIG_BLOCK_TABLE_HEADER *ConfigBlkTblAddrPtr,
+  IN     UINT16                    *Index,
+  IN     UINT16                    Slots,
+  IN     UINT16                    ConfigBlkOffset
+  )
+{
+  CONFIG_BLOCK  *ConfigBlk;
+  UINT16        Slot;
+
+  ConfigBlk = (CONFIG_BLOCK *)((UINTN)ConfigBlkTblAddrPtr + ConfigBlkOffset);
+  Slot = ConfigBlockIndexSlot (&ConfigBlk->Header.GuidHob.Name, Slots);
+  while (ReadUnaligned16 (&Index[1 + Slot]) != 0) {
+    Slot = (Slot + 1) & (Slots - 1);
+  }
+
+  WriteUnaligned16 (&Index[1 + Slot], ConfigBlkOffset);
+  WriteUnaligned16 (&Index[0], ReadUnaligned16 (&Index[0]) + 1);
+}
+
+/**
+  Build the hash index of a config block table from scratch.
+
+  @param[in]     ConfigBlkTblAddrPtr          - A pointer to the beginning of Config Block Table Address
+  @param[in]     Slots                        - Number of slots of the new index, 0 to remove the index.
+                                                The caller checked that AvailableSize covers it.
+**/
+STATIC
+VOID
+ConfigBlockIndexBuild (
+  IN     CONFIG_BLOCK_TABLE_HEADER *ConfigBlkTblAddrPtr,
+  IN     UINT16                    Slots
+  )
+{
+  UINT16        *Index;
+  UINT16        OffsetIndex;
+  UINT32        ConfigBlkOffset;
+  UINT32        ConfigBlkEnd;
+  CONFIG_BLOCK  *TempConfigBlk;
+  UINT16        OldSlots;
+
+  //
+  // Blocks added later expect the free space to be zeroed.
+  //
+  Index = ConfigBlockIndex (ConfigBlkTblAddrPtr, &OldSlots);
+  if (Index != NULL) {
+    ZeroMem (Index, ((UINTN)OldSlots + 1) * sizeof (UINT16));
+  }
+
+  WriteUnaligned16 ((UINT16 *)ConfigBlkTblAddrPtr->Rsvd0, Slots);
+  if (Slots == 0) {
+    return;
+  }
+
+  Index = ConfigBlockIndex (ConfigBlkTblAddrPtr, &Slots);
+  ASSERT (Index != NULL);
+  ZeroMem (Index, ((UINTN)Slots + 1) * sizeof (UINT16));
+
+  ConfigBlkOffset = sizeof (CONFIG_BLOCK_TABLE_HEADER);
+  ConfigBlkEnd    = ConfigBlkTblAddrPtr->Header.GuidHob.Header.HobLength - ConfigBlkTblAddrPtr->AvailableSize;
+  for (OffsetIndex = 0; OffsetIndex < ConfigBlkTblAddrPtr->NumberOfBlocks; OffsetIndex++) {
+    if ((ConfigBlkOffset + sizeof (CONFIG_BLOCK_HEADER)) > ConfigBlkEnd) {
+      break;
+    }
+    ConfigBlockIndexInsert (ConfigBlkTblAddrPtr, Index, Slots, (UINT16)ConfigBlkOffset);
+    TempConfigBlk = (CONFIG_BLOCK *)((UINTN)ConfigBlkTblAddrPtr + ConfigBlkOffset);
+    ConfigBlkOffset = ConfigBlkOffset + TempConfigBlk->Header.GuidHob.Header.HobLength;
+  }
+}
+
 /**
   Create config block table.
 
@@ -71,6 +219,9 @@ AddConfigBlock (
   CONFIG_BLOCK_TABLE_HEADER *ConfigBlkTblAddrPtr;
   CONFIG_BLOCK              *ConfigBlkAddrPtr;
   UINT16                    ConfigBlkSize;
+  UINT16                    *Index;
+  UINT16                    Slots;
+  UINT16                    Indexed;
 
   ConfigBlkTblAddrPtr = (CONFIG_BLOCK_TABLE_HEADER *)ConfigBlockTableAddress;
   ConfigBlkAddrPtr = (CONFIG_BLOCK *)(*ConfigBlockAddress);
@@ -83,12 +234,46 @@ AddConfigBlock (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  //
+  // The block may take the space of the index, which is then dropped.
+  //
+  Index = ConfigBlockIndex (ConfigBlkTblAddrPtr, &Slots);
+  if ((Index != NULL) && (ConfigBlkTblAddrPtr->AvailableSize - ConfigBlkSize < ((UINT32)Slots + 1) * sizeof (UINT16))) {
+    ConfigBlockIndexBuild (ConfigBlkTblAddrPtr, 0);
+    Index = NULL;
+  }
+  Indexed = (Index != NULL) ? ReadUnaligned16 (&Index[0]) : 0;
+
   TempConfigBlk = (CONFIG_BLOCK *)((UINTN)ConfigBlkTblAddrPtr + (UINTN)(ConfigBlkTblAddrPtr->Header.GuidHob.Header.HobLength - ConfigBlkTblAddrPtr->AvailableSize));
   CopyMem (&TempConfigBlk->Header, &ConfigBlkAddrPtr->Header, sizeof(CONFIG_BLOCK_HEADER));
 
   ConfigBlkTblAddrPtr->NumberOfBlocks++;
   ConfigBlkTblAddrPtr->AvailableSize = ConfigBlkTblAddrPtr->AvailableSize - ConfigBlkSize;
 
+  //
+  // Keep the index at most half full, doubling it while the free space allows.
+  // It is rebuilt when it is missing blocks, e.g. added by another copy of
+  // this library that did not know about it.
+  //
+  if ((Index == NULL) || (Indexed + 1 != ConfigBlkTblAddrPtr->NumberOfBlocks) || ((UINT32)Indexed + 1 > Slots / 2)) {
+    Slots = (Index == NULL) ? CONFIG_BLOCK_INDEX_MIN_SLOTS : Slots;
+    while ((UINT32)ConfigBlkTblAddrPtr->NumberOfBlocks > Slots / 2) {
+      Slots = Slots * 2;
+    }
+    if (ConfigBlkTblAddrPtr->AvailableSize >= ((UINT32)Slots + 1) * sizeof (UINT16)) {
+      ConfigBlockIndexBuild (ConfigBlkTblAddrPtr, Slots);
+    } else {
+      ConfigBlockIndexBuild (ConfigBlkTblAddrPtr, 0);
+    }
+  } else {
+    ConfigBlockIndexInsert (
+      ConfigBlkTblAddrPtr,
+      Index,
+      Slots,
+      (UINT16)((UINTN)TempConfigBlk - (UINTN)ConfigBlkTblAddrPtr)
+      );
+  }
+
   *ConfigBlockAddress = (VOID *) TempConfigBlk;
   return EFI_SUCCESS;
 }
@@ -117,11 +302,42 @@ GetConfigBlock (
   UINT32                    ConfigBlkTblHdrSize;
   UINT32                    ConfigBlkOffset;
   UINT16                    NumOfBlocks;
+  UINT16                    *Index;
+  UINT16                    Slots;
+  UINT16                    Slot;
+  UINT16                    Probes;
+  UINT32                    ConfigBlkEnd;
 
   ConfigBlkTblHdrSize = (UINT32)(sizeof (CONFIG_BLOCK_TABLE_HEADER));
   ConfigBlkTblAddrPtr = (CONFIG_BLOCK_TABLE_HEADER *)ConfigBlockTableAddress;
   NumOfBlocks = ConfigBlkTblAddrPtr->NumberOfBlocks;
 
+  Index = ConfigBlockIndex (ConfigBlkTblAddrPtr, &Slots);
+  if (Index != NULL) {
+    ConfigBlkEnd = ConfigBlkTblAddrPtr->Header.GuidHob.Header.HobLength - ConfigBlkTblAddrPtr->AvailableSize;
+    Slot = ConfigBlockIndexSlot (ConfigBlockGuid, Slots);
+    for (Probes = 0; Probes < Slots; Probes++) {
+      ConfigBlkOffset = ReadUnaligned16 (&Index[1 + Slot]);
+      if (ConfigBlkOffset == 0) {
+        break;
+      }
+      if ((ConfigBlkOffset >= ConfigBlkTblHdrSize) && ((ConfigBlkOffset + sizeof (CONFIG_BLOCK_HEADER)) <= ConfigBlkEnd)) {
+        TempConfigBlk = (CONFIG_BLOCK *)((UINTN)ConfigBlkTblAddrPtr + (UINTN)ConfigBlkOffset);
+        if (CompareGuid (&(TempConfigBlk->Header.GuidHob.Name), ConfigBlockGuid)) {
+          *ConfigBlockAddress = (VOID *)TempConfigBlk;
+          return EFI_SUCCESS;
+        }
+      }
+      Slot = (Slot + 1) & (Slots - 1);
+    }
+    //
+    // The index holds every block, so the table doesn't need to be walked.
+    //
+    if (ReadUnaligned16 (&Index[0]) == NumOfBlocks) {
+      return EFI_NOT_FOUND;
+    }
+  }
+
   ConfigBlkOffset = 0;
   for (OffsetIndex = 0; OffsetIndex < NumOfBlocks; OffsetIndex++) {
     if ((ConfigBlkTblHdrSize + ConfigBlkOffset) > (ConfigBlkTblAddrPtr->Header.GuidHob.Header.HobLength)) {
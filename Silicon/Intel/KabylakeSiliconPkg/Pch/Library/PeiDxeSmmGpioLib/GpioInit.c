@@ -293,7 +293,7 @@ GpioConfigureSklPch (
       //
       // Write PADCFG DW0 register
       //
-      MmioAndThenOr32 (
+      GpioMmioAndThenOr32 (
         PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, PadCfgReg),
         ~PadCfgDwRegMask[0],
         PadCfgDwReg[0]
@@ -302,7 +302,7 @@ GpioConfigureSklPch (
       //
       // Write PADCFG DW1 register
       //
-      MmioAndThenOr32 (
+      GpioMmioAndThenOr32 (
         PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, PadCfgReg + 0x4),
         ~PadCfgDwRegMask[1],
         PadCfgDwReg[1]
@@ -326,7 +326,7 @@ GpioConfigureSklPch (
       // Write HOSTSW_OWN registers
       //
       if (GpioGroupInfo[GroupIndex].HostOwnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioMmioAndThenOr32 (
           PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, GpioGroupInfo[GroupIndex].HostOwnOffset + DwNum * 0x4),
           ~DwRegsValues[DwNum].HostSoftOwnRegMask,
           DwRegsValues[DwNum].HostSoftOwnReg
@@ -337,7 +337,7 @@ GpioConfigureSklPch (
       // Write GPI_GPE_EN registers
       //
       if (GpioGroupInfo[GroupIndex].GpiGpeEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioMmioAndThenOr32 (
           PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, GpioGroupInfo[GroupIndex].GpiGpeEnOffset + DwNum * 0x4),
           ~DwRegsValues[DwNum].GpiGpeEnRegMask,
           DwRegsValues[DwNum].GpiGpeEnReg
@@ -348,7 +348,7 @@ GpioConfigureSklPch (
       // Write GPI_NMI_EN registers
       //
       if (GpioGroupInfo[GroupIndex].NmiEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioMmioAndThenOr32 (
           PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, GpioGroupInfo[GroupIndex].NmiEnOffset + DwNum * 0x4),
           ~DwRegsValues[DwNum].GpiNmiEnRegMask,
           DwRegsValues[DwNum].GpiNmiEnReg
@@ -7,6 +7,36 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 #include "GpioLibrary.h"
 
+/**
+  This procedure will read-modify-write a GPIO register.
+  Register is not accessed if AND and OR masks leave it unchanged
+  and it is not written back if it already holds the target value.
+
+  @param[in]  Address                   GPIO register address
+  @param[in]  AndData                   Mask which will be AND'ed with register value
+  @param[in]  OrData                    Mask which will be OR'ed with register value
+**/
+VOID
+GpioMmioAndThenOr32 (
+  IN UINTN               Address,
+  IN UINT32              AndData,
+  IN UINT32              OrData
+  )
+{
+  UINT32  Data32;
+  UINT32  NewData32;
+
+  if ((AndData == MAX_UINT32) && (OrData == 0)) {
+    return;
+  }
+
+  Data32    = MmioRead32 (Address);
+  NewData32 = (Data32 & AndData) | OrData;
+  if (NewData32 != Data32) {
+    MmioWrite32 (Address, NewData32);
+  }
+}
+
 /**
   This procedure will check if GpioPad is owned by host.
 
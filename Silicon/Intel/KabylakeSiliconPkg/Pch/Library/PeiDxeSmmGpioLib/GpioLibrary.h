@@ -318,4 +318,20 @@ GpioPadCfgRegValueFromGpioConfig (
   OUT UINT32             *PadCfgDwReg,
   OUT UINT32             *PadCfgDwRegMask
   );
+/**
+  This procedure will read-modify-write a GPIO register.
+  Register is not accessed if AND and OR masks leave it unchanged
+  and it is not written back if it already holds the target value.
+
+  @param[in]  Address                   GPIO register address
+  @param[in]  AndData                   Mask which will be AND'ed with register value
+  @param[in]  OrData                    Mask which will be OR'ed with register value
+**/
+VOID
+GpioMmioAndThenOr32 (
+  IN UINTN               Address,
+  IN UINT32              AndData,
+  IN UINT32              OrData
+  );
+
 #endif // _GPIO_LIBRARY_H_
@@ -1741,10 +1741,19 @@ ConfigureEmmcHs400Mode (
     if (mPchConfigHob->Scs.ScsEmmcHs400DllDataValid == TRUE) {
       DEBUG ((DEBUG_INFO, "ConfigureEmmcHs400Mode: SCS eMMC 5.0 HS400 Tuning Not Required, set device to HS400 mode\n"));
       Status = EmmcModeSelection (EmmcInfo, EmmcBaseAddress, Hs400);
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "ConfigureEmmcHs400Mode: eMMC HS400 Mode Selection Failed!\n"));
+      if (!EFI_ERROR (Status)) {
+        return Status;
+      }
+      //
+      // Saved DLL values no longer work with this device, fall back to HS200 and re-tune,
+      // so the platform gets fresh tuning data back instead of losing HS400 until CMOS clear.
+      //
+      DEBUG ((DEBUG_ERROR, "ConfigureEmmcHs400Mode: eMMC HS400 Mode Selection Failed! Re-tuning\n"));
+      ModeStatus = EmmcModeSelection (EmmcInfo, EmmcBaseAddress, Hs200);
+      if (EFI_ERROR (ModeStatus)) {
+        DEBUG ((DEBUG_ERROR, "ConfigureEmmcHs400Mode: eMMC HS200 Mode Selection Failed!\n"));
+        return Status;
       }
-      return Status;
     } else {
       DEBUG ((DEBUG_INFO, "ConfigureEmmcHs400Mode: SCS eMMC 5.0 HS400 Mode Selection Not Required.\n"));
       return EFI_ABORTED;
@@ -1848,7 +1857,8 @@ InstallPchEmmcTuningProtocol (
   ///    b) RC installed Pch Emmc Tuning Protocol regardless of ScsEmmcHs400TuningRequired policy setting in DXE
   /// 2. Once RC successfully installed Pch Emmc Tuning Protocol, it will be used to perform EmmcTune
   /// 3. Since ScsEmmcHs400TuningRequired state tuning not required, RC will not perform Emmc Hs400 Tuning but just set the device to operate in HS400 mode if data is valid
-  /// 4. Platform shall not set variable 'Hs400TuningData'
+  /// 4. Platform shall not set variable 'Hs400TuningData', unless HS400 mode selection with the saved data failed,
+  ///    in which case RC re-tunes and returns new EmmcTuningData that platform shall store in the variable
   ///
   //
   // Install PchEmmcTuningProtocol Protocol
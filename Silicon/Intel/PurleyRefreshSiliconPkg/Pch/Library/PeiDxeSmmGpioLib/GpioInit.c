@@ -237,7 +237,7 @@ DEBUG_CODE_END();
     //
     // Write PADCFG DW0 register
     //
-    MmioAndThenOr32 (
+    GpioMmioAndThenOr32 (
       (UINTN)PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, PadCfgReg),
       ~(UINT32)Dw0RegMask,
       (UINT32)Dw0Reg
@@ -246,7 +246,7 @@ DEBUG_CODE_END();
     //
     // Write PADCFG DW1 register
     //
-    MmioAndThenOr32 (
+    GpioMmioAndThenOr32 (
       (UINTN)PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, PadCfgReg + 0x4),
       ~(UINT32)Dw1RegMask,
       (UINT32)Dw1Reg
@@ -269,7 +269,7 @@ DEBUG_CODE_END();
     // Write HOSTSW_OWN registers
     //
     if (GpioGroupInfo[Index].HostOwnOffset != NO_REGISTER_FOR_PROPERTY) {
-      MmioAndThenOr32 (
+      GpioMmioAndThenOr32 (
         (UINTN)PCH_PCR_ADDRESS (GpioGroupInfo[Index].Community, GpioGroupInfo[Index].HostOwnOffset),
         ~(UINT32)HostSoftOwnRegMask[Index],
         (UINT32)HostSoftOwnReg[Index]
@@ -280,7 +280,7 @@ DEBUG_CODE_END();
     // Write GPI_GPE_EN registers
     //
     if (GpioGroupInfo[Index].GpiGpeEnOffset != NO_REGISTER_FOR_PROPERTY) {
-      MmioAndThenOr32 (
+      GpioMmioAndThenOr32 (
         (UINTN)PCH_PCR_ADDRESS (GpioGroupInfo[Index].Community, GpioGroupInfo[Index].GpiGpeEnOffset),
         ~(UINT32)GpiGpeEnRegMask[Index],
         (UINT32)GpiGpeEnReg[Index]
@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "memory_options.h"
 #include "io.h"
 
+#include "meminit_utils.h"
 #include "hte.h"
 
 
@@ -197,6 +198,7 @@ UINT32 HteMemInit(
   for (i = 0; i < TestNum; i++)
   {
     DPF(D_INFO, ".");
+    post_code(0x09, ((MemInitFlag == MrcMemInit) ? 0x10 : 0x20) + i);
 
     if (i == 0)
     {
@@ -2197,8 +2197,10 @@ static void ecc_enable(
   // Assume 8 bank memory, one bank is gone for ECC
   mrc_params->mem_size -= mrc_params->mem_size / 8;
 
-  // For S3 resume memory content has to be preserved
-  if (mrc_params->boot_mode != bmS3)
+  // For S3 resume memory content has to be preserved.
+  // On cold and fast boot memory_test follows, its first pass writes
+  // all memory locations and so initialises ECC as well.
+  if ((mrc_params->boot_mode & (bmS3 | bmCold | bmFast)) == 0)
   {
     select_hte(mrc_params);
     HteMemInit(mrc_params, MrcMemInit, MrcHaltHteEngineOnError);
@@ -2624,6 +2626,18 @@ void MemInit(
       my_tsc = read_tsc();
       init[i].init_fn(mrc_params);
       DPF(D_TIME, "Execution time %llX", read_tsc() - my_tsc);
+
+      if ((init[i].init_fn == memory_test) &&
+          (mrc_params->boot_mode == bmFast) &&
+          (mrc_params->status != MRC_SUCCESS))
+      {
+        // restored timings no longer work, registers are not locked yet
+        // so start over with full training
+        DPF(D_INFO, "Restored timings failed memory test, full training required\n");
+        mrc_params->boot_mode = bmCold;
+        mrc_params->status = MRC_SUCCESS;
+        i = (uint32_t) -1;
+      }
     }
   }
 
@@ -724,9 +724,15 @@ OhciBulkTransfer(
   HeadTd = NULL;
   FirstTD = TRUE;
   while (LeftLength > 0) {
+    //
+    // Let every TD carry as many packets as its two page buffer can hold,
+    // the HC splits it into MaxPacketLength packets by itself. Only the last
+    // TD may end with a short packet.
+    //
     ActualSendLength = LeftLength;
-    if (LeftLength > MaxPacketLength) {
-      ActualSendLength = MaxPacketLength;
+    if (ActualSendLength > MAX_TD_BUFFER_SPAN - (UINTN)(MapPyhAddr & (EFI_PAGE_SIZE - 1))) {
+      ActualSendLength = MAX_TD_BUFFER_SPAN - (UINTN)(MapPyhAddr & (EFI_PAGE_SIZE - 1));
+      ActualSendLength -= ActualSendLength % MaxPacketLength;
     }
     DataTd = OhciCreateTD (Ohc);
     if (DataTd == NULL) {
@@ -753,7 +759,12 @@ OhciBulkTransfer(
     } else {
       OhciLinkTD (HeadTd, DataTd);
     }
-    *DataToggle ^= 1;
+    //
+    // The HC toggles the TD data toggle after each packet.
+    //
+    if ((((ActualSendLength + MaxPacketLength - 1) / MaxPacketLength) & 1) != 0) {
+      *DataToggle ^= 1;
+    }
     MapPyhAddr += ActualSendLength;
     LeftLength -= ActualSendLength;
   }
@@ -799,8 +810,6 @@ OhciBulkTransfer(
     DEBUG ((EFI_D_INFO, "OhciControlTransfer: Fail to enable BULK_ENABLE\r\n"));
     goto FREE_OHCI_TDBUFF;
   }
-  gBS->Stall(20 * 1000);
-
   TimeCount = 0;
   Status = CheckIfDone (Ohc, BULK_LIST, Ed, HeadTd, &EdResult);
   while (Status == EFI_NOT_READY && TimeCount <= TimeOut) {
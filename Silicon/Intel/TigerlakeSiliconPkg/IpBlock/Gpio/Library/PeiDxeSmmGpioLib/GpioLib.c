@@ -7,6 +7,36 @@
 #include "GpioLibrary.h"
 #include <Register/PchPcrRegs.h>
 
+/**
+  This procedure will read-modify-write a GPIO register.
+  Register is not accessed if AND and OR masks leave it unchanged
+  and it is not written back if it already holds the target value.
+
+  @param[in]  Address                   GPIO register address
+  @param[in]  AndData                   Mask which will be AND'ed with register value
+  @param[in]  OrData                    Mask which will be OR'ed with register value
+**/
+VOID
+GpioMmioAndThenOr32 (
+  IN UINTN               Address,
+  IN UINT32              AndData,
+  IN UINT32              OrData
+  )
+{
+  UINT32  Data32;
+  UINT32  NewData32;
+
+  if ((AndData == MAX_UINT32) && (OrData == 0)) {
+    return;
+  }
+
+  Data32    = MmioRead32 (Address);
+  NewData32 = (Data32 & AndData) | OrData;
+  if (NewData32 != Data32) {
+    MmioWrite32 (Address, NewData32);
+  }
+}
+
 /**
   This procedure will check if GpioGroup argument is correct and
   supplied DW reg number can be used for this group to access DW registers.
@@ -231,6 +261,13 @@ GpioWriteReg (
     return EFI_UNSUPPORTED;
   }
 
+  //
+  // Nothing to do if no pad is going to be reconfigured
+  //
+  if ((RegAndMask == MAX_UINT32) && (RegOrMask == 0)) {
+    return EFI_SUCCESS;
+  }
+
   if (Lockable) {
     GpioGetPadCfgLockForGroupDw (Group, DwNum, &PadCfgLock);
     if (PadCfgLock) {
@@ -259,7 +296,7 @@ GpioWriteReg (
   //
   RegOffset += DwNum * 0x4;
 
-  MmioAndThenOr32 (
+  GpioMmioAndThenOr32 (
     PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, RegOffset),
     RegAndMask,
     RegOrMask
@@ -794,32 +831,38 @@ GpioSetPadConfig (
   //
   // Write PADCFG DW0 register
   //
-  GpioWritePadCfgReg (
-    GpioPad,
-    0,
-    ~PadCfgDwRegMask[0],
-    PadCfgDwReg[0]
-    );
+  if (PadCfgDwRegMask[0] != 0) {
+    GpioWritePadCfgReg (
+      GpioPad,
+      0,
+      ~PadCfgDwRegMask[0],
+      PadCfgDwReg[0]
+      );
+  }
 
   //
   // Write PADCFG DW1 register
   //
-  GpioWritePadCfgReg (
-    GpioPad,
-    1,
-    ~PadCfgDwRegMask[1],
-    PadCfgDwReg[1]
-    );
+  if (PadCfgDwRegMask[1] != 0) {
+    GpioWritePadCfgReg (
+      GpioPad,
+      1,
+      ~PadCfgDwRegMask[1],
+      PadCfgDwReg[1]
+      );
+  }
 
   //
   // Write PADCFG DW2 register
   //
-  GpioWritePadCfgReg (
-    GpioPad,
-    2,
-    ~PadCfgDwRegMask[2],
-    PadCfgDwReg[2]
-    );
+  if (PadCfgDwRegMask[2] != 0) {
+    GpioWritePadCfgReg (
+      GpioPad,
+      2,
+      ~PadCfgDwRegMask[2],
+      PadCfgDwReg[2]
+      );
+  }
 
   //
   // Update value to be programmed in HOSTSW_OWN register
@@ -1406,6 +1406,43 @@ RecursiveCccConfiguration (
   return MyScc;
 }
 
+/**
+  Waits for link retrain to finish on every downstream port in given device and in PCIe tree below it.
+  Links are visited top-down, because a link must finish retraining before devices behind it can be accessed.
+  All links share one timeout, so when links retrain in parallel the total wait is that of the slowest
+  link rather than the sum of all of them.
+
+  @param[in]     Sbdf         device's segment:bus:device:function coordinates
+  @param[in,out] TimeoutUs    remaining time shared by all links; decremented while waiting
+**/
+STATIC
+VOID
+RecursiveRetrainWait (
+  SBDF       Sbdf,
+  UINT32     *TimeoutUs
+  )
+{
+  UINT64       Base;
+  SBDF         ChildSbdf;
+  PCI_DEV_TYPE DevType;
+
+  if (Sbdf.PcieCap == 0) {
+    return;
+  }
+  Base = SbdfToBase (Sbdf);
+  DevType = GetDeviceType (Sbdf);
+  if (DevType == DevTypePcieDownstream) {
+    while ((*TimeoutUs != 0) && (PciSegmentRead16 (Base + Sbdf.PcieCap + R_PCIE_LSTS_OFFSET) & B_PCIE_LSTS_LT)) {
+      (*TimeoutUs)--;
+    }
+  }
+  if (HasChildBus (Sbdf, &ChildSbdf)) {
+    while (FindNextPcieChild (DevType, &ChildSbdf)) {
+      RecursiveRetrainWait (ChildSbdf, TimeoutUs);
+    }
+  }
+}
+
 /**
   Configures Latency Tolerance Reporting in given device and in PCIe tree below it.
   This function configures Maximum LTR and enables LTR mechanism. It visits devices using depth-first search
@@ -1670,6 +1707,8 @@ RecursivePtmConfiguration (
 
   CCC requires link retrain, which takes a while. CCC must happen before L0s/L1 programming.
   If there was guarantee no code would access PCI while links retrain, it would be possible to skip this waiting
+  Retrain is triggered on all links of the hierarchy first and then waited for once, so links behind
+  switches retrain in parallel.
 
   @param[in] RpSegment  address of rootport on PCIe
   @param[in] RpBus      address of rootport on PCIe
@@ -1694,6 +1733,7 @@ RootportDownstreamConfiguration (
   UINT64          RpBase;
   SBDF            RpSbdf;
   SBDF_TABLE      BridgeCleanupList;
+  UINT32          TimeoutUs;
 
   IoApicPresent = FALSE;
   RpBase = PCI_SEGMENT_LIB_ADDRESS (RpSegment, RpBus, RpDevice, RpFunction, 0);
@@ -1720,7 +1760,9 @@ RootportDownstreamConfiguration (
   if ((PciSku == EnumPchPcie) || (PciSku == EnumCpuPcie)) {
     ConfigureEoiForwarding (RpBase, IoApicPresent);
   }
-  RecursiveCccConfiguration (RpSbdf, TRUE);
+  RecursiveCccConfiguration (RpSbdf, FALSE);
+  TimeoutUs = LINK_RETRAIN_WAIT_TIME;
+  RecursiveRetrainWait (RpSbdf, &TimeoutUs);
 
   if (IsPtmCapable (RpSbdf)) {
     RecursivePtmConfiguration (RpSbdf, 0, FALSE);
@@ -465,6 +465,11 @@ struct _DATABASE_RECORD {
   /// Indicate the PCH SMI types.
   ///
   PCH_SMI_TYPES                 PchSmiType;
+  ///
+  /// Top level SMI_STS bit of the source, zero if the source has none.
+  /// Filled in by SmmCoreInsertRecord.
+  ///
+  UINT32                        SmiStsMask;
 };
 
 #define DATABASE_RECORD_FROM_LINK(_record)  CR (_record, DATABASE_RECORD, Link, DATABASE_RECORD_SIGNATURE)
@@ -623,6 +628,15 @@ SmmCoreInsertRecord (
   OUT EFI_HANDLE                        *DispatchHandle
   );
 
+/**
+  Rebuild the mask of top level SMI_STS bits that have a registered source.
+  Must be called after a record has been removed from the database.
+**/
+VOID
+SmmCoreUpdateSmiStsIndex (
+  VOID
+  );
+
 /**
   Get the Sleep type
 
@@ -25,6 +25,13 @@ GLOBAL_REMOVE_IF_UNREFERENCED UINT16                mTcoBaseAddr;
 GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN               mReadyToLock;
 GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN               mS3SusStart;
 
+//
+// Top level SMI_STS bits that have at least one registered source.
+// All bits are set when a registered source has no top level SMI_STS bit,
+// since such a source can be active whatever SMI_STS reads.
+//
+STATIC UINT32                                       mSmiStsIndexMask;
+
 GLOBAL_REMOVE_IF_UNREFERENCED PRIVATE_DATA          mPrivateData = {
   {
     NULL,
@@ -273,6 +280,76 @@ InitializePchSmmDispatcher (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the top level SMI_STS bit of an SMI source.
+
+  @param[in] SrcDesc                    Pointer to the PCH SMI source description table
+
+  @retval 0                             The source has no top level SMI_STS bit.
+  @retval Others                        Mask of the top level SMI_STS bit.
+**/
+STATIC
+UINT32
+GetSourceSmiStsMask (
+  CONST PCH_SMM_SOURCE_DESC             *SrcDesc
+  )
+{
+  CONST PCH_SMM_BIT_DESC                *BitDesc;
+
+  if (!IS_BIT_DESC_NULL (SrcDesc->PmcSmiSts)) {
+    BitDesc = &SrcDesc->PmcSmiSts;
+  } else {
+    BitDesc = &SrcDesc->Sts[0];
+  }
+
+  if (!IS_BIT_DESC_NULL (*BitDesc) &&
+      (BitDesc->Reg.Type == ACPI_ADDR_TYPE) &&
+      (BitDesc->Reg.Data.acpi == R_ACPI_IO_SMI_STS)) {
+    return 1u << BitDesc->Bit;
+  }
+
+  return 0;
+}
+
+/**
+  Add the top level SMI_STS bit of a database record to the SMI_STS index.
+
+  @param[in] Record                     Record that was inserted to database.
+**/
+STATIC
+VOID
+SmmCoreIndexRecord (
+  IN DATABASE_RECORD                    *Record
+  )
+{
+  if (Record->SmiStsMask == 0) {
+    mSmiStsIndexMask = MAX_UINT32;
+  } else {
+    mSmiStsIndexMask |= Record->SmiStsMask;
+  }
+}
+
+/**
+  Rebuild the mask of top level SMI_STS bits that have a registered source.
+  Must be called after a record has been removed from the database.
+**/
+VOID
+SmmCoreUpdateSmiStsIndex (
+  VOID
+  )
+{
+  DATABASE_RECORD                       *RecordInDb;
+  LIST_ENTRY                            *LinkInDb;
+
+  mSmiStsIndexMask = 0;
+  LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
+  while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
+    RecordInDb = DATABASE_RECORD_FROM_LINK (LinkInDb);
+    SmmCoreIndexRecord (RecordInDb);
+    LinkInDb = GetNextNode (&mPrivateData.CallbackDataBase, &RecordInDb->Link);
+  }
+}
+
 /**
   The internal function used to create and insert a database record
 
@@ -305,11 +382,13 @@ SmmCoreInsertRecord (
     return EFI_OUT_OF_RESOURCES;
   }
   CopyMem (Record, NewRecord, sizeof (DATABASE_RECORD));
+  Record->SmiStsMask = GetSourceSmiStsMask (&Record->SrcDesc);
 
   //
   // After ensuring the source of event is not null, we will insert the record into the database
   //
   InsertTailList (&mPrivateData.CallbackDataBase, &Record->Link);
+  SmmCoreIndexRecord (Record);
 
   //
   // Child's handle will be the address linked list link in the record
@@ -583,6 +662,7 @@ PchSmmCoreUnRegister (
   }
 
   RemoveEntryList (&RecordToDelete->Link);
+  SmmCoreUpdateSmiStsIndex ();
 
   //
   // Loop through all the souces in record linked list to see if any source enable is equal.
@@ -741,13 +821,24 @@ PchSmmCoreDispatcher (
       SmiEnValue  = IoRead32 ((UINTN) (mAcpiBaseAddr + R_ACPI_IO_SMI_EN));
       SmiStsValue = IoRead32 ((UINTN) (mAcpiBaseAddr + R_ACPI_IO_SMI_STS));
 
+      if ((SmiStsValue & mSmiStsIndexMask) == 0) {
+        //
+        // None of the registered sources can be active, skip the database walk
+        //
+        ClearPendingSmiStatus (SmiStsValue, SciEn);
+        EosSet = PchSmmSetAndCheckEos ();
+        continue;
+      }
+
       while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
         RecordInDb = DATABASE_RECORD_FROM_LINK (LinkInDb);
 
         //
-        // look for the first active source
+        // look for the first active source, rejecting the sources whose top level
+        // SMI_STS bit is clear without querying their status registers
         //
-        if (!SourceIsActive (&RecordInDb->SrcDesc, SciEn, SmiEnValue, SmiStsValue)) {
+        if (((RecordInDb->SmiStsMask != 0) && ((SmiStsValue & RecordInDb->SmiStsMask) == 0)) ||
+            !SourceIsActive (&RecordInDb->SrcDesc, SciEn, SmiEnValue, SmiStsValue)) {
           //
           // Didn't find the source yet, keep looking
           //
@@ -246,6 +246,7 @@ PchGpiSmiUnRegister (
 
 
   RemoveEntryList (&RecordToDelete->Link);
+  SmmCoreUpdateSmiStsIndex ();
   ZeroMem (RecordToDelete, sizeof (DATABASE_RECORD));
   Status = gSmst->SmmFreePool (RecordToDelete);
 
@@ -89,6 +89,7 @@ static TIMER_INTERVAL mSmmPeriodicTimerIntervals[NUM_INTERVALS] = {
 typedef struct _TIMER_INFO {
   UINTN   NumChildren;        ///< number of children using this timer
   UINT64  MinReqInterval;     ///< minimum interval required by children
+  UINT64  MinTimeToDeadline;  ///< shortest time left until a child's period elapses
   UINTN   CurrentSetting;     ///< interval this timer is set at right now (index into interval table)
 } TIMER_INFO;
 
@@ -269,9 +270,9 @@ PeriodicTimerGetContext (
   ///
   /// Ignore the hardware context. It's not required for this protocol.
   /// Instead, just increment the child's context.
-  /// Update the elapsed time w/ the data from our tables
+  /// Update the elapsed time w/ the interval the timer was programmed with
   ///
-  Record->MiscData.ElapsedTime += mTimers[TimerInterval->AssociatedTimer].MinReqInterval;
+  Record->MiscData.ElapsedTime += mSmmPeriodicTimerIntervals[mTimers[TimerInterval->AssociatedTimer].CurrentSetting].Interval;
   *HwContext = Record->ChildContext;
 }
 
@@ -339,6 +340,36 @@ PeriodicTimerGetCommBuffer (
   *CommBufferSize = sizeof (EFI_SMM_PERIODIC_TIMER_CONTEXT);
 }
 
+/**
+  Select the interval a timer is programmed with.
+
+  All the children of a timer share one hardware source, so instead of always ticking
+  at the shortest interval requested by a child, the longest interval that still
+  ends no later than the earliest child deadline is used. The interval never gets
+  shorter than the shortest one requested by a child.
+
+  @param[in] Timer                The timer to select the interval for.
+
+  @retval UINT64                  The interval to program, in 100 nano-second units.
+**/
+UINT64
+PchSmmPeriodicTimerSelectInterval (
+  IN SUPPORTED_TIMER              Timer
+  )
+{
+  UINTN   Index;
+
+  for (Index = 0; Index < NUM_INTERVALS; Index++) {
+    if ((mSmmPeriodicTimerIntervals[Index].AssociatedTimer == Timer) &&
+        (mSmmPeriodicTimerIntervals[Index].Interval <= mTimers[Timer].MinTimeToDeadline) &&
+        (mSmmPeriodicTimerIntervals[Index].Interval >= mTimers[Timer].MinReqInterval)) {
+      return mSmmPeriodicTimerIntervals[Index].Interval;
+    }
+  }
+
+  return mTimers[Timer].MinReqInterval;
+}
+
 /**
   Program Smm Periodic Timer
 
@@ -353,13 +384,15 @@ PchSmmPeriodicTimerProgramTimers (
   DATABASE_RECORD *RecordInDb;
   LIST_ENTRY      *LinkInDb;
   TIMER_INTERVAL  *TimerInterval;
+  UINT64          TimeToDeadline;
 
   ///
-  /// Find the minimum required interval for each timer
+  /// Find the minimum required interval and the earliest deadline for each timer
   ///
   for (Timer = 0; Timer < NUM_TIMERS; Timer++) {
-    mTimers[Timer].MinReqInterval = ~ (UINT64) 0x0;
-    mTimers[Timer].NumChildren    = 0;
+    mTimers[Timer].MinReqInterval    = ~ (UINT64) 0x0;
+    mTimers[Timer].MinTimeToDeadline = ~ (UINT64) 0x0;
+    mTimers[Timer].NumChildren       = 0;
   }
 
   LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
@@ -384,6 +417,13 @@ PchSmmPeriodicTimerProgramTimers (
         if (mTimers[Timer].MinReqInterval > RecordInDb->ChildContext.PeriodicTimer.SmiTickInterval) {
           mTimers[Timer].MinReqInterval = RecordInDb->ChildContext.PeriodicTimer.SmiTickInterval;
         }
+        TimeToDeadline = 0;
+        if (RecordInDb->ChildContext.PeriodicTimer.Period > RecordInDb->MiscData.ElapsedTime) {
+          TimeToDeadline = RecordInDb->ChildContext.PeriodicTimer.Period - RecordInDb->MiscData.ElapsedTime;
+        }
+        if (mTimers[Timer].MinTimeToDeadline > TimeToDeadline) {
+          mTimers[Timer].MinTimeToDeadline = TimeToDeadline;
+        }
         mTimers[Timer].NumChildren++;
       }
     }
@@ -393,7 +433,7 @@ PchSmmPeriodicTimerProgramTimers (
   /// Program the hardware
   ///
   if (mTimers[PERIODIC_TIMER].NumChildren > 0) {
-    switch (mTimers[PERIODIC_TIMER].MinReqInterval) {
+    switch (PchSmmPeriodicTimerSelectInterval (PERIODIC_TIMER)) {
       case TIME_64s:
         PmcSetPeriodicSmiRate (PmcPeriodicSmiRate64s);
         mTimers[PERIODIC_TIMER].CurrentSetting = INDEX_TIME_64s;
@@ -430,7 +470,7 @@ PchSmmPeriodicTimerProgramTimers (
   }
 
   if (mTimers[SWSMI_TIMER].NumChildren > 0) {
-    switch (mTimers[SWSMI_TIMER].MinReqInterval) {
+    switch (PchSmmPeriodicTimerSelectInterval (SWSMI_TIMER)) {
       case TIME_64ms:
         PmcSetSwSmiRate (PmcSwSmiRate64ms);
         mTimers[SWSMI_TIMER].CurrentSetting = INDEX_TIME_64ms;
@@ -296,6 +296,28 @@ typedef struct {
 
 FIT_TABLE_CONTEXT   gFitTableContext = {0};
 
+//
+// FitGen looks up many files by GUID in the same BIOS image. Walking a large
+// image for FV headers on every lookup dominated the run time, so the FFS files
+// of the last searched buffer are indexed once and looked up from the index.
+// The index must be invalidated whenever the image is written to.
+//
+typedef struct {
+  EFI_GUID  *Name;
+  UINT8     *Data;
+  UINT32    Size;
+} FFS_FILE_INDEX_ENTRY;
+
+typedef struct {
+  UINT8                 *Buffer;
+  UINT32                BufferSize;
+  UINT32                FileNumber;
+  UINT32                MaxFileNumber;
+  FFS_FILE_INDEX_ENTRY  *File;
+} FFS_FILE_INDEX;
+
+FFS_FILE_INDEX      gFfsFileIndex = {0};
+
 unsigned int
 xtoi (
   char  *str
@@ -673,50 +695,113 @@ FindNextFvHeader (
   return NULL;
 }
 
-UINT8  *
-FindFileFromFvByGuid (
+VOID
+InvalidateFfsFileIndex (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  Drop the FFS file index, so that the next lookup walks the FVs again
+
+Arguments:
+
+  None
+
+Returns:
+
+  None
+
+--*/
+{
+  if (gFfsFileIndex.File != NULL) {
+    free (gFfsFileIndex.File);
+  }
+  memset (&gFfsFileIndex, 0, sizeof (gFfsFileIndex));
+}
+
+BOOLEAN
+AddFfsFileIndexEntry (
+  IN EFI_GUID  *Name,
+  IN UINT8     *Data,
+  IN UINT32    Size
+  )
+/*++
+
+Routine Description:
+
+  Append a file to the FFS file index
+
+Arguments:
+
+  Name           - File GUID
+  Data           - File data, after the FFS header
+  Size           - File data size
+
+Returns:
+
+  TRUE           - The file is added.
+  FALSE          - Out of memory.
+
+--*/
+{
+  FFS_FILE_INDEX_ENTRY  *NewFile;
+  UINT32                NewMaxFileNumber;
+
+  if (gFfsFileIndex.FileNumber == gFfsFileIndex.MaxFileNumber) {
+    NewMaxFileNumber = (gFfsFileIndex.MaxFileNumber == 0) ? 0x100 : gFfsFileIndex.MaxFileNumber * 2;
+    NewFile = (FFS_FILE_INDEX_ENTRY *) realloc (gFfsFileIndex.File, NewMaxFileNumber * sizeof (FFS_FILE_INDEX_ENTRY));
+    if (NewFile == NULL) {
+      return FALSE;
+    }
+    gFfsFileIndex.File          = NewFile;
+    gFfsFileIndex.MaxFileNumber = NewMaxFileNumber;
+  }
+
+  gFfsFileIndex.File[gFfsFileIndex.FileNumber].Name = Name;
+  gFfsFileIndex.File[gFfsFileIndex.FileNumber].Data = Data;
+  gFfsFileIndex.File[gFfsFileIndex.FileNumber].Size = Size;
+  gFfsFileIndex.FileNumber++;
+
+  return TRUE;
+}
+
+BOOLEAN
+BuildFfsFileIndex (
   IN UINT8     *FvBuffer,
-  IN UINT32    FvSize,
-  IN EFI_GUID  *Guid,
-  OUT UINT32   *FileSize
+  IN UINT32    FvSize
   )
 /*++
 
 Routine Description:
 
-  Find File with GUID in an FV
+  Index all FFS files of all FVs in a buffer, in the order they are found
 
 Arguments:
 
   FvBuffer       - FV binary buffer
   FvSize         - FV size
-  Guid           - File GUID value to be searched
-  FileSize       - Guid File size
 
 Returns:
 
-  FileLocation   - Guid File location.
-  NULL           - Guid File is not found.
+  TRUE           - The index is built.
+  FALSE          - Out of memory.
 
 --*/
 {
   EFI_FIRMWARE_VOLUME_HEADER  *FvHeader;
   EFI_FFS_FILE_HEADER         *FileHeader;
   UINT64                      FvLength;
-  EFI_GUID                    *TempGuid;
-  UINT8                       *FixPoint;
   UINTN                       Offset;
   UINTN                       FileLength;
   UINTN                       FileOccupiedSize;
+  UINT32                      FileSize;
+
+  InvalidateFfsFileIndex ();
 
-  //
-  // Find the FFS file
-  //
   FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader (FvBuffer, FvSize);
-  if (NULL == FvHeader) {
-    return NULL;
-  }
-  while (TRUE) {
+  while (FvHeader != NULL) {
     FvLength         = FvHeader->FvLength;
 
     //
@@ -728,49 +813,86 @@ Returns:
     Offset           = (UINTN) FileHeader - (UINTN) FvHeader;
 
     while (Offset < FvLength) {
-      TempGuid = (EFI_GUID *)&(FileHeader->Name);
       FileLength = (*(UINT32 *)(FileHeader->Size)) & 0x00FFFFFF;
       FileOccupiedSize = GETOCCUPIEDSIZE(FileLength, 8);
-      if ((CompareGuid (TempGuid, Guid)) == 0) {
-        //
-        // Good! Find it.
-        //
-        FixPoint = ((UINT8 *)FileHeader + sizeof(EFI_FFS_FILE_HEADER));
-        //
-        // Find the position of file module, the offset
-        // between the position and the end of FvRecovery.fv file
-        // should not exceed 128kB to prevent reset vector from
-        // outside legacy E and F segment
-        //
-        if ((UINTN)FvHeader + FvLength - (UINTN)FixPoint > 0x20000) {
-  //        printf ("WARNING: The position of file module is not in E and F segment!\n");
-  //        return NULL;
-        }
-        *FileSize = FileLength - sizeof(EFI_FFS_FILE_HEADER);
+      FileSize = (UINT32) (FileLength - sizeof(EFI_FFS_FILE_HEADER));
   #if (PI_SPECIFICATION_VERSION < 0x00010000)
-        if (FileHeader->Attributes & FFS_ATTRIB_TAIL_PRESENT) {
-          *FileSize -= sizeof(EFI_FFS_FILE_TAIL);
-        }
+      if (FileHeader->Attributes & FFS_ATTRIB_TAIL_PRESENT) {
+        FileSize -= sizeof(EFI_FFS_FILE_TAIL);
+      }
   #endif
-        return FixPoint;
+      if (!AddFfsFileIndexEntry (&FileHeader->Name, (UINT8 *)FileHeader + sizeof(EFI_FFS_FILE_HEADER), FileSize)) {
+        InvalidateFfsFileIndex ();
+        return FALSE;
+      }
+      if (FileOccupiedSize == 0) {
+        break;
       }
       FileHeader = (EFI_FFS_FILE_HEADER *)((UINTN)FileHeader + FileOccupiedSize);
       Offset = (UINTN) FileHeader - (UINTN) FvHeader;
     }
 
     //
-    // Not found, check next FV
+    // Check next FV
     //
     if ((UINTN)FvBuffer + FvSize > (UINTN)FvHeader + FvLength) {
       FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader ((UINT8 *)FvHeader + (UINTN)FvLength, (UINTN)FvBuffer + FvSize - ((UINTN)FvHeader + (UINTN)FvLength));
-      if (FvHeader == NULL) {
-        break;
-      }
     } else {
       break;
     }
   }
 
+  gFfsFileIndex.Buffer     = FvBuffer;
+  gFfsFileIndex.BufferSize = FvSize;
+  return TRUE;
+}
+
+UINT8  *
+FindFileFromFvByGuid (
+  IN UINT8     *FvBuffer,
+  IN UINT32    FvSize,
+  IN EFI_GUID  *Guid,
+  OUT UINT32   *FileSize
+  )
+/*++
+
+Routine Description:
+
+  Find File with GUID in an FV
+
+Arguments:
+
+  FvBuffer       - FV binary buffer
+  FvSize         - FV size
+  Guid           - File GUID value to be searched
+  FileSize       - Guid File size
+
+Returns:
+
+  FileLocation   - Guid File location.
+  NULL           - Guid File is not found.
+
+--*/
+{
+  UINT32                      Index;
+
+  if ((gFfsFileIndex.Buffer != FvBuffer) || (gFfsFileIndex.BufferSize != FvSize)) {
+    if (!BuildFfsFileIndex (FvBuffer, FvSize)) {
+      Error (NULL, 0, 0, "Out of memory indexing FFS files!", NULL);
+      return NULL;
+    }
+  }
+
+  //
+  // The first file with the GUID wins, as when walking the FVs in order
+  //
+  for (Index = 0; Index < gFfsFileIndex.FileNumber; Index++) {
+    if ((CompareGuid (gFfsFileIndex.File[Index].Name, Guid)) == 0) {
+      *FileSize = gFfsFileIndex.File[Index].Size;
+      return gFfsFileIndex.File[Index].Data;
+    }
+  }
+
   //
   // Not found
   //
@@ -2191,6 +2313,7 @@ Returns:
         }
       }
       memcpy (OptionalModuleAddress, gFitTableContext.OptionalModule[Index].Buffer, gFitTableContext.OptionalModule[Index].Size);
+      InvalidateFfsFileIndex ();
       free (gFitTableContext.OptionalModule[Index].Buffer);
       gFitTableContext.OptionalModule[Index].Address = MEMORY_TO_FLASH (OptionalModuleAddress, FvBuffer, FvSize);
     }
@@ -3076,6 +3199,7 @@ Returns:
     //
     SetMem (&FitEntry[FitIndex], sizeof(FitEntry[FitIndex]), 0xFF);
   }
+  InvalidateFfsFileIndex ();
 }
 
 STATUS
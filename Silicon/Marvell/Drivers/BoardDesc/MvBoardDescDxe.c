@@ -10,6 +10,14 @@ MV_BOARD_DESC *mBoardDescInstance;
 
 STATIC MV_BOARD_GPIO_DESCRIPTION *mGpioDescription;
 STATIC MV_BOARD_PCIE_DESCRIPTION *mPcieDescription;
+STATIC MV_BOARD_COMPHY_DESC *mComPhyDesc;
+STATIC MV_BOARD_I2C_DESC *mI2cDesc;
+STATIC MV_BOARD_MDIO_DESC *mMdioDesc;
+STATIC MV_BOARD_AHCI_DESC *mAhciDesc;
+STATIC MV_BOARD_SDMMC_DESC *mSdMmcDesc;
+STATIC MV_BOARD_XHCI_DESC *mXhciDesc;
+STATIC MV_BOARD_PP2_DESC *mPp2Desc;
+STATIC MV_BOARD_UTMI_DESC *mUtmiDesc;
 
 STATIC
 EFI_STATUS
@@ -24,6 +32,12 @@ MvBoardDescComPhyGet (
   MV_SOC_COMPHY_DESC *SoCDesc;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mComPhyDesc != NULL) {
+    *ComPhyDesc = mComPhyDesc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available ComPhy controllers */
   Status = ArmadaSoCDescComPhyGet (&SoCDesc, &ComPhyCount);
   if (EFI_ERROR (Status)) {
@@ -69,6 +83,7 @@ MvBoardDescComPhyGet (
 
   BoardDesc->ComPhyDevCount = ComPhyIndex;
 
+  mComPhyDesc = BoardDesc;
   *ComPhyDesc = BoardDesc;
 
   return EFI_SUCCESS;
@@ -134,6 +149,12 @@ MvBoardDescI2cGet (
   MV_SOC_I2C_DESC *SoCDesc;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mI2cDesc != NULL) {
+    *I2cDesc = mI2cDesc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available I2C controllers */
   Status = ArmadaSoCDescI2cGet (&SoCDesc, &I2cCount);
   if (EFI_ERROR (Status)) {
@@ -181,6 +202,7 @@ MvBoardDescI2cGet (
 
   BoardDesc->I2cDevCount = I2cIndex;
 
+  mI2cDesc = BoardDesc;
   *I2cDesc = BoardDesc;
 
   return EFI_SUCCESS;
@@ -198,6 +220,12 @@ MvBoardDescMdioGet (
   UINTN MdioCount, Index;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mMdioDesc != NULL) {
+    *MdioDesc = mMdioDesc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available MDIO controllers */
   Status = ArmadaSoCDescMdioGet (&SoCDesc, &MdioCount);
   if (EFI_ERROR (Status)) {
@@ -216,6 +244,7 @@ MvBoardDescMdioGet (
   }
 
   BoardDesc->MdioDevCount = MdioCount;
+  mMdioDesc = BoardDesc;
   *MdioDesc = BoardDesc;
 
   return EFI_SUCCESS;
@@ -234,6 +263,12 @@ MvBoardDescAhciGet (
   MV_SOC_AHCI_DESC *SoCDesc;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mAhciDesc != NULL) {
+    *AhciDesc = mAhciDesc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available AHCI controllers */
   Status = ArmadaSoCDescAhciGet (&SoCDesc, &AhciCount);
   if (EFI_ERROR (Status)) {
@@ -279,6 +314,7 @@ MvBoardDescAhciGet (
 
   BoardDesc->AhciDevCount = AhciIndex;
 
+  mAhciDesc = BoardDesc;
   *AhciDesc = BoardDesc;
 
   return EFI_SUCCESS;
@@ -298,6 +334,12 @@ MvBoardDescSdMmcGet (
   MV_SOC_SDMMC_DESC *SoCDesc;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mSdMmcDesc != NULL) {
+    *SdMmcDesc = mSdMmcDesc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available SDMMC controllers */
   Status = ArmadaSoCDescSdMmcGet (&SoCDesc, &SdMmcCount);
   if (EFI_ERROR (Status)) {
@@ -350,6 +392,7 @@ MvBoardDescSdMmcGet (
 
   BoardDesc->SdMmcDevCount = SdMmcIndex;
 
+  mSdMmcDesc = BoardDesc;
   *SdMmcDesc = BoardDesc;
 
   return EFI_SUCCESS;
@@ -368,6 +411,12 @@ MvBoardDescXhciGet (
   MV_SOC_XHCI_DESC *SoCDesc;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mXhciDesc != NULL) {
+    *XhciDesc = mXhciDesc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available XHCI controllers */
   Status = ArmadaSoCDescXhciGet (&SoCDesc, &XhciCount);
   if (EFI_ERROR (Status)) {
@@ -413,6 +462,7 @@ MvBoardDescXhciGet (
 
   BoardDesc->XhciDevCount = XhciIndex;
 
+  mXhciDesc = BoardDesc;
   *XhciDesc = BoardDesc;
 
   return EFI_SUCCESS;
@@ -515,6 +565,12 @@ MvBoardDescPp2Get (
   MV_SOC_PP2_DESC *SoCDesc;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mPp2Desc != NULL) {
+    *Pp2Desc = mPp2Desc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available PP2 controllers */
   Status = ArmadaSoCDescPp2Get (&SoCDesc, &Pp2Count);
   if (EFI_ERROR (Status)) {
@@ -559,6 +615,7 @@ MvBoardDescPp2Get (
 
   BoardDesc->Pp2DevCount = Pp2Index;
 
+  mPp2Desc = BoardDesc;
   *Pp2Desc = BoardDesc;
 
   return EFI_SUCCESS;
@@ -577,6 +634,12 @@ MvBoardDescUtmiGet (
   MV_SOC_UTMI_DESC *SoCDesc;
   EFI_STATUS Status;
 
+  /* Use existing description if already created. */
+  if (mUtmiDesc != NULL) {
+    *UtmiDesc = mUtmiDesc;
+    return EFI_SUCCESS;
+  }
+
   /* Get SoC data about all available UTMI controllers */
   Status = ArmadaSoCDescUtmiGet (&SoCDesc, &UtmiCount);
   if (EFI_ERROR (Status)) {
@@ -649,18 +712,22 @@ MvBoardDescUtmiGet (
 
   BoardDesc->UtmiDevCount = UtmiIndex;
 
+  mUtmiDesc = BoardDesc;
   *UtmiDesc = BoardDesc;
 
   return EFI_SUCCESS;
 }
 
+/*
+ * All descriptions are built once, on first query, and then shared by all
+ * consumers for the lifetime of the driver, so there is nothing to free.
+ */
 STATIC
 VOID
 MvBoardDescFree (
   IN VOID *BoardDesc
   )
 {
-  FreePool (BoardDesc);
 }
 
 STATIC
@@ -115,6 +115,12 @@ MvPca95xxGetI2c (
   EFI_HANDLE  *HandleBuffer;
   EFI_STATUS   Status;
 
+  /* Reuse the protocol instance found on the previous lookup */
+  if (mPca95xxInstance->Shadows[ControllerIndex].I2cIo != NULL) {
+    *I2cIo = mPca95xxInstance->Shadows[ControllerIndex].I2cIo;
+    return EFI_SUCCESS;
+  }
+
   I2cBus = mPca95xxInstance->GpioExpanders[ControllerIndex].I2cBus;
   I2cAddress = mPca95xxInstance->GpioExpanders[ControllerIndex].I2cAddress;
 
@@ -144,6 +150,7 @@ MvPca95xxGetI2c (
     }
     if ((*I2cIo)->DeviceIndex == I2C_DEVICE_INDEX (I2cBus, I2cAddress)) {
       gBS->FreePool (HandleBuffer);
+      mPca95xxInstance->Shadows[ControllerIndex].I2cIo = *I2cIo;
       return EFI_SUCCESS;
     }
   }
@@ -218,60 +225,120 @@ MvPca95xxWriteRegs (
   return MvPca95xxI2cTransfer (I2cIo, Reg, &RegVal, I2C_FLAG_NORESTART);
 }
 
+/**
+
+Routine Description:
+
+  Returns the shadowed value of an output or direction register bank,
+  reading it from the device if it has not been cached yet.
+
+Arguments:
+
+  ControllerIndex - index of controller
+  Reg     - PCA95XX_OUTPUT_REG or PCA95XX_DIRECTION_REG
+  Bank    - register bank
+  RegVal  - pointer to register value
+
+Returns:
+
+  EFI_SUCCESS - register value returned in RegVal
+  other       - I2C transfer error
+
+**/
 STATIC
 EFI_STATUS
-MvPca95xxSetOutputValue (
-  IN UINTN               ControllerIndex,
-  IN UINTN               GpioPin,
-  IN EMBEDDED_GPIO_MODE  Mode
+MvPca95xxReadShadowReg (
+  IN  UINTN   ControllerIndex,
+  IN  UINT8   Reg,
+  IN  UINTN   Bank,
+  OUT UINT8  *RegVal
   )
 {
   EFI_I2C_IO_PROTOCOL *I2cIo;
+  PCA95XX_SHADOW *Shadow;
   EFI_STATUS Status;
-  UINT8 RegVal;
-  UINTN Bank;
+  UINT8 *Cache;
+  UINT8 *Valid;
 
-  Status = MvPca95xxGetI2c (ControllerIndex, &I2cIo);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: fail to get I2C protocol\n", __FUNCTION__));
-    return EFI_DEVICE_ERROR;
+  ASSERT (Bank < PCA95XX_MAX_BANKS);
+  ASSERT (Reg == PCA95XX_OUTPUT_REG || Reg == PCA95XX_DIRECTION_REG);
+
+  Shadow = &mPca95xxInstance->Shadows[ControllerIndex];
+  if (Reg == PCA95XX_OUTPUT_REG) {
+    Cache = Shadow->Output;
+    Valid = &Shadow->OutputValid;
+  } else {
+    Cache = Shadow->Direction;
+    Valid = &Shadow->DirectionValid;
   }
 
-  Bank = GpioPin / PCA95XX_BANK_SIZE;
+  if ((*Valid & (1 << Bank)) == 0) {
+    Status = MvPca95xxGetI2c (ControllerIndex, &I2cIo);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: fail to get I2C protocol\n", __FUNCTION__));
+      return Status;
+    }
 
-  Status = MvPca95xxReadRegs (I2cIo, PCA95XX_OUTPUT_REG + Bank, &RegVal);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: fail to read device register\n", __FUNCTION__));
-    return EFI_DEVICE_ERROR;
-  }
+    Status = MvPca95xxReadRegs (I2cIo, Reg + Bank, &Cache[Bank]);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: fail to read device register\n", __FUNCTION__));
+      return Status;
+    }
 
-  if (Mode == GPIO_MODE_OUTPUT_1) {
-    RegVal |= (1 << (GpioPin % PCA95XX_BANK_SIZE));
-  } else {
-    RegVal &= ~(1 << (GpioPin % PCA95XX_BANK_SIZE));
+    *Valid |= 1 << Bank;
   }
 
-  Status = MvPca95xxWriteRegs (I2cIo, PCA95XX_OUTPUT_REG + Bank, RegVal);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: fail to write device register\n", __FUNCTION__));
-    return EFI_DEVICE_ERROR;
-  }
+  *RegVal = Cache[Bank];
 
   return EFI_SUCCESS;
 }
 
+/**
+
+Routine Description:
+
+  Updates the bits selected by Mask in a shadowed output or direction
+  register bank. The device is only written if the value changes.
+
+Arguments:
+
+  ControllerIndex - index of controller
+  Reg     - PCA95XX_OUTPUT_REG or PCA95XX_DIRECTION_REG
+  Bank    - register bank
+  Mask    - bits to update
+  Value   - new value of the bits selected by Mask
+
+Returns:
+
+  EFI_SUCCESS - register updated
+  other       - I2C transfer error
+
+**/
 STATIC
 EFI_STATUS
-MvPca95xxSetDirection (
-  IN UINTN              ControllerIndex,
-  IN UINTN              GpioPin,
-  IN EMBEDDED_GPIO_MODE Mode
+MvPca95xxUpdateShadowReg (
+  IN UINTN   ControllerIndex,
+  IN UINT8   Reg,
+  IN UINTN   Bank,
+  IN UINT8   Mask,
+  IN UINT8   Value
   )
 {
   EFI_I2C_IO_PROTOCOL *I2cIo;
+  PCA95XX_SHADOW *Shadow;
   EFI_STATUS Status;
+  UINT8 OldVal;
   UINT8 RegVal;
-  UINTN Bank;
+
+  Status = MvPca95xxReadShadowReg (ControllerIndex, Reg, Bank, &OldVal);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  RegVal = (OldVal & ~Mask) | (Value & Mask);
+  if (RegVal == OldVal) {
+    return EFI_SUCCESS;
+  }
 
   Status = MvPca95xxGetI2c (ControllerIndex, &I2cIo);
   if (EFI_ERROR (Status)) {
@@ -279,29 +346,73 @@ MvPca95xxSetDirection (
     return Status;
   }
 
-  Bank = GpioPin / PCA95XX_BANK_SIZE;
+  Shadow = &mPca95xxInstance->Shadows[ControllerIndex];
 
-  Status = MvPca95xxReadRegs (I2cIo, PCA95XX_DIRECTION_REG + Bank, &RegVal);
+  Status = MvPca95xxWriteRegs (I2cIo, Reg + Bank, RegVal);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: fail to read device register\n", __FUNCTION__));
+    DEBUG ((DEBUG_ERROR, "%a: fail to write device register\n", __FUNCTION__));
+    /* The device state is unknown, re-read it on the next access */
+    if (Reg == PCA95XX_OUTPUT_REG) {
+      Shadow->OutputValid &= ~(1 << Bank);
+    } else {
+      Shadow->DirectionValid &= ~(1 << Bank);
+    }
     return Status;
   }
 
-  if (Mode == GPIO_MODE_INPUT) {
-    RegVal |= (1 << (GpioPin % PCA95XX_BANK_SIZE));
+  if (Reg == PCA95XX_OUTPUT_REG) {
+    Shadow->Output[Bank] = RegVal;
   } else {
-    RegVal &= ~(1 << (GpioPin % PCA95XX_BANK_SIZE));
+    Shadow->Direction[Bank] = RegVal;
   }
 
-  Status = MvPca95xxWriteRegs (I2cIo, PCA95XX_DIRECTION_REG + Bank, RegVal);
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+MvPca95xxSetOutputValue (
+  IN UINTN               ControllerIndex,
+  IN UINTN               GpioPin,
+  IN EMBEDDED_GPIO_MODE  Mode
+  )
+{
+  EFI_STATUS Status;
+  UINT8 Mask;
+
+  Mask = 1 << (GpioPin % PCA95XX_BANK_SIZE);
+
+  Status = MvPca95xxUpdateShadowReg (ControllerIndex,
+             PCA95XX_OUTPUT_REG,
+             GpioPin / PCA95XX_BANK_SIZE,
+             Mask,
+             (Mode == GPIO_MODE_OUTPUT_1) ? Mask : 0);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: fail to write device register\n", __FUNCTION__));
-    return Status;
+    return EFI_DEVICE_ERROR;
   }
 
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+MvPca95xxSetDirection (
+  IN UINTN              ControllerIndex,
+  IN UINTN              GpioPin,
+  IN EMBEDDED_GPIO_MODE Mode
+  )
+{
+  UINT8 Mask;
+
+  Mask = 1 << (GpioPin % PCA95XX_BANK_SIZE);
+
+  return MvPca95xxUpdateShadowReg (ControllerIndex,
+           PCA95XX_DIRECTION_REG,
+           GpioPin / PCA95XX_BANK_SIZE,
+           Mask,
+           (Mode == GPIO_MODE_INPUT) ? Mask : 0);
+}
+
 STATIC
 EFI_STATUS
 MvPca95xxReadMode (
@@ -325,9 +436,11 @@ MvPca95xxReadMode (
 
   Bank = GpioPin / PCA95XX_BANK_SIZE;
 
-  Status = MvPca95xxReadRegs (I2cIo, PCA95XX_DIRECTION_REG + Bank, &RegVal);
+  Status = MvPca95xxReadShadowReg (ControllerIndex,
+             PCA95XX_DIRECTION_REG,
+             Bank,
+             &RegVal);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: fail to read device register\n", __FUNCTION__));
     return Status;
   }
 
@@ -616,6 +729,17 @@ MvPca95xxEntryPoint (
   mPca95xxInstance->GpioExpanders = GpioDescription->GpioExpanders;
   mPca95xxInstance->GpioExpanderCount = GpioDescription->GpioExpanderCount;
 
+  mPca95xxInstance->Shadows = AllocateZeroPool (
+                                sizeof (PCA95XX_SHADOW) *
+                                mPca95xxInstance->GpioExpanderCount);
+  if (mPca95xxInstance->Shadows == NULL) {
+    DEBUG ((DEBUG_ERROR,
+      "%a: Fail to allocate register shadows\n",
+      __FUNCTION__));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ErrShadowsAlloc;
+  }
+
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &(mPca95xxInstance->ControllerHandle),
                   &gEmbeddedGpioProtocolGuid,
@@ -630,6 +754,9 @@ MvPca95xxEntryPoint (
   return EFI_SUCCESS;
 
 ErrInstallProtocols:
+  gBS->FreePool (mPca95xxInstance->Shadows);
+
+ErrShadowsAlloc:
   gBS->FreePool (mPca95xxInstance);
 
 ErrPca95xxInstanceAlloc:
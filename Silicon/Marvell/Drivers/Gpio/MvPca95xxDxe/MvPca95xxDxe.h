@@ -20,6 +20,7 @@
 #include <Library/UefiLib.h>
 
 #include <Protocol/BoardDesc.h>
+#include <Protocol/I2cIo.h>
 #include <Protocol/MvI2c.h>
 
 #include <Uefi/UefiBaseType.h>
@@ -34,6 +35,9 @@
 #define PCA95XX_OPERATION_COUNT  2
 #define PCA95XX_OPERATION_LENGTH 1
 
+/* The widest supported expander (PCA9505) has 40 pins */
+#define PCA95XX_MAX_BANKS        5
+
 typedef enum {
   PCA9505_PIN_COUNT = 40,
   PCA9534_PIN_COUNT = 8,
@@ -48,10 +52,25 @@ typedef enum {
   PCA9557_PIN_COUNT = 16,
 } PCA95XX_PIN_COUNT;
 
+/*
+ * Shadow copies of the output and direction registers of one expander.
+ * A bank is read from the device the first time it is modified and all
+ * further updates are served from the shadow, so that changing a pin
+ * costs a single register write, or none if its state already matches.
+ */
+typedef struct {
+  EFI_I2C_IO_PROTOCOL *I2cIo;
+  UINT8                Output[PCA95XX_MAX_BANKS];
+  UINT8                Direction[PCA95XX_MAX_BANKS];
+  UINT8                OutputValid;
+  UINT8                DirectionValid;
+} PCA95XX_SHADOW;
+
 typedef struct {
   EMBEDDED_GPIO      GpioProtocol;
   MV_GPIO_EXPANDER  *GpioExpanders;
   UINTN              GpioExpanderCount;
+  PCA95XX_SHADOW    *Shadows;
   UINTN              Signature;
   EFI_HANDLE         ControllerHandle;
 } PCA95XX;
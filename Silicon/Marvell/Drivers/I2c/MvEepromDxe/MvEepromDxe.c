@@ -88,11 +88,11 @@ out:
   return Status;
 }
 
+STATIC
 EFI_STATUS
-EFIAPI
-MvEepromTransfer (
-  IN CONST MARVELL_EEPROM_PROTOCOL *This,
-  IN UINT16 Address,
+MvEepromDeviceTransfer (
+  IN EEPROM_CONTEXT *EepromContext,
+  IN UINT32 Address,
   IN UINT32 Length,
   IN UINT8 *Buffer,
   IN UINT8 Operation
@@ -101,7 +101,6 @@ MvEepromTransfer (
   EFI_I2C_REQUEST_PACKET *RequestPacket;
   UINTN RequestPacketSize;
   EFI_STATUS Status = EFI_SUCCESS;
-  EEPROM_CONTEXT *EepromContext = EEPROM_SC_FROM_EEPROM(This);
   UINT32 BufferLength;
   UINT32 Transmitted = 0;
   UINT32 CurrentAddress = Address;
@@ -144,6 +143,69 @@ MvEepromTransfer (
   return Status;
 }
 
+EFI_STATUS
+EFIAPI
+MvEepromTransfer (
+  IN CONST MARVELL_EEPROM_PROTOCOL *This,
+  IN UINT16 Address,
+  IN UINT32 Length,
+  IN UINT8 *Buffer,
+  IN UINT8 Operation
+  )
+{
+  EFI_STATUS Status;
+  EEPROM_CONTEXT *EepromContext = EEPROM_SC_FROM_EEPROM(This);
+  UINT32 CurrentAddress;
+  UINT32 Block;
+  UINT32 Offset;
+  UINT32 ChunkLength;
+
+  if (EepromContext->Cache == NULL ||
+      (UINT32)Address + Length > EEPROM_CACHE_SIZE) {
+    return MvEepromDeviceTransfer (EepromContext, Address, Length, Buffer,
+             Operation);
+  }
+
+  if (Operation != EEPROM_READ) {
+    Status = MvEepromDeviceTransfer (EepromContext, Address, Length, Buffer,
+               Operation);
+
+    /* Drop the cached copies of the blocks that were written */
+    for (Block = Address / EEPROM_CACHE_BLOCK_SIZE;
+         Block * EEPROM_CACHE_BLOCK_SIZE < (UINT32)Address + Length;
+         Block++) {
+      EepromContext->CacheValid[Block / 8] &= ~(1 << (Block % 8));
+    }
+    return Status;
+  }
+
+  CurrentAddress = Address;
+  while (Length > 0) {
+    Block = CurrentAddress / EEPROM_CACHE_BLOCK_SIZE;
+    Offset = CurrentAddress % EEPROM_CACHE_BLOCK_SIZE;
+    ChunkLength = MIN (Length, EEPROM_CACHE_BLOCK_SIZE - Offset);
+
+    if ((EepromContext->CacheValid[Block / 8] & (1 << (Block % 8))) == 0) {
+      Status = MvEepromDeviceTransfer (EepromContext,
+                 Block * EEPROM_CACHE_BLOCK_SIZE,
+                 EEPROM_CACHE_BLOCK_SIZE,
+                 &EepromContext->Cache[Block * EEPROM_CACHE_BLOCK_SIZE],
+                 EEPROM_READ);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
+      EepromContext->CacheValid[Block / 8] |= 1 << (Block % 8);
+    }
+
+    CopyMem (Buffer, &EepromContext->Cache[CurrentAddress], ChunkLength);
+    Buffer += ChunkLength;
+    CurrentAddress += ChunkLength;
+    Length -= ChunkLength;
+  }
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 EFIAPI
 MvEepromStart (
@@ -165,6 +227,9 @@ MvEepromStart (
   EepromContext->Signature = EEPROM_SIGNATURE;
   EepromContext->EepromProtocol.Transfer = MvEepromTransfer;
 
+  /* Without a cache, all accesses simply go to the device */
+  EepromContext->Cache = AllocatePool (EEPROM_CACHE_SIZE);
+
   Status = gBS->OpenProtocol (
       ControllerHandle,
       &gEfiI2cIoProtocolGuid,
@@ -175,6 +240,9 @@ MvEepromStart (
       );
   if (EFI_ERROR(Status)) {
     DEBUG((DEBUG_ERROR, "MvEeprom: failed to open I2cIo\n"));
+    if (EepromContext->Cache != NULL) {
+      FreePool(EepromContext->Cache);
+    }
     FreePool(EepromContext);
     return EFI_UNSUPPORTED;
   }
@@ -193,6 +261,9 @@ MvEepromStart (
   return Status;
 
 fail:
+  if (EepromContext->Cache != NULL) {
+    FreePool(EepromContext->Cache);
+  }
   FreePool(EepromContext);
   gBS->CloseProtocol (
       ControllerHandle,
@@ -243,6 +314,9 @@ MvEepromStop (
       gImageHandle,
       ControllerHandle
       );
+  if (EepromContext->Cache != NULL) {
+    FreePool(EepromContext->Cache);
+  }
   FreePool(EepromContext);
   return EFI_SUCCESS;
 }
@@ -14,6 +14,15 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define MAX_BUFFER_LENGTH 64
 
+/*
+ * Reads are served from an in-memory copy of the EEPROM, filled one
+ * MAX_BUFFER_LENGTH aligned block at a time as it is first accessed.
+ * The cache covers the whole 16-bit address space.
+ */
+#define EEPROM_CACHE_SIZE         SIZE_64KB
+#define EEPROM_CACHE_BLOCK_SIZE   MAX_BUFFER_LENGTH
+#define EEPROM_CACHE_BLOCKS       (EEPROM_CACHE_SIZE / EEPROM_CACHE_BLOCK_SIZE)
+
 #define I2C_GUID \
   { \
   0xadc1901b, 0xb83c, 0x4831, { 0x8f, 0x59, 0x70, 0x89, 0x8f, 0x26, 0x57, 0x1e } \
@@ -24,6 +33,8 @@ typedef struct {
   EFI_HANDLE ControllerHandle;
   EFI_I2C_IO_PROTOCOL *I2cIo;
   MARVELL_EEPROM_PROTOCOL EepromProtocol;
+  UINT8 *Cache;
+  UINT8 CacheValid[EEPROM_CACHE_BLOCKS / 8];
 } EEPROM_CONTEXT;
 
 #define EEPROM_SC_FROM_IO(a) CR (a, EEPROM_CONTEXT, I2cIo, EEPROM_SIGNATURE)
@@ -502,7 +502,11 @@ MvI2cRead (
     else
       MvI2cControlSet(I2cMasterContext, I2C_CONTROL_ACK);
 
-    gBS->Stall (I2C_OPERATION_TIMEOUT);
+    /*
+     * The ACK setting takes effect as soon as it is written, and clearing
+     * IFLG below is what makes the controller clock in the next byte, whose
+     * completion is then polled for: no need to stall for every byte.
+     */
     MvI2cClearIflg(I2cMasterContext);
 
     if (MvI2cPollCtrl(I2cMasterContext, delay, I2C_CONTROL_IFLG)) {
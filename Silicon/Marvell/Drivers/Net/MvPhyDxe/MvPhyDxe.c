@@ -168,23 +168,10 @@ MvPhyParseStatus (
 
   if ((Data & MIIM_88E1xxx_PHYSTAT_LINK) &&
     !(Data & MIIM_88E1xxx_PHYSTAT_SPDDONE)) {
-    INTN i = 0;
-
-    DEBUG((DEBUG_ERROR,"MvPhyDxe: Waiting for PHY realtime link"));
-    while (!(Data & MIIM_88E1xxx_PHYSTAT_SPDDONE)) {
-      if (i > PHY_AUTONEGOTIATE_TIMEOUT) {
-        DEBUG((DEBUG_ERROR," TIMEOUT !\n"));
-        PhyDev->LinkUp = FALSE;
-        break;
-      }
-
-      if ((i++ % 1000) == 0)
-        DEBUG((DEBUG_ERROR, "."));
-      gBS->Stall(1000);
-      Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1xxx_PHY_STATUS, &Data);
-    }
-    DEBUG((DEBUG_ERROR," done\n"));
-    gBS->Stall(500000);
+    /* Speed and duplex are not resolved yet, the link is polled later on */
+    DEBUG((DEBUG_INFO, "MvPhyDxe: link not resolved yet\n"));
+    PhyDev->LinkUp = FALSE;
+    return EFI_NOT_READY;
   } else {
     if (Data & MIIM_88E1xxx_PHYSTAT_LINK) {
       DEBUG((DEBUG_ERROR, "MvPhyDxe: link up, "));
@@ -224,10 +211,18 @@ MvPhyParseStatus (
 }
 
 /**
-  Configure PHY device autonegotiation.
+  Check PHY device autonegotiation status.
+
+  Autonegotiation was restarted by MvPhyM88e1111sConfig and completes in the
+  background, so it is not waited for here. Link state changes are picked up
+  later through the SNP GetStatus polling, which keeps ports without a cable
+  from delaying the ones that have one.
 
   @param[in out]   *PhyDevice      A pointer to configured PHY device structure.
 
+  @retval EFI_SUCCESS       Autonegotiation is complete or not supported.
+  @retval EFI_NOT_READY     Autonegotiation is still in progress.
+
 **/
 STATIC
 EFI_STATUS
@@ -236,30 +231,16 @@ MvPhyConfigureAutonegotiation (
   )
 {
   UINT32 Data;
-  INTN Index;
 
   /* Read BMSR register in order to check autoneg capabilities and status. */
   Mdio->Read (Mdio, PhyDevice->Addr, PhyDevice->MdioIndex, MII_BMSR, &Data);
 
   if ((Data & BMSR_ANEGCAPABLE) && !(Data & BMSR_ANEGCOMPLETE)) {
-
     DEBUG ((DEBUG_INFO,
-      "%a: Waiting for PHY auto negotiation...",
+      "%a: auto negotiation in progress\n",
       __FUNCTION__));
-
-    /* Wait for autonegotiation to complete and read media status */
-    for (Index = 0; !(Data & BMSR_ANEGCOMPLETE); Index++) {
-      if (Index > PHY_AUTONEGOTIATE_TIMEOUT) {
-        DEBUG ((DEBUG_ERROR, "%a: Timeout\n", __FUNCTION__));
-        PhyDevice->LinkUp = FALSE;
-        return EFI_TIMEOUT;
-      }
-      gBS->Stall (1000);  /* 1 ms */
-      Mdio->Read (Mdio, PhyDevice->Addr, PhyDevice->MdioIndex, MII_BMSR, &Data);
-    }
-
-    PhyDevice->LinkUp = TRUE;
-    DEBUG ((DEBUG_INFO, "%a: link up\n", __FUNCTION__));
+    PhyDevice->LinkUp = FALSE;
+    return EFI_NOT_READY;
   } else {
     Mdio->Read (Mdio, PhyDevice->Addr, PhyDevice->MdioIndex, MII_BMSR, &Data);
 
@@ -345,12 +326,10 @@ MvPhyInit1512 (
     return EFI_SUCCESS;
 
   Status = MvPhyConfigureAutonegotiation (PhyDev);
-  if (EFI_ERROR (Status)) {
-    return Status;
+  if (!EFI_ERROR (Status)) {
+    MvPhyParseStatus (PhyDev);
   }
 
-  MvPhyParseStatus (PhyDev);
-
   return EFI_SUCCESS;
 }
 
@@ -374,11 +353,9 @@ MvPhyInit1112 (
 
   if (PcdGetBool (PcdPhyStartupAutoneg)) {
     Status = MvPhyConfigureAutonegotiation (PhyDevice);
-    if (EFI_ERROR (Status)) {
-      return Status;
+    if (!EFI_ERROR (Status)) {
+      MvPhyParseStatus (PhyDevice);
     }
-
-    MvPhyParseStatus (PhyDevice);
   }
 
   return EFI_SUCCESS;
@@ -21,8 +21,6 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define BMSR_ANEGCAPABLE               0x0008 /* 1 = Able to perform auto-neg */
 #define BMSR_ANEGCOMPLETE              0x0020 /* 1 = Auto-neg complete */
 
-#define PHY_AUTONEGOTIATE_TIMEOUT      5000
-
 /* 88E1011 PHY Status Register */
 #define MIIM_88E1xxx_PHY_STATUS        0x11
 #define MIIM_88E1xxx_PHYSTAT_SPEED     0xc000
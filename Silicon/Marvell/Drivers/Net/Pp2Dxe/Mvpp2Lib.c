@@ -19,6 +19,7 @@ Mvpp2PrsHwWrite (
   IN OUT MVPP2_PRS_ENTRY *Pe
   )
 {
+  MVPP2_PRS_SHADOW *Shadow;
   INT32 i;
 
   if (Pe->Index > MVPP2_PRS_TCAM_SRAM_SIZE - 1) {
@@ -28,6 +29,16 @@ Mvpp2PrsHwWrite (
   /* Clear entry invalidation bit */
   Pe->Tcam.Word[MVPP2_PRS_TCAM_INV_WORD] &= ~MVPP2_PRS_TCAM_INV_MASK;
 
+  /* Skip the indirect access if hw already holds this entry */
+  Shadow = &Priv->PrsShadow[Pe->Index];
+  if (CompareMem (&Shadow->Tcam, &Pe->Tcam, sizeof (Pe->Tcam)) == 0 &&
+      CompareMem (&Shadow->Sram, &Pe->Sram, sizeof (Pe->Sram)) == 0) {
+    return 0;
+  }
+
+  CopyMem (&Shadow->Tcam, &Pe->Tcam, sizeof (Pe->Tcam));
+  CopyMem (&Shadow->Sram, &Pe->Sram, sizeof (Pe->Sram));
+
   /* Write Tcam Index - indirect access */
   Mvpp2Write (Priv, MVPP2_PRS_TCAM_IDX_REG, Pe->Index);
   for (i = 0; i < MVPP2_PRS_TCAM_WORDS; i++) {
@@ -43,7 +54,10 @@ Mvpp2PrsHwWrite (
   return 0;
 }
 
-/* Read Tcam entry from hw */
+/*
+ * Read Tcam entry. The shadow table mirrors every hw write, so the entry
+ * is taken from it instead of the indirect registers.
+ */
 STATIC
 INT32
 Mvpp2PrsHwRead (
@@ -51,30 +65,21 @@ Mvpp2PrsHwRead (
   IN OUT MVPP2_PRS_ENTRY *Pe
   )
 {
-  INT32 i;
+  MVPP2_PRS_SHADOW *Shadow;
 
   if (Pe->Index > MVPP2_PRS_TCAM_SRAM_SIZE - 1) {
     return MVPP2_EINVAL;
   }
 
-  /* Write Tcam Index - indirect access */
-  Mvpp2Write (Priv, MVPP2_PRS_TCAM_IDX_REG, Pe->Index);
+  Shadow = &Priv->PrsShadow[Pe->Index];
 
-  Pe->Tcam.Word[MVPP2_PRS_TCAM_INV_WORD] =
-    Mvpp2Read (Priv, MVPP2_PRS_TCAM_DATA_REG(MVPP2_PRS_TCAM_INV_WORD));
+  Pe->Tcam.Word[MVPP2_PRS_TCAM_INV_WORD] = Shadow->Tcam.Word[MVPP2_PRS_TCAM_INV_WORD];
   if (Pe->Tcam.Word[MVPP2_PRS_TCAM_INV_WORD] & MVPP2_PRS_TCAM_INV_MASK) {
     return MVPP2_PRS_TCAM_ENTRY_INVALID;
   }
 
-  for (i = 0; i < MVPP2_PRS_TCAM_WORDS; i++) {
-    Pe->Tcam.Word[i] = Mvpp2Read (Priv, MVPP2_PRS_TCAM_DATA_REG(i));
-  }
-
-  /* Write Sram Index - indirect access */
-  Mvpp2Write (Priv, MVPP2_PRS_SRAM_IDX_REG, Pe->Index);
-  for (i = 0; i < MVPP2_PRS_SRAM_WORDS; i++) {
-    Pe->Sram.Word[i] = Mvpp2Read (Priv, MVPP2_PRS_SRAM_DATA_REG(i));
-  }
+  CopyMem (&Pe->Tcam, &Shadow->Tcam, sizeof (Pe->Tcam));
+  CopyMem (&Pe->Sram, &Shadow->Sram, sizeof (Pe->Sram));
 
   return 0;
 }
@@ -91,6 +96,8 @@ Mvpp2PrsHwInv (
   Mvpp2Write (Priv, MVPP2_PRS_TCAM_IDX_REG, Index);
   Mvpp2Write (Priv, MVPP2_PRS_TCAM_DATA_REG(MVPP2_PRS_TCAM_INV_WORD),
         MVPP2_PRS_TCAM_INV_MASK);
+
+  Priv->PrsShadow[Index].Tcam.Word[MVPP2_PRS_TCAM_INV_WORD] = MVPP2_PRS_TCAM_INV_MASK;
 }
 
 /* Enable shadow table entry and set its lookup ID */
@@ -1505,8 +1512,8 @@ Mvpp2PrsMacInit (
   /* Place holders only - no Ports */
   Mvpp2PrsMacDropAllSet (Priv, 0, FALSE);
   Mvpp2PrsMacPromiscSet (Priv, 0, FALSE);
-  Mvpp2PrsMacMultiSet (Priv, MVPP2_PE_MAC_MC_ALL, 0, FALSE);
-  Mvpp2PrsMacMultiSet (Priv, MVPP2_PE_MAC_MC_IP6, 0, FALSE);
+  Mvpp2PrsMacMultiSet (Priv, 0, MVPP2_PE_MAC_MC_ALL, FALSE);
+  Mvpp2PrsMacMultiSet (Priv, 0, MVPP2_PE_MAC_MC_IP6, FALSE);
 }
 
 /* Set default entries for various types of dsa packets */
@@ -2215,11 +2222,18 @@ Mvpp2PrsDefaultInit (
   /* Enable Tcam table */
   Mvpp2Write (Priv, MVPP2_PRS_TCAM_CTRL_REG, MVPP2_PRS_TCAM_EN_MASK);
 
-  /* Clear all Tcam and Sram entries */
+  /*
+   * Clear all Tcam and Sram entries, leaving the Tcam entries invalidated.
+   * From now on the shadow table holds what hw contains.
+   */
   for (Index = 0; Index < MVPP2_PRS_TCAM_SRAM_SIZE; Index++) {
+    ZeroMem (&Priv->PrsShadow[Index].Tcam, sizeof (Priv->PrsShadow[Index].Tcam));
+    ZeroMem (&Priv->PrsShadow[Index].Sram, sizeof (Priv->PrsShadow[Index].Sram));
+    Priv->PrsShadow[Index].Tcam.Word[MVPP2_PRS_TCAM_INV_WORD] = MVPP2_PRS_TCAM_INV_MASK;
+
     Mvpp2Write (Priv, MVPP2_PRS_TCAM_IDX_REG, Index);
     for (i = 0; i < MVPP2_PRS_TCAM_WORDS; i++) {
-      Mvpp2Write (Priv, MVPP2_PRS_TCAM_DATA_REG(i), 0);
+      Mvpp2Write (Priv, MVPP2_PRS_TCAM_DATA_REG(i), Priv->PrsShadow[Index].Tcam.Word[i]);
     }
 
     Mvpp2Write (Priv, MVPP2_PRS_SRAM_IDX_REG, Index);
@@ -2228,11 +2242,6 @@ Mvpp2PrsDefaultInit (
     }
   }
 
-  /* Invalidate all Tcam entries */
-  for (Index = 0; Index < MVPP2_PRS_TCAM_SRAM_SIZE; Index++) {
-    Mvpp2PrsHwInv (Priv, Index);
-  }
-
   /* Always start from lookup = 0 */
   for (Index = 0; Index < MVPP2_MAX_PORTS; Index++) {
     Mvpp2PrsHwPortInit (Priv, Index, MVPP2_PRS_LU_MH, MVPP2_PRS_PORT_LU_MAX, 0);
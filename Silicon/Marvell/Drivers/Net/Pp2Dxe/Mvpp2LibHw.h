@@ -1905,6 +1905,10 @@ typedef struct {
   /* Result info */
   UINT32 Ri;
   UINT32 RiMask;
+
+  /* Copy of the hw Tcam and Sram entry */
+  union Mvpp2PrsTcamEntry Tcam;
+  union Mvpp2PrsSramEntry Sram;
 } MVPP2_PRS_SHADOW;
 
 typedef struct {
@@ -19,6 +19,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
 #include <Library/PcdLib.h>
+#include <Library/SnpStatsLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 
@@ -98,7 +99,7 @@ EFI_SIMPLE_NETWORK_MODE Pp2SnpModeTemplate = {
   },                                                    // Permanent Address
   NET_IFTYPE_ETHERNET,                                  // IfType
   TRUE,                                                 // MacAddressChangeable
-  FALSE,                                                // MultipleTxSupported
+  TRUE,                                                 // MultipleTxSupported
   TRUE,                                                 // MediaPresentSupported
   FALSE                                                 // MediaPresent
 };
@@ -142,6 +143,64 @@ QueueRemove (
   return Buffer;
 }
 
+STATIC
+UINTN
+QueueCount (
+  IN PP2DXE_CONTEXT *Pp2Context
+  )
+{
+  return (Pp2Context->CompletionQueueTail + QUEUE_DEPTH -
+          Pp2Context->CompletionQueueHead) % QUEUE_DEPTH;
+}
+
+/*
+ * Move the oldest in-flight Tx buffer to the completion queue.
+ * There is always room for it, as Pp2SnpTransmit does not accept
+ * more frames than the completion queue can hold.
+ */
+STATIC
+VOID
+Pp2DxeTxComplete (
+  IN PP2DXE_CONTEXT *Pp2Context
+  )
+{
+  EFI_STATUS Status;
+
+  ASSERT (Pp2Context->TxInFlightCount > 0);
+
+  Status = QueueInsert (Pp2Context, Pp2Context->TxInFlight[Pp2Context->TxInFlightHead]);
+  ASSERT_EFI_ERROR (Status);
+
+  Pp2Context->TxInFlight[Pp2Context->TxInFlightHead] = NULL;
+  Pp2Context->TxInFlightHead = (Pp2Context->TxInFlightHead + 1) % MVPP2_TX_MAX_IN_FLIGHT;
+  Pp2Context->TxInFlightCount--;
+}
+
+/*
+ * Reap the frames sent by HW since the last call. The physical TXQ
+ * sends them in order, so the oldest in-flight buffers are the ones done.
+ */
+STATIC
+VOID
+Pp2DxeTxReap (
+  IN PP2DXE_CONTEXT *Pp2Context
+  )
+{
+  PP2DXE_PORT *Port = &Pp2Context->Port;
+  INTN TxSent;
+
+  if (Pp2Context->TxInFlightCount == 0) {
+    return;
+  }
+
+  /* Reading the counter also resets it */
+  TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
+
+  while (TxSent-- > 0 && Pp2Context->TxInFlightCount > 0) {
+    Pp2DxeTxComplete (Pp2Context);
+  }
+}
+
 STATIC
 EFI_STATUS
 Pp2DxeBmPoolInit (
@@ -330,6 +389,54 @@ Pp2DxeSetupAggrTxqs (
   return EFI_SUCCESS;
 }
 
+/*
+ * Program the parser with the SNP receive filters (other than unicast to
+ * our station address, which is always accepted), so frames nobody asked
+ * for are dropped by HW instead of taking up BM buffers and Rx descriptors.
+ * Add = FALSE removes the entries programmed for the current filters.
+ */
+STATIC
+EFI_STATUS
+Pp2DxeSetRxFilters (
+  IN PP2DXE_CONTEXT *Pp2Context,
+  IN BOOLEAN Add
+  )
+{
+  PP2DXE_PORT *Port = &Pp2Context->Port;
+  MVPP2_SHARED *Mvpp2Shared = Pp2Context->Port.Priv;
+  EFI_SIMPLE_NETWORK_MODE *Mode = Pp2Context->Snp.Mode;
+  UINT8 MacBcast[NET_ETHER_ADDR_LEN] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+  UINTN Index;
+  INTN Ret;
+
+  if (Mode->ReceiveFilterSetting & EFI_SIMPLE_NETWORK_RECEIVE_BROADCAST) {
+    Ret = Mvpp2PrsMacDaAccept(Mvpp2Shared, Port->Id, MacBcast, Add);
+    if (Ret != 0) {
+      return EFI_DEVICE_ERROR;
+    }
+  }
+
+  if (Mode->ReceiveFilterSetting & EFI_SIMPLE_NETWORK_RECEIVE_MULTICAST) {
+    for (Index = 0; Index < Mode->MCastFilterCount; Index++) {
+      Ret = Mvpp2PrsMacDaAccept(Mvpp2Shared, Port->Id, Mode->MCastFilter[Index].Addr, Add);
+      if (Ret != 0) {
+        return EFI_DEVICE_ERROR;
+      }
+    }
+  }
+
+  if (Mode->ReceiveFilterSetting & EFI_SIMPLE_NETWORK_RECEIVE_PROMISCUOUS_MULTICAST) {
+    Mvpp2PrsMacMultiSet(Mvpp2Shared, Port->Id, MVPP2_PE_MAC_MC_ALL, Add);
+    Mvpp2PrsMacMultiSet(Mvpp2Shared, Port->Id, MVPP2_PE_MAC_MC_IP6, Add);
+  }
+
+  if (Mode->ReceiveFilterSetting & EFI_SIMPLE_NETWORK_RECEIVE_PROMISCUOUS) {
+    Mvpp2PrsMacPromiscSet(Mvpp2Shared, Port->Id, Add);
+  }
+
+  return EFI_SUCCESS;
+}
+
 STATIC
 EFI_STATUS
 Pp2DxeOpen (
@@ -338,16 +445,15 @@ Pp2DxeOpen (
 {
   PP2DXE_PORT *Port = &Pp2Context->Port;
   MVPP2_SHARED *Mvpp2Shared = Pp2Context->Port.Priv;
-  UINT8 MacBcast[NET_ETHER_ADDR_LEN] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
   UINT8 DevAddr[NET_ETHER_ADDR_LEN];
   INTN Ret;
   EFI_STATUS Status;
 
   CopyMem (DevAddr, Pp2Context->Snp.Mode->CurrentAddress.Addr, NET_ETHER_ADDR_LEN);
 
-  Ret = Mvpp2PrsMacDaAccept(Mvpp2Shared, Port->Id, MacBcast, TRUE);
-  if (Ret != 0) {
-    return EFI_DEVICE_ERROR;
+  Status = Pp2DxeSetRxFilters(Pp2Context, TRUE);
+  if (EFI_ERROR(Status)) {
+    return Status;
   }
   Ret = Mvpp2PrsMacDaAccept(Mvpp2Shared, Port->Id, DevAddr, TRUE);
   if (Ret != 0) {
@@ -701,6 +807,11 @@ Pp2DxeHalt (
 
   MvGop110PortEventsMask(Port);
   MvGop110PortDisable(Port);
+
+  /* Frames still in flight are either sent or dropped now, recycle them */
+  while (Pp2Context->TxInFlightCount > 0) {
+    Pp2DxeTxComplete (Pp2Context);
+  }
 }
 
 VOID
@@ -771,6 +882,7 @@ Pp2SnpReceiveFilters (
 {
   PP2DXE_CONTEXT *Pp2Context;
   EFI_TPL SavedTpl;
+  EFI_STATUS Status;
   UINTN Count;
 
   /* Check Snp Instance. */
@@ -817,6 +929,19 @@ Pp2SnpReceiveFilters (
       if ((MCastFilter[Count].Addr[0] & 1) == 0) {
         ReturnUnlock (SavedTpl, EFI_INVALID_PARAMETER);
       }
+    }
+  }
+
+  /* Drop the parser entries of the old filters, before they are updated */
+  Status = Pp2DxeSetRxFilters (Pp2Context, FALSE);
+  if (EFI_ERROR (Status)) {
+    ReturnUnlock (SavedTpl, Status);
+  }
+
+  if (!ResetMCastFilter &&
+      (Disable & EFI_SIMPLE_NETWORK_RECEIVE_MULTICAST) == 0 &&
+      (Enable & EFI_SIMPLE_NETWORK_RECEIVE_MULTICAST) != 0) {
+    for (Count = 0; Count < MCastFilterCnt; Count++) {
       CopyMem (&This->Mode->MCastFilter[Count],
         &MCastFilter[Count],
         sizeof (EFI_MAC_ADDRESS));
@@ -829,7 +954,9 @@ Pp2SnpReceiveFilters (
   This->Mode->ReceiveFilterSetting |= Enable;
   This->Mode->ReceiveFilterSetting &= ~Disable;
 
-  ReturnUnlock (SavedTpl, EFI_SUCCESS);
+  Status = Pp2DxeSetRxFilters (Pp2Context, TRUE);
+
+  ReturnUnlock (SavedTpl, Status);
 }
 
 EFI_STATUS
@@ -909,7 +1036,12 @@ Pp2SnpNetStat (
   OUT EFI_NETWORK_STATISTICS     *StatisticsTable  OPTIONAL
   )
 {
-  return EFI_UNSUPPORTED;
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return SnpStatsGetNetworkStatistics (INSTANCE_FROM_SNP (This)->SnpStats,
+           Reset, StatisticsSize, StatisticsTable);
 }
 
 EFI_STATUS
@@ -1010,9 +1142,9 @@ Pp2SnpNvData (
   return EFI_UNSUPPORTED;
 }
 
+STATIC
 EFI_STATUS
-EFIAPI
-Pp2SnpGetStatus (
+Pp2DxeGetStatus (
   IN EFI_SIMPLE_NETWORK_PROTOCOL *Snp,
   OUT UINT32                     *InterruptStatus OPTIONAL,
   OUT VOID                       **TxBuf OPTIONAL
@@ -1063,6 +1195,8 @@ Pp2SnpGetStatus (
   }
   Snp->Mode->MediaPresent = LinkUp;
 
+  Pp2DxeTxReap (Pp2Context);
+
   if (TxBuf != NULL) {
     *TxBuf = QueueRemove (Pp2Context);
   }
@@ -1072,7 +1206,29 @@ Pp2SnpGetStatus (
 
 EFI_STATUS
 EFIAPI
-Pp2SnpTransmit (
+Pp2SnpGetStatus (
+  IN EFI_SIMPLE_NETWORK_PROTOCOL *Snp,
+  OUT UINT32                     *InterruptStatus OPTIONAL,
+  OUT VOID                       **TxBuf OPTIONAL
+  )
+{
+  EFI_STATUS Status;
+  UINT64 StartTicks;
+
+  if (Snp == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = Pp2DxeGetStatus (Snp, InterruptStatus, TxBuf);
+  SnpStatsRecord (INSTANCE_FROM_SNP (Snp)->SnpStats, SnpStatsGetStatus, StartTicks, Status, 0);
+
+  return Status;
+}
+
+STATIC
+EFI_STATUS
+Pp2DxeTransmit (
   IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
   IN UINTN                       HeaderSize,
   IN UINTN                       BufferSize,
@@ -1087,9 +1243,7 @@ Pp2SnpTransmit (
   MVPP2_SHARED *Mvpp2Shared = Pp2Context->Port.Priv;
   MVPP2_TX_QUEUE *AggrTxq = Mvpp2Shared->AggrTxqs;
   MVPP2_TX_DESC *TxDesc;
-  EFI_STATUS Status;
-  INTN PollingCount;
-  INTN TxSent;
+  UINTN Slot;
   UINT8 *DataPtr = Buffer;
   UINT16 EtherType;
   UINT32 State = This->Mode->State;
@@ -1133,14 +1287,25 @@ Pp2SnpTransmit (
     ReturnUnlock(SavedTpl, EFI_NOT_READY);
   }
 
-  /* Fetch next descriptor */
-  TxDesc = Mvpp2TxqNextDescGet(AggrTxq);
+  /*
+   * Make room for the frame: the physical TXQ and the completion queue must
+   * be able to hold every in-flight buffer, and the aggregated TXQ needs a
+   * free descriptor.
+   */
+  Pp2DxeTxReap (Pp2Context);
+
+  if (Pp2Context->TxInFlightCount == MVPP2_TX_MAX_IN_FLIGHT ||
+      QueueCount (Pp2Context) + Pp2Context->TxInFlightCount >= QUEUE_DEPTH - 1) {
+    ReturnUnlock(SavedTpl, EFI_NOT_READY);
+  }
 
-  if (!TxDesc) {
-    DEBUG((DEBUG_ERROR, "No tx descriptor to use\n"));
-    ReturnUnlock(SavedTpl, EFI_OUT_OF_RESOURCES);
+  if (Mvpp2AggrDescNumCheck(Mvpp2Shared, AggrTxq, 1, 0)) {
+    ReturnUnlock(SavedTpl, EFI_NOT_READY);
   }
 
+  /* Fetch next descriptor */
+  TxDesc = Mvpp2TxqNextDescGet(AggrTxq);
+
   if (HeaderSize != 0) {
     CopyMem(DataPtr, DestAddr, NET_ETHER_ADDR_LEN);
 
@@ -1164,46 +1329,70 @@ Pp2SnpTransmit (
 
   InvalidateDataCacheRange (DataPtr, BufferSize);
 
-  /* Issue send */
-  Mvpp2AggrTxqPendDescAdd(Port, 1);
-
   /*
-   * Egress processing:
-   * Wait until packet is passed from per-cpu aggregated queue
-   * to physical per-port TXQ.
+   * Track the buffer until HW reports it as sent. It is handed back to
+   * the caller via GetStatus once that happens.
    */
-  PollingCount = 0;
-  TxSent = Mvpp2AggrTxqPendDescNumGet(Mvpp2Shared, 0);
-  do {
-    if (PollingCount++ > MVPP2_TX_SEND_MAX_POLLING_COUNT) {
-      DEBUG((DEBUG_ERROR, "Pp2Dxe: transmit polling failed\n"));
-      ReturnUnlock(SavedTpl, EFI_TIMEOUT);
-    }
-    TxSent = Mvpp2AggrTxqPendDescNumGet(Mvpp2Shared, 0);
-  } while (TxSent);
+  Slot = (Pp2Context->TxInFlightHead + Pp2Context->TxInFlightCount) % MVPP2_TX_MAX_IN_FLIGHT;
+  Pp2Context->TxInFlight[Slot] = Buffer;
+  Pp2Context->TxInFlightCount++;
 
-  /* Wait for packet to be transmitted by hardware. */
-  PollingCount = 0;
-  TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
-  while (!TxSent) {
-    if (PollingCount++ > MVPP2_TX_SEND_MAX_POLLING_COUNT) {
-      DEBUG((DEBUG_ERROR, "Pp2Dxe: transmit polling failed\n"));
-      ReturnUnlock(SavedTpl, EFI_TIMEOUT);
-    }
-    TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
-  }
+  /* Issue send, without waiting for it to complete */
+  Mvpp2AggrTxqPendDescAdd(Port, 1);
+  AggrTxq->count++;
 
-  /*
-   * At this point TxSent has increased - HW sent the packet
-   * Add buffer to completion queue and return.
-   */
-  Status = QueueInsert (Pp2Context, Buffer);
-  ReturnUnlock (SavedTpl, Status);
+  ReturnUnlock (SavedTpl, EFI_SUCCESS);
 }
 
 EFI_STATUS
 EFIAPI
-Pp2SnpReceive (
+Pp2SnpTransmit (
+  IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
+  IN UINTN                       HeaderSize,
+  IN UINTN                       BufferSize,
+  IN VOID                        *Buffer,
+  IN EFI_MAC_ADDRESS             *SrcAddr  OPTIONAL,
+  IN EFI_MAC_ADDRESS             *DestAddr OPTIONAL,
+  IN UINT16                      *EtherTypePtr OPTIONAL
+  )
+{
+  EFI_STATUS Status;
+  UINT64 StartTicks;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = Pp2DxeTransmit (This, HeaderSize, BufferSize, Buffer, SrcAddr, DestAddr, EtherTypePtr);
+  SnpStatsRecord (INSTANCE_FROM_SNP (This)->SnpStats, SnpStatsTransmit, StartTicks, Status, BufferSize);
+
+  return Status;
+}
+
+/* Pass a received packet's buffer back to BM */
+STATIC
+VOID
+Pp2DxeRxRefill (
+  IN PP2DXE_PORT *Port,
+  IN MVPP2_RX_QUEUE *Rxq,
+  IN UINT32 StatusReg,
+  IN UINTN PhysAddr,
+  IN UINTN VirtAddr
+  )
+{
+  INTN PoolId;
+
+  PoolId = (StatusReg & MVPP2_RXD_BM_POOL_ID_MASK) >> MVPP2_RXD_BM_POOL_ID_OFFS;
+  Mvpp2BmPoolPut (Port->Priv, PoolId, PhysAddr, VirtAddr);
+
+  /* Update counters with 1 packet received and 1 packet refilled */
+  Mvpp2RxqStatusUpdate(Port, Rxq->Id, 1, 1);
+}
+
+STATIC
+EFI_STATUS
+Pp2DxeReceive (
   IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
   OUT UINTN                      *HeaderSize OPTIONAL,
   IN OUT UINTN                   *BufferSize,
@@ -1217,10 +1406,9 @@ Pp2SnpReceive (
   PP2DXE_CONTEXT *Pp2Context;
   PP2DXE_PORT *Port;
   UINTN PhysAddr, VirtAddr;
-  EFI_STATUS Status;
   EFI_TPL SavedTpl;
   UINT32 StatusReg;
-  INTN PoolId;
+  INT32 DescIndex;
   UINTN PktLength;
   UINT8 *DataPtr;
   MVPP2_RX_DESC *RxDesc;
@@ -1260,29 +1448,40 @@ Pp2SnpReceive (
 
   ReceivedPackets = Mvpp2RxqReceived(Port, Rxq->Id);
 
-  if (ReceivedPackets == 0) {
-    ReturnUnlock(SavedTpl, EFI_NOT_READY);
-  }
+  /*
+   * Return one good packet per call. Bad ones are dropped on the way,
+   * so their buffers go back to BM without waiting for more calls.
+   */
+  while (TRUE) {
+    if (ReceivedPackets == 0) {
+      ReturnUnlock(SavedTpl, EFI_NOT_READY);
+    }
 
-  /* Process one packet per call */
-  RxDesc = Mvpp2RxqNextDescGet(Rxq);
-  StatusReg = RxDesc->status;
+    DescIndex = Rxq->NextDescToProc;
+    RxDesc = Mvpp2RxqNextDescGet(Rxq);
+    StatusReg = RxDesc->status;
 
-  /* extract addresses from descriptor */
-  PhysAddr = RxDesc->BufPhysAddrKeyHash & MVPP22_ADDR_MASK;
-  VirtAddr = RxDesc->BufCookieBmQsetClsInfo & MVPP22_ADDR_MASK;
+    /* extract addresses from descriptor */
+    PhysAddr = RxDesc->BufPhysAddrKeyHash & MVPP22_ADDR_MASK;
+    VirtAddr = RxDesc->BufCookieBmQsetClsInfo & MVPP22_ADDR_MASK;
+
+    /* Drop packets with error or with buffer header (MC, SG) */
+    if (!(StatusReg & MVPP2_RXD_BUF_HDR) && !(StatusReg & MVPP2_RXD_ERR_SUMMARY)) {
+      break;
+    }
 
-  /* Drop packets with error or with buffer header (MC, SG) */
-  if ((StatusReg & MVPP2_RXD_BUF_HDR) || (StatusReg & MVPP2_RXD_ERR_SUMMARY)) {
     DEBUG((DEBUG_WARN, "Pp2Dxe: dropping packet\n"));
-    Status = EFI_DEVICE_ERROR;
-    goto drop;
+    SnpStatsRecordDrop (Pp2Context->SnpStats, SnpStatsReceive);
+    Pp2DxeRxRefill (Port, Rxq, StatusReg, PhysAddr, VirtAddr);
+    ReceivedPackets--;
   }
 
   PktLength = (UINTN) RxDesc->DataSize - 2;
   if (PktLength > *BufferSize) {
     *BufferSize = PktLength;
     DEBUG((DEBUG_ERROR, "Pp2Dxe: buffer too small\n"));
+    /* Leave the packet in the queue, so it can be received with a larger buffer */
+    Rxq->NextDescToProc = DescIndex;
     ReturnUnlock(SavedTpl, EFI_BUFFER_TOO_SMALL);
   }
 
@@ -1312,17 +1511,36 @@ Pp2SnpReceive (
     *EtherType = NTOHS (*(UINT16 *)(&DataPtr[12]));
   }
 
-  Status = EFI_SUCCESS;
+  Pp2DxeRxRefill (Port, Rxq, StatusReg, PhysAddr, VirtAddr);
 
-drop:
-  /* Refill: pass packet back to BM */
-  PoolId = (StatusReg & MVPP2_RXD_BM_POOL_ID_MASK) >> MVPP2_RXD_BM_POOL_ID_OFFS;
-  Mvpp2BmPoolPut (Pp2Context->Port.Priv, PoolId, PhysAddr, VirtAddr);
+  ReturnUnlock(SavedTpl, EFI_SUCCESS);
+}
 
-  /* Update counters with 1 packet received and 1 packet refilled */
-  Mvpp2RxqStatusUpdate(Port, Rxq->Id, 1, 1);
+EFI_STATUS
+EFIAPI
+Pp2SnpReceive (
+  IN EFI_SIMPLE_NETWORK_PROTOCOL *This,
+  OUT UINTN                      *HeaderSize OPTIONAL,
+  IN OUT UINTN                   *BufferSize,
+  OUT VOID                       *Buffer,
+  OUT EFI_MAC_ADDRESS            *SrcAddr OPTIONAL,
+  OUT EFI_MAC_ADDRESS            *DstAddr OPTIONAL,
+  OUT UINT16                     *EtherType OPTIONAL
+  )
+{
+  EFI_STATUS Status;
+  UINT64 StartTicks;
 
-  ReturnUnlock(SavedTpl, Status);
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = Pp2DxeReceive (This, HeaderSize, BufferSize, Buffer, SrcAddr, DstAddr, EtherType);
+  SnpStatsRecord (INSTANCE_FROM_SNP (This)->SnpStats, SnpStatsReceive, StartTicks, Status,
+    EFI_ERROR (Status) ? 0 : *BufferSize);
+
+  return Status;
 }
 
 EFI_STATUS
@@ -1374,9 +1592,16 @@ Pp2DxeSnpInstall (
 
   if (EFI_ERROR(Status)) {
     DEBUG((DEBUG_ERROR, "Failed to install protocols.\n"));
+    return Status;
   }
 
-  return Status;
+  /* Statistics are optional, the interface works without them */
+  Status = SnpStatsInstall (Handle, &Pp2Context->SnpStats);
+  if (EFI_ERROR(Status)) {
+    DEBUG((DEBUG_WARN, "Pp2Dxe%d: no statistics: %r\n", Pp2Context->Instance, Status));
+  }
+
+  return EFI_SUCCESS;
 }
 
 /**
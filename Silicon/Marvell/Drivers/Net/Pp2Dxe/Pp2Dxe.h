@@ -25,6 +25,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
 #include <Library/PcdLib.h>
+#include <Library/SnpStatsLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 
@@ -143,10 +144,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define MTU                               1500
 
 /*
- * Maximum retries of checking, wheter HW really sent the packet
- * after it was done is software.
+ * Maximum number of frames handed to the hardware, whose buffers
+ * were not recycled yet. Bounded by the size of the physical TXQ.
  */
-#define MVPP2_TX_SEND_MAX_POLLING_COUNT   10000
+#define MVPP2_TX_MAX_IN_FLIGHT            MVPP2_MAX_TXD
 
 /* Structures */
 typedef struct {
@@ -338,9 +339,14 @@ typedef struct {
   VOID                        *CompletionQueue[QUEUE_DEPTH];
   UINTN                       CompletionQueueHead;
   UINTN                       CompletionQueueTail;
+  /* Transmitted buffers not yet reported as sent by HW, oldest first */
+  VOID                        *TxInFlight[MVPP2_TX_MAX_IN_FLIGHT];
+  UINTN                       TxInFlightHead;
+  UINTN                       TxInFlightCount;
   EFI_EVENT                   EfiExitBootServicesEvent;
   PP2_DEVICE_PATH             *DevicePath;
   EFI_ADAPTER_INFORMATION_PROTOCOL Aip;
+  SNP_STATS_CONTEXT           *SnpStats;
 } PP2DXE_CONTEXT;
 
 /* Inline helpers */
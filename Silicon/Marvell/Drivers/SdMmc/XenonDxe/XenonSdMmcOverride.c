@@ -342,6 +342,27 @@ XenonSdMmcCapability (
     Capability &= ~(UINT64)(SDHC_CAP_SDR104 | SDHC_CAP_DDR50 | SDHC_CAP_HS400);
   }
 
+  //
+  // HS400 isn't advertised by the controller itself. It needs 1.8V
+  // signaling and an 8-bit bus, and is entered after HS200 tuning, which
+  // slow mode rules out.
+  //
+  if (SdMmcDesc.Xenon1v8Enabled &&
+      SdMmcDesc.Xenon8BitBusEnabled &&
+      !SdMmcDesc.XenonSlowModeEnabled) {
+    Capability |= SDHC_CAP_HS400;
+  }
+
+  //
+  // ADMA2 and 64-bit addressing are kept as reported, the generic
+  // SdMmcPciHcDxe driver selects 64-bit ADMA2 from them.
+  //
+  DEBUG ((DEBUG_INFO, "%a: ADMA2 %a, 64-bit DMA %a, HS400 %a\n",
+    __FUNCTION__,
+    (Capability & SDHC_CAP_ADMA2) ? "yes" : "no",
+    (Capability & SDHC_CAP_SYS_BUS_64_V3) ? "yes" : "no",
+    (Capability & SDHC_CAP_HS400) ? "yes" : "no"));
+
   Capability &= ~(UINT64)(SDHC_CAP_SLOT_TYPE_MASK);
   Capability |= SdMmcDesc.SlotType << SDHC_CAP_SLOT_TYPE_OFFSET;
 
@@ -47,9 +47,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define UHS_MODE_SELECT_MASK          0x7
 #define SDHC_CAP                      0x0040
 #define SDHC_CAP_BUS_WIDTH8           BIT18
+#define SDHC_CAP_ADMA2                BIT19
 #define SDHC_CAP_VOLTAGE_33           BIT24
 #define SDHC_CAP_VOLTAGE_30           BIT25
 #define SDHC_CAP_VOLTAGE_18           BIT26
+#define SDHC_CAP_SYS_BUS_64_V3        BIT28
 #define SDHC_CAP_SLOT_TYPE_OFFSET     30
 #define SDHC_CAP_SLOT_TYPE_MASK       (BIT30 | BIT31)
 #define SDHC_CAP_SDR50                BIT32
@@ -144,8 +146,6 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define SDHC_REG_SIZE_2B              2
 #define SDHC_REG_SIZE_4B              4
 
-#define SDHC_DAT_BUF_PORT_ADDR        0xF06E0020
-
 /* Command register bits description */
 #define RESP_TYPE_136_BITS            (1 << 0)
 #define RESP_TYPE_48_BITS             (1 << 1)
@@ -302,7 +302,6 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 /* Max retry count for INT status ready */
 #define SDHC_INT_STATUS_POLL_RETRY              1000
-#define SDHC_INT_STATUS_POLL_RETRY_DATA_TRAN    100000
 
 /* Take 2.5 seconds as generic time out value, 1 microsecond as unit */
 #define SD_GENERIC_TIMEOUT            2500 * 1000
@@ -389,17 +388,6 @@ XenonReset (
   IN UINT8 Mask
   );
 
-EFI_STATUS
-XenonTransferData (
-  IN EFI_PCI_IO_PROTOCOL *PciIo,
-  IN UINT8 Slot,
-  IN OUT VOID *Buffer,
-  IN UINT32 DataLen,
-  IN UINT16 BlockSize,
-  IN UINT16 Blocks,
-  IN BOOLEAN Read
-  );
-
 EFI_STATUS
 XenonInit (
   IN EFI_PCI_IO_PROTOCOL   *PciIo,
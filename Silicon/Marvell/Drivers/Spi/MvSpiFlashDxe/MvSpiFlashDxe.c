@@ -230,7 +230,10 @@ MvSpiFlashRead (
     }
     SpiFlashFormatAddress (ReadAddr, Slave->AddrSize, Cmd);
     // Program proper read address and read data
-    Status = MvSpiFlashReadCmd (Slave, Cmd, Slave->AddrSize + 2, Buf, Length);
+    Status = MvSpiFlashReadCmd (Slave, Cmd, Slave->AddrSize + 2, Buf, ReadLength);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
 
     Offset += ReadLength;
     Length -= ReadLength;
@@ -283,6 +286,30 @@ MvSpiFlashWrite (
   return EFI_SUCCESS;
 }
 
+STATIC
+BOOLEAN
+MvSpiFlashIsErased (
+  IN UINT8 *Buf,
+  IN UINTN Length
+  )
+{
+  UINTN Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    if (Buf[Index] != 0xFF) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/*
+ * Update a single erase block, touching the flash only where needed.
+ * Pages that already hold the requested data are not programmed, and the
+ * erase is skipped altogether if the new data only clears bits of the
+ * current contents, since page program can turn 1s into 0s on its own.
+ */
 STATIC
 EFI_STATUS
 MvSpiFlashUpdateBlock (
@@ -295,34 +322,70 @@ MvSpiFlashUpdateBlock (
   )
 {
   EFI_STATUS Status;
+  UINTN Index, Length, PageSize;
+  BOOLEAN Changed, NeedErase;
+
+  PageSize = Slave->Info->PageSize;
 
-  // Read backup
+  // Read current contents
   Status = MvSpiFlashRead (Slave, Offset, EraseSize, TmpBuf);
-    if (EFI_ERROR (Status)) {
-      DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while reading old data\n"));
-      return Status;
+  if (EFI_ERROR (Status)) {
+    DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while reading old data\n"));
+    return Status;
+  }
+
+  Changed = FALSE;
+  NeedErase = FALSE;
+  for (Index = 0; Index < ToUpdate; Index++) {
+    if (TmpBuf[Index] != Buf[Index]) {
+      Changed = TRUE;
+      if ((TmpBuf[Index] & Buf[Index]) != Buf[Index]) {
+        NeedErase = TRUE;
+        break;
+      }
+    }
+  }
+
+  if (!Changed) {
+    return EFI_SUCCESS;
+  }
+
+  if (!NeedErase) {
+    // Program only the pages that differ, on top of the current contents
+    for (Index = 0; Index < ToUpdate; Index += Length) {
+      Length = MIN (ToUpdate - Index, PageSize - ((Offset + Index) % PageSize));
+      if (CompareMem (&TmpBuf[Index], &Buf[Index], Length) == 0) {
+        continue;
+      }
+
+      Status = MvSpiFlashWrite (Slave, Offset + Index, Length, &Buf[Index]);
+      if (EFI_ERROR (Status)) {
+        DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while writing new data\n"));
+        return Status;
+      }
     }
 
+    return EFI_SUCCESS;
+  }
+
   // Erase entire sector
   Status = MvSpiFlashErase (Slave, Offset, EraseSize);
   if (EFI_ERROR (Status)) {
-      DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while erasing block\n"));
-      return Status;
-    }
+    DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while erasing block\n"));
+    return Status;
+  }
 
-  // Write new data
-  MvSpiFlashWrite (Slave, Offset, ToUpdate, Buf);
-  if (EFI_ERROR (Status)) {
-      DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while writing new data\n"));
-      return Status;
+  // Merge new data with the backup and program all non-blank pages
+  CopyMem (TmpBuf, Buf, ToUpdate);
+  for (Index = 0; Index < EraseSize; Index += Length) {
+    Length = MIN (EraseSize - Index, PageSize - ((Offset + Index) % PageSize));
+    if (MvSpiFlashIsErased (&TmpBuf[Index], Length)) {
+      continue;
     }
 
-  // Write backup
-  if (ToUpdate != EraseSize) {
-    Status = MvSpiFlashWrite (Slave, Offset + ToUpdate, EraseSize - ToUpdate,
-      &TmpBuf[ToUpdate]);
+    Status = MvSpiFlashWrite (Slave, Offset + Index, Length, &TmpBuf[Index]);
     if (EFI_ERROR (Status)) {
-      DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while writing backup\n"));
+      DEBUG((DEBUG_ERROR, "SpiFlash: Update: Error while writing new data\n"));
       return Status;
     }
   }
@@ -159,6 +159,51 @@ SpiSetupTransfer (
   EfiReleaseLock (&SpiMaster->Lock);
 }
 
+STATIC
+VOID
+SpiSetWordLength (
+  IN UINTN   SpiRegBase,
+  IN BOOLEAN Use16Bit
+  )
+{
+  UINT32 Reg;
+
+  Reg = MmioRead32 (SpiRegBase + SPI_CONF_REG);
+  if (Use16Bit) {
+    Reg |= SPI_BYTE_LENGTH;
+  } else {
+    Reg &= ~SPI_BYTE_LENGTH;
+  }
+  MmioWrite32 (SpiRegBase + SPI_CONF_REG, Reg);
+}
+
+STATIC
+EFI_STATUS
+SpiTransferWord (
+  IN  UINTN   SpiRegBase,
+  IN  UINT32  DataOut,
+  OUT UINT32  *DataIn OPTIONAL
+  )
+{
+  UINT32 Iterator;
+
+  // Transmit Data
+  MmioWrite32 (SpiRegBase + SPI_INT_CAUSE_REG, 0x0);
+  MmioWrite32 (SpiRegBase + SPI_DATA_OUT_REG, DataOut);
+  // Wait for memory ready
+  for (Iterator = 0; Iterator < SPI_TIMEOUT; Iterator++) {
+    if (MmioRead32 (SpiRegBase + SPI_INT_CAUSE_REG)) {
+      if (DataIn != NULL) {
+        *DataIn = MmioRead32 (SpiRegBase + SPI_DATA_IN_REG);
+      }
+      return EFI_SUCCESS;
+    }
+  }
+
+  DEBUG ((DEBUG_ERROR, "%a: Timeout\n", __FUNCTION__));
+  return EFI_TIMEOUT;
+}
+
 EFI_STATUS
 EFIAPI
 MvSpiTransfer (
@@ -171,18 +216,18 @@ MvSpiTransfer (
   )
 {
   SPI_MASTER *SpiMaster;
-  UINT64  Length;
-  UINT32  Iterator, Reg;
+  EFI_STATUS Status;
+  UINTN   Index, WordCount;
+  UINT32  Word;
   UINT8   *DataOutPtr = (UINT8 *)DataOut;
   UINT8   *DataInPtr  = (UINT8 *)DataIn;
-  UINT8   DataToSend  = 0;
   UINTN   SpiRegBase;
 
   SpiMaster = SPI_MASTER_FROM_SPI_MASTER_PROTOCOL (This);
 
   SpiRegBase = Slave->HostRegisterBaseAddress;
 
-  Length = 8 * DataByteCount;
+  Status = EFI_SUCCESS;
 
   if (!EfiAtRuntime ()) {
     EfiAcquireLock (&SpiMaster->Lock);
@@ -192,40 +237,59 @@ MvSpiTransfer (
     SpiActivateCs (Slave);
   }
 
-  // Set 8-bit mode
-  Reg = MmioRead32 (SpiRegBase + SPI_CONF_REG);
-  Reg &= ~SPI_BYTE_LENGTH;
-  MmioWrite32 (SpiRegBase + SPI_CONF_REG, Reg);
+  //
+  // The controller has no FIFO, so every word costs a full round trip
+  // through the data and cause registers. Move the bulk of the data in
+  // 16-bit mode, which halves the number of these round trips, and send
+  // an odd trailing byte in 8-bit mode. Words are shifted out MSB first,
+  // so the first byte of each pair goes into the upper half.
+  //
+  WordCount = DataByteCount / 2;
+  if (WordCount > 0) {
+    SpiSetWordLength (SpiRegBase, TRUE);
+
+    for (Index = 0; Index < WordCount; Index++) {
+      Word = 0;
+      if (DataOutPtr != NULL) {
+        Word = (DataOutPtr[0] << 8) | DataOutPtr[1];
+        DataOutPtr += 2;
+      }
 
-  while (Length > 0) {
-    if (DataOut != NULL) {
-      DataToSend = *DataOutPtr & 0xFF;
-    }
-    // Transmit Data
-    MmioWrite32 (SpiRegBase + SPI_INT_CAUSE_REG, 0x0);
-    MmioWrite32 (SpiRegBase + SPI_DATA_OUT_REG, DataToSend);
-    // Wait for memory ready
-    for (Iterator = 0; Iterator < SPI_TIMEOUT; Iterator++) {
-      if (MmioRead32 (SpiRegBase + SPI_INT_CAUSE_REG)) {
-        if (DataInPtr != NULL) {
-          *DataInPtr = MmioRead32 (SpiRegBase + SPI_DATA_IN_REG);
-          DataInPtr++;
-        }
-        if (DataOutPtr != NULL) {
-          DataOutPtr++;
-        }
-        Length -= 8;
-        break;
+      Status = SpiTransferWord (SpiRegBase, Word,
+                 (DataInPtr != NULL) ? &Word : NULL);
+      if (EFI_ERROR (Status)) {
+        goto Exit;
+      }
+
+      if (DataInPtr != NULL) {
+        DataInPtr[0] = (UINT8)(Word >> 8);
+        DataInPtr[1] = (UINT8)Word;
+        DataInPtr += 2;
       }
     }
+  }
+
+  if (DataByteCount & 1) {
+    SpiSetWordLength (SpiRegBase, FALSE);
+
+    Word = 0;
+    if (DataOutPtr != NULL) {
+      Word = *DataOutPtr;
+    }
 
-    if (Iterator >= SPI_TIMEOUT) {
-      DEBUG ((DEBUG_ERROR, "%a: Timeout\n", __FUNCTION__));
-      return EFI_TIMEOUT;
+    Status = SpiTransferWord (SpiRegBase, Word,
+               (DataInPtr != NULL) ? &Word : NULL);
+    if (EFI_ERROR (Status)) {
+      goto Exit;
+    }
+
+    if (DataInPtr != NULL) {
+      *DataInPtr = (UINT8)Word;
     }
   }
 
-  if (Flag & SPI_TRANSFER_END) {
+Exit:
+  if ((Flag & SPI_TRANSFER_END) || EFI_ERROR (Status)) {
     SpiDeactivateCs (Slave);
   }
 
@@ -233,7 +297,7 @@ MvSpiTransfer (
     EfiReleaseLock (&SpiMaster->Lock);
   }
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 EFI_STATUS
@@ -148,14 +148,35 @@ ComPhySataPowerUp (
 
   ComPhySataPhyPowerUp (Desc[ChipId].SoC->AhciBaseAddress);
 
-  Status = ComPhySmc (MV_SMC_ID_COMPHY_PLL_LOCK,
-             ComPhyBase,
-             Lane,
-             COMPHY_FW_FORMAT (COMPHY_SATA_MODE,
-               Desc[ChipId].SoC->AhciId,
-               COMPHY_SPEED_DEFAULT));
+  return Status;
+}
+
+/*
+ * Wait for the PLL of a SATA lane, powered up earlier by ComPhySataPowerUp,
+ * to lock. This is done only after all lanes of the chip have been powered
+ * up, so that the PLL settling time overlaps with the other lanes bring-up.
+ * On failure, the lane is powered off again.
+ */
+STATIC
+EFI_STATUS
+ComPhySataPllLock (
+  IN UINTN ChipId,
+  IN UINT32 Lane,
+  IN EFI_PHYSICAL_ADDRESS ComPhyBase,
+  IN MV_BOARD_AHCI_DESC *Desc
+  )
+{
+  EFI_STATUS Status;
+  UINT32 Mode;
+
+  Mode = COMPHY_FW_FORMAT (COMPHY_SATA_MODE,
+           Desc[ChipId].SoC->AhciId,
+           COMPHY_SPEED_DEFAULT);
+
+  Status = ComPhySmc (MV_SMC_ID_COMPHY_PLL_LOCK, ComPhyBase, Lane, Mode);
   if (EFI_ERROR (Status)) {
-    return Status;
+    DEBUG ((DEBUG_ERROR, "ComPhySata: PLL lock failed on Lane %d\n", Lane));
+    ComPhySmc (MV_SMC_ID_COMPHY_POWER_OFF, ComPhyBase, Lane, Mode);
   }
 
   return Status;
@@ -169,8 +190,8 @@ ComPhyCp110Init (
   EFI_STATUS Status;
   COMPHY_MAP *PtrComPhyMap, *SerdesMap;
   EFI_PHYSICAL_ADDRESS ComPhyBaseAddr, HpipeBaseAddr;
-  MARVELL_BOARD_DESC_PROTOCOL *BoardDescProtocol;
-  MV_BOARD_AHCI_DESC *AhciBoardDesc;
+  MARVELL_BOARD_DESC_PROTOCOL *BoardDescProtocol = NULL;
+  MV_BOARD_AHCI_DESC *AhciBoardDesc = NULL;
   UINT32 ComPhyMaxCount, Lane;
   UINT32 PcieWidth = 0;
   UINT8 ChipId;
@@ -218,18 +239,21 @@ ComPhyCp110Init (
     case COMPHY_TYPE_SATA1:
     case COMPHY_TYPE_SATA2:
     case COMPHY_TYPE_SATA3:
-      /* Obtain AHCI board description */
-      Status = gBS->LocateProtocol (&gMarvellBoardDescProtocolGuid,
-                      NULL,
-                      (VOID **)&BoardDescProtocol);
-      if (EFI_ERROR (Status)) {
-        break;
-      }
-
-      Status = BoardDescProtocol->BoardDescAhciGet (BoardDescProtocol,
-                                    &AhciBoardDesc);
-      if (EFI_ERROR (Status)) {
-        break;
+      /* Obtain AHCI board description, shared by all SATA lanes */
+      if (AhciBoardDesc == NULL) {
+        Status = gBS->LocateProtocol (&gMarvellBoardDescProtocolGuid,
+                        NULL,
+                        (VOID **)&BoardDescProtocol);
+        if (EFI_ERROR (Status)) {
+          break;
+        }
+
+        Status = BoardDescProtocol->BoardDescAhciGet (BoardDescProtocol,
+                                      &AhciBoardDesc);
+        if (EFI_ERROR (Status)) {
+          AhciBoardDesc = NULL;
+          break;
+        }
       }
 
       Status = ComPhySataPowerUp (ChipId,
@@ -237,8 +261,6 @@ ComPhyCp110Init (
                  HpipeBaseAddr,
                  ComPhyBaseAddr,
                  AhciBoardDesc);
-
-      BoardDescProtocol->BoardDescFree (AhciBoardDesc);
       break;
     case COMPHY_TYPE_USB3_HOST0:
     case COMPHY_TYPE_USB3_HOST1:
@@ -285,4 +307,24 @@ ComPhyCp110Init (
       PtrComPhyMap->Type = COMPHY_TYPE_UNCONNECTED;
     }
   }
+
+  if (AhciBoardDesc == NULL) {
+    return;
+  }
+
+  /* Wait for the PLL lock of all SATA lanes, once every lane is powered up */
+  for (Lane = 0, PtrComPhyMap = SerdesMap; Lane < ComPhyMaxCount;
+       Lane++, PtrComPhyMap++) {
+    if (PtrComPhyMap->Type < COMPHY_TYPE_SATA0 ||
+        PtrComPhyMap->Type > COMPHY_TYPE_SATA3) {
+      continue;
+    }
+
+    Status = ComPhySataPllLock (ChipId, Lane, ComPhyBaseAddr, AhciBoardDesc);
+    if (EFI_ERROR(Status)) {
+      PtrComPhyMap->Type = COMPHY_TYPE_UNCONNECTED;
+    }
+  }
+
+  BoardDescProtocol->BoardDescFree (AhciBoardDesc);
 }
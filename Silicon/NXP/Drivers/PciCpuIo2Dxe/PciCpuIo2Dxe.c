@@ -232,6 +232,7 @@ CpuMemoryServiceRead (
   UINT8                      OutStride;
   EFI_CPU_IO_PROTOCOL_WIDTH  OperationWidth;
   UINT8                      *Uint8Buffer;
+  UINTN                      Length;
 
   Status = CpuIoCheckParameter (TRUE, Width, Address, Count, Buffer);
   if (EFI_ERROR (Status)) {
@@ -244,6 +245,21 @@ CpuMemoryServiceRead (
   InStride = mInStride[Width];
   OutStride = mOutStride[Width];
   OperationWidth = (EFI_CPU_IO_PROTOCOL_WIDTH) (Width & 0x03);
+
+  //
+  // Plain increment transfers whose address, buffer and length are all 64-bit
+  // aligned are carried out using 64-bit accesses, whatever the element width.
+  // CopyMem () is not used, since it may issue unaligned or paired accesses,
+  // which are not permitted on device memory.
+  //
+  if (Width <= EfiCpuIoWidthUint64) {
+    Length = Count << OperationWidth;
+    if (((Address | (UINTN)Buffer | Length) & (sizeof (UINT64) - 1)) == 0) {
+      MmioReadBuffer64 ((UINTN)Address, Length, Buffer);
+      return EFI_SUCCESS;
+    }
+  }
+
   for (Uint8Buffer = Buffer; Count > 0; Address += InStride, Uint8Buffer += OutStride, Count--) {
     if (OperationWidth == EfiCpuIoWidthUint8) {
       *Uint8Buffer = MmioRead8 ((UINTN)Address);
@@ -312,6 +328,7 @@ CpuMemoryServiceWrite (
   UINT8                      OutStride;
   EFI_CPU_IO_PROTOCOL_WIDTH  OperationWidth;
   UINT8                      *Uint8Buffer;
+  UINTN                      Length;
 
   Status = CpuIoCheckParameter (TRUE, Width, Address, Count, Buffer);
   if (EFI_ERROR (Status)) {
@@ -324,6 +341,21 @@ CpuMemoryServiceWrite (
   InStride = mInStride[Width];
   OutStride = mOutStride[Width];
   OperationWidth = (EFI_CPU_IO_PROTOCOL_WIDTH) (Width & 0x03);
+
+  //
+  // Plain increment transfers whose address, buffer and length are all 64-bit
+  // aligned are carried out using 64-bit accesses, whatever the element width.
+  // CopyMem () is not used, since it may issue unaligned or paired accesses,
+  // which are not permitted on device memory.
+  //
+  if (Width <= EfiCpuIoWidthUint64) {
+    Length = Count << OperationWidth;
+    if (((Address | (UINTN)Buffer | Length) & (sizeof (UINT64) - 1)) == 0) {
+      MmioWriteBuffer64 ((UINTN)Address, Length, Buffer);
+      return EFI_SUCCESS;
+    }
+  }
+
   for (Uint8Buffer = Buffer; Count > 0; Address += InStride, Uint8Buffer += OutStride, Count--) {
     if (OperationWidth == EfiCpuIoWidthUint8) {
       MmioWrite8 ((UINTN)Address, *Uint8Buffer);
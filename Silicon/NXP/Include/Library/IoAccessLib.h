@@ -31,8 +31,146 @@ typedef struct _MMIO_OPERATIONS {
   UINT64 (*Or64) (UINTN Address, UINT64 OrData);
   UINT64 (*And64) (UINTN Address, UINT64 AndData);
   UINT64 (*AndThenOr64) (UINTN Address, UINT64 AndData, UINT64 OrData);
+  UINT16 *(*ReadBuffer16) (UINTN StartAddress, UINTN Length, UINT16 *Buffer);
+  UINT16 *(*WriteBuffer16) (UINTN StartAddress, UINTN Length, CONST UINT16 *Buffer);
+  UINT32 *(*ReadBuffer32) (UINTN StartAddress, UINTN Length, UINT32 *Buffer);
+  UINT32 *(*WriteBuffer32) (UINTN StartAddress, UINTN Length, CONST UINT32 *Buffer);
+  UINT64 *(*ReadBuffer64) (UINTN StartAddress, UINTN Length, UINT64 *Buffer);
+  UINT64 *(*WriteBuffer64) (UINTN StartAddress, UINTN Length, CONST UINT64 *Buffer);
 } MMIO_OPERATIONS;
 
+/**
+  MmioReadBuffer16 for Big-Endian modules.
+
+  Copy data from the MMIO region to system memory, swapping every
+  16-bit unit. When the endianness of a module is fixed at build time,
+  calling this (or MmioReadBuffer16) directly on a FeaturePcdGet ()
+  condition avoids the dispatch through MMIO_OPERATIONS.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied from.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer receiving the data read.
+
+  @return Buffer
+
+**/
+UINT16 *
+EFIAPI
+SwapMmioReadBuffer16 (
+  IN  UINTN       StartAddress,
+  IN  UINTN       Length,
+  OUT UINT16      *Buffer
+  );
+
+/**
+  MmioWriteBuffer16 for Big-Endian modules.
+
+  Copy data from system memory to the MMIO region, swapping every
+  16-bit unit.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied to.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer containing the data to write.
+
+  @return Buffer
+
+**/
+UINT16 *
+EFIAPI
+SwapMmioWriteBuffer16 (
+  IN  UINTN         StartAddress,
+  IN  UINTN         Length,
+  IN  CONST UINT16  *Buffer
+  );
+
+/**
+  MmioReadBuffer32 for Big-Endian modules.
+
+  Copy data from the MMIO region to system memory, swapping every
+  32-bit unit. When the endianness of a module is fixed at build time,
+  calling this (or MmioReadBuffer32) directly on a FeaturePcdGet ()
+  condition avoids the dispatch through MMIO_OPERATIONS.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied from.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer receiving the data read.
+
+  @return Buffer
+
+**/
+UINT32 *
+EFIAPI
+SwapMmioReadBuffer32 (
+  IN  UINTN       StartAddress,
+  IN  UINTN       Length,
+  OUT UINT32      *Buffer
+  );
+
+/**
+  MmioWriteBuffer32 for Big-Endian modules.
+
+  Copy data from system memory to the MMIO region, swapping every
+  32-bit unit.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied to.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer containing the data to write.
+
+  @return Buffer
+
+**/
+UINT32 *
+EFIAPI
+SwapMmioWriteBuffer32 (
+  IN  UINTN         StartAddress,
+  IN  UINTN         Length,
+  IN  CONST UINT32  *Buffer
+  );
+
+/**
+  MmioReadBuffer64 for Big-Endian modules.
+
+  Copy data from the MMIO region to system memory, swapping every
+  64-bit unit. When the endianness of a module is fixed at build time,
+  calling this (or MmioReadBuffer64) directly on a FeaturePcdGet ()
+  condition avoids the dispatch through MMIO_OPERATIONS.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied from.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer receiving the data read.
+
+  @return Buffer
+
+**/
+UINT64 *
+EFIAPI
+SwapMmioReadBuffer64 (
+  IN  UINTN       StartAddress,
+  IN  UINTN       Length,
+  OUT UINT64      *Buffer
+  );
+
+/**
+  MmioWriteBuffer64 for Big-Endian modules.
+
+  Copy data from system memory to the MMIO region, swapping every
+  64-bit unit.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied to.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer containing the data to write.
+
+  @return Buffer
+
+**/
+UINT64 *
+EFIAPI
+SwapMmioWriteBuffer64 (
+  IN  UINTN         StartAddress,
+  IN  UINTN         Length,
+  IN  CONST UINT64  *Buffer
+  );
+
 /**
   Function to return pointer to Mmio operations.
 
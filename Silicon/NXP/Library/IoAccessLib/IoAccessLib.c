@@ -10,6 +10,7 @@
 
 #include <Base.h>
 #include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
 #include <Library/IoAccessLib.h>
 #include <Library/IoLib.h>
 
@@ -316,6 +317,228 @@ SwapMmioAnd64 (
   return MmioAnd64 (Address, SwapBytes64 (AndData));
 }
 
+/**
+  MmioReadBuffer16 for Big-Endian modules.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied from.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer receiving the data read.
+
+  @return Buffer
+
+**/
+UINT16 *
+EFIAPI
+SwapMmioReadBuffer16 (
+  IN  UINTN       StartAddress,
+  IN  UINTN       Length,
+  OUT UINT16      *Buffer
+  )
+{
+  UINT16  *ReturnBuffer;
+
+  ASSERT ((StartAddress & (sizeof (UINT16) - 1)) == 0);
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - StartAddress));
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - (UINTN)Buffer));
+  ASSERT ((Length & (sizeof (UINT16) - 1)) == 0);
+  ASSERT (((UINTN)Buffer & (sizeof (UINT16) - 1)) == 0);
+
+  ReturnBuffer = Buffer;
+
+  while (Length != 0) {
+    *(Buffer++) = SwapBytes16 (MmioRead16 (StartAddress));
+    StartAddress += sizeof (UINT16);
+    Length -= sizeof (UINT16);
+  }
+
+  return ReturnBuffer;
+}
+
+/**
+  MmioWriteBuffer16 for Big-Endian modules.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied to.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer containing the data to write.
+
+  @return Buffer
+
+**/
+UINT16 *
+EFIAPI
+SwapMmioWriteBuffer16 (
+  IN  UINTN         StartAddress,
+  IN  UINTN         Length,
+  IN  CONST UINT16  *Buffer
+  )
+{
+  UINT16  *ReturnBuffer;
+
+  ASSERT ((StartAddress & (sizeof (UINT16) - 1)) == 0);
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - StartAddress));
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - (UINTN)Buffer));
+  ASSERT ((Length & (sizeof (UINT16) - 1)) == 0);
+  ASSERT (((UINTN)Buffer & (sizeof (UINT16) - 1)) == 0);
+
+  ReturnBuffer = (UINT16 *)Buffer;
+
+  while (Length != 0) {
+    MmioWrite16 (StartAddress, SwapBytes16 (*(Buffer++)));
+    StartAddress += sizeof (UINT16);
+    Length -= sizeof (UINT16);
+  }
+
+  return ReturnBuffer;
+}
+
+/**
+  MmioReadBuffer32 for Big-Endian modules.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied from.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer receiving the data read.
+
+  @return Buffer
+
+**/
+UINT32 *
+EFIAPI
+SwapMmioReadBuffer32 (
+  IN  UINTN       StartAddress,
+  IN  UINTN       Length,
+  OUT UINT32      *Buffer
+  )
+{
+  UINT32  *ReturnBuffer;
+
+  ASSERT ((StartAddress & (sizeof (UINT32) - 1)) == 0);
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - StartAddress));
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - (UINTN)Buffer));
+  ASSERT ((Length & (sizeof (UINT32) - 1)) == 0);
+  ASSERT (((UINTN)Buffer & (sizeof (UINT32) - 1)) == 0);
+
+  ReturnBuffer = Buffer;
+
+  while (Length != 0) {
+    *(Buffer++) = SwapBytes32 (MmioRead32 (StartAddress));
+    StartAddress += sizeof (UINT32);
+    Length -= sizeof (UINT32);
+  }
+
+  return ReturnBuffer;
+}
+
+/**
+  MmioWriteBuffer32 for Big-Endian modules.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied to.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer containing the data to write.
+
+  @return Buffer
+
+**/
+UINT32 *
+EFIAPI
+SwapMmioWriteBuffer32 (
+  IN  UINTN         StartAddress,
+  IN  UINTN         Length,
+  IN  CONST UINT32  *Buffer
+  )
+{
+  UINT32  *ReturnBuffer;
+
+  ASSERT ((StartAddress & (sizeof (UINT32) - 1)) == 0);
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - StartAddress));
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - (UINTN)Buffer));
+  ASSERT ((Length & (sizeof (UINT32) - 1)) == 0);
+  ASSERT (((UINTN)Buffer & (sizeof (UINT32) - 1)) == 0);
+
+  ReturnBuffer = (UINT32 *)Buffer;
+
+  while (Length != 0) {
+    MmioWrite32 (StartAddress, SwapBytes32 (*(Buffer++)));
+    StartAddress += sizeof (UINT32);
+    Length -= sizeof (UINT32);
+  }
+
+  return ReturnBuffer;
+}
+
+/**
+  MmioReadBuffer64 for Big-Endian modules.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied from.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer receiving the data read.
+
+  @return Buffer
+
+**/
+UINT64 *
+EFIAPI
+SwapMmioReadBuffer64 (
+  IN  UINTN       StartAddress,
+  IN  UINTN       Length,
+  OUT UINT64      *Buffer
+  )
+{
+  UINT64  *ReturnBuffer;
+
+  ASSERT ((StartAddress & (sizeof (UINT64) - 1)) == 0);
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - StartAddress));
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - (UINTN)Buffer));
+  ASSERT ((Length & (sizeof (UINT64) - 1)) == 0);
+  ASSERT (((UINTN)Buffer & (sizeof (UINT64) - 1)) == 0);
+
+  ReturnBuffer = Buffer;
+
+  while (Length != 0) {
+    *(Buffer++) = SwapBytes64 (MmioRead64 (StartAddress));
+    StartAddress += sizeof (UINT64);
+    Length -= sizeof (UINT64);
+  }
+
+  return ReturnBuffer;
+}
+
+/**
+  MmioWriteBuffer64 for Big-Endian modules.
+
+  @param  StartAddress    The starting address for the MMIO region to be copied to.
+  @param  Length          The size, in bytes, of Buffer.
+  @param  Buffer          The pointer to a system memory buffer containing the data to write.
+
+  @return Buffer
+
+**/
+UINT64 *
+EFIAPI
+SwapMmioWriteBuffer64 (
+  IN  UINTN         StartAddress,
+  IN  UINTN         Length,
+  IN  CONST UINT64  *Buffer
+  )
+{
+  UINT64  *ReturnBuffer;
+
+  ASSERT ((StartAddress & (sizeof (UINT64) - 1)) == 0);
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - StartAddress));
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - (UINTN)Buffer));
+  ASSERT ((Length & (sizeof (UINT64) - 1)) == 0);
+  ASSERT (((UINTN)Buffer & (sizeof (UINT64) - 1)) == 0);
+
+  ReturnBuffer = (UINT64 *)Buffer;
+
+  while (Length != 0) {
+    MmioWrite64 (StartAddress, SwapBytes64 (*(Buffer++)));
+    StartAddress += sizeof (UINT64);
+    Length -= sizeof (UINT64);
+  }
+
+  return ReturnBuffer;
+}
+
 STATIC MMIO_OPERATIONS SwappingFunctions = {
   SwapMmioRead16,
   SwapMmioWrite16,
@@ -332,6 +555,12 @@ STATIC MMIO_OPERATIONS SwappingFunctions = {
   SwapMmioOr64,
   SwapMmioAnd64,
   SwapMmioAndThenOr64,
+  SwapMmioReadBuffer16,
+  SwapMmioWriteBuffer16,
+  SwapMmioReadBuffer32,
+  SwapMmioWriteBuffer32,
+  SwapMmioReadBuffer64,
+  SwapMmioWriteBuffer64,
 };
 
 STATIC MMIO_OPERATIONS NonSwappingFunctions = {
@@ -350,6 +579,12 @@ STATIC MMIO_OPERATIONS NonSwappingFunctions = {
   MmioOr64,
   MmioAnd64,
   MmioAndThenOr64,
+  MmioReadBuffer16,
+  MmioWriteBuffer16,
+  MmioReadBuffer32,
+  MmioWriteBuffer32,
+  MmioReadBuffer64,
+  MmioWriteBuffer64,
 };
 
 /**
@@ -15,6 +15,8 @@
 
 PHYT_SPI_MASTER *pSpiMasterInstance;
 static UINTN     mSpiControlBase;
+static UINTN     mSpiFlashBase;
+static UINTN     mSpiFlashSize;
 
 /**
   This function inited a spi driver.
@@ -133,6 +135,46 @@ SpiMasterSetMode (
 }
 
 
+/**
+  This function geted the memory-mapped read window of the spi flash.
+
+  The controller decodes reads from this window into flash read cycles, using
+  the read configuration programmed in the controller. Flash contents can thus
+  be read with plain memory copies, without issuing commands.
+
+  @param[out] Base     The pointer of the window base address.
+
+  @param[out] Size     The pointer of the window size.
+
+  @retval EFI_SUCCESS            SpiMasterGetFlashWindow() is executed successfully.
+
+  @retval EFI_INVALID_PARAMETER  Base or Size is NULL.
+
+  @retval EFI_UNSUPPORTED        No memory-mapped window is configured.
+
+**/
+EFI_STATUS
+EFIAPI
+SpiMasterGetFlashWindow (
+  OUT UINTN  *Base,
+  OUT UINTN  *Size
+  )
+{
+  if ((Base == NULL) || (Size == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (mSpiFlashSize == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  *Base = mSpiFlashBase;
+  *Size = mSpiFlashSize;
+
+  return EFI_SUCCESS;
+}
+
+
 /**
   This function inited the spi driver protocol.
 
@@ -153,6 +195,7 @@ SpiMasterInitProtocol (
   SpiMasterProtocol->SpiSetConfig   = SpiMasterSetConfig;
   SpiMasterProtocol->SpiGetConfig   = SpiMasterGetConfig;
   SpiMasterProtocol->SpiSetMode     = SpiMasterSetMode;
+  SpiMasterProtocol->SpiGetFlashWindow = SpiMasterGetFlashWindow;
 
   return EFI_SUCCESS;
 }
@@ -185,6 +228,8 @@ SpiMasterDrvEntryPoint (
   }
 
   mSpiControlBase = FixedPcdGet64 (PcdSpiControllerBase);
+  mSpiFlashBase   = FixedPcdGet64 (PcdSpiFlashBase);
+  mSpiFlashSize   = FixedPcdGet64 (PcdSpiFlashSize);
 
   SpiMasterInitProtocol (&pSpiMasterInstance->SpiMasterProtocol);
 
@@ -43,6 +43,13 @@ SpiMasterInit (
   VOID
   );
 
+EFI_STATUS
+EFIAPI
+SpiMasterGetFlashWindow (
+  OUT  UINTN    *Base,
+  OUT  UINTN    *Size
+  );
+
 typedef struct {
   EFI_SPI_DRV_PROTOCOL    SpiMasterProtocol;
   UINTN                   Signature;
@@ -112,36 +112,6 @@ LocateFvInstanceWithTables (
 }
 
 
-/**
-  This function calculates and updates an UINT8 checksum.
-
-  @param[in]  Buffer          Pointer to buffer to checksum.
-
-  @param[in]  Size            Number of bytes to checksum.
-
-**/
-VOID
-AcpiPlatformChecksum (
-  IN UINT8      *Buffer,
-  IN UINTN      Size
-  )
-{
-  UINTN ChecksumOffset;
-
-  ChecksumOffset = OFFSET_OF (EFI_ACPI_DESCRIPTION_HEADER, Checksum);
-
-  //
-  // Set checksum to 0 first
-  //
-  Buffer[ChecksumOffset] = 0;
-
-  //
-  // Update checksum value
-  //
-  Buffer[ChecksumOffset] = CalculateCheckSum8 (Buffer, Size);
-}
-
-
 /**
   This function is the entrypoint of the acpi platform.
 
@@ -214,12 +184,8 @@ AcpiPlatformEntryPoint (
       ASSERT (Size >= TableSize);
 
       //
-      // Checksum ACPI table
-      //
-      AcpiPlatformChecksum ((UINT8 *)CurrentTable, TableSize);
-
-      //
-      // Install ACPI table
+      // Install ACPI table. The ACPI table protocol computes the checksum of
+      // its own copy of the table, so there is no need to do it here.
       //
       Status = AcpiTable->InstallAcpiTable (
                             AcpiTable,
@@ -41,11 +41,19 @@ EFI_STATUS
   IN  UINT32 Config
   );
 
+typedef
+EFI_STATUS
+(EFIAPI *SPI_DRV_GET_FLASH_WINDOW_INTERFACE)(
+  OUT UINTN  *Base,
+  OUT UINTN  *Size
+  );
+
 struct _EFI_SPI_DRV_PROTOCOL{
   SPI_DRV_INIT_INTERFACE        SpiInit;
   SPI_DRV_SET_CONFIG_INTERFACE  SpiSetConfig;
   SPI_DRV_GET_CONFIG_INTERFACE  SpiGetConfig;
   SPI_DRV_CONFIG_MODE_INTERFACE SpiSetMode;
+  SPI_DRV_GET_FLASH_WINDOW_INTERFACE SpiGetFlashWindow;
 };
 
 #endif // SPI_H_
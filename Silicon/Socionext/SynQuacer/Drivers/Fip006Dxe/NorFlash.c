@@ -516,7 +516,10 @@ NorFlashWriteSingleWord (
   MmioWrite32 (WordAddress, WriteData);
   NorFlashWaitProgramErase (Instance);
 
-  NorFlashDisableWrite (Instance);
+  //
+  // No need to issue WRDIS: the device clears the write enable latch by
+  // itself once the page program operation has completed.
+  //
   NorFlashSetHostCSDC (Instance, TRUE, mFip006NullCmdSeq);
   return Status;
 }
@@ -558,6 +561,11 @@ NorFlashWriteFullBlock (
   for (WordIndex=0;
        WordIndex < BlockSizeInWords;
        WordIndex++, DataBuffer++, WordAddress += 4) {
+    // The block has just been erased, so there is no need to program
+    // words that are to remain in the erased state.
+    if (*DataBuffer == MAX_UINT32) {
+      continue;
+    }
     Status = NorFlashWriteSingleWord (Instance, WordAddress, *DataBuffer);
     if (EFI_ERROR (Status)) {
       goto EXIT;
@@ -598,8 +598,7 @@ ExitUnlock:
  */
 STATIC
 EFI_STATUS
-EFIAPI
-SnpGetStatus (
+NetsecGetStatus (
   IN      EFI_SIMPLE_NETWORK_PROTOCOL   *Snp,
       OUT UINT32                        *IrqStat  OPTIONAL,
       OUT VOID                          **TxBuff  OPTIONAL
@@ -674,13 +673,36 @@ ExitUnlock:
   return Status;
 }
 
+STATIC
+EFI_STATUS
+EFIAPI
+SnpGetStatus (
+  IN      EFI_SIMPLE_NETWORK_PROTOCOL   *Snp,
+      OUT UINT32                        *IrqStat  OPTIONAL,
+      OUT VOID                          **TxBuff  OPTIONAL
+  )
+{
+  EFI_STATUS                Status;
+  UINT64                    StartTicks;
+
+  if (Snp == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = NetsecGetStatus (Snp, IrqStat, TxBuff);
+  SnpStatsRecord (INSTANCE_FROM_SNP_THIS (Snp)->SnpStats, SnpStatsGetStatus,
+    StartTicks, Status, 0);
+
+  return Status;
+}
+
 /*
  *  UEFI Transmit() function
  */
 STATIC
 EFI_STATUS
-EFIAPI
-SnpTransmit (
+NetsecTransmit (
   IN  EFI_SIMPLE_NETWORK_PROTOCOL   *Snp,
   IN  UINTN                         HdrSize,
   IN  UINTN                         BufSize,
@@ -700,6 +722,7 @@ SnpTransmit (
   ogma_err_t          ogma_err;
   UINT16              Proto;
   pfdep_pkt_handle_t  pkt_handle;
+  UINTN               Timeout;
 
   // Check preliminaries
   if ((Snp == NULL) || (BufAddr == NULL)) {
@@ -748,13 +771,30 @@ SnpTransmit (
     ReturnUnlock (EFI_DEVICE_ERROR);
   }
 
-  ogma_err = ogma_clean_tx_desc_ring (LanDriver->Handle,
-                                      OGMA_DESC_RING_ID_NRM_TX);
-  if (ogma_err != OGMA_ERR_OK) {
-    DEBUG ((DEBUG_ERROR,
-      "NETSEC: ogma_clean_tx_desc_ring failed with error code: %d\n",
-      (INT32)ogma_err));
-    ReturnUnlock (EFI_DEVICE_ERROR);
+  //
+  // Reap the frames the hardware has completed. If this leaves no slot
+  // free, keep reaping for a while, rather than failing right away.
+  //
+  for (Timeout = 0; ; Timeout++) {
+    ogma_err = ogma_clean_tx_desc_ring (LanDriver->Handle,
+                                        OGMA_DESC_RING_ID_NRM_TX);
+    if (ogma_err != OGMA_ERR_OK) {
+      DEBUG ((DEBUG_ERROR,
+        "NETSEC: ogma_clean_tx_desc_ring failed with error code: %d\n",
+        (INT32)ogma_err));
+      ReturnUnlock (EFI_DEVICE_ERROR);
+    }
+
+    tx_avail_num = ogma_get_tx_avail_num (LanDriver->Handle,
+                                          OGMA_DESC_RING_ID_NRM_TX);
+    if (tx_avail_num >= SCAT_NUM) {
+      break;
+    }
+
+    if (Timeout == TX_RECLAIM_TIMEOUT_US) {
+      ReturnUnlock (EFI_NOT_READY);
+    }
+    gBS->Stall (1);
   }
 
   // Ensure header is correct size if non-zero
@@ -803,12 +843,6 @@ SnpTransmit (
   tx_pkt_ctrl.pass_through_flag     = OGMA_TRUE;
   tx_pkt_ctrl.target_desc_ring_id   = OGMA_DESC_RING_ID_GMAC;
 
-  // check empty slot
-  do {
-    tx_avail_num = ogma_get_tx_avail_num (LanDriver->Handle,
-                                          OGMA_DESC_RING_ID_NRM_TX);
-  } while (tx_avail_num < SCAT_NUM);
-
   // send
   ogma_err = ogma_set_tx_pkt_data (LanDriver->Handle,
                                    OGMA_DESC_RING_ID_NRM_TX,
@@ -842,12 +876,42 @@ ExitUnlock:
   return Status;
 }
 
+STATIC
+EFI_STATUS
+EFIAPI
+SnpTransmit (
+  IN  EFI_SIMPLE_NETWORK_PROTOCOL   *Snp,
+  IN  UINTN                         HdrSize,
+  IN  UINTN                         BufSize,
+  IN  VOID                          *BufAddr,
+  IN  EFI_MAC_ADDRESS               *SrcAddr    OPTIONAL,
+  IN  EFI_MAC_ADDRESS               *DstAddr    OPTIONAL,
+  IN  UINT16                        *Protocol   OPTIONAL
+  )
+{
+  EFI_STATUS                Status;
+  UINT64                    StartTicks;
+
+  if (Snp == NULL) {
+    return NetsecTransmit (Snp, HdrSize, BufSize, BufAddr, SrcAddr, DstAddr,
+             Protocol);
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = NetsecTransmit (Snp, HdrSize, BufSize, BufAddr, SrcAddr, DstAddr,
+             Protocol);
+  SnpStatsRecord (INSTANCE_FROM_SNP_THIS (Snp)->SnpStats, SnpStatsTransmit,
+    StartTicks, Status, BufSize);
+
+  return Status;
+}
+
 /*
  *  UEFI Receive() function
  */
+STATIC
 EFI_STATUS
-EFIAPI
-SnpReceive (
+NetsecReceive (
   IN      EFI_SIMPLE_NETWORK_PROTOCOL   *Snp,
       OUT UINTN                         *HdrSize    OPTIONAL,
   IN  OUT UINTN                         *BuffSize,
@@ -940,6 +1004,65 @@ ExitUnlock:
   return Status;
 }
 
+STATIC
+EFI_STATUS
+EFIAPI
+SnpReceive (
+  IN      EFI_SIMPLE_NETWORK_PROTOCOL   *Snp,
+      OUT UINTN                         *HdrSize    OPTIONAL,
+  IN  OUT UINTN                         *BuffSize,
+      OUT VOID                          *Data,
+      OUT EFI_MAC_ADDRESS               *SrcAddr    OPTIONAL,
+      OUT EFI_MAC_ADDRESS               *DstAddr    OPTIONAL,
+      OUT UINT16                        *Protocol   OPTIONAL
+  )
+{
+  EFI_STATUS          Status;
+  UINT64              StartTicks;
+
+  if (Snp == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = NetsecReceive (Snp, HdrSize, BuffSize, Data, SrcAddr, DstAddr,
+             Protocol);
+  SnpStatsRecord (INSTANCE_FROM_SNP_THIS (Snp)->SnpStats, SnpStatsReceive,
+    StartTicks, Status, EFI_ERROR (Status) ? 0 : *BuffSize);
+
+  return Status;
+}
+
+/*
+ *  UEFI Statistics() function
+ */
+STATIC
+EFI_STATUS
+EFIAPI
+SnpStatistics (
+  IN      EFI_SIMPLE_NETWORK_PROTOCOL   *Snp,
+  IN      BOOLEAN                       Reset,
+  IN  OUT UINTN                         *StatSize   OPTIONAL,
+      OUT EFI_NETWORK_STATISTICS        *Statistics OPTIONAL
+  )
+{
+  if (Snp == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  switch (Snp->Mode->State) {
+  case EfiSimpleNetworkInitialized:
+    break;
+  case EfiSimpleNetworkStopped:
+    return EFI_NOT_STARTED;
+  default:
+    return EFI_DEVICE_ERROR;
+  }
+
+  return SnpStatsGetNetworkStatistics (INSTANCE_FROM_SNP_THIS (Snp)->SnpStats,
+           Reset, StatSize, Statistics);
+}
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -1083,7 +1206,7 @@ NetsecInit (
   Snp->Shutdown = SnpShutdown;
   Snp->ReceiveFilters = SnpReceiveFilters;
   Snp->StationAddress = NULL;
-  Snp->Statistics = NULL;
+  Snp->Statistics = SnpStatistics;
   Snp->MCastIpToMac = NULL;
   Snp->NvData = NULL;
   Snp->GetStatus = SnpGetStatus;
@@ -1153,6 +1276,12 @@ NetsecInit (
     ogma_terminate (LanDriver->Handle);
     goto CloseDeviceProtocol;
   }
+
+  // Statistics are optional, the interface works without them
+  Status = SnpStatsInstall (ControllerHandle, &LanDriver->SnpStats);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: no statistics - %r\n", __FUNCTION__, Status));
+  }
   return EFI_SUCCESS;
 
 CloseDeviceProtocol:
@@ -1193,6 +1322,8 @@ NetsecRelease (
     return Status;
   }
 
+  SnpStatsUninstall (ControllerHandle, LanDriver->SnpStats);
+
   if (Snp->Mode->State == EfiSimpleNetworkInitialized) {
     SnpShutdown (Snp);
   }
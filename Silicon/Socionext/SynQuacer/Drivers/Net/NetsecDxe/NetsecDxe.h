@@ -17,6 +17,7 @@
 #include <Library/IoLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
+#include <Library/SnpStatsLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 
@@ -52,6 +53,9 @@ typedef struct {
   // EFI Snp statistics instance
   EFI_NETWORK_STATISTICS            Stats;
 
+  // Call counters and latencies, also backing Snp.Statistics ()
+  SNP_STATS_CONTEXT                 *SnpStats;
+
   // Adapter Information protocol
   EFI_ADAPTER_INFORMATION_PROTOCOL  Aip;
 
@@ -103,6 +107,10 @@ NetsecRelease (
 
 #define SCAT_NUM                    1
 
+// How long SnpTransmit() waits for the hardware to complete frames when the
+// TX ring is full, before giving up with EFI_NOT_READY (in microseconds)
+#define TX_RECLAIM_TIMEOUT_US       1000
+
 #define RXINT_TMR_CNT_US            0
 #define RXINT_PKTCNT                1
 
@@ -13,6 +13,7 @@
 #include <Library/DmaLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
+#include <Library/PcdLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
 STATIC
@@ -117,16 +118,13 @@ DriverStart (
   SIMPLE_NETWORK_DEVICE_PATH       *DevicePath;
   UINT64                           DefaultMacAddress;
   EFI_MAC_ADDRESS                  *SwapMacAddressPtr;
-  UINTN                            DescriptorSize;
-  UINTN                            BufferSize;
-  UINTN                            *RxBufferAddr;
-  EFI_PHYSICAL_ADDRESS             RxBufferAddrMap;
 
   // Allocate Resources
   Snp = AllocatePages (EFI_SIZE_TO_PAGES (sizeof (SIMPLE_NETWORK_DRIVER)));
   if (Snp == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
+  ZeroMem (Snp, sizeof (SIMPLE_NETWORK_DRIVER));
 
   Status = gBS->OpenProtocol (Controller,
                               &gEdkiiNonDiscoverableDeviceProtocolGuid,
@@ -135,51 +133,12 @@ DriverStart (
                               Controller,
                               EFI_OPEN_PROTOCOL_BY_DRIVER);
 
-  // Size for descriptor
-  DescriptorSize = EFI_PAGES_TO_SIZE (sizeof (DESIGNWARE_HW_DESCRIPTOR));
-  // Size for transmit and receive buffer
-  BufferSize = ETH_BUFSIZE;
-
-  for (int Index=0; Index < DESC_NUM; Index++) {
-    //DMA TxdescRing allocate buffer and map
-    Status = DmaAllocateBuffer (EfiBootServicesData,
-               EFI_SIZE_TO_PAGES (sizeof (DESIGNWARE_HW_DESCRIPTOR)), (VOID *)&Snp->MacDriver.TxdescRing[Index]);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "%a () for TxdescRing: %r\n", __FUNCTION__, Status));
-      return Status;
-    }
-
-    Status = DmaMap (MapOperationBusMasterCommonBuffer, Snp->MacDriver.TxdescRing[Index],
-               &DescriptorSize, &Snp->MacDriver.TxdescRingMap[Index].AddrMap, &Snp->MacDriver.TxdescRingMap[Index].Mapping);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "%a () for TxdescRing: %r\n", __FUNCTION__, Status));
-      return Status;
-    }
-
-    // DMA RxdescRing allocte buffer and map
-    Status = DmaAllocateBuffer (EfiBootServicesData,
-               EFI_SIZE_TO_PAGES (sizeof (DESIGNWARE_HW_DESCRIPTOR)), (VOID *)&Snp->MacDriver.RxdescRing[Index]);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "%a () for RxdescRing: %r\n", __FUNCTION__, Status));
-      return Status;
-    }
-
-    Status = DmaMap (MapOperationBusMasterCommonBuffer, Snp->MacDriver.RxdescRing[Index],
-               &DescriptorSize, &Snp->MacDriver.RxdescRingMap[Index].AddrMap, &Snp->MacDriver.RxdescRingMap[Index].Mapping);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "%a () for RxdescRing: %r\n", __FUNCTION__, Status));
-      return Status;
-    }
-
-    //DMA mapping for receive buffer
-    RxBufferAddr = (UINTN*)((UINTN)Snp->MacDriver.RxBuffer + (Index * BufferSize));
-    Status = DmaMap (MapOperationBusMasterWrite,  (VOID *) RxBufferAddr,
-               &BufferSize, &RxBufferAddrMap, &Snp->MacDriver.RxBufNum[Index].Mapping);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "%a () for Rxbuffer: %r\n", __FUNCTION__, Status));
-      return Status;
-    }
-    Snp->MacDriver.RxBufNum[Index].AddrMap= RxBufferAddrMap;
+  // Descriptor rings, sized by the platform
+  Status = EmacAllocateRings (&Snp->MacDriver,
+             PcdGet32 (PcdDwEmacSnpTxDescriptorCount),
+             PcdGet32 (PcdDwEmacSnpRxDescriptorCount));
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
   DevicePath = (SIMPLE_NETWORK_DEVICE_PATH*)AllocateCopyPool (sizeof (SIMPLE_NETWORK_DEVICE_PATH), &PathTemplate);
@@ -292,11 +251,18 @@ DriverStart (
                         Controller);
 
     FreePages (Snp, EFI_SIZE_TO_PAGES (sizeof (SIMPLE_NETWORK_DRIVER)));
-  } else {
-    Snp->ControllerHandle = Controller;
+    return Status;
   }
 
-  return Status;
+  Snp->ControllerHandle = Controller;
+
+  // Statistics are optional, the interface works without them
+  Status = SnpStatsInstall (Controller, &Snp->SnpStats);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a (): SnpStatsInstall: %r\n", __FUNCTION__, Status));
+  }
+
+  return EFI_SUCCESS;
 }
 
 STATIC
@@ -335,6 +301,9 @@ DriverStop (
     return Status;
   }
 
+  SnpStatsUninstall (Controller, Snp->SnpStats);
+
+  EmacFreeRings (&Snp->MacDriver);
   FreePool (Snp->RecycledTxBuf);
   FreePages (Snp, EFI_SIZE_TO_PAGES (sizeof (SIMPLE_NETWORK_DRIVER)));
 
@@ -605,7 +605,7 @@ SnpStatistics (
   EmacGetStatistic (&Snp->Stats, Snp->MacBase);
 
   // Fill in the statistics
-  CopyMem (&Statistics, &Snp->Stats, sizeof(EFI_NETWORK_STATISTICS));
+  CopyMem (Statistics, &Snp->Stats, sizeof(EFI_NETWORK_STATISTICS));
 
   return EFI_SUCCESS;
 }
@@ -806,9 +806,9 @@ SnpNvData (
                                 interface.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-SnpGetStatus (
+DwEmacGetStatus (
   IN   EFI_SIMPLE_NETWORK_PROTOCOL   *This,
   OUT  UINT32                        *IrqStat  OPTIONAL,
   OUT  VOID                          **TxBuff  OPTIONAL
@@ -908,9 +908,9 @@ SnpGetStatus (
   @retval EFI_ACCESS_DENIED     Error acquire global lock for operation.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-SnpTransmit (
+DwEmacTransmit (
   IN  EFI_SIMPLE_NETWORK_PROTOCOL   *This,
   IN  UINTN                         HdrSize,
   IN  UINTN                         BuffSize,
@@ -954,8 +954,14 @@ SnpTransmit (
   Snp->MacDriver.TxCurrentDescriptorNum = Snp->MacDriver.TxNextDescriptorNum;
   DescNum = Snp->MacDriver.TxCurrentDescriptorNum;
 
-  TxDescriptor = Snp->MacDriver.TxdescRing[DescNum];
-  TxDescriptorMap = (VOID *)(UINTN)Snp->MacDriver.TxdescRingMap[DescNum].AddrMap;
+  TxDescriptor = &Snp->MacDriver.TxdescRing[DescNum];
+  TxDescriptorMap = EMAC_TX_DESC_MAP (&Snp->MacDriver, DescNum);
+
+  // The descriptor is still waiting for the DMA engine, the ring is full
+  if (TxDescriptor->Tdes0 & TDES0_OWN) {
+    EfiReleaseLock (&Snp->Lock);
+    return EFI_NOT_READY;
+  }
 
   // Ensure header is correct size if non-zero
   if (HdrSize) {
@@ -1012,7 +1018,7 @@ SnpTransmit (
   // Increase descriptor number
   DescNum++;
 
-  if (DescNum >= CONFIG_TX_DESCR_NUM) {
+  if (DescNum >= Snp->MacDriver.TxDescriptorCount) {
     DescNum = 0;
   }
 
@@ -1089,9 +1095,9 @@ SnpTransmit (
   @retval EFI_ACCESS_DENIED     Error acquire global lock for operation.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-SnpReceive (
+DwEmacReceive (
   IN       EFI_SIMPLE_NETWORK_PROTOCOL   *This,
       OUT  UINTN                         *HdrSize      OPTIONAL,
   IN  OUT  UINTN                         *BuffSize,
@@ -1109,10 +1115,8 @@ SnpReceive (
   UINT8                      *RawData;
   UINT32                     DescNum;
   DESIGNWARE_HW_DESCRIPTOR   *RxDescriptor;
-  DESIGNWARE_HW_DESCRIPTOR   *RxDescriptorMap;
   UINTN                      BufferSizeBuf;
   UINTN                      *RxBufferAddr;
-  EFI_PHYSICAL_ADDRESS       RxBufferAddrMap;
   EFI_STATUS                 Status;
 
   BufferSizeBuf = ETH_BUFSIZE;
@@ -1134,10 +1138,9 @@ SnpReceive (
 
   Snp->MacDriver.RxCurrentDescriptorNum = Snp->MacDriver.RxNextDescriptorNum;
   DescNum = Snp->MacDriver.RxCurrentDescriptorNum;
-  RxDescriptor = Snp->MacDriver.RxdescRing[DescNum];
+  RxDescriptor = &Snp->MacDriver.RxdescRing[DescNum];
   RxBufferAddr = (UINTN*)((UINTN)Snp->MacDriver.RxBuffer +
                           (DescNum * BufferSizeBuf));
-  RxDescriptorMap = (VOID *)(UINTN)Snp->MacDriver.RxdescRingMap[DescNum].AddrMap;
 
   RawData = (UINT8 *) Data;
 
@@ -1148,12 +1151,14 @@ SnpReceive (
 
   if (DescriptorStatus & RDES0_SAF) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Rx Descritpor Status Error: Source Address Filter Fail\n"));
-    return EFI_DEVICE_ERROR;
+    Status = EFI_DEVICE_ERROR;
+    goto DropFrame;
   }
 
   if (DescriptorStatus & RDES0_AFM) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Rx Descritpor Status Error: Destination Address Filter Fail\n"));
-    return EFI_DEVICE_ERROR;
+    Status = EFI_DEVICE_ERROR;
+    goto DropFrame;
   }
 
   if (DescriptorStatus & RDES0_ES) {
@@ -1187,17 +1192,21 @@ SnpReceive (
     if (DescriptorStatus & RDES0_CE) {
       DEBUG ((DEBUG_WARN, "SNP:DXE: Rx Descritpor Status Error: CRC Error\n"));
     }
-    return EFI_DEVICE_ERROR;
+    Status = EFI_DEVICE_ERROR;
+    goto DropFrame;
   }
 
   Length = (DescriptorStatus >> RDES0_FL_SHIFT) & RDES0_FL_MASK;
   if (!Length) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Error: Invalid Frame Packet length \r\n"));
-    return EFI_NOT_READY;
+    Status = EFI_NOT_READY;
+    goto DropFrame;
   }
-  // Check buffer size
+  // Check buffer size, leaving the frame in the ring for the next call
   if (*BuffSize < Length) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Error: Buffer size is too small\n"));
+    *BuffSize = Length;
+    EfiReleaseLock (&Snp->Lock);
     return EFI_BUFFER_TOO_SMALL;
   }
   *BuffSize = Length;
@@ -1205,9 +1214,8 @@ SnpReceive (
   if (HdrSize != NULL)
     *HdrSize = Snp->SnpMode.MediaHeaderSize;
 
-  DmaUnmap (Snp->MacDriver.RxBufNum[DescNum].Mapping);
-  Snp->MacDriver.RxBufNum[DescNum].Mapping = NULL;
-
+  // The receive buffers stay mapped as a common buffer, so the frame can be
+  // copied out directly
   CopyMem (RawData, (VOID *)RxBufferAddr, *BuffSize);
 
   if (DstAddr != NULL) {
@@ -1238,22 +1246,12 @@ SnpReceive (
     *Protocol = NTOHS (RawData[12] | (RawData[13] >> 8) | (RawData[14] >> 16) | (RawData[15] >> 24));
   }
 
-  // DMA map for the current receive buffer
-  Status = DmaMap (MapOperationBusMasterWrite,  (VOID *)RxBufferAddr,
-             &BufferSizeBuf, &RxBufferAddrMap, &Snp->MacDriver.RxBufNum[DescNum].Mapping);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a () for Rxbuffer: %r\n", __FUNCTION__, Status));
-    return Status;
-  }
-  Snp->MacDriver.RxBufNum[DescNum].AddrMap = RxBufferAddrMap;
-  RxDescriptorMap->Addr = Snp->MacDriver.RxBufNum[DescNum].AddrMap;
-
   RxDescriptor->Tdes0 |= (UINT32)RDES0_OWN;
 
   // Increase descriptor number
   DescNum++;
 
-  if (DescNum >= CONFIG_RX_DESCR_NUM) {
+  if (DescNum >= Snp->MacDriver.RxDescriptorCount) {
     DescNum = 0;
   }
   Snp->MacDriver.RxNextDescriptorNum = DescNum;
@@ -1261,8 +1259,117 @@ SnpReceive (
   EfiReleaseLock (&Snp->Lock);
   return EFI_SUCCESS;
 
+DropFrame:
+  // Give the descriptor back to the DMA engine
+  Snp->Stats.RxDroppedFrames++;
+  SnpStatsRecordDrop (Snp->SnpStats, SnpStatsReceive);
+  RxDescriptor->Tdes0 = (UINT32)RDES0_OWN;
+
+  DescNum++;
+  if (DescNum >= Snp->MacDriver.RxDescriptorCount) {
+    DescNum = 0;
+  }
+  Snp->MacDriver.RxNextDescriptorNum = DescNum;
+
+  EfiReleaseLock (&Snp->Lock);
+  return Status;
+
 ReleaseLock:
   EfiReleaseLock (&Snp->Lock);
   return EFI_NOT_READY;
 }
 
+/**
+  Reads the interrupt status and the recycled transmit buffer status, and
+  records the call in the SNP statistics. See DwEmacGetStatus ().
+
+**/
+EFI_STATUS
+EFIAPI
+SnpGetStatus (
+  IN   EFI_SIMPLE_NETWORK_PROTOCOL   *This,
+  OUT  UINT32                        *IrqStat  OPTIONAL,
+  OUT  VOID                          **TxBuff  OPTIONAL
+  )
+{
+  EFI_STATUS                 Status;
+  UINT64                     StartTicks;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = DwEmacGetStatus (This, IrqStat, TxBuff);
+  SnpStatsRecord (INSTANCE_FROM_SNP_THIS (This)->SnpStats, SnpStatsGetStatus,
+    StartTicks, Status, 0);
+
+  return Status;
+}
+
+/**
+  Places a packet in the transmit queue, and records the call in the SNP
+  statistics. See DwEmacTransmit ().
+
+**/
+EFI_STATUS
+EFIAPI
+SnpTransmit (
+  IN  EFI_SIMPLE_NETWORK_PROTOCOL   *This,
+  IN  UINTN                         HdrSize,
+  IN  UINTN                         BuffSize,
+  IN  VOID                          *Data,
+  IN  EFI_MAC_ADDRESS               *SrcAddr  OPTIONAL,
+  IN  EFI_MAC_ADDRESS               *DstAddr  OPTIONAL,
+  IN  UINT16                        *Protocol OPTIONAL
+  )
+{
+  EFI_STATUS                 Status;
+  UINT64                     StartTicks;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = DwEmacTransmit (This, HdrSize, BuffSize, Data, SrcAddr, DstAddr,
+             Protocol);
+  SnpStatsRecord (INSTANCE_FROM_SNP_THIS (This)->SnpStats, SnpStatsTransmit,
+    StartTicks, Status, BuffSize);
+
+  return Status;
+}
+
+/**
+  Receives a packet, and records the call in the SNP statistics.
+  See DwEmacReceive ().
+
+**/
+EFI_STATUS
+EFIAPI
+SnpReceive (
+  IN       EFI_SIMPLE_NETWORK_PROTOCOL   *This,
+      OUT  UINTN                         *HdrSize      OPTIONAL,
+  IN  OUT  UINTN                         *BuffSize,
+      OUT  VOID                          *Data,
+      OUT  EFI_MAC_ADDRESS               *SrcAddr      OPTIONAL,
+      OUT  EFI_MAC_ADDRESS               *DstAddr      OPTIONAL,
+      OUT  UINT16                        *Protocol     OPTIONAL
+  )
+{
+  EFI_STATUS                 Status;
+  UINT64                     StartTicks;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StartTicks = SnpStatsStart ();
+  Status = DwEmacReceive (This, HdrSize, BuffSize, Data, SrcAddr, DstAddr,
+             Protocol);
+  SnpStatsRecord (INSTANCE_FROM_SNP_THIS (This)->SnpStats, SnpStatsReceive,
+    StartTicks, Status, EFI_ERROR (Status) ? 0 : *BuffSize);
+
+  return Status;
+}
+
@@ -22,6 +22,7 @@
 #include <Protocol/DevicePath.h>
 #include <Protocol/NonDiscoverableDevice.h>
 
+#include <Library/SnpStatsLib.h>
 #include <Library/UefiLib.h>
 
 #include "PhyDxeUtil.h"
@@ -48,6 +49,9 @@ typedef struct {
   // EFI Snp statistics instance
   EFI_NETWORK_STATISTICS                 Stats;
 
+  // Call counters and latencies
+  SNP_STATS_CONTEXT                      *SnpStats;
+
   EMAC_DRIVER                            MacDriver;
   PHY_DRIVER                             PhyDriver;
 
@@ -78,7 +82,6 @@ extern EFI_COMPONENT_NAME2_PROTOCOL      gSnpComponentName2;
 #define INSTANCE_FROM_SNP_THIS(a)        CR(a, SIMPLE_NETWORK_DRIVER, Snp, SNP_DRIVER_SIGNATURE)
 #define SNP_TX_BUFFER_INCREASE           32
 #define SNP_MAX_TX_BUFFER_NUM            65536
-#define DESC_NUM                         10
 #define ETH_BUFSIZE                      0x800
 /*---------------------------------------------------------------------------------------------------------------------
 
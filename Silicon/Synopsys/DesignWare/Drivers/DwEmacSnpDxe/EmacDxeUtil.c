@@ -18,6 +18,7 @@
 
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/DmaLib.h>
 #include <Library/IoLib.h>
 #include <Library/MemoryAllocationLib.h>
 
@@ -220,6 +221,174 @@ EmacDmaInit (
 }
 
 
+/**
+  Allocates the TX and RX descriptor rings, along with their buffers, and
+  maps the RX buffers for the device. Each ring is allocated as a single
+  DMA buffer, so its descriptors can be chained to one another.
+
+  @param  EmacDriver         The EMAC driver instance.
+  @param  TxDescriptorCount  Number of descriptors in the TX ring.
+  @param  RxDescriptorCount  Number of descriptors in the RX ring.
+
+  @retval EFI_SUCCESS            The rings were allocated.
+  @retval EFI_INVALID_PARAMETER  A descriptor count is zero.
+  @retval Others                 An allocation or a mapping failed.
+
+**/
+EFI_STATUS
+EFIAPI
+EmacAllocateRings (
+  IN  EMAC_DRIVER   *EmacDriver,
+  IN  UINT32        TxDescriptorCount,
+  IN  UINT32        RxDescriptorCount
+  )
+{
+  EFI_STATUS             Status;
+  UINTN                  DescriptorSize;
+  UINTN                  BufferSize;
+  UINT32                 Index;
+
+  if ((TxDescriptorCount == 0) || (RxDescriptorCount == 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  EmacDriver->TxDescriptorCount = TxDescriptorCount;
+  EmacDriver->RxDescriptorCount = RxDescriptorCount;
+
+  // DMA TxdescRing allocate buffer and map
+  Status = DmaAllocateBuffer (EfiBootServicesData,
+             EFI_SIZE_TO_PAGES (TxDescriptorCount * sizeof (DESIGNWARE_HW_DESCRIPTOR)),
+             (VOID **)&EmacDriver->TxdescRing);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a () for TxdescRing: %r\n", __FUNCTION__, Status));
+    goto Error;
+  }
+
+  DescriptorSize = TxDescriptorCount * sizeof (DESIGNWARE_HW_DESCRIPTOR);
+  Status = DmaMap (MapOperationBusMasterCommonBuffer, EmacDriver->TxdescRing,
+             &DescriptorSize, &EmacDriver->TxdescRingMap.AddrMap, &EmacDriver->TxdescRingMap.Mapping);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a () for TxdescRing: %r\n", __FUNCTION__, Status));
+    goto Error;
+  }
+
+  // DMA RxdescRing allocate buffer and map
+  Status = DmaAllocateBuffer (EfiBootServicesData,
+             EFI_SIZE_TO_PAGES (RxDescriptorCount * sizeof (DESIGNWARE_HW_DESCRIPTOR)),
+             (VOID **)&EmacDriver->RxdescRing);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a () for RxdescRing: %r\n", __FUNCTION__, Status));
+    goto Error;
+  }
+
+  DescriptorSize = RxDescriptorCount * sizeof (DESIGNWARE_HW_DESCRIPTOR);
+  Status = DmaMap (MapOperationBusMasterCommonBuffer, EmacDriver->RxdescRing,
+             &DescriptorSize, &EmacDriver->RxdescRingMap.AddrMap, &EmacDriver->RxdescRingMap.Mapping);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a () for RxdescRing: %r\n", __FUNCTION__, Status));
+    goto Error;
+  }
+
+  // Transmit and receive buffers
+  EmacDriver->TxBuffer = AllocatePages (EFI_SIZE_TO_PAGES (TxDescriptorCount * CONFIG_ETH_BUFSIZE));
+  EmacDriver->RxBufNum = AllocateZeroPool (RxDescriptorCount * sizeof (MAP_INFO));
+  if ((EmacDriver->TxBuffer == NULL) ||
+      (EmacDriver->RxBufNum == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Error;
+  }
+
+  // DMA receive buffers allocate and map once, so that receiving a frame
+  // doesn't need to unmap and map its buffer again
+  Status = DmaAllocateBuffer (EfiBootServicesData,
+             EFI_SIZE_TO_PAGES (RxDescriptorCount * CONFIG_ETH_BUFSIZE),
+             (VOID **)&EmacDriver->RxBuffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a () for Rxbuffer: %r\n", __FUNCTION__, Status));
+    goto Error;
+  }
+
+  BufferSize = RxDescriptorCount * CONFIG_ETH_BUFSIZE;
+  Status = DmaMap (MapOperationBusMasterCommonBuffer, EmacDriver->RxBuffer,
+             &BufferSize, &EmacDriver->RxBufferMap.AddrMap, &EmacDriver->RxBufferMap.Mapping);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a () for Rxbuffer: %r\n", __FUNCTION__, Status));
+    goto Error;
+  }
+
+  for (Index = 0; Index < RxDescriptorCount; Index++) {
+    EmacDriver->RxBufNum[Index].AddrMap = EmacDriver->RxBufferMap.AddrMap + Index * CONFIG_ETH_BUFSIZE;
+  }
+
+  return EFI_SUCCESS;
+
+Error:
+  EmacFreeRings (EmacDriver);
+  return Status;
+}
+
+
+/**
+  Frees the descriptor rings and buffers allocated by EmacAllocateRings ().
+
+  @param  EmacDriver         The EMAC driver instance.
+
+**/
+VOID
+EFIAPI
+EmacFreeRings (
+  IN  EMAC_DRIVER   *EmacDriver
+  )
+{
+  if (EmacDriver->RxBufNum != NULL) {
+    FreePool (EmacDriver->RxBufNum);
+    EmacDriver->RxBufNum = NULL;
+  }
+
+  if (EmacDriver->RxBufferMap.Mapping != NULL) {
+    DmaUnmap (EmacDriver->RxBufferMap.Mapping);
+    EmacDriver->RxBufferMap.Mapping = NULL;
+  }
+
+  if (EmacDriver->RxBuffer != NULL) {
+    DmaFreeBuffer (
+      EFI_SIZE_TO_PAGES (EmacDriver->RxDescriptorCount * CONFIG_ETH_BUFSIZE),
+      EmacDriver->RxBuffer);
+    EmacDriver->RxBuffer = NULL;
+  }
+
+  if (EmacDriver->TxBuffer != NULL) {
+    FreePages (EmacDriver->TxBuffer,
+      EFI_SIZE_TO_PAGES (EmacDriver->TxDescriptorCount * CONFIG_ETH_BUFSIZE));
+    EmacDriver->TxBuffer = NULL;
+  }
+
+  if (EmacDriver->RxdescRingMap.Mapping != NULL) {
+    DmaUnmap (EmacDriver->RxdescRingMap.Mapping);
+    EmacDriver->RxdescRingMap.Mapping = NULL;
+  }
+
+  if (EmacDriver->RxdescRing != NULL) {
+    DmaFreeBuffer (
+      EFI_SIZE_TO_PAGES (EmacDriver->RxDescriptorCount * sizeof (DESIGNWARE_HW_DESCRIPTOR)),
+      EmacDriver->RxdescRing);
+    EmacDriver->RxdescRing = NULL;
+  }
+
+  if (EmacDriver->TxdescRingMap.Mapping != NULL) {
+    DmaUnmap (EmacDriver->TxdescRingMap.Mapping);
+    EmacDriver->TxdescRingMap.Mapping = NULL;
+  }
+
+  if (EmacDriver->TxdescRing != NULL) {
+    DmaFreeBuffer (
+      EFI_SIZE_TO_PAGES (EmacDriver->TxDescriptorCount * sizeof (DESIGNWARE_HW_DESCRIPTOR)),
+      EmacDriver->TxdescRing);
+    EmacDriver->TxdescRing = NULL;
+  }
+}
+
+
 EFI_STATUS
 EFIAPI
 EmacSetupTxdesc (
@@ -227,26 +396,26 @@ EmacSetupTxdesc (
   IN  UINTN         MacBaseAddress
  )
 {
-  INTN                       Index;
+  UINT32                     Index;
   DESIGNWARE_HW_DESCRIPTOR   *TxDescriptor;
 
-  for (Index = 0; Index < CONFIG_TX_DESCR_NUM; Index++) {
-    TxDescriptor = (VOID *)(UINTN)EmacDriver->TxdescRingMap[Index].AddrMap;
+  for (Index = 0; Index < EmacDriver->TxDescriptorCount; Index++) {
+    TxDescriptor = EMAC_TX_DESC_MAP (EmacDriver, Index);
     TxDescriptor->Addr = (UINT32)(UINTN)&EmacDriver->TxBuffer[Index * CONFIG_ETH_BUFSIZE];
-    if (Index < 9) {
-      TxDescriptor->AddrNext = (UINT32)(UINTN)EmacDriver->TxdescRingMap[Index + 1].AddrMap;
+    if (Index < EmacDriver->TxDescriptorCount - 1) {
+      TxDescriptor->AddrNext = (UINT32)(UINTN)EMAC_TX_DESC_MAP (EmacDriver, Index + 1);
     }
     TxDescriptor->Tdes0 = TDES0_TXCHAIN;
     TxDescriptor->Tdes1 = 0;
   }
 
   // Correcting the last pointer of the chain
-  TxDescriptor->AddrNext = (UINT32)(UINTN)EmacDriver->TxdescRingMap[0].AddrMap;
+  TxDescriptor->AddrNext = (UINT32)(UINTN)EMAC_TX_DESC_MAP (EmacDriver, 0);
 
   // Write the address of tx descriptor list
   MmioWrite32 (MacBaseAddress +
               DW_EMAC_DMAGRP_TRANSMIT_DESCRIPTOR_LIST_ADDRESS_OFST,
-              (UINT32)(UINTN)EmacDriver->TxdescRingMap[0].AddrMap);
+              (UINT32)(UINTN)EMAC_TX_DESC_MAP (EmacDriver, 0));
 
   // Initialize the descriptor number
   EmacDriver->TxCurrentDescriptorNum = 0;
@@ -263,26 +432,26 @@ EmacSetupRxdesc (
   IN  UINTN         MacBaseAddress
   )
 {
-  INTN                        Index;
+  UINT32                      Index;
   DESIGNWARE_HW_DESCRIPTOR    *RxDescriptor;
 
-  for (Index = 0; Index < CONFIG_RX_DESCR_NUM; Index++) {
-    RxDescriptor = (VOID *)(UINTN)EmacDriver->RxdescRingMap[Index].AddrMap;
+  for (Index = 0; Index < EmacDriver->RxDescriptorCount; Index++) {
+    RxDescriptor = EMAC_RX_DESC_MAP (EmacDriver, Index);
     RxDescriptor->Addr = EmacDriver->RxBufNum[Index].AddrMap;
-    if (Index < 9) {
-      RxDescriptor->AddrNext = (UINT32)(UINTN)EmacDriver->RxdescRingMap[Index + 1].AddrMap;
+    if (Index < EmacDriver->RxDescriptorCount - 1) {
+      RxDescriptor->AddrNext = (UINT32)(UINTN)EMAC_RX_DESC_MAP (EmacDriver, Index + 1);
     }
     RxDescriptor->Tdes0 = RDES0_OWN;
     RxDescriptor->Tdes1 = RDES1_CHAINED | RX_MAX_PACKET;
   }
 
   // Correcting the last pointer of the chain
-  RxDescriptor->AddrNext = (UINT32)(UINTN)EmacDriver->RxdescRingMap[0].AddrMap;
+  RxDescriptor->AddrNext = (UINT32)(UINTN)EMAC_RX_DESC_MAP (EmacDriver, 0);
 
   // Write the address of tx descriptor list
   MmioWrite32(MacBaseAddress +
               DW_EMAC_DMAGRP_RECEIVE_DESCRIPTOR_LIST_ADDRESS_OFST,
-              (UINT32)(UINTN)EmacDriver->RxdescRingMap[0].AddrMap);
+              (UINT32)(UINTN)EMAC_RX_DESC_MAP (EmacDriver, 0));
 
   // Initialize the descriptor number
   EmacDriver->RxCurrentDescriptorNum = 0;
@@ -613,14 +782,11 @@ EmacGetStatistic (
   )
 {
   EFI_NETWORK_STATISTICS   *Stats;
+  UINT32                   MissedFrames;
 
   DEBUG ((DEBUG_INFO, "SNP:MAC: %a ()\r\n", __FUNCTION__));
 
-  // Allocate Resources
-  Stats = AllocateZeroPool (sizeof (EFI_NETWORK_STATISTICS));
-  if (Stats == NULL) {
-    return;
-  }
+  Stats = Statistic;
 
   Stats->RxTotalFrames     = MmioRead32 (MacBaseAddress + DW_EMAC_GMACGRP_RXFRAMECOUNT_GB_OFST);
   Stats->RxUndersizeFrames = MmioRead32 (MacBaseAddress + DW_EMAC_GMACGRP_RXUNDERSIZE_G_OFST);
@@ -642,8 +808,11 @@ EmacGetStatistic (
   Stats->Collisions        = MmioRead32 (MacBaseAddress + DW_EMAC_GMACGRP_TXLATECOL_OFST) +
                              MmioRead32 (MacBaseAddress + DW_EMAC_GMACGRP_TXEXESSCOL_OFST);
 
-  // Fill in the statistics
-  CopyMem (Statistic, Stats, sizeof (EFI_NETWORK_STATISTICS));
+  // Frames missed for lack of a free RX descriptor, or lost to a FIFO
+  // overflow. The register counts up from the last read, so accumulate.
+  MissedFrames = MmioRead32 (MacBaseAddress + DW_EMAC_DMAGRP_MISSED_FRAME_AND_BUFFER_OVERFLOW_COUNTER_OFST);
+  Stats->RxDroppedFrames  += DW_EMAC_DMAGRP_MISSED_FRAME_MISFRMCNT_GET (MissedFrames) +
+                             DW_EMAC_DMAGRP_MISSED_FRAME_OVFFRMCNT_GET (MissedFrames);
 }
 
 
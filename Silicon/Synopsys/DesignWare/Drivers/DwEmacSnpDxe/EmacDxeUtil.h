@@ -25,10 +25,6 @@
 #define RX_MAX_PACKET                                             1600
 
 #define CONFIG_ETH_BUFSIZE                                         2048
-#define CONFIG_TX_DESCR_NUM                                        10
-#define CONFIG_RX_DESCR_NUM                                        10
-#define TX_TOTAL_BUFSIZE                                           (CONFIG_ETH_BUFSIZE * CONFIG_TX_DESCR_NUM)
-#define RX_TOTAL_BUFSIZE                                           (CONFIG_ETH_BUFSIZE * CONFIG_RX_DESCR_NUM)
 
 // DMA status error bit
 #define RX_DMA_WRITE_DATA_TRANSFER_ERROR                           0x0
@@ -220,6 +216,8 @@
 #define DW_EMAC_DMAGRP_OPERATION_MODE_OFST                           0x1018
 #define DW_EMAC_DMAGRP_INTERRUPT_ENABLE_OFST                         0x101c
 #define DW_EMAC_DMAGRP_MISSED_FRAME_AND_BUFFER_OVERFLOW_COUNTER_OFST 0x1020
+#define DW_EMAC_DMAGRP_MISSED_FRAME_MISFRMCNT_GET(Value)             ((Value) & 0x0000ffff)
+#define DW_EMAC_DMAGRP_MISSED_FRAME_OVFFRMCNT_GET(Value)             (((Value) & 0x0ffe0000) >> 17)
 #define DW_EMAC_DMAGRP_RECEIVE_INTERRUPT_WATCHDOG_TIMER_OFST         0x1024
 #define DW_EMAC_DMAGRP_AXI_BUS_MODE_OFST                             0x1028
 #define DW_EMAC_DMAGRP_AHB_OR_AXI_STATUS_OFST                        0x102c
@@ -242,19 +240,42 @@ typedef struct {
 } MAP_INFO;
 
 typedef struct {
-  DESIGNWARE_HW_DESCRIPTOR    *TxdescRing[CONFIG_TX_DESCR_NUM];
-  DESIGNWARE_HW_DESCRIPTOR    *RxdescRing[CONFIG_RX_DESCR_NUM];
-  CHAR8                       TxBuffer[TX_TOTAL_BUFSIZE];
-  CHAR8                       RxBuffer[RX_TOTAL_BUFSIZE];
-  MAP_INFO                    TxdescRingMap[CONFIG_TX_DESCR_NUM ];
-  MAP_INFO                    RxdescRingMap[CONFIG_RX_DESCR_NUM ];
-  MAP_INFO                    RxBufNum[CONFIG_TX_DESCR_NUM];
+  // Each ring is a single DMA buffer of chained descriptors
+  DESIGNWARE_HW_DESCRIPTOR    *TxdescRing;
+  DESIGNWARE_HW_DESCRIPTOR    *RxdescRing;
+  CHAR8                       *TxBuffer;
+  CHAR8                       *RxBuffer;
+  MAP_INFO                    TxdescRingMap;
+  MAP_INFO                    RxdescRingMap;
+  // The receive buffers are a single DMA buffer, mapped once for the ring's lifetime
+  MAP_INFO                    RxBufferMap;
+  MAP_INFO                    *RxBufNum;
+  UINT32                      TxDescriptorCount;
+  UINT32                      RxDescriptorCount;
   UINT32                      TxCurrentDescriptorNum;
   UINT32                      TxNextDescriptorNum;
   UINT32                      RxCurrentDescriptorNum;
   UINT32                      RxNextDescriptorNum;
 } EMAC_DRIVER;
 
+// Device address of a descriptor, as seen by the DMA engine
+#define EMAC_TX_DESC_MAP(Emac, Index)  ((DESIGNWARE_HW_DESCRIPTOR *)(UINTN)(Emac)->TxdescRingMap.AddrMap + (Index))
+#define EMAC_RX_DESC_MAP(Emac, Index)  ((DESIGNWARE_HW_DESCRIPTOR *)(UINTN)(Emac)->RxdescRingMap.AddrMap + (Index))
+
+EFI_STATUS
+EFIAPI
+EmacAllocateRings (
+  IN  EMAC_DRIVER             *EmacDriver,
+  IN  UINT32                  TxDescriptorCount,
+  IN  UINT32                  RxDescriptorCount
+  );
+
+VOID
+EFIAPI
+EmacFreeRings (
+  IN  EMAC_DRIVER             *EmacDriver
+  );
+
 VOID
 EFIAPI
 EmacSetMacAddress (
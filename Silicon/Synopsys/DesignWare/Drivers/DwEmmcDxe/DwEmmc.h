@@ -123,6 +123,8 @@
 #define DWEMMC_FIFO_TWMARK(x)                   (x & 0xfff)
 #define DWEMMC_FIFO_RWMARK(x)                   ((x & 0x1ff) << 16)
 #define DWEMMC_DMA_BURST_SIZE(x)                ((x & 0x7) << 28)
+// RX_WMark resets to the FIFO depth minus one
+#define DWEMMC_GET_FIFO_DEPTH(x)                ((((x) >> 16) & 0xfff) + 1)
 
 #define DWEMMC_CARD_RD_THR(x)                   ((x & 0xfff) << 16)
 #define DWEMMC_CARD_RD_THR_EN                   (1 << 0)
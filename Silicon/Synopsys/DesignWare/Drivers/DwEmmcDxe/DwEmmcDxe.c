@@ -31,6 +31,9 @@
 #define DWEMMC_BLOCK_SIZE               512
 #define DWEMMC_DMA_BUF_SIZE             (512 * 8)
 #define DWEMMC_MAX_DESC_PAGES           512
+// Each chained descriptor covers DWEMMC_DMA_BUF_SIZE, 512MB in total
+#define DWEMMC_MAX_DESC_COUNT           (EFI_PAGES_TO_SIZE (DWEMMC_MAX_DESC_PAGES) / \
+                                         sizeof (DWEMMC_IDMAC_DESCRIPTOR))
 
 typedef struct {
   UINT32                        Des0;
@@ -424,10 +427,10 @@ DwEmmcAdjustFifoThreshold (
   UINT32 BlkDepthInFifo, FifoThreshold, FifoWidth, FifoDepth;
   UINT32 BlkSize = DWEMMC_BLOCK_SIZE, Idx = 0, RxWatermark = 1, TxWatermark, TxWatermarkInvers;
 
-  /* Skip FIFO adjustment if we do not have platform FIFO depth info */
+  /* Without platform FIFO depth info, use the reset value of FIFOTH */
   FifoDepth = PcdGet32 (PcdDwEmmcDxeFifoDepth);
   if (!FifoDepth) {
-    return;
+    FifoDepth = DWEMMC_GET_FIFO_DEPTH (MmioRead32 (DWEMMC_FIFOTH));
   }
 
   TxWatermark = FifoDepth / 2;
@@ -453,6 +456,9 @@ DwEmmcAdjustFifoThreshold (
   FifoThreshold = DWEMMC_DMA_BURST_SIZE (Idx) | DWEMMC_FIFO_TWMARK (TxWatermark)
            | DWEMMC_FIFO_RWMARK (RxWatermark);
   MmioWrite32 (DWEMMC_FIFOTH, FifoThreshold);
+
+  DEBUG ((DEBUG_INFO, "DwEmmc: FIFO depth %u, burst %u, FIFOTH 0x%x\n",
+    FifoDepth, BurstSize[Idx], FifoThreshold));
 }
 
 EFI_STATUS
@@ -468,6 +474,10 @@ PrepareDmaData (
   Blks = (Length + DWEMMC_BLOCK_SIZE - 1) / DWEMMC_BLOCK_SIZE;
   Length = DWEMMC_BLOCK_SIZE * Blks;
 
+  if (Cnt == 0 || Cnt > DWEMMC_MAX_DESC_COUNT) {
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
   for (Idx = 0; Idx < Cnt; Idx++) {
     (IdmacDesc + Idx)->Des0 = DWEMMC_IDMAC_DES0_OWN | DWEMMC_IDMAC_DES0_CH |
                               DWEMMC_IDMAC_DES0_DIC;
@@ -488,6 +498,9 @@ PrepareDmaData (
                                                       (LastIdx * DWEMMC_DMA_BUF_SIZE));
   /* Set the Next field of Last Descriptor */
   (IdmacDesc + LastIdx)->Des3 = 0;
+
+  /* Only the descriptors of this request need to reach memory */
+  WriteBackDataCacheRange (IdmacDesc, Cnt * sizeof (DWEMMC_IDMAC_DESCRIPTOR));
   MmioWrite32 (DWEMMC_DBADDR, (UINT32)((UINTN)IdmacDesc));
 
   return EFI_SUCCESS;
@@ -511,37 +524,36 @@ StartDma (
   MmioWrite32 (DWEMMC_BYTCNT, Length);
 }
 
+STATIC
 EFI_STATUS
-DwEmmcReadBlockData (
-  IN EFI_MMC_HOST_PROTOCOL     *This,
-  IN EFI_LBA                    Lba,
+DwEmmcTransferBlockData (
   IN UINTN                      Length,
-  IN UINT32*                   Buffer
+  IN UINT32*                    Buffer,
+  IN BOOLEAN                    IsWrite
   )
 {
   EFI_STATUS  Status;
-  UINT32      DescPages, CountPerPage, Count;
   EFI_TPL     Tpl;
 
   Tpl = gBS->RaiseTPL (TPL_NOTIFY);
 
-  CountPerPage = EFI_PAGE_SIZE / 16;
-  Count = (Length + DWEMMC_DMA_BUF_SIZE - 1) / DWEMMC_DMA_BUF_SIZE;
-  DescPages = (Count + CountPerPage - 1) / CountPerPage;
-
-  InvalidateDataCacheRange (Buffer, Length);
+  if (IsWrite) {
+    WriteBackDataCacheRange (Buffer, Length);
+  } else {
+    InvalidateDataCacheRange (Buffer, Length);
+  }
 
   Status = PrepareDmaData (gpIdmacDesc, Length, Buffer);
   if (EFI_ERROR (Status)) {
     goto out;
   }
 
-  WriteBackDataCacheRange (gpIdmacDesc, DescPages * EFI_PAGE_SIZE);
   StartDma (Length);
 
   Status = SendCommand (mDwEmmcCommand, mDwEmmcArgument);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "Failed to read data, mDwEmmcCommand:%x, mDwEmmcArgument:%x, Status:%r\n", mDwEmmcCommand, mDwEmmcArgument, Status));
+    DEBUG ((DEBUG_ERROR, "Failed to %a data, mDwEmmcCommand:%x, mDwEmmcArgument:%x, Status:%r\n",
+      IsWrite ? "write" : "read", mDwEmmcCommand, mDwEmmcArgument, Status));
     goto out;
   }
 out:
@@ -550,6 +562,17 @@ out:
   return Status;
 }
 
+EFI_STATUS
+DwEmmcReadBlockData (
+  IN EFI_MMC_HOST_PROTOCOL     *This,
+  IN EFI_LBA                    Lba,
+  IN UINTN                      Length,
+  IN UINT32*                   Buffer
+  )
+{
+  return DwEmmcTransferBlockData (Length, Buffer, FALSE);
+}
+
 EFI_STATUS
 DwEmmcWriteBlockData (
   IN EFI_MMC_HOST_PROTOCOL     *This,
@@ -558,35 +581,7 @@ DwEmmcWriteBlockData (
   IN UINT32*                    Buffer
   )
 {
-  EFI_STATUS  Status;
-  UINT32      DescPages, CountPerPage, Count;
-  EFI_TPL     Tpl;
-
-  Tpl = gBS->RaiseTPL (TPL_NOTIFY);
-
-  CountPerPage = EFI_PAGE_SIZE / 16;
-  Count = (Length + DWEMMC_DMA_BUF_SIZE - 1) / DWEMMC_DMA_BUF_SIZE;
-  DescPages = (Count + CountPerPage - 1) / CountPerPage;
-
-  WriteBackDataCacheRange (Buffer, Length);
-
-  Status = PrepareDmaData (gpIdmacDesc, Length, Buffer);
-  if (EFI_ERROR (Status)) {
-    goto out;
-  }
-
-  WriteBackDataCacheRange (gpIdmacDesc, DescPages * EFI_PAGE_SIZE);
-  StartDma (Length);
-
-  Status = SendCommand (mDwEmmcCommand, mDwEmmcArgument);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "Failed to write data, mDwEmmcCommand:%x, mDwEmmcArgument:%x, Status:%r\n", mDwEmmcCommand, mDwEmmcArgument, Status));
-    goto out;
-  }
-out:
-  // Restore Tpl
-  gBS->RestoreTPL (Tpl);
-  return Status;
+  return DwEmmcTransferBlockData (Length, Buffer, TRUE);
 }
 
 EFI_STATUS